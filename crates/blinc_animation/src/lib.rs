@@ -18,6 +18,7 @@ pub mod keyframe;
 pub mod presets;
 pub mod scheduler;
 pub mod spring;
+mod spring_store;
 pub mod timeline;
 
 pub use context::{
@@ -31,8 +32,8 @@ pub use keyframe::{
 pub use presets::AnimationPreset;
 pub use scheduler::{
     get_scheduler, is_scheduler_initialized, set_global_scheduler, try_get_scheduler,
-    AnimatedKeyframe, AnimatedTimeline, AnimatedValue, AnimationScheduler, ConfigureResult,
-    KeyframeId, SchedulerHandle, SpringId, TimelineId,
+    AnimatedKeyframe, AnimatedTimeline, AnimatedValue, AnimationActivity, AnimationScheduler,
+    ConfigureResult, KeyframeId, SchedulerHandle, SpringId, TimelineId,
 };
 pub use spring::{Spring, SpringConfig};
 pub use timeline::{StaggerBuilder, Timeline, TimelineEntryId};
@@ -9,12 +9,13 @@
 use crate::easing::Easing;
 use crate::keyframe::{Keyframe, KeyframeAnimation};
 use crate::spring::{Spring, SpringConfig};
+use crate::spring_store::SpringStore;
 use crate::timeline::Timeline;
 use blinc_core::AnimationAccess;
 use slotmap::{new_key_type, SlotMap};
-use std::sync::atomic::{AtomicBool, Ordering};
+use std::sync::atomic::{AtomicBool, AtomicUsize, Ordering};
 use std::sync::{Arc, Mutex, OnceLock, Weak};
-use std::thread::{self, JoinHandle};
+use std::thread::{self, JoinHandle, Thread};
 use std::time::{Duration, Instant};
 
 // ============================================================================
@@ -101,11 +102,140 @@ impl SpringId {
 
 /// Internal state of the animation scheduler
 struct SchedulerInner {
-    springs: SlotMap<SpringId, Spring>,
+    /// Packed so a tick steps only moving springs, in SIMD lanes
+    springs: SpringStore,
     keyframes: SlotMap<KeyframeId, KeyframeAnimation>,
     timelines: SlotMap<TimelineId, Timeline>,
     last_frame: Instant,
     target_fps: u32,
+    /// No animation was active after the last tick
+    idle: bool,
+    /// Number of playing animations, readable without the lock
+    /// (see `AnimationActivity`)
+    active: Arc<AtomicUsize>,
+    /// Background thread to unpark when animations become active
+    ticker: Option<Thread>,
+    /// Wake callback for externally clocked mode, invoked when animations
+    /// become active so the platform can resume its vsync callbacks
+    external_wake: Option<WakeCallback>,
+}
+
+impl SchedulerInner {
+    /// Note that an animation may have become active
+    ///
+    /// On the idle -> active transition this resets `last_frame` (so the first
+    /// tick doesn't see the whole idle period as dt) and wakes whatever drives
+    /// the ticks: the parked background thread or, in externally clocked mode,
+    /// the platform via the wake callback.
+    fn mark_active(&mut self) {
+        if self.idle {
+            self.idle = false;
+            // The exact count is taken on the next tick
+            self.active.fetch_max(1, Ordering::Release);
+            self.last_frame = Instant::now();
+            self.wake_ticker();
+        }
+    }
+
+    /// Wake the background thread or the external clock
+    ///
+    /// The external wake callback runs with the scheduler lock held, so it
+    /// must not call back into the scheduler.
+    fn wake_ticker(&self) {
+        if let Some(ref ticker) = self.ticker {
+            ticker.unpark();
+        }
+        if let Some(ref callback) = self.external_wake {
+            callback();
+        }
+    }
+
+    /// Step all animations forward to `now`
+    ///
+    /// Returns true if any animations are still active.
+    fn advance(&mut self, now: Instant) -> bool {
+        let dt = now.saturating_duration_since(self.last_frame).as_secs_f32();
+        let dt_ms = dt * 1000.0;
+        if now > self.last_frame {
+            self.last_frame = now;
+        }
+
+        // Step everything, counting what is still playing afterwards
+        let mut active = 0;
+
+        // Update all springs
+        active += self.springs.step(dt);
+
+        // Update all keyframe animations
+        for (_, keyframe) in self.keyframes.iter_mut() {
+            keyframe.tick(dt_ms);
+            active += usize::from(keyframe.is_playing());
+        }
+
+        // Update all timelines
+        for (_, timeline) in self.timelines.iter_mut() {
+            timeline.tick(dt_ms);
+            active += usize::from(timeline.is_playing());
+        }
+
+        // NOTE: We do NOT remove animations here!
+        // Springs, keyframes, and timelines are only removed when:
+        // 1. Their wrapper (AnimatedValue, AnimatedKeyframe, AnimatedTimeline) is dropped
+        // 2. set_immediate() is called on springs
+        // This ensures animations can be restarted after completing.
+
+        self.publish_active(active);
+        active > 0
+    }
+
+    /// Recount playing animations (not just present) after they were
+    /// stepped outside a tick
+    fn recount(&mut self) {
+        let active = self.springs.active_len()
+            + self
+                .keyframes
+                .iter()
+                .filter(|(_, k)| k.is_playing())
+                .count()
+            + self
+                .timelines
+                .iter()
+                .filter(|(_, t)| t.is_playing())
+                .count();
+        self.publish_active(active);
+    }
+
+    fn publish_active(&mut self, active: usize) {
+        self.idle = active == 0;
+        self.active.store(active, Ordering::Release);
+    }
+}
+
+/// Lock-free view of whether a scheduler has work to render
+///
+/// Obtained from `AnimationScheduler::activity()`. Reading it never takes the
+/// scheduler lock, so a render loop can poll it every frame without ever
+/// waiting on the animation thread mid-tick.
+#[derive(Clone)]
+pub struct AnimationActivity {
+    active: Arc<AtomicUsize>,
+    continuous_redraw: Arc<AtomicBool>,
+}
+
+impl AnimationActivity {
+    /// Number of playing animations
+    ///
+    /// Exact as of the last tick; an animation started since then counts as
+    /// at least one, and one stopped or removed since then still counts
+    /// until the next tick.
+    pub fn active_animations(&self) -> usize {
+        self.active.load(Ordering::Acquire)
+    }
+
+    /// Whether animations are playing or continuous redraw is enabled
+    pub fn is_active(&self) -> bool {
+        self.active_animations() > 0 || self.continuous_redraw.load(Ordering::Relaxed)
+    }
 }
 
 /// Callback type for waking up the main thread from the animation thread
@@ -128,10 +258,22 @@ pub type WakeCallback = Arc<dyn Fn() + Send + Sync>;
 /// let scheduler = AnimationScheduler::new();
 /// scheduler.start_background(); // Runs at 120fps in background thread
 /// ```
+///
+/// The thread parks while nothing is animating and is woken when an
+/// animation starts, so an idle UI costs no wakeups.
+///
+/// # Externally Clocked Mode
+///
+/// On mobile the display's vsync (CADisplayLink, Choreographer) should drive
+/// ticks instead. `start_external_clock()` runs without a thread: the platform
+/// calls `tick_at()` once per frame, and the wake callback is invoked when an
+/// animation becomes active so a paused display link can be resumed.
 pub struct AnimationScheduler {
     inner: Arc<Mutex<SchedulerInner>>,
     /// Stop signal for background thread
     stop_flag: Arc<AtomicBool>,
+    /// Shared with `SchedulerInner::active`
+    active: Arc<AtomicUsize>,
     /// Flag set by background thread when animations need redraw
     /// The main thread should check and clear this to request window redraws
     needs_redraw: Arc<AtomicBool>,
@@ -142,23 +284,32 @@ pub struct AnimationScheduler {
     thread_handle: Option<JoinHandle<()>>,
     /// Optional callback to wake up the main thread
     wake_callback: Option<WakeCallback>,
+    /// Ticks are driven by the platform's vsync instead of a background thread
+    external_clock: bool,
 }
 
 impl AnimationScheduler {
     pub fn new() -> Self {
+        let active = Arc::new(AtomicUsize::new(0));
         Self {
             inner: Arc::new(Mutex::new(SchedulerInner {
-                springs: SlotMap::with_key(),
+                springs: SpringStore::new(),
                 keyframes: SlotMap::with_key(),
                 timelines: SlotMap::with_key(),
                 last_frame: Instant::now(),
                 target_fps: 120,
+                idle: true,
+                active: Arc::clone(&active),
+                ticker: None,
+                external_wake: None,
             })),
             stop_flag: Arc::new(AtomicBool::new(false)),
+            active,
             needs_redraw: Arc::new(AtomicBool::new(false)),
             continuous_redraw: Arc::new(AtomicBool::new(false)),
             thread_handle: None,
             wake_callback: None,
+            external_clock: false,
         }
     }
 
@@ -177,13 +328,17 @@ impl AnimationScheduler {
     where
         F: Fn() + Send + Sync + 'static,
     {
-        self.wake_callback = Some(Arc::new(callback));
+        let callback: WakeCallback = Arc::new(callback);
+        if self.external_clock {
+            self.inner.lock().unwrap().external_wake = Some(Arc::clone(&callback));
+        }
+        self.wake_callback = Some(callback);
     }
 
     /// Start the scheduler on a background thread
     ///
     /// This ensures animations continue even when the window loses focus.
-    /// The thread runs at the configured target FPS (default 120).
+    /// The thread runs at the target FPS (default 120, see `set_target_fps`).
     ///
     /// The thread sets the `needs_redraw` flag whenever there are active
     /// animations. The main thread should call `take_needs_redraw()` to
@@ -191,10 +346,17 @@ impl AnimationScheduler {
     ///
     /// If a wake callback is set via `set_wake_callback()`, it will be called
     /// to wake up the main thread's event loop when animations are active.
+    ///
+    /// While no animation is active (and continuous redraw is off) the thread
+    /// parks; registering or retargeting an animation unparks it.
     pub fn start_background(&mut self) {
         if self.thread_handle.is_some() {
             return; // Already running
         }
+        if self.external_clock {
+            self.external_clock = false;
+            self.inner.lock().unwrap().external_wake = None;
+        }
 
         let inner = Arc::clone(&self.inner);
         let stop_flag = Arc::clone(&self.stop_flag);
@@ -203,8 +365,6 @@ impl AnimationScheduler {
         let wake_callback = self.wake_callback.clone();
 
         self.thread_handle = Some(thread::spawn(move || {
-            let frame_duration = Duration::from_micros(1_000_000 / 120); // 120fps
-
             while !stop_flag.load(Ordering::Relaxed) {
                 let start = Instant::now();
 
@@ -212,61 +372,38 @@ impl AnimationScheduler {
                 let wants_continuous = continuous_redraw.load(Ordering::Relaxed);
 
                 // Tick animations and check if any are active
-                let has_active = {
+                let (has_active, target_fps) = {
                     let mut inner = inner.lock().unwrap();
-                    let now = Instant::now();
-                    let dt = (now - inner.last_frame).as_secs_f32();
-                    let dt_ms = dt * 1000.0;
-                    inner.last_frame = now;
-
-                    // Update all springs
-                    for (_, spring) in inner.springs.iter_mut() {
-                        spring.step(dt);
-                    }
-
-                    // Update all keyframe animations
-                    for (_, keyframe) in inner.keyframes.iter_mut() {
-                        keyframe.tick(dt_ms);
-                    }
-
-                    // Update all timelines
-                    for (_, timeline) in inner.timelines.iter_mut() {
-                        timeline.tick(dt_ms);
-                    }
-
-                    // NOTE: We do NOT remove animations here!
-                    // Springs, keyframes, and timelines are only removed when:
-                    // 1. Their wrapper (AnimatedValue, AnimatedKeyframe, AnimatedTimeline) is dropped
-                    // 2. set_immediate() is called on springs
-                    // This ensures animations can be restarted after completing.
-
-                    // Check if any animations are still active (playing, not just present)
-                    inner.springs.iter().any(|(_, s)| !s.is_settled())
-                        || inner.keyframes.iter().any(|(_, k)| k.is_playing())
-                        || inner.timelines.iter().any(|(_, t)| t.is_playing())
+                    (inner.advance(Instant::now()), inner.target_fps)
                 };
+                let frame_duration = Duration::from_micros(1_000_000 / target_fps.max(1) as u64);
+
+                // Nothing to animate: park until an animation starts, continuous
+                // redraw is enabled or the thread is stopped
+                if !has_active && !wants_continuous {
+                    thread::park();
+                    continue;
+                }
 
                 // Signal main thread that it needs to redraw
                 // Either from active animations OR continuous redraw request (cursor blink)
-                if has_active || wants_continuous {
-                    needs_redraw.store(true, Ordering::Release);
-
-                    // Wake up the event loop if a callback is set
-                    if let Some(ref callback) = wake_callback {
-                        // Only log occasionally to avoid spam
-                        static COUNTER: std::sync::atomic::AtomicU64 =
-                            std::sync::atomic::AtomicU64::new(0);
-                        let count = COUNTER.fetch_add(1, Ordering::Relaxed);
-                        if count % 120 == 0 {
-                            // Log once per second at 120fps
-                            tracing::debug!(
-                                "Animation thread: waking event loop (continuous={}, active={})",
-                                wants_continuous,
-                                has_active
-                            );
-                        }
-                        callback();
+                needs_redraw.store(true, Ordering::Release);
+
+                // Wake up the event loop if a callback is set
+                if let Some(ref callback) = wake_callback {
+                    // Only log occasionally to avoid spam
+                    static COUNTER: std::sync::atomic::AtomicU64 =
+                        std::sync::atomic::AtomicU64::new(0);
+                    let count = COUNTER.fetch_add(1, Ordering::Relaxed);
+                    if count % 120 == 0 {
+                        // Log once per second at 120fps
+                        tracing::debug!(
+                            "Animation thread: waking event loop (continuous={}, active={})",
+                            wants_continuous,
+                            has_active
+                        );
                     }
+                    callback();
                 }
 
                 // Sleep for remaining frame time
@@ -276,12 +413,39 @@ impl AnimationScheduler {
                 }
             }
         }));
+
+        // Register the thread so new animations can unpark it
+        let mut inner = self.inner.lock().unwrap();
+        inner.ticker = self.thread_handle.as_ref().map(|h| h.thread().clone());
+        inner.wake_ticker();
+    }
+
+    /// Drive ticks from the platform's vsync instead of a background thread
+    ///
+    /// Stops the background thread if it is running. The platform must call
+    /// `tick_at()` (or `tick()`) once per display frame while
+    /// `has_active_animations()` is true; when an animation becomes active the
+    /// wake callback is invoked so a paused display link can be resumed.
+    pub fn start_external_clock(&mut self) {
+        self.stop_background();
+        self.external_clock = true;
+        self.inner.lock().unwrap().external_wake = self.wake_callback.clone();
+    }
+
+    /// Check if ticks are driven by the platform's vsync
+    pub fn is_external_clock(&self) -> bool {
+        self.external_clock
     }
 
     /// Stop the background thread
     pub fn stop_background(&mut self) {
         self.stop_flag.store(true, Ordering::Relaxed);
         if let Some(handle) = self.thread_handle.take() {
+            // Unpark so a parked thread sees the stop flag
+            if let Ok(mut inner) = self.inner.lock() {
+                inner.ticker = None;
+            }
+            handle.thread().unpark();
             let _ = handle.join();
         }
         self.stop_flag.store(false, Ordering::Relaxed);
@@ -307,9 +471,13 @@ impl AnimationScheduler {
     /// Manually request a redraw
     ///
     /// This sets the needs_redraw flag, which will be picked up by the
-    /// main thread on its next event loop iteration.
+    /// main thread on its next event loop iteration, and invokes the wake
+    /// callback so an idle event loop (or paused display link) runs one.
     pub fn request_redraw(&self) {
         self.needs_redraw.store(true, Ordering::Release);
+        if let Some(ref callback) = self.wake_callback {
+            callback();
+        }
     }
 
     /// Enable continuous redraw mode
@@ -322,6 +490,9 @@ impl AnimationScheduler {
     pub fn set_continuous_redraw(&self, enabled: bool) {
         tracing::debug!("AnimationScheduler: set_continuous_redraw({})", enabled);
         self.continuous_redraw.store(enabled, Ordering::Release);
+        if enabled {
+            self.inner.lock().unwrap().wake_ticker();
+        }
     }
 
     /// Check if continuous redraw mode is enabled
@@ -336,51 +507,63 @@ impl AnimationScheduler {
         }
     }
 
+    /// Set the rate the background thread ticks at
+    ///
+    /// Takes effect from the thread's next tick. Lower it when the device is
+    /// hot or saving power; with an external clock the platform paces ticks
+    /// and this is only informational.
     pub fn set_target_fps(&mut self, fps: u32) {
-        self.inner.lock().unwrap().target_fps = fps;
+        self.inner.lock().unwrap().target_fps = fps.max(1);
+    }
+
+    /// Rate the background thread ticks at
+    pub fn target_fps(&self) -> u32 {
+        self.inner.lock().unwrap().target_fps
     }
 
     /// Tick all animations
     ///
     /// Returns true if any animations are still active (need another tick).
     pub fn tick(&self) -> bool {
-        let mut inner = self.inner.lock().unwrap();
-        let now = Instant::now();
-        let dt = (now - inner.last_frame).as_secs_f32();
-        let dt_ms = dt * 1000.0;
-        inner.last_frame = now;
-
-        // Update all springs
-        for (_, spring) in inner.springs.iter_mut() {
-            spring.step(dt);
-        }
-
-        // Update all keyframe animations
-        for (_, keyframe) in inner.keyframes.iter_mut() {
-            keyframe.tick(dt_ms);
-        }
-
-        // Update all timelines
-        for (_, timeline) in inner.timelines.iter_mut() {
-            timeline.tick(dt_ms);
-        }
-
-        // NOTE: We do NOT remove animations here!
-        // Springs, keyframes, and timelines are only removed when their wrappers drop.
-        // This ensures animations can be restarted after completing.
+        self.tick_at(Instant::now())
+    }
 
-        // Return true if there are still active (playing, not just present) animations
-        inner.springs.iter().any(|(_, s)| !s.is_settled())
-            || inner.keyframes.iter().any(|(_, k)| k.is_playing())
-            || inner.timelines.iter().any(|(_, t)| t.is_playing())
+    /// Tick all animations to a specific point in time
+    ///
+    /// Use this when the caller knows when the frame will actually be shown
+    /// (e.g. a display link's target timestamp), so animation values match
+    /// presentation time rather than the moment the tick happened to run.
+    ///
+    /// Times at or before the last tick are a no-op advance, so mixing this
+    /// with `tick()` or the background thread never steps animations backwards.
+    ///
+    /// Returns true if any animations are still active (need another tick).
+    pub fn tick_at(&self, now: Instant) -> bool {
+        self.inner.lock().unwrap().advance(now)
     }
 
     /// Check if any animations are still active
+    ///
+    /// Lock-free; see `AnimationActivity::active_animations` for how current
+    /// the answer is.
     pub fn has_active_animations(&self) -> bool {
-        let inner = self.inner.lock().unwrap();
-        inner.springs.iter().any(|(_, s)| !s.is_settled())
-            || inner.keyframes.iter().any(|(_, k)| k.is_playing())
-            || inner.timelines.iter().any(|(_, t)| t.is_playing())
+        self.active_animation_count() > 0
+    }
+
+    /// Number of playing springs, keyframes and timelines (lock-free)
+    pub fn active_animation_count(&self) -> usize {
+        self.active.load(Ordering::Acquire)
+    }
+
+    /// Get a lock-free view of this scheduler's activity
+    ///
+    /// Render loops that keep the scheduler behind a mutex can hold this
+    /// instead to decide whether a frame is needed without locking.
+    pub fn activity(&self) -> AnimationActivity {
+        AnimationActivity {
+            active: Arc::clone(&self.active),
+            continuous_redraw: Arc::clone(&self.continuous_redraw),
+        }
     }
 
     /// Get the number of active springs
@@ -403,11 +586,15 @@ impl AnimationScheduler {
     // =========================================================================
 
     pub fn add_spring(&self, spring: Spring) -> SpringId {
-        self.inner.lock().unwrap().springs.insert(spring)
+        let mut inner = self.inner.lock().unwrap();
+        if !spring.is_settled() {
+            inner.mark_active();
+        }
+        inner.springs.insert(spring)
     }
 
     pub fn get_spring(&self, id: SpringId) -> Option<Spring> {
-        self.inner.lock().unwrap().springs.get(id).copied()
+        self.inner.lock().unwrap().springs.get(id)
     }
 
     /// Apply a function to modify a spring if it exists
@@ -415,7 +602,15 @@ impl AnimationScheduler {
     where
         F: FnOnce(&mut Spring) -> R,
     {
-        self.inner.lock().unwrap().springs.get_mut(id).map(f)
+        let mut inner = self.inner.lock().unwrap();
+        let (result, active) = inner.springs.update(id, |spring| {
+            let result = f(spring);
+            (result, !spring.is_settled())
+        })?;
+        if active {
+            inner.mark_active();
+        }
+        Some(result)
     }
 
     pub fn get_spring_value(&self, id: SpringId) -> Option<f32> {
@@ -428,8 +623,13 @@ impl AnimationScheduler {
     }
 
     pub fn set_spring_target(&self, id: SpringId, target: f32) {
-        if let Some(spring) = self.inner.lock().unwrap().springs.get_mut(id) {
+        let mut inner = self.inner.lock().unwrap();
+        let active = inner.springs.update(id, |spring| {
             spring.set_target(target);
+            !spring.is_settled()
+        });
+        if active == Some(true) {
+            inner.mark_active();
         }
     }
 
@@ -442,8 +642,10 @@ impl AnimationScheduler {
     /// This is useful for manual animation loops where you want to step all springs.
     /// Returns an iterator adapter that holds the mutex lock.
     pub fn springs_iter_mut(&self) -> SpringsIterMut<'_> {
+        let guard = self.inner.lock().unwrap();
         SpringsIterMut {
-            guard: self.inner.lock().unwrap(),
+            springs: guard.springs.snapshot(),
+            guard,
         }
     }
 
@@ -452,7 +654,11 @@ impl AnimationScheduler {
     // =========================================================================
 
     pub fn add_keyframe(&self, keyframe: KeyframeAnimation) -> KeyframeId {
-        self.inner.lock().unwrap().keyframes.insert(keyframe)
+        let mut inner = self.inner.lock().unwrap();
+        if keyframe.is_playing() {
+            inner.mark_active();
+        }
+        inner.keyframes.insert(keyframe)
     }
 
     pub fn get_keyframe_value(&self, id: KeyframeId) -> Option<f32> {
@@ -465,8 +671,10 @@ impl AnimationScheduler {
     }
 
     pub fn start_keyframe(&self, id: KeyframeId) {
-        if let Some(keyframe) = self.inner.lock().unwrap().keyframes.get_mut(id) {
+        let mut inner = self.inner.lock().unwrap();
+        if let Some(keyframe) = inner.keyframes.get_mut(id) {
             keyframe.start();
+            inner.mark_active();
         }
     }
 
@@ -485,12 +693,18 @@ impl AnimationScheduler {
     // =========================================================================
 
     pub fn add_timeline(&self, timeline: Timeline) -> TimelineId {
-        self.inner.lock().unwrap().timelines.insert(timeline)
+        let mut inner = self.inner.lock().unwrap();
+        if timeline.is_playing() {
+            inner.mark_active();
+        }
+        inner.timelines.insert(timeline)
     }
 
     pub fn start_timeline(&self, id: TimelineId) {
-        if let Some(timeline) = self.inner.lock().unwrap().timelines.get_mut(id) {
+        let mut inner = self.inner.lock().unwrap();
+        if let Some(timeline) = inner.timelines.get_mut(id) {
             timeline.start();
+            inner.mark_active();
         }
     }
 
@@ -514,9 +728,19 @@ impl Default for AnimationScheduler {
 /// Iterator adapter for mutable access to springs
 ///
 /// Holds the mutex lock for the duration of iteration.
-/// Use in a `for` loop to step all springs.
+/// Use in a `for` loop to step all springs. Springs are unpacked from the
+/// scheduler's store into owned copies; changes are written back, and the
+/// active animation count refreshed, when the iterator is dropped.
 pub struct SpringsIterMut<'a> {
     guard: std::sync::MutexGuard<'a, SchedulerInner>,
+    springs: Vec<(SpringId, Spring)>,
+}
+
+impl Drop for SpringsIterMut<'_> {
+    fn drop(&mut self) {
+        self.guard.springs.write_back(&self.springs);
+        self.guard.recount();
+    }
 }
 
 impl SpringsIterMut<'_> {
@@ -527,18 +751,23 @@ impl SpringsIterMut<'_> {
     where
         F: FnMut(SpringId, &mut Spring),
     {
-        for (id, spring) in self.guard.springs.iter_mut() {
-            f(id, spring);
+        for (id, spring) in &mut self.springs {
+            f(*id, spring);
         }
     }
 }
 
 impl<'a> IntoIterator for &'a mut SpringsIterMut<'_> {
     type Item = (SpringId, &'a mut Spring);
-    type IntoIter = slotmap::basic::IterMut<'a, SpringId, Spring>;
+    type IntoIter = std::iter::Map<
+        std::slice::IterMut<'a, (SpringId, Spring)>,
+        fn(&'a mut (SpringId, Spring)) -> (SpringId, &'a mut Spring),
+    >;
 
     fn into_iter(self) -> Self::IntoIter {
-        self.guard.springs.iter_mut()
+        let split: fn(&'a mut (SpringId, Spring)) -> (SpringId, &'a mut Spring) =
+            |(id, spring)| (*id, spring);
+        self.springs.iter_mut().map(split)
     }
 }
 
@@ -547,11 +776,13 @@ impl Clone for AnimationScheduler {
         Self {
             inner: Arc::clone(&self.inner),
             stop_flag: Arc::clone(&self.stop_flag),
+            active: Arc::clone(&self.active),
             needs_redraw: Arc::clone(&self.needs_redraw),
             continuous_redraw: Arc::clone(&self.continuous_redraw),
             // Cloned scheduler doesn't own the background thread
             thread_handle: None,
             wake_callback: self.wake_callback.clone(),
+            external_clock: self.external_clock,
         }
     }
 }
@@ -625,6 +856,9 @@ impl SchedulerHandle {
             // Reset last_frame to now to prevent huge dt on first tick
             // This ensures new springs start animating smoothly from their current frame
             guard.last_frame = std::time::Instant::now();
+            if !spring.is_settled() {
+                guard.mark_active();
+            }
             guard.springs.insert(spring)
         })
     }
@@ -632,8 +866,13 @@ impl SchedulerHandle {
     /// Update a spring's target
     pub fn set_spring_target(&self, id: SpringId, target: f32) {
         if let Some(inner) = self.inner.upgrade() {
-            if let Some(spring) = inner.lock().unwrap().springs.get_mut(id) {
+            let mut guard = inner.lock().unwrap();
+            let active = guard.springs.update(id, |spring| {
                 spring.set_target(target);
+                !spring.is_settled()
+            });
+            if active == Some(true) {
+                guard.mark_active();
             }
         }
     }
@@ -676,9 +915,13 @@ impl SchedulerHandle {
 
     /// Register a keyframe animation and return its ID
     pub fn register_keyframe(&self, keyframe: KeyframeAnimation) -> Option<KeyframeId> {
-        self.inner
-            .upgrade()
-            .map(|inner| inner.lock().unwrap().keyframes.insert(keyframe))
+        self.inner.upgrade().map(|inner| {
+            let mut guard = inner.lock().unwrap();
+            if keyframe.is_playing() {
+                guard.mark_active();
+            }
+            guard.keyframes.insert(keyframe)
+        })
     }
 
     /// Get current keyframe animation value
@@ -718,8 +961,10 @@ impl SchedulerHandle {
     /// Start a keyframe animation
     pub fn start_keyframe(&self, id: KeyframeId) {
         if let Some(inner) = self.inner.upgrade() {
-            if let Some(keyframe) = inner.lock().unwrap().keyframes.get_mut(id) {
+            let mut guard = inner.lock().unwrap();
+            if let Some(keyframe) = guard.keyframes.get_mut(id) {
                 keyframe.start();
+                guard.mark_active();
             }
         }
     }
@@ -746,9 +991,13 @@ impl SchedulerHandle {
 
     /// Register a timeline and return its ID
     pub fn register_timeline(&self, timeline: Timeline) -> Option<TimelineId> {
-        self.inner
-            .upgrade()
-            .map(|inner| inner.lock().unwrap().timelines.insert(timeline))
+        self.inner.upgrade().map(|inner| {
+            let mut guard = inner.lock().unwrap();
+            if timeline.is_playing() {
+                guard.mark_active();
+            }
+            guard.timelines.insert(timeline)
+        })
     }
 
     /// Check if timeline is playing
@@ -769,8 +1018,10 @@ impl SchedulerHandle {
     /// Start a timeline
     pub fn start_timeline(&self, id: TimelineId) {
         if let Some(inner) = self.inner.upgrade() {
-            if let Some(timeline) = inner.lock().unwrap().timelines.get_mut(id) {
+            let mut guard = inner.lock().unwrap();
+            if let Some(timeline) = guard.timelines.get_mut(id) {
                 timeline.start();
+                guard.mark_active();
             }
         }
     }
@@ -800,12 +1051,15 @@ impl SchedulerHandle {
         F: FnOnce(&mut Timeline) -> R,
     {
         self.inner.upgrade().and_then(|inner| {
-            inner
-                .lock()
-                .unwrap()
-                .timelines
-                .get_mut(id)
-                .map(|timeline| f(timeline))
+            let mut guard = inner.lock().unwrap();
+            let (result, active) = guard.timelines.get_mut(id).map(|timeline| {
+                let result = f(timeline);
+                (result, timeline.is_playing())
+            })?;
+            if active {
+                guard.mark_active();
+            }
+            Some(result)
         })
     }
 
@@ -1649,6 +1903,116 @@ mod tests {
         assert!(value > 0.0);
     }
 
+    #[test]
+    fn test_scheduler_tick_at() {
+        let scheduler = AnimationScheduler::new();
+
+        let spring = Spring::new(SpringConfig::stiff(), 0.0);
+        let id = scheduler.add_spring(spring);
+        scheduler.set_spring_target(id, 100.0);
+
+        // Tick to a presentation time ahead of now
+        let target = Instant::now() + Duration::from_millis(16);
+        assert!(scheduler.tick_at(target));
+        let value = scheduler.get_spring_value(id).unwrap();
+        assert!(value > 0.0);
+
+        // A tick at an earlier time must not step the spring again
+        scheduler.tick_at(target - Duration::from_millis(8));
+        assert_eq!(scheduler.get_spring_value(id).unwrap(), value);
+    }
+
+    #[test]
+    fn test_activity_tracks_ticks_without_locking() {
+        let scheduler = AnimationScheduler::new();
+        let activity = scheduler.activity();
+        assert!(!activity.is_active());
+
+        let id = scheduler.add_spring(Spring::new(SpringConfig::stiff(), 0.0));
+        assert_eq!(activity.active_animations(), 0);
+        scheduler.set_spring_target(id, 100.0);
+        assert!(activity.is_active());
+
+        // Hold the lock: the activity must still be readable
+        let mut springs = scheduler.springs_iter_mut();
+        assert_eq!(activity.active_animations(), 1);
+        for (_, spring) in &mut springs {
+            spring.set_target(spring.value());
+        }
+        drop(springs);
+        assert!(!scheduler.has_active_animations());
+
+        scheduler.set_continuous_redraw(true);
+        assert!(activity.is_active());
+        assert_eq!(activity.active_animations(), 0);
+    }
+
+    #[test]
+    fn test_background_thread_wakes_on_new_animation() {
+        let (wake_tx, wake_rx) = std::sync::mpsc::channel();
+        let wake_tx = Mutex::new(wake_tx);
+
+        let mut scheduler = AnimationScheduler::new();
+        scheduler.set_wake_callback(move || {
+            let _ = wake_tx.lock().unwrap().send(());
+        });
+        scheduler.start_background();
+
+        let spring = Spring::new(SpringConfig::stiff(), 0.0);
+        let id = scheduler.add_spring(spring);
+        scheduler.set_spring_target(id, 100.0);
+
+        // The thread wakes the event loop after every tick; wait (bounded)
+        // for one that moved the spring
+        let deadline = Instant::now() + Duration::from_secs(5);
+        while scheduler.get_spring_value(id).unwrap() <= 0.0 {
+            let remaining = deadline.saturating_duration_since(Instant::now());
+            wake_rx
+                .recv_timeout(remaining)
+                .expect("background thread didn't wake for the new animation");
+        }
+        assert!(scheduler.take_needs_redraw());
+
+        scheduler.stop_background();
+        assert!(!scheduler.is_background_running());
+    }
+
+    #[test]
+    fn test_external_clock_wakes_once_per_activation() {
+        use std::sync::atomic::AtomicUsize;
+
+        let wakes = Arc::new(AtomicUsize::new(0));
+        let wakes_clone = Arc::clone(&wakes);
+
+        let mut scheduler = AnimationScheduler::new();
+        scheduler.set_wake_callback(move || {
+            wakes_clone.fetch_add(1, Ordering::SeqCst);
+        });
+        scheduler.start_external_clock();
+        assert!(scheduler.is_external_clock());
+        assert!(!scheduler.is_background_running());
+
+        let spring = Spring::new(SpringConfig::stiff(), 0.0);
+        let id = scheduler.add_spring(spring);
+        assert_eq!(wakes.load(Ordering::SeqCst), 0); // settled spring
+
+        // Retargeting while already active doesn't wake again
+        scheduler.set_spring_target(id, 100.0);
+        scheduler.set_spring_target(id, 50.0);
+        assert_eq!(wakes.load(Ordering::SeqCst), 1);
+
+        // Settle, then a new target is a new activation
+        let mut now = Instant::now();
+        loop {
+            now += Duration::from_millis(16);
+            if !scheduler.tick_at(now) {
+                break;
+            }
+        }
+        scheduler.set_spring_target(id, 0.0);
+        assert_eq!(wakes.load(Ordering::SeqCst), 2);
+    }
+
     #[test]
     fn test_animated_value() {
         let scheduler = AnimationScheduler::new();
@@ -112,6 +112,20 @@ impl Spring {
         }
     }
 
+    /// Rebuild a spring mid-flight (used by the packed spring store)
+    pub(crate) fn from_parts(config: SpringConfig, value: f32, velocity: f32, target: f32) -> Self {
+        Self {
+            config,
+            value,
+            velocity,
+            target,
+        }
+    }
+
+    pub fn config(&self) -> SpringConfig {
+        self.config
+    }
+
     pub fn value(&self) -> f32 {
         self.value
     }
@@ -130,12 +144,7 @@ impl Spring {
 
     /// Check if the spring has settled (within epsilon of target with minimal velocity)
     pub fn is_settled(&self) -> bool {
-        // Use small epsilons that work for both pixel-based values (scroll)
-        // and normalized values (scale, opacity). 0.01 is imperceptible in both cases.
-        const EPSILON: f32 = 0.01;
-        const VELOCITY_EPSILON: f32 = 0.1;
-
-        (self.value - self.target).abs() < EPSILON && self.velocity.abs() < VELOCITY_EPSILON
+        is_settled(self.value, self.velocity, self.target)
     }
 
     /// Step the spring simulation using RK4 integration
@@ -146,34 +155,62 @@ impl Spring {
             return;
         }
 
-        // RK4 integration for accurate spring physics
-        let k1_v = self.acceleration(self.value, self.velocity);
-        let k1_x = self.velocity;
-
-        let k2_v = self.acceleration(
-            self.value + k1_x * dt * 0.5,
-            self.velocity + k1_v * dt * 0.5,
+        (self.value, self.velocity) = rk4_step(
+            self.value,
+            self.velocity,
+            self.target,
+            self.config.stiffness,
+            self.config.damping,
+            self.config.mass,
+            dt,
         );
-        let k2_x = self.velocity + k1_v * dt * 0.5;
-
-        let k3_v = self.acceleration(
-            self.value + k2_x * dt * 0.5,
-            self.velocity + k2_v * dt * 0.5,
-        );
-        let k3_x = self.velocity + k2_v * dt * 0.5;
+    }
+}
 
-        let k4_v = self.acceleration(self.value + k3_x * dt, self.velocity + k3_v * dt);
-        let k4_x = self.velocity + k3_v * dt;
+/// Whether a spring at `value` moving at `velocity` has settled on `target`
+#[inline(always)]
+pub(crate) fn is_settled(value: f32, velocity: f32, target: f32) -> bool {
+    // Use small epsilons that work for both pixel-based values (scroll)
+    // and normalized values (scale, opacity). 0.01 is imperceptible in both cases.
+    const EPSILON: f32 = 0.01;
+    const VELOCITY_EPSILON: f32 = 0.1;
 
-        self.velocity += (k1_v + 2.0 * k2_v + 2.0 * k3_v + k4_v) * dt / 6.0;
-        self.value += (k1_x + 2.0 * k2_x + 2.0 * k3_x + k4_x) * dt / 6.0;
-    }
+    (value - target).abs() < EPSILON && velocity.abs() < VELOCITY_EPSILON
+}
 
-    fn acceleration(&self, x: f32, v: f32) -> f32 {
-        let spring_force = -self.config.stiffness * (x - self.target);
-        let damping_force = -self.config.damping * v;
-        (spring_force + damping_force) / self.config.mass
-    }
+/// One RK4 step of a damped spring, returning the new (value, velocity)
+///
+/// Branch-free so the packed spring store's loops over it vectorize.
+#[inline(always)]
+pub(crate) fn rk4_step(
+    x: f32,
+    v: f32,
+    target: f32,
+    stiffness: f32,
+    damping: f32,
+    mass: f32,
+    dt: f32,
+) -> (f32, f32) {
+    let acceleration =
+        |x: f32, v: f32| (-stiffness * (x - target) + -damping * v) / mass;
+
+    // RK4 integration for accurate spring physics
+    let k1_v = acceleration(x, v);
+    let k1_x = v;
+
+    let k2_v = acceleration(x + k1_x * dt * 0.5, v + k1_v * dt * 0.5);
+    let k2_x = v + k1_v * dt * 0.5;
+
+    let k3_v = acceleration(x + k2_x * dt * 0.5, v + k2_v * dt * 0.5);
+    let k3_x = v + k2_v * dt * 0.5;
+
+    let k4_v = acceleration(x + k3_x * dt, v + k3_v * dt);
+    let k4_x = v + k3_v * dt;
+
+    (
+        x + (k1_x + 2.0 * k2_x + 2.0 * k3_x + k4_x) * dt / 6.0,
+        v + (k1_v + 2.0 * k2_v + 2.0 * k3_v + k4_v) * dt / 6.0,
+    )
 }
 
 // =============================================================================
@@ -0,0 +1,324 @@
+//! Packed spring storage
+//!
+//! Springs live in structure-of-arrays form: value, velocity, target and
+//! the spring constants each sit in their own contiguous `Vec<f32>`, so a
+//! tick is one branch-free loop over equal-length slices that the compiler
+//! vectorizes (SSE/AVX on x86, NEON on ARM) instead of stepping one
+//! `Spring` at a time.
+//!
+//! Moving springs are kept at the front of the arrays. A spring that settles
+//! is compacted out of that range, so a tick only touches springs that are
+//! moving and the active count is a field read. `SpringId`s stay stable
+//! through the compaction: they are generational keys into a slot map that
+//! records where each spring currently sits.
+
+use slotmap::SlotMap;
+
+use crate::scheduler::SpringId;
+use crate::spring::{is_settled, rk4_step, Spring, SpringConfig};
+
+/// Structure-of-arrays spring store
+pub(crate) struct SpringStore {
+    /// Where each live spring sits in the arrays below
+    slots: SlotMap<SpringId, usize>,
+    /// Owner of each packed entry (for fixing up `slots` after a swap)
+    ids: Vec<SpringId>,
+    value: Vec<f32>,
+    velocity: Vec<f32>,
+    target: Vec<f32>,
+    stiffness: Vec<f32>,
+    damping: Vec<f32>,
+    mass: Vec<f32>,
+    /// Entries `..active` are moving; the rest are at rest on their target
+    active: usize,
+}
+
+impl SpringStore {
+    pub(crate) fn new() -> Self {
+        Self {
+            slots: SlotMap::with_key(),
+            ids: Vec::new(),
+            value: Vec::new(),
+            velocity: Vec::new(),
+            target: Vec::new(),
+            stiffness: Vec::new(),
+            damping: Vec::new(),
+            mass: Vec::new(),
+            active: 0,
+        }
+    }
+
+    /// Number of springs, moving or not
+    pub(crate) fn len(&self) -> usize {
+        self.ids.len()
+    }
+
+    /// Number of springs that haven't settled
+    pub(crate) fn active_len(&self) -> usize {
+        self.active
+    }
+
+    pub(crate) fn insert(&mut self, spring: Spring) -> SpringId {
+        let index = self.ids.len();
+        let id = self.slots.insert(index);
+        let config = spring.config();
+        self.ids.push(id);
+        self.value.push(spring.value());
+        self.velocity.push(spring.velocity());
+        self.target.push(spring.target());
+        self.stiffness.push(config.stiffness);
+        self.damping.push(config.damping);
+        self.mass.push(config.mass);
+        self.place(index);
+        id
+    }
+
+    pub(crate) fn get(&self, id: SpringId) -> Option<Spring> {
+        self.slots.get(id).map(|&index| self.spring_at(index))
+    }
+
+    /// Modify a spring through a `Spring` view of it
+    pub(crate) fn update<R>(
+        &mut self,
+        id: SpringId,
+        f: impl FnOnce(&mut Spring) -> R,
+    ) -> Option<R> {
+        let index = *self.slots.get(id)?;
+        let mut spring = self.spring_at(index);
+        let result = f(&mut spring);
+        self.write(index, &spring);
+        self.place(index);
+        Some(result)
+    }
+
+    pub(crate) fn remove(&mut self, id: SpringId) -> Option<Spring> {
+        let mut index = self.slots.remove(id)?;
+        let spring = self.spring_at(index);
+
+        // Keep the moving range contiguous: pull the entry to its end first
+        if index < self.active {
+            self.active -= 1;
+            self.swap(index, self.active);
+            index = self.active;
+        }
+        let last = self.ids.len() - 1;
+        self.swap(index, last);
+        self.ids.pop();
+        self.value.pop();
+        self.velocity.pop();
+        self.target.pop();
+        self.stiffness.pop();
+        self.damping.pop();
+        self.mass.pop();
+        Some(spring)
+    }
+
+    /// All springs as owned values, for callers that need `&mut Spring`
+    ///
+    /// Hand them back with `write_back` to apply changes.
+    pub(crate) fn snapshot(&self) -> Vec<(SpringId, Spring)> {
+        (0..self.ids.len())
+            .map(|index| (self.ids[index], self.spring_at(index)))
+            .collect()
+    }
+
+    /// Store springs taken with `snapshot`
+    pub(crate) fn write_back(&mut self, springs: &[(SpringId, Spring)]) {
+        for (id, spring) in springs {
+            if let Some(&index) = self.slots.get(*id) {
+                self.write(index, spring);
+            }
+        }
+        // Springs may have started or stopped in any order
+        self.active = 0;
+        for index in 0..self.ids.len() {
+            self.place(index);
+        }
+    }
+
+    /// Step every moving spring by `dt` seconds
+    ///
+    /// Returns the number still moving afterwards.
+    pub(crate) fn step(&mut self, dt: f32) -> usize {
+        // Slicing everything to the same length lets the bounds checks go,
+        // which is what allows the loop to vectorize
+        let n = self.active;
+        let value = &mut self.value[..n];
+        let velocity = &mut self.velocity[..n];
+        let target = &self.target[..n];
+        let stiffness = &self.stiffness[..n];
+        let damping = &self.damping[..n];
+        let mass = &self.mass[..n];
+        for i in 0..n {
+            (value[i], velocity[i]) = rk4_step(
+                value[i],
+                velocity[i],
+                target[i],
+                stiffness[i],
+                damping[i],
+                mass[i],
+                dt,
+            );
+        }
+
+        self.compact();
+        self.active
+    }
+
+    /// Move springs that settled during a step out of the moving range
+    fn compact(&mut self) {
+        let mut index = 0;
+        while index < self.active {
+            if is_settled(self.value[index], self.velocity[index], self.target[index]) {
+                self.rest(index);
+                self.active -= 1;
+                self.swap(index, self.active);
+            } else {
+                index += 1;
+            }
+        }
+    }
+
+    /// Put the entry at `index` on the right side of the moving boundary
+    ///
+    /// Everything before `index` must already be placed.
+    fn place(&mut self, index: usize) {
+        let settled = is_settled(self.value[index], self.velocity[index], self.target[index]);
+        if settled {
+            self.rest(index);
+            if index < self.active {
+                self.active -= 1;
+                self.swap(index, self.active);
+            }
+        } else if index >= self.active {
+            self.swap(index, self.active);
+            self.active += 1;
+        }
+    }
+
+    /// Snap a settled spring onto its target, as `Spring::step` would
+    fn rest(&mut self, index: usize) {
+        self.value[index] = self.target[index];
+        self.velocity[index] = 0.0;
+    }
+
+    fn swap(&mut self, a: usize, b: usize) {
+        if a == b {
+            return;
+        }
+        self.ids.swap(a, b);
+        self.value.swap(a, b);
+        self.velocity.swap(a, b);
+        self.target.swap(a, b);
+        self.stiffness.swap(a, b);
+        self.damping.swap(a, b);
+        self.mass.swap(a, b);
+        // One side may be an entry whose slot was just removed
+        for index in [a, b] {
+            if let Some(slot) = self.slots.get_mut(self.ids[index]) {
+                *slot = index;
+            }
+        }
+    }
+
+    fn spring_at(&self, index: usize) -> Spring {
+        Spring::from_parts(
+            SpringConfig::new(self.stiffness[index], self.damping[index], self.mass[index]),
+            self.value[index],
+            self.velocity[index],
+            self.target[index],
+        )
+    }
+
+    fn write(&mut self, index: usize, spring: &Spring) {
+        let config = spring.config();
+        self.value[index] = spring.value();
+        self.velocity[index] = spring.velocity();
+        self.target[index] = spring.target();
+        self.stiffness[index] = config.stiffness;
+        self.damping[index] = config.damping;
+        self.mass[index] = config.mass;
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn moving(target: f32) -> Spring {
+        let mut spring = Spring::new(SpringConfig::wobbly(), 0.0);
+        spring.set_target(target);
+        spring
+    }
+
+    #[test]
+    fn test_step_matches_scalar_spring() {
+        let mut store = SpringStore::new();
+        let mut scalar: Vec<(SpringId, Spring)> = (0..21)
+            .map(|i| {
+                let spring = moving(10.0 * (i + 1) as f32);
+                (store.insert(spring), spring)
+            })
+            .collect();
+
+        for _ in 0..30 {
+            store.step(1.0 / 60.0);
+            for (_, spring) in &mut scalar {
+                spring.step(1.0 / 60.0);
+            }
+        }
+        for (id, spring) in &scalar {
+            assert_eq!(store.get(*id).unwrap().value(), spring.value());
+            assert_eq!(store.get(*id).unwrap().velocity(), spring.velocity());
+        }
+    }
+
+    #[test]
+    fn test_settled_springs_leave_active_range() {
+        let mut store = SpringStore::new();
+        let idle = store.insert(Spring::new(SpringConfig::stiff(), 5.0));
+        let fast = store.insert(moving(1.0));
+        let slow = store.insert(Spring::new(SpringConfig::molasses(), 0.0));
+        store.update(slow, |s| s.set_target(100.0));
+        assert_eq!(store.len(), 3);
+        assert_eq!(store.active_len(), 2);
+
+        while !store.get(fast).unwrap().is_settled() {
+            store.step(1.0 / 60.0);
+        }
+        assert_eq!(store.active_len(), 1);
+        assert_eq!(store.get(fast).unwrap().value(), 1.0);
+        assert!(!store.get(slow).unwrap().is_settled());
+        assert_eq!(store.get(idle).unwrap().value(), 5.0);
+
+        // Ids survive removal of other springs
+        assert!(store.remove(fast).is_some());
+        assert!(store.get(fast).is_none());
+        assert_eq!(store.active_len(), 1);
+        assert_eq!(store.get(idle).unwrap().value(), 5.0);
+        assert_eq!(store.get(slow).unwrap().target(), 100.0);
+        store.remove(slow);
+        assert_eq!(store.active_len(), 0);
+        assert_eq!(store.len(), 1);
+    }
+
+    #[test]
+    fn test_write_back_repartitions() {
+        let mut store = SpringStore::new();
+        let a = store.insert(moving(50.0));
+        let b = store.insert(Spring::new(SpringConfig::stiff(), 0.0));
+
+        let mut springs = store.snapshot();
+        for (id, spring) in &mut springs {
+            if *id == a {
+                spring.set_target(spring.value());
+            } else {
+                spring.set_target(20.0);
+            }
+        }
+        store.write_back(&springs);
+        assert_eq!(store.active_len(), 1);
+        assert!(store.get(a).unwrap().is_settled());
+        assert_eq!(store.get(b).unwrap().target(), 20.0);
+    }
+}
@@ -155,7 +155,9 @@ impl AndroidApp {
         // Animation scheduler - single-threaded for mobile efficiency
         // Unlike desktop, we tick animations on main thread to avoid mutex contention
         // and high CPU usage from background thread + main thread fighting
-        let scheduler = AnimationScheduler::new();
+        let mut scheduler = AnimationScheduler::new();
+        scheduler.start_external_clock();
+        let animation_activity = scheduler.activity();
         let animations: SharedAnimationScheduler = Arc::new(Mutex::new(scheduler));
 
         // Set global scheduler handle
@@ -258,8 +260,12 @@ impl AndroidApp {
                                 let height = window.height() as u32;
                                 tracing::info!("Window size: {}x{}", width, height);
 
-                                // Initialize GPU with native window
-                                match Self::init_gpu(&window) {
+                                // Initialize GPU with native window, persisting
+                                // compiled Vulkan pipelines in app-private storage
+                                let cache_dir = app
+                                    .internal_data_path()
+                                    .map(|dir| dir.join("pipeline-cache"));
+                                match Self::init_gpu(&window, cache_dir) {
                                     Ok((app_instance, surf)) => {
                                         let format = app_instance.texture_format();
                                         let config = wgpu::SurfaceConfiguration {
@@ -712,8 +718,8 @@ impl AndroidApp {
 
                 // Apply prop updates to the tree
                 if let Some(ref mut tree) = render_tree {
-                    for (node_id, props) in &prop_updates {
-                        tree.update_render_props(*node_id, |p| *p = props.clone());
+                    for (node_id, props) in prop_updates {
+                        tree.update_render_props(node_id, |p| *p = props);
                     }
                 }
 
@@ -886,11 +892,9 @@ impl AndroidApp {
             // PHASE 4: Check if we need another frame for animations
             // =========================================================
             {
-                // Check animation scheduler for active animations
-                if let Ok(scheduler) = animations.lock() {
-                    if scheduler.has_active_animations() {
-                        needs_redraw_next_frame = true;
-                    }
+                // Check animation scheduler for active animations (lock-free)
+                if animation_activity.active_animations() > 0 {
+                    needs_redraw_next_frame = true;
                 }
 
                 // Check for animating stateful elements (spring animations, state transitions)
@@ -910,7 +914,10 @@ impl AndroidApp {
     }
 
     /// Initialize GPU with a native window
-    fn init_gpu(window: &NativeWindow) -> Result<(BlincApp, wgpu::Surface<'static>)> {
+    fn init_gpu(
+        window: &NativeWindow,
+        pipeline_cache_dir: Option<std::path::PathBuf>,
+    ) -> Result<(BlincApp, wgpu::Surface<'static>)> {
         use blinc_gpu::{GpuRenderer, RendererConfig, TextRenderingContext};
 
         let config = crate::BlincConfig::default();
@@ -922,6 +929,9 @@ impl AndroidApp {
             sample_count: 1,
             texture_format: None,
             unified_text_rendering: true,
+            pipeline_cache_dir,
+            background_pipeline_compilation: true,
+            blur_mode: blinc_gpu::BlurMode::Quality,
         };
 
         // Create instance with Vulkan backend
@@ -2,12 +2,12 @@
 //!
 //! The main entry point for Blinc applications.
 
-use blinc_gpu::{FontRegistry, GpuRenderer, RendererConfig, TextRenderingContext};
+use blinc_gpu::{BlurMode, FontRegistry, GpuRenderer, RendererConfig, TextRenderingContext};
 use blinc_layout::prelude::*;
-use blinc_layout::RenderTree;
+use blinc_layout::{Damage, RenderTree};
 use std::sync::{Arc, Mutex};
 
-use crate::context::RenderContext;
+use crate::context::{DisplayList, MemoryPressure, MemoryUsage, RenderContext, RenderStats};
 use crate::error::{BlincError, Result};
 
 /// Blinc application configuration
@@ -83,6 +83,9 @@ impl BlincApp {
             sample_count: 1, // SDF pipelines always use single-sampled textures
             texture_format: None,
             unified_text_rendering: true,
+            pipeline_cache_dir: None,
+            background_pipeline_compilation: true,
+            blur_mode: BlurMode::Quality,
         };
 
         let renderer = pollster::block_on(GpuRenderer::new(renderer_config))
@@ -224,6 +227,81 @@ impl BlincApp {
             .render_tree_with_motion(tree, render_state, width, height, target)
     }
 
+    /// Render a render tree with motion animations, repainting only `damage`
+    ///
+    /// Pass the result of `RenderTree::take_damage`. Without partial redraw
+    /// enabled this behaves like `render_tree_with_motion`.
+    pub fn render_tree_with_damage(
+        &mut self,
+        tree: &RenderTree,
+        render_state: &blinc_layout::RenderState,
+        damage: &Damage,
+        target: &wgpu::TextureView,
+        width: u32,
+        height: u32,
+    ) -> Result<()> {
+        self.ctx
+            .render_tree_with_damage(tree, render_state, damage, width, height, target)
+    }
+
+    /// Render a frame recorded with `DisplayList::record`
+    ///
+    /// Lets the UI thread record frames while another thread owns the app
+    /// and does the GPU encoding.
+    pub fn render_display_list(
+        &mut self,
+        list: &DisplayList,
+        target: &wgpu::TextureView,
+    ) -> Result<()> {
+        self.ctx.render_display_list(list, target)
+    }
+
+    /// Counters and timings for the most recently rendered frame
+    pub fn last_render_stats(&self) -> RenderStats {
+        self.ctx.last_render_stats()
+    }
+
+    /// Enable partial redraws of damaged regions over a retained frame
+    pub fn set_partial_redraw(&mut self, enabled: bool) {
+        self.ctx.set_partial_redraw(enabled);
+    }
+
+    /// Choose between full resolution and downsampled pyramid blurs
+    pub fn set_blur_mode(&mut self, mode: BlurMode) {
+        self.ctx.set_blur_mode(mode);
+    }
+
+    /// How blurs are currently filtered
+    pub fn blur_mode(&self) -> BlurMode {
+        self.ctx.blur_mode()
+    }
+
+    /// Change the MSAA sample count at runtime (`config().sample_count` keeps
+    /// the configured value)
+    pub fn set_sample_count(&mut self, sample_count: u32) {
+        self.ctx.set_sample_count(sample_count);
+    }
+
+    /// MSAA sample count currently used for paths
+    pub fn sample_count(&self) -> u32 {
+        self.ctx.sample_count()
+    }
+
+    /// Damage applied to the most recently rendered frame (physical pixels)
+    pub fn last_damage(&self) -> &Damage {
+        self.ctx.last_damage()
+    }
+
+    /// Release cached GPU and CPU resources in response to memory pressure
+    pub fn trim_memory(&mut self, level: MemoryPressure) {
+        self.ctx.trim_memory(level);
+    }
+
+    /// Estimated bytes held by the renderer's caches
+    pub fn memory_usage(&self) -> MemoryUsage {
+        self.ctx.memory_usage()
+    }
+
     /// Render an overlay tree on top of existing content (no clear)
     ///
     /// This is used for rendering modal/dialog/toast overlays on top of the main UI.
@@ -277,6 +355,11 @@ impl BlincApp {
         self.ctx.font_registry()
     }
 
+    /// Get the text rendering context display lists are recorded with
+    pub fn text_context(&self) -> &Arc<Mutex<TextRenderingContext>> {
+        self.ctx.text_context()
+    }
+
     /// Load font data into the text rendering registry
     ///
     /// This adds fonts that will be available for text rendering.
@@ -288,6 +371,24 @@ impl BlincApp {
         self.ctx.load_font_data_to_registry(data)
     }
 
+    /// Register a font file by path without reading it
+    ///
+    /// Only the table directory is parsed now; the file is memory-mapped
+    /// when a face is first used. Returns the number of font faces added.
+    pub fn load_font_file_to_registry(&mut self, path: &std::path::Path) -> usize {
+        self.ctx.load_font_file_to_registry(path)
+    }
+
+    /// Register font data owned elsewhere (e.g. mapped platform data) without copying it
+    ///
+    /// Returns the number of font faces added.
+    pub fn load_shared_font_data_to_registry(
+        &mut self,
+        data: Arc<dyn AsRef<[u8]> + Send + Sync>,
+    ) -> usize {
+        self.ctx.load_shared_font_data_to_registry(data)
+    }
+
     /// Create a new Blinc application with a window surface
     ///
     /// This creates a GPU renderer optimized for the given window and returns
@@ -324,6 +425,9 @@ impl BlincApp {
             sample_count: 1,
             texture_format: None,
             unified_text_rendering: true,
+            pipeline_cache_dir: None,
+            background_pipeline_compilation: true,
+            blur_mode: BlurMode::Quality,
         };
 
         let (renderer, surface) =
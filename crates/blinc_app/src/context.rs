@@ -6,26 +6,57 @@ use blinc_core::{
     Brush, Color, CornerRadius, DrawCommand, DrawContext, DrawContextExt, Rect, Stroke,
 };
 use blinc_gpu::{
-    FontRegistry, GenericFont as GpuGenericFont, GpuGlyph, GpuImage, GpuImageInstance,
-    GpuPaintContext, GpuPrimitive, GpuRenderer, ImageRenderingContext, PrimitiveBatch,
-    TextAlignment, TextAnchor, TextRenderingContext,
+    AtlasPageStats, BlurMode, FontRegistry, GenericFont as GpuGenericFont, GpuGlyph, GpuImage,
+    GpuImageInstance, GpuPaintContext, GpuPrimitive, GpuRenderer, ImageRenderingContext,
+    LayerTexture, PrimitiveBatch, TextAlignment, TextAnchor, TextRenderingContext,
 };
+use blinc_image::ImageDecoder;
+use blinc_layout::damage::Damage;
 use blinc_layout::div::{FontFamily, FontWeight, GenericFont, TextAlign, TextVerticalAlign};
 use blinc_layout::prelude::*;
 use blinc_layout::render_state::Overlay;
 use blinc_layout::renderer::ElementType;
-use blinc_svg::{RasterizedSvg, SvgDocument};
+use blinc_layout::SharedUpdateQueue;
+use blinc_svg::{content_hash, global_svg_cache, SvgDocument};
+use blinc_text::FrameClient;
 use lru::LruCache;
 use std::collections::hash_map::DefaultHasher;
+use std::collections::HashSet;
 use std::hash::{Hash, Hasher};
 use std::num::NonZeroUsize;
+use std::sync::atomic::{AtomicU32, Ordering};
 use std::sync::{Arc, Mutex};
+use std::time::{Duration, Instant};
 
 use crate::error::Result;
 
+/// Atlas frame client for the next render context (0 is `DEFAULT_FRAME_CLIENT`)
+static NEXT_FRAME_CLIENT: AtomicU32 = AtomicU32::new(1);
+
 /// Maximum number of images to keep in cache (prevents unbounded memory growth)
 const IMAGE_CACHE_CAPACITY: usize = 128;
 
+/// Callback run on a decoder thread after an image finishes decoding
+type ImageReadyCallback = Arc<dyn Fn() + Send + Sync>;
+
+/// Make finished decodes request a redraw on `queue`, then run `callback`
+///
+/// Decoder threads never enter a queue, so the queue is bound here rather
+/// than looked up when the decode finishes.
+fn bind_image_decoder(
+    decoder: &ImageDecoder,
+    queue: &SharedUpdateQueue,
+    callback: Option<ImageReadyCallback>,
+) {
+    let queue = queue.clone();
+    decoder.set_on_ready(move || {
+        queue.request_redraw();
+        if let Some(ref callback) = callback {
+            callback();
+        }
+    });
+}
+
 /// Maximum number of parsed SVG documents to cache
 const SVG_CACHE_CAPACITY: usize = 64;
 
@@ -33,10 +64,77 @@ const SVG_CACHE_CAPACITY: usize = 64;
 /// Key is (svg_hash, width, height, tint_hash) - separate textures for different sizes/tints
 const RASTERIZED_SVG_CACHE_CAPACITY: usize = 64;
 
+/// GPU image and SVG caches, shared by render contexts on the same device
+struct ImageCaches {
+    // LRU cache for images (prevents unbounded memory growth)
+    image_cache: LruCache<String, GpuImage>,
+    // Sources whose cached texture was downsampled to the requesting element
+    downsampled_images: HashSet<String>,
+    // Sources that failed to decode, not retried until caches are trimmed
+    failed_images: HashSet<String>,
+    // LRU cache for parsed SVG documents (avoids re-parsing)
+    svg_cache: LruCache<u64, SvgDocument>,
+    // LRU cache for rasterized SVG textures (CPU-rasterized with proper AA),
+    // untinted - tint is applied by the image shader
+    rasterized_svg_cache: LruCache<u64, GpuImage>,
+    // Sources retained in the global SVG cache, released when trimming
+    svg_sources: HashSet<u64>,
+}
+
+impl ImageCaches {
+    fn new() -> Self {
+        Self {
+            image_cache: LruCache::new(NonZeroUsize::new(IMAGE_CACHE_CAPACITY).unwrap()),
+            downsampled_images: HashSet::new(),
+            failed_images: HashSet::new(),
+            svg_cache: LruCache::new(NonZeroUsize::new(SVG_CACHE_CAPACITY).unwrap()),
+            rasterized_svg_cache: LruCache::new(
+                NonZeroUsize::new(RASTERIZED_SVG_CACHE_CAPACITY).unwrap(),
+            ),
+            svg_sources: HashSet::new(),
+        }
+    }
+}
+
+impl Drop for ImageCaches {
+    fn drop(&mut self) {
+        global_svg_cache().release_sources(self.svg_sources.drain());
+    }
+}
+
+/// Text and image resources that several render contexts can share
+///
+/// Contexts created with `RenderContext::with_shared` from clones of the same
+/// value use one glyph atlas and one set of image and SVG textures, so a
+/// second window or embedded view doesn't rasterize and upload everything
+/// again. All contexts must render with the device the resources were
+/// created on.
+#[derive(Clone)]
+pub struct SharedRenderResources {
+    text_ctx: Arc<Mutex<TextRenderingContext>>,
+    images: Arc<Mutex<ImageCaches>>,
+}
+
+impl SharedRenderResources {
+    /// Wrap a text rendering context, with empty image caches
+    pub fn new(text_ctx: TextRenderingContext) -> Self {
+        Self {
+            text_ctx: Arc::new(Mutex::new(text_ctx)),
+            images: Arc::new(Mutex::new(ImageCaches::new())),
+        }
+    }
+
+    /// Get the shared text rendering context
+    pub fn text_context(&self) -> &Arc<Mutex<TextRenderingContext>> {
+        &self.text_ctx
+    }
+}
+
 /// Internal render context that manages GPU resources and rendering
 pub struct RenderContext {
     renderer: GpuRenderer,
-    text_ctx: TextRenderingContext,
+    // Glyph atlases, possibly shared with other contexts
+    text_ctx: Arc<Mutex<TextRenderingContext>>,
     image_ctx: ImageRenderingContext,
     device: Arc<wgpu::Device>,
     queue: Arc<wgpu::Queue>,
@@ -45,17 +143,57 @@ pub struct RenderContext {
     backdrop_texture: Option<CachedTexture>,
     // Cached MSAA texture for anti-aliased rendering
     msaa_texture: Option<CachedTexture>,
-    // LRU cache for images (prevents unbounded memory growth)
-    image_cache: LruCache<String, GpuImage>,
-    // LRU cache for parsed SVG documents (avoids re-parsing)
-    svg_cache: LruCache<u64, SvgDocument>,
-    // LRU cache for rasterized SVG textures (CPU-rasterized with proper AA)
-    rasterized_svg_cache: LruCache<u64, GpuImage>,
+    // Image and SVG textures, possibly shared with other contexts
+    images: Arc<Mutex<ImageCaches>>,
+    // Decodes images on worker threads so first use doesn't stall a frame
+    image_decoder: ImageDecoder,
+    // Queue finished decodes request a redraw on
+    update_queue: SharedUpdateQueue,
+    // Extra callback for finished decodes (see `set_image_ready_callback`)
+    image_ready_callback: Option<ImageReadyCallback>,
+    // Whether `preload_images` decodes in the background (else inline)
+    async_image_decode: bool,
+    // SVGs at least this large are tessellated instead of rasterized
+    svg_tessellation_min_size: Option<f32>,
     // Scratch buffers for per-frame allocations (reused to avoid allocations)
     scratch_glyphs: Vec<GpuGlyph>,
     scratch_texts: Vec<TextElement>,
     scratch_svgs: Vec<SvgElement>,
     scratch_images: Vec<ImageElement>,
+    // Counters and timings for the last frame encoded by `render_recorded`
+    last_stats: RenderStats,
+    // Layer texture pool (hits, misses) at the end of the last frame
+    layer_cache_lookups: (u64, u64),
+    // Whether frames may be redrawn partially on top of `retained_frame`
+    partial_redraw: bool,
+    // Previous frame, kept while partial redraw is enabled
+    retained_frame: Option<LayerTexture>,
+    // Damage applied to the last frame (physical pixels)
+    last_damage: Damage,
+    // Identifies this context's frames to the (possibly shared) glyph atlases
+    frame_client: FrameClient,
+}
+
+/// Counters and timings for the most recently encoded frame
+#[derive(Clone, Copy, Debug, Default)]
+pub struct RenderStats {
+    /// CPU time spent preparing text and encoding/submitting GPU work
+    pub encode_time: Duration,
+    /// Time spent waiting for the GPU to finish after the last submit
+    pub gpu_time: Duration,
+    /// Primitives in the frame's batch (background, foreground and glass)
+    pub primitives: u32,
+    /// Text glyphs drawn
+    pub glyphs: u32,
+    /// Draw calls issued since the previous frame
+    pub draw_calls: u32,
+    /// Layer texture pool hit rate over this frame's lookups (0.0 - 1.0,
+    /// 0.0 when the frame used no layer textures)
+    pub layer_cache_hit_rate: f32,
+    /// Damage rects redrawn (0 for full repaints and reused frames)
+    pub damage_rects: u32,
+    /// Fraction of the surface repainted (0.0 - 1.0)
+    pub damage_fraction: f32,
 }
 
 struct CachedTexture {
@@ -66,6 +204,7 @@ struct CachedTexture {
 }
 
 /// Text element data for rendering
+#[derive(Clone)]
 struct TextElement {
     content: String,
     x: f32,
@@ -102,9 +241,13 @@ struct TextElement {
     strikethrough: bool,
     /// Whether text has underline decoration
     underline: bool,
+    /// Scroll content this element moves with (index into the collected
+    /// `ScrollContent`)
+    scroll_group: Option<usize>,
 }
 
 /// Image element data for rendering
+#[derive(Clone)]
 struct ImageElement {
     source: String,
     x: f32,
@@ -134,9 +277,13 @@ struct ImageElement {
     border_width: f32,
     /// Border color
     border_color: blinc_core::Color,
+    /// Scroll content this element moves with (index into the collected
+    /// `ScrollContent`)
+    scroll_group: Option<usize>,
 }
 
 /// SVG element data for rendering
+#[derive(Clone)]
 struct SvgElement {
     source: String,
     x: f32,
@@ -149,6 +296,24 @@ struct SvgElement {
     clip_bounds: Option<[f32; 4]>,
     /// Motion opacity inherited from parent motion container
     motion_opacity: f32,
+    /// Scroll content this element moves with (index into the collected
+    /// `ScrollContent`)
+    scroll_group: Option<usize>,
+}
+
+/// A scroll container's content, as collected with the element lists
+#[derive(Clone)]
+struct ScrollContent {
+    node: LayoutNodeId,
+    /// Clip (logical pixels) shared by every element directly in the content
+    clip: Option<[f32; 4]>,
+    /// Scroll offset (logical pixels) the elements are positioned for
+    offset: (f32, f32),
+    /// Whether offsetting the elements is enough to move the content
+    ///
+    /// False if it contains nested scroll containers or elements clipped by
+    /// something inside the content.
+    movable: bool,
 }
 
 /// Debug bounds element for layout visualization
@@ -164,6 +329,244 @@ struct DebugBoundsElement {
     depth: u32,
 }
 
+/// How much `RenderContext::trim_memory` should release
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum MemoryPressure {
+    /// Drop pooled layer textures and the image/SVG caches
+    Moderate,
+    /// Also shrink the glyph atlases and release MSAA/backdrop targets
+    Critical,
+}
+
+/// Estimated bytes held by the render context's caches
+#[derive(Clone, Copy, Debug, Default)]
+pub struct MemoryUsage {
+    /// Unused textures pooled by the layer texture cache
+    pub layer_pool_bytes: u64,
+    /// Textures held for named layers
+    pub layer_named_bytes: u64,
+    /// Decoded images
+    pub image_cache_bytes: u64,
+    /// Rasterized SVG textures
+    pub svg_cache_bytes: u64,
+    /// Grayscale glyph atlas (CPU and GPU copies)
+    pub glyph_atlas_bytes: u64,
+    /// Color (emoji) glyph atlas (CPU and GPU copies)
+    pub color_glyph_atlas_bytes: u64,
+    /// MSAA, glass backdrop and retained frame render targets
+    pub render_target_bytes: u64,
+}
+
+impl MemoryUsage {
+    /// Sum of all tracked caches
+    pub fn total_bytes(&self) -> u64 {
+        self.layer_pool_bytes
+            + self.layer_named_bytes
+            + self.image_cache_bytes
+            + self.svg_cache_bytes
+            + self.glyph_atlas_bytes
+            + self.color_glyph_atlas_bytes
+            + self.render_target_bytes
+    }
+}
+
+/// An immutable snapshot of one frame, ready to be encoded on any thread
+///
+/// Recording walks the `RenderTree` and `RenderState` (which must stay on the
+/// UI thread) and captures everything the GPU pass needs: the primitive
+/// batch, text/SVG/image elements and overlays. The list is then handed to
+/// whoever owns the `RenderContext`, typically a dedicated render thread.
+///
+/// Canvas `draw_text` calls are shaped while recording, into the render
+/// context's glyph atlases (see `RenderContext::text_context`).
+///
+/// A list can be kept and reused while only scroll offsets change: see
+/// `apply_scroll`.
+#[derive(Clone)]
+pub struct DisplayList {
+    batch: PrimitiveBatch,
+    texts: Vec<TextElement>,
+    svgs: Vec<SvgElement>,
+    images: Vec<ImageElement>,
+    scroll: Vec<ScrollContent>,
+    overlays: Vec<Overlay>,
+    scale_factor: f32,
+    width: u32,
+    height: u32,
+    damage: Damage,
+}
+
+impl DisplayList {
+    /// Record a frame from a render tree with motion animations applied
+    ///
+    /// `text_ctx` must be the text context of the render context that will
+    /// draw the list; it is locked while the tree is painted.
+    pub fn record(
+        tree: &RenderTree,
+        render_state: &blinc_layout::RenderState,
+        text_ctx: &Mutex<TextRenderingContext>,
+        width: u32,
+        height: u32,
+    ) -> Self {
+        let mut text_ctx = text_ctx.lock().unwrap();
+        let mut ctx =
+            GpuPaintContext::with_text_context(width as f32, height as f32, &mut text_ctx);
+        tree.render_with_motion(&mut ctx, render_state);
+        let batch = ctx.take_batch();
+        drop(text_ctx);
+
+        let mut texts = Vec::new();
+        let mut svgs = Vec::new();
+        let mut images = Vec::new();
+        let mut scroll = Vec::new();
+        RenderContext::collect_elements_into(
+            tree,
+            Some(render_state),
+            &mut texts,
+            &mut svgs,
+            &mut images,
+            &mut scroll,
+        );
+
+        Self {
+            batch,
+            texts,
+            svgs,
+            images,
+            scroll,
+            overlays: render_state.overlays().to_vec(),
+            scale_factor: tree.scale_factor(),
+            width,
+            height,
+            damage: Damage::Full,
+        }
+    }
+
+    /// Attach the tree's damage for this frame (see `RenderTree::take_damage`)
+    ///
+    /// Lists default to `Damage::Full`. Only used when the render context has
+    /// partial redraw enabled.
+    pub fn with_damage(mut self, damage: Damage) -> Self {
+        self.damage = damage;
+        self
+    }
+
+    /// Replace the damage attached with `with_damage`
+    pub fn set_damage(&mut self, damage: Damage) {
+        self.damage = damage;
+    }
+
+    /// Damage attached with `with_damage`
+    pub fn damage(&self) -> &Damage {
+        &self.damage
+    }
+
+    /// Surface size (in physical pixels) this list was recorded for
+    pub fn size(&self) -> (u32, u32) {
+        (self.width, self.height)
+    }
+
+    /// Whether the list has scroll content that `apply_scroll` could move
+    pub fn has_scroll_content(&self) -> bool {
+        !self.scroll.is_empty()
+    }
+
+    /// Move scroll content to the tree's current scroll offsets
+    ///
+    /// For frames where only scroll offsets changed (see
+    /// `RenderTree::damage_is_scroll_only`): content that scrolled is
+    /// translated in place and every scrollbar is redrawn, without walking the
+    /// tree or running layout. Recording doesn't cull offscreen content, so
+    /// whatever scrolls into view is already in the list.
+    ///
+    /// Returns false if content that scrolled can't be moved by translation
+    /// or a scrollbar changed shape; the list is then partly updated and must
+    /// be recorded again.
+    pub fn apply_scroll(&mut self, tree: &RenderTree) -> bool {
+        let scale = self.scale_factor;
+        for i in 0..self.scroll.len() {
+            let node = self.scroll[i].node;
+            let group = self.batch.scroll_group(node.to_raw());
+
+            let offset = tree.get_scroll_offset(node);
+            let recorded = self.scroll[i].offset;
+            if offset != recorded {
+                let primitives_movable =
+                    group.map_or(true, |g| self.batch.scroll_groups[g].movable);
+                if !self.scroll[i].movable || !primitives_movable {
+                    return false;
+                }
+
+                let dx = (offset.0 - recorded.0) * scale;
+                let dy = (offset.1 - recorded.1) * scale;
+                if let Some(g) = group {
+                    self.batch.translate_scroll_group(g, dx, dy);
+                }
+                let in_group = |g: Option<usize>| g == Some(i);
+                for text in self.texts.iter_mut().filter(|t| in_group(t.scroll_group)) {
+                    text.x += dx;
+                    text.y += dy;
+                }
+                for svg in self.svgs.iter_mut().filter(|s| in_group(s.scroll_group)) {
+                    svg.x += dx;
+                    svg.y += dy;
+                }
+                for image in self.images.iter_mut().filter(|m| in_group(m.scroll_group)) {
+                    image.x += dx;
+                    image.y += dy;
+                }
+                self.scroll[i].offset = offset;
+            }
+
+            // Scrollbars also fade and highlight, so redraw them regardless
+            let Some(g) = group else {
+                continue;
+            };
+            let Some(indicator) = &self.batch.scroll_groups[g].indicator else {
+                continue;
+            };
+            let mut ctx = GpuPaintContext::new(self.width as f32, self.height as f32);
+            ctx.resume_scroll_indicator(indicator);
+            tree.render_scroll_indicator(&mut ctx, node);
+            let redrawn = ctx.take_batch();
+            let primitives = if indicator.foreground {
+                &redrawn.foreground_primitives
+            } else {
+                &redrawn.primitives
+            };
+            if !self.batch.replace_scroll_indicator(g, primitives) {
+                return false;
+            }
+        }
+        true
+    }
+}
+
+/// Make layout measure text again after `loaded` font faces were registered
+///
+/// Text laid out before the font was available was measured with a
+/// fallback and would otherwise keep its old size. Returns `loaded`.
+fn invalidate_measurements_if_loaded(loaded: usize) -> usize {
+    if loaded > 0 {
+        blinc_layout::invalidate_text_measurements();
+    }
+    loaded
+}
+
+/// Whether layout or visual animations are moving content in `tree`
+fn tree_is_animating(tree: &RenderTree) -> bool {
+    tree.has_active_layout_animations() || tree.has_active_visual_animations()
+}
+
+impl Drop for RenderContext {
+    fn drop(&mut self) {
+        // A frame interrupted by a panic must not pin glyphs forever
+        if let Ok(mut text_ctx) = self.text_ctx.lock() {
+            text_ctx.end_frame_for(self.frame_client);
+        }
+    }
+}
+
 impl RenderContext {
     /// Create a new render context
     pub(crate) fn new(
@@ -172,35 +575,109 @@ impl RenderContext {
         device: Arc<wgpu::Device>,
         queue: Arc<wgpu::Queue>,
         sample_count: u32,
+    ) -> Self {
+        Self::with_shared(
+            renderer,
+            &SharedRenderResources::new(text_ctx),
+            device,
+            queue,
+            sample_count,
+        )
+    }
+
+    /// Create a render context using text and image resources shared with
+    /// other contexts on the same device
+    pub fn with_shared(
+        renderer: GpuRenderer,
+        shared: &SharedRenderResources,
+        device: Arc<wgpu::Device>,
+        queue: Arc<wgpu::Queue>,
+        sample_count: u32,
     ) -> Self {
         let image_ctx = ImageRenderingContext::new(device.clone(), queue.clone());
+        let image_decoder = ImageDecoder::new();
+        let update_queue = blinc_layout::current_update_queue();
+        bind_image_decoder(&image_decoder, &update_queue, None);
         Self {
             renderer,
-            text_ctx,
+            text_ctx: shared.text_ctx.clone(),
             image_ctx,
             device,
             queue,
             sample_count,
             backdrop_texture: None,
             msaa_texture: None,
-            image_cache: LruCache::new(NonZeroUsize::new(IMAGE_CACHE_CAPACITY).unwrap()),
-            svg_cache: LruCache::new(NonZeroUsize::new(SVG_CACHE_CAPACITY).unwrap()),
-            rasterized_svg_cache: LruCache::new(
-                NonZeroUsize::new(RASTERIZED_SVG_CACHE_CAPACITY).unwrap(),
-            ),
+            images: shared.images.clone(),
+            image_decoder,
+            update_queue,
+            image_ready_callback: None,
+            async_image_decode: true,
+            svg_tessellation_min_size: None,
             scratch_glyphs: Vec::with_capacity(1024), // Pre-allocate for typical text
             scratch_texts: Vec::with_capacity(64),    // Pre-allocate for text elements
             scratch_svgs: Vec::with_capacity(32),     // Pre-allocate for SVG elements
             scratch_images: Vec::with_capacity(32),   // Pre-allocate for image elements
+            last_stats: RenderStats::default(),
+            layer_cache_lookups: (0, 0),
+            partial_redraw: false,
+            retained_frame: None,
+            last_damage: Damage::Full,
+            frame_client: NEXT_FRAME_CLIENT.fetch_add(1, Ordering::Relaxed),
         }
     }
 
+    /// Start a frame in the glyph atlases: nothing this context prepares
+    /// is evicted until `end_text_frame`, whatever other contexts do
+    fn begin_text_frame(&self, text_ctx: &mut TextRenderingContext) {
+        text_ctx.begin_frame_for(self.frame_client);
+    }
+
+    /// End the frame started by `begin_text_frame`, once it was submitted
+    fn end_text_frame(&self) {
+        self.text_ctx
+            .lock()
+            .unwrap()
+            .end_frame_for(self.frame_client);
+    }
+
     /// Load font data into the text rendering registry
     ///
     /// This adds fonts that will be available for text rendering.
     /// Returns the number of font faces loaded.
     pub fn load_font_data_to_registry(&mut self, data: Vec<u8>) -> usize {
-        self.text_ctx.load_font_data_to_registry(data)
+        let loaded = self
+            .text_ctx
+            .lock()
+            .unwrap()
+            .load_font_data_to_registry(data);
+        invalidate_measurements_if_loaded(loaded)
+    }
+
+    /// Register a font file by path; it is memory-mapped on first use
+    ///
+    /// Returns the number of font faces added.
+    pub fn load_font_file_to_registry(&mut self, path: &std::path::Path) -> usize {
+        let loaded = self
+            .text_ctx
+            .lock()
+            .unwrap()
+            .load_font_file_to_registry(path);
+        invalidate_measurements_if_loaded(loaded)
+    }
+
+    /// Register font data owned elsewhere without copying it
+    ///
+    /// Returns the number of font faces added.
+    pub fn load_shared_font_data_to_registry(
+        &mut self,
+        data: Arc<dyn AsRef<[u8]> + Send + Sync>,
+    ) -> usize {
+        let loaded = self
+            .text_ctx
+            .lock()
+            .unwrap()
+            .load_shared_font_data_to_registry(data);
+        invalidate_measurements_if_loaded(loaded)
     }
 
     /// Render a layout tree to a texture view
@@ -213,12 +690,18 @@ impl RenderContext {
         height: u32,
         target: &wgpu::TextureView,
     ) -> Result<()> {
+        self.renderer
+            .set_backdrop_animating(tree_is_animating(tree));
+
+        let mut text_ctx = self.text_ctx.lock().unwrap();
+        self.begin_text_frame(&mut text_ctx);
+
         // Get scale factor for HiDPI rendering
         let scale_factor = tree.scale_factor();
 
         // Create paint contexts for each layer with text rendering support
         let mut bg_ctx =
-            GpuPaintContext::with_text_context(width as f32, height as f32, &mut self.text_ctx);
+            GpuPaintContext::with_text_context(width as f32, height as f32, &mut text_ctx);
 
         // Render layout layers (background and glass go to bg_ctx)
         tree.render_to_layer(&mut bg_ctx, RenderLayer::Background);
@@ -229,11 +712,12 @@ impl RenderContext {
 
         // Create foreground context with text rendering support
         let mut fg_ctx =
-            GpuPaintContext::with_text_context(width as f32, height as f32, &mut self.text_ctx);
+            GpuPaintContext::with_text_context(width as f32, height as f32, &mut text_ctx);
         tree.render_to_layer(&mut fg_ctx, RenderLayer::Foreground);
 
         // Take the batch from fg_ctx before reusing text_ctx for text elements
         let mut fg_batch = fg_ctx.take_batch();
+        drop(text_ctx);
 
         // Collect text, SVG, and image elements
         let (texts, svgs, images) = self.collect_render_elements(tree);
@@ -243,6 +727,7 @@ impl RenderContext {
 
         // Prepare text glyphs
         let mut all_glyphs = Vec::new();
+        let mut text_ctx = self.text_ctx.lock().unwrap();
         for text in &texts {
             // Convert layout TextAlign to GPU TextAlignment
             let alignment = match text.align {
@@ -297,7 +782,7 @@ impl RenderContext {
                 None
             };
 
-            match self.text_ctx.prepare_text_with_style(
+            match text_ctx.prepare_text_with_style(
                 &text.content,
                 text.x,
                 y_pos,
@@ -334,6 +819,7 @@ impl RenderContext {
                 }
             }
         }
+        drop(text_ctx);
 
         tracing::trace!(
             "Text rendering: {} texts collected, {} total glyphs prepared",
@@ -535,6 +1021,7 @@ impl RenderContext {
 
         // Return scratch buffers for reuse on next frame
         self.return_scratch_elements(texts, svgs, images);
+        self.end_text_frame();
 
         // Poll the device to free completed command buffers and prevent memory accumulation
         self.renderer.poll();
@@ -603,20 +1090,24 @@ impl RenderContext {
                 width: backdrop_width,
                 height: backdrop_height,
             });
+            // The new texture doesn't hold the previous backdrop
+            self.renderer.invalidate_backdrop_blur();
         }
     }
 
     /// Render text glyphs
     fn render_text(&mut self, target: &wgpu::TextureView, glyphs: &[GpuGlyph]) {
+        let text_ctx = self.text_ctx.lock().unwrap();
         if let (Some(atlas_view), Some(color_atlas_view)) =
-            (self.text_ctx.atlas_view(), self.text_ctx.color_atlas_view())
+            (text_ctx.atlas_view(), text_ctx.color_atlas_view())
         {
             self.renderer.render_text(
                 target,
                 glyphs,
                 atlas_view,
                 color_atlas_view,
-                self.text_ctx.sampler(),
+                text_ctx.sampler(),
+                text_ctx.atlas_generation(),
             );
         }
     }
@@ -630,14 +1121,16 @@ impl RenderContext {
             return;
         }
 
+        let text_ctx = self.text_ctx.lock().unwrap();
         if let (Some(atlas_view), Some(color_atlas_view)) =
-            (self.text_ctx.atlas_view(), self.text_ctx.color_atlas_view())
+            (text_ctx.atlas_view(), text_ctx.color_atlas_view())
         {
             self.renderer.render_primitives_overlay_with_glyphs(
                 target,
                 primitives,
                 atlas_view,
                 color_atlas_view,
+                text_ctx.atlas_generation(),
             );
         } else {
             // Fallback to regular rendering if no text atlases available
@@ -800,6 +1293,11 @@ impl RenderContext {
     ///
     /// Images with lazy loading strategy are only loaded when visible in the viewport.
     /// A buffer zone extends the viewport to preload images that are about to become visible.
+    ///
+    /// Images are decoded at the element's pixel size, on the decoder's worker
+    /// threads unless async decode is disabled. Until an image lands in the
+    /// cache its placeholder (if any) is drawn instead; finished decodes are
+    /// uploaded at the start of the next call.
     fn preload_images(
         &mut self,
         images: &[ImageElement],
@@ -809,10 +1307,30 @@ impl RenderContext {
         // Buffer zone: load images that are within 100px of becoming visible
         const VISIBILITY_BUFFER: f32 = 100.0;
 
+        self.upload_decoded_images();
+
         for image in images {
-            // LruCache::contains also promotes to most-recently-used
-            if self.image_cache.contains(&image.source) {
-                continue;
+            let target = (
+                (image.width.ceil() as u32).max(1),
+                (image.height.ceil() as u32).max(1),
+            );
+
+            {
+                let mut guard = self.images.lock().unwrap();
+                let caches = &mut *guard;
+                // LruCache::get also promotes to most-recently-used
+                if let Some(cached) = caches.image_cache.get(&image.source) {
+                    // A downsampled texture is re-decoded once shown larger
+                    let too_small = cached.width() < target.0 || cached.height() < target.1;
+                    if !too_small || !caches.downsampled_images.contains(&image.source) {
+                        continue;
+                    }
+                }
+                if caches.failed_images.contains(&image.source)
+                    || self.image_decoder.is_pending(&image.source)
+                {
+                    continue;
+                }
             }
 
             // Check if lazy loading is enabled (loading_strategy == 1)
@@ -855,29 +1373,92 @@ impl RenderContext {
                 }
             }
 
-            // Try to load the image - use from_uri to handle emoji://, data:, and file paths
+            // Use from_uri to handle emoji://, data:, and file paths
             let source = blinc_image::ImageSource::from_uri(&image.source);
-            let image_data = match blinc_image::ImageData::load(source) {
-                Ok(data) => data,
-                Err(e) => {
-                    tracing::trace!("Failed to load image '{}': {:?}", image.source, e);
-                    continue; // Skip images that fail to load
-                }
-            };
+            if self.async_image_decode {
+                self.image_decoder
+                    .request(image.source.clone(), source, Some(target));
+            } else {
+                let result = blinc_image::ImageData::load_sized(source, Some(target));
+                self.cache_decoded_image(image.source.clone(), result);
+            }
+        }
+    }
 
-            // Create GPU texture
-            let gpu_image = self.image_ctx.create_image_labeled(
-                image_data.pixels(),
-                image_data.width(),
-                image_data.height(),
-                &image.source,
-            );
+    /// Upload images the decoder finished since the last frame
+    ///
+    /// Returns the sources that landed, so their elements can be damaged.
+    fn upload_decoded_images(&mut self) -> Vec<String> {
+        let mut sources = Vec::new();
+        for decoded in self.image_decoder.poll() {
+            sources.push(decoded.key.clone());
+            self.cache_decoded_image(decoded.key, decoded.result);
+        }
+        sources
+    }
 
-            // LruCache::put evicts oldest entry if at capacity
-            self.image_cache.put(image.source.clone(), gpu_image);
+    /// Damage covering the images whose decodes just landed
+    ///
+    /// A finished decode only requests a redraw; without this a partial
+    /// frame would keep showing the placeholder outside other damage.
+    fn decoded_image_damage(&mut self, images: &[ImageElement], width: u32, height: u32) -> Damage {
+        let sources = self.upload_decoded_images();
+        if sources.is_empty() {
+            return Damage::None;
+        }
+        let (width, height) = (width as f32, height as f32);
+        let rects: Vec<Rect> = images
+            .iter()
+            .filter(|image| sources.contains(&image.source))
+            .filter_map(|image| {
+                // Clamped to the target, with a pixel for anti-aliased edges
+                let x0 = (image.x - 1.0).floor().max(0.0);
+                let y0 = (image.y - 1.0).floor().max(0.0);
+                let x1 = (image.x + image.width + 1.0).ceil().min(width);
+                let y1 = (image.y + image.height + 1.0).ceil().min(height);
+                (x1 > x0 && y1 > y0).then(|| Rect::new(x0, y0, x1 - x0, y1 - y0))
+            })
+            .collect();
+        if rects.is_empty() {
+            Damage::None
+        } else {
+            Damage::Rects(rects)
         }
     }
 
+    /// Create the GPU texture for a decoded image (or remember the failure)
+    fn cache_decoded_image(
+        &mut self,
+        source: String,
+        result: blinc_image::Result<blinc_image::ImageData>,
+    ) {
+        let image_data = match result {
+            Ok(data) => data,
+            Err(e) => {
+                tracing::trace!("Failed to load image '{}': {:?}", source, e);
+                self.images.lock().unwrap().failed_images.insert(source);
+                return;
+            }
+        };
+
+        // Create GPU texture
+        let gpu_image = self.image_ctx.create_image_labeled(
+            image_data.pixels(),
+            image_data.width(),
+            image_data.height(),
+            &source,
+        );
+
+        let mut caches = self.images.lock().unwrap();
+        if image_data.is_downsampled() {
+            caches.downsampled_images.insert(source.clone());
+        } else {
+            caches.downsampled_images.remove(&source);
+        }
+        // LruCache::put evicts oldest entry if at capacity
+        caches.image_cache.put(source, gpu_image);
+    }
+
     /// Render images to target (images must be preloaded first)
     fn render_images(
         &mut self,
@@ -888,9 +1469,10 @@ impl RenderContext {
     ) {
         use blinc_image::{calculate_fit_rects, src_rect_to_uv, ObjectFit, ObjectPosition};
 
+        let mut caches = self.images.lock().unwrap();
         for image in images {
             // Get cached GPU image
-            let gpu_image = self.image_cache.get(&image.source);
+            let gpu_image = caches.image_cache.get(&image.source);
 
             // If image is not loaded and has a placeholder, render placeholder
             if gpu_image.is_none() && image.placeholder_type != 0 {
@@ -1007,9 +1589,10 @@ impl RenderContext {
     fn render_images_ref(&mut self, target: &wgpu::TextureView, images: &[&ImageElement]) {
         use blinc_image::{calculate_fit_rects, src_rect_to_uv, ObjectFit, ObjectPosition};
 
+        let mut caches = self.images.lock().unwrap();
         for image in images {
             // Get cached GPU image
-            let Some(gpu_image) = self.image_cache.get(&image.source) else {
+            let Some(gpu_image) = caches.image_cache.get(&image.source) else {
                 continue; // Skip images that failed to load
             };
 
@@ -1122,14 +1705,17 @@ impl RenderContext {
         };
 
         // Try cache lookup first, parse only on miss
-        let doc = if let Some(cached) = self.svg_cache.get(&svg_hash) {
-            cached.clone()
-        } else {
-            let Ok(parsed) = SvgDocument::from_str(&svg.source) else {
-                return;
-            };
-            self.svg_cache.put(svg_hash, parsed.clone());
-            parsed
+        let doc = {
+            let mut caches = self.images.lock().unwrap();
+            if let Some(cached) = caches.svg_cache.get(&svg_hash) {
+                cached.clone()
+            } else {
+                let Ok(parsed) = SvgDocument::from_str(&svg.source) else {
+                    return;
+                };
+                caches.svg_cache.put(svg_hash, parsed.clone());
+                parsed
+            }
         };
 
         // Apply clipping if present
@@ -1224,12 +1810,27 @@ impl RenderContext {
         svgs: &[SvgElement],
         scale_factor: f32,
     ) {
+        // Partial redraws only repaint the scissored damage region
+        let scissor = self.renderer.scissor();
+
         for svg in svgs {
             // Skip completely transparent SVGs
             if svg.motion_opacity <= 0.001 {
                 continue;
             }
 
+            // Skip SVGs outside the damaged region, like text
+            if let Some([x, y, w, h]) = scissor {
+                let (x, y, w, h) = (x as f32, y as f32, w as f32, h as f32);
+                if svg.x >= x + w
+                    || svg.x + svg.width <= x
+                    || svg.y >= y + h
+                    || svg.y + svg.height <= y
+                {
+                    continue;
+                }
+            }
+
             // Skip SVGs completely outside their clip bounds
             if let Some([clip_x, clip_y, clip_w, clip_h]) = svg.clip_bounds {
                 let svg_right = svg.x + svg.width;
@@ -1246,40 +1847,58 @@ impl RenderContext {
                 }
             }
 
+            // Large SVGs can opt into GPU path tessellation: their raster
+            // would be big, and one whose size animates would re-rasterize
+            // every frame
+            if self
+                .svg_tessellation_min_size
+                .is_some_and(|min| svg.width.max(svg.height) >= min)
+            {
+                let (vw, vh) = self.renderer.viewport_size();
+                let mut ctx = GpuPaintContext::new(vw as f32, vh as f32);
+                self.render_svg_element(&mut ctx, svg);
+                let batch = ctx.take_batch();
+                if self.sample_count > 1 && batch.has_paths() {
+                    self.renderer
+                        .render_overlay_msaa(target, &batch, self.sample_count);
+                } else {
+                    self.renderer.render_overlay(target, &batch);
+                }
+                continue;
+            }
+
             // Rasterize at physical pixel resolution for HiDPI displays
             // svg.width/height are logical sizes, multiply by scale_factor for physical pixels
             let raster_width = ((svg.width * scale_factor).ceil() as u32).max(1);
             let raster_height = ((svg.height * scale_factor).ceil() as u32).max(1);
 
-            // Compute cache key: hash of (svg_source, width, height, scale, tint)
+            // Compute cache key: hash of (svg_source, width, height, scale).
+            // Tint is not part of the key - it is applied by the image shader,
+            // so recoloring (themes, hover states) reuses the same texture.
             let cache_key = {
                 let mut hasher = DefaultHasher::new();
                 svg.source.hash(&mut hasher);
                 raster_width.hash(&mut hasher);
                 raster_height.hash(&mut hasher);
-                // Include tint in cache key (hash as bits to handle f32)
-                if let Some(tint) = &svg.tint {
-                    tint.r.to_bits().hash(&mut hasher);
-                    tint.g.to_bits().hash(&mut hasher);
-                    tint.b.to_bits().hash(&mut hasher);
-                    tint.a.to_bits().hash(&mut hasher);
-                }
+                scale_factor.to_bits().hash(&mut hasher);
                 hasher.finish()
             };
 
             // Check cache or rasterize on miss
-            if self.rasterized_svg_cache.get(&cache_key).is_none() {
-                // Rasterize the SVG
-                let rasterized = if let Some(tint) = svg.tint {
-                    RasterizedSvg::from_str_with_tint(
-                        &svg.source,
-                        raster_width,
-                        raster_height,
-                        tint,
-                    )
-                } else {
-                    RasterizedSvg::from_str(&svg.source, raster_width, raster_height)
-                };
+            let mut caches = self.images.lock().unwrap();
+            if caches.rasterized_svg_cache.get(&cache_key).is_none() {
+                // Parsed trees are shared process-wide, so other windows
+                // showing the same icon skip parsing it
+                let source_hash = content_hash(svg.source.as_bytes());
+                if caches.svg_sources.insert(source_hash) {
+                    global_svg_cache().retain_source(source_hash);
+                }
+                let rasterized = global_svg_cache().rasterize(
+                    svg.source.as_bytes(),
+                    raster_width,
+                    raster_height,
+                    scale_factor,
+                );
 
                 let rasterized = match rasterized {
                     Ok(r) => r,
@@ -1298,18 +1917,28 @@ impl RenderContext {
                     rasterized.height,
                     Some("Rasterized SVG"),
                 );
+                // The texture is the cached copy from here on
+                global_svg_cache().release_raster(
+                    svg.source.as_bytes(),
+                    raster_width,
+                    raster_height,
+                    scale_factor,
+                );
 
-                self.rasterized_svg_cache.put(cache_key, gpu_image);
+                caches.rasterized_svg_cache.put(cache_key, gpu_image);
             }
 
             // Get the cached GPU image
-            let Some(gpu_image) = self.rasterized_svg_cache.get(&cache_key) else {
+            let Some(gpu_image) = caches.rasterized_svg_cache.get(&cache_key) else {
                 continue;
             };
 
             // Create instance at SVG position
             let mut instance = GpuImageInstance::new(svg.x, svg.y, svg.width, svg.height)
                 .with_opacity(svg.motion_opacity);
+            if let Some(tint) = svg.tint {
+                instance = instance.with_mask_tint(tint.r, tint.g, tint.b, tint.a);
+            }
 
             // Apply clip bounds if specified
             if let Some([clip_x, clip_y, clip_w, clip_h]) = svg.clip_bounds {
@@ -1341,16 +1970,41 @@ impl RenderContext {
         let mut texts = std::mem::take(&mut self.scratch_texts);
         let mut svgs = std::mem::take(&mut self.scratch_svgs);
         let mut images = std::mem::take(&mut self.scratch_images);
+        let mut scroll_groups = Vec::new();
+        Self::collect_elements_into(
+            tree,
+            render_state,
+            &mut texts,
+            &mut svgs,
+            &mut images,
+            &mut scroll_groups,
+        );
+        (texts, svgs, images)
+    }
+
+    /// Collect text, SVG, and image elements into caller-provided buffers
+    ///
+    /// Doesn't touch any GPU state, so it can run on a thread that doesn't
+    /// own the render context (see `DisplayList::record`).
+    fn collect_elements_into(
+        tree: &RenderTree,
+        render_state: Option<&blinc_layout::RenderState>,
+        texts: &mut Vec<TextElement>,
+        svgs: &mut Vec<SvgElement>,
+        images: &mut Vec<ImageElement>,
+        scroll_groups: &mut Vec<ScrollContent>,
+    ) {
         texts.clear();
         svgs.clear();
         images.clear();
+        scroll_groups.clear();
 
         // Get the scale factor from the tree for DPI scaling
         let scale = tree.scale_factor();
 
         if let Some(root) = tree.root() {
             let mut z_layer = 0u32;
-            self.collect_elements_recursive(
+            Self::collect_elements_recursive(
                 tree,
                 root,
                 (0.0, 0.0),
@@ -1365,21 +2019,20 @@ impl RenderContext {
                 render_state,
                 scale,
                 &mut z_layer,
-                &mut texts,
-                &mut svgs,
-                &mut images,
+                texts,
+                svgs,
+                images,
+                None, // Not inside scroll content
+                scroll_groups,
             );
         }
 
         // Sort texts by z_index (z_layer) to ensure correct rendering order with primitives
         texts.sort_by_key(|t| t.z_index);
-
-        (texts, svgs, images)
     }
 
     #[allow(clippy::too_many_arguments)]
     fn collect_elements_recursive(
-        &self,
         tree: &RenderTree,
         node: LayoutNodeId,
         parent_offset: (f32, f32),
@@ -1399,6 +2052,8 @@ impl RenderContext {
         texts: &mut Vec<TextElement>,
         svgs: &mut Vec<SvgElement>,
         images: &mut Vec<ImageElement>,
+        scroll_group: Option<usize>,
+        scroll_groups: &mut Vec<ScrollContent>,
     ) {
         use blinc_layout::Material;
 
@@ -1575,6 +2230,21 @@ impl RenderContext {
                 render_node.props.layer
             };
 
+            // Elements clipped by something inside the scroll content can't be
+            // moved by offsetting them
+            let is_element = matches!(
+                render_node.element_type,
+                ElementType::Text(_)
+                    | ElementType::StyledText(_)
+                    | ElementType::Svg(_)
+                    | ElementType::Image(_)
+            );
+            if let Some(group) = scroll_group {
+                if is_element && scroll_groups[group].clip != current_clip {
+                    scroll_groups[group].movable = false;
+                }
+            }
+
             match &render_node.element_type {
                 ElementType::Text(text_data) => {
                     // Apply DPI scale factor FIRST to match shape rendering order
@@ -1688,6 +2358,7 @@ impl RenderContext {
                         ascender: text_data.ascender * effective_motion_scale.1 * scale,
                         strikethrough: text_data.strikethrough,
                         underline: text_data.underline,
+                        scroll_group,
                     });
                 }
                 ElementType::Svg(svg_data) => {
@@ -1740,6 +2411,7 @@ impl RenderContext {
                         tint: svg_data.tint,
                         clip_bounds: scaled_clip,
                         motion_opacity: effective_motion_opacity,
+                        scroll_group,
                     });
                 }
                 ElementType::Image(image_data) => {
@@ -1775,6 +2447,7 @@ impl RenderContext {
                             .props
                             .border_color
                             .unwrap_or(blinc_core::Color::TRANSPARENT),
+                        scroll_group,
                     });
                 }
                 // Canvas elements are rendered inline during tree traversal (in render_layer)
@@ -1952,6 +2625,7 @@ impl RenderContext {
                             ascender: scaled_ascender * effective_motion_scale.1, // Scale ascender with motion
                             strikethrough,
                             underline,
+                            scroll_group,
                         });
 
                         x_offset += segment_width;
@@ -1974,8 +2648,25 @@ impl RenderContext {
             abs_x + scroll_offset.0 + static_motion_offset.0,
             abs_y + scroll_offset.1 + static_motion_offset.1,
         );
+
+        // Children of a scroll container move with its offset
+        let child_scroll_group = if tree.is_scroll_container(node) {
+            // Moving the outer content would leave the inner clip behind
+            if let Some(parent) = scroll_group {
+                scroll_groups[parent].movable = false;
+            }
+            scroll_groups.push(ScrollContent {
+                node,
+                clip: child_clip,
+                offset: scroll_offset,
+                movable: true,
+            });
+            Some(scroll_groups.len() - 1)
+        } else {
+            scroll_group
+        };
         for child_id in tree.layout().children(node) {
-            self.collect_elements_recursive(
+            Self::collect_elements_recursive(
                 tree,
                 child_id,
                 new_offset,
@@ -1993,10 +2684,94 @@ impl RenderContext {
                 texts,
                 svgs,
                 images,
+                child_scroll_group,
+                scroll_groups,
             );
         }
     }
 
+    /// Release cached GPU and CPU resources in response to memory pressure
+    ///
+    /// Everything released here is rebuilt lazily: images and SVGs are
+    /// re-decoded, glyphs re-rasterized and render targets re-created by the
+    /// next frame that needs them.
+    pub fn trim_memory(&mut self, level: MemoryPressure) {
+        self.renderer.layer_texture_cache_mut().clear_pool();
+        self.renderer.layer_texture_cache_mut().clear_retained();
+        {
+            let mut caches = self.images.lock().unwrap();
+            caches.image_cache.clear();
+            caches.downsampled_images.clear();
+            caches.failed_images.clear();
+            caches.svg_cache.clear();
+            caches.rasterized_svg_cache.clear();
+            // Only this context's sources: other windows keep their trees
+            global_svg_cache().release_sources(caches.svg_sources.drain());
+        }
+        self.renderer.release_blur_pyramids();
+        self.scratch_glyphs = Vec::new();
+        self.scratch_texts = Vec::new();
+        self.scratch_svgs = Vec::new();
+        self.scratch_images = Vec::new();
+
+        if level == MemoryPressure::Critical {
+            self.text_ctx.lock().unwrap().shrink_atlases();
+            self.backdrop_texture = None;
+            self.msaa_texture = None;
+            self.retained_frame = None;
+            // Also drops bind groups that still reference the old atlas/backdrop
+            self.renderer.release_cached_targets();
+        }
+
+        // Let wgpu free the released resources now rather than on the next submit
+        self.renderer.poll();
+    }
+
+    /// Estimated bytes held by each cache
+    pub fn memory_usage(&self) -> MemoryUsage {
+        let image_bytes = |image: &GpuImage| (image.width() as u64) * (image.height() as u64) * 4;
+        let layer_stats = self.renderer.layer_texture_cache().stats();
+        let (glyph_atlas_bytes, color_glyph_atlas_bytes) =
+            self.text_ctx.lock().unwrap().atlas_memory_bytes();
+
+        let caches = self.images.lock().unwrap();
+
+        let mut render_target_bytes = self.renderer.cached_target_bytes();
+        if let Some(backdrop) = &self.backdrop_texture {
+            render_target_bytes += (backdrop.width as u64) * (backdrop.height as u64) * 4;
+        }
+        if let Some(msaa) = &self.msaa_texture {
+            render_target_bytes +=
+                (msaa.width as u64) * (msaa.height as u64) * 4 * self.sample_count as u64;
+        }
+        if let Some(retained) = &self.retained_frame {
+            render_target_bytes += (retained.size.0 as u64) * (retained.size.1 as u64) * 4;
+        }
+
+        MemoryUsage {
+            layer_pool_bytes: layer_stats.pool_memory_bytes,
+            layer_named_bytes: layer_stats.named_memory_bytes,
+            image_cache_bytes: caches
+                .image_cache
+                .iter()
+                .map(|(_, img)| image_bytes(img))
+                .sum(),
+            svg_cache_bytes: caches
+                .rasterized_svg_cache
+                .iter()
+                .map(|(_, img)| image_bytes(img))
+                .sum(),
+            glyph_atlas_bytes,
+            color_glyph_atlas_bytes,
+            render_target_bytes,
+        }
+    }
+
+    /// Per-page utilization and eviction counts of the (grayscale, color) glyph atlases
+    pub fn glyph_atlas_stats(&self) -> (Vec<AtlasPageStats>, Vec<AtlasPageStats>) {
+        self.text_ctx.lock().unwrap().atlas_page_stats()
+    }
+
     /// Get device arc
     pub fn device(&self) -> &Arc<wgpu::Device> {
         &self.device
@@ -2012,7 +2787,14 @@ impl RenderContext {
     /// This can be used to share fonts between text measurement and rendering,
     /// ensuring consistent font loading and metrics.
     pub fn font_registry(&self) -> Arc<Mutex<FontRegistry>> {
-        self.text_ctx.font_registry()
+        self.text_ctx.lock().unwrap().font_registry()
+    }
+
+    /// Get the text rendering context, possibly shared with other contexts
+    ///
+    /// Pass it to `DisplayList::record` when recording on another thread.
+    pub fn text_context(&self) -> &Arc<Mutex<TextRenderingContext>> {
+        &self.text_ctx
     }
 
     /// Get the texture format used by the renderer
@@ -2040,7 +2822,7 @@ impl RenderContext {
         self.render_tree(tree, width, height, target)?;
 
         // Then render overlays from RenderState
-        self.render_overlays(render_state, width, height, target);
+        self.render_overlays(render_state.overlays(), width, height, target);
 
         Ok(())
     }
@@ -2061,31 +2843,195 @@ impl RenderContext {
         height: u32,
         target: &wgpu::TextureView,
     ) -> Result<()> {
-        // Get scale factor for HiDPI rendering
-        let scale_factor = tree.scale_factor();
+        self.render_tree_with_damage(tree, render_state, &Damage::Full, width, height, target)
+    }
+
+    /// Render a layout tree with motion animations, repainting only `damage`
+    ///
+    /// `damage` comes from `RenderTree::take_damage` and is only used when
+    /// partial redraw is enabled (see `set_partial_redraw`); otherwise this is
+    /// the same as `render_tree_with_motion`.
+    pub fn render_tree_with_damage(
+        &mut self,
+        tree: &RenderTree,
+        render_state: &blinc_layout::RenderState,
+        damage: &Damage,
+        width: u32,
+        height: u32,
+        target: &wgpu::TextureView,
+    ) -> Result<()> {
+        self.renderer
+            .set_backdrop_animating(tree_is_animating(tree) || render_state.has_active_motions());
+
+        let mut text_ctx = self.text_ctx.lock().unwrap();
+        self.begin_text_frame(&mut text_ctx);
 
         // Create a single paint context for all layers with text rendering support
         let mut ctx =
-            GpuPaintContext::with_text_context(width as f32, height as f32, &mut self.text_ctx);
+            GpuPaintContext::with_text_context(width as f32, height as f32, &mut text_ctx);
 
         // Render with motion animations applied (all layers to same context)
         tree.render_with_motion(&mut ctx, render_state);
 
         // Take the batch
         let batch = ctx.take_batch();
+        drop(text_ctx);
 
         // Collect text, SVG, and image elements WITH motion state
         let (texts, svgs, images) =
             self.collect_render_elements_with_state(tree, Some(render_state));
 
+        self.render_recorded(
+            &batch,
+            &texts,
+            &svgs,
+            &images,
+            render_state.overlays(),
+            tree.scale_factor(),
+            width,
+            height,
+            damage,
+            target,
+        );
+
+        // Render debug visualization if enabled (BLINC_DEBUG=text|layout|all)
+        let debug = DebugMode::from_env();
+        if debug.text {
+            self.render_text_debug(target, &texts);
+        }
+        if debug.layout {
+            let scale = tree.scale_factor();
+            self.render_layout_debug(target, tree, scale);
+        }
+        if debug.motion {
+            self.render_motion_debug(target, tree, width, height);
+        }
+
+        // Return scratch buffers for reuse on next frame
+        self.return_scratch_elements(texts, svgs, images);
+        self.end_text_frame();
+
+        Ok(())
+    }
+
+    /// Render a display list recorded with `DisplayList::record`
+    ///
+    /// Use this when frame recording and GPU encoding happen on different
+    /// threads. Debug visualizations that need the live tree are not drawn.
+    pub fn render_display_list(
+        &mut self,
+        list: &DisplayList,
+        target: &wgpu::TextureView,
+    ) -> Result<()> {
+        self.begin_text_frame(&mut self.text_ctx.lock().unwrap());
+        self.render_recorded(
+            &list.batch,
+            &list.texts,
+            &list.svgs,
+            &list.images,
+            &list.overlays,
+            list.scale_factor,
+            list.width,
+            list.height,
+            &list.damage,
+            target,
+        );
+        self.end_text_frame();
+        Ok(())
+    }
+
+    /// Encode a recorded frame: text preparation, images, SVGs, primitives and overlays
+    ///
+    /// With partial redraw enabled, the frame is drawn into the retained
+    /// texture (only the damaged region, when possible) and then copied to
+    /// `target`; overlays are always drawn on `target`.
+    #[allow(clippy::too_many_arguments)]
+    fn render_recorded(
+        &mut self,
+        batch: &PrimitiveBatch,
+        texts: &[TextElement],
+        svgs: &[SvgElement],
+        images: &[ImageElement],
+        overlays: &[Overlay],
+        scale_factor: f32,
+        width: u32,
+        height: u32,
+        damage: &Damage,
+        target: &wgpu::TextureView,
+    ) {
+        let encode_start = Instant::now();
+
+        // Upload finished decodes first: they add damage of their own
+        let mut damage = damage.clone();
+        damage.merge(self.decoded_image_damage(images, width, height));
+        let damage = self.prepare_retained_frame(batch, &damage, width, height);
+        let retained = self.retained_frame.take();
+        let output = target;
+        let target = retained.as_ref().map_or(output, |frame| &frame.view);
+
+        if damage.is_none() {
+            // Nothing changed - the retained frame is already up to date
+            let retained = retained.expect("damage is only None with a retained frame");
+            self.present_retained_frame(&retained, output);
+            self.retained_frame = Some(retained);
+            let encode_time = encode_start.elapsed();
+            self.render_overlays(overlays, width, height, output);
+            let encoded = PrimitiveBatch::new();
+            self.finish_render_stats(
+                &encoded,
+                0,
+                &damage,
+                width,
+                height,
+                encode_time,
+                Duration::ZERO,
+            );
+            return;
+        }
+
+        // Partial damage: redraw only what intersects the damaged bounds
+        let damage_bounds = damage.bounds();
+        let culled_batch;
+        let batch = match damage_bounds {
+            Some(bounds) => {
+                let scissor = [
+                    bounds.x() as u32,
+                    bounds.y() as u32,
+                    bounds.width() as u32,
+                    bounds.height() as u32,
+                ];
+                self.renderer.set_scissor(Some(scissor));
+                culled_batch = cull_batch(batch, bounds);
+                &culled_batch
+            }
+            None => batch,
+        };
+        let is_damaged = |x: f32, y: f32, w: f32, h: f32| {
+            damage_bounds.map_or(true, |b| {
+                x < b.x() + b.width() && x + w > b.x() && y < b.y() + b.height() && y + h > b.y()
+            })
+        };
+
         // Pre-load all images into cache before rendering
-        self.preload_images(&images, width as f32, height as f32);
+        self.preload_images(images, width as f32, height as f32);
 
         // Prepare text glyphs with z_layer information
         // Store (z_layer, glyphs) to enable interleaved rendering
         let mut glyphs_by_layer: std::collections::BTreeMap<u32, Vec<GpuGlyph>> =
             std::collections::BTreeMap::new();
-        for text in &texts {
+        let mut text_ctx = self.text_ctx.lock().unwrap();
+        for text in texts {
+            // Skip text outside the damaged region (glyphs can overhang their box)
+            let overhang = text.font_size * 0.5;
+            if !is_damaged(
+                text.x - overhang,
+                text.y - overhang,
+                text.width + overhang * 2.0,
+                text.height + overhang * 2.0,
+            ) {
+                continue;
+            }
+
             // Skip text that's completely outside its clip bounds (visibility culling)
             // This prevents loading emoji fonts for off-screen text in scroll containers
             if let Some([clip_x, clip_y, clip_w, clip_h]) = text.clip_bounds {
@@ -2164,7 +3110,7 @@ impl RenderContext {
                 None
             };
 
-            match self.text_ctx.prepare_text_with_style(
+            match text_ctx.prepare_text_with_style(
                 &text.content,
                 text.x,
                 y_pos,
@@ -2208,6 +3154,7 @@ impl RenderContext {
                 }
             }
         }
+        drop(text_ctx);
 
         tracing::trace!(
             "render_tree_with_motion: {} texts, {} z-layers with glyphs",
@@ -2246,16 +3193,16 @@ impl RenderContext {
                 self.renderer.render_to_backdrop(
                     &backdrop.view,
                     (backdrop.width, backdrop.height),
-                    &batch,
+                    batch,
                 );
 
                 // Then use render_with_clear which handles layer effects
                 self.renderer
-                    .render_with_clear(target, &batch, [0.0, 0.0, 0.0, 1.0]);
+                    .render_with_clear(target, batch, [0.0, 0.0, 0.0, 1.0]);
 
                 // Finally render glass primitives on top
                 if batch.glass_count() > 0 {
-                    self.renderer.render_glass(target, &backdrop.view, &batch);
+                    self.renderer.render_glass(target, &backdrop.view, batch);
                 }
             } else {
                 // No layer effects, use optimized glass frame rendering
@@ -2264,7 +3211,7 @@ impl RenderContext {
                     target,
                     &backdrop.view,
                     (backdrop.width, backdrop.height),
-                    &batch,
+                    batch,
                 );
             }
 
@@ -2272,7 +3219,7 @@ impl RenderContext {
             // (render_glass_frame uses 1x sampled path rendering)
             if use_msaa_overlay && batch.has_paths() {
                 self.renderer
-                    .render_paths_overlay_msaa(target, &batch, self.sample_count);
+                    .render_paths_overlay_msaa(target, batch, self.sample_count);
             }
 
             self.render_images_ref(target, &bg_images);
@@ -2292,7 +3239,7 @@ impl RenderContext {
             self.scratch_glyphs = scratch; // Restore for next frame
 
             // Render text decorations for glass path (all layers)
-            let decorations_by_layer = generate_text_decoration_primitives_by_layer(&texts);
+            let decorations_by_layer = generate_text_decoration_primitives_by_layer(texts);
             for primitives in decorations_by_layer.values() {
                 if !primitives.is_empty() {
                     self.renderer.render_primitives_overlay(target, primitives);
@@ -2301,12 +3248,12 @@ impl RenderContext {
 
             // Render SVGs as rasterized images for high-quality anti-aliasing
             if !svgs.is_empty() {
-                self.render_rasterized_svgs(target, &svgs, scale_factor);
+                self.render_rasterized_svgs(target, svgs, scale_factor);
             }
         } else {
             // Simple path (no glass)
             // Pre-generate text decorations grouped by layer for interleaved rendering
-            let decorations_by_layer = generate_text_decoration_primitives_by_layer(&texts);
+            let decorations_by_layer = generate_text_decoration_primitives_by_layer(texts);
 
             let max_z = batch.max_z_layer();
             let max_text_z = glyphs_by_layer.keys().cloned().max().unwrap_or(0);
@@ -2319,7 +3266,7 @@ impl RenderContext {
                 // Group images by z_index for interleaved rendering
                 let mut images_by_layer: std::collections::BTreeMap<u32, Vec<&ImageElement>> =
                     std::collections::BTreeMap::new();
-                for img in &images {
+                for img in images {
                     images_by_layer.entry(img.z_index).or_default().push(img);
                 }
                 let max_image_z = images_by_layer.keys().cloned().max().unwrap_or(0);
@@ -2362,7 +3309,7 @@ impl RenderContext {
 
                 // Render SVGs as rasterized images for high-quality anti-aliasing
                 if !svgs.is_empty() {
-                    self.render_rasterized_svgs(target, &svgs, scale_factor);
+                    self.render_rasterized_svgs(target, svgs, scale_factor);
                 }
 
                 // Render foreground primitives on top (for .foreground() elements)
@@ -2383,15 +3330,15 @@ impl RenderContext {
             } else {
                 // No z-layers, use original fast path
                 self.renderer
-                    .render_with_clear(target, &batch, [0.0, 0.0, 0.0, 1.0]);
+                    .render_with_clear(target, batch, [0.0, 0.0, 0.0, 1.0]);
 
                 // Render paths with MSAA for smooth edges on curved shapes like notch
                 if use_msaa_overlay && batch.has_paths() {
                     self.renderer
-                        .render_paths_overlay_msaa(target, &batch, self.sample_count);
+                        .render_paths_overlay_msaa(target, batch, self.sample_count);
                 }
 
-                self.render_images(target, &images, width as f32, height as f32);
+                self.render_images(target, images, width as f32, height as f32);
 
                 // Render foreground primitives on top of images (for .foreground() elements)
                 if !batch.foreground_primitives.is_empty() {
@@ -2401,7 +3348,7 @@ impl RenderContext {
 
                 // Render SVGs as rasterized images for high-quality anti-aliasing
                 if !svgs.is_empty() {
-                    self.render_rasterized_svgs(target, &svgs, scale_factor);
+                    self.render_rasterized_svgs(target, svgs, scale_factor);
                 }
 
                 // Collect all glyphs for flat rendering
@@ -2415,29 +3362,262 @@ impl RenderContext {
             }
         }
 
+        self.renderer.set_scissor(None);
+        if let Some(retained) = retained {
+            self.present_retained_frame(&retained, output);
+            self.retained_frame = Some(retained);
+        }
+
+        let encode_time = encode_start.elapsed();
+
         // Poll the device to free completed command buffers
+        let gpu_wait_start = Instant::now();
         self.renderer.poll();
+        let gpu_time = gpu_wait_start.elapsed();
 
         // Render overlays from RenderState
-        self.render_overlays(render_state, width, height, target);
+        self.render_overlays(overlays, width, height, output);
 
-        // Render debug visualization if enabled (BLINC_DEBUG=text|layout|all)
-        let debug = DebugMode::from_env();
-        if debug.text {
-            self.render_text_debug(target, &texts);
+        let glyphs = glyphs_by_layer.values().map(Vec::len).sum::<usize>() as u32;
+        self.finish_render_stats(batch, glyphs, &damage, width, height, encode_time, gpu_time);
+    }
+
+    /// Record counters for the frame just encoded
+    #[allow(clippy::too_many_arguments)]
+    fn finish_render_stats(
+        &mut self,
+        batch: &PrimitiveBatch,
+        glyphs: u32,
+        damage: &Damage,
+        width: u32,
+        height: u32,
+        encode_time: Duration,
+        gpu_time: Duration,
+    ) {
+        let surface_area = (width as f32 * height as f32).max(1.0);
+        let damage_fraction = match damage {
+            Damage::None => 0.0,
+            Damage::Rects(_) => damage
+                .bounds()
+                .map_or(0.0, |b| (b.width() * b.height() / surface_area).min(1.0)),
+            Damage::Full => 1.0,
+        };
+
+        // The pool's counters are lifetime totals (or since `reset_stats`)
+        let cache_stats = self.renderer.layer_texture_cache().stats();
+        let (prev_hits, prev_misses) = self.layer_cache_lookups;
+        let (hits, misses) = if cache_stats.hits < prev_hits || cache_stats.misses < prev_misses {
+            (cache_stats.hits, cache_stats.misses)
+        } else {
+            (
+                cache_stats.hits - prev_hits,
+                cache_stats.misses - prev_misses,
+            )
+        };
+        self.layer_cache_lookups = (cache_stats.hits, cache_stats.misses);
+        let layer_cache_hit_rate = if hits + misses == 0 {
+            0.0
+        } else {
+            hits as f32 / (hits + misses) as f32
+        };
+
+        self.last_stats = RenderStats {
+            encode_time,
+            gpu_time,
+            primitives: (batch.primitive_count()
+                + batch.foreground_primitive_count()
+                + batch.glass_count()) as u32,
+            glyphs,
+            draw_calls: self.renderer.take_draw_call_count(),
+            layer_cache_hit_rate,
+            damage_rects: damage.rects().len() as u32,
+            damage_fraction,
+        };
+        self.last_damage = damage.clone();
+    }
+
+    /// Decode images on background worker threads (the default)
+    ///
+    /// When disabled, images are decoded inline the first frame they are
+    /// needed, so they appear immediately at the cost of a stalled frame.
+    /// Useful for headless captures that must include every image.
+    pub fn set_async_image_decode(&mut self, enabled: bool) {
+        self.async_image_decode = enabled;
+    }
+
+    /// Call `callback` (on a decoder thread) whenever an image finishes decoding
+    ///
+    /// A redraw is always requested on the context's update queue (see
+    /// `set_update_queue`); use this to additionally wake an idle event loop.
+    pub fn set_image_ready_callback(&mut self, callback: impl Fn() + Send + Sync + 'static) {
+        let callback: ImageReadyCallback = Arc::new(callback);
+        self.image_ready_callback = Some(callback.clone());
+        bind_image_decoder(&self.image_decoder, &self.update_queue, Some(callback));
+    }
+
+    /// Set the update queue finished image decodes request redraws on
+    ///
+    /// Defaults to the queue that was current when the context was created.
+    /// Contexts with their own queue (e.g. one per iOS view) must set it, or
+    /// decoded images are only drawn once something else triggers a frame.
+    pub fn set_update_queue(&mut self, queue: SharedUpdateQueue) {
+        bind_image_decoder(
+            &self.image_decoder,
+            &queue,
+            self.image_ready_callback.clone(),
+        );
+        self.update_queue = queue;
+    }
+
+    /// Enable or disable partial redraws
+    ///
+    /// When enabled, frames are rendered into a retained texture that is
+    /// copied to the target, so a frame whose damage (see
+    /// `DisplayList::with_damage`) covers only part of the surface re-encodes
+    /// just the primitives and text intersecting it. Frames with glass, layer
+    /// effects or MSAA paths always repaint fully. Costs one extra
+    /// surface-sized texture and a full-surface copy per frame.
+    pub fn set_partial_redraw(&mut self, enabled: bool) {
+        self.partial_redraw = enabled;
+        if !enabled {
+            self.retained_frame = None;
         }
-        if debug.layout {
-            let scale = tree.scale_factor();
-            self.render_layout_debug(target, tree, scale);
+    }
+
+    /// Choose how blur effects, shadows and glass backdrops are filtered
+    ///
+    /// `BlurMode::Performance` blurs through a downsampled dual-filter
+    /// pyramid and reuses the blurred glass backdrop while nothing under the
+    /// glass changes. It is noticeably cheaper on high-density displays at a
+    /// small cost in filter accuracy.
+    ///
+    /// Changing the mode drops the retained frame, so the next frame is
+    /// drawn in full.
+    pub fn set_blur_mode(&mut self, mode: BlurMode) {
+        if self.renderer.blur_mode() != mode {
+            self.retained_frame = None;
         }
-        if debug.motion {
-            self.render_motion_debug(target, tree, width, height);
+        self.renderer.set_blur_mode(mode);
+    }
+
+    /// How blur effects, shadows and glass backdrops are currently filtered
+    pub fn blur_mode(&self) -> BlurMode {
+        self.renderer.blur_mode()
+    }
+
+    /// Change the MSAA sample count used for paths (1 disables MSAA)
+    ///
+    /// MSAA pipelines and targets for the new count are created by the next
+    /// frame that draws paths, so avoid toggling this every frame. The
+    /// retained frame and glass backdrop were drawn at the old count, so the
+    /// next frame is drawn in full.
+    pub fn set_sample_count(&mut self, sample_count: u32) {
+        let sample_count = sample_count.max(1);
+        if self.sample_count != sample_count {
+            self.sample_count = sample_count;
+            self.msaa_texture = None;
+            self.retained_frame = None;
+            self.renderer.invalidate_backdrop_blur();
         }
+    }
 
-        // Return scratch buffers for reuse on next frame
-        self.return_scratch_elements(texts, svgs, images);
+    /// MSAA sample count used for paths
+    pub fn sample_count(&self) -> u32 {
+        self.sample_count
+    }
 
-        Ok(())
+    /// Draw text at or above `min_size` pixels from signed distance fields
+    ///
+    /// SDF glyphs are rasterized once per size bucket and scaled on the GPU,
+    /// so text whose size animates (zoom, scale transitions) stops
+    /// re-rasterizing every frame, at the cost of slightly softer corners.
+    /// `None` (the default) keeps exact bitmaps at every size. Color emoji
+    /// always stay bitmaps.
+    pub fn set_sdf_text_min_size(&mut self, min_size: Option<f32>) {
+        self.text_ctx.lock().unwrap().set_sdf_min_size(min_size);
+    }
+
+    /// Draw SVGs whose larger side is at least `min_size` as GPU paths
+    ///
+    /// By default every SVG is rasterized once per size and drawn as a
+    /// texture. Large illustrations, or SVGs whose size animates, are better
+    /// tessellated: nothing is rasterized or uploaded, and each frame
+    /// re-tessellates instead. `None` (the default) always rasterizes.
+    pub fn set_svg_tessellation_min_size(&mut self, min_size: Option<f32>) {
+        self.svg_tessellation_min_size = min_size;
+    }
+
+    /// Whether partial redraws are enabled
+    pub fn partial_redraw(&self) -> bool {
+        self.partial_redraw
+    }
+
+    /// Damage applied to the most recently rendered frame (physical pixels)
+    ///
+    /// `Damage::Full` whenever the frame was repainted completely, including
+    /// when partial redraw is disabled or the frame wasn't eligible.
+    pub fn last_damage(&self) -> &Damage {
+        &self.last_damage
+    }
+
+    /// Decide how much of this frame to repaint, (re)creating the retained
+    /// texture as needed
+    ///
+    /// Returns the damage to apply; anything but `Full` implies a valid
+    /// retained frame holding the previous frame's contents.
+    fn prepare_retained_frame(
+        &mut self,
+        batch: &PrimitiveBatch,
+        damage: &Damage,
+        width: u32,
+        height: u32,
+    ) -> Damage {
+        let eligible = self.partial_redraw
+            && batch.glass_count() == 0
+            && !batch.has_layer_effects()
+            && !(self.sample_count > 1 && batch.has_paths());
+        if !eligible {
+            self.retained_frame = None;
+            return Damage::Full;
+        }
+
+        match &self.retained_frame {
+            Some(frame) if frame.matches_size((width, height)) => damage.clone(),
+            _ => {
+                self.retained_frame = Some(LayerTexture::new(
+                    &self.device,
+                    (width, height),
+                    self.renderer.texture_format(),
+                    false,
+                ));
+                Damage::Full
+            }
+        }
+    }
+
+    /// Copy the retained frame onto the output target
+    fn present_retained_frame(&mut self, retained: &LayerTexture, target: &wgpu::TextureView) {
+        self.renderer.resize(retained.size.0, retained.size.1);
+        let mut encoder = self
+            .device
+            .create_command_encoder(&wgpu::CommandEncoderDescriptor {
+                label: Some("Blinc Retained Frame Encoder"),
+            });
+        self.renderer.composite_layer(
+            &mut encoder,
+            target,
+            retained,
+            0.0,
+            0.0,
+            1.0,
+            blinc_core::BlendMode::Normal,
+        );
+        self.queue.submit(std::iter::once(encoder.finish()));
+    }
+
+    /// Counters and timings for the most recently rendered frame
+    pub fn last_render_stats(&self) -> RenderStats {
+        self.last_stats
     }
 
     /// Render a tree on top of existing content (no clear)
@@ -2456,14 +3636,17 @@ impl RenderContext {
         let scale_factor = tree.scale_factor();
 
         // Create a single paint context for all layers with text rendering support
+        let mut text_ctx = self.text_ctx.lock().unwrap();
+        self.begin_text_frame(&mut text_ctx);
         let mut ctx =
-            GpuPaintContext::with_text_context(width as f32, height as f32, &mut self.text_ctx);
+            GpuPaintContext::with_text_context(width as f32, height as f32, &mut text_ctx);
 
         // Render with motion animations applied (all layers to same context)
         tree.render_with_motion(&mut ctx, render_state);
 
         // Take the batch
         let batch = ctx.take_batch();
+        drop(text_ctx);
 
         // Collect text, SVG, and image elements WITH motion state
         let (texts, svgs, images) =
@@ -2475,6 +3658,7 @@ impl RenderContext {
         // Prepare text glyphs with z_layer information
         let mut glyphs_by_layer: std::collections::BTreeMap<u32, Vec<GpuGlyph>> =
             std::collections::BTreeMap::new();
+        let mut text_ctx = self.text_ctx.lock().unwrap();
         for text in &texts {
             let alignment = match text.align {
                 TextAlign::Left => TextAlignment::Left,
@@ -2523,7 +3707,7 @@ impl RenderContext {
                 None
             };
 
-            if let Ok(glyphs) = self.text_ctx.prepare_text_with_style(
+            if let Ok(glyphs) = text_ctx.prepare_text_with_style(
                 &text.content,
                 text.x,
                 y_pos,
@@ -2551,6 +3735,7 @@ impl RenderContext {
                     .extend(glyphs);
             }
         }
+        drop(text_ctx);
 
         // SVGs are rendered as rasterized images (not tessellated paths) for better anti-aliasing
         // They will be rendered later via render_rasterized_svgs
@@ -2619,6 +3804,7 @@ impl RenderContext {
 
         // Return scratch buffers for reuse on next frame
         self.return_scratch_elements(texts, svgs, images);
+        self.end_text_frame();
 
         Ok(())
     }
@@ -2626,12 +3812,11 @@ impl RenderContext {
     /// Render overlays from RenderState (cursors, selections, focus rings)
     fn render_overlays(
         &mut self,
-        render_state: &blinc_layout::RenderState,
+        overlays: &[Overlay],
         width: u32,
         height: u32,
         target: &wgpu::TextureView,
     ) {
-        let overlays = render_state.overlays();
         if overlays.is_empty() {
             return;
         }
@@ -2687,6 +3872,66 @@ impl RenderContext {
     }
 }
 
+/// Copy of `batch` for redrawing `region`: primitives outside it are dropped
+/// and an opaque background rect is drawn first, since render passes keep
+/// the previous frame while a scissor is set
+///
+/// A retained layer touching `region` is kept whole, with its layer
+/// commands, so it hashes to the same key as in a full frame and is
+/// composited from its cached texture under the scissor.
+fn cull_batch(batch: &PrimitiveBatch, region: Rect) -> PrimitiveBatch {
+    let intersects = |p: &GpuPrimitive| {
+        let [x, y, w, h] = p.bounds;
+        let [ox, oy, blur, spread] = p.shadow;
+        let extent = blur * 3.0 + spread.abs();
+        let (x0, y0) = (x.min(x + ox) - extent, y.min(y + oy) - extent);
+        let (x1, y1) = (
+            (x + w).max(x + w + ox) + extent,
+            (y + h).max(y + h + oy) + extent,
+        );
+        x0 < region.x() + region.width()
+            && x1 > region.x()
+            && y0 < region.y() + region.height()
+            && y1 > region.y()
+    };
+
+    let mut keep: Vec<bool> = batch.primitives.iter().map(|p| intersects(p)).collect();
+    for range in batch.retained_layer_ranges() {
+        let range = range.start.min(keep.len())..range.end.min(keep.len());
+        if keep[range.clone()].contains(&true) {
+            keep[range].fill(true);
+        }
+    }
+
+    let mut culled = PrimitiveBatch::new();
+    culled.primitives.push(
+        GpuPrimitive::rect(region.x(), region.y(), region.width(), region.height())
+            .with_color(0.0, 0.0, 0.0, 1.0),
+    );
+    // Layer commands move to where their primitive lands in the culled list
+    let mut commands = batch.layer_commands.iter().peekable();
+    for (index, primitive) in batch.primitives.iter().enumerate() {
+        while let Some(entry) = commands.next_if(|entry| entry.primitive_index <= index) {
+            culled.push_layer_command(entry.command.clone());
+        }
+        if keep[index] {
+            culled.primitives.push(*primitive);
+        }
+    }
+    for entry in commands {
+        culled.push_layer_command(entry.command.clone());
+    }
+    culled.foreground_primitives = batch
+        .foreground_primitives
+        .iter()
+        .filter(|p| intersects(p))
+        .copied()
+        .collect();
+    culled.paths = batch.paths.clone();
+    culled.foreground_paths = batch.foreground_paths.clone();
+    culled
+}
+
 /// Convert layout's GenericFont to GPU's GenericFont
 fn to_gpu_generic_font(generic: GenericFont) -> GpuGenericFont {
     match generic {
@@ -29,21 +29,27 @@
 
 use std::sync::{
     atomic::{AtomicBool, Ordering},
-    Arc, Mutex,
+    Arc, Condvar, Mutex,
 };
+use std::thread::JoinHandle;
+use std::time::{Duration, Instant};
 
-use blinc_animation::AnimationScheduler;
+use blinc_animation::{AnimationActivity, AnimationScheduler};
 use blinc_core::context_state::{BlincContextState, HookState, SharedHookState};
 use blinc_core::reactive::{ReactiveGraph, SignalId};
+use blinc_gpu::TextRenderingContext;
 use blinc_layout::event_router::MouseButton;
 use blinc_layout::overlay_state::OverlayContext;
 use blinc_layout::prelude::*;
 use blinc_layout::widgets::overlay::{overlay_manager, OverlayManager};
+use blinc_layout::{Damage, SharedUpdateQueue};
 use blinc_platform::assets::set_global_asset_loader;
 use blinc_platform_ios::{IOSAssetLoader, IOSWakeProxy, TouchPhase};
 
 use crate::app::BlincApp;
+use crate::context::{DisplayList, RenderStats};
 use crate::error::{BlincError, Result};
+use crate::pacing::{FramePacing, FrameRateRange, QualityTier, ThermalState};
 use crate::windowed::{
     RefDirtyFlag, SharedAnimationScheduler, SharedElementRegistry, SharedReactiveGraph,
     SharedReadyCallbacks, WindowedContext,
@@ -156,7 +162,20 @@ impl IOSApp {
         let wake_proxy_clone = wake_proxy.clone();
         scheduler.set_wake_callback(move || wake_proxy_clone.wake());
 
-        scheduler.start_background();
+        // Updates queued from any thread resume a paused display link too
+        let update_queue = SharedUpdateQueue::default();
+        let wake_proxy_clone = wake_proxy.clone();
+        update_queue.set_waker(move || wake_proxy_clone.wake());
+
+        // ...and so do async native calls completing on the platform's threads
+        let wake_proxy_clone = wake_proxy.clone();
+        let completion_waker =
+            blinc_core::native_bridge::add_native_completion_waker(move || wake_proxy_clone.wake());
+
+        // CADisplayLink drives the ticks (blinc_frame / blinc_build_frame), so
+        // no background thread wakes up while nothing is animating
+        scheduler.start_external_clock();
+        let animation_activity = scheduler.activity();
         let animations: SharedAnimationScheduler = Arc::new(Mutex::new(scheduler));
 
         // Set global scheduler handle
@@ -252,11 +271,32 @@ impl IOSApp {
             render_tree: None,
             ref_dirty_flag,
             animations,
+            animation_activity,
             ready_callbacks,
             wake_proxy,
+            completion_waker,
             rebuild_count: 0,
             last_touch_pos: None,
             is_scrolling: false,
+            touch_history: std::collections::HashMap::new(),
+            touch_batch: Vec::new(),
+            coalesced_touches: Vec::new(),
+            pending_touch_events: Vec::new(),
+            scroll_animating: false,
+            pacing: FramePacing::new(),
+            last_frame_target: None,
+            frame_stats: BlincFrameStats::default(),
+            frame_stats_open: false,
+            frame_stats_history: std::collections::VecDeque::with_capacity(FRAME_STATS_HISTORY),
+            motions_active: false,
+            damage_scroll_only: false,
+            update_queue,
+            rust_ui_builder: None,
+            ui_builder: None,
+            #[cfg(feature = "replay-profile")]
+            replay: None,
+            #[cfg(feature = "replay-profile")]
+            replay_touch_down: false,
         })
     }
 
@@ -281,10 +321,14 @@ pub struct IOSRenderContext {
     ref_dirty_flag: RefDirtyFlag,
     /// Animation scheduler
     animations: SharedAnimationScheduler,
+    /// Lock-free view of the scheduler, polled by `needs_render`
+    animation_activity: AnimationActivity,
     /// Ready callbacks
     ready_callbacks: SharedReadyCallbacks,
-    /// Wake proxy for animation thread
+    /// Wake proxy, signalled by the scheduler when an animation starts
     wake_proxy: IOSWakeProxy,
+    /// Native completion waker signalling `wake_proxy`, removed on drop
+    completion_waker: blinc_core::native_bridge::NativeWakerId,
     /// Number of rebuilds
     rebuild_count: u64,
     /// Touch tracking for scroll delta calculation
@@ -292,6 +336,136 @@ pub struct IOSRenderContext {
     last_touch_pos: Option<(f32, f32)>,
     /// Whether currently scrolling (touch drag in progress)
     is_scrolling: bool,
+    /// Full-resolution sample history per touch id (for gesture velocity)
+    touch_history: std::collections::HashMap<u64, TouchHistory>,
+    /// Scratch buffer for the uncoalesced touches of the current batch
+    touch_batch: Vec<blinc_platform_ios::Touch>,
+    /// Scratch buffer for the coalesced touches of the current batch
+    coalesced_touches: Vec<blinc_platform_ios::Touch>,
+    /// Scratch buffer for events collected from the event router
+    pending_touch_events: Vec<PendingTouchEvent>,
+    /// Scroll physics was still animating after the last `blinc_frame`
+    scroll_animating: bool,
+    /// Frame rate and quality tier for the device's power state
+    pacing: FramePacing,
+    /// `target_timestamp` of the last frame `blinc_frame` drew
+    last_frame_target: Option<f64>,
+    /// Stats for the frame in progress (or the last finished one)
+    frame_stats: BlincFrameStats,
+    /// `frame_stats` has been started by `build_frame` but not finished by a render
+    frame_stats_open: bool,
+    /// Finished frames, oldest first
+    frame_stats_history: std::collections::VecDeque<BlincFrameStats>,
+    /// RenderState motions were running when damage was last taken
+    motions_active: bool,
+    /// The last `take_damage` found nothing but scroll offset changes
+    damage_scroll_only: bool,
+    /// Redraw flag and pending incremental updates of this context's elements
+    update_queue: SharedUpdateQueue,
+    /// UI builder for this context (overrides `register_rust_ui_builder`)
+    rust_ui_builder: Option<RustUIBuilder>,
+    /// FFI UI builder for this context (overrides `blinc_set_ui_builder`)
+    ui_builder: Option<UIBuilderFn>,
+    /// Profiling replay in progress (`blinc_replay_profile_start`)
+    #[cfg(feature = "replay-profile")]
+    replay: Option<blinc_recorder::ProfileReplay>,
+    /// The replay has injected a touch that hasn't ended yet
+    #[cfg(feature = "replay-profile")]
+    replay_touch_down: bool,
+}
+
+impl Drop for IOSRenderContext {
+    fn drop(&mut self) {
+        blinc_core::native_bridge::remove_native_completion_waker(self.completion_waker);
+    }
+}
+
+/// Number of finished frames kept for `blinc_get_frame_stats_history`
+const FRAME_STATS_HISTORY: usize = 120;
+
+/// Per-frame phase timings and counters (C FFI for Swift)
+///
+/// Durations are CPU wall-clock milliseconds. With the render thread running
+/// (`blinc_start_render_thread`) `render_ms` only covers recording the display
+/// list, and the GPU fields describe the latest frame the thread finished.
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default)]
+pub struct BlincFrameStats {
+    /// Sequence number of the frame (starts at 1)
+    pub frame_index: u64,
+    /// Animation scheduler tick
+    pub animation_ms: f32,
+    /// Applying queued prop updates
+    pub prop_update_ms: f32,
+    /// Processing queued subtree rebuilds
+    pub subtree_rebuild_ms: f32,
+    /// Incremental layout after subtree rebuilds
+    pub layout_ms: f32,
+    /// Full UI builder run (includes its layout pass)
+    pub ui_build_ms: f32,
+    /// Waiting for the next drawable
+    pub acquire_ms: f32,
+    /// Text preparation and GPU command encoding
+    pub encode_ms: f32,
+    /// Waiting for the GPU to finish after the last submit
+    pub gpu_ms: f32,
+    /// Whole render call (acquire, encode, GPU wait and present)
+    pub render_ms: f32,
+    /// Build and render combined
+    pub frame_ms: f32,
+    /// Prop updates applied
+    pub prop_updates: u32,
+    /// Subtree rebuilds applied (rebuilds queued for the same node count once)
+    pub subtree_rebuilds: u32,
+    /// Nodes laid out this frame (0 when layout was skipped)
+    pub layout_nodes: u32,
+    /// Primitives in the frame's batch
+    pub primitives: u32,
+    /// Text glyphs drawn
+    pub glyphs: u32,
+    /// GPU draw calls
+    pub draw_calls: u32,
+    /// Layer texture pool hit rate over this frame (0.0 - 1.0)
+    pub layer_cache_hit_rate: f32,
+    /// Damage rects redrawn (0 for full repaints and reused frames)
+    pub damage_rects: u32,
+    /// Fraction of the drawable repainted (0.0 - 1.0)
+    pub damage_fraction: f32,
+    /// 1 if the frame moved the previous frame's scroll content instead of
+    /// recording it again
+    pub scroll_composited: u32,
+    /// Quality tier the frame was drawn at (`BLINC_QUALITY_*`)
+    pub quality_tier: u32,
+    /// Frame rate animations were paced to
+    pub target_fps: u32,
+}
+
+fn duration_ms(d: Duration) -> f32 {
+    d.as_secs_f32() * 1000.0
+}
+
+/// Maximum number of samples kept per touch for velocity estimation
+const TOUCH_HISTORY_CAPACITY: usize = 32;
+
+/// Time window (seconds) used by `IOSRenderContext::touch_velocity`
+const TOUCH_VELOCITY_WINDOW: f64 = 0.1;
+
+/// Sample history for a single touch
+#[derive(Default)]
+struct TouchHistory {
+    samples: Vec<blinc_platform_ios::TouchSample>,
+    /// Touch has ended or been cancelled; history is dropped on the next batch
+    ended: bool,
+}
+
+/// Event collected from the event router during touch routing, dispatched afterwards
+#[derive(Clone, Default)]
+struct PendingTouchEvent {
+    node_id: blinc_layout::tree::LayoutNodeId,
+    event_type: u32,
+    /// Touch position (logical points) that produced the event
+    x: f32,
+    y: f32,
 }
 
 impl IOSRenderContext {
@@ -301,21 +475,40 @@ impl IOSRenderContext {
     /// - Reactive state changed (dirty flag)
     /// - Stateful elements need redraw (ButtonState changes, etc.)
     /// - Animations are active
-    /// - Wake was requested by animation thread
+    /// - Wake was requested by the scheduler (an animation started)
+    /// - Async native calls completed and are waiting to be delivered
     pub fn needs_render(&self) -> bool {
+        self.has_pending_work(true)
+    }
+
+    /// Check for pending work, optionally consuming the animation thread's wake request
+    ///
+    /// `needs_render` consumes the wake request (it answers "render now?"), while
+    /// `blinc_frame` peeks after rendering to report whether another frame is needed.
+    fn has_pending_work(&self, consume_wake: bool) -> bool {
         let dirty = self.ref_dirty_flag.load(Ordering::SeqCst);
-        let wake_requested = self.wake_proxy.take_wake_request();
-        let animations_active = self
-            .animations
-            .lock()
-            .map(|sched| sched.has_active_animations())
-            .unwrap_or(false);
+        let wake_requested = if consume_wake {
+            self.wake_proxy.take_wake_request()
+        } else {
+            self.wake_proxy.is_wake_requested()
+        };
+        // Atomic reads only: never wait on a tick holding the scheduler lock
+        let animations_active = self.animation_activity.is_active();
 
         // Check if stateful elements need incremental updates (visual state changes)
-        let has_stateful_updates = blinc_layout::peek_needs_redraw();
-        let has_pending_rebuilds = blinc_layout::has_pending_subtree_rebuilds();
-
-        dirty || wake_requested || animations_active || has_stateful_updates || has_pending_rebuilds
+        let has_stateful_updates = self.update_queue.peek_needs_redraw();
+        let has_pending_rebuilds = self.update_queue.subtree_rebuild_count() > 0;
+
+        let has_native_completions = blinc_core::native_bridge::has_pending_native_completions();
+
+        dirty
+            || wake_requested
+            || animations_active
+            || has_stateful_updates
+            || has_pending_rebuilds
+            || has_native_completions
+            || self.scroll_animating
+            || self.render_tree.is_none()
     }
     /// Update the window size
     ///
@@ -354,13 +547,65 @@ impl IOSRenderContext {
         }
     }
 
+    /// Set the frame rate range the app wants while the device is cool
+    ///
+    /// Animations tick at the preferred rate; `set_power_state` may cap it.
+    pub fn set_frame_rate_range(&mut self, range: FrameRateRange) {
+        self.pacing.set_frame_rate_range(range);
+        self.sync_target_fps();
+    }
+
+    /// Report the device's thermal state and Low Power Mode
+    ///
+    /// Picks the quality tier (MSAA, blur mode) and frame rate cap for
+    /// following frames. Returns true if the tier changed.
+    pub fn set_power_state(&mut self, thermal: ThermalState, low_power: bool) -> bool {
+        let changed = self.pacing.set_power_state(thermal, low_power);
+        if changed {
+            tracing::info!(
+                "iOS power state: {:?}{} -> {:?} quality",
+                thermal,
+                if low_power { ", low power" } else { "" },
+                self.pacing.tier()
+            );
+            // Redraw at the new tier even if nothing else changes
+            self.update_queue.request_redraw();
+        }
+        self.sync_target_fps();
+        changed
+    }
+
+    /// Frame rate range to run the display link at
+    pub fn frame_rate_range(&self) -> FrameRateRange {
+        self.pacing.frame_rate_range()
+    }
+
+    /// Quality tier chosen for the current power state
+    pub fn quality_tier(&self) -> QualityTier {
+        self.pacing.tier()
+    }
+
+    /// Match the scheduler's tick rate to the paced frame rate
+    fn sync_target_fps(&self) {
+        if let Ok(mut scheduler) = self.animations.lock() {
+            scheduler.set_target_fps(self.pacing.target_fps());
+        }
+    }
+
     /// Tick scroll physics - must be called every frame for scroll to work
     ///
     /// Returns true if scroll is animating and needs another frame.
     /// Call this before `build_ui` or `render_frame`.
     pub fn tick_scroll(&mut self) -> bool {
+        self.tick_scroll_at(blinc_layout::prelude::elapsed_ms())
+    }
+
+    /// Tick scroll physics to a specific time (milliseconds, `elapsed_ms` clock)
+    ///
+    /// Returns true if scroll is animating and needs another frame.
+    pub fn tick_scroll_at(&mut self, current_time: u64) -> bool {
+        let _queue = self.update_queue.enter();
         if let Some(ref mut tree) = self.render_tree {
-            let current_time = blinc_layout::prelude::elapsed_ms();
             let animating = tree.tick_scroll_physics(current_time);
             tree.process_pending_scroll_refs();
             animating
@@ -369,6 +614,174 @@ impl IOSRenderContext {
         }
     }
 
+    /// Build a frame using the registered UI builder
+    ///
+    /// Ticks animations exactly once at `tick_at`, delivers completed async
+    /// native calls, applies incremental updates (prop changes, subtree
+    /// rebuilds) and only runs the UI builder if the dirty flag is set or no
+    /// tree exists yet.
+    ///
+    /// Returns true if animations are still active after the tick.
+    pub fn build_frame(&mut self, tick_at: Instant) -> bool {
+        // Elements built and updated here report to this context's queue
+        let _queue = self.update_queue.enter();
+        self.begin_frame_stats();
+
+        // Tick animations
+        let phase_start = Instant::now();
+        let animations_active = {
+            let _span = tracing::trace_span!("blinc.animation").entered();
+            self.animations
+                .lock()
+                .map(|sched| sched.tick_at(tick_at))
+                .unwrap_or(false)
+        };
+        self.frame_stats.animation_ms = duration_ms(phase_start.elapsed());
+
+        // Deliver completed async native calls before building, so state set
+        // by their callbacks is picked up by this frame
+        blinc_core::native_bridge::drain_native_completions();
+
+        // PHASE 1: Process incremental updates (prop changes, subtree rebuilds)
+        // This avoids full rebuild for simple state changes like ButtonState
+        let has_stateful_updates = blinc_layout::take_needs_redraw();
+        let has_pending_rebuilds = blinc_layout::has_pending_subtree_rebuilds();
+
+        if has_stateful_updates || has_pending_rebuilds {
+            // Get all pending prop updates
+            let phase_start = Instant::now();
+            let prop_updates = blinc_layout::take_pending_prop_updates();
+            self.frame_stats.prop_updates = prop_updates.len() as u32;
+
+            // Apply prop updates to the tree
+            if let Some(ref mut tree) = self.render_tree {
+                let _span = tracing::trace_span!("blinc.prop_updates").entered();
+                for (node_id, props) in prop_updates {
+                    tree.update_render_props(node_id, |p| *p = props);
+                }
+            }
+            self.frame_stats.prop_update_ms = duration_ms(phase_start.elapsed());
+
+            // Process subtree rebuilds
+            let phase_start = Instant::now();
+            let mut needs_layout = false;
+            if let Some(ref mut tree) = self.render_tree {
+                let _span = tracing::trace_span!("blinc.subtree_rebuilds").entered();
+                needs_layout = tree.process_pending_subtree_rebuilds();
+                self.frame_stats.subtree_rebuilds = tree.subtree_rebuild_count() as u32;
+            }
+            self.frame_stats.subtree_rebuild_ms = duration_ms(phase_start.elapsed());
+
+            if needs_layout {
+                if let Some(ref mut tree) = self.render_tree {
+                    let _span = tracing::trace_span!("blinc.layout").entered();
+                    let phase_start = Instant::now();
+                    // Only subtrees under changed nodes are laid out again
+                    tree.update_layout(self.windowed_ctx.width, self.windowed_ctx.height);
+                    self.frame_stats.layout_ms = duration_ms(phase_start.elapsed());
+                    self.frame_stats.layout_nodes = tree.layout_node_count() as u32;
+                }
+            }
+        }
+
+        // PHASE 2: Check if full rebuild is needed
+        let needs_rebuild = self.ref_dirty_flag.swap(false, Ordering::SeqCst);
+        let no_tree_yet = self.render_tree.is_none();
+
+        if !needs_rebuild && !no_tree_yet {
+            // No full rebuild needed - incremental updates already applied
+            return animations_active;
+        }
+
+        // PHASE 3: Full rebuild using UI builder (required on first load or when dirty)
+        let _span = tracing::trace_span!("blinc.ui_build").entered();
+        let phase_start = Instant::now();
+        let rust_builder = self
+            .rust_ui_builder
+            .as_ref()
+            .or_else(|| get_rust_ui_builder());
+        if let Some(rust_builder) = rust_builder {
+            // The builder creates the RenderTree for us
+            let tree = rust_builder(&mut self.windowed_ctx, self.render_tree.as_mut());
+            self.frame_stats.layout_nodes = tree.layout_node_count() as u32;
+            self.render_tree = Some(tree);
+            self.rebuild_count += 1;
+        } else if let Some(builder) = self.ui_builder.or_else(get_ui_builder) {
+            builder(&mut self.windowed_ctx as *mut WindowedContext);
+            self.rebuild_count += 1;
+        }
+        self.frame_stats.ui_build_ms = duration_ms(phase_start.elapsed());
+
+        animations_active
+    }
+
+    /// Start collecting stats for a new frame
+    fn begin_frame_stats(&mut self) {
+        self.frame_stats = BlincFrameStats {
+            frame_index: self.frame_stats.frame_index + 1,
+            ..Default::default()
+        };
+        self.frame_stats_open = true;
+    }
+
+    /// Fill in the render side of the current frame's stats and archive it
+    fn finish_frame_stats(&mut self, render_time: Duration, gpu: Option<(RenderStats, Duration)>) {
+        if !self.frame_stats_open {
+            // Rendered without a build (e.g. bare `blinc_render_frame`)
+            self.begin_frame_stats();
+        }
+        let stats = &mut self.frame_stats;
+        stats.render_ms = duration_ms(render_time);
+        if let Some((render, acquire)) = gpu {
+            stats.acquire_ms = duration_ms(acquire);
+            stats.encode_ms = duration_ms(render.encode_time);
+            stats.gpu_ms = duration_ms(render.gpu_time);
+            stats.primitives = render.primitives;
+            stats.glyphs = render.glyphs;
+            stats.draw_calls = render.draw_calls;
+            stats.layer_cache_hit_rate = render.layer_cache_hit_rate;
+            stats.damage_rects = render.damage_rects;
+            stats.damage_fraction = render.damage_fraction;
+        }
+        stats.quality_tier = self.pacing.tier() as u32;
+        stats.target_fps = self.pacing.target_fps();
+        stats.frame_ms = stats.animation_ms
+            + stats.prop_update_ms
+            + stats.subtree_rebuild_ms
+            + stats.layout_ms
+            + stats.ui_build_ms
+            + stats.render_ms;
+
+        if self.frame_stats_history.len() == FRAME_STATS_HISTORY {
+            self.frame_stats_history.pop_front();
+        }
+        self.frame_stats_history.push_back(*stats);
+        self.frame_stats_open = false;
+    }
+
+    /// Take the render tree's damage for the frame about to be rendered
+    ///
+    /// RenderState motions (enter/exit animations) aren't visible to the
+    /// tree's damage tracking, so frames repaint fully while they run and
+    /// once more after they settle.
+    fn take_damage(&mut self) -> Damage {
+        let motions_active =
+            self.render_state.is_animating() || self.render_state.has_active_motions();
+        let settling = std::mem::replace(&mut self.motions_active, motions_active);
+
+        let Some(tree) = self.render_tree.as_mut() else {
+            self.damage_scroll_only = false;
+            return Damage::Full;
+        };
+        let damage = tree.take_damage(self.windowed_ctx.width, self.windowed_ctx.height);
+        self.damage_scroll_only = !(motions_active || settling) && tree.damage_is_scroll_only();
+        if motions_active || settling {
+            Damage::Full
+        } else {
+            damage
+        }
+    }
+
     /// Build and layout the UI tree
     ///
     /// Call this before rendering each frame.
@@ -377,6 +790,8 @@ impl IOSRenderContext {
         F: FnOnce(&mut WindowedContext) -> E,
         E: ElementBuilder,
     {
+        let _queue = self.update_queue.enter();
+
         // Clear dirty flag
         self.ref_dirty_flag.swap(false, Ordering::SeqCst);
 
@@ -442,6 +857,10 @@ impl IOSRenderContext {
     /// Call this from your UIView's touch handling methods.
     /// Touch coordinates should be in logical points (not physical pixels).
     ///
+    /// For high-rate input (ProMotion, `coalescedTouches`) prefer
+    /// [`handle_touches`](Self::handle_touches), which routes a whole batch
+    /// with a single hit test and dispatch.
+    ///
     /// # Example (Swift)
     ///
     /// ```swift
@@ -453,15 +872,116 @@ impl IOSRenderContext {
     /// }
     /// ```
     pub fn handle_touch(&mut self, touch: blinc_platform_ios::Touch) {
-        use blinc_layout::tree::LayoutNodeId;
+        let sample = blinc_platform_ios::BlincTouch {
+            id: touch.id,
+            x: touch.x,
+            y: touch.y,
+            phase: match touch.phase {
+                TouchPhase::Began => 0,
+                TouchPhase::Moved => 1,
+                TouchPhase::Ended => 2,
+                TouchPhase::Cancelled => 3,
+            },
+            force: touch.force,
+            timestamp: 0.0,
+        };
+        self.handle_touches(
+            &[sample],
+            blinc_layout::prelude::elapsed_ms() as f64 / 1000.0,
+        );
+    }
+
+    /// Handle a batch of touch samples delivered in one UIKit callback
+    ///
+    /// Moves are coalesced per touch id to the latest sample before routing,
+    /// while every sample is kept in the per-touch history for gesture
+    /// velocity (see [`touch_velocity`](Self::touch_velocity)). The event
+    /// callback is installed once, scroll deltas are accumulated across the
+    /// batch, and the collected events are dispatched in a single pass.
+    ///
+    /// `timestamp` is the batch time in seconds (`UIEvent.timestamp`); it is
+    /// used for samples whose own timestamp is 0.
+    ///
+    /// # Example (Swift)
+    ///
+    /// ```swift
+    /// override func touchesMoved(_ touches: Set<UITouch>, with event: UIEvent?) {
+    ///     var batch: [BlincTouch] = []
+    ///     for touch in touches {
+    ///         for t in event?.coalescedTouches(for: touch) ?? [touch] {
+    ///             let p = t.location(in: self)
+    ///             batch.append(BlincTouch(id: UInt64(UInt(bitPattern: ObjectIdentifier(touch).hashValue)),
+    ///                                     x: Float(p.x), y: Float(p.y), phase: 1,
+    ///                                     force: Float(t.force), timestamp: t.timestamp))
+    ///         }
+    ///     }
+    ///     blinc_handle_touches(context, batch, batch.count, event?.timestamp ?? 0)
+    /// }
+    /// ```
+    pub fn handle_touches(&mut self, samples: &[blinc_platform_ios::BlincTouch], timestamp: f64) {
+        if samples.is_empty() {
+            return;
+        }
+        let _queue = self.update_queue.enter();
+
+        // Record full-resolution history before coalescing. Histories of touches
+        // that ended in a previous batch are dropped first so ids don't accumulate.
+        self.touch_history.retain(|_, history| !history.ended);
+        let mut batch = std::mem::take(&mut self.touch_batch);
+        batch.clear();
+        for sample in samples {
+            let touch = sample.to_touch();
+            let sample_time = if sample.timestamp > 0.0 {
+                sample.timestamp
+            } else {
+                timestamp
+            };
+            let history = self.touch_history.entry(touch.id).or_default();
+            if touch.phase == TouchPhase::Began {
+                history.samples.clear();
+            }
+            if history.samples.len() == TOUCH_HISTORY_CAPACITY {
+                history.samples.remove(0);
+            }
+            history.samples.push(blinc_platform_ios::TouchSample {
+                x: touch.x,
+                y: touch.y,
+                timestamp: sample_time,
+            });
+            history.ended = matches!(touch.phase, TouchPhase::Ended | TouchPhase::Cancelled);
+            batch.push(touch);
+        }
+
+        let mut touches = std::mem::take(&mut self.coalesced_touches);
+        blinc_platform_ios::coalesce_touches(&batch, &mut touches);
+        self.touch_batch = batch;
 
-        // Pending event structure for deferred dispatch
-        #[derive(Clone, Default)]
-        struct PendingEvent {
-            node_id: LayoutNodeId,
-            event_type: u32,
+        self.route_touches(&touches);
+
+        self.coalesced_touches = touches;
+    }
+
+    /// Estimated velocity of a touch in points per second
+    ///
+    /// Computed from the full (uncoalesced) sample history over the most
+    /// recent `TOUCH_VELOCITY_WINDOW` seconds. Returns `None` for unknown
+    /// touches or when fewer than two samples are available. The history of
+    /// an ended touch stays readable until the next batch arrives.
+    pub fn touch_velocity(&self, touch_id: u64) -> Option<(f32, f32)> {
+        let samples = &self.touch_history.get(&touch_id)?.samples;
+        let last = samples.last()?;
+        let first = samples
+            .iter()
+            .find(|s| last.timestamp - s.timestamp <= TOUCH_VELOCITY_WINDOW)?;
+        let dt = (last.timestamp - first.timestamp) as f32;
+        if dt <= f32::EPSILON {
+            return None;
         }
+        Some(((last.x - first.x) / dt, (last.y - first.y) / dt))
+    }
 
+    /// Route already-coalesced touches through the event router and dispatch
+    fn route_touches(&mut self, touches: &[blinc_platform_ios::Touch]) {
         let tree = match &self.render_tree {
             Some(t) => t,
             None => {
@@ -470,104 +990,105 @@ impl IOSRenderContext {
             }
         };
 
-        // Touch coordinates are already in logical points on iOS
-        let lx = touch.x;
-        let ly = touch.y;
-
-        // Log tree info for debugging
-        if let Some(root) = tree.root() {
-            if let Some(bounds) = tree.layout().get_bounds(root, (0.0, 0.0)) {
-                tracing::trace!(
-                    "[Blinc] iOS Touch at ({:.1}, {:.1}) - tree root bounds: ({:.1}, {:.1}, {:.1}x{:.1})",
-                    lx, ly, bounds.x, bounds.y, bounds.width, bounds.height
-                );
-            } else {
-                tracing::debug!("[Blinc] iOS Touch: tree root has no bounds!");
-            }
-        } else {
-            tracing::debug!("[Blinc] iOS Touch: tree has no root!");
-        }
-
-        // Collect pending events via callback
-        let mut pending_events: Vec<PendingEvent> = Vec::new();
+        // Collect pending events via callback (buffer reused across batches)
+        let mut pending_events = std::mem::take(&mut self.pending_touch_events);
+        pending_events.clear();
 
-        // Set up callback to collect events
+        // Set up callback to collect events - installed once per batch.
+        // The position of the touch being routed is tagged onto each event so
+        // local coordinates stay correct when a batch holds several touches.
+        let current_pos = std::cell::Cell::new((0.0f32, 0.0f32));
         self.windowed_ctx.event_router.set_event_callback({
-            let events = &mut pending_events as *mut Vec<PendingEvent>;
+            let events = &mut pending_events as *mut Vec<PendingTouchEvent>;
+            let pos = &current_pos as *const std::cell::Cell<(f32, f32)>;
             move |node, event_type| {
                 // SAFETY: This callback is only used within this scope
                 unsafe {
-                    (*events).push(PendingEvent {
+                    let (x, y) = (*pos).get();
+                    (*events).push(PendingTouchEvent {
                         node_id: node,
                         event_type,
+                        x,
+                        y,
                     });
                 }
             }
         });
 
-        // Track scroll info for dispatch after regular event handling
+        // Track scroll info for dispatch after regular event handling.
+        // Deltas from all moves in the batch accumulate into one scroll dispatch.
         let mut scroll_info: Option<(f32, f32, f32, f32)> = None;
         let mut touch_ended = false;
 
-        // Route touch event through event router
-        match touch.phase {
-            TouchPhase::Began => {
-                tracing::trace!("[Blinc] iOS Touch BEGAN at ({:.1}, {:.1})", lx, ly);
-                self.windowed_ctx
-                    .event_router
-                    .on_mouse_down(tree, lx, ly, MouseButton::Left);
-                // Initialize touch tracking for scroll
-                self.last_touch_pos = Some((lx, ly));
-                self.is_scrolling = false;
-            }
-            TouchPhase::Moved => {
-                self.windowed_ctx.event_router.on_mouse_move(tree, lx, ly);
-
-                // Calculate scroll delta from touch movement
-                // Touch: dragging down = positive delta = content scrolls up (shows below)
-                if let Some((prev_x, prev_y)) = self.last_touch_pos {
-                    let delta_x = lx - prev_x;
-                    let delta_y = ly - prev_y;
-
-                    // Only dispatch scroll if there's actual movement
-                    // Small threshold to avoid jitter
-                    if delta_x.abs() > 0.5 || delta_y.abs() > 0.5 {
-                        self.is_scrolling = true;
-                        // Store scroll info for dispatch after event loop
-                        scroll_info = Some((lx, ly, delta_x, delta_y));
-                        tracing::trace!("Touch scroll: delta=({:.1}, {:.1})", delta_x, delta_y);
-                    }
+        for touch in touches {
+            // Touch coordinates are already in logical points on iOS
+            let lx = touch.x;
+            let ly = touch.y;
+            current_pos.set((lx, ly));
+
+            // Route touch event through event router
+            match touch.phase {
+                TouchPhase::Began => {
+                    tracing::trace!("[Blinc] iOS Touch BEGAN at ({:.1}, {:.1})", lx, ly);
+                    self.windowed_ctx
+                        .event_router
+                        .on_mouse_down(tree, lx, ly, MouseButton::Left);
+                    // Initialize touch tracking for scroll
+                    self.last_touch_pos = Some((lx, ly));
+                    self.is_scrolling = false;
                 }
+                TouchPhase::Moved => {
+                    self.windowed_ctx.event_router.on_mouse_move(tree, lx, ly);
+
+                    // Calculate scroll delta from touch movement
+                    // Touch: dragging down = positive delta = content scrolls up (shows below)
+                    if let Some((prev_x, prev_y)) = self.last_touch_pos {
+                        let delta_x = lx - prev_x;
+                        let delta_y = ly - prev_y;
+
+                        // Only dispatch scroll if there's actual movement
+                        // Small threshold to avoid jitter
+                        if delta_x.abs() > 0.5 || delta_y.abs() > 0.5 {
+                            self.is_scrolling = true;
+                            let (acc_x, acc_y) = scroll_info
+                                .map(|(_, _, dx, dy)| (dx, dy))
+                                .unwrap_or((0.0, 0.0));
+                            // Store scroll info for dispatch after event loop
+                            scroll_info = Some((lx, ly, acc_x + delta_x, acc_y + delta_y));
+                            tracing::trace!("Touch scroll: delta=({:.1}, {:.1})", delta_x, delta_y);
+                        }
+                    }
 
-                // Update last touch position
-                self.last_touch_pos = Some((lx, ly));
-            }
-            TouchPhase::Ended => {
-                tracing::trace!("[Blinc] iOS Touch ENDED at ({:.1}, {:.1})", lx, ly);
-                self.windowed_ctx
-                    .event_router
-                    .on_mouse_up(tree, lx, ly, MouseButton::Left);
-                // On touch devices, finger lift means pointer leaves too
-                // This transitions ButtonState from Hovered back to Idle
-                self.windowed_ctx.event_router.on_mouse_leave();
-
-                // Mark touch ended for scroll physics
-                if self.is_scrolling {
-                    touch_ended = true;
+                    // Update last touch position
+                    self.last_touch_pos = Some((lx, ly));
                 }
-                // Clear touch tracking
-                self.last_touch_pos = None;
-                self.is_scrolling = false;
-            }
-            TouchPhase::Cancelled => {
-                tracing::trace!("[Blinc] iOS Touch CANCELLED");
-                self.windowed_ctx.event_router.on_mouse_leave();
-                // Clear touch tracking on cancel too
-                self.last_touch_pos = None;
-                if self.is_scrolling {
-                    touch_ended = true;
+                TouchPhase::Ended => {
+                    tracing::trace!("[Blinc] iOS Touch ENDED at ({:.1}, {:.1})", lx, ly);
+                    self.windowed_ctx
+                        .event_router
+                        .on_mouse_up(tree, lx, ly, MouseButton::Left);
+                    // On touch devices, finger lift means pointer leaves too
+                    // This transitions ButtonState from Hovered back to Idle
+                    self.windowed_ctx.event_router.on_mouse_leave();
+
+                    // Mark touch ended for scroll physics
+                    if self.is_scrolling {
+                        touch_ended = true;
+                    }
+                    // Clear touch tracking
+                    self.last_touch_pos = None;
+                    self.is_scrolling = false;
+                }
+                TouchPhase::Cancelled => {
+                    tracing::trace!("[Blinc] iOS Touch CANCELLED");
+                    self.windowed_ctx.event_router.on_mouse_leave();
+                    // Clear touch tracking on cancel too
+                    self.last_touch_pos = None;
+                    if self.is_scrolling {
+                        touch_ended = true;
+                    }
+                    self.is_scrolling = false;
                 }
-                self.is_scrolling = false;
             }
         }
 
@@ -575,29 +1096,28 @@ impl IOSRenderContext {
         self.windowed_ctx.event_router.clear_event_callback();
 
         tracing::trace!(
-            "[Blinc] iOS Touch: collected {} pending events",
-            pending_events.len()
+            "[Blinc] iOS Touch: collected {} pending events from {} touches",
+            pending_events.len(),
+            touches.len()
         );
 
         // Dispatch collected events to the tree
         if !pending_events.is_empty() {
-            tracing::trace!("[Blinc] iOS dispatching {} events", pending_events.len());
-
             if let Some(ref mut tree) = self.render_tree {
                 let router = &self.windowed_ctx.event_router;
-                for event in pending_events {
+                for event in pending_events.iter() {
                     // Get bounds for local coordinate calculation
                     let (bounds_x, bounds_y, bounds_width, bounds_height) = router
                         .get_node_bounds(event.node_id)
                         .unwrap_or((0.0, 0.0, 0.0, 0.0));
-                    let local_x = lx - bounds_x;
-                    let local_y = ly - bounds_y;
+                    let local_x = event.x - bounds_x;
+                    let local_y = event.y - bounds_y;
 
                     tree.dispatch_event_full(
                         event.node_id,
                         event.event_type,
-                        lx,
-                        ly,
+                        event.x,
+                        event.y,
                         local_x,
                         local_y,
                         bounds_x,
@@ -612,6 +1132,7 @@ impl IOSRenderContext {
             // Stateful elements will call request_redraw() internally when state changes
             // The needs_render() check will pick this up for the next frame
         }
+        self.pending_touch_events = pending_events;
 
         // Dispatch scroll events (touch scrolling)
         // NOTE: Do NOT set ref_dirty_flag here - that triggers full UI rebuild!
@@ -657,6 +1178,117 @@ impl IOSRenderContext {
     pub fn set_focused(&mut self, focused: bool) {
         self.windowed_ctx.focused = focused;
     }
+
+    /// Use `builder` for this context instead of the registered UI builder
+    ///
+    /// Lets several contexts (e.g. one per window or embedded view) in the
+    /// same process show different UIs.
+    pub fn set_rust_ui_builder<F, E>(&mut self, builder: F)
+    where
+        F: Fn(&mut WindowedContext) -> E + Send + Sync + 'static,
+        E: ElementBuilder + 'static,
+    {
+        self.rust_ui_builder = Some(box_rust_ui_builder(builder));
+        self.ref_dirty_flag.store(true, Ordering::SeqCst);
+    }
+
+    /// Get this context's update queue
+    ///
+    /// Elements built by this context report redraws and incremental updates
+    /// here rather than to the process-wide default queue.
+    pub fn update_queue(&self) -> &SharedUpdateQueue {
+        &self.update_queue
+    }
+}
+
+/// Touch id used for inputs injected by a profiling replay
+#[cfg(feature = "replay-profile")]
+const REPLAY_TOUCH_ID: u64 = u64::MAX;
+
+#[cfg(feature = "replay-profile")]
+impl IOSRenderContext {
+    /// Inject the replay's inputs for the next frame as touches
+    ///
+    /// Returns false when no replay is running or it has just finished.
+    fn begin_replay_frame(&mut self) -> bool {
+        let Some(update) = self.replay.as_mut().and_then(|replay| replay.next_frame()) else {
+            return false;
+        };
+
+        use blinc_recorder::SimulatedInput;
+        for input in &update.events {
+            match input {
+                SimulatedInput::MouseDown { position, .. } => {
+                    self.replay_touch(position.x, position.y, TouchPhase::Began);
+                }
+                SimulatedInput::MouseMove { position, .. } if self.replay_touch_down => {
+                    self.replay_touch(position.x, position.y, TouchPhase::Moved);
+                }
+                SimulatedInput::MouseUp { position, .. } => {
+                    self.replay_touch(position.x, position.y, TouchPhase::Ended);
+                }
+                SimulatedInput::Click { position, .. }
+                | SimulatedInput::DoubleClick { position, .. } => {
+                    self.replay_touch(position.x, position.y, TouchPhase::Began);
+                    self.replay_touch(position.x, position.y, TouchPhase::Ended);
+                }
+                SimulatedInput::Scroll {
+                    position,
+                    delta_x,
+                    delta_y,
+                    ..
+                } => {
+                    // A wheel step becomes a short drag by the same delta
+                    self.replay_touch(position.x, position.y, TouchPhase::Began);
+                    self.replay_touch(
+                        position.x + delta_x,
+                        position.y + delta_y,
+                        TouchPhase::Moved,
+                    );
+                    self.replay_touch(
+                        position.x + delta_x,
+                        position.y + delta_y,
+                        TouchPhase::Ended,
+                    );
+                }
+                _ => {}
+            }
+        }
+        true
+    }
+
+    fn replay_touch(&mut self, x: f32, y: f32, phase: TouchPhase) {
+        self.replay_touch_down = matches!(phase, TouchPhase::Began | TouchPhase::Moved);
+        self.handle_touch(blinc_platform_ios::Touch::new(REPLAY_TOUCH_ID, x, y, phase));
+    }
+
+    /// Record the stages of the frame rendered since `begin_replay_frame`
+    fn finish_replay_frame(&mut self, frames_before: u64) {
+        let Some(replay) = self.replay.as_mut() else {
+            return;
+        };
+        let stages = match self.frame_stats_history.back() {
+            Some(stats) if stats.frame_index > frames_before => {
+                let ms = |ms: f32| Duration::from_secs_f32(ms.max(0.0) / 1000.0);
+                vec![
+                    blinc_recorder::FrameStage::new("animation", ms(stats.animation_ms)),
+                    blinc_recorder::FrameStage::new("prop_update", ms(stats.prop_update_ms)),
+                    blinc_recorder::FrameStage::new(
+                        "subtree_rebuild",
+                        ms(stats.subtree_rebuild_ms),
+                    ),
+                    blinc_recorder::FrameStage::new("layout", ms(stats.layout_ms)),
+                    blinc_recorder::FrameStage::new("build", ms(stats.ui_build_ms)),
+                    blinc_recorder::FrameStage::new("acquire", ms(stats.acquire_ms)),
+                    blinc_recorder::FrameStage::new("encode", ms(stats.encode_ms)),
+                    blinc_recorder::FrameStage::new("gpu", ms(stats.gpu_ms)),
+                ]
+            }
+            // Nothing changed, so nothing was rendered
+            _ => Vec::new(),
+        };
+        replay.finish_frame(stages);
+    }
 }
 
 // =============================================================================
@@ -694,14 +1326,22 @@ where
     F: Fn(&mut WindowedContext) -> E + Send + Sync + 'static,
     E: ElementBuilder + 'static,
 {
-    let boxed_builder: RustUIBuilder = Box::new(move |ctx, _existing_tree| {
+    let _ = RUST_UI_BUILDER.set(box_rust_ui_builder(builder));
+}
+
+/// Wrap an element builder into a builder that creates the laid out tree
+fn box_rust_ui_builder<F, E>(builder: F) -> RustUIBuilder
+where
+    F: Fn(&mut WindowedContext) -> E + Send + Sync + 'static,
+    E: ElementBuilder + 'static,
+{
+    Box::new(move |ctx, _existing_tree| {
         let element = builder(ctx);
         let mut tree = RenderTree::from_element(&element);
         tree.set_scale_factor(ctx.scale_factor as f32);
         tree.compute_layout(ctx.width, ctx.height);
         tree
-    });
-    let _ = RUST_UI_BUILDER.set(boxed_builder);
+    })
 }
 
 /// Get the registered Rust UI builder
@@ -730,7 +1370,7 @@ fn get_rust_ui_builder() -> Option<&'static RustUIBuilder> {
 pub type UIBuilderFn = extern "C" fn(ctx: *mut WindowedContext);
 
 /// Stored UI builder for FFI
-static mut UI_BUILDER: Option<UIBuilderFn> = None;
+static UI_BUILDER: Mutex<Option<UIBuilderFn>> = Mutex::new(None);
 
 /// Register a UI builder function (C FFI for Swift/Rust interop)
 ///
@@ -741,14 +1381,31 @@ static mut UI_BUILDER: Option<UIBuilderFn> = None;
 /// The function pointer must remain valid for the lifetime of the application.
 #[no_mangle]
 pub extern "C" fn blinc_set_ui_builder(builder: UIBuilderFn) {
+    *UI_BUILDER.lock().unwrap() = Some(builder);
+}
+
+/// Register a UI builder for one context only (C FFI for Swift)
+///
+/// Takes precedence over `blinc_set_ui_builder` and
+/// `register_rust_ui_builder`, so each context can show its own UI.
+///
+/// # Safety
+/// `ctx` must be a valid pointer returned by `blinc_create_context`, and the
+/// function pointer must remain valid for the lifetime of the context.
+#[no_mangle]
+pub extern "C" fn blinc_set_context_ui_builder(ctx: *mut IOSRenderContext, builder: UIBuilderFn) {
+    if ctx.is_null() {
+        return;
+    }
     unsafe {
-        UI_BUILDER = Some(builder);
+        (*ctx).ui_builder = Some(builder);
+        (*ctx).ref_dirty_flag.store(true, Ordering::SeqCst);
     }
 }
 
 /// Get the registered UI builder (internal use)
 fn get_ui_builder() -> Option<UIBuilderFn> {
-    unsafe { UI_BUILDER }
+    *UI_BUILDER.lock().unwrap()
 }
 
 /// Build a frame using the registered UI builder (C FFI for Swift)
@@ -770,59 +1427,7 @@ pub extern "C" fn blinc_build_frame(ctx: *mut IOSRenderContext) {
     }
 
     unsafe {
-        let ctx = &mut *ctx;
-
-        // Tick animations
-        if let Ok(sched) = ctx.animations.lock() {
-            sched.tick();
-        }
-
-        // PHASE 1: Process incremental updates (prop changes, subtree rebuilds)
-        // This avoids full rebuild for simple state changes like ButtonState
-        let has_stateful_updates = blinc_layout::take_needs_redraw();
-        let has_pending_rebuilds = blinc_layout::has_pending_subtree_rebuilds();
-
-        if has_stateful_updates || has_pending_rebuilds {
-            // Get all pending prop updates
-            let prop_updates = blinc_layout::take_pending_prop_updates();
-
-            // Apply prop updates to the tree
-            if let Some(ref mut tree) = ctx.render_tree {
-                for (node_id, props) in &prop_updates {
-                    tree.update_render_props(*node_id, |p| *p = props.clone());
-                }
-            }
-
-            // Process subtree rebuilds
-            let mut needs_layout = false;
-            if let Some(ref mut tree) = ctx.render_tree {
-                needs_layout = tree.process_pending_subtree_rebuilds();
-            }
-
-            if needs_layout {
-                if let Some(ref mut tree) = ctx.render_tree {
-                    tree.compute_layout(ctx.windowed_ctx.width, ctx.windowed_ctx.height);
-                }
-            }
-        }
-
-        // PHASE 2: Check if full rebuild is needed
-        let needs_rebuild = ctx.ref_dirty_flag.swap(false, Ordering::SeqCst);
-        let no_tree_yet = ctx.render_tree.is_none();
-
-        if !needs_rebuild && !no_tree_yet {
-            // No full rebuild needed - incremental updates already applied
-            return;
-        }
-
-        // PHASE 3: Full rebuild using UI builder (required on first load or when dirty)
-        if let Some(rust_builder) = get_rust_ui_builder() {
-            // The builder creates the RenderTree for us
-            let tree = rust_builder(&mut ctx.windowed_ctx, ctx.render_tree.as_mut());
-            ctx.render_tree = Some(tree);
-        } else if let Some(builder) = get_ui_builder() {
-            builder(&mut ctx.windowed_ctx as *mut WindowedContext);
-        }
+        (*ctx).build_frame(Instant::now());
     }
 }
 
@@ -920,12 +1525,7 @@ pub extern "C" fn blinc_handle_touch(
         return;
     }
 
-    let touch_phase = match phase {
-        0 => TouchPhase::Began,
-        1 => TouchPhase::Moved,
-        2 => TouchPhase::Ended,
-        _ => TouchPhase::Cancelled,
-    };
+    let touch_phase = blinc_platform_ios::touch_phase_from_raw(phase);
 
     let touch = blinc_platform_ios::Touch::new(touch_id, x, y, touch_phase);
     unsafe {
@@ -934,17 +1534,50 @@ pub extern "C" fn blinc_handle_touch(
     tracing::trace!("[Blinc FFI] blinc_handle_touch completed");
 }
 
-/// Set the focus state (C FFI for Swift)
+/// Handle a batch of touch samples (C FFI for Swift)
+///
+/// Pass every `UITouch` of a UIKit touch callback, including the entries of
+/// `coalescedTouches(for:)`, in one packed array. Moves are merged per touch id
+/// to the latest sample (full history is kept for gesture velocity), and the
+/// batch produces one hit test and one dispatch.
+///
+/// # Arguments
+/// * `ctx` - Render context pointer
+/// * `touches` - Pointer to `count` packed `BlincTouch` samples
+/// * `count` - Number of samples
+/// * `timestamp` - Batch timestamp in seconds (`UIEvent.timestamp`)
 ///
 /// # Safety
-/// `ctx` must be a valid pointer returned by `blinc_create_context`.
+/// * `ctx` must be a valid pointer returned by `blinc_create_context`
+/// * `touches` must point to `count` valid `BlincTouch` values (may be null if `count` is 0)
 #[no_mangle]
-pub extern "C" fn blinc_set_focused(ctx: *mut IOSRenderContext, focused: bool) {
-    if ctx.is_null() {
+pub extern "C" fn blinc_handle_touches(
+    ctx: *mut IOSRenderContext,
+    touches: *const blinc_platform_ios::BlincTouch,
+    count: usize,
+    timestamp: f64,
+) {
+    if ctx.is_null() || touches.is_null() || count == 0 {
         return;
     }
+
     unsafe {
-        (*ctx).set_focused(focused);
+        let samples = std::slice::from_raw_parts(touches, count);
+        (*ctx).handle_touches(samples, timestamp);
+    }
+}
+
+/// Set the focus state (C FFI for Swift)
+///
+/// # Safety
+/// `ctx` must be a valid pointer returned by `blinc_create_context`.
+#[no_mangle]
+pub extern "C" fn blinc_set_focused(ctx: *mut IOSRenderContext, focused: bool) {
+    if ctx.is_null() {
+        return;
+    }
+    unsafe {
+        (*ctx).set_focused(focused);
     }
 }
 
@@ -966,8 +1599,9 @@ pub extern "C" fn blinc_destroy_context(ctx: *mut IOSRenderContext) {
 
 /// Tick animations (C FFI for Swift)
 ///
-/// Call this each frame before building UI. Returns true if any animations
-/// are active (meaning you should continue rendering).
+/// Returns true if any animations are active (meaning you should continue
+/// rendering). `blinc_build_frame` and `blinc_frame` already tick animations,
+/// so only call this when driving the scheduler without them.
 ///
 /// # Safety
 /// `ctx` must be a valid pointer returned by `blinc_create_context`.
@@ -1050,6 +1684,7 @@ pub extern "C" fn blinc_mark_dirty(ctx: *mut IOSRenderContext) {
     }
     unsafe {
         (*ctx).ref_dirty_flag.store(true, Ordering::SeqCst);
+        (*ctx).wake_proxy.wake();
     }
 }
 
@@ -1105,18 +1740,430 @@ pub extern "C" fn blinc_get_physical_height(ctx: *mut IOSRenderContext) -> u32 {
 
 /// GPU renderer state for iOS
 pub struct IOSGpuRenderer {
+    /// App and surface, shared with the render thread when it is running
+    state: Arc<Mutex<IOSGpuState>>,
+    /// Surface size in pixels (mirrors `surface_config` without taking the lock)
+    surface_size: (u32, u32),
+    /// Render context reference
+    render_ctx: *mut IOSRenderContext,
+    /// Dedicated encode/present thread (see `blinc_start_render_thread`)
+    render_thread: Option<IOSRenderThread>,
+    /// Display list of the last frame, kept while frames only scroll
+    ///
+    /// Only used without the render thread, which hands its last frame back
+    /// through the mailbox instead.
+    scroll_list: Option<DisplayList>,
+    /// Quality tier the app is currently set up for
+    quality_tier: QualityTier,
+    /// Blur mode chosen at init, used at `QualityTier::Full`
+    base_blur_mode: blinc_gpu::BlurMode,
+    /// The app's text context, which canvas text is shaped into while
+    /// recording display lists on this thread
+    text_ctx: Arc<Mutex<TextRenderingContext>>,
+}
+
+/// The parts of the GPU renderer that may live on the render thread
+struct IOSGpuState {
     /// The Blinc application (includes renderer, text context, image context)
     app: BlincApp,
     /// The wgpu surface
     surface: wgpu::Surface<'static>,
     /// Surface configuration
     surface_config: wgpu::SurfaceConfiguration,
-    /// Render context reference
-    render_ctx: *mut IOSRenderContext,
+    /// Time the last frame waited for its drawable
+    last_acquire: Duration,
+    /// Damage of frames that were dropped before reaching the retained frame
+    missed_damage: Damage,
+}
+
+impl IOSGpuState {
+    /// Apply `surface_config` to the surface
+    fn configure(&mut self) {
+        self.surface
+            .configure(self.app.device(), &self.surface_config);
+    }
+
+    /// Acquire the next drawable, reconfiguring once if the surface was lost
+    fn acquire(&mut self) -> Option<wgpu::SurfaceTexture> {
+        let _span = tracing::trace_span!("blinc.acquire").entered();
+        let start = Instant::now();
+        let texture = self.acquire_inner();
+        self.last_acquire = start.elapsed();
+        texture
+    }
+
+    fn acquire_inner(&mut self) -> Option<wgpu::SurfaceTexture> {
+        match self.surface.get_current_texture() {
+            Ok(st) => Some(st),
+            Err(wgpu::SurfaceError::Lost | wgpu::SurfaceError::Outdated) => {
+                // Reconfigure surface and try again
+                self.configure();
+                match self.surface.get_current_texture() {
+                    Ok(st) => Some(st),
+                    Err(e) => {
+                        tracing::error!("blinc_render_frame: surface error: {:?}", e);
+                        None
+                    }
+                }
+            }
+            Err(e) => {
+                tracing::error!("blinc_render_frame: surface error: {:?}", e);
+                None
+            }
+        }
+    }
+
+    /// Combine `damage` with anything left over from dropped frames
+    fn frame_damage(&mut self, damage: &Damage) -> Damage {
+        let mut damage = damage.clone();
+        damage.merge(std::mem::take(&mut self.missed_damage));
+        damage
+    }
+
+    /// Encode the current render tree of `ctx` and present it
+    fn render_tree(&mut self, ctx: &IOSRenderContext, damage: &Damage) -> bool {
+        let damage = self.frame_damage(damage);
+        let Some(surface_texture) = self.acquire() else {
+            self.missed_damage = damage;
+            return false;
+        };
+
+        // Get render tree
+        let tree = match ctx.render_tree.as_ref() {
+            Some(t) => t,
+            None => {
+                surface_texture.present();
+                return true; // No tree yet, just present empty frame
+            }
+        };
+
+        // Render
+        let view = surface_texture
+            .texture
+            .create_view(&wgpu::TextureViewDescriptor::default());
+
+        if let Err(e) = self.app.render_tree_with_damage(
+            tree,
+            &ctx.render_state,
+            &damage,
+            &view,
+            self.surface_config.width,
+            self.surface_config.height,
+        ) {
+            tracing::error!("blinc_render_frame: render error: {}", e);
+            surface_texture.present();
+            return false;
+        }
+
+        surface_texture.present();
+        true
+    }
+
+    /// Encode a recorded frame and present it
+    ///
+    /// The list is left intact so scroll frames can reuse it.
+    fn render_display_list(&mut self, list: &mut DisplayList) -> bool {
+        let damage = self.frame_damage(list.damage());
+        list.set_damage(damage);
+
+        // Frames recorded before a resize would be stretched; the UI thread
+        // records a fresh one for the new size
+        if list.size() != (self.surface_config.width, self.surface_config.height) {
+            self.missed_damage = list.damage().clone();
+            return false;
+        }
+
+        let Some(surface_texture) = self.acquire() else {
+            self.missed_damage = list.damage().clone();
+            return false;
+        };
+        let view = surface_texture
+            .texture
+            .create_view(&wgpu::TextureViewDescriptor::default());
+
+        let ok = match self.app.render_display_list(list, &view) {
+            Ok(()) => true,
+            Err(e) => {
+                tracing::error!("blinc render thread: render error: {}", e);
+                false
+            }
+        };
+        surface_texture.present();
+        ok
+    }
+}
+
+/// Single-slot handoff between the UI thread and the render thread
+///
+/// Holds at most one frame: a newer display list replaces one the render
+/// thread hasn't picked up yet, so a slow GPU drops frames instead of
+/// building latency.
+#[derive(Default)]
+struct FrameMailbox {
+    pending: Option<DisplayList>,
+    /// Most recently submitted frame after it was encoded, handed back for
+    /// scroll frames to move instead of recording again
+    spent: Option<DisplayList>,
+    stop: bool,
+}
+
+/// Blinc-owned thread that encodes display lists, acquires drawables and presents
+struct IOSRenderThread {
+    mailbox: Arc<(Mutex<FrameMailbox>, Condvar)>,
+    handle: Option<JoinHandle<()>>,
+}
+
+impl IOSRenderThread {
+    fn spawn(state: Arc<Mutex<IOSGpuState>>) -> std::io::Result<Self> {
+        let mailbox = Arc::new((Mutex::new(FrameMailbox::default()), Condvar::new()));
+        let thread_mailbox = Arc::clone(&mailbox);
+
+        let handle = std::thread::Builder::new()
+            .name("blinc-render".to_string())
+            .spawn(move || {
+                let (lock, ready) = &*thread_mailbox;
+                loop {
+                    let mut list = {
+                        let mut mailbox = lock.lock().unwrap();
+                        loop {
+                            if mailbox.stop {
+                                return;
+                            }
+                            if let Some(list) = mailbox.pending.take() {
+                                break list;
+                            }
+                            mailbox = ready.wait(mailbox).unwrap();
+                        }
+                    };
+                    state.lock().unwrap().render_display_list(&mut list);
+
+                    // A frame already replaced by a newer one can't be reused
+                    let mut mailbox = lock.lock().unwrap();
+                    if mailbox.pending.is_none() && list.has_scroll_content() {
+                        mailbox.spent = Some(list);
+                    }
+                }
+            })?;
+
+        Ok(Self {
+            mailbox,
+            handle: Some(handle),
+        })
+    }
+
+    /// Hand a frame to the render thread, replacing any frame not yet encoded
+    ///
+    /// A replaced frame's damage is carried over, since it never reached the
+    /// retained frame.
+    fn submit(&self, list: DisplayList) {
+        let (lock, ready) = &*self.mailbox;
+        let mut mailbox = lock.lock().unwrap();
+        mailbox.spent = None;
+        let list = match mailbox.pending.take() {
+            Some(dropped) => {
+                let mut damage = dropped.damage().clone();
+                damage.merge(list.damage().clone());
+                list.with_damage(damage)
+            }
+            None => list,
+        };
+        mailbox.pending = Some(list);
+        drop(mailbox);
+        ready.notify_one();
+    }
+
+    /// Take back the last submitted frame, if it has been encoded
+    fn take_spent(&self) -> Option<DisplayList> {
+        self.mailbox.0.lock().unwrap().spent.take()
+    }
+}
+
+impl Drop for IOSRenderThread {
+    fn drop(&mut self) {
+        let (lock, ready) = &*self.mailbox;
+        lock.lock().unwrap().stop = true;
+        ready.notify_one();
+        if let Some(handle) = self.handle.take() {
+            let _ = handle.join();
+        }
+    }
+}
+
+impl Drop for IOSGpuRenderer {
+    fn drop(&mut self) {
+        // Join the render thread first so the surface is released here
+        self.render_thread = None;
+    }
+}
+
+impl IOSGpuRenderer {
+    /// Render the current render tree of `ctx`
+    ///
+    /// With the render thread running this records a display list and hands
+    /// it off; otherwise the frame is encoded and presented inline.
+    /// Returns true if the frame was rendered (or queued) successfully.
+    fn render(&mut self, ctx: &mut IOSRenderContext) -> bool {
+        let _span = tracing::trace_span!("blinc.render").entered();
+        let start = Instant::now();
+        let tier = ctx.pacing.tier();
+        let mut damage = ctx.take_damage();
+        if tier != self.quality_tier {
+            self.apply_quality_tier(tier);
+            // Nothing drawn at the old tier can be kept
+            ctx.damage_scroll_only = false;
+            damage = Damage::Full;
+        }
+        let rendered = self.render_inner(ctx, &damage);
+        let gpu_stats = self.gpu_stats();
+        ctx.finish_frame_stats(start.elapsed(), gpu_stats);
+        rendered
+    }
+
+    /// Switch MSAA and blur quality to `tier`
+    ///
+    /// Waits for the render thread's frame in flight, so later frames are
+    /// all encoded at the new tier. The retained frame and glass backdrop
+    /// are dropped along the way; the caller draws this frame in full.
+    fn apply_quality_tier(&mut self, tier: QualityTier) {
+        let mut state = self.state.lock().unwrap();
+        let sample_count = tier.sample_count(state.app.config().sample_count);
+        state.app.set_sample_count(sample_count);
+        state.app.set_blur_mode(tier.blur_mode(self.base_blur_mode));
+        tracing::info!(
+            "Quality tier {:?}: {}x MSAA, {:?} blur",
+            tier,
+            sample_count,
+            state.app.blur_mode()
+        );
+        self.quality_tier = tier;
+    }
+
+    /// Render counters and drawable wait of the latest encoded frame
+    ///
+    /// Doesn't block on the render thread; returns None while it holds the state.
+    fn gpu_stats(&self) -> Option<(RenderStats, Duration)> {
+        let state = if self.render_thread.is_some() {
+            self.state.try_lock().ok()?
+        } else {
+            self.state.lock().ok()?
+        };
+        Some((state.app.last_render_stats(), state.last_acquire))
+    }
+
+    fn render_inner(&mut self, ctx: &mut IOSRenderContext, damage: &Damage) -> bool {
+        if !ctx.damage_scroll_only {
+            self.scroll_list = None;
+        } else if let Some(list) = self.scroll_frame(ctx) {
+            let mut list = list.with_damage(damage.clone());
+            return match &self.render_thread {
+                Some(thread) => {
+                    thread.submit(list);
+                    true
+                }
+                None => {
+                    let rendered = self.state.lock().unwrap().render_display_list(&mut list);
+                    if list.has_scroll_content() {
+                        self.scroll_list = Some(list);
+                    }
+                    rendered
+                }
+            };
+        }
+
+        if let Some(thread) = &self.render_thread {
+            let Some(tree) = ctx.render_tree.as_ref() else {
+                return false;
+            };
+            let (width, height) = self.surface_size;
+            let list = DisplayList::record(tree, &ctx.render_state, &self.text_ctx, width, height);
+            thread.submit(list.with_damage(damage.clone()));
+            return true;
+        }
+
+        self.state.lock().unwrap().render_tree(ctx, damage)
+    }
+
+    /// Display list for a frame where only scroll offsets changed
+    ///
+    /// Moves the previous frame's scroll content to the new offsets when it
+    /// can, so momentum and drag frames skip the tree walk entirely; otherwise
+    /// records a new list. The previous list is moved, not copied: it comes
+    /// from `scroll_list`, or back from the render thread once encoded (if it
+    /// is still being encoded, the frame is recorded). Returns None if there
+    /// is no render tree yet.
+    fn scroll_frame(&mut self, ctx: &mut IOSRenderContext) -> Option<DisplayList> {
+        let tree = ctx.render_tree.as_ref()?;
+        let size = self.surface_size;
+
+        let previous = match &self.render_thread {
+            Some(thread) => thread.take_spent(),
+            None => self.scroll_list.take(),
+        };
+        if let Some(mut list) = previous {
+            if list.size() == size && list.apply_scroll(tree) {
+                ctx.frame_stats.scroll_composited = 1;
+                return Some(list);
+            }
+        }
+
+        Some(DisplayList::record(
+            tree,
+            &ctx.render_state,
+            &self.text_ctx,
+            size.0,
+            size.1,
+        ))
+    }
+}
+
+/// Options for `blinc_init_gpu_with_options`
+///
+/// Zero-initialising this struct from C gives no pipeline cache and
+/// synchronous pipeline compilation; use `blinc_gpu_options_default` for the
+/// recommended defaults.
+#[repr(C)]
+#[derive(Clone, Copy, Debug)]
+pub struct BlincGpuOptions {
+    /// UTF-8 path of a writable directory for the persistent pipeline cache
+    /// (e.g. the app's Caches directory), or null for no cache
+    pub pipeline_cache_dir: *const std::ffi::c_char,
+    /// Compile glass and effect pipelines on a background thread instead of
+    /// blocking init; the first frame that uses them waits for the compile
+    pub background_pipeline_compilation: bool,
+    /// Keep the previous frame and redraw only damaged regions when possible
+    /// (costs one drawable-sized texture)
+    pub partial_redraw: bool,
+    /// Blur glass, shadows and blur effects through a downsampled pyramid
+    /// (`BlurMode::Performance`), reusing the glass backdrop while the
+    /// content under it is unchanged
+    pub performance_blur: bool,
+}
+
+impl Default for BlincGpuOptions {
+    fn default() -> Self {
+        Self {
+            pipeline_cache_dir: std::ptr::null(),
+            background_pipeline_compilation: true,
+            partial_redraw: true,
+            performance_blur: false,
+        }
+    }
+}
+
+/// Get the default GPU init options (C FFI for Swift)
+///
+/// # Returns
+/// Options with no pipeline cache, and background pipeline compilation and
+/// partial redraw enabled
+#[no_mangle]
+pub extern "C" fn blinc_gpu_options_default() -> BlincGpuOptions {
+    BlincGpuOptions::default()
 }
 
 /// Initialize the GPU renderer with a CAMetalLayer (C FFI for Swift)
 ///
+/// Equivalent to `blinc_init_gpu_with_options` with default options.
+///
 /// # Arguments
 /// * `ctx` - Render context pointer from `blinc_create_context`
 /// * `metal_layer` - Pointer to CAMetalLayer (from UIView.layer)
@@ -1136,23 +2183,48 @@ pub extern "C" fn blinc_init_gpu(
     width: u32,
     height: u32,
 ) -> *mut IOSGpuRenderer {
-    use blinc_gpu::{GpuRenderer, RendererConfig, TextRenderingContext};
+    let options = BlincGpuOptions::default();
+    blinc_init_gpu_with_options(ctx, metal_layer, width, height, &options)
+}
+
+/// Initialize the GPU renderer with a CAMetalLayer and init options (C FFI for Swift)
+///
+/// # Arguments
+/// * `ctx` - Render context pointer from `blinc_create_context`
+/// * `metal_layer` - Pointer to CAMetalLayer (from UIView.layer)
+/// * `width` - Drawable width in pixels
+/// * `height` - Drawable height in pixels
+/// * `options` - Init options, or null for defaults
+///
+/// # Returns
+/// Pointer to GPU renderer, or null on failure
+///
+/// # Safety
+/// * `ctx` must be a valid pointer returned by `blinc_create_context`
+/// * `metal_layer` must be a valid pointer to a CAMetalLayer
+/// * `options` must be null or point to a valid `BlincGpuOptions` whose
+///   `pipeline_cache_dir` is null or a null-terminated string
+#[no_mangle]
+pub extern "C" fn blinc_init_gpu_with_options(
+    ctx: *mut IOSRenderContext,
+    metal_layer: *mut std::ffi::c_void,
+    width: u32,
+    height: u32,
+    options: *const BlincGpuOptions,
+) -> *mut IOSGpuRenderer {
+    use blinc_gpu::{GpuRenderer, TextRenderingContext};
 
     if ctx.is_null() || metal_layer.is_null() {
         tracing::error!("blinc_init_gpu: null context or metal_layer");
         return std::ptr::null_mut();
     }
 
-    let config = crate::BlincConfig::default();
-
-    let renderer_config = RendererConfig {
-        max_primitives: config.max_primitives,
-        max_glass_primitives: config.max_glass_primitives,
-        max_glyphs: config.max_glyphs,
-        sample_count: 1,
-        texture_format: None,
-        unified_text_rendering: true,
+    let options = if options.is_null() {
+        BlincGpuOptions::default()
+    } else {
+        unsafe { *options }
     };
+    let renderer_config = gpu_renderer_config(&options);
 
     // Create wgpu instance with Metal backend
     let instance = wgpu::Instance::new(wgpu::InstanceDescriptor {
@@ -1160,15 +2232,8 @@ pub extern "C" fn blinc_init_gpu(
         ..Default::default()
     });
 
-    // Create surface from CAMetalLayer
-    // CoreAnimationLayer takes a raw *mut c_void pointer
-    let surface_target = wgpu::SurfaceTargetUnsafe::CoreAnimationLayer(metal_layer);
-    let surface = match unsafe { instance.create_surface_unsafe(surface_target) } {
-        Ok(s) => s,
-        Err(e) => {
-            tracing::error!("blinc_init_gpu: failed to create surface: {}", e);
-            return std::ptr::null_mut();
-        }
+    let Some(surface) = create_metal_surface(&instance, metal_layer) else {
+        return std::ptr::null_mut();
     };
 
     // Create renderer
@@ -1186,58 +2251,100 @@ pub extern "C" fn blinc_init_gpu(
     let queue = renderer.queue_arc();
 
     let mut text_ctx = TextRenderingContext::new(device.clone(), queue.clone());
+    load_system_fonts(&mut text_ctx);
+
+    // Create RenderContext with text rendering support
+    let config = crate::BlincConfig::default();
+    let render_context =
+        crate::context::RenderContext::new(renderer, text_ctx, device, queue, config.sample_count);
+    let mut app = BlincApp::from_context(render_context, config);
+    app.set_partial_redraw(options.partial_redraw);
+
+    finish_gpu_init(ctx, app, surface, width, height)
+}
+
+/// Renderer configuration for the given init options
+fn gpu_renderer_config(options: &BlincGpuOptions) -> blinc_gpu::RendererConfig {
+    let pipeline_cache_dir = if options.pipeline_cache_dir.is_null() {
+        None
+    } else {
+        match unsafe { std::ffi::CStr::from_ptr(options.pipeline_cache_dir) }.to_str() {
+            Ok(dir) => Some(std::path::PathBuf::from(dir)),
+            Err(_) => {
+                tracing::warn!("blinc_init_gpu: pipeline cache dir is not UTF-8, ignoring");
+                None
+            }
+        }
+    };
+
+    let config = crate::BlincConfig::default();
+
+    blinc_gpu::RendererConfig {
+        max_primitives: config.max_primitives,
+        max_glass_primitives: config.max_glass_primitives,
+        max_glyphs: config.max_glyphs,
+        sample_count: 1,
+        texture_format: None,
+        unified_text_rendering: true,
+        pipeline_cache_dir,
+        background_pipeline_compilation: options.background_pipeline_compilation,
+        blur_mode: if options.performance_blur {
+            blinc_gpu::BlurMode::Performance
+        } else {
+            blinc_gpu::BlurMode::Quality
+        },
+    }
+}
+
+/// Create a surface presenting to a CAMetalLayer
+fn create_metal_surface(
+    instance: &wgpu::Instance,
+    metal_layer: *mut std::ffi::c_void,
+) -> Option<wgpu::Surface<'static>> {
+    // CoreAnimationLayer takes a raw *mut c_void pointer
+    let surface_target = wgpu::SurfaceTargetUnsafe::CoreAnimationLayer(metal_layer);
+    match unsafe { instance.create_surface_unsafe(surface_target) } {
+        Ok(s) => Some(s),
+        Err(e) => {
+            tracing::error!("blinc_init_gpu: failed to create surface: {}", e);
+            None
+        }
+    }
+}
 
-    // Load iOS system fonts into the registry
-    // Note: The FontRegistry already tries to load from KNOWN_FONT_PATHS,
-    // but we also load from system_font_paths() to ensure fonts are available.
+/// Register the iOS system fonts and resolve the default UI face
+fn load_system_fonts(text_ctx: &mut blinc_gpu::TextRenderingContext) {
+    // Register iOS system fonts by path. Only the table directory is parsed
+    // here; files are memory-mapped when a face is first used, and paths the
+    // FontRegistry already registered from KNOWN_FONT_PATHS are skipped.
     let mut fonts_loaded = 0;
     for font_path in IOSApp::system_font_paths() {
         let path = std::path::Path::new(font_path);
-        tracing::debug!("Checking font path: {}", font_path);
         if path.exists() {
-            match std::fs::read(path) {
-                Ok(data) => {
-                    tracing::info!("Loading font from: {} ({} bytes)", font_path, data.len());
-                    // Use load_font_data_to_registry to add to the font registry
-                    // (not load_font_data which only sets the default font)
-                    let loaded = text_ctx.load_font_data_to_registry(data);
-                    if loaded > 0 {
-                        tracing::info!("Successfully loaded {} faces from: {}", loaded, font_path);
-                        fonts_loaded += loaded;
-                    } else {
-                        tracing::warn!("No faces loaded from font {}", font_path);
-                    }
-                }
-                Err(e) => {
-                    tracing::warn!("Failed to read font file {}: {}", font_path, e);
-                }
-            }
+            fonts_loaded += text_ctx.load_font_file_to_registry(path);
         } else {
             tracing::debug!("Font path does not exist: {}", font_path);
         }
     }
-    tracing::info!("Loaded {} font faces total", fonts_loaded);
-
-    // Preload common fonts with iOS family names
-    // Note: iOS uses ".SF UI" family names (with leading dot for system fonts)
-    text_ctx.preload_fonts(&[
-        ".SF UI",         // iOS system font
-        ".SF UI Text",    // iOS system font (text)
-        ".SF UI Display", // iOS system font (display)
-        "Helvetica",      // Helvetica
-        "Helvetica Neue", // Helvetica Neue
-        "Avenir",         // Avenir
-        "Avenir Next",    // Avenir Next
-        "Menlo",          // Monospace
-        "Courier New",    // Courier
-    ]);
+    tracing::info!("Registered {} font faces", fonts_loaded);
+
+    // Only the default UI face is resolved up front; named families are
+    // looked up on first use instead of preloading every SF/Helvetica variant
     text_ctx.preload_generic_styles(blinc_gpu::GenericFont::SansSerif, &[400, 700], false);
-    tracing::info!("Font preloading complete, {} fonts loaded", fonts_loaded);
+}
 
-    // Create RenderContext with text rendering support
-    let render_context =
-        crate::context::RenderContext::new(renderer, text_ctx, device, queue, config.sample_count);
-    let app = BlincApp::from_context(render_context, config);
+/// Configure the surface for the app's format and wrap everything up
+fn finish_gpu_init(
+    ctx: *mut IOSRenderContext,
+    mut app: BlincApp,
+    surface: wgpu::Surface<'static>,
+    width: u32,
+    height: u32,
+) -> *mut IOSGpuRenderer {
+    // Decoder threads have no current queue; finished decodes must reach
+    // this context's queue, whose waker resumes a paused display link
+    let update_queue = unsafe { (*ctx).update_queue.clone() };
+    app.context().set_update_queue(update_queue);
 
     // Configure surface with the format the renderer selected
     let format = app.texture_format();
@@ -1252,6 +2359,8 @@ pub extern "C" fn blinc_init_gpu(
         desired_maximum_frame_latency: 2,
     };
     surface.configure(app.device(), &surface_config);
+    let base_blur_mode = app.blur_mode();
+    let text_ctx = app.text_context().clone();
 
     tracing::info!(
         "blinc_init_gpu: GPU initialized ({}x{}, format: {:?})",
@@ -1261,34 +2370,186 @@ pub extern "C" fn blinc_init_gpu(
     );
 
     Box::into_raw(Box::new(IOSGpuRenderer {
-        app,
-        surface,
-        surface_config,
+        state: Arc::new(Mutex::new(IOSGpuState {
+            app,
+            surface,
+            surface_config,
+            last_acquire: Duration::ZERO,
+            missed_damage: Damage::None,
+        })),
+        surface_size: (width, height),
         render_ctx: ctx,
+        render_thread: None,
+        scroll_list: None,
+        quality_tier: QualityTier::Full,
+        base_blur_mode,
+        text_ctx,
     }))
 }
 
-/// Resize the GPU surface (C FFI for Swift)
+/// GPU device shared by several render contexts (C FFI for Swift)
 ///
-/// Call this when the Metal layer's drawable size changes.
+/// Holds the Metal device, the compiled pipelines, the glyph atlas and the
+/// image and SVG caches. Renderers created from it with
+/// `blinc_init_gpu_shared` (e.g. one per window or embedded view) reuse all
+/// of these instead of each initializing their own.
+pub struct BlincGpuDevice {
+    device: blinc_gpu::GpuDevice,
+    resources: crate::context::SharedRenderResources,
+    renderer_config: blinc_gpu::RendererConfig,
+    partial_redraw: bool,
+}
+
+/// Create a GPU device to share between render contexts (C FFI for Swift)
+///
+/// System fonts are registered once here rather than per renderer.
+///
+/// # Arguments
+/// * `options` - Init options applied to every renderer created from the
+///   device, or null for defaults
+///
+/// # Returns
+/// Pointer to the device, or null on failure
 ///
 /// # Safety
-/// `gpu` must be a valid pointer returned by `blinc_init_gpu`.
+/// * `options` must be null or point to a valid `BlincGpuOptions` whose
+///   `pipeline_cache_dir` is null or a null-terminated string
+/// * The returned pointer must be freed with `blinc_destroy_gpu_device`
 #[no_mangle]
-pub extern "C" fn blinc_gpu_resize(gpu: *mut IOSGpuRenderer, width: u32, height: u32) {
-    if gpu.is_null() {
-        return;
+pub extern "C" fn blinc_create_gpu_device(options: *const BlincGpuOptions) -> *mut BlincGpuDevice {
+    use blinc_gpu::{GpuDevice, TextRenderingContext};
+
+    let options = if options.is_null() {
+        BlincGpuOptions::default()
+    } else {
+        unsafe { *options }
+    };
+    let renderer_config = gpu_renderer_config(&options);
+
+    let instance = wgpu::Instance::new(wgpu::InstanceDescriptor {
+        backends: wgpu::Backends::METAL,
+        ..Default::default()
+    });
+    let device =
+        match pollster::block_on(GpuDevice::with_instance(instance, None, &renderer_config)) {
+            Ok(d) => d,
+            Err(e) => {
+                tracing::error!("blinc_create_gpu_device: failed to create device: {}", e);
+                return std::ptr::null_mut();
+            }
+        };
+
+    let mut text_ctx = TextRenderingContext::new(device.device_arc(), device.queue_arc());
+    load_system_fonts(&mut text_ctx);
+
+    Box::into_raw(Box::new(BlincGpuDevice {
+        device,
+        resources: crate::context::SharedRenderResources::new(text_ctx),
+        renderer_config,
+        partial_redraw: options.partial_redraw,
+    }))
+}
+
+/// Initialize a GPU renderer on a shared device (C FFI for Swift)
+///
+/// Like `blinc_init_gpu_with_options`, but the renderer draws with `device`
+/// and shares its pipelines, glyph atlas and image caches with every other
+/// renderer created from it.
+///
+/// # Arguments
+/// * `ctx` - Render context pointer from `blinc_create_context`
+/// * `device` - Device from `blinc_create_gpu_device`
+/// * `metal_layer` - Pointer to CAMetalLayer (from UIView.layer)
+/// * `width` - Drawable width in pixels
+/// * `height` - Drawable height in pixels
+///
+/// # Returns
+/// Pointer to GPU renderer, or null on failure
+///
+/// # Safety
+/// * `ctx` must be a valid pointer returned by `blinc_create_context`
+/// * `device` must be a valid pointer returned by `blinc_create_gpu_device`
+/// * `metal_layer` must be a valid pointer to a CAMetalLayer
+#[no_mangle]
+pub extern "C" fn blinc_init_gpu_shared(
+    ctx: *mut IOSRenderContext,
+    device: *mut BlincGpuDevice,
+    metal_layer: *mut std::ffi::c_void,
+    width: u32,
+    height: u32,
+) -> *mut IOSGpuRenderer {
+    if ctx.is_null() || device.is_null() || metal_layer.is_null() {
+        tracing::error!("blinc_init_gpu_shared: null context, device or metal_layer");
+        return std::ptr::null_mut();
+    }
+    let shared = unsafe { &*device };
+
+    let Some(surface) = create_metal_surface(shared.device.instance(), metal_layer) else {
+        return std::ptr::null_mut();
+    };
+
+    let renderer = match blinc_gpu::GpuRenderer::with_device(
+        &shared.device,
+        Some(&surface),
+        shared.renderer_config.clone(),
+    ) {
+        Ok(r) => r,
+        Err(e) => {
+            tracing::error!("blinc_init_gpu_shared: failed to create renderer: {}", e);
+            return std::ptr::null_mut();
+        }
+    };
+
+    let config = crate::BlincConfig::default();
+    let render_context = crate::context::RenderContext::with_shared(
+        renderer,
+        &shared.resources,
+        shared.device.device_arc(),
+        shared.device.queue_arc(),
+        config.sample_count,
+    );
+    let mut app = BlincApp::from_context(render_context, config);
+    app.set_partial_redraw(shared.partial_redraw);
+
+    finish_gpu_init(ctx, app, surface, width, height)
+}
+
+/// Release a shared GPU device (C FFI for Swift)
+///
+/// Renderers created from the device keep it alive until they are
+/// destroyed with `blinc_destroy_gpu`.
+///
+/// # Safety
+/// `device` must be a valid pointer returned by `blinc_create_gpu_device`.
+#[no_mangle]
+pub extern "C" fn blinc_destroy_gpu_device(device: *mut BlincGpuDevice) {
+    if !device.is_null() {
+        unsafe {
+            drop(Box::from_raw(device));
+        }
+    }
+}
+
+/// Resize the GPU surface (C FFI for Swift)
+///
+/// Call this when the Metal layer's drawable size changes.
+///
+/// # Safety
+/// `gpu` must be a valid pointer returned by `blinc_init_gpu`.
+#[no_mangle]
+pub extern "C" fn blinc_gpu_resize(gpu: *mut IOSGpuRenderer, width: u32, height: u32) {
+    if gpu.is_null() {
+        return;
     }
 
     unsafe {
         let gpu = &mut *gpu;
-        if width > 0
-            && height > 0
-            && (gpu.surface_config.width != width || gpu.surface_config.height != height)
-        {
-            gpu.surface_config.width = width;
-            gpu.surface_config.height = height;
-            gpu.surface.configure(gpu.app.device(), &gpu.surface_config);
+        if width > 0 && height > 0 && gpu.surface_size != (width, height) {
+            let mut state = gpu.state.lock().unwrap();
+            state.surface_config.width = width;
+            state.surface_config.height = height;
+            state.configure();
+            gpu.surface_size = (width, height);
             tracing::debug!("blinc_gpu_resize: {}x{}", width, height);
         }
     }
@@ -1317,55 +2578,540 @@ pub extern "C" fn blinc_render_frame(gpu: *mut IOSGpuRenderer) -> bool {
             Some(c) => c,
             None => return false,
         };
+        gpu.render(ctx)
+    }
+}
 
-        // Get surface texture
-        let surface_texture = match gpu.surface.get_current_texture() {
-            Ok(st) => st,
-            Err(wgpu::SurfaceError::Lost | wgpu::SurfaceError::Outdated) => {
-                // Reconfigure surface and try again
-                gpu.surface.configure(gpu.app.device(), &gpu.surface_config);
-                match gpu.surface.get_current_texture() {
-                    Ok(st) => st,
-                    Err(e) => {
-                        tracing::error!("blinc_render_frame: surface error: {:?}", e);
-                        return false;
-                    }
-                }
+/// Result of a combined frame (`blinc_frame`)
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default)]
+pub struct BlincFrameResult {
+    /// A frame was encoded and presented
+    pub rendered: bool,
+    /// The UI builder ran (full rebuild)
+    pub rebuilt: bool,
+    /// Animations or scroll physics are still running after this frame's tick
+    pub animations_active: bool,
+    /// Another frame is needed; when false the display link can be paused
+    /// until input, a size change or `blinc_mark_dirty`
+    pub needs_another_frame: bool,
+}
+
+/// Longest presentation lead accepted from a display link (seconds)
+///
+/// Guards against garbage timestamps; a real display link is at most a
+/// couple of refresh intervals ahead.
+const MAX_PRESENTATION_LEAD: f64 = 0.25;
+
+/// How far ahead of now a display link frame will be presented
+///
+/// Only the difference between the two timestamps is used, so any monotonic
+/// clock works (`CADisplayLink.timestamp`/`targetTimestamp` use CACurrentMediaTime).
+fn presentation_lead(timestamp: f64, target_timestamp: f64) -> Duration {
+    let lead = target_timestamp - timestamp;
+    if lead.is_finite() && lead > 0.0 {
+        Duration::from_secs_f64(lead.min(MAX_PRESENTATION_LEAD))
+    } else {
+        Duration::ZERO
+    }
+}
+
+/// Run a complete frame in one call (C FFI for Swift)
+///
+/// Replaces the `blinc_needs_render`, `blinc_tick_animations`,
+/// `blinc_build_frame`, `blinc_render_frame`, `blinc_clear_dirty` sequence:
+///
+/// 1. Returns early (renders nothing) if there is no pending work, or if
+///    drawing now would exceed the frame rate cap of the device's power
+///    state (see `blinc_set_power_state`)
+/// 2. Ticks scroll physics and animations exactly once, at `target_timestamp`
+/// 3. Applies incremental updates, or runs the UI builder if dirty
+/// 4. Encodes and presents the frame
+///
+/// Pass `CADisplayLink.timestamp` and `CADisplayLink.targetTimestamp`; animations
+/// are advanced to the time the frame will actually be shown, so motion stays
+/// smooth on variable refresh rate displays. When `needs_another_frame` is false
+/// the display link can be paused until the next input event.
+///
+/// # Arguments
+/// * `ctx` - Render context pointer from `blinc_create_context`
+/// * `gpu` - GPU renderer pointer from `blinc_init_gpu`
+/// * `timestamp` - Time of the current display link callback (seconds)
+/// * `target_timestamp` - Time the frame will be presented (seconds, same clock)
+/// * `out` - Receives the frame result (can be null)
+///
+/// # Safety
+/// * `ctx` must be a valid pointer returned by `blinc_create_context`
+/// * `gpu` must be a valid pointer returned by `blinc_init_gpu` for `ctx`
+/// * `out` must be null or point to a writable `BlincFrameResult`
+/// * Must be called on the main thread
+#[no_mangle]
+pub extern "C" fn blinc_frame(
+    ctx: *mut IOSRenderContext,
+    gpu: *mut IOSGpuRenderer,
+    timestamp: f64,
+    target_timestamp: f64,
+    out: *mut BlincFrameResult,
+) {
+    let mut result = BlincFrameResult::default();
+
+    if !ctx.is_null() && !gpu.is_null() {
+        unsafe {
+            let ctx = &mut *ctx;
+            let gpu = &mut *gpu;
+
+            #[cfg(feature = "replay-profile")]
+            let replay_frames_before = ctx.frame_stats.frame_index;
+            #[cfg(feature = "replay-profile")]
+            let replaying = ctx.begin_replay_frame();
+
+            // A hot or power-saving device draws at a capped rate even if the
+            // display link fires faster; skipped frames keep their work pending
+            let paced_out = ctx
+                .last_frame_target
+                .is_some_and(|last| !ctx.pacing.is_frame_due(target_timestamp - last));
+
+            if !paced_out && ctx.has_pending_work(true) {
+                ctx.last_frame_target = Some(target_timestamp);
+                let lead = presentation_lead(timestamp, target_timestamp);
+                let rebuilds_before = ctx.rebuild_count;
+
+                // Scroll physics first so ScrollRef state is current during rebuilds
+                let scroll_time = blinc_layout::prelude::elapsed_ms() + lead.as_millis() as u64;
+                ctx.scroll_animating = ctx.tick_scroll_at(scroll_time);
+
+                let animations_active = ctx.build_frame(Instant::now() + lead);
+
+                result.rebuilt = ctx.rebuild_count != rebuilds_before;
+                result.animations_active = animations_active || ctx.scroll_animating;
+                result.rendered = gpu.render(ctx);
             }
-            Err(e) => {
-                tracing::error!("blinc_render_frame: surface error: {:?}", e);
-                return false;
+
+            result.needs_another_frame = result.animations_active || ctx.has_pending_work(false);
+
+            #[cfg(feature = "replay-profile")]
+            if replaying {
+                ctx.finish_replay_frame(replay_frames_before);
+                // Keep the display link running until the recording is exhausted
+                result.needs_another_frame = true;
             }
-        };
+        }
+    }
 
-        // Get render tree
-        let tree = match ctx.render_tree.as_ref() {
-            Some(t) => t,
-            None => {
-                surface_texture.present();
-                return true; // No tree yet, just present empty frame
+    if !out.is_null() {
+        unsafe {
+            *out = result;
+        }
+    }
+}
+
+/// Register a function called when the context wants a frame (C FFI for Swift)
+///
+/// Invoked whenever the wake proxy is signalled: when an animation starts,
+/// an update is queued for this context (from any thread), an image decode
+/// or async native call (`blinc_native_complete`) finishes, or
+/// `blinc_mark_dirty` is called. Use it to resume a
+/// display link paused after `needs_another_frame` came back false. It may
+/// run on any thread, so it should only dispatch to the main queue. Pass a
+/// null callback to remove it.
+///
+/// # Safety
+/// * `ctx` must be a valid pointer returned by `blinc_create_context`
+/// * `callback` must be safe to call from any thread with `user_data` until
+///   it is replaced, removed or the context is destroyed
+#[no_mangle]
+pub extern "C" fn blinc_set_wake_callback(
+    ctx: *mut IOSRenderContext,
+    callback: Option<extern "C" fn(*mut std::ffi::c_void)>,
+    user_data: *mut std::ffi::c_void,
+) {
+    if ctx.is_null() {
+        return;
+    }
+    let ctx = unsafe { &mut *ctx };
+    match callback {
+        Some(callback) => {
+            // Raw pointers aren't Send; the caller vouches for thread safety
+            let user_data = user_data as usize;
+            ctx.wake_proxy
+                .set_handler(move || callback(user_data as *mut std::ffi::c_void));
+        }
+        None => ctx.wake_proxy.clear_handler(),
+    }
+}
+
+/// Get timing and counters for the last rendered frame (C FFI for Swift)
+///
+/// # Returns
+/// false if no frame has been rendered yet (`out` is left untouched)
+///
+/// # Safety
+/// * `ctx` must be a valid pointer returned by `blinc_create_context`
+/// * `out` must point to a writable `BlincFrameStats`
+#[no_mangle]
+pub extern "C" fn blinc_get_frame_stats(
+    ctx: *mut IOSRenderContext,
+    out: *mut BlincFrameStats,
+) -> bool {
+    if ctx.is_null() || out.is_null() {
+        return false;
+    }
+
+    unsafe {
+        match (*ctx).frame_stats_history.back() {
+            Some(stats) => {
+                *out = *stats;
+                true
             }
+            None => false,
+        }
+    }
+}
+
+/// Copy the stats of recent frames, oldest first (C FFI for Swift)
+///
+/// Up to the last 120 frames are kept.
+///
+/// # Arguments
+/// * `ctx` - Render context pointer from `blinc_create_context`
+/// * `out` - Array receiving the stats
+/// * `capacity` - Number of elements `out` can hold
+///
+/// # Returns
+/// Number of frames written
+///
+/// # Safety
+/// * `ctx` must be a valid pointer returned by `blinc_create_context`
+/// * `out` must point to at least `capacity` writable `BlincFrameStats`
+#[no_mangle]
+pub extern "C" fn blinc_get_frame_stats_history(
+    ctx: *mut IOSRenderContext,
+    out: *mut BlincFrameStats,
+    capacity: u32,
+) -> u32 {
+    if ctx.is_null() || out.is_null() {
+        return 0;
+    }
+
+    unsafe {
+        let history = &(*ctx).frame_stats_history;
+        let count = history.len().min(capacity as usize);
+        let skip = history.len() - count;
+        for (i, stats) in history.iter().skip(skip).enumerate() {
+            *out.add(i) = *stats;
+        }
+        count as u32
+    }
+}
+
+/// `blinc_set_power_state` level for `ProcessInfo.ThermalState.nominal`
+pub const BLINC_THERMAL_NOMINAL: u32 = 0;
+/// `blinc_set_power_state` level for `ProcessInfo.ThermalState.fair`
+pub const BLINC_THERMAL_FAIR: u32 = 1;
+/// `blinc_set_power_state` level for `ProcessInfo.ThermalState.serious`
+pub const BLINC_THERMAL_SERIOUS: u32 = 2;
+/// `blinc_set_power_state` level for `ProcessInfo.ThermalState.critical`
+pub const BLINC_THERMAL_CRITICAL: u32 = 3;
+
+/// `BlincFrameStats::quality_tier`: configured MSAA and blur quality
+pub const BLINC_QUALITY_FULL: u32 = QualityTier::Full as u32;
+/// `BlincFrameStats::quality_tier`: at most 2x MSAA, pyramid blurs, 60fps cap
+pub const BLINC_QUALITY_REDUCED: u32 = QualityTier::Reduced as u32;
+/// `BlincFrameStats::quality_tier`: no MSAA, pyramid blurs, 30fps cap
+pub const BLINC_QUALITY_MINIMAL: u32 = QualityTier::Minimal as u32;
+
+/// A frame rate range in frames per second (C FFI for Swift)
+///
+/// Same fields as `CAFrameRateRange`.
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default)]
+pub struct BlincFrameRateRange {
+    pub minimum: f32,
+    pub maximum: f32,
+    pub preferred: f32,
+}
+
+/// Set the frame rate range the app wants (C FFI for Swift)
+///
+/// Pass the range given to `CADisplayLink.preferredFrameRateRange`. It
+/// applies while the device is cool; `blinc_set_power_state` caps it.
+/// Animations are ticked at the preferred rate.
+///
+/// # Arguments
+/// * `ctx` - Render context pointer from `blinc_create_context`
+/// * `min` - Lowest acceptable rate (0 for none)
+/// * `max` - Highest rate (0 for the default 120fps)
+/// * `preferred` - Rate to aim for (0 for `max`)
+///
+/// # Safety
+/// `ctx` must be a valid pointer returned by `blinc_create_context`.
+#[no_mangle]
+pub extern "C" fn blinc_set_frame_rate_range(
+    ctx: *mut IOSRenderContext,
+    min: f32,
+    max: f32,
+    preferred: f32,
+) {
+    if ctx.is_null() {
+        return;
+    }
+
+    unsafe {
+        (*ctx).set_frame_rate_range(FrameRateRange::new(min, max, preferred));
+    }
+}
+
+/// Report the device's thermal state and Low Power Mode (C FFI for Swift)
+///
+/// Call at startup and from `ProcessInfo.thermalStateDidChangeNotification`
+/// and `NSProcessInfoPowerStateDidChange`. Serious thermal state or Low Power
+/// Mode drop to `BLINC_QUALITY_REDUCED` (at most 2x MSAA, pyramid blurs and
+/// glass, 60fps); critical thermal state drops to `BLINC_QUALITY_MINIMAL`
+/// (no MSAA, 30fps). `blinc_frame` skips display link callbacks above the
+/// cap; apply `blinc_get_frame_rate_range` to the display link so they
+/// aren't delivered in the first place.
+///
+/// # Arguments
+/// * `ctx` - Render context pointer from `blinc_create_context`
+/// * `thermal_level` - `ProcessInfo.thermalState.rawValue` (`BLINC_THERMAL_*`)
+/// * `low_power` - `ProcessInfo.isLowPowerModeEnabled`
+///
+/// # Returns
+/// true if the quality tier changed
+///
+/// # Safety
+/// `ctx` must be a valid pointer returned by `blinc_create_context`.
+#[no_mangle]
+pub extern "C" fn blinc_set_power_state(
+    ctx: *mut IOSRenderContext,
+    thermal_level: u32,
+    low_power: bool,
+) -> bool {
+    if ctx.is_null() {
+        return false;
+    }
+
+    unsafe { (*ctx).set_power_state(ThermalState::from_level(thermal_level), low_power) }
+}
+
+/// Get the frame rate range to run the display link at (C FFI for Swift)
+///
+/// The range from `blinc_set_frame_rate_range`, capped for the power state
+/// last reported with `blinc_set_power_state`.
+///
+/// # Returns
+/// false if `ctx` or `out` is null
+///
+/// # Safety
+/// * `ctx` must be a valid pointer returned by `blinc_create_context`
+/// * `out` must point to a writable `BlincFrameRateRange`
+#[no_mangle]
+pub extern "C" fn blinc_get_frame_rate_range(
+    ctx: *mut IOSRenderContext,
+    out: *mut BlincFrameRateRange,
+) -> bool {
+    if ctx.is_null() || out.is_null() {
+        return false;
+    }
+
+    unsafe {
+        let range = (*ctx).frame_rate_range();
+        *out = BlincFrameRateRange {
+            minimum: range.min,
+            maximum: range.max,
+            preferred: range.preferred,
         };
+    }
+    true
+}
 
-        // Render
-        let view = surface_texture
-            .texture
-            .create_view(&wgpu::TextureViewDescriptor::default());
+/// Start replaying a recording for profiling (C FFI for Swift)
+///
+/// The recording (JSON from `SharedRecordingSession::export`) is played back
+/// through `blinc_frame`: each frame's recorded pointer input is injected as
+/// touches and the frame's stats are attributed to it. Keyboard input and
+/// window resizes are not replayed. The display link paces the replay, so
+/// each frame advances `speed` × 16.67ms of the recording.
+///
+/// # Arguments
+/// * `ctx` - Render context pointer from `blinc_create_context`
+/// * `recording_json` - Recording as a null-terminated JSON string
+/// * `speed` - Recording time covered per frame, relative to 60fps (1.0 = real time)
+///
+/// # Returns
+/// false if the recording could not be parsed
+///
+/// # Safety
+/// * `ctx` must be a valid pointer returned by `blinc_create_context`
+/// * `recording_json` must be a valid null-terminated C string
+#[cfg(feature = "replay-profile")]
+#[no_mangle]
+pub extern "C" fn blinc_replay_profile_start(
+    ctx: *mut IOSRenderContext,
+    recording_json: *const std::ffi::c_char,
+    speed: f64,
+) -> bool {
+    if ctx.is_null() || recording_json.is_null() {
+        return false;
+    }
 
-        if let Err(e) = gpu.app.render_tree_with_motion(
-            tree,
-            &ctx.render_state,
-            &view,
-            gpu.surface_config.width,
-            gpu.surface_config.height,
-        ) {
-            tracing::error!("blinc_render_frame: render error: {}", e);
-            surface_texture.present();
+    let json = match unsafe { std::ffi::CStr::from_ptr(recording_json) }.to_str() {
+        Ok(json) => json,
+        Err(_) => {
+            tracing::error!("blinc_replay_profile_start: invalid recording string");
+            return false;
+        }
+    };
+    let export = match crate::replay_profile::load_recording(json) {
+        Ok(export) => export,
+        Err(e) => {
+            tracing::error!("blinc_replay_profile_start: {}", e);
             return false;
         }
+    };
 
-        surface_texture.present();
-        true
+    let config = blinc_recorder::ProfileConfig::accelerated(speed);
+    unsafe {
+        let ctx = &mut *ctx;
+        ctx.replay = Some(blinc_recorder::ProfileReplay::new(export, config));
+        ctx.replay_touch_down = false;
+        ctx.wake_proxy.wake();
+    }
+    true
+}
+
+/// Check whether a profiling replay still has frames to play (C FFI for Swift)
+///
+/// # Safety
+/// * `ctx` must be a valid pointer returned by `blinc_create_context`
+#[cfg(feature = "replay-profile")]
+#[no_mangle]
+pub extern "C" fn blinc_replay_profile_active(ctx: *mut IOSRenderContext) -> bool {
+    if ctx.is_null() {
+        return false;
+    }
+    unsafe {
+        (*ctx)
+            .replay
+            .as_ref()
+            .map_or(false, |replay| !replay.is_finished())
+    }
+}
+
+/// Stop the profiling replay and write its Chrome trace (C FFI for Swift)
+///
+/// The trace can be opened in Perfetto or `chrome://tracing`. Frames over
+/// the 16.67ms budget are marked as jank.
+///
+/// # Arguments
+/// * `ctx` - Render context pointer from `blinc_create_context`
+/// * `trace_path` - Where to write the trace JSON (null-terminated C string)
+///
+/// # Returns
+/// Number of janky frames, or -1 if no replay was running or the trace
+/// could not be written
+///
+/// # Safety
+/// * `ctx` must be a valid pointer returned by `blinc_create_context`
+/// * `trace_path` must be a valid null-terminated C string
+#[cfg(feature = "replay-profile")]
+#[no_mangle]
+pub extern "C" fn blinc_replay_profile_finish(
+    ctx: *mut IOSRenderContext,
+    trace_path: *const std::ffi::c_char,
+) -> i32 {
+    if ctx.is_null() || trace_path.is_null() {
+        return -1;
+    }
+
+    let Some(replay) = (unsafe { (*ctx).replay.take() }) else {
+        return -1;
+    };
+    let trace = replay.into_trace();
+    let path = match unsafe { std::ffi::CStr::from_ptr(trace_path) }.to_str() {
+        Ok(path) => path,
+        Err(_) => {
+            tracing::error!("blinc_replay_profile_finish: invalid path string");
+            return -1;
+        }
+    };
+    if let Err(e) = std::fs::write(path, trace.to_chrome_trace()) {
+        tracing::error!("blinc_replay_profile_finish: writing {}: {}", path, e);
+        return -1;
+    }
+    trace.jank_frames().count() as i32
+}
+
+/// A damaged region of the drawable, in pixels (C FFI for Swift)
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default)]
+pub struct BlincDamageRect {
+    pub x: f32,
+    pub y: f32,
+    pub width: f32,
+    pub height: f32,
+}
+
+/// Get the regions repainted by the last rendered frame (C FFI for Swift)
+///
+/// A full repaint is reported as one rect covering the drawable; a frame that
+/// reused the previous contents reports none. With the render thread running
+/// this describes the latest frame the thread finished, and returns 0 while
+/// the thread is busy encoding.
+///
+/// # Arguments
+/// * `gpu` - GPU renderer pointer from `blinc_init_gpu`
+/// * `out` - Array receiving the rects
+/// * `capacity` - Number of elements `out` can hold
+///
+/// # Returns
+/// Number of rects written
+///
+/// # Safety
+/// * `gpu` must be a valid pointer returned by `blinc_init_gpu`
+/// * `out` must point to at least `capacity` writable `BlincDamageRect`
+#[no_mangle]
+pub extern "C" fn blinc_get_damage_rects(
+    gpu: *mut IOSGpuRenderer,
+    out: *mut BlincDamageRect,
+    capacity: u32,
+) -> u32 {
+    if gpu.is_null() || out.is_null() {
+        return 0;
+    }
+
+    unsafe {
+        let gpu = &*gpu;
+        let state = if gpu.render_thread.is_some() {
+            match gpu.state.try_lock() {
+                Ok(state) => state,
+                Err(_) => return 0,
+            }
+        } else {
+            match gpu.state.lock() {
+                Ok(state) => state,
+                Err(_) => return 0,
+            }
+        };
+
+        let (width, height) = (state.surface_config.width, state.surface_config.height);
+        let full = [blinc_core::Rect::new(0.0, 0.0, width as f32, height as f32)];
+        let damage = state.app.last_damage();
+        let rects = match damage {
+            Damage::Full => &full[..],
+            _ => damage.rects(),
+        };
+
+        let count = rects.len().min(capacity as usize);
+        for (i, rect) in rects.iter().take(count).enumerate() {
+            *out.add(i) = BlincDamageRect {
+                x: rect.x(),
+                y: rect.y(),
+                width: rect.width(),
+                height: rect.height(),
+            };
+        }
+        count as u32
     }
 }
 
@@ -1383,6 +3129,189 @@ pub extern "C" fn blinc_destroy_gpu(gpu: *mut IOSGpuRenderer) {
     }
 }
 
+/// Move frame encoding and presentation to a Blinc-owned thread (C FFI for Swift)
+///
+/// After this call, `blinc_frame`/`blinc_render_frame` only record an
+/// immutable display list on the main thread and hand it to the render
+/// thread, which encodes it, acquires the drawable and presents. The main
+/// thread no longer blocks on `nextDrawable`; the render thread runs at most
+/// one frame behind and drops stale frames rather than queueing them.
+///
+/// # Returns
+/// true if the render thread is running
+///
+/// # Safety
+/// * `gpu` must be a valid pointer returned by `blinc_init_gpu`
+/// * Must be called on the main thread
+#[no_mangle]
+pub extern "C" fn blinc_start_render_thread(gpu: *mut IOSGpuRenderer) -> bool {
+    if gpu.is_null() {
+        return false;
+    }
+
+    unsafe {
+        let gpu = &mut *gpu;
+        if gpu.render_thread.is_some() {
+            return true;
+        }
+
+        match IOSRenderThread::spawn(Arc::clone(&gpu.state)) {
+            Ok(thread) => {
+                gpu.render_thread = Some(thread);
+                tracing::info!("blinc_start_render_thread: render thread started");
+                true
+            }
+            Err(e) => {
+                tracing::error!("blinc_start_render_thread: failed to spawn thread: {}", e);
+                false
+            }
+        }
+    }
+}
+
+/// Stop the render thread and go back to rendering on the main thread (C FFI for Swift)
+///
+/// Blocks until the frame being encoded (if any) has been presented.
+///
+/// # Safety
+/// * `gpu` must be a valid pointer returned by `blinc_init_gpu`
+/// * Must be called on the main thread
+#[no_mangle]
+pub extern "C" fn blinc_stop_render_thread(gpu: *mut IOSGpuRenderer) {
+    if gpu.is_null() {
+        return;
+    }
+
+    unsafe {
+        // Dropping the handle stops and joins the thread
+        (*gpu).render_thread = None;
+    }
+}
+
+/// Set the number of drawables the Metal layer may have in flight (C FFI for Swift)
+///
+/// 2 gives the lowest latency; 3 gives the GPU more slack at the cost of one
+/// frame of latency. Values are clamped to that range.
+///
+/// # Safety
+/// `gpu` must be a valid pointer returned by `blinc_init_gpu`.
+#[no_mangle]
+pub extern "C" fn blinc_set_drawable_count(gpu: *mut IOSGpuRenderer, count: u32) {
+    if gpu.is_null() {
+        return;
+    }
+
+    unsafe {
+        let gpu = &mut *gpu;
+        // wgpu's Metal backend keeps frame latency + 1 drawables
+        let latency = count.saturating_sub(1).clamp(1, 2);
+        let mut state = gpu.state.lock().unwrap();
+        if state.surface_config.desired_maximum_frame_latency != latency {
+            state.surface_config.desired_maximum_frame_latency = latency;
+            state.configure();
+            tracing::debug!("blinc_set_drawable_count: {}", latency + 1);
+        }
+    }
+}
+
+/// `blinc_handle_memory_warning` level: drop pooled layer textures and image/SVG caches
+pub const BLINC_MEMORY_WARNING_MODERATE: u32 = 0;
+/// `blinc_handle_memory_warning` level: also shrink glyph atlases and release render targets
+pub const BLINC_MEMORY_WARNING_CRITICAL: u32 = 1;
+
+/// Release cached GPU memory (C FFI for Swift)
+///
+/// Call from `didReceiveMemoryWarning` /
+/// `UIApplication.didReceiveMemoryWarningNotification`. Released caches are
+/// rebuilt lazily, so the next frames may be slower.
+///
+/// # Arguments
+/// * `gpu` - GPU renderer pointer from `blinc_init_gpu`
+/// * `level` - `BLINC_MEMORY_WARNING_MODERATE` (0) or `BLINC_MEMORY_WARNING_CRITICAL` (1)
+///
+/// # Safety
+/// `gpu` must be a valid pointer returned by `blinc_init_gpu`.
+#[no_mangle]
+pub extern "C" fn blinc_handle_memory_warning(gpu: *mut IOSGpuRenderer, level: u32) {
+    if gpu.is_null() {
+        return;
+    }
+
+    let level = if level >= BLINC_MEMORY_WARNING_CRITICAL {
+        crate::context::MemoryPressure::Critical
+    } else {
+        crate::context::MemoryPressure::Moderate
+    };
+
+    unsafe {
+        let mut state = (*gpu).state.lock().unwrap();
+        let before = state.app.memory_usage().total_bytes();
+        state.app.trim_memory(level);
+        let after = state.app.memory_usage().total_bytes();
+        tracing::info!(
+            "blinc_handle_memory_warning: {:?}, {} KB -> {} KB",
+            level,
+            before / 1024,
+            after / 1024
+        );
+    }
+}
+
+/// Estimated bytes held by each renderer cache (C FFI for Swift)
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default)]
+pub struct BlincMemoryStats {
+    /// Unused textures pooled by the layer texture cache
+    pub layer_pool_bytes: u64,
+    /// Textures held for named layers
+    pub layer_named_bytes: u64,
+    /// Decoded images
+    pub image_cache_bytes: u64,
+    /// Rasterized SVG textures
+    pub svg_cache_bytes: u64,
+    /// Grayscale glyph atlas (CPU and GPU copies)
+    pub glyph_atlas_bytes: u64,
+    /// Color (emoji) glyph atlas (CPU and GPU copies)
+    pub color_glyph_atlas_bytes: u64,
+    /// MSAA and glass backdrop render targets
+    pub render_target_bytes: u64,
+    /// Sum of the above
+    pub total_bytes: u64,
+}
+
+/// Get the renderer's estimated cache footprint (C FFI for Swift)
+///
+/// # Returns
+/// false if `gpu` or `out` is null
+///
+/// # Safety
+/// * `gpu` must be a valid pointer returned by `blinc_init_gpu`
+/// * `out` must point to a writable `BlincMemoryStats`
+#[no_mangle]
+pub extern "C" fn blinc_get_memory_usage(
+    gpu: *mut IOSGpuRenderer,
+    out: *mut BlincMemoryStats,
+) -> bool {
+    if gpu.is_null() || out.is_null() {
+        return false;
+    }
+
+    unsafe {
+        let usage = (*gpu).state.lock().unwrap().app.memory_usage();
+        *out = BlincMemoryStats {
+            layer_pool_bytes: usage.layer_pool_bytes,
+            layer_named_bytes: usage.layer_named_bytes,
+            image_cache_bytes: usage.image_cache_bytes,
+            svg_cache_bytes: usage.svg_cache_bytes,
+            glyph_atlas_bytes: usage.glyph_atlas_bytes,
+            color_glyph_atlas_bytes: usage.color_glyph_atlas_bytes,
+            render_target_bytes: usage.render_target_bytes,
+            total_bytes: usage.total_bytes(),
+        };
+    }
+    true
+}
+
 /// Load a bundled font from the app bundle (C FFI for Swift)
 ///
 /// Call this after `blinc_init_gpu` to load fonts from the app bundle.
@@ -1428,17 +3357,96 @@ pub extern "C" fn blinc_load_bundled_font(
             return 0;
         }
 
-        match std::fs::read(path) {
-            Ok(data) => {
-                tracing::info!("Read {} bytes from bundled font", data.len());
-                let loaded = gpu.app.load_font_data_to_registry(data);
-                tracing::info!("Loaded {} font faces from bundled font", loaded);
-                loaded as u32
-            }
-            Err(e) => {
-                tracing::error!("blinc_load_bundled_font: failed to read font: {}", e);
-                0
-            }
+        let loaded = gpu
+            .state
+            .lock()
+            .unwrap()
+            .app
+            .load_font_file_to_registry(path);
+        tracing::info!("Registered {} font faces from bundled font", loaded);
+        loaded as u32
+    }
+}
+
+/// Release callback for `blinc_load_font_from_memory`
+pub type BlincReleaseCallback = extern "C" fn(context: *mut std::ffi::c_void);
+
+/// Font bytes owned by the caller, released through its callback when dropped
+struct ForeignFontData {
+    data: *const u8,
+    len: usize,
+    release: Option<BlincReleaseCallback>,
+    context: *mut std::ffi::c_void,
+}
+
+// SAFETY: the caller guarantees the bytes are immutable and valid until the
+// release callback runs, and that the callback may be called from any thread.
+unsafe impl Send for ForeignFontData {}
+unsafe impl Sync for ForeignFontData {}
+
+impl AsRef<[u8]> for ForeignFontData {
+    fn as_ref(&self) -> &[u8] {
+        unsafe { std::slice::from_raw_parts(self.data, self.len) }
+    }
+}
+
+impl Drop for ForeignFontData {
+    fn drop(&mut self) {
+        if let Some(release) = self.release {
+            release(self.context);
         }
     }
 }
+
+/// Load a font from memory owned by the caller, without copying (C FFI for Swift)
+///
+/// Use this to hand over `NSData` that is already mapped
+/// (`Data(contentsOf:options: .alwaysMapped)`). Blinc keeps the pointer for
+/// as long as any face loaded from it is alive, then calls
+/// `release(context)` exactly once (also when no faces could be loaded).
+///
+/// # Arguments
+/// * `gpu` - GPU renderer pointer from `blinc_init_gpu`
+/// * `data` - Font file bytes (TTF/OTF/TTC)
+/// * `len` - Length of `data` in bytes
+/// * `release` - Called when Blinc no longer needs the bytes (can be null)
+/// * `context` - Passed to `release` (e.g. a retained `NSData`)
+///
+/// # Returns
+/// Number of font faces loaded (0 on failure)
+///
+/// # Safety
+/// * `gpu` must be a valid pointer returned by `blinc_init_gpu`
+/// * `data` must point to `len` bytes that stay valid and unchanged until
+///   `release` is called
+/// * `release` must be safe to call from any thread
+#[no_mangle]
+pub extern "C" fn blinc_load_font_from_memory(
+    gpu: *mut IOSGpuRenderer,
+    data: *const u8,
+    len: usize,
+    release: Option<BlincReleaseCallback>,
+    context: *mut std::ffi::c_void,
+) -> u32 {
+    let font_data = ForeignFontData {
+        data,
+        len,
+        release,
+        context,
+    };
+    if gpu.is_null() || data.is_null() || len == 0 {
+        // Dropping font_data hands the bytes straight back
+        return 0;
+    }
+
+    unsafe {
+        let loaded = (*gpu)
+            .state
+            .lock()
+            .unwrap()
+            .app
+            .load_shared_font_data_to_registry(Arc::new(font_data));
+        tracing::info!("Loaded {} font faces from memory ({} bytes)", loaded, len);
+        loaded as u32
+    }
+}
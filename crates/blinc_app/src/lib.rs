@@ -124,6 +124,7 @@ pub fn system_font_paths() -> &'static [&'static str] {
 mod app;
 mod context;
 mod error;
+mod pacing;
 mod text_measurer;
 
 // Windowed module is compiled for desktop (windowed feature), Android, iOS, Fuchsia, and HarmonyOS
@@ -150,17 +151,24 @@ pub mod fuchsia;
 #[cfg(all(feature = "fuchsia", target_os = "fuchsia"))]
 pub use fuchsia::FuchsiaApp;
 
+#[cfg(feature = "replay-profile")]
+pub mod replay_profile;
+
 #[cfg(test)]
 mod tests;
 
 pub use app::{BlincApp, BlincConfig};
-pub use context::{DebugMode, RenderContext};
+pub use context::{
+    DebugMode, DisplayList, MemoryPressure, MemoryUsage, RenderContext, RenderStats,
+    SharedRenderResources,
+};
 pub use error::{BlincError, Result};
+pub use pacing::{FramePacing, FrameRateRange, QualityTier, ThermalState};
 pub use text_measurer::{init_text_measurer, init_text_measurer_with_registry, FontTextMeasurer};
 
 // Re-export layout API for convenience
 pub use blinc_layout::prelude::*;
-pub use blinc_layout::RenderTree;
+pub use blinc_layout::{Damage, RenderTree};
 
 // Re-export platform types for windowed applications
 pub use blinc_platform::WindowConfig;
@@ -171,7 +179,9 @@ pub use blinc_macros::BlincComponent;
 /// Prelude module - import everything commonly needed
 pub mod prelude {
     pub use crate::app::{BlincApp, BlincConfig};
-    pub use crate::context::{DebugMode, RenderContext};
+    pub use crate::context::{
+        DebugMode, DisplayList, MemoryPressure, MemoryUsage, RenderContext, RenderStats,
+    };
     pub use crate::error::{BlincError, Result};
     pub use crate::text_measurer::{init_text_measurer, init_text_measurer_with_registry};
 
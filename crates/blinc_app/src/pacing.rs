@@ -0,0 +1,316 @@
+//! Thermal- and power-aware frame pacing
+//!
+//! Platforms report the device's thermal state and power saving mode (on iOS
+//! `ProcessInfo.thermalState` and `isLowPowerModeEnabled`) along with the
+//! frame rate range the app asked for. `FramePacing` turns those into a
+//! `QualityTier` and the frame rate range to actually run at, so a hot or
+//! power-saving device draws fewer and cheaper frames instead of running at
+//! full rate and quality until the OS throttles it.
+//!
+//! Tiers step down MSAA and switch blurs and glass to the downsampled
+//! pyramid (`BlurMode::Performance`) before anything is hidden, so the UI
+//! looks the same, just slightly softer.
+
+use blinc_gpu::BlurMode;
+
+/// Device thermal state, in the order of `ProcessInfo.ThermalState`
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq, PartialOrd, Ord)]
+pub enum ThermalState {
+    /// Normal operating temperature
+    #[default]
+    Nominal,
+    /// Slightly elevated; the system may start reducing background work
+    Fair,
+    /// High; the system is throttling and the app should cut its own work
+    Serious,
+    /// Critical; the app should do as little as possible
+    Critical,
+}
+
+impl ThermalState {
+    /// Map a `ProcessInfo.ThermalState` raw value
+    ///
+    /// Values past `Critical` are treated as critical.
+    pub fn from_level(level: u32) -> Self {
+        match level {
+            0 => ThermalState::Nominal,
+            1 => ThermalState::Fair,
+            2 => ThermalState::Serious,
+            _ => ThermalState::Critical,
+        }
+    }
+}
+
+/// Rendering quality chosen for the current power state
+#[repr(u32)]
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq, PartialOrd, Ord)]
+pub enum QualityTier {
+    /// Configured MSAA and blur mode at the app's full frame rate range
+    #[default]
+    Full = 0,
+    /// At most 2x MSAA and pyramid blurs, capped at 60fps
+    Reduced = 1,
+    /// No MSAA and pyramid blurs, capped at 30fps
+    Minimal = 2,
+}
+
+impl QualityTier {
+    /// Highest frame rate this tier runs at, or None for no cap
+    pub fn max_fps(self) -> Option<f32> {
+        match self {
+            QualityTier::Full => None,
+            QualityTier::Reduced => Some(60.0),
+            QualityTier::Minimal => Some(30.0),
+        }
+    }
+
+    /// MSAA sample count to use when `configured` is the app's setting
+    pub fn sample_count(self, configured: u32) -> u32 {
+        match self {
+            QualityTier::Full => configured,
+            QualityTier::Reduced => configured.min(2),
+            QualityTier::Minimal => 1,
+        }
+    }
+
+    /// Blur mode to use when `configured` is the app's setting
+    pub fn blur_mode(self, configured: BlurMode) -> BlurMode {
+        match self {
+            QualityTier::Full => configured,
+            QualityTier::Reduced | QualityTier::Minimal => BlurMode::Performance,
+        }
+    }
+}
+
+/// A frame rate range in frames per second, as in `CAFrameRateRange`
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub struct FrameRateRange {
+    /// Lowest acceptable rate
+    pub min: f32,
+    /// Highest rate worth drawing at
+    pub max: f32,
+    /// Rate to aim for
+    pub preferred: f32,
+}
+
+impl Default for FrameRateRange {
+    fn default() -> Self {
+        Self {
+            min: 30.0,
+            max: 120.0,
+            preferred: 120.0,
+        }
+    }
+}
+
+impl FrameRateRange {
+    /// Create a range, fixing up inconsistent values
+    ///
+    /// Non-positive or non-finite rates are dropped: a missing `max` means
+    /// the default 120fps, a missing `preferred` means `max`. `min` and
+    /// `preferred` are clamped into the range.
+    pub fn new(min: f32, max: f32, preferred: f32) -> Self {
+        let valid = |fps: f32| fps.is_finite() && fps > 0.0;
+        let max = if valid(max) {
+            max
+        } else {
+            FrameRateRange::default().max
+        };
+        let min = if valid(min) { min.min(max) } else { 0.0 };
+        let preferred = if valid(preferred) {
+            preferred.clamp(min, max)
+        } else {
+            max
+        };
+        Self {
+            min,
+            max,
+            preferred,
+        }
+    }
+
+    /// This range limited to at most `max_fps`
+    pub fn capped(self, max_fps: f32) -> Self {
+        let max = self.max.min(max_fps);
+        Self {
+            min: self.min.min(max),
+            max,
+            preferred: self.preferred.min(max),
+        }
+    }
+}
+
+/// Fraction of the minimum frame interval after which a frame counts as due
+///
+/// Display link timestamps jitter slightly, so a frame a hair early must
+/// still be drawn or every other frame would be skipped.
+const FRAME_INTERVAL_SLACK: f64 = 0.9;
+
+/// Frame rate and quality policy for one render context
+///
+/// Thermal state notifications are already coarse and debounced by the OS,
+/// so tiers follow them directly without further hysteresis.
+#[derive(Clone, Copy, Debug, Default)]
+pub struct FramePacing {
+    requested: FrameRateRange,
+    thermal: ThermalState,
+    low_power: bool,
+}
+
+impl FramePacing {
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Set the frame rate range the app wants when the device is cool
+    pub fn set_frame_rate_range(&mut self, range: FrameRateRange) {
+        self.requested = range;
+    }
+
+    /// Record the device's power state
+    ///
+    /// Returns true if the quality tier changed.
+    pub fn set_power_state(&mut self, thermal: ThermalState, low_power: bool) -> bool {
+        let tier = self.tier();
+        self.thermal = thermal;
+        self.low_power = low_power;
+        self.tier() != tier
+    }
+
+    /// Current thermal state
+    pub fn thermal_state(&self) -> ThermalState {
+        self.thermal
+    }
+
+    /// Whether power saving mode is on
+    pub fn is_low_power(&self) -> bool {
+        self.low_power
+    }
+
+    /// Quality tier for the current power state
+    ///
+    /// Serious thermal state or power saving mode reduce quality, critical
+    /// thermal state drops it to the minimum.
+    pub fn tier(&self) -> QualityTier {
+        let thermal = match self.thermal {
+            ThermalState::Nominal | ThermalState::Fair => QualityTier::Full,
+            ThermalState::Serious => QualityTier::Reduced,
+            ThermalState::Critical => QualityTier::Minimal,
+        };
+        if self.low_power {
+            thermal.max(QualityTier::Reduced)
+        } else {
+            thermal
+        }
+    }
+
+    /// Frame rate range to run at: the requested one, capped by the tier
+    pub fn frame_rate_range(&self) -> FrameRateRange {
+        match self.tier().max_fps() {
+            Some(max_fps) => self.requested.capped(max_fps),
+            None => self.requested,
+        }
+    }
+
+    /// Frame rate to tick animations at
+    pub fn target_fps(&self) -> u32 {
+        self.frame_rate_range().preferred.round().max(1.0) as u32
+    }
+
+    /// Check whether a frame `elapsed` seconds after the last drawn one
+    /// should be drawn
+    ///
+    /// False for frames that would exceed the range's maximum rate, e.g.
+    /// every other 120Hz display link callback while capped at 60fps.
+    /// Negative or non-finite gaps (clock changes) always count as due.
+    pub fn is_frame_due(&self, elapsed: f64) -> bool {
+        let min_interval = FRAME_INTERVAL_SLACK / self.frame_rate_range().max as f64;
+        !(0.0..min_interval).contains(&elapsed)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_tier_follows_power_state() {
+        let mut pacing = FramePacing::new();
+        assert_eq!(pacing.tier(), QualityTier::Full);
+
+        assert!(!pacing.set_power_state(ThermalState::Fair, false));
+        assert!(pacing.set_power_state(ThermalState::Serious, false));
+        assert_eq!(pacing.tier(), QualityTier::Reduced);
+        assert!(pacing.set_power_state(ThermalState::Critical, false));
+        assert_eq!(pacing.tier(), QualityTier::Minimal);
+
+        // Power saving mode alone reduces quality, but never raises it
+        assert!(pacing.set_power_state(ThermalState::Nominal, true));
+        assert_eq!(pacing.tier(), QualityTier::Reduced);
+        pacing.set_power_state(ThermalState::Critical, true);
+        assert_eq!(pacing.tier(), QualityTier::Minimal);
+
+        assert_eq!(ThermalState::from_level(2), ThermalState::Serious);
+        assert_eq!(ThermalState::from_level(7), ThermalState::Critical);
+    }
+
+    #[test]
+    fn test_tier_quality_settings() {
+        assert_eq!(QualityTier::Full.sample_count(4), 4);
+        assert_eq!(QualityTier::Reduced.sample_count(4), 2);
+        assert_eq!(QualityTier::Reduced.sample_count(1), 1);
+        assert_eq!(QualityTier::Minimal.sample_count(4), 1);
+        assert_eq!(
+            QualityTier::Full.blur_mode(BlurMode::Quality),
+            BlurMode::Quality
+        );
+        assert_eq!(
+            QualityTier::Reduced.blur_mode(BlurMode::Quality),
+            BlurMode::Performance
+        );
+    }
+
+    #[test]
+    fn test_frame_rate_range_is_capped_by_tier() {
+        let mut pacing = FramePacing::new();
+        pacing.set_frame_rate_range(FrameRateRange::new(80.0, 120.0, 120.0));
+        assert_eq!(pacing.target_fps(), 120);
+
+        pacing.set_power_state(ThermalState::Serious, false);
+        assert_eq!(
+            pacing.frame_rate_range(),
+            FrameRateRange {
+                min: 60.0,
+                max: 60.0,
+                preferred: 60.0
+            }
+        );
+        pacing.set_power_state(ThermalState::Critical, false);
+        assert_eq!(pacing.target_fps(), 30);
+
+        // A range already below the cap is left alone
+        pacing.set_frame_rate_range(FrameRateRange::new(10.0, 24.0, 24.0));
+        assert_eq!(pacing.frame_rate_range().max, 24.0);
+
+        let range = FrameRateRange::new(90.0, f32::NAN, 0.0);
+        assert_eq!(range.max, 120.0);
+        assert_eq!(range.preferred, 120.0);
+        assert_eq!(FrameRateRange::new(90.0, 60.0, 30.0).min, 60.0);
+        assert_eq!(FrameRateRange::new(0.0, 60.0, 30.0).preferred, 30.0);
+    }
+
+    #[test]
+    fn test_frames_are_skipped_above_the_cap() {
+        let mut pacing = FramePacing::new();
+        let refresh = 1.0 / 120.0;
+        assert!(pacing.is_frame_due(refresh));
+
+        pacing.set_power_state(ThermalState::Serious, false);
+        assert!(!pacing.is_frame_due(refresh));
+        assert!(pacing.is_frame_due(2.0 * refresh));
+        // Jitter around the cap's interval still draws
+        assert!(pacing.is_frame_due(2.0 * refresh - 0.0005));
+        assert!(pacing.is_frame_due(-1.0));
+        assert!(pacing.is_frame_due(f64::NAN));
+    }
+}
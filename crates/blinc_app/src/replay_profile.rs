@@ -0,0 +1,253 @@
+//! Profiling replay through the headless frame pipeline
+//!
+//! Feeds a recorded session (see `blinc_recorder`) into a `BlincApp` one
+//! frame at a time: the frame's recorded pointer and scroll inputs are routed
+//! to the tree kept from the previous frame, queued prop updates and subtree
+//! rebuilds are applied, the UI is rebuilt and diffed into that tree with
+//! `incremental_update`, laid out where it changed and rendered, and each
+//! stage is timed. The result is a `ProfileTrace` whose Chrome trace
+//! export shows where the original session would have dropped frames.
+//!
+//! Requires the `replay-profile` feature. On iOS the same replay runs on
+//! device through `blinc_replay_profile_start`.
+//!
+//! # Example
+//!
+//! ```ignore
+//! use blinc_app::replay_profile::{load_recording, ReplayProfiler};
+//! use blinc_recorder::ProfileConfig;
+//!
+//! let export = load_recording(&std::fs::read_to_string("session.json")?)?;
+//! let profiler = ReplayProfiler::new(export, ProfileConfig::accelerated(4.0), 800, 600);
+//! let trace = profiler.run(&mut app, &target_view, |w, h| build_ui(w, h))?;
+//! std::fs::write("session.trace.json", trace.to_chrome_trace())?;
+//! ```
+
+use std::sync::{Arc, Mutex};
+use std::time::{Duration, Instant};
+
+use blinc_animation::AnimationScheduler;
+use blinc_layout::event_router::{EventRouter, MouseButton};
+use blinc_layout::prelude::*;
+use blinc_layout::{RenderState, RenderTree, SharedUpdateQueue, UpdateResult};
+use blinc_recorder::{
+    FrameStage, ProfileConfig, ProfileReplay, ProfileTrace, RecordingExport, SimulatedInput,
+};
+
+use crate::app::BlincApp;
+use crate::error::{BlincError, Result};
+
+/// Parse a recording exported by `SharedRecordingSession::export` as JSON
+pub fn load_recording(json: &str) -> Result<RecordingExport> {
+    serde_json::from_str(json).map_err(|e| BlincError::Other(format!("Invalid recording: {}", e)))
+}
+
+/// Replays a recording through a headless `BlincApp` and times every frame
+///
+/// Pointer and scroll inputs are replayed; keyboard and text input are
+/// recorded in the trace but not injected. Frames render at the size given
+/// to `new`, so recorded window resizes are not replayed.
+pub struct ReplayProfiler {
+    replay: ProfileReplay,
+    router: EventRouter,
+    render_state: RenderState,
+    update_queue: SharedUpdateQueue,
+    width: u32,
+    height: u32,
+}
+
+impl ReplayProfiler {
+    /// Create a profiler rendering `export` at `width`×`height`
+    pub fn new(export: RecordingExport, config: ProfileConfig, width: u32, height: u32) -> Self {
+        let scheduler = Arc::new(Mutex::new(AnimationScheduler::new()));
+        Self {
+            replay: ProfileReplay::new(export, config),
+            router: EventRouter::new(),
+            render_state: RenderState::new(scheduler),
+            update_queue: SharedUpdateQueue::default(),
+            width,
+            height,
+        }
+    }
+
+    /// Replay the whole recording, rebuilding the UI with `build` each frame
+    ///
+    /// The tree persists across frames like in the windowed and iOS loops, so
+    /// replayed scrolls and state changes carry over and only what `build`
+    /// changed is laid out again. `target` must be a `width`×`height` texture
+    /// in the app's format.
+    pub fn run<E, F>(
+        mut self,
+        app: &mut BlincApp,
+        target: &wgpu::TextureView,
+        mut build: F,
+    ) -> Result<ProfileTrace>
+    where
+        E: ElementBuilder,
+        F: FnMut(f32, f32) -> E,
+    {
+        let (width, height) = (self.width as f32, self.height as f32);
+        // Updates queued by the replayed UI land here, not in another context
+        let update_queue = self.update_queue.clone();
+        let _queue = update_queue.enter();
+        let mut tree: Option<RenderTree> = None;
+
+        while let Some(update) = self.replay.next_frame() {
+            // Inputs land on what the user was looking at: last frame's tree
+            let start = Instant::now();
+            if let Some(tree) = tree.as_mut() {
+                for input in &update.events {
+                    apply_input(&mut self.router, tree, input);
+                }
+                tree.tick_scroll_physics(elapsed_ms());
+                tree.process_pending_scroll_refs();
+            }
+            let input_time = start.elapsed();
+
+            // Apply what handlers queued, as the windowed loop does
+            let start = Instant::now();
+            let mut layout_time = Duration::ZERO;
+            if blinc_layout::take_needs_redraw() || blinc_layout::has_pending_subtree_rebuilds() {
+                let prop_updates = blinc_layout::take_pending_prop_updates();
+                if let Some(tree) = tree.as_mut() {
+                    for (node_id, props) in prop_updates {
+                        tree.update_render_props(node_id, |p| *p = props);
+                    }
+                    if tree.process_pending_subtree_rebuilds() {
+                        let layout_start = Instant::now();
+                        tree.update_layout(width, height);
+                        layout_time += layout_start.elapsed();
+                    }
+                }
+            }
+            let update_time = start.elapsed() - layout_time;
+
+            let start = Instant::now();
+            let element = build(width, height);
+            let relayout = match tree.as_mut() {
+                Some(existing) => matches!(
+                    existing.incremental_update(&element),
+                    UpdateResult::LayoutChanged | UpdateResult::ChildrenChanged
+                ),
+                None => {
+                    tree = Some(RenderTree::from_element(&element));
+                    true
+                }
+            };
+            let build_time = start.elapsed();
+            let current = tree.as_mut().expect("tree was created above");
+
+            if relayout {
+                let start = Instant::now();
+                current.compute_layout(width, height);
+                layout_time += start.elapsed();
+            }
+
+            app.render_tree_with_motion(
+                current,
+                &self.render_state,
+                target,
+                self.width,
+                self.height,
+            )?;
+            let stats = app.last_render_stats();
+
+            self.replay.finish_frame(vec![
+                FrameStage::new("input", input_time),
+                FrameStage::new("updates", update_time),
+                FrameStage::new("build", build_time),
+                FrameStage::new("layout", layout_time),
+                FrameStage::new("encode", stats.encode_time),
+                FrameStage::new("gpu", stats.gpu_time),
+            ]);
+        }
+
+        let trace = self.replay.into_trace();
+        let jank = trace.jank_frames().count();
+        tracing::info!(
+            "Replayed {} frames, {} over the {:?} budget",
+            trace.frames.len(),
+            jank,
+            Duration::from_micros(trace.frame_budget_us)
+        );
+        Ok(trace)
+    }
+}
+
+fn mouse_button(button: blinc_recorder::MouseButton) -> MouseButton {
+    match button {
+        blinc_recorder::MouseButton::Left => MouseButton::Left,
+        blinc_recorder::MouseButton::Right => MouseButton::Right,
+        blinc_recorder::MouseButton::Middle => MouseButton::Middle,
+        blinc_recorder::MouseButton::Other(n) => MouseButton::Other(n as u16),
+    }
+}
+
+/// Route one recorded input through `router` and dispatch it to `tree`
+fn apply_input(router: &mut EventRouter, tree: &mut RenderTree, input: &SimulatedInput) {
+    let events = match input {
+        SimulatedInput::MouseMove { position, .. } => {
+            router.on_mouse_move(tree, position.x, position.y)
+        }
+        SimulatedInput::MouseDown {
+            position, button, ..
+        } => router.on_mouse_down(tree, position.x, position.y, mouse_button(*button)),
+        SimulatedInput::MouseUp {
+            position, button, ..
+        } => router.on_mouse_up(tree, position.x, position.y, mouse_button(*button)),
+        SimulatedInput::Click {
+            position, button, ..
+        }
+        | SimulatedInput::DoubleClick {
+            position, button, ..
+        } => {
+            let button = mouse_button(*button);
+            let mut events = router.on_mouse_down(tree, position.x, position.y, button);
+            events.extend(router.on_mouse_up(tree, position.x, position.y, button));
+            events
+        }
+        SimulatedInput::Scroll {
+            position,
+            delta_x,
+            delta_y,
+            ..
+        } => {
+            router.on_mouse_move(tree, position.x, position.y);
+            if let Some(hit) = router.on_scroll_nested(tree, *delta_x, *delta_y) {
+                tree.dispatch_scroll_chain(
+                    hit.node,
+                    &hit.ancestors,
+                    position.x,
+                    position.y,
+                    *delta_x,
+                    *delta_y,
+                );
+            }
+            return;
+        }
+        SimulatedInput::WindowFocus { focused } => {
+            router.on_window_focus(*focused).into_iter().collect()
+        }
+        _ => return,
+    };
+
+    let (mouse_x, mouse_y) = router.mouse_position();
+    let (drag_x, drag_y) = router.drag_delta();
+    for (node, event_type) in events {
+        let (x, y, w, h) = router.get_node_bounds(node).unwrap_or_default();
+        tree.dispatch_event_full(
+            node,
+            event_type,
+            mouse_x,
+            mouse_y,
+            mouse_x - x,
+            mouse_y - y,
+            x,
+            y,
+            w,
+            h,
+            drag_x,
+            drag_y,
+        );
+    }
+}
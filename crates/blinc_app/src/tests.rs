@@ -5,6 +5,7 @@
 
 use crate::app::BlincConfig;
 use crate::prelude::*;
+use crate::Damage;
 use image::{ImageBuffer, Rgba, RgbaImage};
 use std::path::Path;
 
@@ -66,15 +67,14 @@ fn padded_bytes_per_row(width: u32) -> u32 {
     ((unpadded + align - 1) / align) * align
 }
 
-/// Save a rendered texture to PNG
-fn save_to_png(
+/// Read a rendered texture back into an image
+fn read_texture(
     device: &wgpu::Device,
     queue: &wgpu::Queue,
     texture: &wgpu::Texture,
     width: u32,
     height: u32,
-    path: &Path,
-) {
+) -> RgbaImage {
     let bytes_per_row = padded_bytes_per_row(width);
     let buffer_size = (bytes_per_row * height) as u64;
 
@@ -148,6 +148,19 @@ fn save_to_png(
 
     drop(data);
     buffer.unmap();
+    img
+}
+
+/// Save a rendered texture to PNG
+fn save_to_png(
+    device: &wgpu::Device,
+    queue: &wgpu::Queue,
+    texture: &wgpu::Texture,
+    width: u32,
+    height: u32,
+    path: &Path,
+) {
+    let img = read_texture(device, queue, texture, width, height);
 
     // Ensure output directory exists
     if let Some(parent) = path.parent() {
@@ -582,3 +595,156 @@ fn test_render_tree_reuse() {
     save_to_png(app.device(), app.queue(), &texture, 200, 200, &path);
     println!("Saved: {:?}", path);
 }
+
+/// Render state for recording display lists
+fn test_render_state() -> blinc_layout::RenderState {
+    let scheduler = blinc_animation::AnimationScheduler::new();
+    blinc_layout::RenderState::new(std::sync::Arc::new(std::sync::Mutex::new(scheduler)))
+}
+
+#[test]
+fn test_display_list_matches_render_tree() {
+    require_gpu!(app);
+
+    let ui = div()
+        .w(200.0)
+        .h(100.0)
+        .flex_row()
+        .bg(Color::WHITE)
+        .child(div().w(100.0).h_full().bg(Color::RED))
+        .child(div().w(100.0).h_full().bg(Color::BLUE));
+    let mut tree = RenderTree::from_element(&ui);
+    tree.compute_layout(200.0, 100.0);
+
+    let (texture, view) = create_test_texture(app.device(), 200, 100);
+    app.render_tree(&tree, &view, 200, 100)
+        .expect("Render failed");
+    let direct = read_texture(app.device(), app.queue(), &texture, 200, 100);
+
+    let state = test_render_state();
+    let list = DisplayList::record(&tree, &state, app.text_context(), 200, 100);
+    assert_eq!(list.size(), (200, 100));
+    let (texture, view) = create_test_texture(app.device(), 200, 100);
+    app.render_display_list(&list, &view)
+        .expect("Render failed");
+    let recorded = read_texture(app.device(), app.queue(), &texture, 200, 100);
+
+    for (x, y) in [(50, 50), (150, 50)] {
+        assert_eq!(recorded.get_pixel(x, y), direct.get_pixel(x, y));
+    }
+}
+
+#[test]
+fn test_display_list_draws_canvas_text() {
+    require_gpu!(app);
+
+    let ui = div().w(200.0).h(60.0).bg(Color::BLACK).child(
+        canvas(|ctx, _bounds| {
+            let style = blinc_core::TextStyle {
+                size: 32.0,
+                color: Color::WHITE,
+                ..Default::default()
+            };
+            ctx.draw_text("Blinc", Point::new(10.0, 40.0), &style);
+        })
+        .w(200.0)
+        .h(60.0),
+    );
+    let mut tree = RenderTree::from_element(&ui);
+    tree.compute_layout(200.0, 60.0);
+    let has_text = |img: &RgbaImage| img.pixels().any(|p| p[0] > 128);
+
+    let (texture, view) = create_test_texture(app.device(), 200, 60);
+    app.render_tree(&tree, &view, 200, 60)
+        .expect("Render failed");
+    if !has_text(&read_texture(app.device(), app.queue(), &texture, 200, 60)) {
+        eprintln!("Skipping test: no fonts available");
+        return;
+    }
+
+    let state = test_render_state();
+    let list = DisplayList::record(&tree, &state, app.text_context(), 200, 60);
+    let (texture, view) = create_test_texture(app.device(), 200, 60);
+    app.render_display_list(&list, &view)
+        .expect("Render failed");
+    assert!(has_text(&read_texture(
+        app.device(),
+        app.queue(),
+        &texture,
+        200,
+        60
+    )));
+}
+
+#[test]
+fn test_font_registration_invalidates_text_layout() {
+    require_gpu!(app);
+
+    let path = Path::new(env!("CARGO_MANIFEST_DIR"))
+        .join("../../mobile/example/platforms/ios/BlincApp/Fonts/Arial.ttf");
+    let Ok(data) = std::fs::read(&path) else {
+        eprintln!("Skipping test: bundled font not found");
+        return;
+    };
+
+    let ui = div()
+        .w(200.0)
+        .h(60.0)
+        .child(text("Blinc").size(24.0).font("Arial"));
+    let mut tree = RenderTree::from_element(&ui);
+    tree.compute_layout(200.0, 60.0);
+    let all_nodes = tree.layout_node_count();
+    assert!(all_nodes >= 2);
+
+    // Nothing changed yet, so nothing is laid out again
+    tree.update_layout(200.0, 60.0);
+    assert_eq!(tree.layout_node_count(), 0);
+
+    // Text measured with the old fonts has to be measured again: the text
+    // node and its ancestors (here, the whole tree) are laid out afresh
+    assert!(app.load_font_data_to_registry(data) > 0);
+    tree.update_layout(200.0, 60.0);
+    assert_eq!(tree.layout_node_count(), all_nodes);
+
+    // A second pass is clean again: the new generation was recorded
+    tree.update_layout(200.0, 60.0);
+    assert_eq!(tree.layout_node_count(), 0);
+}
+
+#[test]
+fn test_partial_redraw_keeps_retained_layer_frame() {
+    require_gpu!(app);
+
+    let ui = div()
+        .w(200.0)
+        .h(100.0)
+        .flex_row()
+        .bg(Color::WHITE)
+        .child(div().w(100.0).h_full().bg(Color::RED).cache_layer())
+        .child(div().w(100.0).h_full().bg(Color::BLUE));
+    let mut tree = RenderTree::from_element(&ui);
+    tree.compute_layout(200.0, 100.0);
+    let state = test_render_state();
+
+    app.set_partial_redraw(true);
+    let (texture, view) = create_test_texture(app.device(), 200, 100);
+    app.render_tree_with_damage(&tree, &state, &Damage::Full, &view, 200, 100)
+        .expect("Render failed");
+    let full = read_texture(app.device(), app.queue(), &texture, 200, 100);
+
+    // Damage that overlaps the retained layer takes the layer path, which
+    // must keep the previous frame outside the damaged rect
+    let damage = Damage::Rects(vec![Rect::new(80.0, 40.0, 40.0, 20.0)]);
+    app.render_tree_with_damage(&tree, &state, &damage, &view, 200, 100)
+        .expect("Render failed");
+    assert!(matches!(app.last_damage(), Damage::Rects(_)));
+    let partial = read_texture(app.device(), app.queue(), &texture, 200, 100);
+
+    for (x, y) in [(20, 20), (90, 10), (150, 50), (190, 90), (100, 50)] {
+        assert_eq!(
+            partial.get_pixel(x, y),
+            full.get_pixel(x, y),
+            "pixel ({x}, {y})"
+        );
+    }
+}
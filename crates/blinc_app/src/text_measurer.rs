@@ -191,6 +191,23 @@ impl TextMeasurer for FontTextMeasurer {
             line_count: layout.lines.len() as u32,
         }
     }
+
+    fn prepare_batch(&self, texts: &[&str], font_size: f32, options: &TextLayoutOptions) {
+        let generic_font = to_text_generic_font(options.generic_font);
+        let registry = self.font_registry.lock().unwrap();
+        let Some(font) = registry.get_for_render_with_style(
+            options.font_name.as_deref(),
+            generic_font,
+            options.font_weight,
+            options.italic,
+        ) else {
+            return;
+        };
+        drop(registry);
+
+        // Shapes into the shared shape cache that measure_with_options uses
+        TextLayoutEngine::new().shape_batch(texts, &font, font_size);
+    }
 }
 
 /// Initialize the global text measurer with font support
@@ -1425,6 +1425,8 @@ impl WindowedApp {
         // Shared animation scheduler for spring/keyframe animations
         // Runs on background thread so animations continue even when window loses focus
         let mut scheduler = AnimationScheduler::new();
+        // Image decode workers wake the event loop when an image lands
+        let image_wake_proxy = wake_proxy.clone();
         // Set up wake callback so animation thread can wake the event loop
         scheduler.set_wake_callback(move || wake_proxy.wake());
         scheduler.start_background();
@@ -1518,7 +1520,12 @@ impl WindowedApp {
                             let winit_window = window.winit_window_arc();
 
                             match BlincApp::with_window(winit_window, None) {
-                                Ok((blinc_app, surf)) => {
+                                Ok((mut blinc_app, surf)) => {
+                                    let wake = image_wake_proxy.clone();
+                                    blinc_app
+                                        .context()
+                                        .set_image_ready_callback(move || wake.wake());
+
                                     let (width, height) = window.size();
                                     // Use the same texture format that the renderer's pipelines use
                                     let format = blinc_app.texture_format();
@@ -2419,8 +2426,8 @@ impl WindowedApp {
                                 // Apply prop updates to the main tree
                                 // (Overlays are now part of the main tree, so all nodes are here)
                                 if let Some(ref mut tree) = render_tree {
-                                    for (node_id, props) in &prop_updates {
-                                        tree.update_render_props(*node_id, |p| *p = props.clone());
+                                    for (node_id, props) in prop_updates {
+                                        tree.update_render_props(node_id, |p| *p = props);
                                     }
                                 }
 
@@ -81,6 +81,12 @@ enum Commands {
         command: PluginCommands,
     },
 
+    /// Work with stylesheets
+    Css {
+        #[command(subcommand)]
+        command: CssCommands,
+    },
+
     /// Create a new Blinc project
     New {
         /// Project name
@@ -144,6 +150,19 @@ enum PluginCommands {
     },
 }
 
+#[derive(Subcommand)]
+enum CssCommands {
+    /// Precompile a stylesheet for `Stylesheet::from_compiled`
+    Compile {
+        /// CSS file
+        input: String,
+
+        /// Output path (defaults to the input with a .bcss extension)
+        #[arg(short, long)]
+        output: Option<String>,
+    },
+}
+
 fn main() -> Result<()> {
     let cli = Cli::parse();
 
@@ -181,6 +200,10 @@ fn main() -> Result<()> {
             PluginCommands::New { name } => cmd_plugin_new(&name),
         },
 
+        Commands::Css { command } => match command {
+            CssCommands::Compile { input, output } => cmd_css_compile(&input, output.as_deref()),
+        },
+
         Commands::New {
             name,
             template,
@@ -296,6 +319,37 @@ fn cmd_plugin_new(name: &str) -> Result<()> {
     Ok(())
 }
 
+fn cmd_css_compile(input: &str, output: Option<&str>) -> Result<()> {
+    use blinc_layout::css_parser::Stylesheet;
+
+    let input_path = PathBuf::from(input);
+    let output_path = match output {
+        Some(output) => PathBuf::from(output),
+        None => input_path.with_extension("bcss"),
+    };
+
+    let css = fs::read_to_string(&input_path)?;
+
+    // theme() references are checked against the default theme
+    blinc_theme::ThemeState::init_default();
+    let compiled = match Stylesheet::compile(&css) {
+        Ok(compiled) => compiled,
+        Err(result) => {
+            result.print_colored_diagnostics();
+            anyhow::bail!("Failed to compile {}", input);
+        }
+    };
+
+    fs::write(&output_path, &compiled)?;
+    info!(
+        "Compiled {} -> {} ({} bytes)",
+        input,
+        output_path.display(),
+        compiled.len()
+    );
+    Ok(())
+}
+
 fn cmd_new(name: &str, template: &str, org: &str, rust: bool) -> Result<()> {
     let path = PathBuf::from(name);
 
@@ -894,6 +894,13 @@ pub struct LayerConfig {
     pub depth: bool,
     /// Post-processing effects to apply when layer is composited
     pub effects: Vec<LayerEffect>,
+    /// Keep the layer's rendered texture across frames
+    ///
+    /// The renderer hashes the layer's content and, while it is unchanged,
+    /// composites last frame's texture instead of re-rendering (and
+    /// re-applying effects). Suited to static subtrees such as sidebars,
+    /// headers and chart backgrounds.
+    pub retained: bool,
 }
 
 impl LayerConfig {
@@ -938,6 +945,12 @@ impl LayerConfig {
         self
     }
 
+    /// Retain the rendered layer across frames (see `LayerConfig::retained`)
+    pub fn retained(mut self) -> Self {
+        self.retained = true;
+        self
+    }
+
     /// Add a post-processing effect
     pub fn effect(mut self, effect: LayerEffect) -> Self {
         self.effects.push(effect);
@@ -1254,6 +1267,38 @@ pub trait DrawContext {
     /// Sample from a named layer's output
     fn sample_layer(&mut self, id: LayerId, source_rect: Rect, dest_rect: Rect);
 
+    // ─────────────────────────────────────────────────────────────────────────
+    // Scroll Content
+    // ─────────────────────────────────────────────────────────────────────────
+
+    /// Mark the start of a scroll container's content
+    ///
+    /// Everything drawn until `end_scroll_content` moves with the container's
+    /// scroll offset. Contexts that retain their output can use this to move
+    /// the content on later frames instead of drawing it again. `id`
+    /// identifies the container across frames and rendering passes.
+    fn begin_scroll_content(&mut self, _id: u64) {
+        // Default implementation does nothing
+    }
+
+    /// Mark the end of the content started by `begin_scroll_content`
+    fn end_scroll_content(&mut self) {
+        // Default implementation does nothing
+    }
+
+    /// Mark the start of a scroll container's scrollbar
+    ///
+    /// The scrollbar changes with every offset, so retaining contexts redraw
+    /// it instead of moving it.
+    fn begin_scroll_indicator(&mut self, _id: u64) {
+        // Default implementation does nothing
+    }
+
+    /// Mark the end of the scrollbar started by `begin_scroll_indicator`
+    fn end_scroll_indicator(&mut self) {
+        // Default implementation does nothing
+    }
+
     // ─────────────────────────────────────────────────────────────────────────
     // State Queries
     // ─────────────────────────────────────────────────────────────────────────
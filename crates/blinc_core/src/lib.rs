@@ -39,6 +39,7 @@ pub mod draw;
 pub mod events;
 pub mod fsm;
 pub mod layer;
+pub mod mpsc;
 pub mod native_bridge;
 pub mod reactive;
 pub mod runtime;
@@ -61,6 +62,7 @@ pub use layer::{
     PostEffect, Rect, Scene3DCommand, Scene3DCommands, SceneGraph, Shadow, Size, TextureFormat,
     UiNode, Vec2, Vec3,
 };
+pub use mpsc::MpscQueue;
 pub use reactive::{
     Derived, DerivedId, DirtyFlag, Effect, EffectId, ReactiveGraph, SharedReactiveGraph, Signal,
     SignalId, State, StatefulDepsCallback,
@@ -89,7 +91,8 @@ pub use store::{
 
 // Re-export native bridge types
 pub use native_bridge::{
-    native_call, native_register, set_platform_adapter, FromNativeValue, IntoNativeArgs,
-    NativeBridgeError, NativeBridgeState, NativeHandler, NativeResult, NativeValue,
-    PlatformAdapter,
+    drain_native_completions, has_pending_native_completions, native_call, native_call_async,
+    native_call_async_with, native_complete, native_register, set_platform_adapter,
+    FromNativeValue, IntoNativeArgs, NativeBridgeError, NativeBridgeState, NativeCall,
+    NativeHandler, NativeRequestId, NativeResult, NativeValue, PlatformAdapter,
 };
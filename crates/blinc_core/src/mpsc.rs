@@ -0,0 +1,164 @@
+//! Lock-free multi-producer queue drained in batches
+//!
+//! Producers push with a single compare-and-swap onto an intrusive stack;
+//! the consumer takes the whole stack with one swap and reverses it into
+//! push order. Neither side ever waits on the other, so a state change on
+//! another thread can't stall the frame that drains the queue. There are no
+//! single-item pops, so the stack is not exposed to ABA.
+
+use std::ptr;
+use std::sync::atomic::{AtomicPtr, AtomicUsize, Ordering};
+
+struct Node<T> {
+    value: T,
+    next: *mut Node<T>,
+}
+
+/// Unbounded lock-free queue whose consumer takes everything at once
+///
+/// Shared by the native bridge's async completions and the layout crate's
+/// update queues.
+pub struct MpscQueue<T> {
+    head: AtomicPtr<Node<T>>,
+    /// Items pushed and not yet taken (incremented before the push lands)
+    len: AtomicUsize,
+}
+
+// Safety: values are only moved between threads, never shared
+unsafe impl<T: Send> Send for MpscQueue<T> {}
+unsafe impl<T: Send> Sync for MpscQueue<T> {}
+
+impl<T> MpscQueue<T> {
+    /// Create an empty queue (usable in a `static`)
+    pub const fn new() -> Self {
+        Self {
+            head: AtomicPtr::new(ptr::null_mut()),
+            len: AtomicUsize::new(0),
+        }
+    }
+
+    /// Add a value
+    pub fn push(&self, value: T) {
+        let node = Box::into_raw(Box::new(Node {
+            value,
+            next: ptr::null_mut(),
+        }));
+        self.len.fetch_add(1, Ordering::Relaxed);
+
+        let mut head = self.head.load(Ordering::Relaxed);
+        loop {
+            // Safety: `node` isn't reachable by other threads until the
+            // exchange below publishes it
+            unsafe { (*node).next = head };
+            match self
+                .head
+                .compare_exchange_weak(head, node, Ordering::Release, Ordering::Relaxed)
+            {
+                Ok(_) => return,
+                Err(current) => head = current,
+            }
+        }
+    }
+
+    /// Add several values, in order
+    pub fn extend(&self, values: impl IntoIterator<Item = T>) {
+        for value in values {
+            self.push(value);
+        }
+    }
+
+    /// Take every queued value, oldest first
+    pub fn take_all(&self) -> Vec<T> {
+        let mut node = self.head.swap(ptr::null_mut(), Ordering::Acquire);
+        let mut values = Vec::new();
+        while !node.is_null() {
+            // Safety: the swap detached the list, so it is owned here
+            let boxed = unsafe { Box::from_raw(node) };
+            node = boxed.next;
+            values.push(boxed.value);
+        }
+        self.len.fetch_sub(values.len(), Ordering::Relaxed);
+        values.reverse();
+        values
+    }
+
+    /// Number of queued values
+    ///
+    /// May briefly count a value whose push is still in progress.
+    pub fn len(&self) -> usize {
+        self.len.load(Ordering::Relaxed)
+    }
+
+    /// Check whether nothing is queued
+    ///
+    /// A single atomic load, cheap enough for per-vsync "needs render" checks.
+    pub fn is_empty(&self) -> bool {
+        self.head.load(Ordering::Acquire).is_null()
+    }
+}
+
+impl<T> Default for MpscQueue<T> {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl<T> Drop for MpscQueue<T> {
+    fn drop(&mut self) {
+        drop(self.take_all());
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::sync::Arc;
+
+    #[test]
+    fn test_take_all_returns_push_order() {
+        let queue = MpscQueue::new();
+        queue.push(1);
+        queue.extend([2, 3]);
+        assert_eq!(queue.len(), 3);
+        assert!(!queue.is_empty());
+        assert_eq!(queue.take_all(), vec![1, 2, 3]);
+        assert_eq!(queue.len(), 0);
+        assert!(queue.is_empty());
+        assert!(queue.take_all().is_empty());
+    }
+
+    #[test]
+    fn test_concurrent_producers() {
+        let queue = Arc::new(MpscQueue::new());
+        let producers: Vec<_> = (0..4)
+            .map(|t| {
+                let queue = Arc::clone(&queue);
+                std::thread::spawn(move || {
+                    for i in 0..1000 {
+                        queue.push((t, i));
+                    }
+                })
+            })
+            .collect();
+
+        let mut taken = Vec::new();
+        while taken.len() < 4000 {
+            taken.extend(queue.take_all());
+        }
+        for producer in producers {
+            producer.join().unwrap();
+        }
+        taken.extend(queue.take_all());
+        assert_eq!(taken.len(), 4000);
+
+        // Each producer's values arrive in the order it pushed them
+        for t in 0..4 {
+            let values: Vec<_> = taken
+                .iter()
+                .filter(|(p, _)| *p == t)
+                .map(|(_, i)| *i)
+                .collect();
+            assert_eq!(values, (0..1000).collect::<Vec<_>>());
+        }
+    }
+}
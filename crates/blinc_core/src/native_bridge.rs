@@ -59,10 +59,34 @@
 //!     String(UIDevice.current.batteryLevel)
 //! }
 //! ```
+//!
+//! # Async Calls
+//!
+//! Slow native work (keychain reads, location fixes) should not block the
+//! thread that builds frames. `native_call_async` returns immediately with a
+//! request id; the platform completes the request later from any thread via
+//! `native_complete`, which pushes the result onto a lock-free queue. The
+//! frame loop calls `drain_native_completions` once per frame, which hands
+//! results to the waiting callbacks or `NativeCall` futures on the frame
+//! thread.
+//!
+//! ```ignore
+//! use blinc_core::native_bridge::native_call_async_with;
+//!
+//! native_call_async_with("keychain", "read", ("token",), move |result| {
+//!     token_state.set(result.ok().and_then(|v| v.into_string()));
+//! });
+//! ```
 
 use std::collections::HashMap;
 use std::fmt;
-use std::sync::{Arc, OnceLock, RwLock};
+use std::future::Future;
+use std::pin::Pin;
+use std::sync::atomic::{AtomicU64, Ordering};
+use std::sync::{Arc, Mutex, OnceLock, RwLock};
+use std::task::{Context, Poll, Waker};
+
+use crate::mpsc::MpscQueue;
 
 // ============================================================================
 // Types
@@ -77,6 +101,18 @@ pub type NativeResult<T> = Result<T, NativeBridgeError>;
 /// Handler function type for native calls
 pub type NativeHandler = Arc<dyn Fn(Vec<NativeValue>) -> NativeResult<NativeValue> + Send + Sync>;
 
+/// Identifier of an in-flight async native call
+pub type NativeRequestId = u64;
+
+/// Callback invoked on the frame thread when an async native call completes
+pub type NativeCompletionCallback = Box<dyn FnOnce(NativeResult<NativeValue>) + Send>;
+
+/// Callback that wakes a frame loop when an async call completes
+pub type NativeCompletionWaker = Arc<dyn Fn() + Send + Sync>;
+
+/// Identifies a waker added with `add_native_completion_waker`
+pub type NativeWakerId = u64;
+
 /// Error type for native bridge operations
 #[derive(Debug, Clone)]
 pub enum NativeBridgeError {
@@ -431,6 +467,21 @@ pub trait PlatformAdapter: Send + Sync {
         name: &str,
         args: Vec<NativeValue>,
     ) -> NativeResult<NativeValue>;
+
+    /// Start an async native call
+    ///
+    /// The adapter must eventually call `native_complete(request_id, ..)`,
+    /// from any thread. The default implementation performs a blocking
+    /// `call` and completes immediately, for adapters without async support.
+    fn call_async(
+        &self,
+        request_id: NativeRequestId,
+        namespace: &str,
+        name: &str,
+        args: Vec<NativeValue>,
+    ) {
+        native_complete(request_id, self.call(namespace, name, args));
+    }
 }
 
 // ============================================================================
@@ -445,6 +496,10 @@ pub struct NativeBridgeState {
     handlers: RwLock<HashMap<String, HashMap<String, NativeHandler>>>,
     /// Platform adapter (JNI for Android, C FFI for iOS)
     platform_adapter: RwLock<Option<Arc<dyn PlatformAdapter>>>,
+    /// Async calls waiting for their completion to be drained
+    pending_async: Mutex<HashMap<NativeRequestId, PendingNativeCall>>,
+    /// Next async request id
+    next_request_id: AtomicU64,
 }
 
 impl NativeBridgeState {
@@ -459,6 +514,8 @@ impl NativeBridgeState {
         let state = NativeBridgeState {
             handlers: RwLock::new(HashMap::new()),
             platform_adapter: RwLock::new(None),
+            pending_async: Mutex::new(HashMap::new()),
+            next_request_id: AtomicU64::new(1),
         };
 
         if NATIVE_BRIDGE.set(state).is_err() {
@@ -559,6 +616,130 @@ impl NativeBridgeState {
         })
     }
 
+    /// Start an async native call, invoking `on_complete` when it finishes
+    ///
+    /// Returns immediately. `on_complete` runs on the thread that calls
+    /// `drain_completions` (the frame thread), never on the thread that
+    /// completed the request. Rust-registered handlers run synchronously but
+    /// their result is still delivered through the completion queue, so
+    /// callers see the same ordering either way.
+    pub fn call_async_with<A, F>(
+        &self,
+        namespace: &str,
+        name: &str,
+        args: A,
+        on_complete: F,
+    ) -> NativeRequestId
+    where
+        A: IntoNativeArgs,
+        F: FnOnce(NativeResult<NativeValue>) + Send + 'static,
+    {
+        self.start_async(
+            namespace,
+            name,
+            args.into_native_args(),
+            PendingNativeCall::Callback(Box::new(on_complete)),
+        )
+    }
+
+    /// Start an async native call, returning a future for its result
+    ///
+    /// The future resolves after the completion has been drained by the
+    /// frame loop. It can also be checked without an executor via
+    /// `NativeCall::try_take`.
+    pub fn call_async<A: IntoNativeArgs>(
+        &self,
+        namespace: &str,
+        name: &str,
+        args: A,
+    ) -> NativeCall {
+        let slot = Arc::new(NativeCallSlot::default());
+        let request_id = self.start_async(
+            namespace,
+            name,
+            args.into_native_args(),
+            PendingNativeCall::Future(Arc::clone(&slot)),
+        );
+        NativeCall { request_id, slot }
+    }
+
+    fn start_async(
+        &self,
+        namespace: &str,
+        name: &str,
+        args: Vec<NativeValue>,
+        pending: PendingNativeCall,
+    ) -> NativeRequestId {
+        let request_id = self.next_request_id.fetch_add(1, Ordering::Relaxed);
+        self.pending_async
+            .lock()
+            .unwrap()
+            .insert(request_id, pending);
+
+        // Rust-registered handlers complete synchronously
+        let handler = self
+            .handlers
+            .read()
+            .unwrap()
+            .get(namespace)
+            .and_then(|ns| ns.get(name))
+            .cloned();
+        if let Some(handler) = handler {
+            native_complete(request_id, handler(args));
+            return request_id;
+        }
+
+        // Clone the adapter out so a slow dispatch doesn't hold the lock
+        let adapter = self.platform_adapter.read().unwrap().clone();
+        match adapter {
+            Some(adapter) => adapter.call_async(request_id, namespace, name, args),
+            None => native_complete(
+                request_id,
+                Err(NativeBridgeError::NotRegistered {
+                    namespace: namespace.to_string(),
+                    name: name.to_string(),
+                }),
+            ),
+        }
+        request_id
+    }
+
+    /// Cancel an async call; its result is discarded when it arrives
+    pub fn cancel_async(&self, request_id: NativeRequestId) -> bool {
+        self.pending_async
+            .lock()
+            .unwrap()
+            .remove(&request_id)
+            .is_some()
+    }
+
+    /// Deliver all completed async results to their waiters
+    ///
+    /// Call once per frame from the frame thread. Returns the number of
+    /// completions that were delivered.
+    pub fn drain_completions(&self) -> usize {
+        let completions = COMPLETIONS.take_all();
+        if completions.is_empty() {
+            return 0;
+        }
+
+        let mut delivered = 0;
+        for (request_id, result) in completions {
+            // Don't hold the map lock while running callbacks (they may start new calls)
+            let pending = self.pending_async.lock().unwrap().remove(&request_id);
+            match pending {
+                Some(PendingNativeCall::Callback(callback)) => callback(result),
+                Some(PendingNativeCall::Future(slot)) => slot.fulfill(result),
+                None => {
+                    tracing::debug!("Dropping result for unknown native request {}", request_id);
+                    continue;
+                }
+            }
+            delivered += 1;
+        }
+        delivered
+    }
+
     /// Check if a handler is registered (Rust or platform)
     pub fn has_handler(&self, namespace: &str, name: &str) -> bool {
         // Check Rust handlers
@@ -657,6 +838,172 @@ pub fn set_platform_adapter(adapter: Arc<dyn PlatformAdapter>) {
     NativeBridgeState::get().set_platform_adapter(adapter)
 }
 
+/// Start an async native call with a completion callback
+///
+/// Convenience wrapper around `NativeBridgeState::get().call_async_with()`.
+///
+/// # Panics
+///
+/// Panics if `NativeBridgeState::init()` has not been called.
+pub fn native_call_async_with<A, F>(
+    namespace: &str,
+    name: &str,
+    args: A,
+    on_complete: F,
+) -> NativeRequestId
+where
+    A: IntoNativeArgs,
+    F: FnOnce(NativeResult<NativeValue>) + Send + 'static,
+{
+    NativeBridgeState::get().call_async_with(namespace, name, args, on_complete)
+}
+
+/// Start an async native call, returning a future for its result
+///
+/// Convenience wrapper around `NativeBridgeState::get().call_async()`.
+///
+/// # Panics
+///
+/// Panics if `NativeBridgeState::init()` has not been called.
+pub fn native_call_async<A: IntoNativeArgs>(namespace: &str, name: &str, args: A) -> NativeCall {
+    NativeBridgeState::get().call_async(namespace, name, args)
+}
+
+/// Complete an async native call
+///
+/// Safe to call from any thread; the result is pushed onto a lock-free queue
+/// and delivered by the next `drain_native_completions`. Every registered
+/// completion waker is then called so an idle frame loop renders that frame.
+pub fn native_complete(request_id: NativeRequestId, result: NativeResult<NativeValue>) {
+    COMPLETIONS.push((request_id, result));
+    wake_completion_wakers();
+}
+
+/// Deliver completed async native calls (call once per frame)
+///
+/// Returns the number of completions delivered. No-op if the bridge has not
+/// been initialized.
+pub fn drain_native_completions() -> usize {
+    NativeBridgeState::try_get()
+        .map(|state| state.drain_completions())
+        .unwrap_or(0)
+}
+
+/// Check if completed async calls are waiting to be drained
+///
+/// A single atomic load; suitable for the per-vsync "needs render" check.
+pub fn has_pending_native_completions() -> bool {
+    !COMPLETIONS.is_empty()
+}
+
+// ============================================================================
+// Async Completion Plumbing
+// ============================================================================
+
+/// Completed async results waiting for the frame thread
+static COMPLETIONS: MpscQueue<(NativeRequestId, NativeResult<NativeValue>)> = MpscQueue::new();
+
+/// Frame loops to wake when a completion is pushed
+static COMPLETION_WAKERS: RwLock<Vec<(NativeWakerId, NativeCompletionWaker)>> =
+    RwLock::new(Vec::new());
+
+static NEXT_WAKER_ID: AtomicU64 = AtomicU64::new(1);
+
+/// Call `waker` (from any thread) whenever `native_complete` pushes a result
+///
+/// Frame loops that stop ticking while idle register one so completions
+/// resume them. Remove it with `remove_native_completion_waker` when the loop
+/// goes away.
+pub fn add_native_completion_waker(waker: impl Fn() + Send + Sync + 'static) -> NativeWakerId {
+    let id = NEXT_WAKER_ID.fetch_add(1, Ordering::Relaxed);
+    COMPLETION_WAKERS
+        .write()
+        .unwrap()
+        .push((id, Arc::new(waker)));
+    id
+}
+
+/// Remove a waker added with `add_native_completion_waker`
+pub fn remove_native_completion_waker(id: NativeWakerId) {
+    COMPLETION_WAKERS
+        .write()
+        .unwrap()
+        .retain(|(waker_id, _)| *waker_id != id);
+}
+
+/// Call every completion waker without holding the registry lock
+fn wake_completion_wakers() {
+    let wakers: Vec<NativeCompletionWaker> = COMPLETION_WAKERS
+        .read()
+        .unwrap()
+        .iter()
+        .map(|(_, waker)| Arc::clone(waker))
+        .collect();
+    for waker in wakers {
+        waker();
+    }
+}
+
+/// Waiter registered for an in-flight async call
+enum PendingNativeCall {
+    Callback(NativeCompletionCallback),
+    Future(Arc<NativeCallSlot>),
+}
+
+/// Result slot shared between a `NativeCall` future and the bridge
+#[derive(Default)]
+struct NativeCallSlot {
+    state: Mutex<(Option<NativeResult<NativeValue>>, Option<Waker>)>,
+}
+
+impl NativeCallSlot {
+    fn fulfill(&self, result: NativeResult<NativeValue>) {
+        let waker = {
+            let mut state = self.state.lock().unwrap();
+            state.0 = Some(result);
+            state.1.take()
+        };
+        if let Some(waker) = waker {
+            waker.wake();
+        }
+    }
+}
+
+/// Handle to an in-flight async native call
+///
+/// Resolves once the frame loop has drained the call's completion.
+pub struct NativeCall {
+    request_id: NativeRequestId,
+    slot: Arc<NativeCallSlot>,
+}
+
+impl NativeCall {
+    /// The request id passed to the platform
+    pub fn request_id(&self) -> NativeRequestId {
+        self.request_id
+    }
+
+    /// Take the result if the call has completed
+    pub fn try_take(&self) -> Option<NativeResult<NativeValue>> {
+        self.slot.state.lock().unwrap().0.take()
+    }
+}
+
+impl Future for NativeCall {
+    type Output = NativeResult<NativeValue>;
+
+    fn poll(self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<Self::Output> {
+        let mut state = self.slot.state.lock().unwrap();
+        match state.0.take() {
+            Some(result) => Poll::Ready(result),
+            None => {
+                state.1 = Some(cx.waker().clone());
+                Poll::Pending
+            }
+        }
+    }
+}
+
 // ============================================================================
 // JSON Helpers
 // ============================================================================
@@ -739,6 +1086,18 @@ fn extract_json_string<'a>(json: &'a str, key: &str) -> Option<&'a str> {
 mod tests {
     use super::*;
 
+    /// Serializes tests using the process-wide completion queue and wakers
+    ///
+    /// The test runner runs tests in parallel threads, so one test's drain or
+    /// `native_complete` would otherwise show up in another's assertions.
+    static COMPLETION_QUEUE_LOCK: Mutex<()> = Mutex::new(());
+
+    fn lock_completion_queue() -> std::sync::MutexGuard<'static, ()> {
+        COMPLETION_QUEUE_LOCK
+            .lock()
+            .unwrap_or_else(|poisoned| poisoned.into_inner())
+    }
+
     #[test]
     fn test_native_value_accessors() {
         assert_eq!(NativeValue::Bool(true).as_bool(), Some(true));
@@ -780,6 +1139,53 @@ mod tests {
         assert!(bool::from_native_value(NativeValue::Int32(42)).is_err());
     }
 
+    #[test]
+    fn test_call_async_delivers_on_drain() {
+        use std::sync::atomic::AtomicI32;
+
+        let _queue = lock_completion_queue();
+        NativeBridgeState::init();
+        let bridge = NativeBridgeState::get();
+        bridge.register("test_async", "double", |args| {
+            let v = args.first().and_then(|v| v.as_i32()).unwrap_or(0);
+            Ok(NativeValue::Int32(v * 2))
+        });
+
+        let seen = Arc::new(AtomicI32::new(0));
+        let seen_clone = Arc::clone(&seen);
+        bridge.call_async_with("test_async", "double", (21i32,), move |result| {
+            seen_clone.store(result.unwrap().as_i32().unwrap(), Ordering::SeqCst);
+        });
+        let future = bridge.call_async("test_async", "double", (5i32,));
+
+        // Nothing is delivered until the frame loop drains
+        assert_eq!(seen.load(Ordering::SeqCst), 0);
+        assert!(future.try_take().is_none());
+
+        drain_native_completions();
+        assert_eq!(seen.load(Ordering::SeqCst), 42);
+        assert_eq!(future.try_take().unwrap().unwrap().as_i32(), Some(10));
+    }
+
+    #[test]
+    fn test_native_complete_calls_wakers() {
+        use std::sync::atomic::AtomicUsize;
+
+        let _queue = lock_completion_queue();
+        let wakes = Arc::new(AtomicUsize::new(0));
+        let wakes_clone = Arc::clone(&wakes);
+        let id = add_native_completion_waker(move || {
+            wakes_clone.fetch_add(1, Ordering::SeqCst);
+        });
+
+        native_complete(u64::MAX, Ok(NativeValue::Void));
+        assert_eq!(wakes.load(Ordering::SeqCst), 1);
+
+        remove_native_completion_waker(id);
+        native_complete(u64::MAX - 1, Ok(NativeValue::Void));
+        assert_eq!(wakes.load(Ordering::SeqCst), 1);
+    }
+
     #[test]
     fn test_parse_native_result_json() {
         let success = r#"{"success":true,"value":"hello"}"#;
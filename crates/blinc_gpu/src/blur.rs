@@ -0,0 +1,430 @@
+//! Dual-filter blur pyramid
+//!
+//! The Kawase blur in `apply_blur` runs every pass at full resolution, and
+//! the glass shaders take up to 61 backdrop samples per pixel. In
+//! `BlurMode::Performance` blurs instead go through a mip pyramid: each
+//! downsample pass halves the image with a 5-tap filter and each upsample
+//! pass doubles it back with an 8-tap filter (the "dual Kawase" filter), so
+//! the cost is dominated by the first, half resolution level regardless of
+//! the radius.
+//!
+//! Pyramids are kept per base size and reused by every blur of that size, so
+//! several shadows, blurred layers and the glass backdrop in one frame share
+//! the same level textures, uniform buffers and bind groups.
+
+use crate::primitives::BlurUniforms;
+use crate::renderer::LayerTexture;
+
+/// How blur effects and glass backdrops are filtered
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub enum BlurMode {
+    /// Multi-pass Kawase blur at full resolution, glass blurs sampled
+    /// directly from the backdrop
+    #[default]
+    Quality,
+    /// Dual-filter blur over a downsampled pyramid, with the glass backdrop
+    /// prefiltered once per frame (and reused while it is unchanged)
+    Performance,
+}
+
+/// Deepest pyramid built; the smallest level of a 2732px wide frame is then
+/// still ~40px wide
+pub const MAX_PYRAMID_LEVELS: u32 = 6;
+
+/// Pyramids kept for distinct base sizes before the least recently used one
+/// is dropped
+const MAX_CACHED_PYRAMIDS: usize = 4;
+
+/// Pyramid depth and per-level sample offset approximating a `radius` pixel
+/// blur
+///
+/// Each level doubles the filter footprint, so the depth is chosen so that
+/// `2^levels` covers the radius and the offset scales the remainder.
+pub fn pyramid_params(radius: f32) -> (u32, f32) {
+    let levels = (radius.max(1.0).log2().floor() as u32).clamp(1, MAX_PYRAMID_LEVELS);
+    let offset = (radius / (1u32 << levels) as f32).clamp(0.5, 3.0);
+    (levels, offset)
+}
+
+/// Approximate blur radius in pixels produced by `pyramid_params`' output
+pub fn pyramid_radius(levels: u32, offset: f32) -> f32 {
+    offset * (1u32 << levels) as f32
+}
+
+/// Deepest level count for which every level of `base` is at least 2px
+fn max_levels(base: (u32, u32)) -> u32 {
+    let smallest = base.0.min(base.1).max(1);
+    (31 - smallest.leading_zeros())
+        .saturating_sub(1)
+        .min(MAX_PYRAMID_LEVELS)
+}
+
+fn level_size(base: (u32, u32), level: u32) -> (u32, u32) {
+    ((base.0 >> level).max(1), (base.1 >> level).max(1))
+}
+
+/// Pipelines and layout shared by all pyramid passes
+pub(crate) struct DualBlurPipelines<'a> {
+    pub down: &'a wgpu::RenderPipeline,
+    pub up: &'a wgpu::RenderPipeline,
+    /// Upsample writing RGB only, for element blurs that keep their alpha
+    pub up_color: &'a wgpu::RenderPipeline,
+    pub layout: &'a wgpu::BindGroupLayout,
+    pub sampler: &'a wgpu::Sampler,
+}
+
+fn blur_bind_group(
+    device: &wgpu::Device,
+    layout: &wgpu::BindGroupLayout,
+    uniforms: &wgpu::Buffer,
+    input: &wgpu::TextureView,
+    sampler: &wgpu::Sampler,
+) -> wgpu::BindGroup {
+    device.create_bind_group(&wgpu::BindGroupDescriptor {
+        label: Some("Blur Pyramid Bind Group"),
+        layout,
+        entries: &[
+            wgpu::BindGroupEntry {
+                binding: 0,
+                resource: uniforms.as_entire_binding(),
+            },
+            wgpu::BindGroupEntry {
+                binding: 1,
+                resource: wgpu::BindingResource::TextureView(input),
+            },
+            wgpu::BindGroupEntry {
+                binding: 2,
+                resource: wgpu::BindingResource::Sampler(sampler),
+            },
+        ],
+    })
+}
+
+fn blur_pass(
+    encoder: &mut wgpu::CommandEncoder,
+    target: &wgpu::TextureView,
+    load: wgpu::LoadOp<wgpu::Color>,
+    pipeline: &wgpu::RenderPipeline,
+    bind_group: &wgpu::BindGroup,
+) {
+    let mut render_pass = encoder.begin_render_pass(&wgpu::RenderPassDescriptor {
+        label: Some("Blur Pyramid Pass"),
+        color_attachments: &[Some(wgpu::RenderPassColorAttachment {
+            view: target,
+            resolve_target: None,
+            ops: wgpu::Operations {
+                load,
+                store: wgpu::StoreOp::Store,
+            },
+        })],
+        depth_stencil_attachment: None,
+        timestamp_writes: None,
+        occlusion_query_set: None,
+    });
+    render_pass.set_pipeline(pipeline);
+    render_pass.set_bind_group(0, bind_group, &[]);
+    render_pass.draw(0..6, 0..1);
+}
+
+/// One downsampled level (level `n` is `base >> n`, starting at 1)
+struct PyramidLevel {
+    texture: LayerTexture,
+    /// Uniforms of the downsample pass writing this level
+    down_uniforms: wgpu::Buffer,
+    /// Uniforms of the upsample pass reading this level
+    up_uniforms: wgpu::Buffer,
+    /// Downsample bind group reading the previous level (None for level 1,
+    /// whose input is supplied per call)
+    down_bind_group: Option<wgpu::BindGroup>,
+    /// Upsample bind group reading this level
+    up_bind_group: wgpu::BindGroup,
+}
+
+/// Downsampled levels for blurring images of one base size
+pub(crate) struct BlurPyramid {
+    base: (u32, u32),
+    format: wgpu::TextureFormat,
+    levels: Vec<PyramidLevel>,
+    /// Base-size result texture, for blurs the pyramid keeps (glass backdrops)
+    output: Option<LayerTexture>,
+    last_used: u64,
+}
+
+impl BlurPyramid {
+    fn new(base: (u32, u32), format: wgpu::TextureFormat) -> Self {
+        Self {
+            base,
+            format,
+            levels: Vec::new(),
+            output: None,
+            last_used: 0,
+        }
+    }
+
+    /// Number of levels `levels` is clamped to for this base size
+    pub fn clamp_levels(&self, levels: u32) -> u32 {
+        levels.min(max_levels(self.base))
+    }
+
+    fn ensure_levels(&mut self, device: &wgpu::Device, pipelines: &DualBlurPipelines, count: u32) {
+        while (self.levels.len() as u32) < count {
+            let level = self.levels.len() as u32 + 1;
+            let texture =
+                LayerTexture::new(device, level_size(self.base, level), self.format, false);
+            let uniforms = |label: &'static str| {
+                device.create_buffer(&wgpu::BufferDescriptor {
+                    label: Some(label),
+                    size: std::mem::size_of::<BlurUniforms>() as u64,
+                    usage: wgpu::BufferUsages::UNIFORM | wgpu::BufferUsages::COPY_DST,
+                    mapped_at_creation: false,
+                })
+            };
+            let down_uniforms = uniforms("Blur Pyramid Down Uniforms");
+            let up_uniforms = uniforms("Blur Pyramid Up Uniforms");
+            let down_bind_group = self.levels.last().map(|previous| {
+                blur_bind_group(
+                    device,
+                    pipelines.layout,
+                    &down_uniforms,
+                    &previous.texture.view,
+                    pipelines.sampler,
+                )
+            });
+            let up_bind_group = blur_bind_group(
+                device,
+                pipelines.layout,
+                &up_uniforms,
+                &texture.view,
+                pipelines.sampler,
+            );
+            self.levels.push(PyramidLevel {
+                texture,
+                down_uniforms,
+                up_uniforms,
+                down_bind_group,
+                up_bind_group,
+            });
+        }
+    }
+
+    /// The base-size texture `record_into_output` writes to
+    pub fn output(&mut self, device: &wgpu::Device) -> &LayerTexture {
+        let (base, format) = (self.base, self.format);
+        self.output
+            .get_or_insert_with(|| LayerTexture::new(device, base, format, false))
+    }
+
+    /// Record a full RGBA blur of `input` into the pyramid's own output
+    /// texture, which stays valid until the pyramid is dropped
+    #[allow(clippy::too_many_arguments)]
+    pub fn record_into_output(
+        &mut self,
+        device: &wgpu::Device,
+        queue: &wgpu::Queue,
+        encoder: &mut wgpu::CommandEncoder,
+        pipelines: &DualBlurPipelines,
+        input: &wgpu::TextureView,
+        levels: u32,
+        offset: f32,
+    ) -> u32 {
+        self.output(device);
+        let output = self.output.take().unwrap();
+        let draws = self.record(
+            device,
+            queue,
+            encoder,
+            pipelines,
+            input,
+            &output.view,
+            levels,
+            offset,
+            false,
+            false,
+        );
+        self.output = Some(output);
+        draws
+    }
+
+    /// Record a blur of `input` (which must be `base` sized) into `output`
+    ///
+    /// `blur_alpha` selects shadow mode (white RGB, blurred alpha) as in
+    /// `BlurUniforms`. With `keep_alpha` the final pass only writes RGB, so
+    /// the caller must have copied `input` into `output` beforehand.
+    /// Returns the number of draw calls recorded.
+    #[allow(clippy::too_many_arguments)]
+    pub fn record(
+        &mut self,
+        device: &wgpu::Device,
+        queue: &wgpu::Queue,
+        encoder: &mut wgpu::CommandEncoder,
+        pipelines: &DualBlurPipelines,
+        input: &wgpu::TextureView,
+        output: &wgpu::TextureView,
+        levels: u32,
+        offset: f32,
+        blur_alpha: bool,
+        keep_alpha: bool,
+    ) -> u32 {
+        let levels = self.clamp_levels(levels).max(1);
+        self.ensure_levels(device, pipelines, levels);
+
+        let uniforms_for = |size: (u32, u32)| BlurUniforms {
+            texel_size: [1.0 / size.0 as f32, 1.0 / size.1 as f32],
+            radius: offset,
+            iteration: 0,
+            blur_alpha: u32::from(blur_alpha),
+            _pad1: 0.0,
+            _pad2: 0.0,
+            _pad3: 0.0,
+        };
+        for (i, level) in self.levels[..levels as usize].iter().enumerate() {
+            let level_number = i as u32 + 1;
+            let down = uniforms_for(level_size(self.base, level_number - 1));
+            let up = uniforms_for(level_size(self.base, level_number));
+            queue.write_buffer(&level.down_uniforms, 0, bytemuck::bytes_of(&down));
+            queue.write_buffer(&level.up_uniforms, 0, bytemuck::bytes_of(&up));
+        }
+
+        let clear = wgpu::LoadOp::Clear(wgpu::Color::TRANSPARENT);
+
+        // Downsample: input -> 1 -> 2 -> ... -> levels
+        let first = blur_bind_group(
+            device,
+            pipelines.layout,
+            &self.levels[0].down_uniforms,
+            input,
+            pipelines.sampler,
+        );
+        blur_pass(
+            encoder,
+            &self.levels[0].texture.view,
+            clear,
+            pipelines.down,
+            &first,
+        );
+        for level in &self.levels[1..levels as usize] {
+            let bind_group = level.down_bind_group.as_ref().unwrap();
+            blur_pass(
+                encoder,
+                &level.texture.view,
+                clear,
+                pipelines.down,
+                bind_group,
+            );
+        }
+
+        // Upsample: levels -> ... -> 1 -> output
+        for i in (1..levels as usize).rev() {
+            let target = &self.levels[i - 1].texture.view;
+            blur_pass(
+                encoder,
+                target,
+                clear,
+                pipelines.up,
+                &self.levels[i].up_bind_group,
+            );
+        }
+        let (pipeline, load) = if keep_alpha {
+            (pipelines.up_color, wgpu::LoadOp::Load)
+        } else {
+            (pipelines.up, clear)
+        };
+        blur_pass(
+            encoder,
+            output,
+            load,
+            pipeline,
+            &self.levels[0].up_bind_group,
+        );
+
+        levels * 2
+    }
+
+    /// Bytes held by the level and output textures
+    pub fn memory_bytes(&self) -> u64 {
+        let bytes = |(w, h): (u32, u32)| w as u64 * h as u64 * 4;
+        let levels: u64 = self.levels.iter().map(|l| bytes(l.texture.size)).sum();
+        levels + self.output.as_ref().map_or(0, |o| bytes(o.size))
+    }
+}
+
+/// Pyramids by base size, least recently used dropped first
+#[derive(Default)]
+pub(crate) struct BlurPyramids {
+    pyramids: Vec<BlurPyramid>,
+    clock: u64,
+    /// Bumped whenever a pyramid (and so an output texture) is created or
+    /// dropped, letting bind groups over an output detect they are stale
+    generation: u64,
+}
+
+impl BlurPyramids {
+    /// The pyramid for `base`, creating it if needed
+    pub fn get(&mut self, base: (u32, u32), format: wgpu::TextureFormat) -> &mut BlurPyramid {
+        self.clock += 1;
+        let index = match self
+            .pyramids
+            .iter()
+            .position(|p| p.base == base && p.format == format)
+        {
+            Some(index) => index,
+            None => {
+                if self.pyramids.len() >= MAX_CACHED_PYRAMIDS {
+                    let oldest = (0..self.pyramids.len())
+                        .min_by_key(|&i| self.pyramids[i].last_used)
+                        .unwrap();
+                    self.pyramids.swap_remove(oldest);
+                }
+                self.generation += 1;
+                self.pyramids.push(BlurPyramid::new(base, format));
+                self.pyramids.len() - 1
+            }
+        };
+        let pyramid = &mut self.pyramids[index];
+        pyramid.last_used = self.clock;
+        pyramid
+    }
+
+    /// Changes whenever pyramids are created or dropped
+    pub fn generation(&self) -> u64 {
+        self.generation
+    }
+
+    /// Drop every pyramid
+    pub fn clear(&mut self) {
+        if !self.pyramids.is_empty() {
+            self.pyramids.clear();
+            self.generation += 1;
+        }
+    }
+
+    /// Bytes held by all pyramids
+    pub fn memory_bytes(&self) -> u64 {
+        self.pyramids.iter().map(BlurPyramid::memory_bytes).sum()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_pyramid_params_cover_radius() {
+        assert_eq!(pyramid_params(0.0), (1, 0.5));
+        for radius in [2.0, 5.0, 24.0, 64.0] {
+            let (levels, offset) = pyramid_params(radius);
+            assert!((pyramid_radius(levels, offset) - radius).abs() < 0.01);
+        }
+        // Very large radii stop at the deepest level and widen the offset
+        assert_eq!(pyramid_params(10_000.0), (MAX_PYRAMID_LEVELS, 3.0));
+    }
+
+    #[test]
+    fn test_max_levels_keeps_smallest_level_two_pixels() {
+        assert_eq!(max_levels((1, 1)), 0);
+        assert_eq!(max_levels((4, 1000)), 1);
+        assert_eq!(max_levels((64, 64)), 5);
+        assert_eq!(max_levels((2732, 2048)), MAX_PYRAMID_LEVELS);
+        assert_eq!(level_size((100, 7), 2), (25, 1));
+    }
+}
@@ -0,0 +1,146 @@
+//! Shared GPU device
+//!
+//! A `GpuDevice` owns the wgpu instance, adapter, device and queue, and
+//! caches compiled pipelines per texture format and sample count. Several
+//! `GpuRenderer`s created with `GpuRenderer::with_device` (e.g. one per
+//! window or embedded view) then share a single device and its pipelines
+//! instead of each opening their own.
+
+use std::sync::{Arc, Mutex};
+
+use crate::renderer::{GpuRenderer, PipelineSet, RendererConfig, RendererError};
+
+struct GpuDeviceInner {
+    instance: Arc<wgpu::Instance>,
+    adapter: Arc<wgpu::Adapter>,
+    device: Arc<wgpu::Device>,
+    queue: Arc<wgpu::Queue>,
+    pipeline_sets: Mutex<Vec<Arc<PipelineSet>>>,
+}
+
+/// A GPU device shared between renderers
+///
+/// Cloning is cheap and yields a handle to the same device.
+#[derive(Clone)]
+pub struct GpuDevice {
+    inner: Arc<GpuDeviceInner>,
+}
+
+impl GpuDevice {
+    /// Open a device without a surface (for headless rendering)
+    pub async fn new(config: &RendererConfig) -> Result<Self, RendererError> {
+        let instance = wgpu::Instance::new(wgpu::InstanceDescriptor {
+            backends: GpuRenderer::preferred_backends(),
+            ..Default::default()
+        });
+        Self::with_instance(instance, None, config).await
+    }
+
+    /// Open a device on an existing instance
+    ///
+    /// When `surface` is given the adapter is chosen to be compatible with
+    /// it. Surfaces for further renderers should be created from
+    /// `instance()` so they can be presented with this device.
+    pub async fn with_instance(
+        instance: wgpu::Instance,
+        surface: Option<&wgpu::Surface<'_>>,
+        config: &RendererConfig,
+    ) -> Result<Self, RendererError> {
+        let adapter = instance
+            .request_adapter(&wgpu::RequestAdapterOptions {
+                power_preference: wgpu::PowerPreference::HighPerformance,
+                compatible_surface: surface,
+                force_fallback_adapter: false,
+            })
+            .await
+            .ok_or(RendererError::AdapterNotFound)?;
+
+        let (device, queue) = adapter
+            .request_device(
+                &wgpu::DeviceDescriptor {
+                    label: Some("Blinc GPU Device"),
+                    required_features: GpuRenderer::required_features(&adapter, config),
+                    required_limits: wgpu::Limits::default(),
+                    memory_hints: wgpu::MemoryHints::MemoryUsage,
+                },
+                None,
+            )
+            .await
+            .map_err(RendererError::DeviceError)?;
+
+        Ok(Self {
+            inner: Arc::new(GpuDeviceInner {
+                instance: Arc::new(instance),
+                adapter: Arc::new(adapter),
+                device: Arc::new(device),
+                queue: Arc::new(queue),
+                pipeline_sets: Mutex::new(Vec::new()),
+            }),
+        })
+    }
+
+    /// Get the wgpu instance (for creating further surfaces)
+    pub fn instance(&self) -> &wgpu::Instance {
+        &self.inner.instance
+    }
+
+    /// Get the GPU adapter
+    pub fn adapter(&self) -> &wgpu::Adapter {
+        &self.inner.adapter
+    }
+
+    /// Get the wgpu device
+    pub fn device(&self) -> &wgpu::Device {
+        &self.inner.device
+    }
+
+    /// Get the wgpu queue
+    pub fn queue(&self) -> &wgpu::Queue {
+        &self.inner.queue
+    }
+
+    /// Get the wgpu device as Arc
+    pub fn device_arc(&self) -> Arc<wgpu::Device> {
+        self.inner.device.clone()
+    }
+
+    /// Get the wgpu queue as Arc
+    pub fn queue_arc(&self) -> Arc<wgpu::Queue> {
+        self.inner.queue.clone()
+    }
+
+    pub(crate) fn instance_arc(&self) -> Arc<wgpu::Instance> {
+        self.inner.instance.clone()
+    }
+
+    pub(crate) fn adapter_arc(&self) -> Arc<wgpu::Adapter> {
+        self.inner.adapter.clone()
+    }
+
+    /// Get the pipelines for `texture_format`, compiling them on first use
+    ///
+    /// The pipeline cache directory and compile mode of the first renderer
+    /// that asks for a format are used for it.
+    pub(crate) fn pipeline_set(
+        &self,
+        texture_format: wgpu::TextureFormat,
+        config: &RendererConfig,
+    ) -> Arc<PipelineSet> {
+        let mut sets = self.inner.pipeline_sets.lock().unwrap();
+        if let Some(set) = sets
+            .iter()
+            .find(|s| s.texture_format == texture_format && s.sample_count == config.sample_count)
+        {
+            return set.clone();
+        }
+
+        let set = Arc::new(GpuRenderer::create_pipeline_set(
+            &self.inner.device,
+            &self.inner.adapter,
+            texture_format,
+            config,
+        ));
+        sets.push(set.clone());
+        set
+    }
+}
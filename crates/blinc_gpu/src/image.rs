@@ -89,7 +89,7 @@ impl GpuImage {
 /// - `dst_rect`: `vec4<f32>` (16 bytes) - destination rectangle
 /// - `src_uv`: `vec4<f32>` (16 bytes) - source UV coordinates
 /// - `tint`: `vec4<f32>` (16 bytes) - tint color
-/// - `params`: `vec4<f32>` (16 bytes) - border_radius, opacity, padding, padding
+/// - `params`: `vec4<f32>` (16 bytes) - border_radius, opacity, tint_mode, padding
 /// - `clip_bounds`: `vec4<f32>` (16 bytes) - clip region
 /// - `clip_radius`: `vec4<f32>` (16 bytes) - clip corner radii
 /// Total: 96 bytes
@@ -102,7 +102,10 @@ pub struct GpuImageInstance {
     pub src_uv: [f32; 4],
     /// Tint color (RGBA)
     pub tint: [f32; 4],
-    /// Parameters: (border_radius, opacity, padding, padding)
+    /// Parameters: (border_radius, opacity, tint_mode, padding)
+    ///
+    /// `tint_mode` 0 multiplies the texture by `tint`; 1 treats the texture as
+    /// a coverage mask and fills it with `tint` (see `with_mask_tint`).
     pub params: [f32; 4],
     /// Clip bounds (x, y, width, height) - set to large negative x for no clip
     pub clip_bounds: [f32; 4],
@@ -145,6 +148,16 @@ impl GpuImageInstance {
         self
     }
 
+    /// Fill the texture's alpha with a solid tint color
+    ///
+    /// The texture's RGB is ignored, so a single cached raster of a
+    /// monochrome icon can be drawn in any color without re-rasterizing.
+    pub fn with_mask_tint(mut self, r: f32, g: f32, b: f32, a: f32) -> Self {
+        self.tint = [r, g, b, a];
+        self.params[2] = 1.0;
+        self
+    }
+
     /// Set border radius for rounded corners
     pub fn with_border_radius(mut self, radius: f32) -> Self {
         self.params[0] = radius;
@@ -15,16 +15,22 @@
 //! - **Path Rendering**: Vector path tessellation via lyon
 
 pub mod backbuffer;
+mod blur;
+mod device;
 pub mod gradient_texture;
 pub mod image;
 pub mod paint;
 pub mod path;
+mod pipeline_cache;
 pub mod primitives;
 pub mod renderer;
 pub mod shaders;
 pub mod text;
+mod upload;
 
 pub use backbuffer::{Backbuffer, BackbufferConfig, FrameContext};
+pub use blur::BlurMode;
+pub use device::GpuDevice;
 pub use gradient_texture::{GradientTextureCache, RasterizedGradient, GRADIENT_TEXTURE_WIDTH};
 pub use image::{GpuImage, GpuImageInstance, ImageRenderingContext};
 pub use paint::GpuPaintContext;
@@ -36,7 +42,7 @@ pub use primitives::{
     BlurUniforms, ClipType, ColorMatrixUniforms, CompositeUniforms, DropShadowUniforms, FillType,
     GlassType, GlassUniforms, GlowUniforms, GpuGlassPrimitive, GpuGlyph, GpuPrimitive,
     LayerCommand, LayerCommandEntry, LayerCompositeUniforms, PathBatch, PathUniforms,
-    PrimitiveBatch, PrimitiveType, Uniforms,
+    PrimitiveBatch, PrimitiveType, ScrollGroup, ScrollIndicator, Uniforms,
 };
 pub use renderer::{GpuRenderer, LayerTexture, LayerTextureCache, RendererConfig};
 pub use shaders::{
@@ -47,4 +53,6 @@ pub use shaders::{
 pub use text::TextRenderingContext;
 
 // Re-export text types for convenience
-pub use blinc_text::{ColorSpan, FontRegistry, GenericFont, TextAlignment, TextAnchor};
+pub use blinc_text::{
+    AtlasPageStats, ColorSpan, FontRegistry, GenericFont, TextAlignment, TextAnchor,
+};
@@ -51,6 +51,7 @@ use blinc_core::{
 use crate::path::{extract_brush_info, tessellate_fill, tessellate_stroke};
 use crate::primitives::{
     ClipType, FillType, GlassType, GpuGlassPrimitive, GpuPrimitive, PrimitiveBatch, PrimitiveType,
+    ScrollGroup, ScrollIndicator,
 };
 use crate::text::TextRenderingContext;
 
@@ -104,6 +105,29 @@ struct LayerState {
     parent_state_indices: (usize, usize, usize, usize),
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+// Scroll Groups
+// ─────────────────────────────────────────────────────────────────────────────
+
+/// Batch sizes when a scroll container's content began
+///
+/// Compared at `end_scroll_content` to find the content's primitive ranges
+/// and whether it contains anything that can't be moved by translation.
+#[derive(Clone, Copy, Debug)]
+struct OpenScrollGroup {
+    /// Index into `PrimitiveBatch::scroll_groups`
+    group: usize,
+    /// Clip stack depth at begin; deeper clips belong to the content
+    clip_depth: usize,
+    primitive_start: usize,
+    foreground_primitive_start: usize,
+    glass_start: usize,
+    glyph_start: usize,
+    path_start: usize,
+    foreground_path_start: usize,
+    layer_command_start: usize,
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // GPU Paint Context
 // ─────────────────────────────────────────────────────────────────────────────
@@ -137,6 +161,10 @@ pub struct GpuPaintContext<'a> {
     z_layer: u32,
     /// Stack of active layers for offscreen rendering
     layer_stack: Vec<LayerState>,
+    /// Scroll container content currently being drawn (innermost last)
+    scroll_stack: Vec<OpenScrollGroup>,
+    /// Scroll group whose scrollbar is currently being drawn
+    open_indicator: Option<usize>,
 }
 
 impl<'a> GpuPaintContext<'a> {
@@ -155,6 +183,8 @@ impl<'a> GpuPaintContext<'a> {
             is_foreground: false,
             z_layer: 0,
             layer_stack: Vec::new(),
+            scroll_stack: Vec::new(),
+            open_indicator: None,
         }
     }
 
@@ -185,6 +215,8 @@ impl<'a> GpuPaintContext<'a> {
             is_foreground: false,
             z_layer: 0,
             layer_stack: Vec::new(),
+            scroll_stack: Vec::new(),
+            open_indicator: None,
         }
     }
 
@@ -733,6 +765,45 @@ impl<'a> GpuPaintContext<'a> {
         std::mem::take(&mut self.batch)
     }
 
+    /// Add a primitive to the current pass's list
+    fn push_primitive(&mut self, primitive: GpuPrimitive) {
+        // Content clipped by clips of its own can't be moved by translation
+        if let Some(open) = self.scroll_stack.last() {
+            if self.clip_stack.len() > open.clip_depth {
+                self.batch.scroll_groups[open.group].movable = false;
+            }
+        }
+
+        if self.is_foreground {
+            self.batch.push_foreground(primitive);
+        } else {
+            self.batch.push(primitive);
+        }
+    }
+
+    /// Index of the scroll group for container `id`, creating it if needed
+    fn scroll_group_index(&mut self, id: u64) -> usize {
+        match self.batch.scroll_group(id) {
+            Some(group) => group,
+            None => {
+                self.batch.scroll_groups.push(ScrollGroup::new(id));
+                self.batch.scroll_groups.len() - 1
+            }
+        }
+    }
+
+    /// Restore the paint state a scroll indicator was drawn in
+    ///
+    /// Lets a retained batch's scrollbar be redrawn for a new offset on a
+    /// fresh context (see `PrimitiveBatch::replace_scroll_indicator`).
+    pub fn resume_scroll_indicator(&mut self, indicator: &ScrollIndicator) {
+        self.transform_stack = vec![Affine2D::IDENTITY, indicator.transform];
+        self.opacity_stack = vec![indicator.opacity];
+        self.clip_stack = indicator.clip_stack.clone();
+        self.is_foreground = indicator.foreground;
+        self.z_layer = indicator.z_layer;
+    }
+
     /// Get a reference to the current batch
     pub fn batch(&self) -> &PrimitiveBatch {
         &self.batch
@@ -751,6 +822,8 @@ impl<'a> GpuPaintContext<'a> {
         self.blend_mode_stack = vec![BlendMode::Normal];
         self.clip_stack.clear();
         self.layer_stack.clear();
+        self.scroll_stack.clear();
+        self.open_indicator = None;
         self.is_3d = false;
         self.camera = None;
     }
@@ -1223,11 +1296,7 @@ impl<'a> DrawContext for GpuPaintContext<'a> {
             ],
         };
 
-        if self.is_foreground {
-            self.batch.push_foreground(primitive);
-        } else {
-            self.batch.push(primitive);
-        }
+        self.push_primitive(primitive);
     }
 
     fn fill_rect_with_per_side_border(
@@ -1303,11 +1372,7 @@ impl<'a> DrawContext for GpuPaintContext<'a> {
             ],
         };
 
-        if self.is_foreground {
-            self.batch.push_foreground(primitive);
-        } else {
-            self.batch.push(primitive);
-        }
+        self.push_primitive(primitive);
     }
 
     fn stroke_rect(
@@ -1352,11 +1417,7 @@ impl<'a> DrawContext for GpuPaintContext<'a> {
             ],
         };
 
-        if self.is_foreground {
-            self.batch.push_foreground(primitive);
-        } else {
-            self.batch.push(primitive);
-        }
+        self.push_primitive(primitive);
     }
 
     fn fill_circle(&mut self, center: Point, radius: f32, brush: Brush) {
@@ -1422,11 +1483,7 @@ impl<'a> DrawContext for GpuPaintContext<'a> {
             ],
         };
 
-        if self.is_foreground {
-            self.batch.push_foreground(primitive);
-        } else {
-            self.batch.push(primitive);
-        }
+        self.push_primitive(primitive);
     }
 
     fn stroke_circle(&mut self, center: Point, radius: f32, stroke: &Stroke, brush: Brush) {
@@ -1475,11 +1532,7 @@ impl<'a> DrawContext for GpuPaintContext<'a> {
             ],
         };
 
-        if self.is_foreground {
-            self.batch.push_foreground(primitive);
-        } else {
-            self.batch.push(primitive);
-        }
+        self.push_primitive(primitive);
     }
 
     fn draw_text(&mut self, text: &str, origin: Point, style: &TextStyle) {
@@ -1596,11 +1649,7 @@ impl<'a> DrawContext for GpuPaintContext<'a> {
             ],
         };
 
-        if self.is_foreground {
-            self.batch.push_foreground(primitive);
-        } else {
-            self.batch.push(primitive);
-        }
+        self.push_primitive(primitive);
     }
 
     fn draw_inner_shadow(&mut self, rect: Rect, corner_radius: CornerRadius, shadow: Shadow) {
@@ -1644,11 +1693,7 @@ impl<'a> DrawContext for GpuPaintContext<'a> {
             ],
         };
 
-        if self.is_foreground {
-            self.batch.push_foreground(primitive);
-        } else {
-            self.batch.push(primitive);
-        }
+        self.push_primitive(primitive);
     }
 
     fn draw_circle_shadow(&mut self, center: Point, radius: f32, shadow: Shadow) {
@@ -1688,11 +1733,7 @@ impl<'a> DrawContext for GpuPaintContext<'a> {
             ],
         };
 
-        if self.is_foreground {
-            self.batch.push_foreground(primitive);
-        } else {
-            self.batch.push(primitive);
-        }
+        self.push_primitive(primitive);
     }
 
     fn draw_circle_inner_shadow(&mut self, center: Point, radius: f32, shadow: Shadow) {
@@ -1731,11 +1772,7 @@ impl<'a> DrawContext for GpuPaintContext<'a> {
             ],
         };
 
-        if self.is_foreground {
-            self.batch.push_foreground(primitive);
-        } else {
-            self.batch.push(primitive);
-        }
+        self.push_primitive(primitive);
     }
 
     fn sdf_build(&mut self, f: &mut dyn FnMut(&mut dyn SdfBuilder)) {
@@ -1866,6 +1903,87 @@ impl<'a> DrawContext for GpuPaintContext<'a> {
             });
     }
 
+    fn begin_scroll_content(&mut self, id: u64) {
+        // Moving the outer content would leave the inner viewport behind
+        if let Some(parent) = self.scroll_stack.last() {
+            self.batch.scroll_groups[parent.group].movable = false;
+        }
+
+        let group = self.scroll_group_index(id);
+        self.scroll_stack.push(OpenScrollGroup {
+            group,
+            clip_depth: self.clip_stack.len(),
+            primitive_start: self.batch.primitives.len(),
+            foreground_primitive_start: self.batch.foreground_primitives.len(),
+            glass_start: self.batch.glass_primitives.len(),
+            glyph_start: self.batch.glyphs.len(),
+            path_start: self.batch.paths.vertices.len(),
+            foreground_path_start: self.batch.foreground_paths.vertices.len(),
+            layer_command_start: self.batch.layer_commands.len(),
+        });
+    }
+
+    fn end_scroll_content(&mut self) {
+        let Some(open) = self.scroll_stack.pop() else {
+            return;
+        };
+
+        let batch = &mut self.batch;
+        let primitive_end = batch.primitives.len();
+        let foreground_primitive_end = batch.foreground_primitives.len();
+        let unmovable = batch.glass_primitives.len() > open.glass_start
+            || batch.glyphs.len() > open.glyph_start
+            || batch.paths.vertices.len() > open.path_start
+            || batch.foreground_paths.vertices.len() > open.foreground_path_start
+            || batch.layer_commands.len() > open.layer_command_start;
+
+        let group = &mut batch.scroll_groups[open.group];
+        if unmovable {
+            group.movable = false;
+        }
+        if primitive_end > open.primitive_start {
+            group.ranges.push(open.primitive_start..primitive_end);
+        }
+        if foreground_primitive_end > open.foreground_primitive_start {
+            group
+                .foreground_ranges
+                .push(open.foreground_primitive_start..foreground_primitive_end);
+        }
+    }
+
+    fn begin_scroll_indicator(&mut self, id: u64) {
+        let group = self.scroll_group_index(id);
+        let foreground = self.is_foreground;
+        let start = if foreground {
+            self.batch.foreground_primitives.len()
+        } else {
+            self.batch.primitives.len()
+        };
+        self.batch.scroll_groups[group].indicator = Some(ScrollIndicator {
+            foreground,
+            range: start..start,
+            transform: self.current_affine(),
+            clip_stack: self.clip_stack.clone(),
+            opacity: self.combined_opacity(),
+            z_layer: self.z_layer,
+        });
+        self.open_indicator = Some(group);
+    }
+
+    fn end_scroll_indicator(&mut self) {
+        let Some(group) = self.open_indicator.take() else {
+            return;
+        };
+        let end = if self.is_foreground {
+            self.batch.foreground_primitives.len()
+        } else {
+            self.batch.primitives.len()
+        };
+        if let Some(indicator) = &mut self.batch.scroll_groups[group].indicator {
+            indicator.range.end = end;
+        }
+    }
+
     fn viewport_size(&self) -> Size {
         self.viewport
     }
@@ -2172,6 +2290,7 @@ mod tests {
             opacity: 0.5,
             depth: false,
             effects: Vec::new(),
+            retained: false,
         };
         ctx.push_layer(config);
 
@@ -2210,6 +2329,7 @@ mod tests {
             opacity: 0.8,
             depth: false,
             effects: Vec::new(),
+            retained: false,
         };
         ctx.push_layer(config1);
         assert_eq!(ctx.layer_stack.len(), 1);
@@ -2224,6 +2344,7 @@ mod tests {
             opacity: 0.5,
             depth: false,
             effects: Vec::new(),
+            retained: false,
         };
         ctx.push_layer(config2);
         assert_eq!(ctx.layer_stack.len(), 2);
@@ -2241,4 +2362,41 @@ mod tests {
         assert_eq!(ctx.layer_stack.len(), 0);
         assert_eq!(ctx.current_opacity(), 1.0);
     }
+
+    #[test]
+    fn test_scroll_group_translates_content() {
+        let mut ctx = GpuPaintContext::new(800.0, 600.0);
+        ctx.push_clip(ClipShape::rect(Rect::new(0.0, 0.0, 200.0, 200.0)));
+        ctx.begin_scroll_content(7);
+        ctx.fill_rect(
+            Rect::new(10.0, 20.0, 100.0, 50.0),
+            0.0.into(),
+            Color::BLUE.into(),
+        );
+        ctx.end_scroll_content();
+        ctx.pop_clip();
+
+        let mut batch = ctx.take_batch();
+        let group = batch.scroll_group(7).unwrap();
+        assert!(batch.scroll_groups[group].movable);
+        batch.translate_scroll_group(group, 0.0, -15.0);
+        assert_eq!(batch.primitives[0].bounds, [10.0, 5.0, 100.0, 50.0]);
+        assert_eq!(batch.primitives[0].clip_bounds, [0.0, 0.0, 200.0, 200.0]);
+    }
+
+    #[test]
+    fn test_clipped_scroll_content_is_not_movable() {
+        let mut ctx = GpuPaintContext::new(800.0, 600.0);
+        ctx.begin_scroll_content(7);
+        ctx.push_clip(ClipShape::rect(Rect::new(0.0, 0.0, 50.0, 50.0)));
+        ctx.fill_rect(
+            Rect::new(10.0, 20.0, 100.0, 50.0),
+            0.0.into(),
+            Color::BLUE.into(),
+        );
+        ctx.pop_clip();
+        ctx.end_scroll_content();
+
+        assert!(!ctx.batch().scroll_groups[0].movable);
+    }
 }
@@ -0,0 +1,181 @@
+//! Persistent pipeline cache
+//!
+//! Wraps `wgpu::PipelineCache` with a file on disk so driver-compiled
+//! pipelines survive process restarts. The file name encodes the adapter
+//! (via `wgpu::util::pipeline_cache_key`) plus a hash of every shader source,
+//! the target format and the driver version, so a shader change or driver
+//! update starts from an empty cache and stale files are removed.
+//!
+//! Only backends exposing `Features::PIPELINE_CACHE` (currently Vulkan)
+//! persist anything; elsewhere `open` returns `None` and pipelines are
+//! compiled without a cache.
+
+use std::path::{Path, PathBuf};
+
+use crate::shaders::{
+    BLUR_SHADER, COLOR_MATRIX_SHADER, COMPOSITE_SHADER, DROP_SHADOW_SHADER, GLASS_SHADER,
+    GLOW_SHADER, IMAGE_SHADER, LAYER_COMPOSITE_SHADER, PATH_SHADER, SDF_SHADER,
+    SIMPLE_GLASS_SHADER, TEXT_SHADER,
+};
+
+/// File name prefix shared by all cache files Blinc writes
+const CACHE_FILE_PREFIX: &str = "blinc-pipelines-";
+
+/// A `wgpu::PipelineCache` backed by a file in the cache directory
+pub(crate) struct PersistentPipelineCache {
+    cache: wgpu::PipelineCache,
+    path: PathBuf,
+}
+
+impl PersistentPipelineCache {
+    /// Open (or create) the cache file for this adapter in `dir`
+    ///
+    /// Returns `None` if the device was created without
+    /// `Features::PIPELINE_CACHE` or the directory is unusable.
+    pub(crate) fn open(
+        device: &wgpu::Device,
+        adapter: &wgpu::Adapter,
+        dir: &Path,
+        texture_format: wgpu::TextureFormat,
+    ) -> Option<Self> {
+        if !device.features().contains(wgpu::Features::PIPELINE_CACHE) {
+            return None;
+        }
+
+        let info = adapter.get_info();
+        let adapter_key = wgpu::util::pipeline_cache_key(&info)?;
+
+        if let Err(e) = std::fs::create_dir_all(dir) {
+            tracing::warn!("Pipeline cache directory {:?} unusable: {}", dir, e);
+            return None;
+        }
+
+        let hash = cache_hash(&info, texture_format);
+        let path = dir.join(format!("{CACHE_FILE_PREFIX}{adapter_key}-{hash:016x}.bin"));
+        let data = std::fs::read(&path).ok();
+
+        // Safety: the data was produced by `PipelineCache::get_data` for an
+        // adapter with the same cache key. wgpu validates the header and, with
+        // `fallback: true`, replaces anything it rejects with an empty cache.
+        let cache = unsafe {
+            device.create_pipeline_cache(&wgpu::PipelineCacheDescriptor {
+                label: Some("Blinc Pipeline Cache"),
+                data: data.as_deref(),
+                fallback: true,
+            })
+        };
+
+        tracing::debug!(
+            "Pipeline cache {:?} ({} bytes loaded)",
+            path,
+            data.as_ref().map_or(0, |d| d.len())
+        );
+
+        remove_stale_files(dir, &path);
+
+        Some(Self { cache, path })
+    }
+
+    /// The underlying wgpu cache, for pipeline descriptors
+    pub(crate) fn cache(&self) -> &wgpu::PipelineCache {
+        &self.cache
+    }
+
+    /// Write the current cache contents to disk
+    ///
+    /// Writes to a temporary file first so a crash mid-write never leaves a
+    /// truncated cache behind.
+    pub(crate) fn save(&self) {
+        let Some(data) = self.cache.get_data() else {
+            return;
+        };
+
+        let tmp = self.path.with_extension("tmp");
+        let result = std::fs::write(&tmp, &data).and_then(|_| std::fs::rename(&tmp, &self.path));
+        match result {
+            Ok(()) => tracing::debug!("Saved {} bytes of pipeline cache", data.len()),
+            Err(e) => tracing::warn!("Failed to save pipeline cache {:?}: {}", self.path, e),
+        }
+    }
+}
+
+/// Stable hash of everything that invalidates compiled pipelines
+fn cache_hash(info: &wgpu::AdapterInfo, texture_format: wgpu::TextureFormat) -> u64 {
+    let mut hash = Fnv1a::new();
+    for source in [
+        SDF_SHADER,
+        GLASS_SHADER,
+        SIMPLE_GLASS_SHADER,
+        TEXT_SHADER,
+        COMPOSITE_SHADER,
+        PATH_SHADER,
+        LAYER_COMPOSITE_SHADER,
+        BLUR_SHADER,
+        COLOR_MATRIX_SHADER,
+        DROP_SHADOW_SHADER,
+        GLOW_SHADER,
+        IMAGE_SHADER,
+    ] {
+        hash.write(source.as_bytes());
+        hash.write(&[0]);
+    }
+    hash.write(format!("{texture_format:?}").as_bytes());
+    hash.write(info.driver.as_bytes());
+    hash.write(&[0]);
+    hash.write(info.driver_info.as_bytes());
+    hash.finish()
+}
+
+/// Delete cache files from previous shader or driver versions
+fn remove_stale_files(dir: &Path, current: &Path) {
+    let Ok(entries) = std::fs::read_dir(dir) else {
+        return;
+    };
+    for entry in entries.flatten() {
+        let path = entry.path();
+        let is_ours = path
+            .file_name()
+            .and_then(|n| n.to_str())
+            .is_some_and(|n| n.starts_with(CACHE_FILE_PREFIX));
+        if is_ours && path != current {
+            let _ = std::fs::remove_file(&path);
+        }
+    }
+}
+
+/// FNV-1a, used instead of `DefaultHasher` so file names are stable across
+/// Rust releases
+struct Fnv1a(u64);
+
+impl Fnv1a {
+    fn new() -> Self {
+        Self(0xcbf2_9ce4_8422_2325)
+    }
+
+    fn write(&mut self, bytes: &[u8]) {
+        for &b in bytes {
+            self.0 ^= b as u64;
+            self.0 = self.0.wrapping_mul(0x0000_0100_0000_01b3);
+        }
+    }
+
+    fn finish(&self) -> u64 {
+        self.0
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_fnv1a_known_vectors() {
+        let mut h = Fnv1a::new();
+        h.write(b"");
+        assert_eq!(h.finish(), 0xcbf2_9ce4_8422_2325);
+
+        let mut h = Fnv1a::new();
+        h.write(b"a");
+        assert_eq!(h.finish(), 0xaf63_dc4c_8601_ec8c);
+    }
+}
@@ -4,6 +4,10 @@
 //! All structures use `#[repr(C)]` and implement `bytemuck::Pod` for safe
 //! GPU buffer copies.
 
+use std::ops::Range;
+
+use blinc_core::{Affine2D, ClipShape};
+
 /// Primitive types (must match shader constants)
 #[repr(u32)]
 #[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
@@ -298,7 +302,9 @@ impl GpuPrimitive {
     /// in the same pass as shapes, enabling proper z-ordering.
     ///
     /// The glyph's UV bounds are stored in `gradient_params` and the color in `color`.
-    /// For color emoji, `flags[0]` is 1.0 (stored in `type_info[1]`).
+    /// For color emoji, `flags[0]` is 1.0 (stored in `type_info[1]`). The atlas
+    /// page and SDF spread (`flags[1]`, `flags[2]`) go in `color2`, which text
+    /// doesn't otherwise use.
     pub fn from_glyph(glyph: &GpuGlyph) -> Self {
         // Use type_info[1] to store is_color flag (1 = color emoji, 0 = grayscale)
         let is_color_flag = if glyph.flags[0] > 0.5 { 1u32 } else { 0u32 };
@@ -306,15 +312,15 @@ impl GpuPrimitive {
             bounds: glyph.bounds,
             corner_radius: [0.0; 4],
             color: glyph.color,
-            color2: [0.0; 4],
+            color2: [glyph.flags[1], glyph.flags[2], 0.0, 0.0],
             border: [0.0; 4],
             border_color: [0.0; 4],
             shadow: [0.0; 4],
             shadow_color: [0.0; 4],
             clip_bounds: glyph.clip_bounds,
             clip_radius: [0.0; 4],
-            // Store UV bounds (u_min, v_min, u_max, v_max) in gradient_params
-            gradient_params: glyph.uv_bounds,
+            // Store texel bounds (x_min, y_min, x_max, y_max) in gradient_params
+            gradient_params: glyph.texel_bounds,
             type_info: [
                 PrimitiveType::Text as u32,
                 is_color_flag,
@@ -664,7 +670,7 @@ impl From<&blinc_layout::GlassPanel> for GpuGlassPrimitive {
 ///
 /// Memory layout:
 /// - bounds: `vec4<f32>`       (16 bytes) - position and size
-/// - uv_bounds: `vec4<f32>`    (16 bytes) - UV coordinates in atlas
+/// - texel_bounds: `vec4<f32>` (16 bytes) - texel coordinates in atlas
 /// - color: `vec4<f32>`        (16 bytes) - text color
 /// - clip_bounds: `vec4<f32>`  (16 bytes) - clip region (x, y, width, height)
 /// Total: 80 bytes
@@ -673,14 +679,17 @@ impl From<&blinc_layout::GlassPanel> for GpuGlassPrimitive {
 pub struct GpuGlyph {
     /// Position and size (x, y, width, height)
     pub bounds: [f32; 4],
-    /// UV coordinates in atlas (u_min, v_min, u_max, v_max)
-    pub uv_bounds: [f32; 4],
+    /// Texel coordinates in the atlas page (x_min, y_min, x_max, y_max),
+    /// normalized by the shaders against the bound atlas texture
+    pub texel_bounds: [f32; 4],
     /// Text color (RGBA)
     pub color: [f32; 4],
     /// Clip bounds (x, y, width, height) - set to large values for no clip
     pub clip_bounds: [f32; 4],
-    /// Flags: [is_color, unused, unused, unused]
+    /// Flags: [is_color, atlas_page, sdf_spread, unused]
     /// is_color: 1.0 for color emoji (use color atlas), 0.0 for grayscale (use main atlas)
+    /// atlas_page: layer of the atlas texture array holding the glyph
+    /// sdf_spread: distance encoded per side (texels) for SDF glyphs, 0.0 for bitmaps
     pub flags: [f32; 4],
 }
 
@@ -688,7 +697,7 @@ impl Default for GpuGlyph {
     fn default() -> Self {
         Self {
             bounds: [0.0; 4],
-            uv_bounds: [0.0, 0.0, 1.0, 1.0],
+            texel_bounds: [0.0; 4],
             color: [0.0, 0.0, 0.0, 1.0],
             // Default: no clip (large bounds that won't clip anything)
             clip_bounds: [-10000.0, -10000.0, 100000.0, 100000.0],
@@ -725,7 +734,9 @@ pub struct Uniforms {
 pub struct GlassUniforms {
     pub viewport_size: [f32; 2],
     pub time: f32,
-    pub _padding: f32,
+    /// Blur already applied to the backdrop texture (viewport pixels), which
+    /// the glass shaders subtract from each primitive's blur radius
+    pub backdrop_blur: f32,
 }
 
 /// Uniform buffer for compositor
@@ -1123,7 +1134,64 @@ pub struct LayerCommandEntry {
     pub command: LayerCommand,
 }
 
+/// A scroll container's content within a batch
+///
+/// Recorded between `DrawContext::begin_scroll_content` and
+/// `end_scroll_content`, so a retained batch can follow a new scroll offset by
+/// translating these primitives instead of walking the tree again. A
+/// container is drawn once per rendering pass, so its content can span
+/// several ranges.
+#[derive(Clone, Debug)]
+pub struct ScrollGroup {
+    /// Container id passed to `begin_scroll_content`
+    pub id: u64,
+    /// Ranges of `PrimitiveBatch::primitives`
+    pub ranges: Vec<Range<usize>>,
+    /// Ranges of `PrimitiveBatch::foreground_primitives`
+    pub foreground_ranges: Vec<Range<usize>>,
+    /// Whether translating the ranges is enough to move the content
+    ///
+    /// False if the content contains anything that can't simply be offset:
+    /// glass, tessellated paths, glyphs, offscreen layers, nested scroll
+    /// containers or clips of its own.
+    pub movable: bool,
+    /// The container's scrollbar, if one was drawn
+    pub indicator: Option<ScrollIndicator>,
+}
+
+impl ScrollGroup {
+    /// An empty, movable group for container `id`
+    pub fn new(id: u64) -> Self {
+        Self {
+            id,
+            ranges: Vec::new(),
+            foreground_ranges: Vec::new(),
+            movable: true,
+            indicator: None,
+        }
+    }
+}
+
+/// Scrollbar primitives of a scroll group, with the paint state they were
+/// drawn in so they can be redrawn for a new offset
+#[derive(Clone, Debug)]
+pub struct ScrollIndicator {
+    /// Whether the primitives are in the foreground list
+    pub foreground: bool,
+    /// Range of the primitive list
+    pub range: Range<usize>,
+    /// Transform at `begin_scroll_indicator`
+    pub transform: Affine2D,
+    /// Clip stack (screen space) at `begin_scroll_indicator`
+    pub clip_stack: Vec<ClipShape>,
+    /// Combined opacity at `begin_scroll_indicator`
+    pub opacity: f32,
+    /// Z-layer at `begin_scroll_indicator`
+    pub z_layer: u32,
+}
+
 /// Batch of GPU primitives for efficient rendering
+#[derive(Clone)]
 pub struct PrimitiveBatch {
     /// Background primitives (rendered before glass)
     pub primitives: Vec<GpuPrimitive>,
@@ -1137,6 +1205,8 @@ pub struct PrimitiveBatch {
     pub foreground_paths: PathBatch,
     /// Layer commands for offscreen rendering and composition
     pub layer_commands: Vec<LayerCommandEntry>,
+    /// Scroll container content, for moving it without re-recording
+    pub scroll_groups: Vec<ScrollGroup>,
 }
 
 impl PrimitiveBatch {
@@ -1149,6 +1219,7 @@ impl PrimitiveBatch {
             paths: PathBatch::default(),
             foreground_paths: PathBatch::default(),
             layer_commands: Vec::new(),
+            scroll_groups: Vec::new(),
         }
     }
 
@@ -1160,6 +1231,7 @@ impl PrimitiveBatch {
         self.paths = PathBatch::default();
         self.foreground_paths = PathBatch::default();
         self.layer_commands.clear();
+        self.scroll_groups.clear();
     }
 
     /// Record a layer command at the current primitive index
@@ -1186,6 +1258,33 @@ impl PrimitiveBatch {
         })
     }
 
+    /// Check if there are any retained layers (see `LayerConfig::retained`)
+    pub fn has_retained_layers(&self) -> bool {
+        self.layer_commands
+            .iter()
+            .any(|entry| matches!(&entry.command, LayerCommand::Push { config } if config.retained))
+    }
+
+    /// Primitive index ranges (`start..end`) of every retained layer
+    pub fn retained_layer_ranges(&self) -> Vec<std::ops::Range<usize>> {
+        let mut ranges = Vec::new();
+        let mut stack = Vec::new();
+        for entry in &self.layer_commands {
+            match &entry.command {
+                LayerCommand::Push { config } => {
+                    stack.push((entry.primitive_index, config.retained))
+                }
+                LayerCommand::Pop => {
+                    if let Some((start, true)) = stack.pop() {
+                        ranges.push(start..entry.primitive_index);
+                    }
+                }
+                LayerCommand::Sample { .. } => {}
+            }
+        }
+        ranges
+    }
+
     pub fn push(&mut self, primitive: GpuPrimitive) {
         self.primitives.push(primitive);
     }
@@ -1476,8 +1575,10 @@ impl PrimitiveBatch {
     ///
     /// Useful for combining batches from different paint contexts.
     pub fn merge(&mut self, other: PrimitiveBatch) {
-        // Record the current primitive count for offsetting layer commands
+        // Record the current primitive counts for offsetting layer commands
+        // and scroll groups
         let primitive_offset = self.primitives.len();
+        let fg_primitive_offset = self.foreground_primitives.len();
 
         self.primitives.extend(other.primitives);
         self.foreground_primitives
@@ -1510,6 +1611,89 @@ impl PrimitiveBatch {
             entry.primitive_index += primitive_offset;
             self.layer_commands.push(entry);
         }
+
+        // Merge scroll groups with offset ranges
+        let shift = |r: &mut Range<usize>, offset: usize| *r = r.start + offset..r.end + offset;
+        for mut group in other.scroll_groups {
+            for range in &mut group.ranges {
+                shift(range, primitive_offset);
+            }
+            for range in &mut group.foreground_ranges {
+                shift(range, fg_primitive_offset);
+            }
+            if let Some(indicator) = &mut group.indicator {
+                let offset = if indicator.foreground {
+                    fg_primitive_offset
+                } else {
+                    primitive_offset
+                };
+                shift(&mut indicator.range, offset);
+            }
+            self.scroll_groups.push(group);
+        }
+    }
+
+    /// Index of the scroll group recorded for container `id`
+    pub fn scroll_group(&self, id: u64) -> Option<usize> {
+        self.scroll_groups.iter().position(|g| g.id == id)
+    }
+
+    /// Move a scroll group's content by `(dx, dy)` physical pixels
+    ///
+    /// Only valid for movable groups: clips stay at the container's viewport
+    /// and shadows and radii are relative, so offsetting bounds and gradient
+    /// coordinates moves the content exactly.
+    pub fn translate_scroll_group(&mut self, group: usize, dx: f32, dy: f32) {
+        let group = &self.scroll_groups[group];
+        let background = group.ranges.iter().flat_map(|r| r.clone());
+        let foreground = group.foreground_ranges.iter().flat_map(|r| r.clone());
+        for i in background {
+            translate_primitive(&mut self.primitives[i], dx, dy);
+        }
+        for i in foreground {
+            translate_primitive(&mut self.foreground_primitives[i], dx, dy);
+        }
+    }
+
+    /// Replace a scroll group's scrollbar primitives with a redrawn set
+    ///
+    /// Returns false (leaving the batch untouched) if the group has no
+    /// scrollbar or the redraw produced a different number of primitives,
+    /// since other ranges would shift.
+    pub fn replace_scroll_indicator(&mut self, group: usize, primitives: &[GpuPrimitive]) -> bool {
+        let Some(indicator) = &self.scroll_groups[group].indicator else {
+            return false;
+        };
+        if indicator.range.len() != primitives.len() {
+            return false;
+        }
+        let list = if indicator.foreground {
+            &mut self.foreground_primitives
+        } else {
+            &mut self.primitives
+        };
+        list[indicator.range.clone()].copy_from_slice(primitives);
+        true
+    }
+}
+
+/// Offset a primitive's absolute coordinates
+fn translate_primitive(primitive: &mut GpuPrimitive, dx: f32, dy: f32) {
+    primitive.bounds[0] += dx;
+    primitive.bounds[1] += dy;
+    // Linear: (x1, y1, x2, y2), radial: (cx, cy, r, 0)
+    match primitive.type_info[1] {
+        t if t == FillType::LinearGradient as u32 => {
+            primitive.gradient_params[0] += dx;
+            primitive.gradient_params[1] += dy;
+            primitive.gradient_params[2] += dx;
+            primitive.gradient_params[3] += dy;
+        }
+        t if t == FillType::RadialGradient as u32 => {
+            primitive.gradient_params[0] += dx;
+            primitive.gradient_params[1] += dy;
+        }
+        _ => {}
     }
 }
 
@@ -3,13 +3,16 @@
 //! The main renderer that manages wgpu resources and executes render passes
 //! for SDF primitives, glass effects, and text.
 
-use std::sync::Arc;
+use std::sync::{Arc, Mutex, OnceLock};
 
 use wgpu::util::DeviceExt;
 
+use crate::blur::{self, BlurMode, BlurPyramids, DualBlurPipelines};
+use crate::device::GpuDevice;
 use crate::gradient_texture::GradientTextureCache;
 use crate::image::GpuImageInstance;
 use crate::path::PathVertex;
+use crate::pipeline_cache::PersistentPipelineCache;
 use crate::primitives::{
     BlurUniforms, ColorMatrixUniforms, DropShadowUniforms, GlassType, GlassUniforms, GlowUniforms,
     GpuGlassPrimitive, GpuGlyph, GpuPrimitive, PathUniforms, PrimitiveBatch, Uniforms,
@@ -19,6 +22,7 @@ use crate::shaders::{
     GLOW_SHADER, IMAGE_SHADER, LAYER_COMPOSITE_SHADER, PATH_SHADER, SDF_SHADER,
     SIMPLE_GLASS_SHADER, TEXT_SHADER,
 };
+use crate::upload::UploadBuffer;
 
 /// Error type for renderer operations
 #[derive(Debug)]
@@ -68,6 +72,29 @@ pub struct RendererConfig {
     ///
     /// Default: true (unified rendering for consistent animations)
     pub unified_text_rendering: bool,
+    /// Directory for the persistent pipeline cache (None = no cache)
+    ///
+    /// Compiled pipelines are stored here and reloaded on the next launch.
+    /// Files are keyed by adapter, driver version and shader hash, so stale
+    /// entries are discarded automatically. Only takes effect on backends that
+    /// support `wgpu::Features::PIPELINE_CACHE` (currently Vulkan).
+    pub pipeline_cache_dir: Option<std::path::PathBuf>,
+    /// Compile glass and effect pipelines on a background thread
+    ///
+    /// When enabled, init only waits for the pipelines a plain frame needs.
+    /// The first frame that uses glass, blur, shadows or glow blocks until the
+    /// background compile finishes.
+    ///
+    /// Default: true
+    pub background_pipeline_compilation: bool,
+    /// How blur effects and glass backdrops are filtered
+    ///
+    /// `BlurMode::Performance` trades some filter accuracy for a much
+    /// cheaper downsampled blur, and is worth enabling on high-density
+    /// mobile displays. Can be changed later with `set_blur_mode`.
+    ///
+    /// Default: `BlurMode::Quality`
+    pub blur_mode: BlurMode,
 }
 
 impl Default for RendererConfig {
@@ -81,6 +108,9 @@ impl Default for RendererConfig {
             sample_count: 1,
             texture_format: None,
             unified_text_rendering: true, // Enabled for consistent transforms during animations
+            pipeline_cache_dir: None,
+            background_pipeline_compilation: true,
+            blur_mode: BlurMode::Quality,
         }
     }
 }
@@ -91,10 +121,6 @@ struct Pipelines {
     sdf: wgpu::RenderPipeline,
     /// Pipeline for SDF primitives rendering on top of existing content (1x sampled)
     sdf_overlay: wgpu::RenderPipeline,
-    /// Pipeline for glass/vibrancy effects (liquid glass with refraction)
-    glass: wgpu::RenderPipeline,
-    /// Pipeline for simple frosted glass (pure blur, no refraction)
-    simple_glass: wgpu::RenderPipeline,
     /// Pipeline for text rendering (MSAA)
     #[allow(dead_code)]
     text: wgpu::RenderPipeline,
@@ -111,8 +137,21 @@ struct Pipelines {
     path_overlay: wgpu::RenderPipeline,
     /// Pipeline for layer composition (blend modes)
     layer_composite: wgpu::RenderPipeline,
+}
+
+/// Glass and post-processing pipelines, compiled off the init path
+struct EffectPipelines {
+    /// Pipeline for glass/vibrancy effects (liquid glass with refraction)
+    glass: wgpu::RenderPipeline,
+    /// Pipeline for simple frosted glass (pure blur, no refraction)
+    simple_glass: wgpu::RenderPipeline,
     /// Pipeline for Kawase blur effect
     blur: wgpu::RenderPipeline,
+    /// Pipelines for the dual-filter pyramid (downsample, upsample, and
+    /// upsample writing RGB only)
+    blur_down: wgpu::RenderPipeline,
+    blur_up: wgpu::RenderPipeline,
+    blur_up_color: wgpu::RenderPipeline,
     /// Pipeline for color matrix transformation
     color_matrix: wgpu::RenderPipeline,
     /// Pipeline for drop shadow effect
@@ -121,6 +160,65 @@ struct Pipelines {
     glow: wgpu::RenderPipeline,
 }
 
+/// Compiles the effect pipelines (and saves the pipeline cache)
+type CompileEffectPipelines = Arc<dyn Fn() -> EffectPipelines + Send + Sync>;
+
+/// Effect pipelines that may still be compiling on a background thread
+///
+/// The first frame that needs glass or an effect joins the compile thread;
+/// frames that don't never wait for it.
+struct DeferredEffectPipelines {
+    ready: OnceLock<Arc<EffectPipelines>>,
+    pending: Mutex<Option<std::thread::JoinHandle<EffectPipelines>>>,
+    /// Used on the calling thread if the compile thread panicked
+    compile: CompileEffectPipelines,
+}
+
+impl DeferredEffectPipelines {
+    /// Compile the pipelines now
+    fn ready(compile: CompileEffectPipelines) -> Self {
+        Self {
+            ready: OnceLock::from(Arc::new(compile())),
+            pending: Mutex::new(None),
+            compile,
+        }
+    }
+
+    fn pending(
+        handle: std::thread::JoinHandle<EffectPipelines>,
+        compile: CompileEffectPipelines,
+    ) -> Self {
+        Self {
+            ready: OnceLock::new(),
+            pending: Mutex::new(Some(handle)),
+            compile,
+        }
+    }
+
+    /// Get the pipelines, blocking until the compile thread finishes
+    ///
+    /// If the compile thread panicked, the pipelines are compiled on the
+    /// calling thread instead.
+    fn get(&self) -> Arc<EffectPipelines> {
+        self.ready
+            .get_or_init(|| {
+                let joined = self.pending.lock().unwrap().take().map(|h| h.join());
+                let pipelines = match joined {
+                    Some(Ok(pipelines)) => pipelines,
+                    // Also reached after an earlier fallback compile panicked
+                    _ => {
+                        tracing::error!(
+                            "Effect pipeline compile thread panicked, compiling on this thread"
+                        );
+                        (self.compile)()
+                    }
+                };
+                Arc::new(pipelines)
+            })
+            .clone()
+    }
+}
+
 /// Cached MSAA pipelines for dynamic sample counts
 struct MsaaPipelines {
     /// SDF pipeline for this sample count
@@ -135,15 +233,14 @@ struct MsaaPipelines {
 struct Buffers {
     /// Uniform buffer for viewport size
     uniforms: wgpu::Buffer,
-    /// Storage buffer for SDF primitives
-    primitives: wgpu::Buffer,
-    /// Storage buffer for glass primitives
-    glass_primitives: wgpu::Buffer,
+    /// Storage buffer for SDF primitives (grows with the batch)
+    primitives: UploadBuffer,
+    /// Storage buffer for glass primitives (grows with the batch)
+    glass_primitives: UploadBuffer,
     /// Uniform buffer for glass shader
     glass_uniforms: wgpu::Buffer,
-    /// Storage buffer for text glyphs
-    #[allow(dead_code)]
-    glyphs: wgpu::Buffer,
+    /// Storage buffer for text glyphs (grows with the batch)
+    glyphs: UploadBuffer,
     /// Uniform buffer for path rendering
     path_uniforms: wgpu::Buffer,
     /// Vertex buffer for path geometry (dynamic, recreated as needed)
@@ -195,6 +292,30 @@ struct CachedGlassResources {
     bind_group: Option<wgpu::BindGroup>,
     /// Width/height when bind group was created (for invalidation)
     bind_group_size: (u32, u32),
+    /// Pyramid generation of the prefiltered backdrop the bind group samples
+    /// (None when it samples the caller's backdrop directly)
+    bind_group_prefiltered: Option<u64>,
+}
+
+/// Pyramid blur applied to the glass backdrop before the glass shaders run
+#[derive(Clone, Copy, Debug, PartialEq)]
+struct BackdropPrefilter {
+    levels: u32,
+    offset: f32,
+    /// Blur it amounts to, in viewport pixels
+    radius: f32,
+}
+
+/// Glass backdrop state carried between frames in `BlurMode::Performance`
+#[derive(Default)]
+struct BackdropBlurCache {
+    /// Size of the backdrop texture last rendered
+    size: (u32, u32),
+    /// Hash of the primitives last rendered into the backdrop
+    content_key: Option<u64>,
+    /// Prefilter held in the pyramid output, and the pyramid generation it
+    /// was written in, while it matches the backdrop contents
+    prefilter: Option<(BackdropPrefilter, u64)>,
 }
 
 /// Cached text resources to avoid per-frame allocations
@@ -205,6 +326,11 @@ struct CachedTextResources {
     atlas_view_ptr: *const wgpu::TextureView,
     /// Pointer to color atlas view when bind group was created (for invalidation)
     color_atlas_view_ptr: *const wgpu::TextureView,
+    /// `TextRenderingContext::atlas_generation` when the bind group was created
+    ///
+    /// Re-created atlas textures keep the view's address, so the pointers
+    /// alone can't detect them.
+    atlas_generation: u64,
 }
 
 /// Cached SDF bind group with glyph atlas textures (for unified text rendering)
@@ -215,8 +341,19 @@ struct CachedSdfWithGlyphs {
     atlas_view_ptr: *const wgpu::TextureView,
     /// Pointer to color atlas view when bind group was created (for invalidation)
     color_atlas_view_ptr: *const wgpu::TextureView,
+    /// `TextRenderingContext::atlas_generation` when the bind group was created
+    ///
+    /// Re-created atlas textures keep the view's address, so the pointers
+    /// alone can't detect them.
+    atlas_generation: u64,
 }
 
+// SAFETY: the atlas view pointers are only compared for identity to detect a
+// re-created atlas, never dereferenced, so moving the cache across threads
+// (e.g. to a dedicated render thread) is sound.
+unsafe impl Send for CachedTextResources {}
+unsafe impl Send for CachedSdfWithGlyphs {}
+
 // ─────────────────────────────────────────────────────────────────────────────
 // Layer Texture Management
 // ─────────────────────────────────────────────────────────────────────────────
@@ -355,12 +492,30 @@ pub struct TextureCacheStats {
     pub named_count: usize,
     /// Estimated memory in named textures (bytes)
     pub named_memory_bytes: u64,
+    /// Number of retained layers (see `LayerConfig::retained`)
+    pub retained_count: usize,
+    /// Estimated memory in retained layers (bytes)
+    pub retained_memory_bytes: u64,
+    /// Retained layers composited without re-rendering
+    pub retained_hits: u64,
+    /// Retained layers that had to be rendered (new or changed content)
+    pub retained_misses: u64,
 }
 
 impl TextureCacheStats {
     /// Total estimated memory usage
     pub fn total_memory_bytes(&self) -> u64 {
-        self.pool_memory_bytes + self.named_memory_bytes
+        self.pool_memory_bytes + self.named_memory_bytes + self.retained_memory_bytes
+    }
+
+    /// Retained layer hit rate (0.0 - 1.0)
+    pub fn retained_hit_rate(&self) -> f64 {
+        let total = self.retained_hits + self.retained_misses;
+        if total == 0 {
+            0.0
+        } else {
+            self.retained_hits as f64 / total as f64
+        }
     }
 
     /// Cache hit rate (0.0 - 1.0)
@@ -374,14 +529,40 @@ impl TextureCacheStats {
     }
 }
 
+/// Frames a retained layer may go unused before its texture is released
+const RETAINED_LAYER_MAX_IDLE_FRAMES: u64 = 120;
+
+/// Memory budget for retained layer textures
+const RETAINED_LAYER_BUDGET_BYTES: u64 = 64 * 1024 * 1024;
+
+/// A layer's composited texture kept across frames
+pub struct RetainedLayer {
+    /// Composited content (after effects)
+    pub texture: LayerTexture,
+    /// Size of the content within `texture`
+    pub content_size: (u32, u32),
+    /// Effects baked into `texture`
+    effects: Vec<blinc_core::LayerEffect>,
+    /// Frame the layer was last composited
+    last_used: u64,
+}
+
 /// Cache for managing layer textures with size-bucketed pooling
 ///
 /// Implements texture pooling to avoid frequent allocations during rendering.
 /// Textures are acquired for layer rendering and released back to the pool
 /// when no longer needed. Uses size buckets for more efficient reuse.
+///
+/// Layers pushed with `LayerConfig::retained` keep their texture across
+/// frames, keyed by a hash of their layer-local content, and are composited
+/// without re-rendering until that content changes.
 pub struct LayerTextureCache {
     /// Map of layer IDs to their dedicated textures
     named_textures: std::collections::HashMap<blinc_core::LayerId, LayerTexture>,
+    /// Retained layers by content hash
+    retained: std::collections::HashMap<u64, RetainedLayer>,
+    /// Frame counter for retained layer eviction
+    frame: u64,
     /// Size-bucketed pools for efficient texture reuse
     pool_small: Vec<LayerTexture>, // <= 128
     pool_medium: Vec<LayerTexture>, // <= 256
@@ -399,6 +580,8 @@ impl LayerTextureCache {
     pub fn new(format: wgpu::TextureFormat) -> Self {
         Self {
             named_textures: std::collections::HashMap::new(),
+            retained: std::collections::HashMap::new(),
+            frame: 0,
             pool_small: Vec::with_capacity(4),
             pool_medium: Vec::with_capacity(4),
             pool_large: Vec::with_capacity(4),
@@ -621,9 +804,131 @@ impl LayerTextureCache {
         self.update_named_stats();
     }
 
+    /// Take the retained layer for `key` if it was rendered with `effects`
+    ///
+    /// Counts a retained hit or miss. Hand the layer back with
+    /// `store_retained` after compositing it.
+    pub fn take_retained(
+        &mut self,
+        key: u64,
+        effects: &[blinc_core::LayerEffect],
+    ) -> Option<RetainedLayer> {
+        match self.retained.remove(&key) {
+            Some(layer) if layer.effects == effects => {
+                self.stats.retained_hits += 1;
+                self.update_retained_stats();
+                Some(layer)
+            }
+            stale => {
+                if let Some(layer) = stale {
+                    self.release(layer.texture);
+                }
+                self.stats.retained_misses += 1;
+                self.update_retained_stats();
+                None
+            }
+        }
+    }
+
+    /// Keep `texture` as the retained layer for `key`
+    ///
+    /// Evicts the least recently used retained layers beyond the memory
+    /// budget.
+    pub fn store_retained(
+        &mut self,
+        key: u64,
+        texture: LayerTexture,
+        content_size: (u32, u32),
+        effects: &[blinc_core::LayerEffect],
+    ) {
+        let layer = RetainedLayer {
+            texture,
+            content_size,
+            effects: effects.to_vec(),
+            last_used: self.frame,
+        };
+        if let Some(old) = self.retained.insert(key, layer) {
+            self.release(old.texture);
+        }
+
+        let mut bytes = self.retained_bytes();
+        while bytes > RETAINED_LAYER_BUDGET_BYTES && self.retained.len() > 1 {
+            let Some(oldest) = self
+                .retained
+                .iter()
+                .filter(|(k, _)| **k != key)
+                .min_by_key(|(_, l)| l.last_used)
+                .map(|(k, _)| *k)
+            else {
+                break;
+            };
+            if let Some(evicted) = self.retained.remove(&oldest) {
+                bytes -=
+                    Self::estimate_texture_bytes(evicted.texture.size, evicted.texture.has_depth);
+                self.release(evicted.texture);
+            }
+        }
+        self.update_retained_stats();
+    }
+
+    /// Re-store a layer returned by `take_retained`, marking it used this frame
+    pub fn restore_retained(&mut self, key: u64, mut layer: RetainedLayer) {
+        layer.last_used = self.frame;
+        self.retained.insert(key, layer);
+        self.update_retained_stats();
+    }
+
+    /// Start a new frame, releasing retained layers that went unused
+    pub fn advance_frame(&mut self) {
+        self.frame += 1;
+        let frame = self.frame;
+        let idle: Vec<u64> = self
+            .retained
+            .iter()
+            .filter(|(_, l)| frame - l.last_used > RETAINED_LAYER_MAX_IDLE_FRAMES)
+            .map(|(k, _)| *k)
+            .collect();
+        if idle.is_empty() {
+            return;
+        }
+        for key in idle {
+            if let Some(layer) = self.retained.remove(&key) {
+                self.release(layer.texture);
+            }
+        }
+        self.update_retained_stats();
+    }
+
+    /// Drop every retained layer, so they re-render on next use
+    pub fn clear_retained(&mut self) {
+        self.retained.clear();
+        self.update_retained_stats();
+    }
+
+    fn retained_bytes(&self) -> u64 {
+        self.retained
+            .values()
+            .map(|l| Self::estimate_texture_bytes(l.texture.size, l.texture.has_depth))
+            .sum()
+    }
+
+    fn update_retained_stats(&mut self) {
+        self.stats.retained_count = self.retained.len();
+        self.stats.retained_memory_bytes = self.retained_bytes();
+    }
+
+    /// Drop every pooled (unused) texture, keeping named layer textures
+    pub fn clear_pool(&mut self) {
+        self.pool_small.clear();
+        self.pool_medium.clear();
+        self.pool_large.clear();
+        self.update_pool_stats();
+    }
+
     /// Clear the entire cache including pool
     pub fn clear_all(&mut self) {
         self.named_textures.clear();
+        self.retained.clear();
         self.pool_small.clear();
         self.pool_medium.clear();
         self.pool_large.clear();
@@ -649,6 +954,8 @@ impl LayerTextureCache {
     pub fn reset_stats(&mut self) {
         self.stats.hits = 0;
         self.stats.misses = 0;
+        self.stats.retained_hits = 0;
+        self.stats.retained_misses = 0;
         self.update_pool_stats();
         self.update_named_stats();
     }
@@ -664,24 +971,28 @@ impl LayerTextureCache {
 pub struct GpuRenderer {
     /// wgpu instance
     #[allow(dead_code)]
-    instance: wgpu::Instance,
+    instance: Arc<wgpu::Instance>,
     /// GPU adapter
     #[allow(dead_code)]
-    adapter: wgpu::Adapter,
+    adapter: Arc<wgpu::Adapter>,
     /// GPU device
     device: Arc<wgpu::Device>,
     /// Command queue
     queue: Arc<wgpu::Queue>,
-    /// Render pipelines
-    pipelines: Pipelines,
+    /// Render pipelines (shared with renderers on the same `GpuDevice`)
+    pipelines: Arc<Pipelines>,
+    /// Glass and effect pipelines (possibly still compiling)
+    effect_pipelines: Arc<DeferredEffectPipelines>,
+    /// On-disk pipeline cache, when configured and supported by the backend
+    pipeline_cache: Option<Arc<PersistentPipelineCache>>,
     /// Cached MSAA pipelines for overlay rendering
     msaa_pipelines: Option<MsaaPipelines>,
     /// GPU buffers
     buffers: Buffers,
     /// Bind groups
     bind_groups: BindGroups,
-    /// Bind group layouts
-    bind_group_layouts: BindGroupLayouts,
+    /// Bind group layouts (shared with the effect pipeline compile thread)
+    bind_group_layouts: Arc<BindGroupLayouts>,
     /// Current viewport size
     viewport_size: (u32, u32),
     /// Renderer configuration
@@ -714,6 +1025,19 @@ pub struct GpuRenderer {
     path_image_sampler: wgpu::Sampler,
     /// Layer texture cache for offscreen rendering and composition
     layer_texture_cache: LayerTextureCache,
+    /// Draw calls issued since the last `take_draw_call_count`
+    draw_calls: std::cell::Cell<u32>,
+    /// Scissor (x, y, width, height in pixels) for partial redraws
+    scissor: Option<[u32; 4]>,
+    /// Viewport last written to the shared uniform buffer
+    last_uniforms: Option<[f32; 2]>,
+    /// Dual-filter blur pyramids by base size
+    blur_pyramids: BlurPyramids,
+    /// Backdrop reuse state for `BlurMode::Performance`
+    backdrop_blur: BackdropBlurCache,
+    /// Whether content that can end up under glass is animating, in which
+    /// case the backdrop is redrawn every frame
+    backdrop_animating: bool,
 }
 
 /// Image rendering pipeline (created lazily on first image render)
@@ -744,12 +1068,25 @@ struct BindGroupLayouts {
     glow: wgpu::BindGroupLayout,
 }
 
+/// Shaders and pipelines compiled for one texture format and sample count
+///
+/// Renderers created from the same `GpuDevice` with matching formats share a
+/// set, so a second render context doesn't recompile every pipeline.
+pub(crate) struct PipelineSet {
+    pub(crate) texture_format: wgpu::TextureFormat,
+    pub(crate) sample_count: u32,
+    bind_group_layouts: Arc<BindGroupLayouts>,
+    pipelines: Arc<Pipelines>,
+    effect_pipelines: Arc<DeferredEffectPipelines>,
+    pipeline_cache: Option<Arc<PersistentPipelineCache>>,
+}
+
 impl GpuRenderer {
     /// Get the preferred backend for the current platform
     ///
     /// Using the primary backend instead of all backends reduces memory usage
     /// by avoiding initialization of multiple GPU driver stacks.
-    fn preferred_backends() -> wgpu::Backends {
+    pub(crate) fn preferred_backends() -> wgpu::Backends {
         #[cfg(target_os = "macos")]
         {
             wgpu::Backends::METAL
@@ -777,6 +1114,21 @@ impl GpuRenderer {
         }
     }
 
+    /// Optional device features to request for this configuration
+    ///
+    /// The pipeline cache feature is only requested when a cache directory is
+    /// configured and the adapter supports it.
+    pub(crate) fn required_features(
+        adapter: &wgpu::Adapter,
+        config: &RendererConfig,
+    ) -> wgpu::Features {
+        if config.pipeline_cache_dir.is_some() {
+            adapter.features() & wgpu::Features::PIPELINE_CACHE
+        } else {
+            wgpu::Features::empty()
+        }
+    }
+
     /// Create a new renderer without a surface (for headless rendering)
     pub async fn new(config: RendererConfig) -> Result<Self, RendererError> {
         let instance = wgpu::Instance::new(wgpu::InstanceDescriptor {
@@ -797,7 +1149,7 @@ impl GpuRenderer {
             .request_device(
                 &wgpu::DeviceDescriptor {
                     label: Some("Blinc GPU Device"),
-                    required_features: wgpu::Features::empty(),
+                    required_features: Self::required_features(&adapter, &config),
                     required_limits: wgpu::Limits::default(),
                     // MemoryUsage hint tells the driver to prefer lower memory over performance.
                     // This helps reduce RSS on integrated GPUs (Apple Silicon) where GPU memory
@@ -862,7 +1214,7 @@ impl GpuRenderer {
             .request_device(
                 &wgpu::DeviceDescriptor {
                     label: Some("Blinc GPU Device"),
-                    required_features: wgpu::Features::empty(),
+                    required_features: Self::required_features(&adapter, &config),
                     required_limits: wgpu::Limits::default(),
                     // MemoryUsage hint tells the driver to prefer lower memory over performance.
                     // This helps reduce RSS on integrated GPUs (Apple Silicon) where GPU memory
@@ -945,7 +1297,7 @@ impl GpuRenderer {
             .request_device(
                 &wgpu::DeviceDescriptor {
                     label: Some("Blinc GPU Device"),
-                    required_features: wgpu::Features::empty(),
+                    required_features: Self::required_features(&adapter, &config),
                     required_limits: wgpu::Limits::default(),
                     memory_hints: wgpu::MemoryHints::MemoryUsage,
                 },
@@ -995,8 +1347,72 @@ impl GpuRenderer {
         config: RendererConfig,
         viewport_size: (u32, u32),
     ) -> Result<Self, RendererError> {
+        let pipeline_set = Arc::new(Self::create_pipeline_set(
+            &device,
+            &adapter,
+            texture_format,
+            &config,
+        ));
+        Self::from_parts(
+            Arc::new(instance),
+            Arc::new(adapter),
+            device,
+            queue,
+            pipeline_set,
+            config,
+            viewport_size,
+        )
+    }
+
+    /// Create a renderer on a shared `GpuDevice`
+    ///
+    /// The renderer reuses the device's pipelines for its texture format, so
+    /// only per-renderer buffers and bind groups are created. Pass the
+    /// surface it will present to (created from `device.instance()`) to pick
+    /// a matching format, or `None` for offscreen rendering.
+    pub fn with_device(
+        device: &GpuDevice,
+        surface: Option<&wgpu::Surface<'_>>,
+        config: RendererConfig,
+    ) -> Result<Self, RendererError> {
+        let texture_format = config.texture_format.unwrap_or_else(|| match surface {
+            // Prefer non-sRGB, matching `with_instance_and_surface`
+            Some(surface) => {
+                let formats = surface.get_capabilities(device.adapter()).formats;
+                formats
+                    .iter()
+                    .find(|f| !f.is_srgb())
+                    .copied()
+                    .unwrap_or(formats[0])
+            }
+            None => wgpu::TextureFormat::Bgra8UnormSrgb,
+        });
+
+        let pipeline_set = device.pipeline_set(texture_format, &config);
+        Self::from_parts(
+            device.instance_arc(),
+            device.adapter_arc(),
+            device.device_arc(),
+            device.queue_arc(),
+            pipeline_set,
+            config,
+            (800, 600),
+        )
+    }
+
+    /// Compile the shaders and pipelines for `texture_format`
+    pub(crate) fn create_pipeline_set(
+        device: &Arc<wgpu::Device>,
+        adapter: &wgpu::Adapter,
+        texture_format: wgpu::TextureFormat,
+        config: &RendererConfig,
+    ) -> PipelineSet {
         // Create bind group layouts
-        let bind_group_layouts = Self::create_bind_group_layouts(&device);
+        let bind_group_layouts = Arc::new(Self::create_bind_group_layouts(device));
+
+        let pipeline_cache = config.pipeline_cache_dir.as_deref().and_then(|dir| {
+            PersistentPipelineCache::open(device, adapter, dir, texture_format).map(Arc::new)
+        });
 
         // Create shaders
         let sdf_shader = device.create_shader_module(wgpu::ShaderModuleDescriptor {
@@ -1004,16 +1420,6 @@ impl GpuRenderer {
             source: wgpu::ShaderSource::Wgsl(SDF_SHADER.into()),
         });
 
-        let glass_shader = device.create_shader_module(wgpu::ShaderModuleDescriptor {
-            label: Some("Glass Shader"),
-            source: wgpu::ShaderSource::Wgsl(GLASS_SHADER.into()),
-        });
-
-        let simple_glass_shader = device.create_shader_module(wgpu::ShaderModuleDescriptor {
-            label: Some("Simple Glass Shader"),
-            source: wgpu::ShaderSource::Wgsl(SIMPLE_GLASS_SHADER.into()),
-        });
-
         let text_shader = device.create_shader_module(wgpu::ShaderModuleDescriptor {
             label: Some("Text Shader"),
             source: wgpu::ShaderSource::Wgsl(TEXT_SHADER.into()),
@@ -1034,50 +1440,59 @@ impl GpuRenderer {
             source: wgpu::ShaderSource::Wgsl(LAYER_COMPOSITE_SHADER.into()),
         });
 
-        // Effect shaders
-        let blur_shader = device.create_shader_module(wgpu::ShaderModuleDescriptor {
-            label: Some("Blur Effect Shader"),
-            source: wgpu::ShaderSource::Wgsl(BLUR_SHADER.into()),
-        });
-
-        let color_matrix_shader = device.create_shader_module(wgpu::ShaderModuleDescriptor {
-            label: Some("Color Matrix Effect Shader"),
-            source: wgpu::ShaderSource::Wgsl(COLOR_MATRIX_SHADER.into()),
-        });
-
-        let drop_shadow_shader = device.create_shader_module(wgpu::ShaderModuleDescriptor {
-            label: Some("Drop Shadow Effect Shader"),
-            source: wgpu::ShaderSource::Wgsl(DROP_SHADOW_SHADER.into()),
-        });
-
-        let glow_shader = device.create_shader_module(wgpu::ShaderModuleDescriptor {
-            label: Some("Glow Effect Shader"),
-            source: wgpu::ShaderSource::Wgsl(GLOW_SHADER.into()),
-        });
-
-        // Create pipelines
+        // Create the pipelines every frame needs
         let pipelines = Self::create_pipelines(
-            &device,
+            device,
             &bind_group_layouts,
+            pipeline_cache.as_ref().map(|c| c.cache()),
             &sdf_shader,
-            &glass_shader,
-            &simple_glass_shader,
             &text_shader,
             &composite_shader,
             &path_shader,
             &layer_composite_shader,
-            &blur_shader,
-            &color_matrix_shader,
-            &drop_shadow_shader,
-            &glow_shader,
             texture_format,
             config.sample_count,
         );
 
+        // Glass and effect pipelines compile in the background unless disabled
+        let effect_pipelines = Self::spawn_effect_pipelines(
+            device,
+            &bind_group_layouts,
+            pipeline_cache.clone(),
+            texture_format,
+            config.background_pipeline_compilation,
+        );
+
+        PipelineSet {
+            texture_format,
+            sample_count: config.sample_count,
+            bind_group_layouts,
+            pipelines: Arc::new(pipelines),
+            effect_pipelines: Arc::new(effect_pipelines),
+            pipeline_cache,
+        }
+    }
+
+    /// Create the per-renderer buffers and bind groups around a pipeline set
+    fn from_parts(
+        instance: Arc<wgpu::Instance>,
+        adapter: Arc<wgpu::Adapter>,
+        device: Arc<wgpu::Device>,
+        queue: Arc<wgpu::Queue>,
+        pipeline_set: Arc<PipelineSet>,
+        config: RendererConfig,
+        viewport_size: (u32, u32),
+    ) -> Result<Self, RendererError> {
+        let texture_format = pipeline_set.texture_format;
+        let bind_group_layouts = pipeline_set.bind_group_layouts.clone();
+        let pipelines = pipeline_set.pipelines.clone();
+        let effect_pipelines = pipeline_set.effect_pipelines.clone();
+        let pipeline_cache = pipeline_set.pipeline_cache.clone();
+
         // Create buffers
         let buffers = Self::create_buffers(&device, &config);
 
-        // Create placeholder glyph atlas textures (1x1 transparent)
+        // Create placeholder glyph atlas textures (1x1 transparent, one array layer)
         // These are used when no text is rendered, satisfying the bind group layout
         let placeholder_glyph_atlas = device.create_texture(&wgpu::TextureDescriptor {
             label: Some("Placeholder Glyph Atlas"),
@@ -1094,7 +1509,10 @@ impl GpuRenderer {
             view_formats: &[],
         });
         let placeholder_glyph_atlas_view =
-            placeholder_glyph_atlas.create_view(&wgpu::TextureViewDescriptor::default());
+            placeholder_glyph_atlas.create_view(&wgpu::TextureViewDescriptor {
+                dimension: Some(wgpu::TextureViewDimension::D2Array),
+                ..Default::default()
+            });
 
         let placeholder_color_glyph_atlas = device.create_texture(&wgpu::TextureDescriptor {
             label: Some("Placeholder Color Glyph Atlas"),
@@ -1111,7 +1529,10 @@ impl GpuRenderer {
             view_formats: &[],
         });
         let placeholder_color_glyph_atlas_view =
-            placeholder_color_glyph_atlas.create_view(&wgpu::TextureViewDescriptor::default());
+            placeholder_color_glyph_atlas.create_view(&wgpu::TextureViewDescriptor {
+                dimension: Some(wgpu::TextureViewDimension::D2Array),
+                ..Default::default()
+            });
 
         // Create sampler for glyph atlases
         let glyph_sampler = device.create_sampler(&wgpu::SamplerDescriptor {
@@ -1197,6 +1618,8 @@ impl GpuRenderer {
             device,
             queue,
             pipelines,
+            effect_pipelines,
+            pipeline_cache,
             msaa_pipelines: None,
             buffers,
             bind_groups,
@@ -1217,9 +1640,65 @@ impl GpuRenderer {
             placeholder_path_image_view,
             path_image_sampler,
             layer_texture_cache: LayerTextureCache::new(texture_format),
+            draw_calls: std::cell::Cell::new(0),
+            scissor: None,
+            last_uniforms: None,
+            blur_pyramids: BlurPyramids::default(),
+            backdrop_blur: BackdropBlurCache::default(),
+            backdrop_animating: false,
         })
     }
 
+    /// Compile the effect pipelines, on a background thread when allowed
+    ///
+    /// The pipeline cache is saved once they are done, since by then it holds
+    /// every pipeline compiled during init.
+    fn spawn_effect_pipelines(
+        device: &Arc<wgpu::Device>,
+        layouts: &Arc<BindGroupLayouts>,
+        cache: Option<Arc<PersistentPipelineCache>>,
+        texture_format: wgpu::TextureFormat,
+        background: bool,
+    ) -> DeferredEffectPipelines {
+        let compile: CompileEffectPipelines = {
+            let device = device.clone();
+            let layouts = layouts.clone();
+            Arc::new(move || {
+                let pipelines = Self::create_effect_pipelines(
+                    &device,
+                    &layouts,
+                    cache.as_ref().map(|c| c.cache()),
+                    texture_format,
+                );
+                if let Some(cache) = &cache {
+                    cache.save();
+                }
+                pipelines
+            })
+        };
+
+        #[cfg(not(target_arch = "wasm32"))]
+        if background {
+            let handle = std::thread::Builder::new()
+                .name("blinc-pipelines".into())
+                .spawn({
+                    let compile = compile.clone();
+                    move || compile()
+                });
+            return match handle {
+                Ok(handle) => DeferredEffectPipelines::pending(handle, compile),
+                Err(e) => {
+                    tracing::warn!("Failed to spawn pipeline compile thread: {}", e);
+                    DeferredEffectPipelines::ready(compile)
+                }
+            };
+        }
+        #[cfg(target_arch = "wasm32")]
+        let _ = background;
+
+        DeferredEffectPipelines::ready(compile)
+    }
+
     fn create_bind_group_layouts(device: &wgpu::Device) -> BindGroupLayouts {
         // SDF bind group layout (includes glyph atlas for unified text rendering)
         let sdf = device.create_bind_group_layout(&wgpu::BindGroupLayoutDescriptor {
@@ -1253,7 +1732,7 @@ impl GpuRenderer {
                     visibility: wgpu::ShaderStages::FRAGMENT,
                     ty: wgpu::BindingType::Texture {
                         sample_type: wgpu::TextureSampleType::Float { filterable: true },
-                        view_dimension: wgpu::TextureViewDimension::D2,
+                        view_dimension: wgpu::TextureViewDimension::D2Array,
                         multisampled: false,
                     },
                     count: None,
@@ -1271,7 +1750,7 @@ impl GpuRenderer {
                     visibility: wgpu::ShaderStages::FRAGMENT,
                     ty: wgpu::BindingType::Texture {
                         sample_type: wgpu::TextureSampleType::Float { filterable: true },
-                        view_dimension: wgpu::TextureViewDimension::D2,
+                        view_dimension: wgpu::TextureViewDimension::D2Array,
                         multisampled: false,
                     },
                     count: None,
@@ -1358,7 +1837,7 @@ impl GpuRenderer {
                     visibility: wgpu::ShaderStages::FRAGMENT,
                     ty: wgpu::BindingType::Texture {
                         sample_type: wgpu::TextureSampleType::Float { filterable: true },
-                        view_dimension: wgpu::TextureViewDimension::D2,
+                        view_dimension: wgpu::TextureViewDimension::D2Array,
                         multisampled: false,
                     },
                     count: None,
@@ -1376,7 +1855,7 @@ impl GpuRenderer {
                     visibility: wgpu::ShaderStages::FRAGMENT,
                     ty: wgpu::BindingType::Texture {
                         sample_type: wgpu::TextureSampleType::Float { filterable: true },
-                        view_dimension: wgpu::TextureViewDimension::D2,
+                        view_dimension: wgpu::TextureViewDimension::D2Array,
                         multisampled: false,
                     },
                     count: None,
@@ -1700,17 +2179,12 @@ impl GpuRenderer {
     fn create_pipelines(
         device: &wgpu::Device,
         layouts: &BindGroupLayouts,
+        cache: Option<&wgpu::PipelineCache>,
         sdf_shader: &wgpu::ShaderModule,
-        glass_shader: &wgpu::ShaderModule,
-        simple_glass_shader: &wgpu::ShaderModule,
         text_shader: &wgpu::ShaderModule,
         composite_shader: &wgpu::ShaderModule,
         path_shader: &wgpu::ShaderModule,
         layer_composite_shader: &wgpu::ShaderModule,
-        blur_shader: &wgpu::ShaderModule,
-        color_matrix_shader: &wgpu::ShaderModule,
-        drop_shadow_shader: &wgpu::ShaderModule,
-        glow_shader: &wgpu::ShaderModule,
         texture_format: wgpu::TextureFormat,
         sample_count: u32,
     ) -> Pipelines {
@@ -1775,7 +2249,7 @@ impl GpuRenderer {
             depth_stencil: None,
             multisample: multisample_state,
             multiview: None,
-            cache: None,
+            cache,
         });
 
         // Overlay pipelines use sample_count=1 for rendering on resolved textures
@@ -1804,67 +2278,7 @@ impl GpuRenderer {
             depth_stencil: None,
             multisample: overlay_multisample_state,
             multiview: None,
-            cache: None,
-        });
-
-        // Glass pipeline - always uses sample_count=1 since it renders on resolved textures
-        // (glass effects require sampling from a single-sampled backdrop texture)
-        let glass_multisample_state = wgpu::MultisampleState {
-            count: 1,
-            mask: !0,
-            alpha_to_coverage_enabled: false,
-        };
-
-        let glass_layout = device.create_pipeline_layout(&wgpu::PipelineLayoutDescriptor {
-            label: Some("Glass Pipeline Layout"),
-            bind_group_layouts: &[&layouts.glass],
-            push_constant_ranges: &[],
-        });
-
-        let glass = device.create_render_pipeline(&wgpu::RenderPipelineDescriptor {
-            label: Some("Glass Pipeline"),
-            layout: Some(&glass_layout),
-            vertex: wgpu::VertexState {
-                module: glass_shader,
-                entry_point: Some("vs_main"),
-                buffers: &[],
-                compilation_options: wgpu::PipelineCompilationOptions::default(),
-            },
-            fragment: Some(wgpu::FragmentState {
-                module: glass_shader,
-                entry_point: Some("fs_main"),
-                targets: color_targets,
-                compilation_options: wgpu::PipelineCompilationOptions::default(),
-            }),
-            primitive: primitive_state,
-            depth_stencil: None,
-            multisample: glass_multisample_state,
-            multiview: None,
-            cache: None,
-        });
-
-        // Simple glass pipeline - pure frosted glass without liquid effects
-        // Uses the same bind group layout as liquid glass
-        let simple_glass = device.create_render_pipeline(&wgpu::RenderPipelineDescriptor {
-            label: Some("Simple Glass Pipeline"),
-            layout: Some(&glass_layout),
-            vertex: wgpu::VertexState {
-                module: simple_glass_shader,
-                entry_point: Some("vs_main"),
-                buffers: &[],
-                compilation_options: wgpu::PipelineCompilationOptions::default(),
-            },
-            fragment: Some(wgpu::FragmentState {
-                module: simple_glass_shader,
-                entry_point: Some("fs_main"),
-                targets: color_targets,
-                compilation_options: wgpu::PipelineCompilationOptions::default(),
-            }),
-            primitive: primitive_state,
-            depth_stencil: None,
-            multisample: glass_multisample_state,
-            multiview: None,
-            cache: None,
+            cache,
         });
 
         // Text pipeline
@@ -1893,7 +2307,7 @@ impl GpuRenderer {
             depth_stencil: None,
             multisample: multisample_state,
             multiview: None,
-            cache: None,
+            cache,
         });
 
         // Text overlay pipeline - uses sample_count=1 for rendering on resolved textures
@@ -1916,7 +2330,7 @@ impl GpuRenderer {
             depth_stencil: None,
             multisample: overlay_multisample_state,
             multiview: None,
-            cache: None,
+            cache,
         });
 
         // Composite pipeline
@@ -1945,7 +2359,7 @@ impl GpuRenderer {
             depth_stencil: None,
             multisample: multisample_state,
             multiview: None,
-            cache: None,
+            cache,
         });
 
         // Composite overlay pipeline - single-sampled for blending onto resolved textures
@@ -1968,7 +2382,7 @@ impl GpuRenderer {
             depth_stencil: None,
             multisample: overlay_multisample_state,
             multiview: None,
-            cache: None,
+            cache,
         });
 
         // Path pipeline - uses vertex buffers for tessellated geometry
@@ -2056,7 +2470,7 @@ impl GpuRenderer {
             depth_stencil: None,
             multisample: multisample_state,
             multiview: None,
-            cache: None,
+            cache,
         });
 
         // Path overlay pipeline - uses sample_count=1 for rendering on resolved textures
@@ -2079,7 +2493,7 @@ impl GpuRenderer {
             depth_stencil: None,
             multisample: overlay_multisample_state,
             multiview: None,
-            cache: None,
+            cache,
         });
 
         // Layer composite pipeline - for compositing offscreen layers with blend modes
@@ -2135,12 +2549,161 @@ impl GpuRenderer {
             depth_stencil: None,
             multisample: overlay_multisample_state, // 1x sampled - layers are resolved
             multiview: None,
-            cache: None,
+            cache,
         });
 
-        // -------------------------------------------------------------------------
-        // Effect Pipelines (post-processing)
-        // -------------------------------------------------------------------------
+        Pipelines {
+            sdf,
+            sdf_overlay,
+            text,
+            text_overlay,
+            composite,
+            composite_overlay,
+            path,
+            path_overlay,
+            layer_composite,
+        }
+    }
+
+    /// Create the pipelines that aren't needed to draw a plain frame
+    ///
+    /// Glass and post-processing effect pipelines are compiled separately from
+    /// `create_pipelines` so they can be built on a background thread while the
+    /// first frame renders. They always render 1x sampled.
+    fn create_effect_pipelines(
+        device: &wgpu::Device,
+        layouts: &BindGroupLayouts,
+        cache: Option<&wgpu::PipelineCache>,
+        texture_format: wgpu::TextureFormat,
+    ) -> EffectPipelines {
+        let glass_shader = &device.create_shader_module(wgpu::ShaderModuleDescriptor {
+            label: Some("Glass Shader"),
+            source: wgpu::ShaderSource::Wgsl(GLASS_SHADER.into()),
+        });
+
+        let simple_glass_shader = &device.create_shader_module(wgpu::ShaderModuleDescriptor {
+            label: Some("Simple Glass Shader"),
+            source: wgpu::ShaderSource::Wgsl(SIMPLE_GLASS_SHADER.into()),
+        });
+
+        let blur_shader = &device.create_shader_module(wgpu::ShaderModuleDescriptor {
+            label: Some("Blur Effect Shader"),
+            source: wgpu::ShaderSource::Wgsl(BLUR_SHADER.into()),
+        });
+
+        let color_matrix_shader = &device.create_shader_module(wgpu::ShaderModuleDescriptor {
+            label: Some("Color Matrix Effect Shader"),
+            source: wgpu::ShaderSource::Wgsl(COLOR_MATRIX_SHADER.into()),
+        });
+
+        let drop_shadow_shader = &device.create_shader_module(wgpu::ShaderModuleDescriptor {
+            label: Some("Drop Shadow Effect Shader"),
+            source: wgpu::ShaderSource::Wgsl(DROP_SHADOW_SHADER.into()),
+        });
+
+        let glow_shader = &device.create_shader_module(wgpu::ShaderModuleDescriptor {
+            label: Some("Glow Effect Shader"),
+            source: wgpu::ShaderSource::Wgsl(GLOW_SHADER.into()),
+        });
+
+        let blend_state = wgpu::BlendState {
+            color: wgpu::BlendComponent {
+                src_factor: wgpu::BlendFactor::SrcAlpha,
+                dst_factor: wgpu::BlendFactor::OneMinusSrcAlpha,
+                operation: wgpu::BlendOperation::Add,
+            },
+            alpha: wgpu::BlendComponent {
+                src_factor: wgpu::BlendFactor::One,
+                dst_factor: wgpu::BlendFactor::OneMinusSrcAlpha,
+                operation: wgpu::BlendOperation::Add,
+            },
+        };
+
+        let color_targets = &[Some(wgpu::ColorTargetState {
+            format: texture_format,
+            blend: Some(blend_state),
+            write_mask: wgpu::ColorWrites::ALL,
+        })];
+
+        let primitive_state = wgpu::PrimitiveState {
+            topology: wgpu::PrimitiveTopology::TriangleList,
+            strip_index_format: None,
+            front_face: wgpu::FrontFace::Ccw,
+            cull_mode: None,
+            unclipped_depth: false,
+            polygon_mode: wgpu::PolygonMode::Fill,
+            conservative: false,
+        };
+
+        let overlay_multisample_state = wgpu::MultisampleState {
+            count: 1,
+            mask: !0,
+            alpha_to_coverage_enabled: false,
+        };
+
+        // Glass pipeline - always uses sample_count=1 since it renders on resolved textures
+        // (glass effects require sampling from a single-sampled backdrop texture)
+        let glass_multisample_state = wgpu::MultisampleState {
+            count: 1,
+            mask: !0,
+            alpha_to_coverage_enabled: false,
+        };
+
+        let glass_layout = device.create_pipeline_layout(&wgpu::PipelineLayoutDescriptor {
+            label: Some("Glass Pipeline Layout"),
+            bind_group_layouts: &[&layouts.glass],
+            push_constant_ranges: &[],
+        });
+
+        let glass = device.create_render_pipeline(&wgpu::RenderPipelineDescriptor {
+            label: Some("Glass Pipeline"),
+            layout: Some(&glass_layout),
+            vertex: wgpu::VertexState {
+                module: glass_shader,
+                entry_point: Some("vs_main"),
+                buffers: &[],
+                compilation_options: wgpu::PipelineCompilationOptions::default(),
+            },
+            fragment: Some(wgpu::FragmentState {
+                module: glass_shader,
+                entry_point: Some("fs_main"),
+                targets: color_targets,
+                compilation_options: wgpu::PipelineCompilationOptions::default(),
+            }),
+            primitive: primitive_state,
+            depth_stencil: None,
+            multisample: glass_multisample_state,
+            multiview: None,
+            cache,
+        });
+
+        // Simple glass pipeline - pure frosted glass without liquid effects
+        // Uses the same bind group layout as liquid glass
+        let simple_glass = device.create_render_pipeline(&wgpu::RenderPipelineDescriptor {
+            label: Some("Simple Glass Pipeline"),
+            layout: Some(&glass_layout),
+            vertex: wgpu::VertexState {
+                module: simple_glass_shader,
+                entry_point: Some("vs_main"),
+                buffers: &[],
+                compilation_options: wgpu::PipelineCompilationOptions::default(),
+            },
+            fragment: Some(wgpu::FragmentState {
+                module: simple_glass_shader,
+                entry_point: Some("fs_main"),
+                targets: color_targets,
+                compilation_options: wgpu::PipelineCompilationOptions::default(),
+            }),
+            primitive: primitive_state,
+            depth_stencil: None,
+            multisample: glass_multisample_state,
+            multiview: None,
+            cache,
+        });
+
+        // -------------------------------------------------------------------------
+        // Effect Pipelines (post-processing)
+        // -------------------------------------------------------------------------
 
         // Effect pipelines share similar configuration: no vertex buffers, fullscreen quad
         let effect_primitive_state = wgpu::PrimitiveState {
@@ -2187,9 +2750,51 @@ impl GpuRenderer {
             depth_stencil: None,
             multisample: overlay_multisample_state, // 1x sampled
             multiview: None,
-            cache: None,
+            cache,
         });
 
+        // Dual-filter pyramid passes share the blur layout. The RGB-only
+        // upsample lets element blurs keep the alpha copied from their input.
+        let blur_color_targets = &[Some(wgpu::ColorTargetState {
+            format: texture_format,
+            blend: None,
+            write_mask: wgpu::ColorWrites::COLOR,
+        })];
+        let dual_blur_pipeline =
+            |label: &'static str,
+             entry_point: &'static str,
+             targets: &[Option<wgpu::ColorTargetState>]| {
+                device.create_render_pipeline(&wgpu::RenderPipelineDescriptor {
+                    label: Some(label),
+                    layout: Some(&blur_layout),
+                    vertex: wgpu::VertexState {
+                        module: blur_shader,
+                        entry_point: Some("vs_main"),
+                        buffers: &[],
+                        compilation_options: wgpu::PipelineCompilationOptions::default(),
+                    },
+                    fragment: Some(wgpu::FragmentState {
+                        module: blur_shader,
+                        entry_point: Some(entry_point),
+                        targets,
+                        compilation_options: wgpu::PipelineCompilationOptions::default(),
+                    }),
+                    primitive: effect_primitive_state,
+                    depth_stencil: None,
+                    multisample: overlay_multisample_state,
+                    multiview: None,
+                    cache,
+                })
+            };
+        let blur_down =
+            dual_blur_pipeline("Blur Downsample Pipeline", "fs_dual_down", blur_targets);
+        let blur_up = dual_blur_pipeline("Blur Upsample Pipeline", "fs_dual_up", blur_targets);
+        let blur_up_color = dual_blur_pipeline(
+            "Blur Upsample Color Pipeline",
+            "fs_dual_up",
+            blur_color_targets,
+        );
+
         // Color matrix pipeline layout
         let color_matrix_layout = device.create_pipeline_layout(&wgpu::PipelineLayoutDescriptor {
             label: Some("Color Matrix Effect Pipeline Layout"),
@@ -2223,7 +2828,7 @@ impl GpuRenderer {
             depth_stencil: None,
             multisample: overlay_multisample_state, // 1x sampled
             multiview: None,
-            cache: None,
+            cache,
         });
 
         // Drop shadow pipeline layout
@@ -2260,7 +2865,7 @@ impl GpuRenderer {
             depth_stencil: None,
             multisample: overlay_multisample_state, // 1x sampled
             multiview: None,
-            cache: None,
+            cache,
         });
 
         // Glow effect pipeline
@@ -2296,22 +2901,16 @@ impl GpuRenderer {
             depth_stencil: None,
             multisample: overlay_multisample_state, // 1x sampled
             multiview: None,
-            cache: None,
+            cache,
         });
 
-        Pipelines {
-            sdf,
-            sdf_overlay,
+        EffectPipelines {
             glass,
             simple_glass,
-            text,
-            text_overlay,
-            composite,
-            composite_overlay,
-            path,
-            path_overlay,
-            layer_composite,
             blur,
+            blur_down,
+            blur_up,
+            blur_up_color,
             color_matrix,
             drop_shadow,
             glow,
@@ -2326,19 +2925,19 @@ impl GpuRenderer {
             mapped_at_creation: false,
         });
 
-        let primitives = device.create_buffer(&wgpu::BufferDescriptor {
-            label: Some("Primitives Buffer"),
-            size: (std::mem::size_of::<GpuPrimitive>() * config.max_primitives) as u64,
-            usage: wgpu::BufferUsages::STORAGE | wgpu::BufferUsages::COPY_DST,
-            mapped_at_creation: false,
-        });
+        let primitives = UploadBuffer::new(
+            device,
+            "Primitives Buffer",
+            wgpu::BufferUsages::STORAGE,
+            (std::mem::size_of::<GpuPrimitive>() * config.max_primitives) as u64,
+        );
 
-        let glass_primitives = device.create_buffer(&wgpu::BufferDescriptor {
-            label: Some("Glass Primitives Buffer"),
-            size: (std::mem::size_of::<GpuGlassPrimitive>() * config.max_glass_primitives) as u64,
-            usage: wgpu::BufferUsages::STORAGE | wgpu::BufferUsages::COPY_DST,
-            mapped_at_creation: false,
-        });
+        let glass_primitives = UploadBuffer::new(
+            device,
+            "Glass Primitives Buffer",
+            wgpu::BufferUsages::STORAGE,
+            (std::mem::size_of::<GpuGlassPrimitive>() * config.max_glass_primitives) as u64,
+        );
 
         let glass_uniforms = device.create_buffer(&wgpu::BufferDescriptor {
             label: Some("Glass Uniforms Buffer"),
@@ -2347,12 +2946,12 @@ impl GpuRenderer {
             mapped_at_creation: false,
         });
 
-        let glyphs = device.create_buffer(&wgpu::BufferDescriptor {
-            label: Some("Glyphs Buffer"),
-            size: (std::mem::size_of::<GpuGlyph>() * config.max_glyphs) as u64,
-            usage: wgpu::BufferUsages::STORAGE | wgpu::BufferUsages::COPY_DST,
-            mapped_at_creation: false,
-        });
+        let glyphs = UploadBuffer::new(
+            device,
+            "Glyphs Buffer",
+            wgpu::BufferUsages::STORAGE,
+            (std::mem::size_of::<GpuGlyph>() * config.max_glyphs) as u64,
+        );
 
         let path_uniforms = device.create_buffer(&wgpu::BufferDescriptor {
             label: Some("Path Uniforms Buffer"),
@@ -2501,6 +3100,7 @@ impl GpuRenderer {
     fn create_msaa_pipelines(
         device: &wgpu::Device,
         layouts: &BindGroupLayouts,
+        cache: Option<&wgpu::PipelineCache>,
         texture_format: wgpu::TextureFormat,
         sample_count: u32,
     ) -> MsaaPipelines {
@@ -2570,7 +3170,7 @@ impl GpuRenderer {
             depth_stencil: None,
             multisample: multisample_state,
             multiview: None,
-            cache: None,
+            cache,
         });
 
         // Create path shader
@@ -2647,7 +3247,7 @@ impl GpuRenderer {
             depth_stencil: None,
             multisample: multisample_state,
             multiview: None,
-            cache: None,
+            cache,
         });
 
         MsaaPipelines {
@@ -2662,6 +3262,98 @@ impl GpuRenderer {
         self.viewport_size = (width, height);
     }
 
+    /// Current viewport size set with `resize`
+    pub fn viewport_size(&self) -> (u32, u32) {
+        self.viewport_size
+    }
+
+    /// Write the shared viewport uniforms, skipping the upload if unchanged
+    ///
+    /// Every pass of a frame binds the same uniform buffer, usually at the same
+    /// viewport size, so most passes have nothing new to upload.
+    fn write_uniforms(&mut self, viewport_size: [f32; 2]) {
+        if self.last_uniforms == Some(viewport_size) {
+            return;
+        }
+        let uniforms = Uniforms {
+            viewport_size,
+            _padding: [0.0; 2],
+        };
+        self.queue
+            .write_buffer(&self.buffers.uniforms, 0, bytemuck::bytes_of(&uniforms));
+        self.last_uniforms = Some(viewport_size);
+    }
+
+    /// Upload SDF primitives, rebuilding bind groups if the buffer grew
+    fn upload_primitives(&mut self, primitives: &[GpuPrimitive]) {
+        if self
+            .buffers
+            .primitives
+            .write(&self.device, &self.queue, primitives)
+        {
+            self.bind_groups = Self::create_bind_groups(
+                &self.device,
+                &self.bind_group_layouts,
+                &self.buffers,
+                &self.placeholder_glyph_atlas_view,
+                &self.placeholder_color_glyph_atlas_view,
+                &self.glyph_sampler,
+                &self.gradient_texture_cache,
+                &self.placeholder_path_image_view,
+                &self.path_image_sampler,
+            );
+            self.cached_sdf_with_glyphs = None;
+        }
+    }
+
+    /// Upload glass primitives; returns true if the glass bind group must be
+    /// rebuilt because the buffer grew
+    fn upload_glass_primitives(&mut self, primitives: &[GpuGlassPrimitive]) -> bool {
+        let grown = self
+            .buffers
+            .glass_primitives
+            .write(&self.device, &self.queue, primitives);
+        if grown {
+            if let Some(cached) = &mut self.cached_glass {
+                cached.bind_group = None;
+            }
+        }
+        grown
+    }
+
+    /// Upload text glyphs, dropping the cached text bind group if the buffer grew
+    fn upload_glyphs(&mut self, glyphs: &[GpuGlyph]) {
+        if self.buffers.glyphs.write(&self.device, &self.queue, glyphs) {
+            self.cached_text = None;
+        }
+    }
+
+    /// Restrict rendering to a region of the target (None = whole target)
+    ///
+    /// Applies to the primitive, path, text and image passes used for the
+    /// main frame, and to the blend step of the MSAA overlays. While a scissor is set, `render_with_clear` keeps the
+    /// existing target contents instead of clearing, so callers can redraw a
+    /// damaged region on top of the previous frame.
+    pub fn set_scissor(&mut self, scissor: Option<[u32; 4]>) {
+        self.scissor = scissor;
+    }
+
+    /// Current scissor set with `set_scissor`
+    pub fn scissor(&self) -> Option<[u32; 4]> {
+        self.scissor
+    }
+
+    /// Apply the current scissor, clamped to the viewport
+    fn apply_scissor(&self, render_pass: &mut wgpu::RenderPass<'_>) {
+        let Some([x, y, w, h]) = self.scissor else {
+            return;
+        };
+        let (vw, vh) = self.viewport_size;
+        let x = x.min(vw);
+        let y = y.min(vh);
+        render_pass.set_scissor_rect(x, y, w.min(vw - x), h.min(vh - y));
+    }
+
     /// Update the frame time (for animations)
     pub fn update_time(&mut self, time: f32) {
         self.time = time;
@@ -2672,6 +3364,18 @@ impl GpuRenderer {
         &self.device
     }
 
+    /// Write the pipeline cache to disk, if one is configured
+    ///
+    /// Init saves once all startup pipelines are compiled, and the MSAA and
+    /// image pipelines save again when they are first created. Call this
+    /// to persist anything else compiled since, e.g. when the app is
+    /// backgrounded.
+    pub fn save_pipeline_cache(&self) {
+        if let Some(cache) = &self.pipeline_cache {
+            cache.save();
+        }
+    }
+
     /// Get the wgpu device as Arc
     pub fn device_arc(&self) -> Arc<wgpu::Device> {
         self.device.clone()
@@ -2707,6 +3411,83 @@ impl GpuRenderer {
         self.device.poll(wgpu::Maintain::Wait);
     }
 
+    /// Release cached render targets and bind groups (MSAA, glass, text)
+    ///
+    /// They are recreated on the next frame that needs them. Call after the
+    /// textures they reference have been replaced, or to free memory.
+    pub fn release_cached_targets(&mut self) {
+        self.cached_msaa = None;
+        self.cached_glass = None;
+        self.cached_text = None;
+        self.cached_sdf_with_glyphs = None;
+        self.release_blur_pyramids();
+        self.invalidate_backdrop_blur();
+    }
+
+    /// Estimated bytes held by the cached MSAA and resolve targets and the
+    /// blur pyramids
+    pub fn cached_target_bytes(&self) -> u64 {
+        let msaa = self
+            .cached_msaa
+            .as_ref()
+            .map(|m| (m.width as u64) * (m.height as u64) * 4 * (m.sample_count as u64 + 1))
+            .unwrap_or(0);
+        msaa + self.blur_pyramids.memory_bytes()
+    }
+
+    /// How blur effects and glass backdrops are currently filtered
+    pub fn blur_mode(&self) -> BlurMode {
+        self.config.blur_mode
+    }
+
+    /// Switch between full resolution Kawase blurs and the dual-filter
+    /// pyramid, e.g. when a device starts running hot
+    pub fn set_blur_mode(&mut self, mode: BlurMode) {
+        if self.config.blur_mode != mode {
+            self.config.blur_mode = mode;
+            self.invalidate_backdrop_blur();
+        }
+    }
+
+    /// Forget the glass backdrop reused in `BlurMode::Performance`
+    ///
+    /// Call after replacing the backdrop texture: a new texture of the same
+    /// size would otherwise be assumed to still hold the last backdrop.
+    pub fn invalidate_backdrop_blur(&mut self) {
+        self.backdrop_blur = BackdropBlurCache::default();
+    }
+
+    /// Note whether the content drawn into the glass backdrop is animating
+    ///
+    /// While it is, the backdrop is never reused in `BlurMode::Performance`:
+    /// the primitive hash can't see time driven inputs, so an animation that
+    /// leaves a frame's primitives unchanged would otherwise freeze what is
+    /// seen through the glass. Set once per frame before rendering.
+    pub fn set_backdrop_animating(&mut self, animating: bool) {
+        self.backdrop_animating = animating;
+    }
+
+    /// Free the blur pyramids; they are rebuilt by the next pyramid blur
+    pub fn release_blur_pyramids(&mut self) {
+        self.blur_pyramids.clear();
+        self.backdrop_blur.prefilter = None;
+    }
+
+    /// Number of draw calls issued since the last call, resetting the counter
+    pub fn take_draw_call_count(&self) -> u32 {
+        self.draw_calls.replace(0)
+    }
+
+    /// Count one draw call for `take_draw_call_count`
+    fn count_draw_call(&self) {
+        self.count_draw_calls(1);
+    }
+
+    /// Count `draws` draw calls for `take_draw_call_count`
+    fn count_draw_calls(&self, draws: u32) {
+        self.draw_calls.set(self.draw_calls.get() + draws);
+    }
+
     /// Render a batch of primitives to a texture view
     /// Render primitives with transparent background (default)
     pub fn render(&mut self, target: &wgpu::TextureView, batch: &PrimitiveBatch) {
@@ -2746,15 +3527,11 @@ impl GpuRenderer {
         // Evict oversized textures from the pool at frame start
         // This prevents memory bloat from accumulated large textures
         self.layer_texture_cache.evict_oversized();
+        self.layer_texture_cache.advance_frame();
 
-        // Check if we have layer commands with effects that need processing
-        let has_layer_effects = batch.layer_commands.iter().any(|entry| {
-            if let crate::primitives::LayerCommand::Push { config } = &entry.command {
-                !config.effects.is_empty()
-            } else {
-                false
-            }
-        });
+        // Check if we have layer commands with effects (or retained layers)
+        // that need processing
+        let has_layer_effects = batch.has_layer_effects() || batch.has_retained_layers();
 
         tracing::trace!(
             "render_with_clear: {} primitives, {} layer commands, has_layer_effects={}",
@@ -2781,20 +3558,11 @@ impl GpuRenderer {
         clear_color: [f64; 4],
     ) {
         // Update uniforms
-        let uniforms = Uniforms {
-            viewport_size: [self.viewport_size.0 as f32, self.viewport_size.1 as f32],
-            _padding: [0.0; 2],
-        };
-        self.queue
-            .write_buffer(&self.buffers.uniforms, 0, bytemuck::bytes_of(&uniforms));
+        self.write_uniforms([self.viewport_size.0 as f32, self.viewport_size.1 as f32]);
 
         // Update primitives buffer
         if !batch.primitives.is_empty() {
-            self.queue.write_buffer(
-                &self.buffers.primitives,
-                0,
-                bytemuck::cast_slice(&batch.primitives),
-            );
+            self.upload_primitives(&batch.primitives);
         }
 
         // Update path buffers if we have path geometry
@@ -2810,6 +3578,19 @@ impl GpuRenderer {
                 label: Some("Blinc Render Encoder"),
             });
 
+        // A clear ignores the scissor, so partial redraws keep the previous
+        // frame and rely on the caller to paint the damaged region's background
+        let load = if self.scissor.is_some() {
+            wgpu::LoadOp::Load
+        } else {
+            wgpu::LoadOp::Clear(wgpu::Color {
+                r: clear_color[0],
+                g: clear_color[1],
+                b: clear_color[2],
+                a: clear_color[3],
+            })
+        };
+
         // Begin render pass
         {
             let mut render_pass = encoder.begin_render_pass(&wgpu::RenderPassDescriptor {
@@ -2818,12 +3599,7 @@ impl GpuRenderer {
                     view: target,
                     resolve_target: None,
                     ops: wgpu::Operations {
-                        load: wgpu::LoadOp::Clear(wgpu::Color {
-                            r: clear_color[0],
-                            g: clear_color[1],
-                            b: clear_color[2],
-                            a: clear_color[3],
-                        }),
+                        load,
                         store: wgpu::StoreOp::Store,
                     },
                 })],
@@ -2832,12 +3608,15 @@ impl GpuRenderer {
                 occlusion_query_set: None,
             });
 
+            self.apply_scissor(&mut render_pass);
+
             // Render SDF primitives
             if !batch.primitives.is_empty() {
                 render_pass.set_pipeline(&self.pipelines.sdf);
                 render_pass.set_bind_group(0, &self.bind_groups.sdf, &[]);
                 // 6 vertices per quad (2 triangles), one instance per primitive
                 render_pass.draw(0..6, 0..batch.primitives.len() as u32);
+                self.count_draw_call();
             }
 
             // Render paths
@@ -2850,6 +3629,7 @@ impl GpuRenderer {
                     render_pass.set_vertex_buffer(0, vb.slice(..));
                     render_pass.set_index_buffer(ib.slice(..), wgpu::IndexFormat::Uint32);
                     render_pass.draw_indexed(0..batch.paths.indices.len() as u32, 0, 0..1);
+                    self.count_draw_call();
                 }
             }
         }
@@ -2883,7 +3663,7 @@ impl GpuRenderer {
                 }
                 LayerCommand::Pop => {
                     if let Some((start_idx, config)) = layer_stack.pop() {
-                        if !config.effects.is_empty() {
+                        if !config.effects.is_empty() || config.retained {
                             effect_layers.push((start_idx, entry.primitive_index, config));
                         }
                     }
@@ -2971,21 +3751,6 @@ impl GpuRenderer {
             // Calculate effect expansion (how much effects extend beyond original bounds)
             let effect_expansion = Self::calculate_effect_expansion(&config.effects);
 
-            // Render layer primitives to a TIGHT texture (not viewport-sized!)
-            // This significantly reduces memory usage and effect processing time
-            // Returns both texture and content_size (which may differ from texture.size due to pool bucket rounding)
-            let (layer_texture, content_size) = self.render_primitive_range_tight(
-                batch,
-                start_idx,
-                end_idx,
-                layer_pos,
-                layer_size,
-                effect_expansion,
-            );
-
-            // Use content_size for blitting (not layer_texture.size which may be larger)
-            let tight_size = content_size;
-
             // Calculate the destination position and size for blitting
             // Don't clamp to 0 - allow negative positions for scrolled content
             // The blit function will handle off-screen portions correctly
@@ -2998,38 +3763,71 @@ impl GpuRenderer {
                 layer_size.1 + effect_expansion.1 + effect_expansion.3,
             );
 
+            // Retained layers are keyed by their layer-local content, so one
+            // that only moved (or didn't change at all) is just composited
+            let retain_key = config
+                .retained
+                .then(|| self.retained_layer_key(primitives, expanded_pos, layer_size));
+            if let Some(key) = retain_key {
+                if let Some(layer) = self.layer_texture_cache.take_retained(key, &config.effects) {
+                    self.blit_tight_texture_to_target(
+                        &layer.texture.view,
+                        layer.content_size,
+                        target,
+                        expanded_pos,
+                        expanded_size,
+                        config.opacity,
+                        config.blend_mode,
+                        layer_clip,
+                    );
+                    self.layer_texture_cache.restore_retained(key, layer);
+                    continue;
+                }
+            }
+
+            // Render layer primitives to a TIGHT texture (not viewport-sized!)
+            // This significantly reduces memory usage and effect processing time
+            // Returns both texture and content_size (which may differ from texture.size due to pool bucket rounding)
+            let (layer_texture, content_size) = self.render_primitive_range_tight(
+                batch,
+                start_idx,
+                end_idx,
+                layer_pos,
+                layer_size,
+                effect_expansion,
+            );
+
             // Skip texture copy when no effects - use layer_texture directly
-            if config.effects.is_empty() {
-                // Blit directly without effect processing (skip copy)
-                self.blit_tight_texture_to_target(
-                    &layer_texture.view,
-                    tight_size,
-                    target,
-                    expanded_pos,
-                    expanded_size,
-                    config.opacity,
-                    config.blend_mode,
-                    layer_clip,
-                );
-                self.layer_texture_cache.release(layer_texture);
+            let composited = if config.effects.is_empty() {
+                layer_texture
             } else {
-                // Apply effects to the tight texture
                 let effected = self.apply_layer_effects(&layer_texture, &config.effects);
                 self.layer_texture_cache.release(layer_texture);
+                effected
+            };
 
-                // Blit the effected texture back to target at the correct position
-                // Pass through the clip bounds so effects don't bleed outside scroll containers
-                self.blit_tight_texture_to_target(
-                    &effected.view,
-                    tight_size,
-                    target,
-                    expanded_pos,
-                    expanded_size,
-                    config.opacity,
-                    config.blend_mode,
-                    layer_clip,
-                );
-                self.layer_texture_cache.release(effected);
+            // Blit back to target at the correct position, using content_size
+            // (not the texture size, which may be larger). Pass through the
+            // clip bounds so effects don't bleed outside scroll containers.
+            self.blit_tight_texture_to_target(
+                &composited.view,
+                content_size,
+                target,
+                expanded_pos,
+                expanded_size,
+                config.opacity,
+                config.blend_mode,
+                layer_clip,
+            );
+
+            match retain_key {
+                Some(key) => self.layer_texture_cache.store_retained(
+                    key,
+                    composited,
+                    content_size,
+                    &config.effects,
+                ),
+                None => self.layer_texture_cache.release(composited),
             }
         }
     }
@@ -3058,6 +3856,11 @@ impl GpuRenderer {
             .collect();
 
         if included_primitives.is_empty() && batch.paths.vertices.is_empty() {
+            // Partial redraws keep the previous frame, so there's nothing to do
+            if self.scissor.is_some() {
+                return;
+            }
+
             // Just clear the target
             let mut encoder = self
                 .device
@@ -3090,20 +3893,11 @@ impl GpuRenderer {
         }
 
         // Update uniforms
-        let uniforms = Uniforms {
-            viewport_size: [self.viewport_size.0 as f32, self.viewport_size.1 as f32],
-            _padding: [0.0; 2],
-        };
-        self.queue
-            .write_buffer(&self.buffers.uniforms, 0, bytemuck::bytes_of(&uniforms));
+        self.write_uniforms([self.viewport_size.0 as f32, self.viewport_size.1 as f32]);
 
         // Update primitives buffer with filtered primitives
         if !included_primitives.is_empty() {
-            self.queue.write_buffer(
-                &self.buffers.primitives,
-                0,
-                bytemuck::cast_slice(&included_primitives),
-            );
+            self.upload_primitives(&included_primitives);
         }
 
         // Update path buffers if we have path geometry
@@ -3119,6 +3913,19 @@ impl GpuRenderer {
                 label: Some("Filtered Render Encoder"),
             });
 
+        // Same as `render_with_clear_simple`: keep the previous frame outside
+        // the scissor on partial redraws
+        let load = if self.scissor.is_some() {
+            wgpu::LoadOp::Load
+        } else {
+            wgpu::LoadOp::Clear(wgpu::Color {
+                r: clear_color[0],
+                g: clear_color[1],
+                b: clear_color[2],
+                a: clear_color[3],
+            })
+        };
+
         // Begin render pass
         {
             let mut render_pass = encoder.begin_render_pass(&wgpu::RenderPassDescriptor {
@@ -3127,12 +3934,7 @@ impl GpuRenderer {
                     view: target,
                     resolve_target: None,
                     ops: wgpu::Operations {
-                        load: wgpu::LoadOp::Clear(wgpu::Color {
-                            r: clear_color[0],
-                            g: clear_color[1],
-                            b: clear_color[2],
-                            a: clear_color[3],
-                        }),
+                        load,
                         store: wgpu::StoreOp::Store,
                     },
                 })],
@@ -3141,11 +3943,14 @@ impl GpuRenderer {
                 occlusion_query_set: None,
             });
 
+            self.apply_scissor(&mut render_pass);
+
             // Render SDF primitives (filtered)
             if !included_primitives.is_empty() {
                 render_pass.set_pipeline(&self.pipelines.sdf);
                 render_pass.set_bind_group(0, &self.bind_groups.sdf, &[]);
                 render_pass.draw(0..6, 0..included_primitives.len() as u32);
+                self.count_draw_call();
             }
 
             // Render paths (always rendered - path filtering would be more complex)
@@ -3158,6 +3963,7 @@ impl GpuRenderer {
                     render_pass.set_vertex_buffer(0, vb.slice(..));
                     render_pass.set_index_buffer(ib.slice(..), wgpu::IndexFormat::Uint32);
                     render_pass.draw_indexed(0..batch.paths.indices.len() as u32, 0, 0..1);
+                    self.count_draw_call();
                 }
             }
         }
@@ -3261,20 +4067,11 @@ impl GpuRenderer {
         clear_color: [f64; 4],
     ) {
         // Update uniforms
-        let uniforms = Uniforms {
-            viewport_size: [self.viewport_size.0 as f32, self.viewport_size.1 as f32],
-            _padding: [0.0; 2],
-        };
-        self.queue
-            .write_buffer(&self.buffers.uniforms, 0, bytemuck::bytes_of(&uniforms));
+        self.write_uniforms([self.viewport_size.0 as f32, self.viewport_size.1 as f32]);
 
         // Update primitives buffer
         if !batch.primitives.is_empty() {
-            self.queue.write_buffer(
-                &self.buffers.primitives,
-                0,
-                bytemuck::cast_slice(&batch.primitives),
-            );
+            self.upload_primitives(&batch.primitives);
         }
 
         // Update path buffers if we have path geometry
@@ -3317,6 +4114,7 @@ impl GpuRenderer {
                 render_pass.set_pipeline(&self.pipelines.sdf);
                 render_pass.set_bind_group(0, &self.bind_groups.sdf, &[]);
                 render_pass.draw(0..6, 0..batch.primitives.len() as u32);
+                self.count_draw_call();
             }
 
             // Render paths
@@ -3329,6 +4127,7 @@ impl GpuRenderer {
                     render_pass.set_vertex_buffer(0, vb.slice(..));
                     render_pass.set_index_buffer(ib.slice(..), wgpu::IndexFormat::Uint32);
                     render_pass.draw_indexed(0..batch.paths.indices.len() as u32, 0, 0..1);
+                    self.count_draw_call();
                 }
             }
         }
@@ -3337,6 +4136,208 @@ impl GpuRenderer {
         self.queue.submit(std::iter::once(encoder.finish()));
     }
 
+    /// Note the primitives about to be drawn into the glass backdrop
+    ///
+    /// In `BlurMode::Performance` returns true when they match what the
+    /// backdrop already holds, so drawing it (and prefiltering it) again can
+    /// be skipped. Unchanged background content is exactly the case where
+    /// nothing under the glass was damaged. `clear_black` distinguishes the
+    /// two backdrop passes, which clear differently. Never reused while
+    /// `set_backdrop_animating` is on.
+    fn update_backdrop_content(
+        &mut self,
+        primitives: &[GpuPrimitive],
+        backdrop_size: (u32, u32),
+        clear_black: bool,
+    ) -> bool {
+        use std::hash::{Hash, Hasher};
+
+        self.backdrop_blur.size = backdrop_size;
+        if self.config.blur_mode != BlurMode::Performance || self.backdrop_animating {
+            self.backdrop_blur.content_key = None;
+            self.backdrop_blur.prefilter = None;
+            return false;
+        }
+
+        let mut hasher = std::collections::hash_map::DefaultHasher::new();
+        self.viewport_size.hash(&mut hasher);
+        backdrop_size.hash(&mut hasher);
+        clear_black.hash(&mut hasher);
+        bytemuck::cast_slice::<GpuPrimitive, u8>(primitives).hash(&mut hasher);
+        let key = hasher.finish();
+
+        if self.backdrop_blur.content_key == Some(key) {
+            return true;
+        }
+        self.backdrop_blur.content_key = Some(key);
+        self.backdrop_blur.prefilter = None;
+        false
+    }
+
+    /// Choose the pyramid blur to prefilter the backdrop with for `glass`
+    ///
+    /// Only in `BlurMode::Performance`. The prefilter is the smallest blur any
+    /// of the primitives asks for, so none of them ends up blurrier than
+    /// requested; the glass shaders add whatever remains.
+    fn plan_backdrop_prefilter(
+        &mut self,
+        glass: &[GpuGlassPrimitive],
+    ) -> Option<BackdropPrefilter> {
+        let size = self.backdrop_blur.size;
+        if self.config.blur_mode != BlurMode::Performance || size.0 == 0 || size.1 == 0 {
+            return None;
+        }
+        let radius = glass
+            .iter()
+            .map(|p| p.params[0])
+            .fold(f32::INFINITY, f32::min);
+        // Backdrop pixels per viewport pixel
+        let scale = size.0 as f32 / self.viewport_size.0.max(1) as f32;
+        if !radius.is_finite() || radius * scale < 1.0 {
+            return None;
+        }
+
+        let (levels, offset) = blur::pyramid_params(radius * scale);
+        let levels = self
+            .blur_pyramids
+            .get(size, self.texture_format)
+            .clamp_levels(levels);
+        if levels == 0 {
+            return None;
+        }
+        Some(BackdropPrefilter {
+            levels,
+            offset,
+            radius: (blur::pyramid_radius(levels, offset) / scale).min(radius),
+        })
+    }
+
+    /// Record `prefilter` of `backdrop` into the pyramid output, unless the
+    /// output already holds it
+    fn record_backdrop_prefilter(
+        &mut self,
+        encoder: &mut wgpu::CommandEncoder,
+        backdrop: &wgpu::TextureView,
+        prefilter: BackdropPrefilter,
+    ) {
+        let size = self.backdrop_blur.size;
+        let format = self.texture_format;
+        self.blur_pyramids.get(size, format);
+        let generation = self.blur_pyramids.generation();
+        if self.backdrop_blur.prefilter == Some((prefilter, generation)) {
+            return;
+        }
+
+        let effect_pipelines = self.effect_pipelines.get();
+        let pipelines = DualBlurPipelines {
+            down: &effect_pipelines.blur_down,
+            up: &effect_pipelines.blur_up,
+            up_color: &effect_pipelines.blur_up_color,
+            layout: &self.bind_group_layouts.blur,
+            sampler: &self.path_image_sampler,
+        };
+        let draws = self.blur_pyramids.get(size, format).record_into_output(
+            &self.device,
+            &self.queue,
+            encoder,
+            &pipelines,
+            backdrop,
+            prefilter.levels,
+            prefilter.offset,
+        );
+        self.count_draw_calls(draws);
+        self.backdrop_blur.prefilter = Some((prefilter, generation));
+    }
+
+    /// Create the glass bind group unless the cached one is still valid
+    ///
+    /// With `prefiltered` the bind group samples the pyramid's blurred copy
+    /// of the backdrop instead of `backdrop` itself. `force` rebuilds it
+    /// regardless (e.g. after the glass primitive buffer grew).
+    fn ensure_glass_bind_group(
+        &mut self,
+        backdrop: &wgpu::TextureView,
+        prefiltered: bool,
+        force: bool,
+    ) {
+        let current_size = self.viewport_size;
+        let prefiltered = prefiltered.then(|| self.blur_pyramids.generation());
+
+        let need_new_bind_group = force
+            || match &self.cached_glass {
+                None => true,
+                Some(cached) => {
+                    cached.bind_group.is_none()
+                        || cached.bind_group_size != current_size
+                        || cached.bind_group_prefiltered != prefiltered
+                }
+            };
+        if !need_new_bind_group {
+            return;
+        }
+
+        // The sampler is reused across frames
+        if self.cached_glass.is_none() {
+            let sampler = self.device.create_sampler(&wgpu::SamplerDescriptor {
+                label: Some("Glass Backdrop Sampler"),
+                address_mode_u: wgpu::AddressMode::ClampToEdge,
+                address_mode_v: wgpu::AddressMode::ClampToEdge,
+                address_mode_w: wgpu::AddressMode::ClampToEdge,
+                mag_filter: wgpu::FilterMode::Linear,
+                min_filter: wgpu::FilterMode::Linear,
+                mipmap_filter: wgpu::FilterMode::Nearest,
+                ..Default::default()
+            });
+            self.cached_glass = Some(CachedGlassResources {
+                sampler,
+                bind_group: None,
+                bind_group_size: (0, 0),
+                bind_group_prefiltered: None,
+            });
+        }
+
+        let backdrop_view = match prefiltered {
+            Some(_) => {
+                &self
+                    .blur_pyramids
+                    .get(self.backdrop_blur.size, self.texture_format)
+                    .output(&self.device)
+                    .view
+            }
+            None => backdrop,
+        };
+
+        let cached_glass = self.cached_glass.as_ref().unwrap();
+        let bind_group = self.device.create_bind_group(&wgpu::BindGroupDescriptor {
+            label: Some("Glass Bind Group"),
+            layout: &self.bind_group_layouts.glass,
+            entries: &[
+                wgpu::BindGroupEntry {
+                    binding: 0,
+                    resource: self.buffers.glass_uniforms.as_entire_binding(),
+                },
+                wgpu::BindGroupEntry {
+                    binding: 1,
+                    resource: self.buffers.glass_primitives.as_entire_binding(),
+                },
+                wgpu::BindGroupEntry {
+                    binding: 2,
+                    resource: wgpu::BindingResource::TextureView(backdrop_view),
+                },
+                wgpu::BindGroupEntry {
+                    binding: 3,
+                    resource: wgpu::BindingResource::Sampler(&cached_glass.sampler),
+                },
+            ],
+        });
+
+        if let Some(ref mut cached) = self.cached_glass {
+            cached.bind_group = Some(bind_group);
+            cached.bind_group_size = current_size;
+            cached.bind_group_prefiltered = prefiltered;
+        }
+    }
+
     /// Render glass primitives (requires backdrop texture)
     ///
     /// Splits primitives into simple (frosted) and liquid (refracted) glass,
@@ -3375,83 +4376,36 @@ impl GpuRenderer {
         let mut ordered_primitives = simple_primitives;
         ordered_primitives.extend(liquid_primitives);
 
-        // Ensure glass resources are cached (sampler is reused across frames)
-        let current_size = self.viewport_size;
-
-        // Check if we need to create or recreate the cached glass resources
-        let need_new_bind_group = match &self.cached_glass {
-            None => true,
-            Some(cached) => cached.bind_group.is_none() || cached.bind_group_size != current_size,
-        };
-
-        if self.cached_glass.is_none() {
-            let sampler = self.device.create_sampler(&wgpu::SamplerDescriptor {
-                label: Some("Glass Backdrop Sampler"),
-                address_mode_u: wgpu::AddressMode::ClampToEdge,
-                address_mode_v: wgpu::AddressMode::ClampToEdge,
-                address_mode_w: wgpu::AddressMode::ClampToEdge,
-                mag_filter: wgpu::FilterMode::Linear,
-                min_filter: wgpu::FilterMode::Linear,
-                mipmap_filter: wgpu::FilterMode::Nearest,
-                ..Default::default()
-            });
-            self.cached_glass = Some(CachedGlassResources {
-                sampler,
-                bind_group: None,
-                bind_group_size: (0, 0),
-            });
-        }
+        // In performance mode, blur the backdrop through the pyramid first
+        // so the glass shaders only add the remaining blur
+        let prefilter = self.plan_backdrop_prefilter(&ordered_primitives);
 
         // Update glass uniforms
         let glass_uniforms = GlassUniforms {
             viewport_size: [self.viewport_size.0 as f32, self.viewport_size.1 as f32],
-            time: self.time,
-            _padding: 0.0,
-        };
-        self.queue.write_buffer(
-            &self.buffers.glass_uniforms,
-            0,
-            bytemuck::bytes_of(&glass_uniforms),
-        );
-
-        // Update glass primitives buffer with ordered primitives
-        self.queue.write_buffer(
-            &self.buffers.glass_primitives,
-            0,
-            bytemuck::cast_slice(&ordered_primitives),
-        );
-
-        // Create or reuse glass bind group
-        if need_new_bind_group {
-            let cached_glass = self.cached_glass.as_ref().unwrap();
-            let bind_group = self.device.create_bind_group(&wgpu::BindGroupDescriptor {
-                label: Some("Glass Bind Group"),
-                layout: &self.bind_group_layouts.glass,
-                entries: &[
-                    wgpu::BindGroupEntry {
-                        binding: 0,
-                        resource: self.buffers.glass_uniforms.as_entire_binding(),
-                    },
-                    wgpu::BindGroupEntry {
-                        binding: 1,
-                        resource: self.buffers.glass_primitives.as_entire_binding(),
-                    },
-                    wgpu::BindGroupEntry {
-                        binding: 2,
-                        resource: wgpu::BindingResource::TextureView(backdrop),
-                    },
-                    wgpu::BindGroupEntry {
-                        binding: 3,
-                        resource: wgpu::BindingResource::Sampler(&cached_glass.sampler),
-                    },
-                ],
+            time: self.time,
+            backdrop_blur: prefilter.map_or(0.0, |p| p.radius),
+        };
+        self.queue.write_buffer(
+            &self.buffers.glass_uniforms,
+            0,
+            bytemuck::bytes_of(&glass_uniforms),
+        );
+
+        // Update glass primitives buffer with ordered primitives (a grown
+        // buffer needs a new bind group)
+        let grown = self.upload_glass_primitives(&ordered_primitives);
+        self.ensure_glass_bind_group(backdrop, prefilter.is_some(), grown);
+
+        // Create command encoder
+        let mut encoder = self
+            .device
+            .create_command_encoder(&wgpu::CommandEncoderDescriptor {
+                label: Some("Blinc Glass Render Encoder"),
             });
 
-            // Update cache
-            if let Some(ref mut cached) = self.cached_glass {
-                cached.bind_group = Some(bind_group);
-                cached.bind_group_size = current_size;
-            }
+        if let Some(prefilter) = prefilter {
+            self.record_backdrop_prefilter(&mut encoder, backdrop, prefilter);
         }
 
         let glass_bind_group = self
@@ -3462,13 +4416,6 @@ impl GpuRenderer {
             .as_ref()
             .unwrap();
 
-        // Create command encoder
-        let mut encoder = self
-            .device
-            .create_command_encoder(&wgpu::CommandEncoderDescriptor {
-                label: Some("Blinc Glass Render Encoder"),
-            });
-
         // Begin render pass (load existing content)
         {
             let mut render_pass = encoder.begin_render_pass(&wgpu::RenderPassDescriptor {
@@ -3488,19 +4435,21 @@ impl GpuRenderer {
 
             // Render simple glass primitives with the simple_glass pipeline
             if simple_count > 0 {
-                render_pass.set_pipeline(&self.pipelines.simple_glass);
+                render_pass.set_pipeline(&self.effect_pipelines.get().simple_glass);
                 render_pass.set_bind_group(0, glass_bind_group, &[]);
                 render_pass.draw(0..6, 0..simple_count as u32);
+                self.count_draw_call();
             }
 
             // Render liquid glass primitives with the glass pipeline
             if liquid_count > 0 {
-                render_pass.set_pipeline(&self.pipelines.glass);
+                render_pass.set_pipeline(&self.effect_pipelines.get().glass);
                 render_pass.set_bind_group(0, glass_bind_group, &[]);
                 render_pass.draw(
                     0..6,
                     simple_count as u32..(simple_count + liquid_count) as u32,
                 );
+                self.count_draw_call();
             }
         }
 
@@ -3515,32 +4464,24 @@ impl GpuRenderer {
     pub fn render_to_backdrop(
         &mut self,
         backdrop: &wgpu::TextureView,
-        _backdrop_size: (u32, u32),
+        backdrop_size: (u32, u32),
         batch: &PrimitiveBatch,
     ) {
         if batch.primitives.is_empty() {
             return;
         }
+        if self.update_backdrop_content(&batch.primitives, backdrop_size, true) {
+            // Same content as the last backdrop, which is still in the texture
+            return;
+        }
 
         // Use full viewport size for coordinate mapping, even though texture is smaller.
         // GPU automatically maps NDC space to the texture size, ensuring primitives
         // appear at correct relative positions for glass sampling.
-        let main_uniforms = Uniforms {
-            viewport_size: [self.viewport_size.0 as f32, self.viewport_size.1 as f32],
-            _padding: [0.0; 2],
-        };
-        self.queue.write_buffer(
-            &self.buffers.uniforms,
-            0,
-            bytemuck::bytes_of(&main_uniforms),
-        );
+        self.write_uniforms([self.viewport_size.0 as f32, self.viewport_size.1 as f32]);
 
         // Update primitives buffer
-        self.queue.write_buffer(
-            &self.buffers.primitives,
-            0,
-            bytemuck::cast_slice(&batch.primitives),
-        );
+        self.upload_primitives(&batch.primitives);
 
         // Create command encoder
         let mut encoder = self
@@ -3569,11 +4510,12 @@ impl GpuRenderer {
             render_pass.set_pipeline(&self.pipelines.sdf);
             render_pass.set_bind_group(0, &self.bind_groups.sdf, &[]);
             render_pass.draw(0..6, 0..batch.primitives.len() as u32);
+            self.count_draw_call();
         }
 
         // Submit commands
         self.queue.submit(std::iter::once(encoder.finish()));
-        // Note: No need to restore uniforms since we're already using main_uniforms
+        // Note: No need to restore uniforms since we're already using the main viewport
     }
 
     /// Render glass frame with backdrop and glass primitives in a single encoder submission.
@@ -3587,23 +4529,16 @@ impl GpuRenderer {
         &mut self,
         target: &wgpu::TextureView,
         backdrop: &wgpu::TextureView,
-        _backdrop_size: (u32, u32), // Not used - we render with full viewport coords
+        backdrop_size: (u32, u32),
         batch: &PrimitiveBatch,
     ) {
         // Update uniforms for rendering (always use full viewport size)
         // The GPU maps NDC space to actual texture size automatically
-        let main_uniforms = Uniforms {
-            viewport_size: [self.viewport_size.0 as f32, self.viewport_size.1 as f32],
-            _padding: [0.0; 2],
-        };
+        let main_viewport = [self.viewport_size.0 as f32, self.viewport_size.1 as f32];
 
         // Update primitives buffer
         if !batch.primitives.is_empty() {
-            self.queue.write_buffer(
-                &self.buffers.primitives,
-                0,
-                bytemuck::cast_slice(&batch.primitives),
-            );
+            self.upload_primitives(&batch.primitives);
         }
 
         // Split glass primitives into simple and liquid for separate rendering
@@ -3624,19 +4559,19 @@ impl GpuRenderer {
         ordered_glass_primitives.extend(liquid_primitives);
 
         // Update glass primitives buffer with ordered primitives
+        let mut grown = false;
         if !ordered_glass_primitives.is_empty() {
-            self.queue.write_buffer(
-                &self.buffers.glass_primitives,
-                0,
-                bytemuck::cast_slice(&ordered_glass_primitives),
-            );
+            grown = self.upload_glass_primitives(&ordered_glass_primitives);
         }
 
+        let reuse_backdrop = self.update_backdrop_content(&batch.primitives, backdrop_size, false);
+        let prefilter = self.plan_backdrop_prefilter(&ordered_glass_primitives);
+
         // Update glass uniforms
         let glass_uniforms = GlassUniforms {
             viewport_size: [self.viewport_size.0 as f32, self.viewport_size.1 as f32],
             time: self.time,
-            _padding: 0.0,
+            backdrop_blur: prefilter.map_or(0.0, |p| p.radius),
         };
         self.queue.write_buffer(
             &self.buffers.glass_uniforms,
@@ -3644,60 +4579,7 @@ impl GpuRenderer {
             bytemuck::bytes_of(&glass_uniforms),
         );
 
-        // Ensure glass bind group is cached
-        let current_size = self.viewport_size;
-        let need_new_bind_group = match &self.cached_glass {
-            None => true,
-            Some(cached) => cached.bind_group.is_none() || cached.bind_group_size != current_size,
-        };
-
-        if self.cached_glass.is_none() {
-            let sampler = self.device.create_sampler(&wgpu::SamplerDescriptor {
-                label: Some("Glass Backdrop Sampler"),
-                address_mode_u: wgpu::AddressMode::ClampToEdge,
-                address_mode_v: wgpu::AddressMode::ClampToEdge,
-                address_mode_w: wgpu::AddressMode::ClampToEdge,
-                mag_filter: wgpu::FilterMode::Linear,
-                min_filter: wgpu::FilterMode::Linear,
-                mipmap_filter: wgpu::FilterMode::Nearest,
-                ..Default::default()
-            });
-            self.cached_glass = Some(CachedGlassResources {
-                sampler,
-                bind_group: None,
-                bind_group_size: (0, 0),
-            });
-        }
-
-        if need_new_bind_group {
-            let cached_glass = self.cached_glass.as_ref().unwrap();
-            let bind_group = self.device.create_bind_group(&wgpu::BindGroupDescriptor {
-                label: Some("Glass Bind Group"),
-                layout: &self.bind_group_layouts.glass,
-                entries: &[
-                    wgpu::BindGroupEntry {
-                        binding: 0,
-                        resource: self.buffers.glass_uniforms.as_entire_binding(),
-                    },
-                    wgpu::BindGroupEntry {
-                        binding: 1,
-                        resource: self.buffers.glass_primitives.as_entire_binding(),
-                    },
-                    wgpu::BindGroupEntry {
-                        binding: 2,
-                        resource: wgpu::BindingResource::TextureView(backdrop),
-                    },
-                    wgpu::BindGroupEntry {
-                        binding: 3,
-                        resource: wgpu::BindingResource::Sampler(&cached_glass.sampler),
-                    },
-                ],
-            });
-            if let Some(ref mut cached) = self.cached_glass {
-                cached.bind_group = Some(bind_group);
-                cached.bind_group_size = current_size;
-            }
-        }
+        self.ensure_glass_bind_group(backdrop, prefilter.is_some(), grown);
 
         // Create single command encoder for entire frame
         let mut encoder = self
@@ -3707,16 +4589,13 @@ impl GpuRenderer {
             });
 
         // Pass 1: Render background primitives to backdrop texture (at half resolution)
-        // NOTE: We use main_uniforms (full viewport size) for coordinate mapping,
+        // NOTE: We use main_viewport (full viewport size) for coordinate mapping,
         // even though the texture is half resolution. The GPU automatically maps
         // NDC space to the texture size. This ensures primitives appear at correct
         // relative positions for glass sampling.
-        {
-            self.queue.write_buffer(
-                &self.buffers.uniforms,
-                0,
-                bytemuck::bytes_of(&main_uniforms),
-            );
+        // Skipped when the background is unchanged since the last frame
+        if !reuse_backdrop {
+            self.write_uniforms(main_viewport);
 
             let mut render_pass = encoder.begin_render_pass(&wgpu::RenderPassDescriptor {
                 label: Some("Backdrop Render Pass"),
@@ -3737,16 +4616,17 @@ impl GpuRenderer {
                 render_pass.set_pipeline(&self.pipelines.sdf);
                 render_pass.set_bind_group(0, &self.bind_groups.sdf, &[]);
                 render_pass.draw(0..6, 0..batch.primitives.len() as u32);
+                self.count_draw_call();
             }
         }
 
+        if let Some(prefilter) = prefilter {
+            self.record_backdrop_prefilter(&mut encoder, backdrop, prefilter);
+        }
+
         // Pass 2: Render background primitives to target (at full resolution)
         {
-            self.queue.write_buffer(
-                &self.buffers.uniforms,
-                0,
-                bytemuck::bytes_of(&main_uniforms),
-            );
+            self.write_uniforms(main_viewport);
 
             let mut render_pass = encoder.begin_render_pass(&wgpu::RenderPassDescriptor {
                 label: Some("Target Background Pass"),
@@ -3767,6 +4647,7 @@ impl GpuRenderer {
                 render_pass.set_pipeline(&self.pipelines.sdf);
                 render_pass.set_bind_group(0, &self.bind_groups.sdf, &[]);
                 render_pass.draw(0..6, 0..batch.primitives.len() as u32);
+                self.count_draw_call();
             }
         }
 
@@ -3797,19 +4678,21 @@ impl GpuRenderer {
 
             // Render simple glass primitives with simple_glass pipeline
             if simple_count > 0 {
-                render_pass.set_pipeline(&self.pipelines.simple_glass);
+                render_pass.set_pipeline(&self.effect_pipelines.get().simple_glass);
                 render_pass.set_bind_group(0, glass_bind_group, &[]);
                 render_pass.draw(0..6, 0..simple_count as u32);
+                self.count_draw_call();
             }
 
             // Render liquid glass primitives with glass pipeline
             if liquid_count > 0 {
-                render_pass.set_pipeline(&self.pipelines.glass);
+                render_pass.set_pipeline(&self.effect_pipelines.get().glass);
                 render_pass.set_bind_group(0, glass_bind_group, &[]);
                 render_pass.draw(
                     0..6,
                     simple_count as u32..(simple_count + liquid_count) as u32,
                 );
+                self.count_draw_call();
             }
         }
 
@@ -3820,11 +4703,7 @@ impl GpuRenderer {
         // This requires a separate submission because we need to overwrite the primitives buffer
         if !batch.foreground_primitives.is_empty() {
             // Upload foreground primitives to the buffer
-            self.queue.write_buffer(
-                &self.buffers.primitives,
-                0,
-                bytemuck::cast_slice(&batch.foreground_primitives),
-            );
+            self.upload_primitives(&batch.foreground_primitives);
 
             let mut encoder = self
                 .device
@@ -3850,6 +4729,7 @@ impl GpuRenderer {
             render_pass.set_pipeline(&self.pipelines.sdf);
             render_pass.set_bind_group(0, &self.bind_groups.sdf, &[]);
             render_pass.draw(0..6, 0..batch.foreground_primitives.len() as u32);
+            self.count_draw_call();
 
             drop(render_pass);
             self.queue.submit(std::iter::once(encoder.finish()));
@@ -3892,6 +4772,7 @@ impl GpuRenderer {
                 render_pass.set_vertex_buffer(0, vb.slice(..));
                 render_pass.set_index_buffer(ib.slice(..), wgpu::IndexFormat::Uint32);
                 render_pass.draw_indexed(0..batch.paths.indices.len() as u32, 0, 0..1);
+                self.count_draw_call();
 
                 drop(render_pass);
                 self.queue.submit(std::iter::once(encoder.finish()));
@@ -3926,20 +4807,11 @@ impl GpuRenderer {
 
         // Standard overlay rendering (no layer effects)
         // Update uniforms
-        let uniforms = Uniforms {
-            viewport_size: [self.viewport_size.0 as f32, self.viewport_size.1 as f32],
-            _padding: [0.0; 2],
-        };
-        self.queue
-            .write_buffer(&self.buffers.uniforms, 0, bytemuck::bytes_of(&uniforms));
+        self.write_uniforms([self.viewport_size.0 as f32, self.viewport_size.1 as f32]);
 
         // Update primitives buffer
         if !batch.primitives.is_empty() {
-            self.queue.write_buffer(
-                &self.buffers.primitives,
-                0,
-                bytemuck::cast_slice(&batch.primitives),
-            );
+            self.upload_primitives(&batch.primitives);
         }
 
         // Update path buffers if we have path geometry
@@ -3972,6 +4844,8 @@ impl GpuRenderer {
                 occlusion_query_set: None,
             });
 
+            self.apply_scissor(&mut render_pass);
+
             // Render paths first (they're typically backgrounds)
             if has_paths {
                 if let (Some(vb), Some(ib)) =
@@ -3982,6 +4856,7 @@ impl GpuRenderer {
                     render_pass.set_vertex_buffer(0, vb.slice(..));
                     render_pass.set_index_buffer(ib.slice(..), wgpu::IndexFormat::Uint32);
                     render_pass.draw_indexed(0..batch.paths.indices.len() as u32, 0, 0..1);
+                    self.count_draw_call();
                 }
             }
 
@@ -3990,6 +4865,7 @@ impl GpuRenderer {
                 render_pass.set_pipeline(&self.pipelines.sdf_overlay);
                 render_pass.set_bind_group(0, &self.bind_groups.sdf, &[]);
                 render_pass.draw(0..6, 0..batch.primitives.len() as u32);
+                self.count_draw_call();
             }
         }
 
@@ -4087,20 +4963,11 @@ impl GpuRenderer {
     /// Simple overlay render without layer effect processing
     fn render_overlay_simple(&mut self, target: &wgpu::TextureView, batch: &PrimitiveBatch) {
         // Update uniforms
-        let uniforms = Uniforms {
-            viewport_size: [self.viewport_size.0 as f32, self.viewport_size.1 as f32],
-            _padding: [0.0; 2],
-        };
-        self.queue
-            .write_buffer(&self.buffers.uniforms, 0, bytemuck::bytes_of(&uniforms));
+        self.write_uniforms([self.viewport_size.0 as f32, self.viewport_size.1 as f32]);
 
         // Update primitives buffer
         if !batch.primitives.is_empty() {
-            self.queue.write_buffer(
-                &self.buffers.primitives,
-                0,
-                bytemuck::cast_slice(&batch.primitives),
-            );
+            self.upload_primitives(&batch.primitives);
         }
 
         // Update path buffers if we have path geometry
@@ -4133,6 +5000,8 @@ impl GpuRenderer {
                 occlusion_query_set: None,
             });
 
+            self.apply_scissor(&mut render_pass);
+
             // Render paths first
             if has_paths {
                 if let (Some(vb), Some(ib)) =
@@ -4143,6 +5012,7 @@ impl GpuRenderer {
                     render_pass.set_vertex_buffer(0, vb.slice(..));
                     render_pass.set_index_buffer(ib.slice(..), wgpu::IndexFormat::Uint32);
                     render_pass.draw_indexed(0..batch.paths.indices.len() as u32, 0, 0..1);
+                    self.count_draw_call();
                 }
             }
 
@@ -4151,6 +5021,7 @@ impl GpuRenderer {
                 render_pass.set_pipeline(&self.pipelines.sdf_overlay);
                 render_pass.set_bind_group(0, &self.bind_groups.sdf, &[]);
                 render_pass.draw(0..6, 0..batch.primitives.len() as u32);
+                self.count_draw_call();
             }
         }
 
@@ -4172,19 +5043,10 @@ impl GpuRenderer {
         }
 
         // Update uniforms
-        let uniforms = Uniforms {
-            viewport_size: [self.viewport_size.0 as f32, self.viewport_size.1 as f32],
-            _padding: [0.0; 2],
-        };
-        self.queue
-            .write_buffer(&self.buffers.uniforms, 0, bytemuck::bytes_of(&uniforms));
+        self.write_uniforms([self.viewport_size.0 as f32, self.viewport_size.1 as f32]);
 
         // Update primitives buffer
-        self.queue.write_buffer(
-            &self.buffers.primitives,
-            0,
-            bytemuck::cast_slice(primitives),
-        );
+        self.upload_primitives(primitives);
 
         // Create command encoder
         let mut encoder = self
@@ -4210,10 +5072,13 @@ impl GpuRenderer {
                 occlusion_query_set: None,
             });
 
+            self.apply_scissor(&mut render_pass);
+
             // Render SDF primitives
             render_pass.set_pipeline(&self.pipelines.sdf_overlay);
             render_pass.set_bind_group(0, &self.bind_groups.sdf, &[]);
             render_pass.draw(0..6, 0..primitives.len() as u32);
+            self.count_draw_call();
         }
 
         // Submit commands
@@ -4256,12 +5121,15 @@ impl GpuRenderer {
                 occlusion_query_set: None,
             });
 
+            self.apply_scissor(&mut render_pass);
+
             // Use overlay path pipeline (1x sampled)
             render_pass.set_pipeline(&self.pipelines.path_overlay);
             render_pass.set_bind_group(0, &self.bind_groups.path, &[]);
             render_pass.set_vertex_buffer(0, vb.slice(..));
             render_pass.set_index_buffer(ib.slice(..), wgpu::IndexFormat::Uint32);
             render_pass.draw_indexed(0..batch.paths.indices.len() as u32, 0, 0..1);
+            self.count_draw_call();
 
             drop(render_pass);
             self.queue.submit(std::iter::once(encoder.finish()));
@@ -4278,31 +5146,24 @@ impl GpuRenderer {
     /// * `primitives` - The SDF primitives including text glyph primitives
     /// * `atlas_view` - The grayscale glyph atlas texture view
     /// * `color_atlas_view` - The color (RGBA) glyph atlas texture view for emoji
+    /// * `atlas_generation` - `TextRenderingContext::atlas_generation` of the atlases
     pub fn render_primitives_overlay_with_glyphs(
         &mut self,
         target: &wgpu::TextureView,
         primitives: &[GpuPrimitive],
         atlas_view: &wgpu::TextureView,
         color_atlas_view: &wgpu::TextureView,
+        atlas_generation: u64,
     ) {
         if primitives.is_empty() {
             return;
         }
 
         // Update uniforms
-        let uniforms = Uniforms {
-            viewport_size: [self.viewport_size.0 as f32, self.viewport_size.1 as f32],
-            _padding: [0.0; 2],
-        };
-        self.queue
-            .write_buffer(&self.buffers.uniforms, 0, bytemuck::bytes_of(&uniforms));
+        self.write_uniforms([self.viewport_size.0 as f32, self.viewport_size.1 as f32]);
 
         // Update primitives buffer
-        self.queue.write_buffer(
-            &self.buffers.primitives,
-            0,
-            bytemuck::cast_slice(primitives),
-        );
+        self.upload_primitives(primitives);
 
         // Check if we need to recreate the SDF bind group with actual glyph textures
         let atlas_view_ptr = atlas_view as *const wgpu::TextureView;
@@ -4311,6 +5172,7 @@ impl GpuRenderer {
             Some(cached) => {
                 cached.atlas_view_ptr != atlas_view_ptr
                     || cached.color_atlas_view_ptr != color_atlas_view_ptr
+                    || cached.atlas_generation != atlas_generation
             }
             None => true,
         };
@@ -4346,6 +5208,7 @@ impl GpuRenderer {
                 bind_group,
                 atlas_view_ptr,
                 color_atlas_view_ptr,
+                atlas_generation,
             });
         }
 
@@ -4375,16 +5238,40 @@ impl GpuRenderer {
                 occlusion_query_set: None,
             });
 
+            self.apply_scissor(&mut render_pass);
+
             // Render SDF primitives (including text glyphs)
             render_pass.set_pipeline(&self.pipelines.sdf_overlay);
             render_pass.set_bind_group(0, sdf_bind_group, &[]);
             render_pass.draw(0..6, 0..primitives.len() as u32);
+            self.count_draw_call();
         }
 
         // Submit commands
         self.queue.submit(std::iter::once(encoder.finish()));
     }
 
+    /// Create the MSAA pipelines for `sample_count` unless they exist
+    ///
+    /// The pipeline cache is saved afterwards, since these are compiled
+    /// after the save at init.
+    fn ensure_msaa_pipelines(&mut self, sample_count: u32) {
+        let need_new_pipelines = match &self.msaa_pipelines {
+            Some(p) => p.sample_count != sample_count,
+            None => true,
+        };
+        if need_new_pipelines && sample_count > 1 {
+            self.msaa_pipelines = Some(Self::create_msaa_pipelines(
+                &self.device,
+                &self.bind_group_layouts,
+                self.pipeline_cache.as_ref().map(|c| c.cache()),
+                self.texture_format,
+                sample_count,
+            ));
+            self.save_pipeline_cache();
+        }
+    }
+
     /// Render overlay primitives with MSAA anti-aliasing
     ///
     /// This method renders paths/primitives to a temporary MSAA texture,
@@ -4405,19 +5292,7 @@ impl GpuRenderer {
             return;
         }
 
-        // Ensure we have MSAA pipelines for this sample count
-        let need_new_pipelines = match &self.msaa_pipelines {
-            Some(p) => p.sample_count != sample_count,
-            None => true,
-        };
-        if need_new_pipelines && sample_count > 1 {
-            self.msaa_pipelines = Some(Self::create_msaa_pipelines(
-                &self.device,
-                &self.bind_group_layouts,
-                self.texture_format,
-                sample_count,
-            ));
-        }
+        self.ensure_msaa_pipelines(sample_count);
 
         let (width, height) = self.viewport_size;
 
@@ -4531,20 +5406,11 @@ impl GpuRenderer {
         }
 
         // Update uniforms
-        let uniforms = Uniforms {
-            viewport_size: [width as f32, height as f32],
-            _padding: [0.0; 2],
-        };
-        self.queue
-            .write_buffer(&self.buffers.uniforms, 0, bytemuck::bytes_of(&uniforms));
+        self.write_uniforms([width as f32, height as f32]);
 
         // Update primitives buffer
         if !batch.primitives.is_empty() {
-            self.queue.write_buffer(
-                &self.buffers.primitives,
-                0,
-                bytemuck::cast_slice(&batch.primitives),
-            );
+            self.upload_primitives(&batch.primitives);
         }
 
         // Update path buffers
@@ -4602,6 +5468,7 @@ impl GpuRenderer {
                     render_pass.set_vertex_buffer(0, vb.slice(..));
                     render_pass.set_index_buffer(ib.slice(..), wgpu::IndexFormat::Uint32);
                     render_pass.draw_indexed(0..batch.paths.indices.len() as u32, 0, 0..1);
+                    self.count_draw_call();
                 }
             }
 
@@ -4610,6 +5477,7 @@ impl GpuRenderer {
                 render_pass.set_pipeline(sdf_pipeline);
                 render_pass.set_bind_group(0, &self.bind_groups.sdf, &[]);
                 render_pass.draw(0..6, 0..batch.primitives.len() as u32);
+                self.count_draw_call();
             }
         }
 
@@ -4630,9 +5498,12 @@ impl GpuRenderer {
                 occlusion_query_set: None,
             });
 
+            // Blending outside the scissor would build up on partial redraws
+            self.apply_scissor(&mut render_pass);
             render_pass.set_pipeline(&self.pipelines.composite_overlay);
             render_pass.set_bind_group(0, &cached.composite_bind_group, &[]);
             render_pass.draw(0..3, 0..1); // Fullscreen triangle
+            self.count_draw_call();
         }
 
         self.queue.submit(std::iter::once(encoder.finish()));
@@ -4652,19 +5523,7 @@ impl GpuRenderer {
             return;
         }
 
-        // Ensure we have MSAA pipelines for this sample count
-        let need_new_pipelines = match &self.msaa_pipelines {
-            Some(p) => p.sample_count != sample_count,
-            None => true,
-        };
-        if need_new_pipelines && sample_count > 1 {
-            self.msaa_pipelines = Some(Self::create_msaa_pipelines(
-                &self.device,
-                &self.bind_group_layouts,
-                self.texture_format,
-                sample_count,
-            ));
-        }
+        self.ensure_msaa_pipelines(sample_count);
 
         let (width, height) = self.viewport_size;
 
@@ -4778,12 +5637,7 @@ impl GpuRenderer {
         }
 
         // Update uniforms
-        let uniforms = Uniforms {
-            viewport_size: [width as f32, height as f32],
-            _padding: [0.0; 2],
-        };
-        self.queue
-            .write_buffer(&self.buffers.uniforms, 0, bytemuck::bytes_of(&uniforms));
+        self.write_uniforms([width as f32, height as f32]);
 
         // Update path buffers
         self.update_path_buffers(batch);
@@ -4832,6 +5686,7 @@ impl GpuRenderer {
                 render_pass.set_vertex_buffer(0, vb.slice(..));
                 render_pass.set_index_buffer(ib.slice(..), wgpu::IndexFormat::Uint32);
                 render_pass.draw_indexed(0..batch.paths.indices.len() as u32, 0, 0..1);
+                self.count_draw_call();
             }
         }
 
@@ -4852,9 +5707,12 @@ impl GpuRenderer {
                 occlusion_query_set: None,
             });
 
+            // Blending outside the scissor would build up on partial redraws
+            self.apply_scissor(&mut render_pass);
             render_pass.set_pipeline(&self.pipelines.composite_overlay);
             render_pass.set_bind_group(0, &cached.composite_bind_group, &[]);
             render_pass.draw(0..3, 0..1);
+            self.count_draw_call();
         }
 
         self.queue.submit(std::iter::once(encoder.finish()));
@@ -4868,6 +5726,7 @@ impl GpuRenderer {
     /// * `atlas_view` - The grayscale glyph atlas texture view
     /// * `color_atlas_view` - The color (RGBA) glyph atlas texture view for emoji
     /// * `atlas_sampler` - The sampler for the atlases
+    /// * `atlas_generation` - `TextRenderingContext::atlas_generation` of the atlases
     pub fn render_text(
         &mut self,
         target: &wgpu::TextureView,
@@ -4875,22 +5734,17 @@ impl GpuRenderer {
         atlas_view: &wgpu::TextureView,
         color_atlas_view: &wgpu::TextureView,
         atlas_sampler: &wgpu::Sampler,
+        atlas_generation: u64,
     ) {
         if glyphs.is_empty() {
             return;
         }
 
         // Update uniforms
-        let uniforms = Uniforms {
-            viewport_size: [self.viewport_size.0 as f32, self.viewport_size.1 as f32],
-            _padding: [0.0; 2],
-        };
-        self.queue
-            .write_buffer(&self.buffers.uniforms, 0, bytemuck::bytes_of(&uniforms));
+        self.write_uniforms([self.viewport_size.0 as f32, self.viewport_size.1 as f32]);
 
         // Update glyphs buffer
-        self.queue
-            .write_buffer(&self.buffers.glyphs, 0, bytemuck::cast_slice(glyphs));
+        self.upload_glyphs(glyphs);
 
         // Check if we need to recreate the text bind group
         // Invalidate if either atlas view pointer changed (texture was recreated)
@@ -4900,6 +5754,7 @@ impl GpuRenderer {
             Some(cached) => {
                 cached.atlas_view_ptr != atlas_view_ptr
                     || cached.color_atlas_view_ptr != color_atlas_view_ptr
+                    || cached.atlas_generation != atlas_generation
             }
             None => true,
         };
@@ -4935,6 +5790,7 @@ impl GpuRenderer {
                 bind_group,
                 atlas_view_ptr,
                 color_atlas_view_ptr,
+                atlas_generation,
             });
         }
 
@@ -4964,10 +5820,13 @@ impl GpuRenderer {
                 occlusion_query_set: None,
             });
 
+            self.apply_scissor(&mut render_pass);
+
             // Use text_overlay pipeline since we're rendering to 1x sampled texture
             render_pass.set_pipeline(&self.pipelines.text_overlay);
             render_pass.set_bind_group(0, text_bind_group, &[]);
             render_pass.draw(0..6, 0..glyphs.len() as u32);
+            self.count_draw_call();
         }
 
         // Submit commands
@@ -5121,7 +5980,7 @@ impl GpuRenderer {
                 depth_stencil: None,
                 multisample: wgpu::MultisampleState::default(),
                 multiview: None,
-                cache: None,
+                cache: self.pipeline_cache.as_ref().map(|c| c.cache()),
             });
 
         // Create instance buffer (max 1000 images per batch)
@@ -5150,6 +6009,7 @@ impl GpuRenderer {
             instance_buffer,
             sampler,
         });
+        self.save_pipeline_cache();
     }
 
     /// Render images to a texture view
@@ -5174,12 +6034,7 @@ impl GpuRenderer {
         let image_pipeline = self.image_pipeline.as_ref().unwrap();
 
         // Update uniforms
-        let uniforms = Uniforms {
-            viewport_size: [self.viewport_size.0 as f32, self.viewport_size.1 as f32],
-            _padding: [0.0; 2],
-        };
-        self.queue
-            .write_buffer(&self.buffers.uniforms, 0, bytemuck::bytes_of(&uniforms));
+        self.write_uniforms([self.viewport_size.0 as f32, self.viewport_size.1 as f32]);
 
         // Update instance buffer
         self.queue.write_buffer(
@@ -5231,10 +6086,13 @@ impl GpuRenderer {
                 occlusion_query_set: None,
             });
 
+            self.apply_scissor(&mut render_pass);
+
             render_pass.set_pipeline(&image_pipeline.pipeline);
             render_pass.set_bind_group(0, &bind_group, &[]);
             render_pass.set_vertex_buffer(0, image_pipeline.instance_buffer.slice(..));
             render_pass.draw(0..6, 0..instances.len() as u32);
+            self.count_draw_call();
         }
 
         self.queue.submit(std::iter::once(encoder.finish()));
@@ -5366,6 +6224,7 @@ impl GpuRenderer {
         render_pass.set_pipeline(&self.pipelines.layer_composite);
         render_pass.set_bind_group(0, &bind_group, &[]);
         render_pass.draw(0..6, 0..1); // 6 vertices for quad (2 triangles)
+        self.count_draw_call();
     }
 
     /// Composite a layer with source/dest rectangle mapping
@@ -5445,6 +6304,7 @@ impl GpuRenderer {
         render_pass.set_pipeline(&self.pipelines.layer_composite);
         render_pass.set_bind_group(0, &bind_group, &[]);
         render_pass.draw(0..6, 0..1);
+        self.count_draw_call();
     }
 
     // ─────────────────────────────────────────────────────────────────────────────
@@ -5525,9 +6385,10 @@ impl GpuRenderer {
                 occlusion_query_set: None,
             });
 
-            render_pass.set_pipeline(&self.pipelines.blur);
+            render_pass.set_pipeline(&self.effect_pipelines.get().blur);
             render_pass.set_bind_group(0, &bind_group, &[]);
             render_pass.draw(0..6, 0..1);
+            self.count_draw_call();
         }
 
         self.queue.submit(std::iter::once(encoder.finish()));
@@ -5583,6 +6444,10 @@ impl GpuRenderer {
             return output;
         }
 
+        if self.config.blur_mode == BlurMode::Performance {
+            return self.apply_pyramid_blur(input, radius, blur_alpha);
+        }
+
         let size = input.size;
 
         // For ping-pong we need two temp textures
@@ -5616,6 +6481,68 @@ impl GpuRenderer {
         }
     }
 
+    /// Blur through the dual-filter pyramid (`BlurMode::Performance`)
+    ///
+    /// All passes go into one submission. Element blurs keep the input's
+    /// alpha like the Kawase path: the input is copied to the output first
+    /// and the last upsample only writes RGB.
+    fn apply_pyramid_blur(
+        &mut self,
+        input: &LayerTexture,
+        radius: f32,
+        blur_alpha: bool,
+    ) -> LayerTexture {
+        let output = self
+            .layer_texture_cache
+            .acquire(&self.device, input.size, false);
+        let mut encoder = self
+            .device
+            .create_command_encoder(&wgpu::CommandEncoderDescriptor {
+                label: Some("Blur Pyramid Encoder"),
+            });
+
+        if !blur_alpha {
+            encoder.copy_texture_to_texture(
+                input.texture.as_image_copy(),
+                output.texture.as_image_copy(),
+                wgpu::Extent3d {
+                    width: input.size.0,
+                    height: input.size.1,
+                    depth_or_array_layers: 1,
+                },
+            );
+        }
+
+        let (levels, offset) = blur::pyramid_params(radius);
+        let effect_pipelines = self.effect_pipelines.get();
+        let pipelines = DualBlurPipelines {
+            down: &effect_pipelines.blur_down,
+            up: &effect_pipelines.blur_up,
+            up_color: &effect_pipelines.blur_up_color,
+            layout: &self.bind_group_layouts.blur,
+            sampler: &self.path_image_sampler,
+        };
+        let draws = self
+            .blur_pyramids
+            .get(input.size, self.texture_format)
+            .record(
+                &self.device,
+                &self.queue,
+                &mut encoder,
+                &pipelines,
+                &input.view,
+                &output.view,
+                levels,
+                offset,
+                blur_alpha,
+                !blur_alpha,
+            );
+        self.count_draw_calls(draws);
+
+        self.queue.submit(std::iter::once(encoder.finish()));
+        output
+    }
+
     /// Apply multi-pass Kawase blur (element blur - preserves alpha)
     ///
     /// Convenience wrapper that preserves alpha for element blur effects.
@@ -5695,9 +6622,10 @@ impl GpuRenderer {
                 occlusion_query_set: None,
             });
 
-            render_pass.set_pipeline(&self.pipelines.color_matrix);
+            render_pass.set_pipeline(&self.effect_pipelines.get().color_matrix);
             render_pass.set_bind_group(0, &bind_group, &[]);
             render_pass.draw(0..6, 0..1);
+            self.count_draw_call();
         }
 
         self.queue.submit(std::iter::once(encoder.finish()));
@@ -5780,9 +6708,10 @@ impl GpuRenderer {
                 occlusion_query_set: None,
             });
 
-            render_pass.set_pipeline(&self.pipelines.drop_shadow);
+            render_pass.set_pipeline(&self.effect_pipelines.get().drop_shadow);
             render_pass.set_bind_group(0, &bind_group, &[]);
             render_pass.draw(0..6, 0..1);
+            self.count_draw_call();
         }
 
         self.queue.submit(std::iter::once(encoder.finish()));
@@ -5860,9 +6789,10 @@ impl GpuRenderer {
                 occlusion_query_set: None,
             });
 
-            render_pass.set_pipeline(&self.pipelines.glow);
+            render_pass.set_pipeline(&self.effect_pipelines.get().glow);
             render_pass.set_bind_group(0, &bind_group, &[]);
             render_pass.draw(0..6, 0..1);
+            self.count_draw_call();
         }
 
         self.queue.submit(std::iter::once(encoder.finish()));
@@ -6226,6 +7156,7 @@ impl GpuRenderer {
             render_pass.set_pipeline(&self.pipelines.composite);
             render_pass.set_bind_group(0, &bind_group, &[]);
             render_pass.draw(0..6, 0..1);
+            self.count_draw_call();
         }
 
         self.queue.submit(std::iter::once(encoder.finish()));
@@ -6253,19 +7184,10 @@ impl GpuRenderer {
         }
 
         // Update uniforms
-        let uniforms = Uniforms {
-            viewport_size: [self.viewport_size.0 as f32, self.viewport_size.1 as f32],
-            _padding: [0.0; 2],
-        };
-        self.queue
-            .write_buffer(&self.buffers.uniforms, 0, bytemuck::bytes_of(&uniforms));
+        self.write_uniforms([self.viewport_size.0 as f32, self.viewport_size.1 as f32]);
 
         // Write primitive range to buffer
-        self.queue.write_buffer(
-            &self.buffers.primitives,
-            0,
-            bytemuck::cast_slice(primitives),
-        );
+        self.upload_primitives(primitives);
 
         // Create command encoder
         let mut encoder = self
@@ -6299,11 +7221,53 @@ impl GpuRenderer {
             render_pass.set_pipeline(&self.pipelines.sdf);
             render_pass.set_bind_group(0, &self.bind_groups.sdf, &[]);
             render_pass.draw(0..6, 0..primitive_count as u32);
+            self.count_draw_call();
         }
 
         self.queue.submit(std::iter::once(encoder.finish()));
     }
 
+    /// Move a primitive (and its clip, if it has one) by `-offset`
+    fn offset_primitive(p: &GpuPrimitive, offset_x: f32, offset_y: f32) -> GpuPrimitive {
+        let mut op = *p;
+        op.bounds[0] -= offset_x;
+        op.bounds[1] -= offset_y;
+        // Also offset clip bounds if they're valid (not the "no clip" default)
+        // Default "no clip" is [-10000.0, -10000.0, 100000.0, 100000.0]
+        // A real clip has x > -5000 AND width < 90000 (reasonable viewport sizes)
+        let has_real_clip = op.clip_bounds[0] > -5000.0 && op.clip_bounds[2] < 90000.0;
+        if has_real_clip {
+            op.clip_bounds[0] -= offset_x;
+            op.clip_bounds[1] -= offset_y;
+        }
+        op
+    }
+
+    /// Content hash of a retained layer
+    ///
+    /// Hashes the primitives as `render_primitive_range_tight` would draw
+    /// them (relative to the layer's origin), so a layer that scrolled or
+    /// moved keeps its key. The viewport is included because it caps the
+    /// tight texture size.
+    fn retained_layer_key(
+        &self,
+        primitives: &[GpuPrimitive],
+        origin: (f32, f32),
+        layer_size: (f32, f32),
+    ) -> u64 {
+        use std::hash::{Hash, Hasher};
+
+        let mut hasher = std::collections::hash_map::DefaultHasher::new();
+        self.viewport_size.hash(&mut hasher);
+        layer_size.0.to_bits().hash(&mut hasher);
+        layer_size.1.to_bits().hash(&mut hasher);
+        for p in primitives {
+            let local = Self::offset_primitive(p, origin.0, origin.1);
+            bytemuck::bytes_of(&local).hash(&mut hasher);
+        }
+        hasher.finish()
+    }
+
     /// Render a range of primitives to a tight-fit texture with offset
     ///
     /// This method renders primitives to a texture sized to fit the content,
@@ -6356,39 +7320,17 @@ impl GpuRenderer {
         let offset_x = layer_pos.0 - effect_expansion.0;
         let offset_y = layer_pos.1 - effect_expansion.1;
 
-        let mut offset_primitives: Vec<GpuPrimitive> = primitives
+        let offset_primitives: Vec<GpuPrimitive> = primitives
             .iter()
-            .map(|p| {
-                let mut op = *p;
-                op.bounds[0] -= offset_x;
-                op.bounds[1] -= offset_y;
-                // Also offset clip bounds if they're valid (not the "no clip" default)
-                // Default "no clip" is [-10000.0, -10000.0, 100000.0, 100000.0]
-                // A real clip has x > -5000 AND width < 90000 (reasonable viewport sizes)
-                let has_real_clip = op.clip_bounds[0] > -5000.0 && op.clip_bounds[2] < 90000.0;
-                if has_real_clip {
-                    op.clip_bounds[0] -= offset_x;
-                    op.clip_bounds[1] -= offset_y;
-                }
-                op
-            })
+            .map(|p| Self::offset_primitive(p, offset_x, offset_y))
             .collect();
 
         // Update uniforms with content size (the viewport for this tight render)
-        let uniforms = Uniforms {
-            viewport_size: [content_size.0 as f32, content_size.1 as f32],
-            _padding: [0.0; 2],
-        };
-        self.queue
-            .write_buffer(&self.buffers.uniforms, 0, bytemuck::bytes_of(&uniforms));
+        self.write_uniforms([content_size.0 as f32, content_size.1 as f32]);
 
         // Write offset primitives to buffer and capture count for draw call
         let primitive_count = offset_primitives.len() as u32;
-        self.queue.write_buffer(
-            &self.buffers.primitives,
-            0,
-            bytemuck::cast_slice(&offset_primitives),
-        );
+        self.upload_primitives(&offset_primitives);
         drop(offset_primitives); // Free Vec immediately - data is now on GPU
 
         // Create command encoder
@@ -6418,20 +7360,13 @@ impl GpuRenderer {
             render_pass.set_pipeline(&self.pipelines.sdf);
             render_pass.set_bind_group(0, &self.bind_groups.sdf, &[]);
             render_pass.draw(0..6, 0..primitive_count);
+            self.count_draw_call();
         }
 
         self.queue.submit(std::iter::once(encoder.finish()));
 
         // Restore viewport uniforms for subsequent operations
-        let restore_uniforms = Uniforms {
-            viewport_size: [self.viewport_size.0 as f32, self.viewport_size.1 as f32],
-            _padding: [0.0; 2],
-        };
-        self.queue.write_buffer(
-            &self.buffers.uniforms,
-            0,
-            bytemuck::bytes_of(&restore_uniforms),
-        );
+        self.write_uniforms([self.viewport_size.0 as f32, self.viewport_size.1 as f32]);
 
         (layer_texture, content_size)
     }
@@ -6479,6 +7414,14 @@ impl GpuRenderer {
             None => ([0.0, 0.0, vp_w, vp_h], [0.0; 4], 0),
         };
 
+        // Intersect with the partial redraw scissor, if any
+        if let Some([sx, sy, sw, sh]) = self.scissor {
+            vis_x0 = vis_x0.max(sx as f32);
+            vis_y0 = vis_y0.max(sy as f32);
+            vis_x1 = vis_x1.min((sx + sw) as f32);
+            vis_y1 = vis_y1.min((sy + sh) as f32);
+        }
+
         // Check if anything is visible
         let vis_w = vis_x1 - vis_x0;
         let vis_h = vis_y1 - vis_y0;
@@ -6582,6 +7525,7 @@ impl GpuRenderer {
             render_pass.set_pipeline(&self.pipelines.layer_composite);
             render_pass.set_bind_group(0, &bind_group, &[]);
             render_pass.draw(0..6, 0..1);
+            self.count_draw_call();
         }
 
         self.queue.submit(std::iter::once(encoder.finish()));
@@ -6665,6 +7609,7 @@ impl GpuRenderer {
             render_pass.set_pipeline(&self.pipelines.layer_composite);
             render_pass.set_bind_group(0, &bind_group, &[]);
             render_pass.draw(0..6, 0..1);
+            self.count_draw_call();
         }
 
         self.queue.submit(std::iter::once(encoder.finish()));
@@ -6794,6 +7739,7 @@ impl GpuRenderer {
             render_pass.set_pipeline(&self.pipelines.layer_composite);
             render_pass.set_bind_group(0, &bind_group, &[]);
             render_pass.draw(0..6, 0..1);
+            self.count_draw_call();
         }
 
         self.queue.submit(std::iter::once(encoder.finish()));
@@ -81,9 +81,10 @@ struct Primitive {
 @group(0) @binding(0) var<uniform> uniforms: Uniforms;
 @group(0) @binding(1) var<storage, read> primitives: array<Primitive>;
 // Glyph atlas textures for unified text rendering
-@group(0) @binding(2) var glyph_atlas: texture_2d<f32>;
+// One array layer per atlas page
+@group(0) @binding(2) var glyph_atlas: texture_2d_array<f32>;
 @group(0) @binding(3) var glyph_sampler: sampler;
-@group(0) @binding(4) var color_glyph_atlas: texture_2d<f32>;
+@group(0) @binding(4) var color_glyph_atlas: texture_2d_array<f32>;
 
 // ============================================================================
 // Vertex Shader
@@ -305,6 +306,31 @@ fn calculate_clip_alpha(p: vec2<f32>, clip_bounds: vec4<f32>, clip_radius: vec4<
     return 1.0 - smoothstep(-aa_width, aa_width, clip_d);
 }
 
+// Bilinearly filtered SDF glyph sample
+// The glyph sampler uses nearest filtering for pixel-exact bitmaps, but
+// distance fields need interpolation to stay smooth when scaled up
+fn sample_sdf_glyph(uv: vec2<f32>, page: i32) -> f32 {
+    let dims = vec2<i32>(textureDimensions(glyph_atlas));
+    let p = uv * vec2<f32>(dims) - 0.5;
+    let base = floor(p);
+    let f = p - base;
+    let i0 = clamp(vec2<i32>(base), vec2<i32>(0), dims - 1);
+    let i1 = clamp(vec2<i32>(base) + 1, vec2<i32>(0), dims - 1);
+    let t00 = textureLoad(glyph_atlas, i0, page, 0).r;
+    let t10 = textureLoad(glyph_atlas, vec2<i32>(i1.x, i0.y), page, 0).r;
+    let t01 = textureLoad(glyph_atlas, vec2<i32>(i0.x, i1.y), page, 0).r;
+    let t11 = textureLoad(glyph_atlas, i1, page, 0).r;
+    return mix(mix(t00, t10, f.x), mix(t01, t11, f.x), f.y);
+}
+
+// Coverage of an SDF glyph value with a one pixel anti-aliasing ramp
+// spread: distance encoded on each side of the outline (atlas texels)
+// px_per_texel: screen pixels covered by one atlas texel
+fn sdf_glyph_coverage(value: f32, spread: f32, px_per_texel: f32) -> f32 {
+    let distance = (value - 0.5) * 2.0 * spread * px_per_texel;
+    return clamp(distance + 0.5, 0.0, 1.0);
+}
+
 // ============================================================================
 // Fragment Shader
 // ============================================================================
@@ -461,28 +487,45 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4<f32> {
         }
         case PRIM_TEXT: {
             // Text glyph - sample from glyph atlas
-            // UV bounds are stored in gradient_params: (u_min, v_min, u_max, v_max)
+            // Texel bounds are stored in gradient_params: (x_min, y_min, x_max, y_max)
             // fill_type stores is_color flag (1 = color emoji, 0 = grayscale)
-            let uv_bounds = prim.gradient_params;
+            // color2.x stores the atlas page (texture array layer)
+            // color2.y stores the SDF spread (0 = coverage bitmap)
+            let texel_bounds = prim.gradient_params;
             let is_color = fill_type == 1u;
+            let page = i32(prim.color2.x);
+            let sdf_spread = prim.color2.y;
 
             // Calculate UV within the glyph quad
             // p is in screen coordinates, bounds defines the glyph quad
             let local_uv = (p - origin) / size;
 
-            // Map to atlas UV coordinates
-            let atlas_uv = uv_bounds.xy + local_uv * (uv_bounds.zw - uv_bounds.xy);
+            // Map to atlas UV coordinates, normalized against the bound atlas
+            // so glyphs prepared before the atlas grew still line up
+            let atlas_size = select(
+                vec2<f32>(textureDimensions(glyph_atlas)),
+                vec2<f32>(textureDimensions(color_glyph_atlas)),
+                is_color
+            );
+            let atlas_texel = texel_bounds.xy + local_uv * (texel_bounds.zw - texel_bounds.xy);
+            let atlas_uv = atlas_texel / atlas_size;
 
             var text_result: vec4<f32>;
             if is_color {
                 // Color emoji - sample RGBA directly from color atlas
-                text_result = textureSample(color_glyph_atlas, glyph_sampler, atlas_uv);
+                text_result = textureSample(color_glyph_atlas, glyph_sampler, atlas_uv, page);
             } else {
                 // Grayscale text - sample coverage from R channel, apply color tint
-                let coverage = textureSample(glyph_atlas, glyph_sampler, atlas_uv).r;
+                let coverage = textureSample(glyph_atlas, glyph_sampler, atlas_uv, page).r;
                 // Apply gamma correction for crisp text rendering
-                let gamma_coverage = pow(coverage, 0.7);
-                text_result = vec4<f32>(prim.color.rgb, prim.color.a * gamma_coverage);
+                var glyph_alpha = pow(coverage, 0.7);
+                if sdf_spread > 0.0 {
+                    // Distance field glyph scaled from its size bucket
+                    let px_per_texel = size.x / (texel_bounds.z - texel_bounds.x);
+                    let sdf = sample_sdf_glyph(atlas_uv, page);
+                    glyph_alpha = sdf_glyph_coverage(sdf, sdf_spread, px_per_texel);
+                }
+                text_result = vec4<f32>(prim.color.rgb, prim.color.a * glyph_alpha);
             }
 
             // Apply clip alpha
@@ -680,11 +723,14 @@ pub const TEXT_SHADER: &str = r#"
 
 struct VertexOutput {
     @builtin(position) position: vec4<f32>,
-    @location(0) uv: vec2<f32>,
+    @location(0) texel: vec2<f32>,
     @location(1) color: vec4<f32>,
     @location(2) world_pos: vec2<f32>,
     @location(3) @interpolate(flat) clip_bounds: vec4<f32>,
     @location(4) @interpolate(flat) is_color: f32,
+    @location(5) @interpolate(flat) page: i32,
+    // SDF spread (atlas texels, 0 = coverage bitmap) and glyph pixels per atlas texel
+    @location(6) @interpolate(flat) sdf: vec2<f32>,
 }
 
 struct TextUniforms {
@@ -695,22 +741,24 @@ struct TextUniforms {
 struct GlyphInstance {
     // Position and size (x, y, width, height)
     bounds: vec4<f32>,
-    // UV coordinates in atlas (u_min, v_min, u_max, v_max)
-    uv_bounds: vec4<f32>,
+    // Texel coordinates in atlas (x_min, y_min, x_max, y_max)
+    texel_bounds: vec4<f32>,
     // Text color
     color: vec4<f32>,
     // Clip bounds (x, y, width, height) - set to large values for no clip
     clip_bounds: vec4<f32>,
-    // Flags: [is_color, unused, unused, unused]
+    // Flags: [is_color, atlas_page, sdf_spread, unused]
     // is_color: 1.0 = color emoji (use color_atlas), 0.0 = grayscale (use glyph_atlas)
+    // atlas_page: texture array layer holding the glyph
+    // sdf_spread: > 0 for signed distance field glyphs (distance per side, in texels)
     flags: vec4<f32>,
 }
 
 @group(0) @binding(0) var<uniform> uniforms: TextUniforms;
 @group(0) @binding(1) var<storage, read> glyphs: array<GlyphInstance>;
-@group(0) @binding(2) var glyph_atlas: texture_2d<f32>;
+@group(0) @binding(2) var glyph_atlas: texture_2d_array<f32>;
 @group(0) @binding(3) var glyph_sampler: sampler;
-@group(0) @binding(4) var color_atlas: texture_2d<f32>;
+@group(0) @binding(4) var color_atlas: texture_2d_array<f32>;
 
 @vertex
 fn vs_main(
@@ -740,10 +788,10 @@ fn vs_main(
         glyph.bounds.y + local_uv.y * glyph.bounds.w
     );
 
-    // UV in atlas
-    let uv = vec2<f32>(
-        glyph.uv_bounds.x + local_uv.x * (glyph.uv_bounds.z - glyph.uv_bounds.x),
-        glyph.uv_bounds.y + local_uv.y * (glyph.uv_bounds.w - glyph.uv_bounds.y)
+    // Texel position in atlas (normalized in the fragment shader)
+    let texel = vec2<f32>(
+        glyph.texel_bounds.x + local_uv.x * (glyph.texel_bounds.z - glyph.texel_bounds.x),
+        glyph.texel_bounds.y + local_uv.y * (glyph.texel_bounds.w - glyph.texel_bounds.y)
     );
 
     // Convert to clip space
@@ -753,11 +801,14 @@ fn vs_main(
     );
 
     out.position = vec4<f32>(clip_pos, 0.0, 1.0);
-    out.uv = uv;
+    out.texel = texel;
     out.color = glyph.color;
     out.world_pos = pos;
     out.clip_bounds = glyph.clip_bounds;
     out.is_color = glyph.flags.x;
+    out.page = i32(glyph.flags.y);
+    let texel_width = max(glyph.texel_bounds.z - glyph.texel_bounds.x, 1e-6);
+    out.sdf = vec2<f32>(glyph.flags.z, glyph.bounds.z / texel_width);
 
     return out;
 }
@@ -786,6 +837,31 @@ fn calculate_clip_alpha(p: vec2<f32>, clip_bounds: vec4<f32>) -> f32 {
     return clamp(d + 0.5, 0.0, 1.0);
 }
 
+// Bilinearly filtered SDF glyph sample
+// The glyph sampler uses nearest filtering for pixel-exact bitmaps, but
+// distance fields need interpolation to stay smooth when scaled up
+fn sample_sdf_glyph(uv: vec2<f32>, page: i32) -> f32 {
+    let dims = vec2<i32>(textureDimensions(glyph_atlas));
+    let p = uv * vec2<f32>(dims) - 0.5;
+    let base = floor(p);
+    let f = p - base;
+    let i0 = clamp(vec2<i32>(base), vec2<i32>(0), dims - 1);
+    let i1 = clamp(vec2<i32>(base) + 1, vec2<i32>(0), dims - 1);
+    let t00 = textureLoad(glyph_atlas, i0, page, 0).r;
+    let t10 = textureLoad(glyph_atlas, vec2<i32>(i1.x, i0.y), page, 0).r;
+    let t01 = textureLoad(glyph_atlas, vec2<i32>(i0.x, i1.y), page, 0).r;
+    let t11 = textureLoad(glyph_atlas, i1, page, 0).r;
+    return mix(mix(t00, t10, f.x), mix(t01, t11, f.x), f.y);
+}
+
+// Coverage of an SDF glyph value with a one pixel anti-aliasing ramp
+// spread: distance encoded on each side of the outline (atlas texels)
+// px_per_texel: screen pixels covered by one atlas texel
+fn sdf_glyph_coverage(value: f32, spread: f32, px_per_texel: f32) -> f32 {
+    let distance = (value - 0.5) * 2.0 * spread * px_per_texel;
+    return clamp(distance + 0.5, 0.0, 1.0);
+}
+
 @fragment
 fn fs_main(in: VertexOutput) -> @location(0) vec4<f32> {
     // Calculate clip alpha first - discard if completely outside
@@ -794,21 +870,35 @@ fn fs_main(in: VertexOutput) -> @location(0) vec4<f32> {
         discard;
     }
 
+    // Normalize against the bound atlas, which may have grown since the
+    // glyph was prepared
+    let uv = in.texel / select(
+        vec2<f32>(textureDimensions(glyph_atlas)),
+        vec2<f32>(textureDimensions(color_atlas)),
+        in.is_color > 0.5
+    );
+
     // Check if this is a color emoji glyph
     if in.is_color > 0.5 {
         // Color emoji: sample RGBA from color atlas, use texture color directly
-        let emoji_color = textureSample(color_atlas, glyph_sampler, in.uv);
+        let emoji_color = textureSample(color_atlas, glyph_sampler, uv, in.page);
         // Apply clip alpha only - keep original emoji colors
         return vec4<f32>(emoji_color.rgb, emoji_color.a * clip_alpha);
     } else {
         // Grayscale text: sample coverage from glyph atlas, apply tint color
-        let coverage = textureSample(glyph_atlas, glyph_sampler, in.uv).r;
+        let coverage = textureSample(glyph_atlas, glyph_sampler, uv, in.page).r;
 
         // Use coverage directly with slight gamma correction for cleaner edges
         // The rasterizer provides good coverage values - we just need to
         // apply a subtle curve to sharpen without losing anti-aliasing
         // pow(x, 0.7) brightens mid-tones, making strokes appear crisper
-        let aa_alpha = pow(coverage, 0.7);
+        var aa_alpha = pow(coverage, 0.7);
+        if in.sdf.x > 0.0 {
+            // Distance field glyph scaled from its size bucket
+            let px_per_texel = in.sdf.y;
+            let sdf = sample_sdf_glyph(uv, in.page);
+            aa_alpha = sdf_glyph_coverage(sdf, in.sdf.x, px_per_texel);
+        }
 
         // Apply both text alpha and clip alpha
         return vec4<f32>(in.color.rgb, in.color.a * aa_alpha * clip_alpha);
@@ -839,7 +929,8 @@ struct VertexOutput {
 struct GlassUniforms {
     viewport_size: vec2<f32>,
     time: f32,
-    _padding: f32,
+    // Blur already applied to the backdrop (pyramid prefilter), in pixels
+    backdrop_blur: f32,
 }
 
 // Glass material types (matching Apple's vibrancy styles)
@@ -1038,9 +1129,16 @@ fn calculate_glass_clip_alpha(p: vec2<f32>, clip_bounds: vec4<f32>) -> f32 {
     return clamp(d + 0.5, 0.0, 1.0);
 }
 
+// Blur still to apply after the backdrop prefilter (blurs add in quadrature)
+fn residual_blur(blur_radius: f32) -> f32 {
+    let prefilter = uniforms.backdrop_blur;
+    return sqrt(max(blur_radius * blur_radius - prefilter * prefilter, 0.0));
+}
+
 // High quality blur using spiral sampling pattern
 // More samples and better distribution to eliminate checkered artifacts
-fn blur_backdrop(uv: vec2<f32>, blur_radius: f32) -> vec4<f32> {
+fn blur_backdrop(uv: vec2<f32>, requested_radius: f32) -> vec4<f32> {
+    let blur_radius = residual_blur(requested_radius);
     if blur_radius < 0.5 {
         return textureSample(backdrop_texture, backdrop_sampler, uv);
     }
@@ -1084,7 +1182,9 @@ fn blur_backdrop(uv: vec2<f32>, blur_radius: f32) -> vec4<f32> {
 
 // High quality blur with clip bounds for scroll containers
 // Samples are clamped to the clip region to prevent blur bleeding
-fn blur_backdrop_clipped(uv: vec2<f32>, blur_radius: f32, clip_bounds: vec4<f32>) -> vec4<f32> {
+fn blur_backdrop_clipped(uv: vec2<f32>, requested_radius: f32, clip_bounds: vec4<f32>) -> vec4<f32> {
+    let blur_radius = residual_blur(requested_radius);
+
     // Convert clip bounds from (x, y, width, height) to (min_x, min_y, max_x, max_y) in UV space
     let clip_min = clip_bounds.xy / uniforms.viewport_size;
     let clip_max = (clip_bounds.xy + clip_bounds.zw) / uniforms.viewport_size;
@@ -1470,7 +1570,8 @@ struct VertexOutput {
 struct SimpleGlassUniforms {
     viewport_size: vec2<f32>,
     time: f32,
-    _padding: f32,
+    // Blur already applied to the backdrop (pyramid prefilter), in pixels
+    backdrop_blur: f32,
 }
 
 struct SimpleGlassPrimitive {
@@ -1588,18 +1689,25 @@ fn adjust_saturation(color: vec3<f32>, saturation: f32) -> vec3<f32> {
 }
 
 // Simple box blur - sample backdrop at offset positions
-fn blur_backdrop(uv: vec2<f32>, radius: f32, clip_bounds: vec4<f32>) -> vec4<f32> {
+fn blur_backdrop(uv: vec2<f32>, requested_radius: f32, clip_bounds: vec4<f32>) -> vec4<f32> {
     let tex_size = vec2<f32>(textureDimensions(backdrop_texture));
     let pixel_size = 1.0 / tex_size;
 
+    let clip_min = clip_bounds.xy / uniforms.viewport_size;
+    let clip_max = (clip_bounds.xy + clip_bounds.zw) / uniforms.viewport_size;
+
+    // Blur still to apply after the backdrop prefilter (blurs add in quadrature)
+    let prefilter = uniforms.backdrop_blur;
+    let radius = sqrt(max(requested_radius * requested_radius - prefilter * prefilter, 0.0));
+    if prefilter > 0.0 && radius < 0.5 {
+        return textureSample(backdrop_texture, backdrop_sampler, clamp(uv, clip_min, clip_max));
+    }
+
     // Use 5x5 box blur for simplicity
     let r = max(1.0, radius * 0.5);
     var sum = vec4<f32>(0.0);
     var weight = 0.0;
 
-    let clip_min = clip_bounds.xy / uniforms.viewport_size;
-    let clip_max = (clip_bounds.xy + clip_bounds.zw) / uniforms.viewport_size;
-
     for (var y = -2.0; y <= 2.0; y += 1.0) {
         for (var x = -2.0; x <= 2.0; x += 1.0) {
             let offset = vec2<f32>(x, y) * pixel_size * r;
@@ -2516,6 +2624,69 @@ fn fs_kawase_blur(in: VertexOutput) -> @location(0) vec4<f32> {
     }
 }
 
+// ----------------------------------------------------------------------------
+// Dual-filter (dual Kawase) pyramid passes
+// ----------------------------------------------------------------------------
+// `texel_size` is the inverse size of the texture being sampled and `radius`
+// the per-level sample offset. Intermediate levels keep alpha-weighted RGB so
+// transparent texels don't darken the result; element blurs restore their
+// original alpha by writing only RGB in the final upsample.
+
+fn dual_resolve(weighted_rgb: vec3<f32>, alpha_sum: f32, weight_sum: f32) -> vec4<f32> {
+    let alpha = alpha_sum / weight_sum;
+    if (uniforms.blur_alpha != 0u) {
+        return vec4<f32>(1.0, 1.0, 1.0, alpha);
+    }
+    if (alpha_sum < 0.001) {
+        return vec4<f32>(0.0, 0.0, 0.0, 0.0);
+    }
+    return vec4<f32>(weighted_rgb / alpha_sum, alpha);
+}
+
+// Downsample to half size: center plus four diagonal taps
+@fragment
+fn fs_dual_down(in: VertexOutput) -> @location(0) vec4<f32> {
+    let o = uniforms.texel_size * uniforms.radius;
+    let s0 = textureSample(input_texture, input_sampler, in.uv);
+    let s1 = textureSample(input_texture, input_sampler, in.uv + vec2<f32>(-o.x, -o.y));
+    let s2 = textureSample(input_texture, input_sampler, in.uv + vec2<f32>( o.x, -o.y));
+    let s3 = textureSample(input_texture, input_sampler, in.uv + vec2<f32>(-o.x,  o.y));
+    let s4 = textureSample(input_texture, input_sampler, in.uv + vec2<f32>( o.x,  o.y));
+
+    let weighted_rgb = s0.rgb * s0.a * 4.0 + s1.rgb * s1.a + s2.rgb * s2.a + s3.rgb * s3.a + s4.rgb * s4.a;
+    let alpha_sum = s0.a * 4.0 + s1.a + s2.a + s3.a + s4.a;
+    return dual_resolve(weighted_rgb, alpha_sum, 8.0);
+}
+
+// Upsample to double size: four axis taps plus four (double weight) diagonals
+@fragment
+fn fs_dual_up(in: VertexOutput) -> @location(0) vec4<f32> {
+    let o = uniforms.texel_size * uniforms.radius;
+    let h = o * 0.5;
+    var weighted_rgb = vec3<f32>(0.0);
+    var alpha_sum = 0.0;
+
+    var axis = array<vec2<f32>, 4>(
+        vec2<f32>(-o.x, 0.0),
+        vec2<f32>( o.x, 0.0),
+        vec2<f32>(0.0, -o.y),
+        vec2<f32>(0.0,  o.y),
+    );
+    var diagonal = array<vec2<f32>, 4>(
+        vec2<f32>(-h.x, -h.y),
+        vec2<f32>( h.x, -h.y),
+        vec2<f32>(-h.x,  h.y),
+        vec2<f32>( h.x,  h.y),
+    );
+    for (var i = 0; i < 4; i++) {
+        let a = textureSample(input_texture, input_sampler, in.uv + axis[i]);
+        let d = textureSample(input_texture, input_sampler, in.uv + diagonal[i]);
+        weighted_rgb += a.rgb * a.a + d.rgb * d.a * 2.0;
+        alpha_sum += a.a + d.a * 2.0;
+    }
+    return dual_resolve(weighted_rgb, alpha_sum, 12.0);
+}
+
 // Single-pass box blur for low quality mode
 @fragment
 fn fs_box_blur(in: VertexOutput) -> @location(0) vec4<f32> {
@@ -14,7 +14,7 @@ struct ImageInstance {
     // Tint color (RGBA)
     @location(2) tint: vec4<f32>,
     // Border radius and opacity
-    @location(3) params: vec4<f32>, // (border_radius, opacity, padding, padding)
+    @location(3) params: vec4<f32>, // (border_radius, opacity, tint_mode, padding)
     // Clip bounds (x, y, width, height) - set to large values for no clip
     @location(4) clip_bounds: vec4<f32>,
     // Clip corner radii (top-left, top-right, bottom-right, bottom-left)
@@ -32,6 +32,8 @@ struct VertexOutput {
     @location(6) world_pos: vec2<f32>,
     @location(7) clip_bounds: vec4<f32>,
     @location(8) clip_radius: vec4<f32>,
+    // 0 = multiply by tint, 1 = replace RGB with tint (alpha masks such as SVG icons)
+    @location(9) @interpolate(flat) tint_mode: f32,
 }
 
 @group(0) @binding(0)
@@ -86,6 +88,7 @@ fn vs_main(
     output.world_pos = vec2<f32>(x, y);
     output.clip_bounds = instance.clip_bounds;
     output.clip_radius = instance.clip_radius;
+    output.tint_mode = instance.params.z;
 
     return output;
 }
@@ -153,8 +156,13 @@ fn fs_main(input: VertexOutput) -> @location(0) vec4<f32> {
     // Sample the texture
     var color = textureSample(image_texture, image_sampler, input.uv);
 
-    // Apply tint
-    color = color * input.tint;
+    // Apply tint: either modulate the texture, or use it as a coverage mask
+    // so one cached raster can be drawn in any color
+    if input.tint_mode > 0.5 {
+        color = vec4<f32>(input.tint.rgb, color.a * input.tint.a);
+    } else {
+        color = color * input.tint;
+    }
 
     // Apply opacity
     color.a *= input.opacity;
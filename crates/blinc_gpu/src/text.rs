@@ -4,7 +4,8 @@
 //! and the GPU rendering pipeline.
 
 use blinc_text::{
-    ColorSpan, FontRegistry, GenericFont, LayoutOptions, TextAlignment, TextAnchor, TextRenderer,
+    AtlasPageStats, AtlasRegion, ColorSpan, FontRegistry, FrameClient, GenericFont, GlyphInstance,
+    LayoutOptions, TextAlignment, TextAnchor, TextRenderer, SDF_SPREAD,
 };
 use std::sync::{Arc, Mutex};
 
@@ -39,6 +40,8 @@ pub struct TextRenderingContext {
     color_atlas_texture: Option<wgpu::Texture>,
     /// Color glyph atlas texture view
     color_atlas_view: Option<wgpu::TextureView>,
+    /// Bumped whenever either atlas texture is re-created
+    atlas_generation: u64,
     /// Sampler for the atlas
     sampler: wgpu::Sampler,
 }
@@ -64,40 +67,25 @@ impl TextRenderingContext {
 
         // Grayscale atlas for regular text
         let (gray_width, gray_height) = renderer.atlas_dimensions();
-        let atlas_texture = device.create_texture(&wgpu::TextureDescriptor {
-            label: Some("Glyph Atlas Texture"),
-            size: wgpu::Extent3d {
-                width: gray_width,
-                height: gray_height,
-                depth_or_array_layers: 1,
-            },
-            mip_level_count: 1,
-            sample_count: 1,
-            dimension: wgpu::TextureDimension::D2,
-            format: wgpu::TextureFormat::R8Unorm,
-            usage: wgpu::TextureUsages::TEXTURE_BINDING | wgpu::TextureUsages::COPY_DST,
-            view_formats: &[],
-        });
-        let atlas_view = atlas_texture.create_view(&wgpu::TextureViewDescriptor::default());
+        let (atlas_texture, atlas_view) = create_atlas_texture(
+            &device,
+            "Glyph Atlas Texture",
+            wgpu::TextureFormat::R8Unorm,
+            gray_width,
+            gray_height,
+            renderer.atlas_page_count(),
+        );
 
         // RGBA color atlas for emoji
         let (color_width, color_height) = renderer.color_atlas_dimensions();
-        let color_atlas_texture = device.create_texture(&wgpu::TextureDescriptor {
-            label: Some("Color Glyph Atlas Texture"),
-            size: wgpu::Extent3d {
-                width: color_width,
-                height: color_height,
-                depth_or_array_layers: 1,
-            },
-            mip_level_count: 1,
-            sample_count: 1,
-            dimension: wgpu::TextureDimension::D2,
-            format: wgpu::TextureFormat::Rgba8UnormSrgb,
-            usage: wgpu::TextureUsages::TEXTURE_BINDING | wgpu::TextureUsages::COPY_DST,
-            view_formats: &[],
-        });
-        let color_atlas_view =
-            color_atlas_texture.create_view(&wgpu::TextureViewDescriptor::default());
+        let (color_atlas_texture, color_atlas_view) = create_atlas_texture(
+            &device,
+            "Color Glyph Atlas Texture",
+            wgpu::TextureFormat::Rgba8UnormSrgb,
+            color_width,
+            color_height,
+            renderer.color_atlas_page_count(),
+        );
 
         Self {
             renderer,
@@ -107,6 +95,7 @@ impl TextRenderingContext {
             atlas_view: Some(atlas_view),
             color_atlas_texture: Some(color_atlas_texture),
             color_atlas_view: Some(color_atlas_view),
+            atlas_generation: 0,
             sampler,
         }
     }
@@ -151,6 +140,23 @@ impl TextRenderingContext {
         self.renderer.load_font_data_to_registry(data)
     }
 
+    /// Register a font file by path; it is memory-mapped on first use
+    ///
+    /// Returns the number of font faces added.
+    pub fn load_font_file_to_registry(&mut self, path: &std::path::Path) -> usize {
+        self.renderer.load_font_file_to_registry(path)
+    }
+
+    /// Register font data owned elsewhere without copying it
+    ///
+    /// Returns the number of font faces added.
+    pub fn load_shared_font_data_to_registry(
+        &mut self,
+        data: Arc<dyn AsRef<[u8]> + Send + Sync>,
+    ) -> usize {
+        self.renderer.load_shared_font_data_to_registry(data)
+    }
+
     /// Set the default font
     pub fn set_font(&mut self, font: blinc_text::FontFace) {
         self.renderer.set_default_font(font);
@@ -408,24 +414,17 @@ impl TextRenderingContext {
                     g.bounds[2],
                     g.bounds[3],
                 ],
-                uv_bounds: g.uv_bounds,
+                texel_bounds: g.texel_bounds,
                 color: g.color,
                 // Default: no clip (will be set by caller if needed)
                 clip_bounds: [-10000.0, -10000.0, 100000.0, 100000.0],
-                // Set is_color flag for emoji glyphs
-                flags: [if g.is_color { 1.0 } else { 0.0 }, 0.0, 0.0, 0.0],
+                // Set is_color flag for emoji glyphs, the atlas page and SDF spread
+                flags: glyph_flags(g),
             })
             .collect();
 
-        // Update atlas textures if dirty
-        if self.renderer.atlas_is_dirty() {
-            self.update_atlas_texture();
-            self.renderer.mark_atlas_clean();
-        }
-        if self.renderer.color_atlas_is_dirty() {
-            self.update_color_atlas_texture();
-            self.renderer.mark_color_atlas_clean();
-        }
+        // Upload newly rasterized glyphs
+        self.update_atlas_textures();
 
         Ok(glyphs)
     }
@@ -493,21 +492,14 @@ impl TextRenderingContext {
                     g.bounds[2],
                     g.bounds[3],
                 ],
-                uv_bounds: g.uv_bounds,
+                texel_bounds: g.texel_bounds,
                 color: g.color,
                 clip_bounds: [-10000.0, -10000.0, 100000.0, 100000.0],
-                flags: [if g.is_color { 1.0 } else { 0.0 }, 0.0, 0.0, 0.0],
+                flags: glyph_flags(g),
             })
             .collect();
 
-        if self.renderer.atlas_is_dirty() {
-            self.update_atlas_texture();
-            self.renderer.mark_atlas_clean();
-        }
-        if self.renderer.color_atlas_is_dirty() {
-            self.update_color_atlas_texture();
-            self.renderer.mark_color_atlas_clean();
-        }
+        self.update_atlas_textures();
 
         Ok(glyphs)
     }
@@ -571,6 +563,16 @@ impl TextRenderingContext {
         self.color_atlas_view.as_ref()
     }
 
+    /// Counter bumped whenever an atlas texture is re-created
+    ///
+    /// Adding a page or growing or shrinking the pages replaces the atlas
+    /// textures and views, so bind groups made from the previous views must
+    /// be rebuilt. The views themselves live in the same place and can't be
+    /// told apart by address.
+    pub fn atlas_generation(&self) -> u64 {
+        self.atlas_generation
+    }
+
     /// Get the sampler
     pub fn sampler(&self) -> &wgpu::Sampler {
         &self.sampler
@@ -584,115 +586,227 @@ impl TextRenderingContext {
         self.renderer.font_registry()
     }
 
-    /// Update the GPU atlas texture from the TextRenderer's atlas
-    fn update_atlas_texture(&mut self) {
-        let (width, height) = self.renderer.atlas_dimensions();
-        let pixels = self.renderer.atlas_pixels();
+    /// Clear cached glyphs and shrink the atlases (CPU and GPU) to release memory
+    ///
+    /// Any renderer bind groups referencing the old atlas textures must be
+    /// dropped afterwards (see `GpuRenderer::release_cached_targets`).
+    pub fn shrink_atlases(&mut self) {
+        self.renderer.shrink_atlases();
+        self.update_atlas_textures();
+    }
 
-        // Create or recreate texture if size changed
-        let needs_create = match &self.atlas_texture {
-            Some(tex) => tex.width() != width || tex.height() != height,
-            None => true,
-        };
+    /// Start a new frame
+    ///
+    /// Glyphs prepared during the current frame are never evicted from the
+    /// atlases; glyphs from earlier frames may be, once the atlases are full.
+    /// Call this once per frame before preparing text.
+    pub fn begin_frame(&mut self) {
+        self.renderer.begin_frame();
+    }
 
-        if needs_create {
-            let texture = self.device.create_texture(&wgpu::TextureDescriptor {
-                label: Some("Glyph Atlas Texture"),
-                size: wgpu::Extent3d {
-                    width,
-                    height,
-                    depth_or_array_layers: 1,
-                },
-                mip_level_count: 1,
-                sample_count: 1,
-                dimension: wgpu::TextureDimension::D2,
-                format: wgpu::TextureFormat::R8Unorm,
-                usage: wgpu::TextureUsages::TEXTURE_BINDING | wgpu::TextureUsages::COPY_DST,
-                view_formats: &[],
-            });
-
-            let view = texture.create_view(&wgpu::TextureViewDescriptor::default());
-            self.atlas_texture = Some(texture);
-            self.atlas_view = Some(view);
+    /// Start a frame for one of several render contexts sharing this one
+    ///
+    /// Glyphs prepared until the matching `end_frame_for` are never evicted,
+    /// however many frames the other contexts start meanwhile.
+    pub fn begin_frame_for(&mut self, client: FrameClient) {
+        self.renderer.begin_frame_for(client);
+    }
+
+    /// End a frame started with `begin_frame_for`, once its draws are submitted
+    pub fn end_frame_for(&mut self, client: FrameClient) {
+        self.renderer.end_frame_for(client);
+    }
+
+    /// Per-page utilization and eviction counts of the (grayscale, color) atlases
+    pub fn atlas_page_stats(&self) -> (Vec<AtlasPageStats>, Vec<AtlasPageStats>) {
+        self.renderer.atlas_page_stats()
+    }
+
+    /// Draw text at or above `min_size` pixels from signed distance fields
+    ///
+    /// See `TextRenderer::set_sdf_min_size`. Useful when text size animates
+    /// (zoom, scale transitions) so glyphs aren't re-rasterized at every step.
+    pub fn set_sdf_min_size(&mut self, min_size: Option<f32>) {
+        self.renderer.set_sdf_min_size(min_size);
+    }
+
+    /// Bytes held by the (grayscale, color) glyph atlases, CPU and GPU copies
+    pub fn atlas_memory_bytes(&self) -> (u64, u64) {
+        let (gray, color) = self.renderer.atlas_memory_bytes();
+        // Each atlas has a GPU texture of the same size as its pixel buffer
+        (gray as u64 * 2, color as u64 * 2)
+    }
+
+    /// Upload atlas changes to the GPU textures
+    fn update_atlas_textures(&mut self) {
+        if self.renderer.atlas_is_dirty() {
+            let regions = self.renderer.take_atlas_dirty_regions();
+            let (width, height) = self.renderer.atlas_dimensions();
+            let pages = self.renderer.atlas_page_count();
+            let renderer = &self.renderer;
+            let recreated = sync_atlas_texture(
+                &self.device,
+                &self.queue,
+                &mut self.atlas_texture,
+                &mut self.atlas_view,
+                "Glyph Atlas Texture",
+                wgpu::TextureFormat::R8Unorm,
+                1,
+                (width, height, pages),
+                &regions,
+                |page| renderer.atlas_page_pixels(page),
+            );
+            if recreated {
+                self.atlas_generation += 1;
+            }
         }
 
-        // Upload pixel data
-        if let Some(texture) = &self.atlas_texture {
-            self.queue.write_texture(
-                wgpu::ImageCopyTexture {
-                    texture,
-                    mip_level: 0,
-                    origin: wgpu::Origin3d::ZERO,
-                    aspect: wgpu::TextureAspect::All,
-                },
-                pixels,
-                wgpu::ImageDataLayout {
-                    offset: 0,
-                    bytes_per_row: Some(width),
-                    rows_per_image: Some(height),
-                },
-                wgpu::Extent3d {
-                    width,
-                    height,
-                    depth_or_array_layers: 1,
-                },
+        if self.renderer.color_atlas_is_dirty() {
+            let regions = self.renderer.take_color_atlas_dirty_regions();
+            let (width, height) = self.renderer.color_atlas_dimensions();
+            let pages = self.renderer.color_atlas_page_count();
+            let renderer = &self.renderer;
+            let recreated = sync_atlas_texture(
+                &self.device,
+                &self.queue,
+                &mut self.color_atlas_texture,
+                &mut self.color_atlas_view,
+                "Color Glyph Atlas Texture",
+                wgpu::TextureFormat::Rgba8UnormSrgb, // RGBA for color emoji
+                4,
+                (width, height, pages),
+                &regions,
+                |page| renderer.color_atlas_page_pixels(page),
             );
+            if recreated {
+                self.atlas_generation += 1;
+            }
         }
     }
+}
 
-    /// Update the GPU color atlas texture from the TextRenderer's color atlas
-    fn update_color_atlas_texture(&mut self) {
-        let (width, height) = self.renderer.color_atlas_dimensions();
-        let pixels = self.renderer.color_atlas_pixels();
+/// `GpuGlyph::flags` for a prepared glyph: [is_color, page, sdf_spread, 0]
+fn glyph_flags(glyph: &GlyphInstance) -> [f32; 4] {
+    let sdf_spread = if glyph.sdf { SDF_SPREAD as f32 } else { 0.0 };
+    [
+        if glyph.is_color { 1.0 } else { 0.0 },
+        glyph.page as f32,
+        sdf_spread,
+        0.0,
+    ]
+}
 
-        // Create or recreate texture if size changed
-        let needs_create = match &self.color_atlas_texture {
-            Some(tex) => tex.width() != width || tex.height() != height,
-            None => true,
-        };
+/// Create a glyph atlas texture array with one layer per atlas page
+fn create_atlas_texture(
+    device: &wgpu::Device,
+    label: &str,
+    format: wgpu::TextureFormat,
+    width: u32,
+    height: u32,
+    pages: u32,
+) -> (wgpu::Texture, wgpu::TextureView) {
+    let texture = device.create_texture(&wgpu::TextureDescriptor {
+        label: Some(label),
+        size: wgpu::Extent3d {
+            width,
+            height,
+            depth_or_array_layers: pages,
+        },
+        mip_level_count: 1,
+        sample_count: 1,
+        dimension: wgpu::TextureDimension::D2,
+        format,
+        usage: wgpu::TextureUsages::TEXTURE_BINDING | wgpu::TextureUsages::COPY_DST,
+        view_formats: &[],
+    });
+    // A single-layer texture defaults to a D2 view; the shaders sample arrays
+    let view = texture.create_view(&wgpu::TextureViewDescriptor {
+        dimension: Some(wgpu::TextureViewDimension::D2Array),
+        ..Default::default()
+    });
+    (texture, view)
+}
 
-        if needs_create {
-            let texture = self.device.create_texture(&wgpu::TextureDescriptor {
-                label: Some("Color Glyph Atlas Texture"),
-                size: wgpu::Extent3d {
-                    width,
-                    height,
-                    depth_or_array_layers: 1,
-                },
-                mip_level_count: 1,
-                sample_count: 1,
-                dimension: wgpu::TextureDimension::D2,
-                format: wgpu::TextureFormat::Rgba8UnormSrgb, // RGBA for color emoji
-                usage: wgpu::TextureUsages::TEXTURE_BINDING | wgpu::TextureUsages::COPY_DST,
-                view_formats: &[],
-            });
-
-            let view = texture.create_view(&wgpu::TextureViewDescriptor::default());
-            self.color_atlas_texture = Some(texture);
-            self.color_atlas_view = Some(view);
+/// Bring an atlas texture up to date with its CPU pages
+///
+/// Only the `regions` modified since the last upload are copied, unless the
+/// page size or count changed and the texture has to be re-created, in which
+/// case every page is uploaded in full. Returns true if it was re-created.
+#[allow(clippy::too_many_arguments)]
+fn sync_atlas_texture<'a>(
+    device: &wgpu::Device,
+    queue: &wgpu::Queue,
+    texture: &mut Option<wgpu::Texture>,
+    view: &mut Option<wgpu::TextureView>,
+    label: &str,
+    format: wgpu::TextureFormat,
+    bytes_per_pixel: u32,
+    (width, height, pages): (u32, u32, u32),
+    regions: &[AtlasRegion],
+    page_pixels: impl Fn(u32) -> &'a [u8],
+) -> bool {
+    // Create or recreate texture if size or page count changed
+    let needs_create = match texture {
+        Some(tex) => {
+            tex.width() != width || tex.height() != height || tex.depth_or_array_layers() != pages
         }
-
-        // Upload pixel data (RGBA = 4 bytes per pixel)
-        if let Some(texture) = &self.color_atlas_texture {
-            self.queue.write_texture(
-                wgpu::ImageCopyTexture {
-                    texture,
-                    mip_level: 0,
-                    origin: wgpu::Origin3d::ZERO,
-                    aspect: wgpu::TextureAspect::All,
-                },
-                pixels,
-                wgpu::ImageDataLayout {
-                    offset: 0,
-                    bytes_per_row: Some(width * 4), // 4 bytes per pixel for RGBA
-                    rows_per_image: Some(height),
-                },
-                wgpu::Extent3d {
-                    width,
-                    height,
-                    depth_or_array_layers: 1,
-                },
-            );
+        None => true,
+    };
+
+    if needs_create {
+        let (new_texture, new_view) =
+            create_atlas_texture(device, label, format, width, height, pages);
+        *texture = Some(new_texture);
+        *view = Some(new_view);
+    }
+    let Some(texture) = texture.as_ref() else {
+        return needs_create;
+    };
+
+    let full_pages: Vec<AtlasRegion>;
+    let regions = if needs_create {
+        full_pages = (0..pages)
+            .map(|page| AtlasRegion {
+                page,
+                x: 0,
+                y: 0,
+                width,
+                height,
+            })
+            .collect();
+        &full_pages
+    } else {
+        regions
+    };
+
+    // Copy each region straight out of the page's pixel buffer
+    for region in regions {
+        if region.width == 0 || region.height == 0 {
+            continue;
         }
+        queue.write_texture(
+            wgpu::ImageCopyTexture {
+                texture,
+                mip_level: 0,
+                origin: wgpu::Origin3d {
+                    x: region.x,
+                    y: region.y,
+                    z: region.page,
+                },
+                aspect: wgpu::TextureAspect::All,
+            },
+            page_pixels(region.page),
+            wgpu::ImageDataLayout {
+                offset: ((region.y * width + region.x) * bytes_per_pixel) as u64,
+                bytes_per_row: Some(width * bytes_per_pixel),
+                rows_per_image: Some(height),
+            },
+            wgpu::Extent3d {
+                width: region.width,
+                height: region.height,
+                depth_or_array_layers: 1,
+            },
+        );
     }
+    needs_create
 }
@@ -0,0 +1,126 @@
+//! Growable GPU upload buffers
+//!
+//! The renderer's primitive, glass and glyph storage buffers used to be
+//! allocated once at `RendererConfig` sizes, so a batch larger than the
+//! configured maximum failed validation. `UploadBuffer` grows them by whole
+//! chunks instead and writes through `Queue::write_buffer_with`, which copies
+//! the batch straight into wgpu's staging ring rather than through an
+//! intermediate allocation.
+
+use std::num::NonZeroU64;
+
+/// Granularity buffers grow by, so a slowly growing batch doesn't
+/// reallocate every frame
+pub const UPLOAD_CHUNK_SIZE: u64 = 256 * 1024;
+
+/// A storage buffer rewritten from offset 0 by each pass that uses it
+pub(crate) struct UploadBuffer {
+    buffer: wgpu::Buffer,
+    label: &'static str,
+    usage: wgpu::BufferUsages,
+    /// Largest size the device can bind
+    max_size: u64,
+}
+
+impl UploadBuffer {
+    /// Create a buffer of at least `size` bytes
+    pub fn new(
+        device: &wgpu::Device,
+        label: &'static str,
+        usage: wgpu::BufferUsages,
+        size: u64,
+    ) -> Self {
+        let max_size = device.limits().max_storage_buffer_binding_size as u64;
+        let size = size.clamp(wgpu::COPY_BUFFER_ALIGNMENT, max_size);
+        Self {
+            buffer: Self::allocate(device, label, usage | wgpu::BufferUsages::COPY_DST, size),
+            label,
+            usage: usage | wgpu::BufferUsages::COPY_DST,
+            max_size,
+        }
+    }
+
+    fn allocate(
+        device: &wgpu::Device,
+        label: &'static str,
+        usage: wgpu::BufferUsages,
+        size: u64,
+    ) -> wgpu::Buffer {
+        device.create_buffer(&wgpu::BufferDescriptor {
+            label: Some(label),
+            size,
+            usage,
+            mapped_at_creation: false,
+        })
+    }
+
+    /// A binding of the whole buffer
+    pub fn as_entire_binding(&self) -> wgpu::BindingResource<'_> {
+        self.buffer.as_entire_binding()
+    }
+
+    /// Upload `data` at offset 0, growing the buffer first if it doesn't fit
+    ///
+    /// Returns true if the buffer was reallocated, in which case bind groups
+    /// referencing the old buffer must be rebuilt. Data beyond the device's
+    /// binding limit is dropped with a warning.
+    pub fn write<T: bytemuck::Pod>(
+        &mut self,
+        device: &wgpu::Device,
+        queue: &wgpu::Queue,
+        data: &[T],
+    ) -> bool {
+        let mut bytes: &[u8] = bytemuck::cast_slice(data);
+        let mut grown = false;
+
+        if bytes.len() as u64 > self.buffer.size() {
+            let size = grown_size(bytes.len() as u64, self.max_size);
+            self.buffer = Self::allocate(device, self.label, self.usage, size);
+            grown = true;
+            tracing::debug!("{} grown to {} KB", self.label, size / 1024);
+        }
+        if bytes.len() as u64 > self.buffer.size() {
+            tracing::warn!(
+                "{}: {} bytes exceeds the device limit, truncating",
+                self.label,
+                bytes.len()
+            );
+            let whole = std::mem::size_of::<T>().max(1);
+            let fit = (self.buffer.size() as usize / whole) * whole;
+            bytes = &bytes[..fit];
+        }
+
+        // write_buffer_with needs a non-empty, 4-byte aligned size; GPU
+        // structs are always multiples of 16 bytes
+        if let Some(size) = NonZeroU64::new(bytes.len() as u64) {
+            if let Some(mut view) = queue.write_buffer_with(&self.buffer, 0, size) {
+                view.copy_from_slice(bytes);
+            }
+        }
+        grown
+    }
+}
+
+/// Size to grow to for `needed` bytes: whole chunks, at most `max_size`
+fn grown_size(needed: u64, max_size: u64) -> u64 {
+    needed
+        .div_ceil(UPLOAD_CHUNK_SIZE)
+        .saturating_mul(UPLOAD_CHUNK_SIZE)
+        .min(max_size)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_grown_size_rounds_to_whole_chunks() {
+        assert_eq!(grown_size(1, u64::MAX), UPLOAD_CHUNK_SIZE);
+        assert_eq!(grown_size(UPLOAD_CHUNK_SIZE, u64::MAX), UPLOAD_CHUNK_SIZE);
+        assert_eq!(
+            grown_size(UPLOAD_CHUNK_SIZE + 1, u64::MAX),
+            2 * UPLOAD_CHUNK_SIZE
+        );
+        assert_eq!(grown_size(10 * UPLOAD_CHUNK_SIZE, 1024), 1024);
+    }
+}
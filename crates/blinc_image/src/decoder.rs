@@ -0,0 +1,212 @@
+//! Background image decoding
+//!
+//! Decoding a large JPEG or PNG can take tens of milliseconds, far more than a
+//! frame. `ImageDecoder` runs `ImageData::load_sized` on a small pool of
+//! worker threads instead: the renderer requests a decode when an image
+//! first needs drawing, keeps showing its placeholder, and picks up finished
+//! images with `poll` at the start of a later frame.
+
+use std::collections::HashSet;
+use std::sync::mpsc::{self, Receiver, Sender};
+use std::sync::{Arc, Mutex};
+
+use crate::error::Result;
+use crate::loader::ImageData;
+use crate::source::ImageSource;
+
+/// Upper bound on decode worker threads
+const MAX_DECODE_WORKERS: usize = 4;
+
+/// Callback invoked on a worker thread whenever a decode finishes
+pub type DecodeReadyCallback = Arc<dyn Fn() + Send + Sync>;
+
+struct DecodeJob {
+    key: String,
+    source: ImageSource,
+    target: Option<(u32, u32)>,
+}
+
+/// A finished decode returned by `ImageDecoder::poll`
+#[derive(Debug)]
+pub struct DecodedImage {
+    /// Key passed to `ImageDecoder::request`
+    pub key: String,
+    /// Decoded pixels, or why decoding failed
+    pub result: Result<ImageData>,
+}
+
+/// Pool of worker threads decoding images off the render thread
+pub struct ImageDecoder {
+    jobs: Option<Sender<DecodeJob>>,
+    finished: Receiver<DecodedImage>,
+    /// Keys requested but not yet returned by `poll`
+    in_flight: HashSet<String>,
+    on_ready: Arc<Mutex<Option<DecodeReadyCallback>>>,
+}
+
+impl ImageDecoder {
+    /// Create a decoder with one worker per spare core (at most 4)
+    pub fn new() -> Self {
+        let workers = std::thread::available_parallelism()
+            .map(|n| n.get().saturating_sub(1))
+            .unwrap_or(1)
+            .clamp(1, MAX_DECODE_WORKERS);
+        Self::with_workers(workers)
+    }
+
+    /// Create a decoder with a fixed number of worker threads
+    pub fn with_workers(workers: usize) -> Self {
+        let (job_tx, job_rx) = mpsc::channel::<DecodeJob>();
+        let (done_tx, done_rx) = mpsc::channel();
+        let job_rx = Arc::new(Mutex::new(job_rx));
+        let on_ready: Arc<Mutex<Option<DecodeReadyCallback>>> = Arc::new(Mutex::new(None));
+
+        for i in 0..workers.max(1) {
+            let job_rx = Arc::clone(&job_rx);
+            let done_tx = done_tx.clone();
+            let on_ready = Arc::clone(&on_ready);
+            let spawned = std::thread::Builder::new()
+                .name(format!("blinc-image-decode-{}", i))
+                .spawn(move || loop {
+                    // Hold the lock only while waiting, not while decoding
+                    let job = match job_rx.lock().unwrap().recv() {
+                        Ok(job) => job,
+                        Err(_) => break, // Decoder dropped
+                    };
+                    let decoded = DecodedImage {
+                        result: ImageData::load_sized(job.source, job.target),
+                        key: job.key,
+                    };
+                    if done_tx.send(decoded).is_err() {
+                        break;
+                    }
+                    let callback = on_ready.lock().unwrap().clone();
+                    if let Some(callback) = callback {
+                        callback();
+                    }
+                });
+            if let Err(e) = spawned {
+                tracing::warn!("Failed to spawn image decode worker: {}", e);
+            }
+        }
+
+        Self {
+            jobs: Some(job_tx),
+            finished: done_rx,
+            in_flight: HashSet::new(),
+            on_ready,
+        }
+    }
+
+    /// Call `callback` (on a worker thread) each time a decode finishes
+    ///
+    /// Use this to wake an idle event loop so the finished image is drawn.
+    pub fn set_on_ready(&self, callback: impl Fn() + Send + Sync + 'static) {
+        *self.on_ready.lock().unwrap() = Some(Arc::new(callback));
+    }
+
+    /// Queue `source` for decoding under `key`, sized for `target` pixels
+    ///
+    /// Does nothing if `key` is already being decoded. Returns whether a new
+    /// decode was queued.
+    pub fn request(
+        &mut self,
+        key: impl Into<String>,
+        source: ImageSource,
+        target: Option<(u32, u32)>,
+    ) -> bool {
+        let key = key.into();
+        if self.in_flight.contains(&key) {
+            return false;
+        }
+        let Some(jobs) = &self.jobs else {
+            return false;
+        };
+        let job = DecodeJob {
+            key: key.clone(),
+            source,
+            target,
+        };
+        if jobs.send(job).is_err() {
+            return false;
+        }
+        self.in_flight.insert(key);
+        true
+    }
+
+    /// Whether `key` has been requested and not yet returned by `poll`
+    pub fn is_pending(&self, key: &str) -> bool {
+        self.in_flight.contains(key)
+    }
+
+    /// Number of decodes queued or running
+    pub fn pending_count(&self) -> usize {
+        self.in_flight.len()
+    }
+
+    /// Take all decodes that finished since the last call
+    pub fn poll(&mut self) -> Vec<DecodedImage> {
+        let finished: Vec<DecodedImage> = self.finished.try_iter().collect();
+        for image in &finished {
+            self.in_flight.remove(&image.key);
+        }
+        finished
+    }
+}
+
+impl Default for ImageDecoder {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl Drop for ImageDecoder {
+    fn drop(&mut self) {
+        // Closing the job channel lets idle workers exit; busy ones exit after
+        // their current decode (their result send fails)
+        self.jobs = None;
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::time::{Duration, Instant};
+
+    fn poll_until_done(decoder: &mut ImageDecoder) -> Vec<DecodedImage> {
+        let deadline = Instant::now() + Duration::from_secs(5);
+        let mut done = Vec::new();
+        while decoder.pending_count() > 0 && Instant::now() < deadline {
+            done.extend(decoder.poll());
+            std::thread::sleep(Duration::from_millis(1));
+        }
+        done
+    }
+
+    #[test]
+    fn test_decodes_in_background_at_target_size() {
+        let mut decoder = ImageDecoder::with_workers(2);
+        let source = ImageSource::rgba(vec![255; 64 * 64 * 4], 64, 64);
+
+        assert!(decoder.request("avatar", source.clone(), Some((16, 16))));
+        // A second request for the same key while in flight is ignored
+        assert!(!decoder.request("avatar", source, Some((16, 16))));
+
+        let done = poll_until_done(&mut decoder);
+        assert_eq!(done.len(), 1);
+        let image = done[0].result.as_ref().unwrap();
+        assert_eq!(image.dimensions(), (16, 16));
+        assert_eq!(image.source_dimensions(), (64, 64));
+        assert!(!decoder.is_pending("avatar"));
+    }
+
+    #[test]
+    fn test_failed_decode_is_reported() {
+        let mut decoder = ImageDecoder::with_workers(1);
+        decoder.request("broken", ImageSource::bytes(vec![0, 1, 2, 3]), None);
+
+        let done = poll_until_done(&mut decoder);
+        assert_eq!(done.len(), 1);
+        assert!(done[0].result.is_err());
+    }
+}
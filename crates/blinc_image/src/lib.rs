@@ -8,6 +8,7 @@
 //! - Support for PNG, JPEG, GIF, WebP, BMP formats
 //! - CSS-style object-fit options (cover, contain, fill, etc.)
 //! - Image filters: grayscale, sepia, brightness, contrast, blur, etc.
+//! - Background decoding (`ImageDecoder`) with downsample-on-decode
 //!
 //! # Example
 //!
@@ -24,12 +25,14 @@
 //! let data = ImageData::load_async(ImageSource::Url("https://example.com/image.png".into())).await?;
 //! ```
 
+mod decoder;
 mod error;
 mod loader;
 mod source;
 
+pub use decoder::{DecodeReadyCallback, DecodedImage, ImageDecoder};
 pub use error::{ImageError, Result};
-pub use loader::ImageData;
+pub use loader::{downsampled_size, ImageData};
 pub use source::ImageSource;
 
 // ============================================================================
@@ -5,6 +5,30 @@ use crate::source::ImageSource;
 use base64::Engine;
 use image::{DynamicImage, GenericImageView};
 
+/// Downsample only when the target needs less than this fraction of a side
+///
+/// Skipping near-1:1 resizes keeps small images sharp and avoids spending
+/// decode time on savings that don't matter.
+const DOWNSAMPLE_THRESHOLD: f32 = 0.75;
+
+/// Size to decode a `width`x`height` image to so it still covers `target`
+///
+/// Scales uniformly so both sides stay at least as large as the target
+/// (enough for any object-fit, including cover). Returns `None` when the
+/// image is already close to (or smaller than) the target size.
+pub fn downsampled_size(width: u32, height: u32, target: (u32, u32)) -> Option<(u32, u32)> {
+    if width == 0 || height == 0 || target.0 == 0 || target.1 == 0 {
+        return None;
+    }
+    let scale = (target.0 as f32 / width as f32).max(target.1 as f32 / height as f32);
+    if scale >= DOWNSAMPLE_THRESHOLD {
+        return None;
+    }
+    // Round up, ignoring float noise on the side that matches the target exactly
+    let fit = |side: u32| ((side as f32 * scale - 1e-3).ceil() as u32).clamp(1, side);
+    Some((fit(width), fit(height)))
+}
+
 /// Decoded image data ready for GPU upload
 #[derive(Debug, Clone)]
 pub struct ImageData {
@@ -14,6 +38,8 @@ pub struct ImageData {
     width: u32,
     /// Image height in pixels
     height: u32,
+    /// Size of the source image before any downsampling
+    source_size: (u32, u32),
 }
 
 impl ImageData {
@@ -31,6 +57,7 @@ impl ImageData {
             pixels,
             width,
             height,
+            source_size: (width, height),
         })
     }
 
@@ -63,9 +90,7 @@ impl ImageData {
                 }
 
                 // Fallback to direct filesystem access (desktop only)
-                let data = std::fs::read(&path)
-                    .map_err(|e| ImageError::FileLoad(format!("{}: {}", path.display(), e)))?;
-                Self::from_bytes(&data)
+                Self::from_bytes(&read_file(&path)?)
             }
 
             ImageSource::Base64(data) => Self::from_base64(&data),
@@ -110,6 +135,44 @@ impl ImageData {
         }
     }
 
+    /// Load an image, downsampling on decode to what `target` needs
+    ///
+    /// `target` is the largest size (in physical pixels) the image will be
+    /// drawn at. Encoded sources (files, base64, bytes) are decoded and then
+    /// reduced before RGBA conversion, so a 12MP photo shown as a 64px
+    /// avatar keeps a few KB of pixels instead of ~48MB. The result stays at
+    /// least as large as `target` on both sides; use `source_dimensions` to
+    /// find the original size. `None` decodes at full resolution.
+    ///
+    /// Runs entirely on the calling thread; see `ImageDecoder` to decode in
+    /// the background.
+    pub fn load_sized(source: ImageSource, target: Option<(u32, u32)>) -> Result<Self> {
+        match source {
+            ImageSource::File(path) => {
+                #[cfg(feature = "platform")]
+                {
+                    if let Some(loader) = blinc_platform::assets::global_asset_loader() {
+                        let asset_path =
+                            blinc_platform::AssetPath::from(path.to_string_lossy().to_string());
+                        if let Ok(data) = loader.load(&asset_path) {
+                            return Self::from_bytes_sized(&data, target);
+                        }
+                    }
+                }
+                Self::from_bytes_sized(&read_file(&path)?, target)
+            }
+            ImageSource::Base64(data) => Self::from_bytes_sized(&decode_base64(&data)?, target),
+            ImageSource::Bytes { data, format: _ } => Self::from_bytes_sized(&data, target),
+            other => {
+                let image = Self::load(other)?;
+                Ok(match target {
+                    Some(target) => image.downsampled(target),
+                    None => image,
+                })
+            }
+        }
+    }
+
     /// Load an emoji character as an image
     ///
     /// Uses the system emoji font to render the emoji as an RGBA image.
@@ -182,25 +245,46 @@ impl ImageData {
         Self::from_dynamic_image(img)
     }
 
+    /// Decode image from raw bytes, downsampling to what `target` needs
+    ///
+    /// See `load_sized`.
+    pub fn from_bytes_sized(data: &[u8], target: Option<(u32, u32)>) -> Result<Self> {
+        let img = image::load_from_memory(data)?;
+        let source_size = img.dimensions();
+        let img = match target.and_then(|t| downsampled_size(source_size.0, source_size.1, t)) {
+            // Reduce in the decoded format, before the RGBA8 conversion
+            Some((w, h)) => img.thumbnail_exact(w, h),
+            None => img,
+        };
+        let mut data = Self::from_dynamic_image(img)?;
+        data.source_size = source_size;
+        Ok(data)
+    }
+
+    /// A copy reduced to what `target` needs (or `self` if already small)
+    pub fn downsampled(self, target: (u32, u32)) -> Self {
+        let Some((w, h)) = downsampled_size(self.width, self.height, target) else {
+            return self;
+        };
+        let source_size = self.source_size;
+        let rgba = image::RgbaImage::from_raw(self.width, self.height, self.pixels)
+            .expect("ImageData pixel length is validated on construction");
+        let reduced = DynamicImage::ImageRgba8(rgba).thumbnail_exact(w, h);
+        Self {
+            pixels: reduced.to_rgba8().into_raw(),
+            width: w,
+            height: h,
+            source_size,
+        }
+    }
+
     /// Decode image from base64 string
     ///
     /// Supports both plain base64 and data URIs like:
     /// - `iVBORw0KGgo...` (plain base64)
     /// - `data:image/png;base64,iVBORw0KGgo...` (data URI)
     pub fn from_base64(data: &str) -> Result<Self> {
-        // Handle data URI format
-        let base64_data = if data.starts_with("data:") {
-            // Find the base64 marker
-            data.find(";base64,")
-                .map(|pos| &data[pos + 8..])
-                .ok_or_else(|| ImageError::Base64("Invalid data URI format".to_string()))?
-        } else {
-            data
-        };
-
-        // Decode base64
-        let bytes = base64::engine::general_purpose::STANDARD.decode(base64_data)?;
-        Self::from_bytes(&bytes)
+        Self::from_bytes(&decode_base64(data)?)
     }
 
     /// Convert a DynamicImage to ImageData
@@ -213,6 +297,7 @@ impl ImageData {
             pixels,
             width,
             height,
+            source_size: (width, height),
         })
     }
 
@@ -236,6 +321,16 @@ impl ImageData {
         (self.width, self.height)
     }
 
+    /// Size of the source image before any downsampling on decode
+    pub fn source_dimensions(&self) -> (u32, u32) {
+        self.source_size
+    }
+
+    /// Whether these pixels are smaller than the source image
+    pub fn is_downsampled(&self) -> bool {
+        self.source_size != (self.width, self.height)
+    }
+
     /// Get the aspect ratio (width / height)
     pub fn aspect_ratio(&self) -> f32 {
         self.width as f32 / self.height as f32
@@ -252,6 +347,26 @@ impl ImageData {
     }
 }
 
+/// Read an encoded image file from disk
+fn read_file(path: &std::path::Path) -> Result<Vec<u8>> {
+    std::fs::read(path).map_err(|e| ImageError::FileLoad(format!("{}: {}", path.display(), e)))
+}
+
+/// Decode plain base64 or a `data:` URI into encoded image bytes
+fn decode_base64(data: &str) -> Result<Vec<u8>> {
+    // Handle data URI format
+    let base64_data = if data.starts_with("data:") {
+        // Find the base64 marker
+        data.find(";base64,")
+            .map(|pos| &data[pos + 8..])
+            .ok_or_else(|| ImageError::Base64("Invalid data URI format".to_string()))?
+    } else {
+        data
+    };
+
+    Ok(base64::engine::general_purpose::STANDARD.decode(base64_data)?)
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -289,4 +404,25 @@ mod tests {
         assert_eq!(img.width(), 1);
         assert_eq!(img.height(), 1);
     }
+
+    #[test]
+    fn test_downsampled_size_covers_target() {
+        // 4000x3000 photo shown as a 64x64 avatar: the short side must still cover 64
+        assert_eq!(downsampled_size(4000, 3000, (64, 64)), Some((86, 64)));
+        // Close to the target size: decode as-is
+        assert_eq!(downsampled_size(100, 100, (90, 90)), None);
+        // Smaller than the target: never upscale
+        assert_eq!(downsampled_size(32, 32, (64, 64)), None);
+    }
+
+    #[test]
+    fn test_downsampled_keeps_source_dimensions() {
+        let data = ImageData::from_rgba(vec![255; 16 * 8 * 4], 16, 8).unwrap();
+        let small = data.downsampled((4, 2));
+
+        assert_eq!(small.dimensions(), (4, 2));
+        assert_eq!(small.byte_len(), 4 * 2 * 4);
+        assert_eq!(small.source_dimensions(), (16, 8));
+        assert!(small.is_downsampled());
+    }
 }
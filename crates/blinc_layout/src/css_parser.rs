@@ -47,8 +47,26 @@
 //! // Apply styles to elements
 //! div().id("card").style(stylesheet.get("card").unwrap())
 //! ```
+//!
+//! # Precompiled Stylesheets
+//!
+//! Large stylesheets can be compiled at build time with `blinc css compile`
+//! (or `Stylesheet::compile` from a build script) and embedded in the binary.
+//! Loading the compiled form does no CSS parsing: selectors and declarations
+//! are borrowed straight from the embedded bytes, and a rule's values are
+//! only parsed the first time it is looked up. `theme()` references are kept
+//! unresolved, so they pick up the theme that is active at that point, just as
+//! parsing the CSS at startup would.
+//!
+//! ```ignore
+//! static THEME_CSS: &[u8] = include_bytes!(concat!(env!("OUT_DIR"), "/theme.bcss"));
+//!
+//! let stylesheet = Stylesheet::from_compiled(THEME_CSS)?;
+//! ```
 
+use std::borrow::Cow;
 use std::collections::HashMap;
+use std::sync::OnceLock;
 
 use blinc_core::{
     Brush, Color, CornerRadius, Gradient, GradientSpace, GradientStop, Point, Shadow, Transform,
@@ -458,6 +476,18 @@ pub enum ElementState {
 }
 
 impl ElementState {
+    /// All states, in the order their rules take precedence (later wins)
+    pub const ALL: [ElementState; 4] = [
+        ElementState::Hover,
+        ElementState::Active,
+        ElementState::Focus,
+        ElementState::Disabled,
+    ];
+
+    fn index(self) -> usize {
+        self as usize
+    }
+
     /// Parse a state from a pseudo-class string
     pub fn from_str(s: &str) -> Option<Self> {
         match s.to_lowercase().as_str() {
@@ -481,6 +511,47 @@ impl std::fmt::Display for ElementState {
     }
 }
 
+/// A set of element states, used to look up merged styles
+///
+/// # Example
+///
+/// ```ignore
+/// let states = ElementStates::from_interaction(hovered, pressed, focused);
+/// let style = stylesheet.computed_style("button", states);
+/// ```
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq, Hash)]
+pub struct ElementStates(u8);
+
+impl ElementStates {
+    /// No states (the element's base style only)
+    pub const NONE: ElementStates = ElementStates(0);
+
+    /// States from an element's interaction flags
+    pub fn from_interaction(hovered: bool, pressed: bool, focused: bool) -> Self {
+        let mut states = Self::NONE;
+        for (state, on) in [
+            (ElementState::Hover, hovered),
+            (ElementState::Active, pressed),
+            (ElementState::Focus, focused),
+        ] {
+            if on {
+                states = states.with(state);
+            }
+        }
+        states
+    }
+
+    /// Add a state to the set
+    pub fn with(self, state: ElementState) -> Self {
+        Self(self.0 | 1 << state.index())
+    }
+
+    /// Check if the set contains a state
+    pub fn contains(self, state: ElementState) -> bool {
+        self.0 & 1 << state.index() != 0
+    }
+}
+
 /// A parsed CSS selector with optional state modifier
 #[derive(Debug, Clone, PartialEq, Eq, Hash)]
 pub struct CssSelector {
@@ -834,11 +905,111 @@ pub enum AnimationFillMode {
     Both,
 }
 
+/// Split a selector key (`id` or `id:state`) into its id and state
+fn split_selector_key(key: &str) -> (&str, Option<ElementState>) {
+    match key.rsplit_once(':') {
+        Some((id, state)) => match ElementState::from_str(state) {
+            Some(state) => (id, Some(state)),
+            None => (key, None),
+        },
+        None => (key, None),
+    }
+}
+
+/// One selector's rule
+///
+/// Rules loaded from a compiled stylesheet hold their declarations as slices
+/// of the embedded data and are turned into an `ElementStyle` on first use.
+#[derive(Clone, Debug)]
+struct StyleRule {
+    /// Selector key (`id` or `id:state`)
+    selector: Cow<'static, str>,
+    /// `(property, value)` pairs still to be applied
+    declarations: Vec<(&'static str, &'static str)>,
+    style: OnceLock<ElementStyle>,
+}
+
+impl StyleRule {
+    fn parsed(selector: String, style: ElementStyle) -> Self {
+        Self {
+            selector: Cow::Owned(selector),
+            declarations: Vec::new(),
+            style: OnceLock::from(style),
+        }
+    }
+
+    fn compiled(selector: &'static str, declarations: Vec<(&'static str, &'static str)>) -> Self {
+        Self {
+            selector: Cow::Borrowed(selector),
+            declarations,
+            style: OnceLock::new(),
+        }
+    }
+
+    fn style(&self) -> &ElementStyle {
+        self.style.get_or_init(|| {
+            let mut style = ElementStyle::new();
+            for (name, value) in &self.declarations {
+                apply_property(&mut style, name, value);
+            }
+            style
+        })
+    }
+}
+
+/// All rules for one element ID
+///
+/// Bucketing by ID means a lookup touches only the rules that can match the
+/// element, without building `id:state` keys.
+#[derive(Clone, Debug, Default)]
+struct ElementRules {
+    /// `#id`
+    base: Option<StyleRule>,
+    /// `#id:state`, indexed by `ElementState::index`
+    states: [Option<StyleRule>; ElementState::ALL.len()],
+    /// Base and state rules merged, per `ElementStates` combination
+    computed: [OnceLock<Option<ElementStyle>>; 1 << ElementState::ALL.len()],
+}
+
+impl ElementRules {
+    fn rule(&self, state: Option<ElementState>) -> Option<&StyleRule> {
+        match state {
+            None => self.base.as_ref(),
+            Some(state) => self.states[state.index()].as_ref(),
+        }
+    }
+
+    fn rules(&self) -> impl Iterator<Item = &StyleRule> {
+        self.base.iter().chain(self.states.iter().flatten())
+    }
+
+    fn computed(&self, states: ElementStates) -> Option<&ElementStyle> {
+        self.computed[states.0 as usize]
+            .get_or_init(|| {
+                let mut merged: Option<ElementStyle> =
+                    self.base.as_ref().map(|r| r.style().clone());
+                for state in ElementState::ALL {
+                    if !states.contains(state) {
+                        continue;
+                    }
+                    if let Some(rule) = &self.states[state.index()] {
+                        merged = Some(match merged {
+                            Some(style) => style.merge(rule.style()),
+                            None => rule.style().clone(),
+                        });
+                    }
+                }
+                merged
+            })
+            .as_ref()
+    }
+}
+
 /// A parsed stylesheet containing styles keyed by element ID
 #[derive(Clone, Default, Debug)]
 pub struct Stylesheet {
-    /// Styles keyed by selector (id or id:state)
-    styles: HashMap<String, ElementStyle>,
+    /// Rules bucketed by element ID
+    styles: HashMap<Cow<'static, str>, ElementRules>,
     /// CSS custom properties (variables) defined in :root
     variables: HashMap<String, String>,
     /// Keyframe animations defined with @keyframes
@@ -870,6 +1041,12 @@ impl Stylesheet {
     /// let stylesheet = result.stylesheet;
     /// ```
     pub fn parse_with_errors(css: &str) -> CssParseResult {
+        Self::parse_counting_blocks(css).0
+    }
+
+    /// `parse_with_errors`, also counting the rule and `@keyframes` blocks
+    /// parsed (before rules for the same selector are merged)
+    fn parse_counting_blocks(css: &str) -> (CssParseResult, BlockCounts) {
         let mut errors: Vec<ParseError> = Vec::new();
         let initial_vars = HashMap::new();
 
@@ -891,10 +1068,14 @@ impl Stylesheet {
                     });
                 }
 
+                let counts = BlockCounts {
+                    rules: parsed.rules.len(),
+                    keyframes: parsed.keyframes.len(),
+                };
                 let mut stylesheet = Stylesheet::new();
                 stylesheet.variables = parsed.variables;
-                for (id, style) in parsed.rules {
-                    stylesheet.styles.insert(id, style);
+                for (selector, style) in parsed.rules {
+                    stylesheet.insert_rule(StyleRule::parsed(selector, style));
                 }
                 for keyframes in parsed.keyframes {
                     stylesheet
@@ -902,16 +1083,17 @@ impl Stylesheet {
                         .insert(keyframes.name.clone(), keyframes);
                 }
 
-                CssParseResult { stylesheet, errors }
+                (CssParseResult { stylesheet, errors }, counts)
             }
             Err(e) => {
                 let parse_error = ParseError::from_verbose(css, e);
                 errors.push(parse_error);
 
-                CssParseResult {
+                let result = CssParseResult {
                     stylesheet: Stylesheet::new(),
                     errors,
-                }
+                };
+                (result, BlockCounts::default())
             }
         }
     }
@@ -956,11 +1138,158 @@ impl Stylesheet {
         Self::parse(css).unwrap_or_default()
     }
 
+    // =========================================================================
+    // Precompiled Stylesheets
+    // =========================================================================
+
+    /// Compile CSS text into the binary form loaded by `from_compiled`
+    ///
+    /// Meant for build time (`blinc css compile`, or a build script). The CSS
+    /// is fully parsed first, so any diagnostics surface then; on errors the
+    /// whole parse result is returned for reporting. Declarations that only
+    /// produced warnings (unknown properties, invalid values) are dropped.
+    ///
+    /// `var()` references are resolved here, but `theme()` references are
+    /// kept and resolved when a rule is first used. Like `parse`, this needs
+    /// `ThemeState` initialized if the CSS uses `theme()`.
+    pub fn compile(css: &str) -> Result<Vec<u8>, CssParseResult> {
+        let (mut result, parsed) = Self::parse_counting_blocks(css);
+        if result.has_errors() {
+            return Err(result);
+        }
+        result.log_diagnostics();
+
+        // Never write a stylesheet missing blocks the parser accepted
+        let (compiled, stopped_at) = collect_compiled_blocks(css);
+        let counts = BlockCounts {
+            rules: compiled.rules.len(),
+            keyframes: compiled.keyframes.len(),
+        };
+        if counts != parsed {
+            let (line, column, fragment) = calculate_position(css, stopped_at);
+            let mut error = ParseError::new(
+                Severity::Error,
+                format!(
+                    "Compiled {} rules and {} @keyframes blocks, but parsed {} and {}",
+                    counts.rules, counts.keyframes, parsed.rules, parsed.keyframes
+                ),
+                line,
+                column,
+            );
+            error.fragment = fragment;
+            result.errors.push(error);
+            return Err(result);
+        }
+        let mut out = Vec::with_capacity(css.len());
+        out.extend_from_slice(COMPILED_MAGIC);
+        put_u32(&mut out, COMPILED_VERSION);
+
+        put_u32(&mut out, compiled.rules.len() as u32);
+        for (selector, declarations) in &compiled.rules {
+            put_str(&mut out, selector);
+            put_u32(&mut out, declarations.len() as u32);
+            for (name, value) in declarations {
+                put_str(&mut out, name);
+                put_str(&mut out, value);
+            }
+        }
+
+        put_u32(&mut out, compiled.variables.len() as u32);
+        for (name, value) in &compiled.variables {
+            put_str(&mut out, name);
+            put_str(&mut out, value);
+        }
+
+        put_u32(&mut out, compiled.keyframes.len() as u32);
+        for source in &compiled.keyframes {
+            put_str(&mut out, source);
+        }
+
+        Ok(out)
+    }
+
+    /// Load a stylesheet produced by `compile`
+    ///
+    /// The data is typically embedded with `include_bytes!`. Selectors and
+    /// declarations are borrowed from it rather than copied, and each rule's
+    /// values are parsed the first time the rule is used. Keyframes are parsed
+    /// here, since resolving animations needs them whole.
+    pub fn from_compiled(data: &'static [u8]) -> Result<Self, ParseError> {
+        let mut reader = CompiledReader { data, pos: 0 };
+        if reader.bytes(COMPILED_MAGIC.len())? != COMPILED_MAGIC {
+            return Err(compiled_error("not a compiled stylesheet"));
+        }
+        let version = reader.u32()?;
+        if version != COMPILED_VERSION {
+            return Err(compiled_error(format!(
+                "compiled stylesheet version {} is not supported (expected {})",
+                version, COMPILED_VERSION
+            )));
+        }
+
+        let mut stylesheet = Stylesheet::new();
+        for _ in 0..reader.u32()? {
+            let selector = reader.str()?;
+            let count = reader.u32()? as usize;
+            let mut declarations = Vec::with_capacity(count.min(reader.remaining() / 8));
+            for _ in 0..count {
+                declarations.push((reader.str()?, reader.str()?));
+            }
+            stylesheet.insert_rule(StyleRule::compiled(selector, declarations));
+        }
+
+        for _ in 0..reader.u32()? {
+            let name = reader.str()?;
+            let value = reader.str()?;
+            stylesheet
+                .variables
+                .insert(name.to_string(), value.to_string());
+        }
+
+        for _ in 0..reader.u32()? {
+            let source = reader.str()?;
+            let mut errors = Vec::new();
+            match keyframes_block(source, &mut errors, &stylesheet.variables) {
+                Ok((_, keyframes)) => stylesheet.add_keyframes(keyframes),
+                Err(_) => debug!("Skipping unparseable compiled @keyframes block"),
+            }
+        }
+
+        Ok(stylesheet)
+    }
+
+    /// Store a rule, replacing any earlier rule for the same selector
+    fn insert_rule(&mut self, rule: StyleRule) {
+        let (id, state) = match &rule.selector {
+            Cow::Borrowed(selector) => {
+                let (id, state) = split_selector_key(selector);
+                (Cow::Borrowed(id), state)
+            }
+            Cow::Owned(selector) => {
+                let (id, state) = split_selector_key(selector);
+                (Cow::Owned(id.to_string()), state)
+            }
+        };
+
+        let rules = self.styles.entry(id).or_default();
+        match state {
+            None => rules.base = Some(rule),
+            Some(state) => rules.states[state.index()] = Some(rule),
+        }
+        rules.computed = Default::default();
+    }
+
+    fn rule(&self, id: &str, state: Option<ElementState>) -> Option<&StyleRule> {
+        self.styles.get(id)?.rule(state)
+    }
+
     /// Get a style by element ID (without the # prefix)
     ///
-    /// Returns `None` if no style is defined for the given ID.
+    /// Returns `None` if no style is defined for the given ID. An `id:state`
+    /// key looks up that state's style.
     pub fn get(&self, id: &str) -> Option<&ElementStyle> {
-        self.styles.get(id)
+        let (id, state) = split_selector_key(id);
+        self.rule(id, state).map(StyleRule::style)
     }
 
     /// Get a style by element ID and state
@@ -975,8 +1304,7 @@ impl Stylesheet {
     /// let hover_style = stylesheet.get_with_state("button", ElementState::Hover);
     /// ```
     pub fn get_with_state(&self, id: &str, state: ElementState) -> Option<&ElementStyle> {
-        let key = format!("{}:{}", id, state);
-        self.styles.get(&key)
+        self.rule(id, Some(state)).map(StyleRule::style)
     }
 
     /// Get all styles for an element, including state variants
@@ -999,17 +1327,11 @@ impl Stylesheet {
         &self,
         id: &str,
     ) -> (Option<&ElementStyle>, Vec<(ElementState, &ElementStyle)>) {
-        let base = self.styles.get(id);
+        let base = self.get(id);
 
         let mut state_styles = Vec::new();
-        for state in [
-            ElementState::Hover,
-            ElementState::Active,
-            ElementState::Focus,
-            ElementState::Disabled,
-        ] {
-            let key = format!("{}:{}", id, state);
-            if let Some(style) = self.styles.get(&key) {
+        for state in ElementState::ALL {
+            if let Some(style) = self.get_with_state(id, state) {
                 state_styles.push((state, style));
             }
         }
@@ -1017,25 +1339,53 @@ impl Stylesheet {
         (base, state_styles)
     }
 
+    /// Get an element's base style merged with the styles of its states
+    ///
+    /// State styles are applied in `ElementState::ALL` order, so e.g.
+    /// `:active` overrides `:hover`. The merged style is cached per ID and
+    /// state combination, so repeated lookups (every rebuild, every hover
+    /// change) return the same style without merging again.
+    ///
+    /// Returns `None` if neither the base style nor any of the states' styles
+    /// are defined.
+    pub fn computed_style(&self, id: &str, states: ElementStates) -> Option<&ElementStyle> {
+        self.styles.get(id)?.computed(states)
+    }
+
     /// Check if a style exists for the given ID
     pub fn contains(&self, id: &str) -> bool {
-        self.styles.contains_key(id)
+        let (id, state) = split_selector_key(id);
+        self.rule(id, state).is_some()
     }
 
     /// Check if a style exists for the given ID and state
     pub fn contains_with_state(&self, id: &str, state: ElementState) -> bool {
-        let key = format!("{}:{}", id, state);
-        self.styles.contains_key(&key)
+        self.rule(id, Some(state)).is_some()
+    }
+
+    /// Check if any state style (`:hover`, `:active`, ...) exists for the given ID
+    pub fn has_state_styles(&self, id: &str) -> bool {
+        self.styles
+            .get(id)
+            .is_some_and(|rules| rules.states.iter().any(Option::is_some))
     }
 
     /// Get all style IDs in the stylesheet
+    ///
+    /// State styles are listed by their `id:state` key.
     pub fn ids(&self) -> impl Iterator<Item = &str> {
-        self.styles.keys().map(|s| s.as_str())
+        self.styles
+            .values()
+            .flat_map(ElementRules::rules)
+            .map(|rule| rule.selector.as_ref())
     }
 
     /// Get the number of styles in the stylesheet
     pub fn len(&self) -> usize {
-        self.styles.len()
+        self.styles
+            .values()
+            .map(|rules| rules.rules().count())
+            .sum()
     }
 
     /// Check if the stylesheet is empty
@@ -1546,6 +1896,13 @@ where
     }
 }
 
+/// Number of blocks of each kind found in a stylesheet
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+struct BlockCounts {
+    rules: usize,
+    keyframes: usize,
+}
+
 /// Result of parsing a stylesheet - rules, variables, and keyframes
 struct ParsedStylesheet {
     rules: Vec<(String, ElementStyle)>,
@@ -1568,7 +1925,8 @@ fn parse_stylesheet_with_errors<'a>(
     let mut remaining = input;
 
     loop {
-        let trimmed = remaining.trim_start();
+        // Comments may sit between blocks
+        let (trimmed, _) = ws(remaining)?;
         if trimmed.is_empty() {
             break;
         }
@@ -1630,6 +1988,153 @@ fn parse_stylesheet_with_errors<'a>(
     ))
 }
 
+/// Blocks of a stylesheet as `Stylesheet::compile` stores them
+struct CompiledBlocks<'a> {
+    /// Selector key and `(property, value)` pairs with `var()` resolved
+    rules: Vec<(String, Vec<(&'a str, String)>)>,
+    variables: Vec<(String, String)>,
+    /// Source text of each `@keyframes` block
+    keyframes: Vec<&'a str>,
+}
+
+/// Split a stylesheet into blocks for compilation
+///
+/// Walks the CSS the same way `parse_stylesheet_with_errors` does, but keeps
+/// declarations as text instead of applying them. Also returns the input
+/// left when no further block could be read.
+fn collect_compiled_blocks(css: &str) -> (CompiledBlocks<'_>, &str) {
+    let mut blocks = CompiledBlocks {
+        rules: Vec::new(),
+        variables: Vec::new(),
+        keyframes: Vec::new(),
+    };
+    let mut variables = HashMap::new();
+    let mut remaining = css;
+
+    loop {
+        let trimmed = match ws::<VerboseError<&str>>(remaining) {
+            Ok((rest, _)) => rest,
+            Err(_) => remaining,
+        };
+        remaining = trimmed;
+        if trimmed.is_empty() {
+            break;
+        }
+
+        if trimmed.starts_with(":root") {
+            if let Ok((rest, vars)) = root_block(trimmed) {
+                for (name, value) in vars {
+                    variables.insert(name.clone(), value.clone());
+                    blocks.variables.push((name, value));
+                }
+                remaining = rest;
+                continue;
+            }
+        }
+
+        if trimmed.starts_with("@keyframes") {
+            let mut errors = Vec::new();
+            if let Ok((rest, _)) = keyframes_block(trimmed, &mut errors, &variables) {
+                blocks
+                    .keyframes
+                    .push(&trimmed[..trimmed.len() - rest.len()]);
+                remaining = rest;
+                continue;
+            }
+        }
+
+        let (rest, (selector, properties)) = match css_rule_declarations(trimmed) {
+            Ok(parsed) => parsed,
+            Err(_) => break,
+        };
+        let mut declarations = Vec::with_capacity(properties.len());
+        for (name, value) in properties {
+            let value = resolve_var_references(value, &variables);
+            // Drop declarations the parser would ignore (with a warning)
+            let mut errors = Vec::new();
+            apply_property_with_errors(
+                &mut ElementStyle::new(),
+                name,
+                &value,
+                css,
+                rest,
+                &mut errors,
+            );
+            if errors.is_empty() {
+                declarations.push((name, value));
+            }
+        }
+        blocks.rules.push((selector, declarations));
+        remaining = rest;
+    }
+
+    (blocks, remaining)
+}
+
+/// Parse a rule's selector and declarations without applying them
+fn css_rule_declarations(input: &str) -> ParseResult<(String, Vec<(&str, &str)>)> {
+    let (input, _) = ws(input)?;
+    let (input, selector) = context("CSS rule selector", id_selector)(input)?;
+    let (input, _) = ws(input)?;
+    let (input, properties) = context("CSS rule block", rule_block)(input)?;
+    Ok((input, (selector.key(), properties)))
+}
+
+/// Leading bytes of a compiled stylesheet
+const COMPILED_MAGIC: &[u8; 4] = b"BCSS";
+/// Format version of compiled stylesheets, bumped on layout changes
+const COMPILED_VERSION: u32 = 1;
+
+// Compiled layout: magic, version, then three sections (rules, variables,
+// keyframes), each a u32 count followed by its entries. Strings are a u32
+// byte length followed by UTF-8. Integers are little-endian.
+
+fn put_u32(out: &mut Vec<u8>, value: u32) {
+    out.extend_from_slice(&value.to_le_bytes());
+}
+
+fn put_str(out: &mut Vec<u8>, value: &str) {
+    put_u32(out, value.len() as u32);
+    out.extend_from_slice(value.as_bytes());
+}
+
+fn compiled_error(message: impl Into<String>) -> ParseError {
+    ParseError::new(Severity::Error, message, 0, 0)
+}
+
+/// Cursor over compiled stylesheet data
+struct CompiledReader {
+    data: &'static [u8],
+    pos: usize,
+}
+
+impl CompiledReader {
+    fn remaining(&self) -> usize {
+        self.data.len() - self.pos
+    }
+
+    fn bytes(&mut self, len: usize) -> Result<&'static [u8], ParseError> {
+        if len > self.remaining() {
+            return Err(compiled_error("compiled stylesheet is truncated"));
+        }
+        let data: &'static [u8] = self.data;
+        let bytes = &data[self.pos..self.pos + len];
+        self.pos += len;
+        Ok(bytes)
+    }
+
+    fn u32(&mut self) -> Result<u32, ParseError> {
+        let bytes = self.bytes(4)?;
+        Ok(u32::from_le_bytes([bytes[0], bytes[1], bytes[2], bytes[3]]))
+    }
+
+    fn str(&mut self) -> Result<&'static str, ParseError> {
+        let len = self.u32()? as usize;
+        std::str::from_utf8(self.bytes(len)?)
+            .map_err(|_| compiled_error("compiled stylesheet contains invalid UTF-8"))
+    }
+}
+
 /// Parse a complete rule with error collection and variable resolution: #id { ... } or #id:state { ... }
 fn css_rule_with_errors_and_vars<'a, 'b>(
     original_css: &'a str,
@@ -3956,6 +4461,132 @@ mod tests {
         assert!(state_types.contains(&ElementState::Active));
     }
 
+    #[test]
+    fn test_computed_style_merges_states() {
+        let css = r#"
+            #button { opacity: 1.0; border-radius: 4px; }
+            #button:hover { opacity: 0.9; }
+            #button:active { opacity: 0.8; }
+            #badge:hover { opacity: 0.5; }
+        "#;
+        let stylesheet = Stylesheet::parse(css).unwrap();
+
+        let base = stylesheet
+            .computed_style("button", ElementStates::NONE)
+            .unwrap();
+        assert_eq!(base.opacity, Some(1.0));
+
+        let hovered = ElementStates::from_interaction(true, false, false);
+        let style = stylesheet.computed_style("button", hovered).unwrap();
+        assert_eq!(style.opacity, Some(0.9));
+        assert!(style.corner_radius.is_some());
+
+        // Active wins over hover, and the merge is cached
+        let pressed = ElementStates::from_interaction(true, true, false);
+        let style = stylesheet.computed_style("button", pressed).unwrap();
+        assert_eq!(style.opacity, Some(0.8));
+        assert!(std::ptr::eq(
+            style,
+            stylesheet.computed_style("button", pressed).unwrap()
+        ));
+
+        // State-only rules apply just in their state
+        assert!(stylesheet
+            .computed_style("badge", ElementStates::NONE)
+            .is_none());
+        assert_eq!(
+            stylesheet.computed_style("badge", hovered).unwrap().opacity,
+            Some(0.5)
+        );
+        assert!(stylesheet.has_state_styles("badge"));
+        assert!(stylesheet.computed_style("missing", hovered).is_none());
+
+        // `id:state` keys still resolve through `get`
+        assert_eq!(stylesheet.len(), 4);
+        assert_eq!(stylesheet.get("button:hover").unwrap().opacity, Some(0.9));
+        let mut ids: Vec<_> = stylesheet.ids().collect();
+        ids.sort();
+        assert_eq!(
+            ids,
+            ["badge:hover", "button", "button:active", "button:hover"]
+        );
+    }
+
+    #[test]
+    fn test_compiled_stylesheet_roundtrip() {
+        let css = r#"
+            :root { --accent: #FF0000; }
+            @keyframes fade-in {
+                from { opacity: 0; }
+                to { opacity: 1; }
+            }
+            #card {
+                background: var(--accent);
+                opacity: 0.5;
+                made-up: 1;
+                animation: fade-in 300ms ease-out;
+            }
+            #card:hover { opacity: 0.8; }
+        "#;
+        let compiled = Stylesheet::compile(css).unwrap();
+        let compiled: &'static [u8] = Box::leak(compiled.into_boxed_slice());
+        let stylesheet = Stylesheet::from_compiled(compiled).unwrap();
+
+        let parsed = Stylesheet::parse(css).unwrap();
+        let card = stylesheet.get("card").unwrap();
+        assert_eq!(card.opacity, parsed.get("card").unwrap().opacity);
+        assert!(matches!(
+            card.background,
+            Some(Brush::Solid(color)) if color == Color::rgb(1.0, 0.0, 0.0)
+        ));
+        assert_eq!(
+            stylesheet
+                .get_with_state("card", ElementState::Hover)
+                .unwrap()
+                .opacity,
+            Some(0.8)
+        );
+        assert_eq!(stylesheet.len(), 2);
+        assert_eq!(stylesheet.get_variable("accent"), Some("#FF0000"));
+        assert!(stylesheet.contains_keyframes("fade-in"));
+        assert!(stylesheet.resolve_animation("card").is_some());
+    }
+
+    #[test]
+    fn test_compile_keeps_blocks_after_comments() {
+        let css = r#"
+            /* Brand colors */
+            :root { --accent: #FF0000; }
+            /* Entrance */
+            @keyframes fade-in {
+                from { opacity: 0; }
+                to { opacity: 1; }
+            }
+            /* Cards */ #card { background: var(--accent); }
+            #badge { opacity: 0.5; } /* trailing */
+        "#;
+        let compiled = Stylesheet::compile(css).unwrap();
+        let compiled: &'static [u8] = Box::leak(compiled.into_boxed_slice());
+        let stylesheet = Stylesheet::from_compiled(compiled).unwrap();
+
+        assert_eq!(stylesheet.len(), 2);
+        assert_eq!(stylesheet.get_variable("accent"), Some("#FF0000"));
+        assert!(stylesheet.contains_keyframes("fade-in"));
+        assert!(matches!(
+            stylesheet.get("card").unwrap().background,
+            Some(Brush::Solid(color)) if color == Color::rgb(1.0, 0.0, 0.0)
+        ));
+        assert_eq!(stylesheet.get("badge").unwrap().opacity, Some(0.5));
+    }
+
+    #[test]
+    fn test_from_compiled_rejects_bad_data() {
+        assert!(Stylesheet::from_compiled(b"not css").is_err());
+        let compiled = Stylesheet::compile("#card { opacity: 0.5; }").unwrap();
+        let truncated: &'static [u8] = Box::leak(compiled[..compiled.len() - 2].into());
+        assert!(Stylesheet::from_compiled(truncated).is_err());
+    }
+
     #[test]
     fn test_state_modifier_with_variables() {
         let css = r#"
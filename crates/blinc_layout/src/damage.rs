@@ -0,0 +1,321 @@
+//! Damage tracking for partial redraws
+//!
+//! `RenderTree` records which nodes changed between frames (prop updates,
+//! subtree rebuilds, motion bindings, scroll offsets) and resolves them into
+//! screen-space rectangles with `RenderTree::take_damage`. A renderer that
+//! keeps the previous frame around can then re-encode only what intersects
+//! the damage instead of repainting the whole drawable.
+
+use std::collections::HashMap;
+
+use blinc_core::{Rect, Transform};
+
+use crate::tree::LayoutNodeId;
+
+/// Maximum number of separate damage rects before they collapse into one
+pub const MAX_DAMAGE_RECTS: usize = 8;
+
+/// Damaged fraction of the viewport above which a full repaint is cheaper
+const FULL_DAMAGE_AREA_FRACTION: f32 = 0.6;
+
+/// Extra margin (physical pixels) around damaged bounds for anti-aliasing
+const DAMAGE_MARGIN: f32 = 2.0;
+
+/// Screen regions that changed since the last frame
+#[derive(Clone, Debug, Default, PartialEq)]
+pub enum Damage {
+    /// Nothing visible changed - the previous frame can be reused as-is
+    #[default]
+    None,
+    /// Only these regions changed (physical pixels, non-overlapping)
+    Rects(Vec<Rect>),
+    /// Everything must be repainted
+    Full,
+}
+
+impl Damage {
+    /// Whether nothing changed
+    pub fn is_none(&self) -> bool {
+        matches!(self, Damage::None)
+    }
+
+    /// Whether the whole frame must be repainted
+    pub fn is_full(&self) -> bool {
+        matches!(self, Damage::Full)
+    }
+
+    /// The damaged regions (empty for `None` and `Full`)
+    pub fn rects(&self) -> &[Rect] {
+        match self {
+            Damage::Rects(rects) => rects,
+            _ => &[],
+        }
+    }
+
+    /// Bounding box of all damaged regions (None for `None` and `Full`)
+    pub fn bounds(&self) -> Option<Rect> {
+        self.rects().iter().copied().reduce(union_rect)
+    }
+
+    /// Combine with damage from another source
+    ///
+    /// Overlapping rects are merged, so `Rects` stays non-overlapping.
+    pub fn merge(&mut self, other: Damage) {
+        match (std::mem::take(self), other) {
+            (Damage::Full, _) | (_, Damage::Full) => *self = Damage::Full,
+            (Damage::None, other) | (other, Damage::None) => *self = other,
+            (Damage::Rects(a), Damage::Rects(b)) => {
+                let mut acc = DamageAccumulator::default();
+                for rect in a.into_iter().chain(b) {
+                    acc.add(rect);
+                }
+                *self = Damage::Rects(acc.rects);
+            }
+        }
+    }
+}
+
+/// Per-tree damage state, owned by `RenderTree`
+#[derive(Debug)]
+pub(crate) struct DamageTracker {
+    /// Repaint everything on the next `take_damage`
+    full: bool,
+    /// Nodes changed since the last frame, with their element transform from
+    /// before the first change (so shrinking transforms damage the old area)
+    pending: HashMap<LayoutNodeId, Option<Transform>>,
+    /// Motion-bound nodes as sampled on the last `take_damage`
+    pub(crate) motion_samples: HashMap<LayoutNodeId, MotionSample>,
+    /// Scroll containers as sampled on the last `take_damage`
+    pub(crate) scroll_samples: HashMap<LayoutNodeId, ScrollSample>,
+    /// Whether the last `take_damage` only found scroll changes
+    pub(crate) scroll_only: bool,
+}
+
+impl Default for DamageTracker {
+    /// A new tree has never been drawn, so it starts fully damaged
+    fn default() -> Self {
+        Self {
+            full: true,
+            pending: HashMap::new(),
+            motion_samples: HashMap::new(),
+            scroll_samples: HashMap::new(),
+            scroll_only: false,
+        }
+    }
+}
+
+impl DamageTracker {
+    /// Repaint everything on the next frame
+    pub(crate) fn mark_full(&mut self) {
+        self.full = true;
+        self.pending.clear();
+    }
+
+    /// Record a change to a node, keeping its transform from before the change
+    pub(crate) fn mark_node(&mut self, node_id: LayoutNodeId, old_transform: Option<Transform>) {
+        if !self.full {
+            self.pending.entry(node_id).or_insert(old_transform);
+        }
+    }
+
+    /// Take the full flag and pending nodes, resetting both
+    pub(crate) fn take(&mut self) -> (bool, HashMap<LayoutNodeId, Option<Transform>>) {
+        (
+            std::mem::take(&mut self.full),
+            std::mem::take(&mut self.pending),
+        )
+    }
+}
+
+/// Screen-space state of a motion-bound node on the last frame
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub(crate) struct MotionSample {
+    /// Node-to-screen matrix elements, including motion transforms
+    pub matrix: [f32; 6],
+    /// Motion opacity
+    pub opacity: f32,
+    /// Screen bounds of the node's subtree
+    pub bounds: Option<Rect>,
+}
+
+/// Scroll state of a scroll container on the last frame
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub(crate) struct ScrollSample {
+    pub offset: (f32, f32),
+    pub scrollbar_opacity: f32,
+    pub scrollbar_active: bool,
+}
+
+/// Collects damage rects (logical pixels) during a damage walk
+#[derive(Debug, Default)]
+pub(crate) struct DamageAccumulator {
+    rects: Vec<Rect>,
+    full: bool,
+}
+
+impl DamageAccumulator {
+    /// Give up on partial damage
+    pub(crate) fn mark_full(&mut self) {
+        self.full = true;
+        self.rects.clear();
+    }
+
+    /// Add a damaged region, merging it with any rect it overlaps
+    pub(crate) fn add(&mut self, rect: Rect) {
+        if self.full || rect.width() <= 0.0 || rect.height() <= 0.0 {
+            return;
+        }
+
+        let mut rect = rect;
+        while let Some(i) = self
+            .rects
+            .iter()
+            .position(|r| intersect_rect(*r, rect).is_some())
+        {
+            rect = union_rect(self.rects.swap_remove(i), rect);
+        }
+        self.rects.push(rect);
+
+        if self.rects.len() > MAX_DAMAGE_RECTS {
+            let bounds = self.rects.drain(..).reduce(union_rect);
+            self.rects.extend(bounds);
+        }
+    }
+
+    /// Resolve to `Damage` in physical pixels
+    ///
+    /// `viewport` is the logical viewport; rects are clipped to it, scaled by
+    /// `scale_factor`, rounded outward and padded for anti-aliasing.
+    pub(crate) fn finish(self, viewport: Rect, scale_factor: f32) -> Damage {
+        if self.full {
+            return Damage::Full;
+        }
+
+        let rects: Vec<Rect> = self
+            .rects
+            .into_iter()
+            .filter_map(|r| intersect_rect(r, viewport))
+            .collect();
+        if rects.is_empty() {
+            return Damage::None;
+        }
+
+        let damaged_area: f32 = rects.iter().map(|r| r.width() * r.height()).sum();
+        let viewport_area = viewport.width() * viewport.height();
+        if damaged_area > viewport_area * FULL_DAMAGE_AREA_FRACTION {
+            return Damage::Full;
+        }
+
+        let screen = Rect::new(
+            viewport.x() * scale_factor,
+            viewport.y() * scale_factor,
+            viewport.width() * scale_factor,
+            viewport.height() * scale_factor,
+        );
+        let mut physical = DamageAccumulator::default();
+        for r in rects {
+            let x0 = (r.x() * scale_factor - DAMAGE_MARGIN).floor();
+            let y0 = (r.y() * scale_factor - DAMAGE_MARGIN).floor();
+            let x1 = ((r.x() + r.width()) * scale_factor + DAMAGE_MARGIN).ceil();
+            let y1 = ((r.y() + r.height()) * scale_factor + DAMAGE_MARGIN).ceil();
+            if let Some(r) = intersect_rect(Rect::new(x0, y0, x1 - x0, y1 - y0), screen) {
+                // Padding can make neighbours overlap again
+                physical.add(r);
+            }
+        }
+        Damage::Rects(physical.rects)
+    }
+}
+
+/// Smallest rect containing both
+pub(crate) fn union_rect(a: Rect, b: Rect) -> Rect {
+    let x0 = a.x().min(b.x());
+    let y0 = a.y().min(b.y());
+    let x1 = (a.x() + a.width()).max(b.x() + b.width());
+    let y1 = (a.y() + a.height()).max(b.y() + b.height());
+    Rect::new(x0, y0, x1 - x0, y1 - y0)
+}
+
+/// Overlap of two rects, if any
+pub(crate) fn intersect_rect(a: Rect, b: Rect) -> Option<Rect> {
+    let x0 = a.x().max(b.x());
+    let y0 = a.y().max(b.y());
+    let x1 = (a.x() + a.width()).min(b.x() + b.width());
+    let y1 = (a.y() + a.height()).min(b.y() + b.height());
+    (x1 > x0 && y1 > y0).then(|| Rect::new(x0, y0, x1 - x0, y1 - y0))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_overlapping_rects_merge() {
+        let mut acc = DamageAccumulator::default();
+        acc.add(Rect::new(0.0, 0.0, 10.0, 10.0));
+        acc.add(Rect::new(5.0, 5.0, 10.0, 10.0));
+        acc.add(Rect::new(50.0, 50.0, 10.0, 10.0));
+
+        assert_eq!(acc.rects.len(), 2);
+        assert!(acc.rects.contains(&Rect::new(0.0, 0.0, 15.0, 15.0)));
+    }
+
+    #[test]
+    fn test_too_many_rects_collapse_to_bounds() {
+        let mut acc = DamageAccumulator::default();
+        for i in 0..=MAX_DAMAGE_RECTS {
+            acc.add(Rect::new(i as f32 * 20.0, 0.0, 10.0, 10.0));
+        }
+
+        assert_eq!(acc.rects.len(), 1);
+        assert_eq!(acc.rects[0].width(), MAX_DAMAGE_RECTS as f32 * 20.0 + 10.0);
+    }
+
+    #[test]
+    fn test_finish_scales_and_pads() {
+        let mut acc = DamageAccumulator::default();
+        acc.add(Rect::new(10.25, 10.0, 5.0, 5.0));
+
+        let damage = acc.finish(Rect::new(0.0, 0.0, 100.0, 100.0), 2.0);
+        assert_eq!(damage.rects(), &[Rect::new(18.0, 18.0, 15.0, 14.0)]);
+    }
+
+    #[test]
+    fn test_large_damage_becomes_full() {
+        let mut acc = DamageAccumulator::default();
+        acc.add(Rect::new(0.0, 0.0, 90.0, 90.0));
+
+        assert!(acc.finish(Rect::new(0.0, 0.0, 100.0, 100.0), 1.0).is_full());
+    }
+
+    #[test]
+    fn test_offscreen_damage_is_none() {
+        let mut acc = DamageAccumulator::default();
+        acc.add(Rect::new(200.0, 200.0, 10.0, 10.0));
+
+        assert!(acc.finish(Rect::new(0.0, 0.0, 100.0, 100.0), 1.0).is_none());
+    }
+
+    #[test]
+    fn test_damage_merge() {
+        let mut damage = Damage::None;
+        damage.merge(Damage::Rects(vec![Rect::new(0.0, 0.0, 1.0, 1.0)]));
+        assert_eq!(damage.rects().len(), 1);
+
+        // Overlapping rects from different sources are merged
+        damage.merge(Damage::Rects(vec![
+            Rect::new(0.5, 0.5, 1.0, 1.0),
+            Rect::new(10.0, 10.0, 1.0, 1.0),
+        ]));
+        assert_eq!(
+            damage.rects(),
+            &[
+                Rect::new(0.0, 0.0, 1.5, 1.5),
+                Rect::new(10.0, 10.0, 1.0, 1.0)
+            ]
+        );
+
+        damage.merge(Damage::Full);
+        assert!(damage.is_full());
+    }
+}
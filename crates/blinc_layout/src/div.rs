@@ -383,6 +383,8 @@ pub struct Div {
     pub(crate) pointer_events_none: bool,
     /// Layer effects (blur, drop shadow, glow, color matrix) applied to this element
     pub(crate) layer_effects: Vec<LayerEffect>,
+    /// Render this subtree through a retained layer texture
+    pub(crate) cache_layer: bool,
     /// Marks this as a stack layer for z-ordering (increments z_layer for interleaved rendering)
     pub(crate) is_stack_layer: bool,
     pub(crate) event_handlers: crate::event_handler::EventHandlers,
@@ -424,6 +426,7 @@ impl Div {
             cursor: None,
             pointer_events_none: false,
             layer_effects: Vec::new(),
+            cache_layer: false,
             is_stack_layer: false,
             event_handlers: crate::event_handler::EventHandlers::new(),
             element_id: None,
@@ -454,6 +457,7 @@ impl Div {
             cursor: None,
             pointer_events_none: false,
             layer_effects: Vec::new(),
+            cache_layer: false,
             is_stack_layer: false,
             event_handlers: crate::event_handler::EventHandlers::new(),
             element_id: None,
@@ -2403,6 +2407,33 @@ impl Div {
         self
     }
 
+    /// Keep this subtree's rendering in a retained layer texture
+    ///
+    /// The subtree's shapes are rendered into an offscreen texture that is
+    /// kept across frames and composited while its content is unchanged;
+    /// any change (props, layout, hover state) re-renders it once. Layer
+    /// effects on the same element are baked into the retained texture too.
+    /// Use it for large static regions - sidebars, headers, chart
+    /// backgrounds - not for content that changes every frame.
+    ///
+    /// Like layer effects, the layer is composited after the element's
+    /// non-layer siblings and only covers shapes: text and images inside it
+    /// still draw each frame.
+    ///
+    /// # Example
+    ///
+    /// ```ignore
+    /// div()
+    ///     .w(240.0).h_full()
+    ///     .bg(Color::from_hex(0x1E1E2E))
+    ///     .cache_layer()
+    ///     .child(sidebar_items())
+    /// ```
+    pub fn cache_layer(mut self) -> Self {
+        self.cache_layer = true;
+        self
+    }
+
     /// Add a blur effect
     ///
     /// # Example
@@ -3168,6 +3199,11 @@ pub trait ElementBuilder {
         None
     }
 
+    /// Get virtual list state if this is the content of a virtual list
+    fn virtual_list(&self) -> Option<crate::widgets::virtual_list::SharedVirtualList> {
+        None
+    }
+
     /// Get motion animation config for a child at given index
     ///
     /// This is only implemented by Motion containers. The index corresponds
@@ -3342,6 +3378,7 @@ impl ElementBuilder for Div {
             pointer_events_none: self.pointer_events_none,
             cursor: self.cursor,
             layer_effects: self.layer_effects.clone(),
+            cache_layer: self.cache_layer,
             motion_is_exiting: false,
         }
     }
@@ -3402,6 +3439,12 @@ mod tests {
         assert_eq!(parent.children.len(), 2);
     }
 
+    #[test]
+    fn test_cache_layer_marks_render_props() {
+        assert!(!div().render_props().cache_layer);
+        assert!(div().cache_layer().render_props().cache_layer);
+    }
+
     #[test]
     fn test_build_tree() {
         let ui = div().flex_col().child(div().h(20.0)).child(div().h(30.0));
@@ -994,6 +994,9 @@ pub struct RenderProps {
     /// Layer effects applied to this element (blur, drop shadow, glow, color matrix)
     /// Effects are applied during layer composition when the element is rendered
     pub layer_effects: Vec<LayerEffect>,
+    /// Whether this subtree is drawn through a retained layer
+    /// (see `Div::cache_layer`)
+    pub cache_layer: bool,
     /// DEPRECATED: Whether the motion should start exiting
     ///
     /// This field is deprecated. Motion exit is now triggered explicitly via
@@ -1034,6 +1037,7 @@ impl Default for RenderProps {
             cursor: None,
             pointer_events_none: false,
             layer_effects: Vec::new(),
+            cache_layer: false,
             motion_is_exiting: false,
         }
     }
@@ -37,7 +37,7 @@ use std::collections::HashSet;
 
 use blinc_core::events::event_types;
 
-use crate::element::ElementBounds;
+use crate::hit_index::IndexedHit;
 use crate::renderer::RenderTree;
 use crate::tree::LayoutNodeId;
 
@@ -1059,130 +1059,61 @@ impl EventRouter {
     /// Hit test to find the topmost element at a point
     ///
     /// Returns the hit result for the frontmost (last in child order) element
-    /// that contains the point.
+    /// that contains the point. Elements with `pointer_events_none` let the
+    /// hit fall through to whatever is behind them.
     pub fn hit_test(&self, tree: &RenderTree, x: f32, y: f32) -> Option<HitTestResult> {
-        let root = tree.root()?;
-        self.hit_test_node(
-            tree,
-            root,
-            x,
-            y,
-            (0.0, 0.0),
-            Vec::new(),
-            std::collections::HashMap::new(),
-        )
+        let hits = tree.hit_test_point(x, y);
+        // Pre-order puts children after their parents and later siblings
+        // after earlier ones, so the last hit is the topmost
+        let target = hits
+            .iter()
+            .rposition(|hit| !Self::pointer_events_none(tree, hit.node))?;
+        tracing::trace!("hit_test: target node={:?}", hits[target].node);
+        Some(Self::hit_result(&hits, target, x, y))
     }
 
     /// Hit test to find all elements at a point
     ///
     /// Returns all elements that contain the point, from root to leaf.
     pub fn hit_test_all(&self, tree: &RenderTree, x: f32, y: f32) -> Vec<HitTestResult> {
-        let mut results = Vec::new();
-        if let Some(root) = tree.root() {
-            self.hit_test_node_all(
-                tree,
-                root,
-                x,
-                y,
-                (0.0, 0.0),
-                Vec::new(),
-                std::collections::HashMap::new(),
-                &mut results,
-            );
-        }
-        results
+        let hits = tree.hit_test_point(x, y);
+        (0..hits.len())
+            .filter(|&i| !Self::pointer_events_none(tree, hits[i].node))
+            .map(|i| Self::hit_result(&hits, i, x, y))
+            .collect()
     }
 
-    /// Recursive hit test for a single node
-    fn hit_test_node(
-        &self,
-        tree: &RenderTree,
-        node: LayoutNodeId,
-        x: f32,
-        y: f32,
-        parent_offset: (f32, f32),
-        mut ancestors: Vec<LayoutNodeId>,
-        mut ancestor_bounds: std::collections::HashMap<u32, (f32, f32, f32, f32)>,
-    ) -> Option<HitTestResult> {
-        let bounds = tree.layout().get_bounds(node, parent_offset)?;
-
-        // Check if point is within bounds
-        if !self.point_in_bounds(x, y, &bounds) {
-            return None;
-        }
-
-        // Debug log for nodes in hit path
-        tracing::debug!(
-            "hit_test_node: HIT node={:?}, bounds=({:.1}, {:.1}, {:.1}x{:.1}), point=({:.1}, {:.1})",
-            node,
-            bounds.x,
-            bounds.y,
-            bounds.width,
-            bounds.height,
-            x,
-            y
-        );
-
-        ancestors.push(node);
-        // Store this node's bounds for event bubbling
-        ancestor_bounds.insert(
-            node.to_raw() as u32,
-            (bounds.x, bounds.y, bounds.width, bounds.height),
-        );
-
-        // Get scroll offset for this node (if it's a scroll container)
-        // Children are rendered at bounds + scroll_offset, so we need to
-        // include the scroll offset when hit testing children
-        let scroll_offset = tree.get_scroll_offset(node);
-        let child_offset = (bounds.x + scroll_offset.0, bounds.y + scroll_offset.1);
-
-        // Check children in reverse order (last child is on top)
-        let children = tree.layout().children(node);
-        tracing::trace!(
-            "hit_test_node: node={:?}, bounds=({:.1}, {:.1}, {:.1}x{:.1}), children={:?}",
-            node,
-            bounds.x,
-            bounds.y,
-            bounds.width,
-            bounds.height,
-            children
-        );
-        for child in children.into_iter().rev() {
-            if let Some(result) = self.hit_test_node(
-                tree,
-                child,
-                x,
-                y,
-                child_offset,
-                ancestors.clone(),
-                ancestor_bounds.clone(),
-            ) {
-                return Some(result);
-            }
-        }
-
-        // No child hit - check if this node has pointer_events_none
-        // If so, return None to let the hit fall through to siblings
-        let pointer_events_none = tree
-            .get_render_node(node)
+    /// Whether a node lets pointer events pass through to what's behind it
+    fn pointer_events_none(tree: &RenderTree, node: LayoutNodeId) -> bool {
+        tree.get_render_node(node)
             .map(|n| n.props.pointer_events_none)
-            .unwrap_or(false);
+            .unwrap_or(false)
+    }
 
-        if pointer_events_none {
-            tracing::trace!(
-                "hit_test_node: node={:?} has pointer_events_none, passing through",
-                node
+    /// Build the result for `hits[index]`, with its ancestor chain
+    fn hit_result(hits: &[IndexedHit], index: usize, x: f32, y: f32) -> HitTestResult {
+        let mut ancestors = Vec::new();
+        let mut ancestor_bounds = std::collections::HashMap::new();
+        let mut current = Some(index);
+        while let Some(i) = current {
+            let hit = &hits[i];
+            ancestors.push(hit.node);
+            ancestor_bounds.insert(
+                hit.node.to_raw() as u32,
+                (
+                    hit.bounds.x,
+                    hit.bounds.y,
+                    hit.bounds.width,
+                    hit.bounds.height,
+                ),
             );
-            return None;
+            current = hit.parent;
         }
+        ancestors.reverse();
 
-        // This node is the target
-        tracing::trace!(
-            "hit_test_node: FINAL target node={:?} (no children hit at point)",
-            node
-        );
-        Some(HitTestResult {
-            node,
+        let bounds = hits[index].bounds;
+        HitTestResult {
+            node: hits[index].node,
             local_x: x - bounds.x,
             local_y: y - bounds.y,
             ancestors,
@@ -1191,92 +1122,9 @@ impl EventRouter {
             bounds_width: bounds.width,
             bounds_height: bounds.height,
             ancestor_bounds,
-        })
-    }
-
-    /// Recursive hit test collecting all hits
-    fn hit_test_node_all(
-        &self,
-        tree: &RenderTree,
-        node: LayoutNodeId,
-        x: f32,
-        y: f32,
-        parent_offset: (f32, f32),
-        mut ancestors: Vec<LayoutNodeId>,
-        mut ancestor_bounds: std::collections::HashMap<u32, (f32, f32, f32, f32)>,
-        results: &mut Vec<HitTestResult>,
-    ) {
-        let Some(bounds) = tree.layout().get_bounds(node, parent_offset) else {
-            return;
-        };
-
-        // Check if point is within bounds
-        let in_bounds = self.point_in_bounds(x, y, &bounds);
-
-        if !in_bounds {
-            return;
-        }
-
-        ancestors.push(node);
-        // Store this node's bounds
-        ancestor_bounds.insert(
-            node.to_raw() as u32,
-            (bounds.x, bounds.y, bounds.width, bounds.height),
-        );
-
-        // Check if this node has pointer_events_none - if so, skip adding it to results
-        // but still recurse into children (they may capture events)
-        let pointer_events_none = tree
-            .get_render_node(node)
-            .map(|n| n.props.pointer_events_none)
-            .unwrap_or(false);
-
-        if !pointer_events_none {
-            // Add this node to results
-            results.push(HitTestResult {
-                node,
-                local_x: x - bounds.x,
-                local_y: y - bounds.y,
-                ancestors: ancestors.clone(),
-                bounds_x: bounds.x,
-                bounds_y: bounds.y,
-                bounds_width: bounds.width,
-                bounds_height: bounds.height,
-                ancestor_bounds: ancestor_bounds.clone(),
-            });
-        }
-
-        // Get scroll offset for this node (if it's a scroll container)
-        // Children are rendered at bounds + scroll_offset, so we need to
-        // include the scroll offset when hit testing children
-        let scroll_offset = tree.get_scroll_offset(node);
-        let child_offset = (bounds.x + scroll_offset.0, bounds.y + scroll_offset.1);
-
-        // Check children
-        let children = tree.layout().children(node);
-
-        for child in children {
-            self.hit_test_node_all(
-                tree,
-                child,
-                x,
-                y,
-                child_offset,
-                ancestors.clone(),
-                ancestor_bounds.clone(),
-                results,
-            );
         }
     }
 
-    /// Check if a point is within element bounds
-    fn point_in_bounds(&self, x: f32, y: f32, bounds: &ElementBounds) -> bool {
-        x >= bounds.x
-            && x < bounds.x + bounds.width
-            && y >= bounds.y
-            && y < bounds.y + bounds.height
-    }
-
     /// Hit test with overlay occlusion awareness
     ///
     /// This method performs a standard hit test, but also checks if the hit point
@@ -1430,6 +1278,86 @@ mod tests {
         assert!(result.is_none());
     }
 
+    #[test]
+    fn test_hit_test_topmost_and_pass_through() {
+        let overlapping = |pass_through: bool| {
+            let top = div().absolute().top(50.0).left(50.0).w(200.0).h(200.0);
+            let top = if pass_through {
+                top.pointer_events_none()
+            } else {
+                top
+            };
+            div()
+                .w(400.0)
+                .h(300.0)
+                .child(div().w(200.0).h(200.0))
+                .child(top)
+        };
+        let router = EventRouter::new();
+
+        for pass_through in [false, true] {
+            let mut tree = RenderTree::from_element(&overlapping(pass_through));
+            tree.compute_layout(400.0, 300.0);
+            let root = tree.root().unwrap();
+            let children = tree.layout().children(root);
+
+            let hit = router.hit_test(&tree, 100.0, 100.0).unwrap();
+            let expected = if pass_through {
+                children[0]
+            } else {
+                children[1]
+            };
+            assert_eq!(hit.node, expected);
+            assert_eq!(hit.ancestors, vec![root, expected]);
+
+            let all: Vec<_> = router
+                .hit_test_all(&tree, 100.0, 100.0)
+                .into_iter()
+                .map(|h| h.node)
+                .collect();
+            let expected_all = if pass_through {
+                vec![root, children[0]]
+            } else {
+                vec![root, children[0], children[1]]
+            };
+            assert_eq!(all, expected_all);
+        }
+    }
+
+    #[test]
+    fn test_hit_test_follows_scroll_offset() {
+        let ui = div()
+            .w(400.0)
+            .h(300.0)
+            .child(div().w(100.0).h(100.0))
+            .child(div().w(100.0).h(100.0));
+
+        let mut tree = RenderTree::from_element(&ui);
+        tree.compute_layout(400.0, 300.0);
+        let root = tree.root().unwrap();
+        let children = tree.layout().children(root);
+        let router = EventRouter::new();
+
+        assert_eq!(
+            router.hit_test(&tree, 50.0, 50.0).unwrap().node,
+            children[0]
+        );
+
+        // Content scrolled up by one row: the second child is now on top
+        tree.set_scroll_offset(root, 0.0, -100.0);
+        let hit = router.hit_test(&tree, 50.0, 50.0).unwrap();
+        assert_eq!(hit.node, children[1]);
+        assert_eq!((hit.bounds_y, hit.local_y), (0.0, 50.0));
+
+        // Scrolling again reuses the index with the live offset
+        tree.set_scroll_offset(root, 0.0, 0.0);
+        assert_eq!(
+            router.hit_test(&tree, 50.0, 150.0).unwrap().node,
+            children[1]
+        );
+        assert_eq!(router.hit_test(&tree, 50.0, 250.0).unwrap().node, root);
+    }
+
     #[test]
     fn test_hover_enter_leave() {
         let ui = div().w(400.0).h(300.0).child(div().w(100.0).h(100.0));
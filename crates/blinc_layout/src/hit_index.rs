@@ -0,0 +1,324 @@
+//! Spatial index for hit testing
+//!
+//! A point only hits a node if it is inside the node and every ancestor, so
+//! `HitIndex` flattens the laid-out tree into pre-order entries whose bounds
+//! are already clipped by their ancestors, and buckets them in a uniform
+//! grid. A query only looks at the entries of the cell under the point
+//! instead of walking the whole tree.
+//!
+//! Scroll containers start a new region with its own grid in content
+//! coordinates; the region's screen origin is recomputed from the live
+//! scroll offset on every query, so scrolling never invalidates the index.
+//! `RenderTree` rebuilds it lazily when the layout generation or the set of
+//! scroll containers changes. `pointer_events_none` is read from the live
+//! render props by `EventRouter`, so prop updates never need a rebuild.
+
+use crate::element::ElementBounds;
+use crate::renderer::RenderTree;
+use crate::tree::LayoutNodeId;
+
+/// Smallest grid cell edge (logical pixels)
+const MIN_CELL_SIZE: f32 = 64.0;
+
+/// Upper bound on cells per axis, so huge scroll content stays cheap to index
+const MAX_CELLS_PER_AXIS: usize = 64;
+
+/// Parent index of the root entry
+const NO_PARENT: u32 = u32::MAX;
+
+/// A node under the queried point
+#[derive(Clone, Debug)]
+pub(crate) struct IndexedHit {
+    pub node: LayoutNodeId,
+    /// Position of the parent in the same hit list (None for the root)
+    pub parent: Option<usize>,
+    /// Absolute bounds, including scroll offsets
+    pub bounds: ElementBounds,
+}
+
+/// Half-open rect `[x0, x1) x [y0, y1)`, matching the router's bounds test
+#[derive(Clone, Copy, Debug)]
+struct ClipRect {
+    x0: f32,
+    y0: f32,
+    x1: f32,
+    y1: f32,
+}
+
+impl ClipRect {
+    fn of(bounds: &ElementBounds) -> Self {
+        Self {
+            x0: bounds.x,
+            y0: bounds.y,
+            x1: bounds.x + bounds.width,
+            y1: bounds.y + bounds.height,
+        }
+    }
+
+    fn intersect(self, other: Self) -> Self {
+        Self {
+            x0: self.x0.max(other.x0),
+            y0: self.y0.max(other.y0),
+            x1: self.x1.min(other.x1),
+            y1: self.y1.min(other.y1),
+        }
+    }
+
+    fn union(self, other: Self) -> Self {
+        Self {
+            x0: self.x0.min(other.x0),
+            y0: self.y0.min(other.y0),
+            x1: self.x1.max(other.x1),
+            y1: self.y1.max(other.y1),
+        }
+    }
+
+    /// Whether no point can be inside (including NaN bounds)
+    fn is_empty(&self) -> bool {
+        !(self.x1 > self.x0 && self.y1 > self.y0)
+    }
+
+    fn contains(&self, x: f32, y: f32) -> bool {
+        x >= self.x0 && x < self.x1 && y >= self.y0 && y < self.y1
+    }
+}
+
+/// One laid-out node, in its region's coordinates
+#[derive(Debug)]
+struct HitEntry {
+    node: LayoutNodeId,
+    parent: u32,
+    region: u32,
+    /// Bounds relative to the region origin
+    bounds: ElementBounds,
+    /// `bounds` clipped by every ancestor in the same region
+    clip: ClipRect,
+    /// Region holding the children, if this node scrolls them
+    child_region: Option<u32>,
+}
+
+/// The root, or the content of one scroll container
+#[derive(Debug, Default)]
+struct HitRegion {
+    grid: HitGrid,
+}
+
+/// Uniform grid of entry indices over a region's extent
+///
+/// Entries are inserted in pre-order, so every cell list is sorted.
+#[derive(Debug, Default)]
+struct HitGrid {
+    x0: f32,
+    y0: f32,
+    x1: f32,
+    y1: f32,
+    cell_width: f32,
+    cell_height: f32,
+    cols: usize,
+    rows: usize,
+    cells: Vec<Vec<u32>>,
+}
+
+impl HitGrid {
+    fn new(extent: ClipRect) -> Self {
+        let width = extent.x1 - extent.x0;
+        let height = extent.y1 - extent.y0;
+        let cols = ((width / MIN_CELL_SIZE).ceil() as usize).clamp(1, MAX_CELLS_PER_AXIS);
+        let rows = ((height / MIN_CELL_SIZE).ceil() as usize).clamp(1, MAX_CELLS_PER_AXIS);
+        Self {
+            x0: extent.x0,
+            y0: extent.y0,
+            x1: extent.x1,
+            y1: extent.y1,
+            cell_width: width / cols as f32,
+            cell_height: height / rows as f32,
+            cols,
+            rows,
+            cells: vec![Vec::new(); cols * rows],
+        }
+    }
+
+    fn col(&self, x: f32) -> usize {
+        (((x - self.x0) / self.cell_width).max(0.0) as usize).min(self.cols - 1)
+    }
+
+    fn row(&self, y: f32) -> usize {
+        (((y - self.y0) / self.cell_height).max(0.0) as usize).min(self.rows - 1)
+    }
+
+    fn insert(&mut self, entry: u32, clip: ClipRect) {
+        for row in self.row(clip.y0)..=self.row(clip.y1) {
+            for col in self.col(clip.x0)..=self.col(clip.x1) {
+                self.cells[row * self.cols + col].push(entry);
+            }
+        }
+    }
+
+    /// Entries whose clip rect may contain the point
+    fn cell(&self, x: f32, y: f32) -> &[u32] {
+        let outside = x < self.x0 || y < self.y0 || x >= self.x1 || y >= self.y1;
+        if self.cells.is_empty() || outside {
+            return &[];
+        }
+        &self.cells[self.row(y) * self.cols + self.col(x)]
+    }
+}
+
+/// Flattened, grid-bucketed snapshot of a `RenderTree`'s layout
+#[derive(Debug)]
+pub(crate) struct HitIndex {
+    root: Option<LayoutNodeId>,
+    generation: u64,
+    scroll_containers: usize,
+    entries: Vec<HitEntry>,
+    regions: Vec<HitRegion>,
+}
+
+impl HitIndex {
+    /// Index the tree's current layout
+    pub(crate) fn build(tree: &RenderTree) -> Self {
+        let mut index = Self {
+            root: tree.root(),
+            generation: tree.layout().generation(),
+            scroll_containers: tree.scroll_container_count(),
+            entries: Vec::new(),
+            regions: vec![HitRegion::default()],
+        };
+        if let Some(root) = index.root {
+            index.add_node(tree, root, NO_PARENT, 0, (0.0, 0.0), None);
+        }
+
+        // Size each region's grid to what it actually contains
+        let mut extents: Vec<Option<ClipRect>> = vec![None; index.regions.len()];
+        for entry in &index.entries {
+            let extent = &mut extents[entry.region as usize];
+            *extent = Some(extent.map_or(entry.clip, |e| e.union(entry.clip)));
+        }
+        for (region, extent) in index.regions.iter_mut().zip(extents) {
+            if let Some(extent) = extent {
+                region.grid = HitGrid::new(extent);
+            }
+        }
+        for (i, entry) in index.entries.iter().enumerate() {
+            index.regions[entry.region as usize]
+                .grid
+                .insert(i as u32, entry.clip);
+        }
+
+        tracing::trace!(
+            "HitIndex: {} entries in {} regions",
+            index.entries.len(),
+            index.regions.len()
+        );
+        index
+    }
+
+    /// Whether the index still matches the tree's layout
+    pub(crate) fn is_current(&self, tree: &RenderTree) -> bool {
+        self.root == tree.root()
+            && self.generation == tree.layout().generation()
+            && self.scroll_containers == tree.scroll_container_count()
+    }
+
+    /// Nodes containing the point, in tree pre-order (parents before
+    /// children, earlier siblings before later ones)
+    pub(crate) fn query(&self, tree: &RenderTree, x: f32, y: f32) -> Vec<IndexedHit> {
+        let mut found: Vec<(u32, ElementBounds)> = Vec::new();
+        if !self.entries.is_empty() {
+            self.query_region(tree, 0, (0.0, 0.0), x, y, &mut found);
+        }
+        found.sort_unstable_by_key(|&(entry, _)| entry);
+
+        found
+            .iter()
+            .map(|&(entry, bounds)| {
+                let entry = &self.entries[entry as usize];
+                // Every ancestor of a hit is a hit, so the parent is in the list
+                let parent = (entry.parent != NO_PARENT)
+                    .then(|| found.binary_search_by_key(&entry.parent, |&(e, _)| e).ok())
+                    .flatten();
+                IndexedHit {
+                    node: entry.node,
+                    parent,
+                    bounds,
+                }
+            })
+            .collect()
+    }
+
+    fn query_region(
+        &self,
+        tree: &RenderTree,
+        region: u32,
+        origin: (f32, f32),
+        x: f32,
+        y: f32,
+        found: &mut Vec<(u32, ElementBounds)>,
+    ) {
+        let (local_x, local_y) = (x - origin.0, y - origin.1);
+        for &i in self.regions[region as usize].grid.cell(local_x, local_y) {
+            let entry = &self.entries[i as usize];
+            if !entry.clip.contains(local_x, local_y) {
+                continue;
+            }
+
+            let bounds = ElementBounds {
+                x: origin.0 + entry.bounds.x,
+                y: origin.1 + entry.bounds.y,
+                ..entry.bounds
+            };
+            found.push((i, bounds));
+
+            if let Some(child_region) = entry.child_region {
+                // Children are rendered at bounds + scroll offset
+                let scroll = tree.get_scroll_offset(entry.node);
+                let child_origin = (bounds.x + scroll.0, bounds.y + scroll.1);
+                self.query_region(tree, child_region, child_origin, x, y, found);
+            }
+        }
+    }
+
+    fn add_node(
+        &mut self,
+        tree: &RenderTree,
+        node: LayoutNodeId,
+        parent: u32,
+        region: u32,
+        offset: (f32, f32),
+        parent_clip: Option<ClipRect>,
+    ) {
+        let Some(bounds) = tree.layout().get_bounds(node, offset) else {
+            return;
+        };
+        let own_clip = ClipRect::of(&bounds);
+        let clip = parent_clip.map_or(own_clip, |c| c.intersect(own_clip));
+        // Nothing in this subtree can be hit
+        if clip.is_empty() {
+            return;
+        }
+
+        let index = self.entries.len() as u32;
+        let child_region = tree.is_scroll_container(node).then(|| {
+            self.regions.push(HitRegion::default());
+            (self.regions.len() - 1) as u32
+        });
+        self.entries.push(HitEntry {
+            node,
+            parent,
+            region,
+            bounds,
+            clip,
+            child_region,
+        });
+
+        let (region, offset, clip) = match child_region {
+            // Scroll content gets its own coordinate space; the container's
+            // clip is checked in the parent region
+            Some(child_region) => (child_region, (0.0, 0.0), None),
+            None => (region, (bounds.x, bounds.y), Some(clip)),
+        };
+        for child in tree.layout().children(node) {
+            self.add_node(tree, child, index, region, offset, clip);
+        }
+    }
+}
@@ -795,6 +795,7 @@ impl ElementBuilder for Image {
             pointer_events_none: false,
             cursor: None,
             layer_effects: Vec::new(),
+            cache_layer: false,
             motion_is_exiting: false,
         }
     }
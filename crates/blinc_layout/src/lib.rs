@@ -30,6 +30,7 @@
 
 pub mod animated;
 pub mod canvas;
+pub mod damage;
 pub mod diff;
 pub mod div;
 pub mod element;
@@ -39,6 +40,7 @@ pub mod notch;
 pub mod element_style;
 pub mod event_handler;
 pub mod event_router;
+mod hit_index;
 pub mod image;
 pub mod interactive;
 pub mod layout_animation;
@@ -123,6 +125,9 @@ pub use rich_text::{rich_text, rich_text_styled, RichText};
 pub use svg::{svg, Svg};
 pub use text::{text, Text};
 
+// Damage tracking
+pub use damage::Damage;
+
 // Renderer
 pub use renderer::{
     GlassPanel, ImageData, LayoutRenderer, OnReadyCallback, OnReadyEntry, RenderTree,
@@ -142,11 +147,12 @@ pub use render_state::{
 
 // Stateful elements
 pub use stateful::{
-    check_stateful_animations, check_stateful_deps, has_animating_statefuls,
-    has_pending_subtree_rebuilds, peek_needs_redraw, queue_prop_update, queue_subtree_rebuild,
-    request_redraw, take_needs_redraw, take_pending_prop_updates, take_pending_subtree_rebuilds,
-    use_shared_state, use_shared_state_with, PendingSubtreeRebuild, SharedState, StateTransitions,
-    StatefulInner,
+    check_stateful_animations, check_stateful_deps, current_update_queue, has_animating_statefuls,
+    has_pending_subtree_rebuilds, peek_needs_redraw, pending_subtree_rebuild_count,
+    queue_prop_update, queue_subtree_rebuild, request_redraw, take_needs_redraw,
+    take_pending_prop_updates, take_pending_subtree_rebuilds, use_shared_state,
+    use_shared_state_with, PendingSubtreeRebuild, QueueWaker, SharedState, SharedUpdateQueue,
+    StateTransitions, StatefulInner, UpdateQueue, UpdateQueueScope,
 };
 
 // Animation integration
@@ -169,8 +175,8 @@ pub use motion::{
 
 // Text measurement
 pub use text_measure::{
-    measure_text, measure_text_with_options, set_text_measurer, TextLayoutOptions, TextMeasurer,
-    TextMetrics,
+    invalidate_text_measurements, measure_text, measure_text_with_options, prepare_text_batch,
+    set_text_measurer, TextLayoutOptions, TextMeasurer, TextMetrics,
 };
 
 // Text selection (clipboard support)
@@ -313,6 +319,9 @@ pub mod prelude {
         ScrollRenderInfo, SharedScrollPhysics,
     };
 
+    // Virtualized list (builds only the items in view)
+    pub use crate::widgets::{virtual_list, VirtualList};
+
     // Code block widget with syntax highlighting
     pub use crate::widgets::{code, pre, Code, CodeConfig};
 
@@ -410,7 +419,8 @@ pub mod prelude {
     pub use crate::css_parser::{
         AnimationDirection, AnimationFillMode, AnimationTiming, CssAnimation, CssKeyframe,
         CssKeyframes, CssParseResult, CssSelector, ElementState as CssElementState,
-        ParseError as CssParseError, Severity as CssSeverity, Stylesheet,
+        ElementStates as CssElementStates, ParseError as CssParseError, Severity as CssSeverity,
+        Stylesheet,
     };
 
     // Stable unique key generation for components
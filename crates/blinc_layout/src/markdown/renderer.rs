@@ -55,6 +55,15 @@ impl MarkdownRenderer {
         let parser = Parser::new_ext(markdown_text, options);
         let events: Vec<Event<'_>> = parser.collect();
 
+        // Shape body text runs in parallel before building measures them
+        let runs = body_text_runs(&events);
+        let runs: Vec<&str> = runs.iter().map(String::as_str).collect();
+        crate::text_measure::prepare_text_batch(
+            &runs,
+            self.config.body_size,
+            &crate::text_measure::TextLayoutOptions::new(),
+        );
+
         // Build the layout
         let mut renderer = RenderState::new(&self.config);
         renderer.render_events(&events);
@@ -69,6 +78,56 @@ impl Default for MarkdownRenderer {
     }
 }
 
+/// Plain body-text runs as `RenderState` will turn them into text elements
+///
+/// Mirrors how inline text accumulates into styled segments (soft breaks
+/// become spaces, any tag boundary ends a run) but skips headings, code,
+/// emphasis and other content rendered with a different font or size. Only
+/// used to warm the shape cache, so an imperfect match just means a miss.
+fn body_text_runs(events: &[Event<'_>]) -> Vec<String> {
+    let mut runs = Vec::new();
+    let mut run = String::new();
+    let mut skip_depth = 0usize;
+
+    for event in events {
+        match event {
+            Event::Text(text) if skip_depth == 0 => run.push_str(&decode_html_entities(text)),
+            Event::SoftBreak if skip_depth == 0 => run.push(' '),
+            Event::Text(_) | Event::SoftBreak => {}
+            _ => {
+                if !run.is_empty() {
+                    runs.push(std::mem::take(&mut run));
+                }
+                match event {
+                    Event::Start(
+                        Tag::Heading { .. }
+                        | Tag::CodeBlock(_)
+                        | Tag::Emphasis
+                        | Tag::Strong
+                        | Tag::Image { .. }
+                        | Tag::MetadataBlock(_)
+                        | Tag::HtmlBlock,
+                    ) => skip_depth += 1,
+                    Event::End(
+                        TagEnd::Heading(_)
+                        | TagEnd::CodeBlock
+                        | TagEnd::Emphasis
+                        | TagEnd::Strong
+                        | TagEnd::Image
+                        | TagEnd::MetadataBlock(_)
+                        | TagEnd::HtmlBlock,
+                    ) => skip_depth = skip_depth.saturating_sub(1),
+                    _ => {}
+                }
+            }
+        }
+    }
+    if !run.is_empty() {
+        runs.push(run);
+    }
+    runs
+}
+
 /// Render markdown to a Div
 ///
 /// # Example
@@ -11,20 +11,29 @@ use blinc_animation::AnimationScheduler;
 use indexmap::IndexMap;
 
 use blinc_core::{
-    BlendMode, Brush, ClipShape, Color, CornerRadius, DrawContext, GlassStyle, LayerConfig, Rect,
-    Shadow, Stroke, Transform,
+    Affine2D, BlendMode, Brush, ClipShape, Color, CornerRadius, DrawContext, GlassStyle,
+    LayerConfig, Rect, Shadow, Stroke, Transform,
 };
 use taffy::prelude::*;
 
 use crate::canvas::CanvasData;
-use crate::css_parser::{ElementState, Stylesheet};
+use crate::css_parser::{ElementStates, Stylesheet};
+use crate::damage::{
+    intersect_rect, union_rect, Damage, DamageAccumulator, DamageTracker, MotionSample,
+    ScrollSample,
+};
 use crate::diff::{render_props_eq, ChangeCategory, DivHash};
 use crate::div::{ElementBuilder, ElementTypeId};
 use crate::element::{ElementBounds, GlassMaterial, Material, RenderLayer, RenderProps};
+use crate::hit_index::{HitIndex, IndexedHit};
 use crate::layout_animation::{LayoutAnimationConfig, LayoutAnimationState};
 use crate::selector::{ElementRegistry, ScrollRef};
-use crate::tree::{LayoutNodeId, LayoutTree};
+use crate::tree::{IncrementalLayout, LayoutNodeId, LayoutTree};
 use crate::visual_animation::{AnimatedRenderBounds, VisualAnimation, VisualAnimationConfig};
+use crate::widgets::virtual_list::SharedVirtualList;
+
+/// Layout passes spent materializing virtual list lines after one layout
+const MAX_VIRTUAL_LIST_PASSES: usize = 3;
 
 /// A computed glass panel ready for GPU rendering
 ///
@@ -351,6 +360,8 @@ pub struct RenderTree {
     scroll_offsets: HashMap<LayoutNodeId, (f32, f32)>,
     /// Scroll physics for scroll containers (keyed by node_id)
     scroll_physics: HashMap<LayoutNodeId, crate::scroll::SharedScrollPhysics>,
+    /// Virtual lists, keyed by the node their lines are materialized into
+    virtual_lists: HashMap<LayoutNodeId, SharedVirtualList>,
     /// Motion bindings for continuous animations (keyed by node_id)
     motion_bindings: HashMap<LayoutNodeId, crate::motion::MotionBindings>,
     /// Last tick time for scroll physics (in milliseconds)
@@ -425,6 +436,14 @@ pub struct RenderTree {
     /// Pre-computed animated render bounds for this frame
     /// Calculated after layout, used during rendering
     animated_render_bounds: HashMap<LayoutNodeId, AnimatedRenderBounds>,
+    /// Changes since the last frame, for partial redraws
+    damage: DamageTracker,
+    /// Viewport of the last full `compute_layout`
+    layout_viewport: Option<(f32, f32)>,
+    /// Rebuilds applied by the last `process_pending_subtree_rebuilds`
+    last_subtree_rebuilds: usize,
+    /// Spatial index for hit testing, rebuilt lazily after layout changes
+    hit_index: Mutex<Option<HitIndex>>,
 }
 
 /// Result of an incremental update attempt
@@ -458,6 +477,7 @@ impl RenderTree {
             node_states: HashMap::new(),
             scroll_offsets: HashMap::new(),
             scroll_physics: HashMap::new(),
+            virtual_lists: HashMap::new(),
             motion_bindings: HashMap::new(),
             last_scroll_tick_ms: None,
             scale_factor: 1.0,
@@ -483,6 +503,10 @@ impl RenderTree {
             visual_animations: HashMap::new(),
             previous_visual_bounds: HashMap::new(),
             animated_render_bounds: HashMap::new(),
+            damage: DamageTracker::default(),
+            layout_viewport: None,
+            last_subtree_rebuilds: 0,
+            hit_index: Mutex::new(None),
         }
     }
 
@@ -563,6 +587,7 @@ impl RenderTree {
         // Hash differs - need to rebuild
         // For now, do a full rebuild. Future optimization: use diff for incremental updates
         self.tree_hash = Some(new_hash);
+        self.damage.mark_full();
 
         // Clear existing data that will be repopulated during rebuild
         self.render_nodes.clear();
@@ -571,6 +596,7 @@ impl RenderTree {
         // Clear scroll_refs HashMap (node_id keyed) - it will be repopulated during rebuild
         // but active_scroll_refs persists for process_pending_scroll_refs
         self.scroll_refs.clear();
+        self.virtual_lists.clear();
 
         // Preserve node_states, scroll_offsets, scroll_physics, motion_bindings, active_scroll_refs
         // as these should survive rebuilds
@@ -607,6 +633,7 @@ impl RenderTree {
         // Walk the tree comparing per-node hashes to detect change categories
         let Some(root_id) = self.root else {
             // No existing tree - build it (this is initial build, not an update)
+            self.damage.mark_full();
             self.tree_hash = Some(new_tree_hash);
             self.root = Some(self.build_element(element));
             return UpdateResult::ChildrenChanged;
@@ -626,7 +653,12 @@ impl RenderTree {
         // Update tree hash
         self.tree_hash = Some(new_tree_hash);
 
-        // Determine update strategy based on change category
+        // Determine update strategy based on change category. Layout and
+        // structural changes repaint everything; visual changes damage just
+        // the nodes `update_render_props_in_place` finds changed.
+        if changes.children || changes.layout {
+            self.damage.mark_full();
+        }
         if changes.children {
             // Children changed - rebuild affected subtrees in place
             // Walk tree and rebuild nodes with changed children
@@ -896,6 +928,14 @@ impl RenderTree {
         element: &E,
         node_id: LayoutNodeId,
     ) {
+        // Damage changed nodes before their props (and transform) change, so
+        // the area they covered is repainted too
+        let own_hash = DivHash::compute_element(element);
+        let changed = self.node_hashes.get(&node_id).map(|&(own, _)| own) != Some(own_hash);
+        if changed {
+            self.mark_damage(node_id);
+        }
+
         // Update this node's props
         if let Some(render_node) = self.render_nodes.get_mut(&node_id) {
             let mut new_props = element.render_props();
@@ -919,6 +959,7 @@ impl RenderTree {
                     element_type,
                 },
             );
+            self.mark_damage(node_id);
         }
 
         // Update taffy node's layout style if element provides one
@@ -928,7 +969,6 @@ impl RenderTree {
         }
 
         // Update stored hash
-        let own_hash = DivHash::compute_element(element);
         let tree_hash = DivHash::compute_element_tree(element);
         self.node_hashes.insert(node_id, (own_hash, tree_hash));
 
@@ -947,6 +987,11 @@ impl RenderTree {
             self.scroll_physics.insert(node_id, physics);
         }
 
+        // Register virtual list content so its lines can be materialized
+        if let Some(list) = element.virtual_list() {
+            self.register_virtual_list(node_id, list);
+        }
+
         // Update motion bindings if this element has continuous animations
         if let Some(bindings) = element.motion_bindings() {
             self.motion_bindings.insert(node_id, bindings);
@@ -977,6 +1022,12 @@ impl RenderTree {
         element: &dyn ElementBuilder,
         node_id: LayoutNodeId,
     ) {
+        let own_hash = DivHash::compute_element(element);
+        let changed = self.node_hashes.get(&node_id).map(|&(own, _)| own) != Some(own_hash);
+        if changed {
+            self.mark_damage(node_id);
+        }
+
         if let Some(render_node) = self.render_nodes.get_mut(&node_id) {
             let mut new_props = element.render_props();
             new_props.node_id = Some(node_id);
@@ -1000,6 +1051,7 @@ impl RenderTree {
                     element_type,
                 },
             );
+            self.mark_damage(node_id);
         }
 
         // Update taffy node's layout style if element provides one
@@ -1008,7 +1060,6 @@ impl RenderTree {
             self.layout_tree.set_style(node_id, style.clone());
         }
 
-        let own_hash = DivHash::compute_element(element);
         let tree_hash = DivHash::compute_element_tree(element);
         self.node_hashes.insert(node_id, (own_hash, tree_hash));
 
@@ -1025,6 +1076,11 @@ impl RenderTree {
             self.scroll_physics.insert(node_id, physics);
         }
 
+        // Register virtual list content so its lines can be materialized
+        if let Some(list) = element.virtual_list() {
+            self.register_virtual_list(node_id, list);
+        }
+
         // Update motion bindings if this element has continuous animations
         if let Some(bindings) = element.motion_bindings() {
             self.motion_bindings.insert(node_id, bindings);
@@ -1056,6 +1112,9 @@ impl RenderTree {
     /// # Arguments
     /// * `scale_factor` - The scale factor (1.0 = no scaling, 2.0 = 2x DPI)
     pub fn set_scale_factor(&mut self, scale_factor: f32) {
+        if scale_factor != self.scale_factor {
+            self.damage.mark_full();
+        }
         self.scale_factor = scale_factor;
     }
 
@@ -1145,6 +1204,11 @@ impl RenderTree {
             self.scroll_physics.insert(node_id, physics);
         }
 
+        // Register virtual list content so its lines can be materialized
+        if let Some(list) = element.virtual_list() {
+            self.register_virtual_list(node_id, list);
+        }
+
         // Store motion bindings if this element has continuous animations
         if let Some(bindings) = element.motion_bindings() {
             self.motion_bindings.insert(node_id, bindings);
@@ -1359,6 +1423,11 @@ impl RenderTree {
             self.scroll_physics.insert(node_id, physics);
         }
 
+        // Register virtual list content so its lines can be materialized
+        if let Some(list) = element.virtual_list() {
+            self.register_virtual_list(node_id, list);
+        }
+
         // Store motion bindings if this element has continuous animations
         if let Some(bindings) = element.motion_bindings() {
             self.motion_bindings.insert(node_id, bindings);
@@ -1644,6 +1713,11 @@ impl RenderTree {
             self.scroll_physics.insert(node_id, physics);
         }
 
+        // Register virtual list content so its lines can be materialized
+        if let Some(list) = element.virtual_list() {
+            self.register_virtual_list(node_id, list);
+        }
+
         // Store motion bindings if this element has continuous animations
         if let Some(bindings) = element.motion_bindings() {
             self.motion_bindings.insert(node_id, bindings);
@@ -1882,8 +1956,77 @@ impl RenderTree {
         self.root
     }
 
+    /// Lay out only what changed since the last layout
+    ///
+    /// Dirty nodes are re-laid-out from their nearest layout boundary (a
+    /// fixed-size ancestor, see `LayoutTree::compute_dirty_layout`), and only
+    /// those boundaries are damaged. Falls back to `compute_layout` when the
+    /// viewport changed, a change can reach the root, or layout animations
+    /// are running.
+    pub fn update_layout(&mut self, width: f32, height: f32) {
+        self.update_layout_pass(width, height);
+        self.settle_virtual_lists(width, height);
+    }
+
+    fn update_layout_pass(&mut self, width: f32, height: f32) {
+        let Some(root) = self.root else {
+            return;
+        };
+        if self.layout_viewport != Some((width, height)) || self.has_active_layout_animations() {
+            self.compute_layout_pass(width, height);
+            return;
+        }
+
+        match self.layout_tree.compute_dirty_layout(root) {
+            IncrementalLayout::Clean => {}
+            IncrementalLayout::Full => self.compute_layout_pass(width, height),
+            IncrementalLayout::Partial(boundaries) => {
+                tracing::trace!(
+                    "update_layout: {} boundaries, {} nodes laid out",
+                    boundaries.len(),
+                    self.layout_tree.last_layout_node_count()
+                );
+                for boundary in boundaries {
+                    self.mark_subtree_damage(boundary);
+                }
+                self.update_scroll_content_dimensions();
+                self.update_layout_bounds_storages();
+                self.update_layout_animations();
+                self.finish_layout();
+            }
+        }
+    }
+
+    /// Nodes laid out by the last `compute_layout` or `update_layout`
+    pub fn layout_node_count(&self) -> usize {
+        self.layout_tree.last_layout_node_count()
+    }
+
     /// Compute layout for the given viewport size
     pub fn compute_layout(&mut self, width: f32, height: f32) {
+        self.compute_layout_pass(width, height);
+        self.settle_virtual_lists(width, height);
+    }
+
+    /// Materialize virtual list lines for the layout just computed
+    ///
+    /// The window depends on the viewport and measured sizes from the
+    /// layout, and new lines need layout themselves, so this alternates
+    /// until the lists are stable (bounded, since each pass only refines
+    /// estimates).
+    fn settle_virtual_lists(&mut self, width: f32, height: f32) {
+        for _ in 0..MAX_VIRTUAL_LIST_PASSES {
+            if !self.update_virtual_lists() {
+                break;
+            }
+            self.update_layout_pass(width, height);
+        }
+    }
+
+    fn compute_layout_pass(&mut self, width: f32, height: f32) {
+        // Layout can move anything, so partial damage no longer applies
+        self.damage.mark_full();
+        self.layout_viewport = Some((width, height));
         if let Some(root) = self.root {
             // Step 1: Check for existing collapsing animations and apply their constraints
             // This ensures children are laid out at the larger (animated) size during collapse
@@ -1935,6 +2078,13 @@ impl RenderTree {
                 }
             }
 
+            self.finish_layout();
+        }
+    }
+
+    /// Post-layout bookkeeping shared by full and incremental layout
+    fn finish_layout(&mut self) {
+        if self.root.is_some() {
             // Cache element bounds for ElementHandle.bounds() queries
             self.cache_element_bounds();
 
@@ -3705,6 +3855,33 @@ impl RenderTree {
         (x.round(), y.round())
     }
 
+    /// Whether a node offsets its children by a scroll offset
+    pub fn is_scroll_container(&self, node_id: LayoutNodeId) -> bool {
+        self.scroll_physics.contains_key(&node_id) || self.scroll_offsets.contains_key(&node_id)
+    }
+
+    /// Number of nodes registered as scroll containers
+    ///
+    /// Containers are only ever added between rebuilds, so a change in the
+    /// count means the set changed.
+    pub(crate) fn scroll_container_count(&self) -> usize {
+        self.scroll_physics.len() + self.scroll_offsets.len()
+    }
+
+    /// Nodes containing a point, in tree pre-order
+    ///
+    /// Looks the point up in the hit-test index, (re)building it first if
+    /// layout changed since it was built.
+    pub(crate) fn hit_test_point(&self, x: f32, y: f32) -> Vec<IndexedHit> {
+        let mut index = self.hit_index.lock().unwrap();
+        if !index.as_ref().is_some_and(|i| i.is_current(self)) {
+            *index = Some(HitIndex::build(self));
+        }
+        index
+            .as_ref()
+            .map_or_else(Vec::new, |i| i.query(self, x, y))
+    }
+
     /// Get the motion translation for a node (if it has motion bindings)
     ///
     /// Returns the current translation transform from any bound AnimatedValue(s).
@@ -3745,6 +3922,25 @@ impl RenderTree {
         self.motion_bindings.contains_key(&node_id)
     }
 
+    /// Draw a scroll container's scrollbar in its current state
+    ///
+    /// `ctx` must be in the container's local space, inside its clip (as in
+    /// `render_with_motion`); retaining contexts use this to redraw just the
+    /// scrollbar when only the offset changed.
+    pub fn render_scroll_indicator(&self, ctx: &mut dyn DrawContext, node: LayoutNodeId) {
+        let Some(bounds) = self.get_render_bounds(node, (0.0, 0.0)) else {
+            return;
+        };
+        if let Some(physics) = self.scroll_physics.get(&node) {
+            if let Ok(p) = physics.try_lock() {
+                let info = p.scrollbar_render_info();
+                if info.opacity > 0.01 {
+                    self.render_scrollbar(ctx, bounds.width, bounds.height, &info);
+                }
+            }
+        }
+    }
+
     /// Render scrollbar overlay for a scroll container
     fn render_scrollbar(
         &self,
@@ -3992,6 +4188,12 @@ impl RenderTree {
             }
         }
 
+        // Momentum scrolling moves lists without an event, so ask for a
+        // frame that runs `process_pending_subtree_rebuilds`
+        if self.virtual_lists_need_update() {
+            crate::stateful::request_redraw();
+        }
+
         any_animating
     }
 
@@ -4074,10 +4276,324 @@ impl RenderTree {
         F: FnOnce(&mut RenderProps),
     {
         if let Some(render_node) = self.render_nodes.get_mut(&node_id) {
+            self.damage
+                .mark_node(node_id, render_node.props.transform.clone());
             f(&mut render_node.props);
         }
     }
 
+    // =========================================================================
+    // Damage Tracking
+    // =========================================================================
+
+    /// Repaint the whole tree on the next frame
+    ///
+    /// Use this after changing something the tree can't observe (e.g. state
+    /// read only at render time).
+    pub fn mark_damage_full(&mut self) {
+        self.damage.mark_full();
+    }
+
+    /// Repaint a node and everything below it on the next frame
+    pub fn mark_damage(&mut self, node_id: LayoutNodeId) {
+        if let Some(render_node) = self.render_nodes.get(&node_id) {
+            self.damage
+                .mark_node(node_id, render_node.props.transform.clone());
+        }
+    }
+
+    /// Mark a node's subtree for repaint ahead of changes anywhere inside it
+    ///
+    /// Only the root is marked: the damage walk repaints the whole subtree
+    /// from there. Descendants with an element transform are marked too so
+    /// their old transform is kept, in case the change replaces it.
+    fn mark_subtree_damage(&mut self, node_id: LayoutNodeId) {
+        self.mark_damage(node_id);
+        let mut stack = self.layout_tree.children(node_id);
+        while let Some(child_id) = stack.pop() {
+            if let Some(render_node) = self.render_nodes.get(&child_id) {
+                if render_node.props.transform.is_some() {
+                    self.damage
+                        .mark_node(child_id, render_node.props.transform.clone());
+                }
+            }
+            stack.extend(self.layout_tree.children(child_id));
+        }
+    }
+
+    /// Resolve everything that changed since the last call into screen regions
+    ///
+    /// Damage comes from `update_render_props`, visual-only subtree rebuilds,
+    /// motion bindings and scroll offsets; a new tree, layout recomputation,
+    /// structural rebuilds and layout/visual animations repaint everything.
+    /// Call once per rendered frame.
+    ///
+    /// `width` and `height` are the logical viewport size (as passed to
+    /// `compute_layout`); returned rects are in physical pixels.
+    pub fn take_damage(&mut self, width: f32, height: f32) -> Damage {
+        let (full, pending) = self.damage.take();
+        let mut acc = DamageAccumulator::default();
+        let mut scroll_only = true;
+        if full || self.has_active_layout_animations() || self.has_active_visual_animations() {
+            acc.mark_full();
+            scroll_only = false;
+        }
+
+        let needs_walk = !pending.is_empty()
+            || !self.motion_bindings.is_empty()
+            || !self.scroll_physics.is_empty()
+            || !self.scroll_offsets.is_empty();
+
+        if let (true, Some(root)) = (needs_walk, self.root) {
+            let mut walk = DamageWalk {
+                pending: &pending,
+                prev_motion: std::mem::take(&mut self.damage.motion_samples),
+                prev_scroll: std::mem::take(&mut self.damage.scroll_samples),
+                motion: HashMap::new(),
+                scroll: HashMap::new(),
+                acc,
+                scroll_only,
+            };
+            self.collect_damage(root, &Affine2D::IDENTITY, None, false, &mut walk);
+            self.damage.motion_samples = walk.motion;
+            self.damage.scroll_samples = walk.scroll;
+            acc = walk.acc;
+            scroll_only = walk.scroll_only;
+        }
+
+        let damage = acc.finish(Rect::new(0.0, 0.0, width, height), self.scale_factor);
+        self.damage.scroll_only = scroll_only && !damage.is_none();
+        damage
+    }
+
+    /// Whether the last `take_damage` found nothing but scroll changes
+    ///
+    /// True when every damaged region came from a scroll container's offset
+    /// or scrollbar. A renderer that kept the previous frame's primitives can
+    /// then move the scroll content (see `DrawContext::begin_scroll_content`)
+    /// instead of walking the tree again.
+    pub fn damage_is_scroll_only(&self) -> bool {
+        self.damage.scroll_only
+    }
+
+    /// Node-to-screen matrix, mirroring the transform stack in `render_node`
+    ///
+    /// `element_transform` is passed separately so the matrix can also be
+    /// computed for a node's transform from before a prop update. Returns None
+    /// for 3D transforms, which can't be bounded cheaply.
+    fn damage_node_matrix(
+        &self,
+        node: LayoutNodeId,
+        origin: &Affine2D,
+        element_transform: Option<&Transform>,
+        bounds: &ElementBounds,
+    ) -> Option<Affine2D> {
+        let (cx, cy) = (bounds.width / 2.0, bounds.height / 2.0);
+        let centered = |m: Affine2D, t: &Affine2D| {
+            m.then(&Affine2D::translation(cx, cy))
+                .then(t)
+                .then(&Affine2D::translation(-cx, -cy))
+        };
+
+        let mut matrix = *origin;
+        match element_transform {
+            Some(Transform::Affine2D(t)) => matrix = centered(matrix, t),
+            Some(Transform::Mat4(_)) => return None,
+            None => {}
+        }
+        match self.get_motion_transform(node) {
+            Some(Transform::Affine2D(t)) => matrix = matrix.then(&t),
+            Some(Transform::Mat4(_)) => return None,
+            None => {}
+        }
+        if let Some((sx, sy)) = self.get_motion_scale(node) {
+            matrix = centered(matrix, &Affine2D::scale(sx, sy));
+        }
+        if let Some(deg) = self.get_motion_rotation(node) {
+            matrix = centered(matrix, &Affine2D::rotation(deg.to_radians()));
+        }
+        Some(matrix)
+    }
+
+    /// Walk the tree, adding damage for pending, moving and scrolled nodes
+    ///
+    /// `in_pending` is set below a pending node, whose subtree has already
+    /// been damaged where it is now.
+    fn collect_damage(
+        &self,
+        node: LayoutNodeId,
+        parent: &Affine2D,
+        clip: Option<Rect>,
+        in_pending: bool,
+        walk: &mut DamageWalk<'_>,
+    ) {
+        let Some(bounds) = self.layout_tree.get_bounds(node, (0.0, 0.0)) else {
+            return;
+        };
+        let Some(render_node) = self.render_nodes.get(&node) else {
+            return;
+        };
+
+        let origin = parent.then(&Affine2D::translation(bounds.x, bounds.y));
+        let Some(matrix) =
+            self.damage_node_matrix(node, &origin, render_node.props.transform.as_ref(), &bounds)
+        else {
+            walk.acc.mark_full();
+            walk.scroll_only = false;
+            return;
+        };
+
+        // Changed node: repaint its subtree where it is now and where it was
+        let pending = walk.pending.get(&node);
+        if let Some(old_transform) = pending {
+            walk.scroll_only = false;
+            let mut full = false;
+            if !in_pending {
+                if let Some(r) = self.damage_subtree_bounds(node, &matrix, clip, &mut full) {
+                    walk.acc.add(r);
+                }
+            }
+            if old_transform.is_some() || render_node.props.transform.is_some() {
+                match self.damage_node_matrix(node, &origin, old_transform.as_ref(), &bounds) {
+                    Some(old) => {
+                        if let Some(r) = self.damage_subtree_bounds(node, &old, clip, &mut full) {
+                            walk.acc.add(r);
+                        }
+                    }
+                    None => full = true,
+                }
+            }
+            if full {
+                walk.acc.mark_full();
+                return;
+            }
+        }
+
+        // Motion-bound node: repaint when its matrix or opacity moved
+        if self.motion_bindings.contains_key(&node) {
+            let matrix_elements = matrix.elements;
+            let opacity = self.get_motion_opacity(node).unwrap_or(1.0);
+            let previous = walk.prev_motion.get(&node).copied();
+            let sample = match previous {
+                Some(prev) if prev.matrix == matrix_elements && prev.opacity == opacity => prev,
+                _ => {
+                    walk.scroll_only = false;
+                    let mut full = false;
+                    let now = self.damage_subtree_bounds(node, &matrix, clip, &mut full);
+                    if full {
+                        walk.acc.mark_full();
+                        return;
+                    }
+                    for r in now.into_iter().chain(previous.and_then(|p| p.bounds)) {
+                        walk.acc.add(r);
+                    }
+                    MotionSample {
+                        matrix: matrix_elements,
+                        opacity,
+                        bounds: now,
+                    }
+                }
+            };
+            walk.motion.insert(node, sample);
+        }
+
+        let screen_bounds = transformed_bounds(&matrix, bounds.width, bounds.height);
+
+        // Scroll container: repaint its viewport when the offset or scrollbar changed
+        let scroll_offset = self.get_scroll_offset(node);
+        if self.scroll_physics.contains_key(&node) || self.scroll_offsets.contains_key(&node) {
+            let scrollbar = self
+                .scroll_physics
+                .get(&node)
+                .and_then(|p| p.try_lock().ok().map(|p| p.scrollbar_render_info()));
+            let sample = ScrollSample {
+                offset: scroll_offset,
+                scrollbar_opacity: scrollbar.as_ref().map_or(0.0, |i| i.opacity),
+                scrollbar_active: scrollbar
+                    .as_ref()
+                    .is_some_and(|i| i.state != crate::widgets::scroll::ScrollbarState::default()),
+            };
+            if walk.prev_scroll.get(&node) != Some(&sample) {
+                if let Some(r) = clip_to(screen_bounds, clip) {
+                    walk.acc.add(r);
+                }
+            }
+            walk.scroll.insert(node, sample);
+        }
+
+        let child_clip = if render_node.props.clips_content {
+            match clip_to(screen_bounds, clip) {
+                Some(r) => Some(r),
+                // Fully clipped away - nothing below can be visible
+                None => return,
+            }
+        } else {
+            clip
+        };
+
+        let child_parent = matrix.then(&Affine2D::translation(scroll_offset.0, scroll_offset.1));
+        let child_in_pending = in_pending || pending.is_some();
+        for child_id in self.layout_tree.children(node) {
+            self.collect_damage(child_id, &child_parent, child_clip, child_in_pending, walk);
+        }
+    }
+
+    /// Screen bounds of a node and everything it draws below it
+    ///
+    /// Sets `full` if a 3D transform makes the subtree unboundable.
+    fn damage_subtree_bounds(
+        &self,
+        node: LayoutNodeId,
+        matrix: &Affine2D,
+        clip: Option<Rect>,
+        full: &mut bool,
+    ) -> Option<Rect> {
+        let bounds = self.layout_tree.get_bounds(node, (0.0, 0.0))?;
+        let render_node = self.render_nodes.get(&node)?;
+
+        let node_bounds = transformed_bounds(matrix, bounds.width, bounds.height);
+        let mut result = Some(node_bounds);
+        if let Some(shadow) = &render_node.props.shadow {
+            result = Some(union_rect(
+                node_bounds,
+                shadow_bounds(matrix, bounds.width, bounds.height, shadow),
+            ));
+        }
+
+        let child_clip = if render_node.props.clips_content {
+            match clip_to(node_bounds, clip) {
+                Some(r) => Some(r),
+                None => return clip_to(result?, clip),
+            }
+        } else {
+            clip
+        };
+
+        let (sx, sy) = self.get_scroll_offset(node);
+        let child_parent = matrix.then(&Affine2D::translation(sx, sy));
+        for child_id in self.layout_tree.children(node) {
+            let Some(child_bounds) = self.layout_tree.get_bounds(child_id, (0.0, 0.0)) else {
+                continue;
+            };
+            let origin = child_parent.then(&Affine2D::translation(child_bounds.x, child_bounds.y));
+            let transform = self
+                .render_nodes
+                .get(&child_id)
+                .and_then(|n| n.props.transform.as_ref());
+            let Some(child_matrix) =
+                self.damage_node_matrix(child_id, &origin, transform, &child_bounds)
+            else {
+                *full = true;
+                return None;
+            };
+            if let Some(r) = self.damage_subtree_bounds(child_id, &child_matrix, child_clip, full) {
+                result = Some(result.map_or(r, |acc| union_rect(acc, r)));
+            }
+        }
+
+        clip_to(result?, clip)
+    }
+
     // =========================================================================
     // Stylesheet Integration
     // =========================================================================
@@ -4158,8 +4674,8 @@ impl RenderTree {
             None => return false,
         };
 
-        // Apply state-specific styles in order of precedence
-        let mut applied = false;
+        self.mark_damage(node_id);
+
         let render_node = match self.render_nodes.get_mut(&node_id) {
             Some(node) => node,
             None => return false,
@@ -4168,38 +4684,17 @@ impl RenderTree {
         // Reset to base style first
         render_node.props = base_props;
 
-        // Apply base stylesheet style (if any)
-        if let Some(base_style) = stylesheet.get(&element_id) {
-            Self::apply_element_style_to_props(&mut render_node.props, base_style);
-            applied = true;
-        }
-
-        // Apply hover style
-        if hovered {
-            if let Some(hover_style) = stylesheet.get_with_state(&element_id, ElementState::Hover) {
-                Self::apply_element_style_to_props(&mut render_node.props, hover_style);
-                applied = true;
-            }
-        }
-
-        // Apply active/pressed style (takes precedence over hover)
-        if pressed {
-            if let Some(active_style) = stylesheet.get_with_state(&element_id, ElementState::Active)
-            {
-                Self::apply_element_style_to_props(&mut render_node.props, active_style);
-                applied = true;
-            }
-        }
-
-        // Apply focus style
-        if focused {
-            if let Some(focus_style) = stylesheet.get_with_state(&element_id, ElementState::Focus) {
-                Self::apply_element_style_to_props(&mut render_node.props, focus_style);
-                applied = true;
+        // Apply the base stylesheet style merged with the active state styles
+        // (active takes precedence over hover, focus over both). The merge is
+        // cached by the stylesheet per element and state combination.
+        let states = ElementStates::from_interaction(hovered, pressed, focused);
+        match stylesheet.computed_style(&element_id, states) {
+            Some(style) => {
+                Self::apply_element_style_to_props(&mut render_node.props, style);
+                true
             }
+            None => false,
         }
-
-        applied
     }
 
     /// Apply ElementStyle properties to RenderProps
@@ -4242,11 +4737,7 @@ impl RenderTree {
             None => return false,
         };
 
-        // Check if any state styles exist
-        stylesheet.contains_with_state(&element_id, ElementState::Hover)
-            || stylesheet.contains_with_state(&element_id, ElementState::Active)
-            || stylesheet.contains_with_state(&element_id, ElementState::Focus)
-            || stylesheet.contains_with_state(&element_id, ElementState::Disabled)
+        stylesheet.has_state_styles(&element_id)
     }
 
     /// Apply stylesheet state styles based on EventRouter state
@@ -4358,6 +4849,7 @@ impl RenderTree {
         self.scroll_offsets.remove(&node_id);
         self.scroll_physics.remove(&node_id);
         self.scroll_refs.remove(&node_id);
+        self.virtual_lists.remove(&node_id);
         // Unregister from element registry (removes by node_id)
         self.element_registry.unregister(node_id);
         // Remove layout animation config (but keep stable-key animations running)
@@ -4379,8 +4871,10 @@ impl RenderTree {
     /// Rebuilds for nodes in other trees (e.g., overlay) are put back in the queue.
     pub fn process_pending_subtree_rebuilds(&mut self) -> bool {
         let pending = crate::stateful::take_pending_subtree_rebuilds();
+        self.last_subtree_rebuilds = 0;
         if pending.is_empty() {
-            return false;
+            // Scrolled virtual lists request a redraw instead of queueing
+            return self.update_virtual_lists();
         }
 
         tracing::debug!("Processing {} pending subtree rebuilds", pending.len());
@@ -4398,6 +4892,7 @@ impl RenderTree {
                 not_in_this_tree.push(rebuild);
                 continue;
             }
+            self.last_subtree_rebuilds += 1;
             tracing::debug!(
                 "Subtree rebuild: processing node {:?}, needs_layout={}",
                 rebuild.parent_id,
@@ -4406,6 +4901,9 @@ impl RenderTree {
             if rebuild.needs_layout {
                 // Full structural rebuild - remove old children and build new ones
                 needs_layout = true;
+                // Layout damages the area that moves; this covers the parent
+                // itself if its own props change
+                self.mark_damage(rebuild.parent_id);
 
                 // Update the parent node's own render props AND layout style
                 // This is critical for overlay layer where size changes from 0x0 to full viewport
@@ -4438,6 +4936,7 @@ impl RenderTree {
             } else {
                 // Visual-only update - just update render props of existing children
                 // Don't remove/rebuild, just walk the tree and update props
+                self.mark_subtree_damage(rebuild.parent_id);
                 self.update_subtree_props_recursive(rebuild.parent_id, &rebuild.new_child);
             }
         }
@@ -4447,7 +4946,148 @@ impl RenderTree {
             crate::stateful::requeue_subtree_rebuilds(not_in_this_tree);
         }
 
-        needs_layout
+        self.update_virtual_lists() || needs_layout
+    }
+
+    /// Rebuilds applied to this tree by the last `process_pending_subtree_rebuilds`
+    ///
+    /// Counted after rebuilds queued for the same node were coalesced, and
+    /// excluding those requeued for other trees.
+    pub fn subtree_rebuild_count(&self) -> usize {
+        self.last_subtree_rebuilds
+    }
+
+    // =========================================================================
+    // Virtual Lists
+    // =========================================================================
+
+    /// Track a virtual list whose lines are materialized under `node_id`
+    ///
+    /// Lines from an earlier registration belong to nodes that are gone or
+    /// about to be replaced, so they are dropped; the next
+    /// `update_virtual_lists` materializes the window again.
+    fn register_virtual_list(&mut self, node_id: LayoutNodeId, list: SharedVirtualList) {
+        for child_id in self.layout_tree.children(node_id) {
+            self.remove_subtree_nodes(child_id);
+        }
+        self.layout_tree.clear_children(node_id);
+        list.lock().unwrap().lines.clear();
+        self.virtual_lists.insert(node_id, list);
+    }
+
+    /// Whether any virtual list scrolled far enough to need other lines
+    fn virtual_lists_need_update(&self) -> bool {
+        self.virtual_lists
+            .values()
+            .any(|list| list.lock().unwrap().needs_update())
+    }
+
+    /// Bring every virtual list in line with its scroll position and the
+    /// last layout
+    ///
+    /// Measured line heights replace estimates, lines that left the window
+    /// are released (their wrappers are recycled for lines that entered),
+    /// and line offsets and the content height follow the new sizes.
+    /// Returns true if the layout tree changed and needs layout.
+    pub fn update_virtual_lists(&mut self) -> bool {
+        use crate::widgets::virtual_list::MaterializedLine;
+
+        let lists: Vec<_> = self
+            .virtual_lists
+            .iter()
+            .map(|(&node_id, list)| (node_id, Arc::clone(list)))
+            .collect();
+
+        let mut changed = false;
+        for (content_id, list) in lists {
+            let mut list = list.lock().unwrap();
+
+            // Lines that haven't been laid out yet have no width
+            let heights: Vec<(usize, f32)> = list
+                .lines
+                .iter()
+                .filter_map(|(&line, materialized)| {
+                    let layout = self.layout_tree.get_layout(materialized.node)?;
+                    (layout.size.width > 0.0).then_some((line, layout.size.height))
+                })
+                .collect();
+            let resized = list.record_measurements(&heights);
+            if !resized && !list.needs_update() {
+                continue;
+            }
+            changed = true;
+            self.mark_damage(content_id);
+
+            let window = list.window();
+            let departed: Vec<usize> = list
+                .lines
+                .keys()
+                .copied()
+                .filter(|line| !window.contains(line))
+                .collect();
+            let mut recycled: Vec<LayoutNodeId> = departed
+                .iter()
+                .filter_map(|line| list.lines.remove(line))
+                .map(|materialized| materialized.node)
+                .collect();
+
+            for line in window {
+                let top = list.line_offset(line);
+                if let Some(materialized) = list.lines.get_mut(&line) {
+                    if materialized.top != top {
+                        materialized.top = top;
+                        let node = materialized.node;
+                        if let Some(mut style) = self.layout_tree.get_style(node) {
+                            style.inset.top = LengthPercentageAuto::Length(top);
+                            self.layout_tree.set_style(node, style);
+                        }
+                    }
+                    continue;
+                }
+
+                let element = list.build_line(line);
+                let node = match recycled.pop() {
+                    Some(node) => {
+                        // Keep the wrapper, replace what's inside it
+                        for child_id in self.layout_tree.children(node) {
+                            self.remove_subtree_nodes(child_id);
+                        }
+                        self.layout_tree.clear_children(node);
+                        if let Some(style) = element.layout_style() {
+                            self.layout_tree.set_style(node, style.clone());
+                        }
+                        for child in element.children_builders() {
+                            let child_id = child.build(&mut self.layout_tree);
+                            self.layout_tree.add_child(node, child_id);
+                            self.collect_render_props_boxed(child.as_ref(), child_id);
+                        }
+                        node
+                    }
+                    None => {
+                        let node = element.build(&mut self.layout_tree);
+                        self.layout_tree.add_child(content_id, node);
+                        self.collect_render_props(&element, node);
+                        node
+                    }
+                };
+                list.lines.insert(line, MaterializedLine { node, top });
+            }
+
+            for node in recycled {
+                self.remove_subtree_nodes(node);
+                self.layout_tree.remove_subtree(node);
+            }
+
+            if let Some(mut style) = self.layout_tree.get_style(content_id) {
+                let height = Dimension::Length(list.content_height());
+                if style.size.height != height {
+                    style.size.height = height;
+                    self.layout_tree.set_style(content_id, style);
+                }
+            }
+        }
+
+        changed
     }
 
     /// Recursively update render props for existing children without rebuilding
@@ -5169,13 +5809,15 @@ impl RenderTree {
             render_node.props.layer
         };
 
-        // Push layer if this node has partial opacity OR layer effects
+        // Push layer if this node has partial opacity OR layer effects OR is a
+        // retained layer (`cache_layer`)
         // Children inside the layer automatically inherit the opacity via GPU composition
         // Layer effects (blur, drop shadow, glow, color matrix) are applied when layer is composited
         // IMPORTANT: Only push layer when element's layer matches current target to avoid duplicate
         // layer commands across multiple render passes
         let has_layer_effects = !render_node.props.layer_effects.is_empty();
-        let has_opacity_layer = node_motion_opacity < 1.0 || has_layer_effects;
+        let cache_layer = render_node.props.cache_layer;
+        let has_opacity_layer = node_motion_opacity < 1.0 || has_layer_effects || cache_layer;
         let should_push_layer = has_opacity_layer && effective_layer == target_layer;
         if should_push_layer {
             ctx.push_layer(LayerConfig {
@@ -5186,6 +5828,7 @@ impl RenderTree {
                 opacity: node_motion_opacity,
                 depth: false,
                 effects: render_node.props.layer_effects.clone(),
+                retained: cache_layer,
             });
         }
 
@@ -5471,6 +6114,11 @@ impl RenderTree {
         } else {
             motion_opacity
         };
+        // Mark scroll content so retaining contexts can move it on later frames
+        let is_scroll_container = self.is_scroll_container(node);
+        if is_scroll_container {
+            ctx.begin_scroll_content(node.to_raw());
+        }
         for child_id in self.layout_tree.children(node) {
             self.render_layer_with_motion(
                 ctx,
@@ -5483,6 +6131,9 @@ impl RenderTree {
                 child_inherited_opacity,
             );
         }
+        if is_scroll_container {
+            ctx.end_scroll_content();
+        }
 
         // Pop children inset clip
         if push_children_clip {
@@ -5497,15 +6148,10 @@ impl RenderTree {
         // Render scrollbar overlay if this is a scroll container
         // Scrollbar is rendered after scroll transform is popped (in viewport space)
         // but before clip is popped (clipped within scroll container)
-        if effective_layer == target_layer {
-            if let Some(physics) = self.scroll_physics.get(&node) {
-                if let Ok(p) = physics.try_lock() {
-                    let info = p.scrollbar_render_info();
-                    if info.opacity > 0.01 {
-                        self.render_scrollbar(ctx, bounds.width, bounds.height, &info);
-                    }
-                }
-            }
+        if effective_layer == target_layer && self.scroll_physics.contains_key(&node) {
+            ctx.begin_scroll_indicator(node.to_raw());
+            self.render_scroll_indicator(ctx, node);
+            ctx.end_scroll_indicator();
         }
 
         // Pop clip
@@ -6674,6 +7320,59 @@ fn apply_opacity_to_brush(brush: &Brush, opacity: f32) -> Brush {
     }
 }
 
+/// State threaded through `RenderTree::collect_damage`
+struct DamageWalk<'a> {
+    /// Nodes changed since the last frame, with their old element transform
+    pending: &'a HashMap<LayoutNodeId, Option<Transform>>,
+    /// Samples from the previous frame
+    prev_motion: HashMap<LayoutNodeId, MotionSample>,
+    prev_scroll: HashMap<LayoutNodeId, ScrollSample>,
+    /// Samples for this frame (nodes no longer in the tree drop out)
+    motion: HashMap<LayoutNodeId, MotionSample>,
+    scroll: HashMap<LayoutNodeId, ScrollSample>,
+    acc: DamageAccumulator,
+    /// Whether all damage so far came from scroll containers
+    scroll_only: bool,
+}
+
+/// Axis-aligned screen bounds of a `width` x `height` box under `matrix`
+fn transformed_bounds(matrix: &Affine2D, width: f32, height: f32) -> Rect {
+    let corners = [
+        matrix.transform_point(blinc_core::Point::new(0.0, 0.0)),
+        matrix.transform_point(blinc_core::Point::new(width, 0.0)),
+        matrix.transform_point(blinc_core::Point::new(0.0, height)),
+        matrix.transform_point(blinc_core::Point::new(width, height)),
+    ];
+    let (mut x0, mut y0) = (f32::INFINITY, f32::INFINITY);
+    let (mut x1, mut y1) = (f32::NEG_INFINITY, f32::NEG_INFINITY);
+    for p in corners {
+        x0 = x0.min(p.x);
+        y0 = y0.min(p.y);
+        x1 = x1.max(p.x);
+        y1 = y1.max(p.y);
+    }
+    Rect::new(x0, y0, x1 - x0, y1 - y0)
+}
+
+/// Screen bounds of a box shadow, with room for the blur falloff
+fn shadow_bounds(matrix: &Affine2D, width: f32, height: f32, shadow: &Shadow) -> Rect {
+    let extent = shadow.blur * 2.0 + shadow.spread.abs();
+    let local = Affine2D::translation(shadow.offset_x - extent, shadow.offset_y - extent);
+    transformed_bounds(
+        &matrix.then(&local),
+        width + extent * 2.0,
+        height + extent * 2.0,
+    )
+}
+
+/// Clip a rect, treating `None` as unclipped
+fn clip_to(rect: Rect, clip: Option<Rect>) -> Option<Rect> {
+    match clip {
+        Some(clip) => intersect_rect(rect, clip),
+        None => Some(rect),
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -6705,4 +7404,77 @@ mod tests {
         assert_eq!(bounds.width, 200.0);
         assert_eq!(bounds.height, 200.0);
     }
+
+    #[test]
+    fn test_prop_update_damages_only_the_node() {
+        let ui = div()
+            .w(200.0)
+            .h(200.0)
+            .flex_col()
+            .child(div().h(50.0).w_full())
+            .child(div().flex_grow().w_full());
+
+        let mut tree = RenderTree::from_element(&ui);
+        tree.compute_layout(200.0, 200.0);
+        assert!(tree.take_damage(200.0, 200.0).is_full());
+        assert!(tree.take_damage(200.0, 200.0).is_none());
+
+        let root = tree.root().unwrap();
+        let first = tree.layout_tree.children(root)[0];
+        tree.update_render_props(first, |p| p.opacity = 0.5);
+
+        let damage = tree.take_damage(200.0, 200.0);
+        let bounds = damage.bounds().expect("partial damage");
+        assert!(bounds.y() <= 0.0 && bounds.y() + bounds.height() >= 50.0);
+        assert!(bounds.y() + bounds.height() < 60.0);
+    }
+
+    #[test]
+    fn test_visual_update_damages_only_changed_nodes() {
+        let ui = |opacity| {
+            div()
+                .w(200.0)
+                .h(200.0)
+                .flex_col()
+                .child(div().h(50.0).w_full().opacity(opacity))
+                .child(div().flex_grow().w_full())
+        };
+
+        let mut tree = RenderTree::from_element(&ui(1.0));
+        tree.compute_layout(200.0, 200.0);
+        tree.take_damage(200.0, 200.0);
+
+        assert_eq!(tree.incremental_update(&ui(0.5)), UpdateResult::VisualOnly);
+        let damage = tree.take_damage(200.0, 200.0);
+        let bounds = damage.bounds().expect("partial damage");
+        assert!(bounds.y() + bounds.height() < 60.0);
+    }
+
+    #[test]
+    fn test_scroll_damage_is_scroll_only() {
+        let ui = div()
+            .w(200.0)
+            .h(200.0)
+            .flex_col()
+            .child(div().h(100.0).w_full().overflow_clip())
+            .child(div().h(50.0).w_full());
+
+        let mut tree = RenderTree::from_element(&ui);
+        tree.compute_layout(200.0, 200.0);
+        let root = tree.root().unwrap();
+        let children = tree.layout_tree.children(root);
+        tree.take_damage(200.0, 200.0);
+        assert!(!tree.damage_is_scroll_only());
+
+        tree.set_scroll_offset(children[0], 0.0, -10.0);
+        tree.take_damage(200.0, 200.0);
+        tree.set_scroll_offset(children[0], 0.0, -20.0);
+        assert!(!tree.take_damage(200.0, 200.0).is_none());
+        assert!(tree.damage_is_scroll_only());
+
+        tree.set_scroll_offset(children[0], 0.0, -30.0);
+        tree.update_render_props(children[1], |p| p.opacity = 0.5);
+        tree.take_damage(200.0, 200.0);
+        assert!(!tree.damage_is_scroll_only());
+    }
 }
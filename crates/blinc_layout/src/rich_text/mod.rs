@@ -624,6 +624,7 @@ impl ElementBuilder for RichText {
             pointer_events_none: false,
             cursor: self.cursor,
             layer_effects: Vec::new(),
+            cache_layer: false,
             motion_is_exiting: false,
         }
     }
@@ -6,6 +6,7 @@ use blinc_core::context_state::MotionAnimationState;
 use blinc_core::BlincContextState;
 
 use crate::element::{ElementBounds, RenderProps};
+use crate::stateful::{current_update_queue, SharedUpdateQueue};
 use crate::tree::LayoutNodeId;
 
 use super::registry::{ElementRegistry, OnReadyCallback};
@@ -16,6 +17,10 @@ use super::ScrollOptions;
 /// Returned by `ctx.query("element-id")` for element manipulation.
 /// The handle can be created even before the element exists in the tree,
 /// allowing operations like `on_ready` to be registered early.
+///
+/// Updates queued through the handle go to the update queue that was current
+/// when it was created, so a handle moved to another thread still updates
+/// its own context.
 #[derive(Clone)]
 pub struct ElementHandle<T = ()> {
     /// The string ID used to query this element
@@ -23,6 +28,8 @@ pub struct ElementHandle<T = ()> {
     /// Cached node_id (may be default if element doesn't exist yet)
     node_id: LayoutNodeId,
     registry: Arc<ElementRegistry>,
+    /// Queue of the context the handle was created in
+    update_queue: SharedUpdateQueue,
     /// Typed element data (if available)
     _marker: std::marker::PhantomData<T>,
 }
@@ -39,6 +46,18 @@ impl<T> ElementHandle<T> {
             string_id,
             node_id,
             registry,
+            update_queue: current_update_queue(),
+            _marker: std::marker::PhantomData,
+        }
+    }
+
+    /// Handle to another element of the same context
+    fn related(&self, string_id: String) -> ElementHandle<()> {
+        ElementHandle {
+            node_id: self.registry.get(&string_id).unwrap_or_default(),
+            string_id,
+            registry: self.registry.clone(),
+            update_queue: self.update_queue.clone(),
             _marker: std::marker::PhantomData,
         }
     }
@@ -111,17 +130,17 @@ impl<T> ElementHandle<T> {
         let current_node_id = self.node_id();
         let parent_node_id = self.registry.get_parent(current_node_id)?;
         let parent_string_id = self.registry.get_id(parent_node_id)?;
-        Some(ElementHandle::new(parent_string_id, self.registry.clone()))
+        Some(self.related(parent_string_id))
     }
 
     /// Get all ancestors (immediate parent to root)
     pub fn ancestors(&self) -> impl Iterator<Item = ElementHandle<()>> {
         let current_node_id = self.node_id();
         let ancestors = self.registry.ancestors(current_node_id);
-        let registry = self.registry.clone();
+        let handle = self.related(self.string_id.clone());
         ancestors.into_iter().filter_map(move |id| {
-            let string_id = registry.get_id(id)?;
-            Some(ElementHandle::new(string_id, registry.clone()))
+            let string_id = handle.registry.get_id(id)?;
+            Some(handle.related(string_id))
         })
     }
 
@@ -205,7 +224,8 @@ impl<T> ElementHandle<T> {
     /// new children should be.
     pub fn mark_dirty_subtree(&self, new_children: crate::div::Div) {
         if let Some(node_id) = self.registry.get(&self.string_id) {
-            crate::stateful::queue_subtree_rebuild(node_id, new_children);
+            self.update_queue
+                .queue_subtree_rebuild(node_id, new_children, true);
         }
     }
 
@@ -227,7 +247,7 @@ impl<T> ElementHandle<T> {
     /// ```
     pub fn mark_visual_dirty(&self, props: RenderProps) {
         if let Some(node_id) = self.registry.get(&self.string_id) {
-            crate::stateful::queue_prop_update(node_id, props);
+            self.update_queue.queue_prop_update(node_id, props);
         }
     }
 
@@ -333,6 +353,25 @@ pub trait Queryable: Sized {
 mod tests {
     use super::*;
 
+    #[test]
+    fn test_handle_updates_its_own_context_from_other_threads() {
+        let registry = Arc::new(ElementRegistry::new());
+        registry.register("badge", LayoutNodeId::default());
+
+        let external = SharedUpdateQueue::default();
+        let handle: ElementHandle<()> = {
+            let _scope = external.enter();
+            ElementHandle::new("badge", registry)
+        };
+
+        // The worker thread never enters a queue
+        std::thread::spawn(move || handle.mark_visual_dirty(RenderProps::default()))
+            .join()
+            .unwrap();
+        assert!(external.take_needs_redraw());
+        assert_eq!(external.take_prop_updates().len(), 1);
+    }
+
     #[test]
     fn test_handle_creation() {
         let registry = Arc::new(ElementRegistry::new());
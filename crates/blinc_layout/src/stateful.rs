@@ -57,7 +57,7 @@
 //! mutable reference to the inner `Div` for full mutation capability.
 
 use std::cell::RefCell;
-use std::collections::HashMap;
+use std::collections::{HashMap, HashSet};
 use std::hash::Hash;
 use std::sync::atomic::{AtomicBool, Ordering};
 use std::sync::{Arc, LazyLock, Mutex, RwLock};
@@ -68,6 +68,7 @@ use crate::tree::{LayoutNodeId, LayoutTree};
 use blinc_animation::{
     AnimatedKeyframe, AnimatedTimeline, AnimatedValue, Easing, SchedulerHandle, SpringConfig,
 };
+use blinc_core::mpsc::MpscQueue;
 use blinc_core::reactive::SignalId;
 
 /// Re-export SharedAnimatedValue from motion module
@@ -273,50 +274,218 @@ static PERSISTED_KEYFRAME_TRACKS: LazyLock<RwLock<HashMap<String, SharedKeyframe
     LazyLock::new(|| RwLock::new(HashMap::new()));
 
 // =========================================================================
-// Global Redraw Flag
+// Update Queues
 // =========================================================================
 
-/// Global flag for requesting a redraw without tree rebuild
-static NEEDS_REDRAW: AtomicBool = AtomicBool::new(false);
+/// Redraw flag and incremental updates waiting for one render context
+///
+/// When a stateful element's state changes, it computes new RenderProps (and
+/// possibly new children) and queues them here. The app applies the queued
+/// updates directly to its RenderTree, avoiding a full tree rebuild.
+///
+/// Stateful elements and `ElementHandle`s queue into the queue that was
+/// current when they were created, so several contexts in one process (e.g.
+/// an external display or a widget extension next to the main screen) don't
+/// see each other's updates. The free functions (`request_redraw`,
+/// `queue_prop_update`, ...) use the queue current on the calling thread;
+/// on a thread that never entered one that is the process-wide default
+/// queue, which only a single-context app reads. To update a context from
+/// another thread, capture its queue with [`current_update_queue`] (or use a
+/// handle) and call the methods on it. Apps with a single context never need
+/// to create a queue: the default one is current unless a context has
+/// entered its own with [`UpdateQueue::enter`].
+///
+/// Queueing and draining are lock-free, so a state change on another thread
+/// never blocks the frame that applies it. Updates are coalesced when taken:
+/// only the newest props per node and the newest rebuild per parent survive.
+///
+/// A context whose event loop sleeps while idle (e.g. a paused display link)
+/// installs a waker with [`UpdateQueue::set_waker`]; it is called whenever
+/// work is queued, from whichever thread queued it.
+#[derive(Default)]
+pub struct UpdateQueue {
+    /// A redraw was requested without a tree rebuild
+    needs_redraw: AtomicBool,
+    /// Called after a redraw is requested or a rebuild is queued
+    waker: RwLock<Option<QueueWaker>>,
+    /// Pending render prop updates (node_id, new_props)
+    prop_updates: MpscQueue<(LayoutNodeId, RenderProps)>,
+    /// Pending subtree rebuilds
+    subtree_rebuilds: MpscQueue<PendingSubtreeRebuild>,
+}
 
-/// Request a redraw without rebuilding the tree
+/// Shared handle to an [`UpdateQueue`]
+pub type SharedUpdateQueue = Arc<UpdateQueue>;
+
+/// Callback that wakes the event loop owning an [`UpdateQueue`]
+pub type QueueWaker = Arc<dyn Fn() + Send + Sync>;
+
+/// Queue used when no context has entered its own
+static DEFAULT_UPDATE_QUEUE: LazyLock<SharedUpdateQueue> = LazyLock::new(Default::default);
+
+thread_local! {
+    /// Queue entered on this thread, if any
+    static CURRENT_UPDATE_QUEUE: RefCell<Option<SharedUpdateQueue>> = const { RefCell::new(None) };
+}
+
+/// Run `f` with the queue that is current on this thread
+fn with_current_queue<R>(f: impl FnOnce(&UpdateQueue) -> R) -> R {
+    CURRENT_UPDATE_QUEUE.with(|current| match current.borrow().as_ref() {
+        Some(queue) => f(queue),
+        None => f(&DEFAULT_UPDATE_QUEUE),
+    })
+}
+
+/// Get the queue that is current on this thread
 ///
-/// This is used by stateful elements when state changes cause visual updates
-/// but don't require a tree structure change.
-pub fn request_redraw() {
-    NEEDS_REDRAW.store(true, Ordering::SeqCst);
+/// This is the queue entered by the innermost live [`UpdateQueueScope`], or
+/// the process-wide default queue.
+pub fn current_update_queue() -> SharedUpdateQueue {
+    CURRENT_UPDATE_QUEUE.with(|current| {
+        current
+            .borrow()
+            .clone()
+            .unwrap_or_else(|| DEFAULT_UPDATE_QUEUE.clone())
+    })
 }
 
-/// Check and clear the redraw flag
-/// Returns true if a redraw was requested since last check
-pub fn take_needs_redraw() -> bool {
-    NEEDS_REDRAW.swap(false, Ordering::SeqCst)
+/// Restores the previously current queue when dropped (see [`UpdateQueue::enter`])
+#[must_use = "the queue is only current while the scope is alive"]
+pub struct UpdateQueueScope {
+    previous: Option<SharedUpdateQueue>,
 }
 
-/// Peek at the redraw flag without clearing it
-/// Used by iOS needs_render() to check if stateful updates are pending
-pub fn peek_needs_redraw() -> bool {
-    NEEDS_REDRAW.load(Ordering::SeqCst)
+impl Drop for UpdateQueueScope {
+    fn drop(&mut self) {
+        let previous = self.previous.take();
+        CURRENT_UPDATE_QUEUE.with(|current| *current.borrow_mut() = previous);
+    }
 }
 
-// =========================================================================
-// Pending Prop Updates Queue
-// =========================================================================
+impl UpdateQueue {
+    /// Make this the current queue on this thread until the scope is dropped
+    ///
+    /// Enter the context's queue around everything that builds UI, dispatches
+    /// events or processes the queue: elements created inside the scope
+    /// queue their updates here, and the free functions (`request_redraw`,
+    /// `take_pending_prop_updates`, ...) operate on it.
+    pub fn enter(self: &Arc<Self>) -> UpdateQueueScope {
+        let previous = CURRENT_UPDATE_QUEUE.with(|current| current.replace(Some(self.clone())));
+        UpdateQueueScope { previous }
+    }
 
-/// Queue of pending render prop updates (node_id, new_props)
-///
-/// When a stateful element's state changes, it computes new RenderProps
-/// and queues the update here. The windowed app applies these updates
-/// directly to the RenderTree, avoiding a full tree rebuild.
-static PENDING_PROP_UPDATES: LazyLock<Mutex<Vec<(LayoutNodeId, RenderProps)>>> =
-    LazyLock::new(|| Mutex::new(Vec::new()));
+    /// Call `waker` whenever work is queued, replacing any previous waker
+    ///
+    /// The waker may run on any thread, so it should only signal the event
+    /// loop (e.g. an `IOSWakeProxy`) and return.
+    pub fn set_waker(&self, waker: impl Fn() + Send + Sync + 'static) {
+        *self.waker.write().unwrap() = Some(Arc::new(waker));
+    }
 
-/// Queue of pending subtree rebuilds
-///
-/// Each entry contains the parent node ID and the children to rebuild.
-/// Children are stored as boxed Div elements (the result of the callback).
-static PENDING_SUBTREE_REBUILDS: LazyLock<Mutex<Vec<PendingSubtreeRebuild>>> =
-    LazyLock::new(|| Mutex::new(Vec::new()));
+    /// Remove the waker
+    pub fn clear_waker(&self) {
+        *self.waker.write().unwrap() = None;
+    }
+
+    /// Call the waker, if any, without holding its lock
+    fn wake(&self) {
+        let waker = self.waker.read().unwrap().clone();
+        if let Some(waker) = waker {
+            waker();
+        }
+    }
+
+    /// Request a redraw without rebuilding the tree
+    pub fn request_redraw(&self) {
+        self.needs_redraw.store(true, Ordering::SeqCst);
+        self.wake();
+    }
+
+    /// Check and clear the redraw flag
+    pub fn take_needs_redraw(&self) -> bool {
+        self.needs_redraw.swap(false, Ordering::SeqCst)
+    }
+
+    /// Peek at the redraw flag without clearing it
+    pub fn peek_needs_redraw(&self) -> bool {
+        self.needs_redraw.load(Ordering::SeqCst)
+    }
+
+    /// Queue a render props update for a node and request a redraw
+    pub fn queue_prop_update(&self, node_id: LayoutNodeId, props: RenderProps) {
+        self.prop_updates.push((node_id, props));
+        self.request_redraw();
+    }
+
+    /// Take all pending prop updates
+    ///
+    /// Later updates for a node replace earlier ones, so each node appears
+    /// once, in the order of its latest update.
+    pub fn take_prop_updates(&self) -> Vec<(LayoutNodeId, RenderProps)> {
+        let mut updates = self.prop_updates.take_all();
+        if updates.len() > 1 {
+            let mut seen = HashSet::with_capacity(updates.len());
+            updates.reverse();
+            updates.retain(|(node_id, _)| seen.insert(*node_id));
+            updates.reverse();
+        }
+        updates
+    }
+
+    /// Queue a subtree rebuild for a node
+    ///
+    /// `needs_layout` is false for visual-only updates (hover/press state
+    /// changes) that keep the tree structure.
+    pub fn queue_subtree_rebuild(
+        &self,
+        parent_id: LayoutNodeId,
+        new_child: crate::div::Div,
+        needs_layout: bool,
+    ) {
+        self.subtree_rebuilds.push(PendingSubtreeRebuild {
+            parent_id,
+            new_child,
+            needs_layout,
+        });
+        self.wake();
+    }
+
+    /// Take all pending subtree rebuilds
+    ///
+    /// Only the newest rebuild per parent is kept; it needs layout if any
+    /// of the rebuilds it replaces did.
+    pub fn take_subtree_rebuilds(&self) -> Vec<PendingSubtreeRebuild> {
+        let mut rebuilds = self.subtree_rebuilds.take_all();
+        if rebuilds.len() > 1 {
+            let mut needs_layout: HashMap<LayoutNodeId, bool> = HashMap::new();
+            for rebuild in &rebuilds {
+                *needs_layout.entry(rebuild.parent_id).or_default() |= rebuild.needs_layout;
+            }
+            rebuilds.reverse();
+            rebuilds.retain_mut(|rebuild| match needs_layout.remove(&rebuild.parent_id) {
+                Some(needs_layout) => {
+                    rebuild.needs_layout = needs_layout;
+                    true
+                }
+                None => false,
+            });
+            rebuilds.reverse();
+        }
+        rebuilds
+    }
+
+    /// Put subtree rebuilds back in the queue (for other trees to process)
+    pub fn requeue_subtree_rebuilds(&self, rebuilds: Vec<PendingSubtreeRebuild>) {
+        self.subtree_rebuilds.extend(rebuilds);
+    }
+
+    /// Number of queued subtree rebuilds, without consuming them
+    ///
+    /// Counts rebuilds that will be coalesced when taken.
+    pub fn subtree_rebuild_count(&self) -> usize {
+        self.subtree_rebuilds.len()
+    }
+}
 
 /// A pending subtree rebuild operation
 pub struct PendingSubtreeRebuild {
@@ -332,16 +501,30 @@ pub struct PendingSubtreeRebuild {
 // Safety: PendingSubtreeRebuild is only accessed from the main thread
 unsafe impl Send for PendingSubtreeRebuild {}
 
+/// Request a redraw without rebuilding the tree
+///
+/// This is used by stateful elements when state changes cause visual updates
+/// but don't require a tree structure change. Applies to the current queue
+/// (the default queue on threads that never entered one).
+pub fn request_redraw() {
+    with_current_queue(UpdateQueue::request_redraw);
+}
+
+/// Check and clear the redraw flag of the current queue
+/// Returns true if a redraw was requested since last check
+pub fn take_needs_redraw() -> bool {
+    with_current_queue(UpdateQueue::take_needs_redraw)
+}
+
+/// Peek at the redraw flag of the current queue without clearing it
+/// Used by iOS needs_render() to check if stateful updates are pending
+pub fn peek_needs_redraw() -> bool {
+    with_current_queue(UpdateQueue::peek_needs_redraw)
+}
+
 /// Queue a subtree rebuild for a node (with layout recomputation)
 pub fn queue_subtree_rebuild(parent_id: LayoutNodeId, new_child: crate::div::Div) {
-    PENDING_SUBTREE_REBUILDS
-        .lock()
-        .unwrap()
-        .push(PendingSubtreeRebuild {
-            parent_id,
-            new_child,
-            needs_layout: true,
-        });
+    with_current_queue(|queue| queue.queue_subtree_rebuild(parent_id, new_child, true));
 }
 
 /// Queue a visual-only subtree rebuild (no layout recomputation)
@@ -349,33 +532,31 @@ pub fn queue_subtree_rebuild(parent_id: LayoutNodeId, new_child: crate::div::Div
 /// Used for hover/press state changes where children's visual props change
 /// but the tree structure remains the same.
 pub fn queue_visual_subtree_rebuild(parent_id: LayoutNodeId, new_child: crate::div::Div) {
-    PENDING_SUBTREE_REBUILDS
-        .lock()
-        .unwrap()
-        .push(PendingSubtreeRebuild {
-            parent_id,
-            new_child,
-            needs_layout: false,
-        });
+    with_current_queue(|queue| queue.queue_subtree_rebuild(parent_id, new_child, false));
 }
 
 /// Take all pending subtree rebuilds
 ///
 /// Called by the windowed app to apply incremental child updates to the RenderTree.
 pub fn take_pending_subtree_rebuilds() -> Vec<PendingSubtreeRebuild> {
-    std::mem::take(&mut *PENDING_SUBTREE_REBUILDS.lock().unwrap())
+    with_current_queue(UpdateQueue::take_subtree_rebuilds)
 }
 
 /// Put subtree rebuilds back in the queue (for other trees to process)
 pub fn requeue_subtree_rebuilds(rebuilds: Vec<PendingSubtreeRebuild>) {
-    PENDING_SUBTREE_REBUILDS.lock().unwrap().extend(rebuilds);
+    with_current_queue(|queue| queue.requeue_subtree_rebuilds(rebuilds));
 }
 
 /// Check if there are pending subtree rebuilds without consuming them
 ///
 /// Used to determine if layout recomputation is needed before processing.
 pub fn has_pending_subtree_rebuilds() -> bool {
-    !PENDING_SUBTREE_REBUILDS.lock().unwrap().is_empty()
+    pending_subtree_rebuild_count() > 0
+}
+
+/// Number of queued subtree rebuilds, without consuming them
+pub fn pending_subtree_rebuild_count() -> usize {
+    with_current_queue(UpdateQueue::subtree_rebuild_count)
 }
 
 /// Registry of stateful elements with signal dependencies
@@ -577,19 +758,19 @@ pub fn has_animating_statefuls() -> bool {
 /// Called by the windowed app to apply incremental updates to the RenderTree.
 /// Returns the queued updates and clears the queue.
 pub fn take_pending_prop_updates() -> Vec<(LayoutNodeId, RenderProps)> {
-    std::mem::take(&mut *PENDING_PROP_UPDATES.lock().unwrap())
+    with_current_queue(UpdateQueue::take_prop_updates)
 }
 
 /// Queue a render props update for a node
 ///
-/// Called by stateful elements when their state changes, or by
-/// `ElementHandle::mark_visual_dirty()` for explicit visual updates.
+/// Applies to the current queue (the default queue on threads that never
+/// entered one); off the frame thread, call `UpdateQueue::queue_prop_update`
+/// on a captured queue instead.
 ///
 /// This queues a visual-only update that skips layout recomputation.
 /// Use this for changes to background, opacity, shadows, etc.
 pub fn queue_prop_update(node_id: LayoutNodeId, props: RenderProps) {
-    PENDING_PROP_UPDATES.lock().unwrap().push((node_id, props));
-    request_redraw();
+    with_current_queue(|queue| queue.queue_prop_update(node_id, props));
 }
 
 // =========================================================================
@@ -1058,10 +1239,18 @@ pub struct StatefulInner<S: StateTransitions> {
     /// Animation keys used by this stateful (for animation-driven refresh)
     /// Updated after each callback invocation with keys of active animations.
     pub(crate) animation_keys: Vec<String>,
+
+    /// Queue of the context this element was created in
+    ///
+    /// State changes land here even when they are triggered outside that
+    /// context's scope (signal deps, animation-driven refreshes).
+    pub(crate) update_queue: SharedUpdateQueue,
 }
 
 impl<S: StateTransitions> StatefulInner<S> {
     /// Create a new StatefulInner with the given initial state
+    ///
+    /// The element queues its updates into the current [`UpdateQueue`].
     pub fn new(state: S) -> Self {
         Self {
             state,
@@ -1075,6 +1264,7 @@ impl<S: StateTransitions> StatefulInner<S> {
             current_event: None,
             refresh_callback: None,
             animation_keys: Vec::new(),
+            update_queue: current_update_queue(),
         }
     }
 }
@@ -1397,8 +1587,7 @@ impl<S: StateTransitions> StateContext<S> {
         if let Some(new_state) = inner.state.on_event(event) {
             inner.state = new_state;
             inner.needs_visual_update = true;
-            drop(inner);
-            request_redraw();
+            inner.update_queue.request_redraw();
         }
     }
 
@@ -2239,19 +2428,7 @@ impl<S: StateTransitions> Stateful<S> {
     pub fn new(initial_state: S) -> Self {
         Self {
             inner: RefCell::new(Div::new()),
-            shared_state: Arc::new(Mutex::new(StatefulInner {
-                state: initial_state,
-                state_callback: None,
-                needs_visual_update: false,
-                base_render_props: None,
-                base_style: None,
-                node_id: None,
-                deps: Vec::new(),
-                ancestor_motion_key: None,
-                current_event: None,
-                refresh_callback: None,
-                animation_keys: Vec::new(),
-            })),
+            shared_state: Arc::new(Mutex::new(StatefulInner::new(initial_state))),
             children_cache: RefCell::new(Vec::new()),
             event_handlers_cache: RefCell::new(crate::event_handler::EventHandlers::new()),
             layout_bounds: Arc::new(std::sync::Mutex::new(None)),
@@ -2572,6 +2749,7 @@ impl<S: StateTransitions> Stateful<S> {
         guard.state = new_state;
         guard.needs_visual_update = true;
         guard.current_event = event_context;
+        let queue = guard.update_queue.clone();
 
         // Compute new props via callback and queue the update
         if let Some(ref callback) = guard.state_callback {
@@ -2598,13 +2776,13 @@ impl<S: StateTransitions> Stateful<S> {
 
             // Queue the prop update for this node
             if let Some(nid) = cached_node_id {
-                queue_prop_update(nid, final_props);
+                queue.queue_prop_update(nid, final_props);
 
                 // Queue visual-only subtree update for children's props (bg, border, etc)
                 // This uses a non-destructive update that walks existing children
                 // and updates their render props without removing/rebuilding them
                 if !temp_div.children_builders().is_empty() {
-                    queue_visual_subtree_rebuild(nid, temp_div);
+                    queue.queue_subtree_rebuild(nid, temp_div, false);
                 }
             }
 
@@ -2627,7 +2805,7 @@ impl<S: StateTransitions> Stateful<S> {
         }
 
         // Just request redraw, not rebuild
-        request_redraw();
+        queue.request_redraw();
     }
 
     /// Force re-run of the state callback and queue prop/subtree updates
@@ -2651,11 +2829,12 @@ impl<S: StateTransitions> Stateful<S> {
                     let base = guard.base_render_props.clone();
                     let style = guard.base_style.clone();
                     let refresh_cb = guard.refresh_callback.clone();
-                    drop(guard);
                     (callback, state, nid, base, style, refresh_cb)
                 }
                 _ => return,
             };
+        let queue = guard.update_queue.clone();
+        drop(guard);
 
         // Create temp div with base style to preserve container properties (overflow, etc.)
         // Then apply callback to get state-specific changes
@@ -2673,7 +2852,7 @@ impl<S: StateTransitions> Stateful<S> {
         final_props.merge_from(&callback_props);
 
         // Queue the prop update for this node
-        queue_prop_update(cached_node_id, final_props);
+        queue.queue_prop_update(cached_node_id, final_props);
 
         // Check if children were set OR if layout style changed - if so, queue a subtree rebuild
         // This is necessary because the callback may have modified height, overflow, etc.
@@ -2687,7 +2866,7 @@ impl<S: StateTransitions> Stateful<S> {
         );
 
         if !children.is_empty() || style_changed {
-            queue_subtree_rebuild(cached_node_id, temp_div);
+            queue.queue_subtree_rebuild(cached_node_id, temp_div, true);
         }
 
         // Register for animation-driven refresh if there are active animations
@@ -2701,7 +2880,7 @@ impl<S: StateTransitions> Stateful<S> {
         }
 
         // Request redraw
-        request_redraw();
+        queue.request_redraw();
     }
 
     /// Dispatch a new state
@@ -4271,4 +4450,89 @@ mod tests {
         // State should still be ()
         assert_eq!(elem.state(), ());
     }
+
+    #[test]
+    fn test_update_queues_are_isolated() {
+        let main = SharedUpdateQueue::default();
+        let external = SharedUpdateQueue::default();
+
+        let node = LayoutNodeId::default();
+        let shared: SharedState<ButtonState> = {
+            let _scope = external.enter();
+            request_redraw();
+            queue_prop_update(node, RenderProps::default());
+            Arc::new(Mutex::new(StatefulInner::new(ButtonState::Idle)))
+        };
+        assert!(!main.peek_needs_redraw());
+        assert!(external.take_needs_redraw());
+        assert_eq!(external.take_prop_updates().len(), 1);
+
+        // Queues into the context it was created in, whichever is current
+        let _scope = main.enter();
+        shared.lock().unwrap().node_id = Some(node);
+        shared.lock().unwrap().state_callback = Some(Arc::new(|_: &ButtonState, _: &mut Div| {}));
+        Stateful::<ButtonState>::refresh_props_internal(&shared);
+        assert!(!main.peek_needs_redraw());
+        assert!(take_pending_prop_updates().is_empty());
+        assert!(external.take_needs_redraw());
+        assert_eq!(external.take_prop_updates().len(), 1);
+    }
+
+    #[test]
+    fn test_update_queue_wakes_on_queued_work() {
+        let queue = SharedUpdateQueue::default();
+        let wakes = Arc::new(std::sync::atomic::AtomicUsize::new(0));
+        let counter = Arc::clone(&wakes);
+        queue.set_waker(move || {
+            counter.fetch_add(1, Ordering::SeqCst);
+        });
+
+        // Queued from a thread that never entered the queue
+        let producer = Arc::clone(&queue);
+        std::thread::spawn(move || {
+            producer.queue_prop_update(LayoutNodeId::default(), RenderProps::default());
+            producer.queue_subtree_rebuild(LayoutNodeId::default(), Div::new(), false);
+        })
+        .join()
+        .unwrap();
+        assert_eq!(wakes.load(Ordering::SeqCst), 2);
+
+        queue.clear_waker();
+        queue.request_redraw();
+        assert_eq!(wakes.load(Ordering::SeqCst), 2);
+    }
+
+    #[test]
+    fn test_update_queue_coalesces_per_node() {
+        let queue = UpdateQueue::default();
+        let mut tree = LayoutTree::new();
+        let a = tree.create_node(taffy::Style::default());
+        let b = tree.create_node(taffy::Style::default());
+
+        let props = |opacity: f32| RenderProps {
+            opacity,
+            ..Default::default()
+        };
+        queue.queue_prop_update(a, props(0.1));
+        queue.queue_prop_update(b, props(0.2));
+        queue.queue_prop_update(a, props(0.3));
+
+        let updates = queue.take_prop_updates();
+        let opacities: Vec<_> = updates.iter().map(|(id, p)| (*id, p.opacity)).collect();
+        assert_eq!(opacities, vec![(b, 0.2), (a, 0.3)]);
+        assert!(queue.take_prop_updates().is_empty());
+
+        queue.queue_subtree_rebuild(a, Div::new(), true);
+        queue.queue_subtree_rebuild(b, Div::new(), false);
+        queue.queue_subtree_rebuild(a, Div::new(), false);
+        assert_eq!(queue.subtree_rebuild_count(), 3);
+
+        let rebuilds = queue.take_subtree_rebuilds();
+        let parents: Vec<_> = rebuilds
+            .iter()
+            .map(|r| (r.parent_id, r.needs_layout))
+            .collect();
+        assert_eq!(parents, vec![(b, false), (a, true)]);
+        assert_eq!(queue.subtree_rebuild_count(), 0);
+    }
 }
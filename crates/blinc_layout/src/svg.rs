@@ -268,6 +268,7 @@ impl ElementBuilder for Svg {
             pointer_events_none: false,
             cursor: None,
             layer_effects: Vec::new(),
+            cache_layer: false,
             motion_is_exiting: false,
         }
     }
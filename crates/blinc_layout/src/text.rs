@@ -600,6 +600,7 @@ impl ElementBuilder for Text {
             pointer_events_none: self.pointer_events_none,
             cursor: self.cursor,
             layer_effects: Vec::new(),
+            cache_layer: false,
             motion_is_exiting: false,
         }
     }
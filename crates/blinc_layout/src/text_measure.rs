@@ -146,6 +146,14 @@ pub trait TextMeasurer: Send + Sync {
     fn measure(&self, text: &str, font_size: f32) -> TextMetrics {
         self.measure_with_options(text, font_size, &TextLayoutOptions::new())
     }
+
+    /// Prepare many independent texts that are about to be measured
+    ///
+    /// Measurers that cache shaping can shape the whole batch up front (in
+    /// parallel for large documents) so the per-element measurements that
+    /// follow are cache hits. Only the font selection in `options` matters.
+    /// The default does nothing.
+    fn prepare_batch(&self, _texts: &[&str], _font_size: f32, _options: &TextLayoutOptions) {}
 }
 
 /// A dummy text measurer that uses estimates
@@ -219,10 +227,14 @@ impl TextMeasurer for EstimatedTextMeasurer {
 /// Global text measurer storage
 ///
 /// This allows setting a text measurer that will be used during layout.
+use std::sync::atomic::{AtomicU64, Ordering};
 use std::sync::{Arc, RwLock};
 
 static TEXT_MEASURER: RwLock<Option<Arc<dyn TextMeasurer>>> = RwLock::new(None);
 
+/// Bumped whenever earlier measurements may no longer be valid
+static TEXT_MEASURE_GENERATION: AtomicU64 = AtomicU64::new(0);
+
 /// Set the global text measurer
 ///
 /// Call this at app initialization with a real text measurer
@@ -230,12 +242,28 @@ static TEXT_MEASURER: RwLock<Option<Arc<dyn TextMeasurer>>> = RwLock::new(None);
 pub fn set_text_measurer(measurer: Arc<dyn TextMeasurer>) {
     let mut guard = TEXT_MEASURER.write().unwrap();
     *guard = Some(measurer);
+    invalidate_text_measurements();
 }
 
 /// Clear the global text measurer
 pub fn clear_text_measurer() {
     let mut guard = TEXT_MEASURER.write().unwrap();
     *guard = None;
+    invalidate_text_measurements();
+}
+
+/// Discard text measurements cached by layout trees
+///
+/// Call this after registering fonts: text that fell back to another font
+/// measures differently once its family is available. Trees measure their
+/// text nodes again on their next layout.
+pub fn invalidate_text_measurements() {
+    TEXT_MEASURE_GENERATION.fetch_add(1, Ordering::Relaxed);
+}
+
+/// Counter bumped by `invalidate_text_measurements`
+pub(crate) fn text_measure_generation() -> u64 {
+    TEXT_MEASURE_GENERATION.load(Ordering::Relaxed)
 }
 
 /// Measure text using the global measurer, or fall back to estimation
@@ -261,3 +289,14 @@ pub fn measure_text_with_options(
         EstimatedTextMeasurer.measure_with_options(text, font_size, options)
     }
 }
+
+/// Prepare a batch of texts with the global measurer ahead of measuring them
+///
+/// See `TextMeasurer::prepare_batch`. Widgets that build many text elements
+/// at once (markdown documents, code blocks) call this before building.
+pub fn prepare_text_batch(texts: &[&str], font_size: f32, options: &TextLayoutOptions) {
+    let guard = TEXT_MEASURER.read().unwrap();
+    if let Some(ref measurer) = *guard {
+        measurer.prepare_batch(texts, font_size, options);
+    }
+}
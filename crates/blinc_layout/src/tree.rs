@@ -1,11 +1,13 @@
 //! Layout tree management
 
 use slotmap::{new_key_type, Key, SlotMap};
-use std::collections::HashMap;
+use std::collections::{HashMap, HashSet};
+use std::sync::atomic::{AtomicU64, Ordering};
 use taffy::prelude::*;
+use taffy::Overflow;
 
 use crate::element::ElementBounds;
-use crate::text_measure::{measure_text_with_options, TextLayoutOptions};
+use crate::text_measure::{measure_text_with_options, text_measure_generation, TextLayoutOptions};
 
 new_key_type! {
     pub struct LayoutNodeId;
@@ -52,15 +54,56 @@ impl LayoutNodeId {
     }
 }
 
+/// Maximum number of measurements remembered per text node
+///
+/// Flex layout measures a node with a handful of different constraints
+/// (min-content, max-content, the final width), so a few slots are enough.
+const TEXT_MEASURE_CACHE_SLOTS: usize = 4;
+
+/// Text measurements of one node, keyed by the max width they were taken at
+///
+/// Kept across frames: a text node's content and font never change after
+/// creation (new text means a new node), so entries only go stale when the
+/// node is removed or `invalidate_text_measurements` is called (fonts were
+/// registered).
+#[derive(Default)]
+struct TextMeasureCache {
+    /// (max width bits or `u32::MAX` for unconstrained, measured size)
+    entries: Vec<(u32, Size<f32>)>,
+}
+
+impl TextMeasureCache {
+    fn key(max_width: Option<f32>) -> u32 {
+        max_width.map_or(u32::MAX, f32::to_bits)
+    }
+
+    fn get(&self, max_width: Option<f32>) -> Option<Size<f32>> {
+        let key = Self::key(max_width);
+        self.entries
+            .iter()
+            .find(|(k, _)| *k == key)
+            .map(|(_, size)| *size)
+    }
+
+    fn insert(&mut self, max_width: Option<f32>, size: Size<f32>) {
+        if self.entries.len() == TEXT_MEASURE_CACHE_SLOTS {
+            self.entries.remove(0);
+        }
+        self.entries.push((Self::key(max_width), size));
+    }
+}
+
 /// Measure function for text nodes during Taffy layout
 ///
 /// This is called by Taffy when computing layout for nodes that have
 /// a TextMeasureContext. It measures the text with the actual available
-/// width to get proper multi-line height.
+/// width to get proper multi-line height, reusing earlier measurements of
+/// the same node from `cache`.
 fn text_measure_function(
+    cache: &mut HashMap<NodeId, TextMeasureCache>,
     known_dimensions: Size<Option<f32>>,
     available_space: Size<AvailableSpace>,
-    _node_id: NodeId,
+    node_id: NodeId,
     node_context: Option<&mut TextMeasureContext>,
     _style: &Style,
 ) -> Size<f32> {
@@ -80,57 +123,93 @@ fn text_measure_function(
         return Size::ZERO;
     };
 
-    // Don't measure if wrapping is disabled
-    if !ctx.wrap {
-        // For non-wrapping text, use single-line measurement
-        let mut options = TextLayoutOptions::new();
-        options.font_name = ctx.font_name.clone();
-        options.generic_font = ctx.generic_font;
-        options.font_weight = ctx.font_weight;
-        options.italic = ctx.italic;
-        options.line_height = ctx.line_height;
-        // No max_width for non-wrapping
-
-        let metrics = measure_text_with_options(&ctx.content, ctx.font_size, &options);
-        return Size {
-            width: width.unwrap_or(metrics.width),
-            height: height.unwrap_or(metrics.height),
+    // Non-wrapping text is measured on a single line (no max_width); wrapping
+    // text wraps at the known width, or else the available width
+    let max_width = if ctx.wrap {
+        let available = match available_space.width {
+            AvailableSpace::Definite(w) => Some(w),
+            AvailableSpace::MaxContent => None,
+            AvailableSpace::MinContent => Some(0.0), // Force wrapping at every word
         };
-    }
+        width.or(available)
+    } else {
+        None
+    };
 
-    // Determine available width for wrapping
-    let max_width = match available_space.width {
-        AvailableSpace::Definite(w) => Some(w),
-        AvailableSpace::MaxContent => None,
-        AvailableSpace::MinContent => Some(0.0), // Force wrapping at every word
+    let node_cache = cache.entry(node_id).or_default();
+    let measured = match node_cache.get(max_width) {
+        Some(size) => size,
+        None => {
+            let mut options = TextLayoutOptions::new();
+            options.font_name = ctx.font_name.clone();
+            options.generic_font = ctx.generic_font;
+            options.font_weight = ctx.font_weight;
+            options.italic = ctx.italic;
+            options.line_height = ctx.line_height;
+            options.max_width = max_width;
+
+            let metrics = measure_text_with_options(&ctx.content, ctx.font_size, &options);
+            let size = Size {
+                width: metrics.width,
+                height: metrics.height,
+            };
+            node_cache.insert(max_width, size);
+            size
+        }
     };
 
-    // If we already know the width, use it as max_width
-    let max_width = width.or(max_width);
+    Size {
+        width: width.unwrap_or(measured.width),
+        height: height.unwrap_or(measured.height),
+    }
+}
 
-    // Measure text with wrapping
-    let mut options = TextLayoutOptions::new();
-    options.font_name = ctx.font_name.clone();
-    options.generic_font = ctx.generic_font;
-    options.font_weight = ctx.font_weight;
-    options.italic = ctx.italic;
-    options.line_height = ctx.line_height;
-    options.max_width = max_width;
+/// Source of `LayoutTree::generation` values
+///
+/// Shared by all trees, so a tree that replaces another never repeats a
+/// generation that caches built from the old one were stamped with.
+static GENERATION: AtomicU64 = AtomicU64::new(0);
 
-    let metrics = measure_text_with_options(&ctx.content, ctx.font_size, &options);
+fn next_generation() -> u64 {
+    GENERATION.fetch_add(1, Ordering::Relaxed) + 1
+}
 
-    Size {
-        width: width.unwrap_or(metrics.width),
-        height: height.unwrap_or(metrics.height),
-    }
+/// What `LayoutTree::compute_dirty_layout` did
+#[derive(Clone, Debug, PartialEq)]
+pub enum IncrementalLayout {
+    /// Nothing changed since the last layout
+    Clean,
+    /// Only these layout boundaries (and their subtrees) were laid out again
+    Partial(Vec<LayoutNodeId>),
+    /// A change can affect the root; call `compute_layout` instead
+    Full,
 }
 
 /// Maps between Blinc node IDs and Taffy node IDs
+///
+/// Style and child changes are recorded as dirty nodes, so
+/// `compute_dirty_layout` can lay out just the subtrees they affect. Taffy's
+/// per-node cache keeps everything else from being recomputed.
 pub struct LayoutTree {
     taffy: TaffyTree<TextMeasureContext>,
     node_map: SlotMap<LayoutNodeId, NodeId>,
     /// Reverse mapping from Taffy NodeId to our LayoutNodeId
     reverse_map: HashMap<NodeId, LayoutNodeId>,
+    /// Nodes whose content or children changed since the last layout
+    dirty: HashSet<NodeId>,
+    /// Nodes whose own style changed since the last layout
+    restyled: HashSet<NodeId>,
+    /// Layouts of boundaries laid out on their own, with their position in
+    /// the parent restored (Taffy places a layout root at the origin)
+    boundary_layouts: HashMap<NodeId, Layout>,
+    /// Text measurements per node, kept across layouts
+    text_measure_cache: HashMap<NodeId, TextMeasureCache>,
+    /// `text_measure_generation()` the cached measurements were taken at
+    text_measure_generation: u64,
+    /// Nodes laid out by the last `compute_layout`/`compute_dirty_layout`
+    last_layout_nodes: usize,
+    /// Bumped whenever bounds or the node hierarchy may have changed
+    generation: u64,
 }
 
 impl LayoutTree {
@@ -139,6 +218,13 @@ impl LayoutTree {
             taffy: TaffyTree::new(),
             node_map: SlotMap::with_key(),
             reverse_map: HashMap::new(),
+            dirty: HashSet::new(),
+            restyled: HashSet::new(),
+            boundary_layouts: HashMap::new(),
+            text_measure_cache: HashMap::new(),
+            text_measure_generation: text_measure_generation(),
+            last_layout_nodes: 0,
+            generation: next_generation(),
         }
     }
 
@@ -165,9 +251,34 @@ impl LayoutTree {
     pub fn set_style(&mut self, id: LayoutNodeId, style: Style) {
         if let Some(&taffy_node) = self.node_map.get(id) {
             let _ = self.taffy.set_style(taffy_node, style);
+            self.restyled.insert(taffy_node);
+        }
+    }
+
+    /// Mark a node as needing layout (e.g. after its measured content changed)
+    ///
+    /// Style and child changes made through `LayoutTree` mark nodes
+    /// automatically.
+    pub fn mark_dirty(&mut self, id: LayoutNodeId) {
+        if let Some(&taffy_node) = self.node_map.get(id) {
+            let _ = self.taffy.mark_dirty(taffy_node);
+            self.dirty.insert(taffy_node);
         }
     }
 
+    /// Whether any node changed since the last layout
+    pub fn has_dirty_nodes(&self) -> bool {
+        !self.dirty.is_empty() || !self.restyled.is_empty()
+    }
+
+    /// Nodes laid out by the last `compute_layout` or `compute_dirty_layout`
+    ///
+    /// Counts nodes whose cached layout was invalid, i.e. the ones Taffy
+    /// actually recomputed.
+    pub fn last_layout_node_count(&self) -> usize {
+        self.last_layout_nodes
+    }
+
     /// Get the style for a node
     pub fn get_style(&self, id: LayoutNodeId) -> Option<Style> {
         self.node_map
@@ -182,17 +293,230 @@ impl LayoutTree {
             (self.node_map.get(parent), self.node_map.get(child))
         {
             let _ = self.taffy.add_child(parent_node, child_node);
+            self.dirty.insert(parent_node);
+            self.generation = next_generation();
         }
     }
 
     /// Compute layout for a tree rooted at the given node
     pub fn compute_layout(&mut self, root: LayoutNodeId, available_space: Size<AvailableSpace>) {
         if let Some(&taffy_node) = self.node_map.get(root) {
-            let _ = self.taffy.compute_layout_with_measure(
-                taffy_node,
-                available_space,
-                text_measure_function,
+            self.dirty.clear();
+            self.restyled.clear();
+            self.boundary_layouts.clear();
+            self.discard_stale_text_measurements();
+            self.last_layout_nodes = self.count_invalid(taffy_node);
+            self.run_layout(taffy_node, available_space);
+            self.generation = next_generation();
+        }
+    }
+
+    /// Lay out only the subtrees affected by changes since the last layout
+    ///
+    /// Each dirty node is laid out again from its nearest layout boundary:
+    /// an ancestor (or itself) whose size can't depend on its content, so
+    /// nothing outside it moves. A node whose own style changed may have a
+    /// new size or position, so its boundary is searched from its parent.
+    /// Returns `Full` without doing anything if a
+    /// change can reach the root, e.g. content inside auto-sized containers
+    /// all the way up, or text measurements were invalidated.
+    pub fn compute_dirty_layout(&mut self, root: LayoutNodeId) -> IncrementalLayout {
+        let Some(&root_node) = self.node_map.get(root) else {
+            return IncrementalLayout::Clean;
+        };
+        if self.text_measure_generation != text_measure_generation() {
+            return IncrementalLayout::Full;
+        }
+
+        // Where each change's boundary search starts; None reaches the root
+        let starts: Vec<Option<NodeId>> = self
+            .dirty
+            .iter()
+            .map(|&n| Some(n))
+            .chain(self.restyled.iter().map(|&n| self.taffy.parent(n)))
+            .filter(|start| start.map_or(true, |n| self.reverse_map.contains_key(&n)))
+            .collect();
+        if starts.is_empty() {
+            self.dirty.clear();
+            self.restyled.clear();
+            self.last_layout_nodes = 0;
+            return IncrementalLayout::Clean;
+        }
+
+        let mut boundaries: Vec<NodeId> = Vec::new();
+        for start in starts {
+            let boundary = start.and_then(|node| self.layout_boundary(node, root_node));
+            match boundary {
+                Some(boundary) if !boundaries.contains(&boundary) => boundaries.push(boundary),
+                Some(_) => {}
+                None => return IncrementalLayout::Full,
+            }
+        }
+        // A boundary nested in another is laid out along with it
+        let boundaries: Vec<NodeId> = boundaries
+            .iter()
+            .copied()
+            .filter(|&b| !boundaries.iter().any(|&o| o != b && self.is_ancestor(o, b)))
+            .collect();
+
+        self.dirty.clear();
+        self.restyled.clear();
+        self.last_layout_nodes = 0;
+        self.generation = next_generation();
+        for &boundary in &boundaries {
+            let Ok(previous) = self.layout_of(boundary).copied() else {
+                continue;
+            };
+            // Nested boundaries are laid out again as part of this one, so
+            // their own restored layouts are stale
+            let nested: Vec<NodeId> = self
+                .boundary_layouts
+                .keys()
+                .copied()
+                .filter(|&n| self.is_ancestor(boundary, n))
+                .collect();
+            for node in nested {
+                self.boundary_layouts.remove(&node);
+            }
+            self.last_layout_nodes += self.count_invalid(boundary);
+            self.run_layout(
+                boundary,
+                Size {
+                    width: AvailableSpace::Definite(previous.size.width),
+                    height: AvailableSpace::Definite(previous.size.height),
+                },
             );
+            if let Ok(&layout) = self.taffy.layout(boundary) {
+                self.boundary_layouts.insert(
+                    boundary,
+                    Layout {
+                        location: previous.location,
+                        ..layout
+                    },
+                );
+            }
+        }
+
+        IncrementalLayout::Partial(
+            boundaries
+                .iter()
+                .filter_map(|b| self.reverse_map.get(b).copied())
+                .collect(),
+        )
+    }
+
+    /// Run Taffy from `node` with the cached text measure function
+    fn run_layout(&mut self, node: NodeId, available_space: Size<AvailableSpace>) {
+        let cache = &mut self.text_measure_cache;
+        let _ = self.taffy.compute_layout_with_measure(
+            node,
+            available_space,
+            |known, available, node_id, context, style| {
+                text_measure_function(cache, known, available, node_id, context, style)
+            },
+        );
+    }
+
+    /// Drop cached text measurements taken before the last
+    /// `invalidate_text_measurements`, marking their nodes for layout so
+    /// Taffy measures them again
+    fn discard_stale_text_measurements(&mut self) {
+        let generation = text_measure_generation();
+        if self.text_measure_generation == generation {
+            return;
+        }
+        self.text_measure_generation = generation;
+        for (node, _) in self.text_measure_cache.drain() {
+            let _ = self.taffy.mark_dirty(node);
+        }
+    }
+
+    /// Number of nodes under (and including) `node` with an invalid layout cache
+    fn count_invalid(&self, node: NodeId) -> usize {
+        if !self.taffy.dirty(node).unwrap_or(true) {
+            return 0;
+        }
+        let children = self.taffy.children(node).unwrap_or_default();
+        1 + children
+            .into_iter()
+            .map(|child| self.count_invalid(child))
+            .sum::<usize>()
+    }
+
+    /// Nearest ancestor-or-self of `node` that isolates its subtree's layout
+    ///
+    /// Nodes that have never been laid out (new in this frame) are skipped,
+    /// since there is no previous size to keep. Returns None if the walk
+    /// reaches `root`, which only `compute_layout` lays out.
+    fn layout_boundary(&self, node: NodeId, root: NodeId) -> Option<NodeId> {
+        let mut current = node;
+        while current != root {
+            let laid_out = || {
+                self.layout_of(current)
+                    .is_ok_and(|l| l.size.width > 0.0 || l.size.height > 0.0)
+            };
+            if self.is_layout_boundary(current) && laid_out() {
+                return Some(current);
+            }
+            current = self.taffy.parent(current)?;
+        }
+        None
+    }
+
+    /// Whether a node's size (and so everything outside it) is independent of
+    /// its content
+    ///
+    /// True for nodes with a fixed width and height, unless they are flex
+    /// items their parent may grow, or shrink down to their content's
+    /// minimum size, or grid items (whose track sizing looks at content).
+    fn is_layout_boundary(&self, node: NodeId) -> bool {
+        let Ok(style) = self.taffy.style(node) else {
+            return false;
+        };
+        let fixed_size = matches!(style.size.width, Dimension::Length(_))
+            && matches!(style.size.height, Dimension::Length(_));
+        if !fixed_size || style.display == Display::None {
+            return false;
+        }
+        if style.position == Position::Absolute {
+            return true;
+        }
+
+        let Some(parent) = self.taffy.parent(node) else {
+            return true;
+        };
+        match self.taffy.style(parent).map(|s| s.display) {
+            Ok(Display::Flex) => {
+                // Scroll containers have no content-based minimum size
+                let scroll_container =
+                    |o: Overflow| matches!(o, Overflow::Scroll | Overflow::Hidden);
+                style.flex_grow == 0.0
+                    && (style.flex_shrink == 0.0
+                        || (scroll_container(style.overflow.x)
+                            && scroll_container(style.overflow.y)))
+            }
+            Ok(Display::Grid) => false,
+            _ => true,
+        }
+    }
+
+    /// Whether `ancestor` is a strict ancestor of `node`
+    fn is_ancestor(&self, ancestor: NodeId, node: NodeId) -> bool {
+        let mut current = self.taffy.parent(node);
+        while let Some(parent) = current {
+            if parent == ancestor {
+                return true;
+            }
+            current = self.taffy.parent(parent);
+        }
+        false
+    }
+
+    /// Layout of a Taffy node, preferring a restored boundary layout
+    fn layout_of(&self, node: NodeId) -> taffy::TaffyResult<&Layout> {
+        match self.boundary_layouts.get(&node) {
+            Some(layout) => Ok(layout),
+            None => self.taffy.layout(node),
         }
     }
 
@@ -200,7 +524,7 @@ impl LayoutTree {
     pub fn get_layout(&self, id: LayoutNodeId) -> Option<&Layout> {
         self.node_map
             .get(id)
-            .and_then(|&taffy_node| self.taffy.layout(taffy_node).ok())
+            .and_then(|&taffy_node| self.layout_of(taffy_node).ok())
     }
 
     /// Check if a node exists in this tree
@@ -212,7 +536,15 @@ impl LayoutTree {
     pub fn remove_node(&mut self, id: LayoutNodeId) {
         if let Some(taffy_node) = self.node_map.remove(id) {
             self.reverse_map.remove(&taffy_node);
+            self.dirty.remove(&taffy_node);
+            self.restyled.remove(&taffy_node);
+            self.boundary_layouts.remove(&taffy_node);
+            self.text_measure_cache.remove(&taffy_node);
+            if let Some(parent) = self.taffy.parent(taffy_node) {
+                self.dirty.insert(parent);
+            }
             let _ = self.taffy.remove(taffy_node);
+            self.generation = next_generation();
         }
     }
 
@@ -248,6 +580,16 @@ impl LayoutTree {
             .map(|layout| (layout.content_size.width, layout.content_size.height))
     }
 
+    /// Counter that changes whenever computed bounds or the node hierarchy
+    /// may have changed
+    ///
+    /// Caches derived from layout (such as the hit-test index) compare it to
+    /// the value they were built at. Values are unique across trees, so a
+    /// cache also notices when the tree it was built from was replaced.
+    pub fn generation(&self) -> u64 {
+        self.generation
+    }
+
     /// Get the number of nodes in the tree
     pub fn len(&self) -> usize {
         self.node_map.len()
@@ -314,6 +656,8 @@ impl LayoutTree {
             .collect();
 
         let _ = self.taffy.set_children(parent_taffy, &new_taffy_children);
+        self.dirty.insert(parent_taffy);
+        self.generation = next_generation();
 
         old_children
     }
@@ -324,3 +668,184 @@ impl Default for LayoutTree {
         Self::new()
     }
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn fixed(width: f32, height: f32) -> Style {
+        Style {
+            size: Size {
+                width: Dimension::Length(width),
+                height: Dimension::Length(height),
+            },
+            flex_shrink: 0.0,
+            ..Default::default()
+        }
+    }
+
+    /// root (400x400 column) -> [header (auto x 50), card (100x100) -> inner]
+    fn card_tree() -> (
+        LayoutTree,
+        LayoutNodeId,
+        LayoutNodeId,
+        LayoutNodeId,
+        LayoutNodeId,
+    ) {
+        let mut tree = LayoutTree::new();
+        let root = tree.create_node(Style {
+            flex_direction: FlexDirection::Column,
+            ..fixed(400.0, 400.0)
+        });
+        let header = tree.create_node(Style {
+            size: Size {
+                width: Dimension::Auto,
+                height: Dimension::Length(50.0),
+            },
+            ..Default::default()
+        });
+        let card = tree.create_node(fixed(100.0, 100.0));
+        let inner = tree.create_node(Style::default());
+        tree.add_child(root, header);
+        tree.add_child(root, card);
+        tree.add_child(card, inner);
+        tree.compute_layout(
+            root,
+            Size {
+                width: AvailableSpace::Definite(400.0),
+                height: AvailableSpace::Definite(400.0),
+            },
+        );
+        (tree, root, header, card, inner)
+    }
+
+    #[test]
+    fn test_change_inside_fixed_size_node_relayouts_only_it() {
+        let (mut tree, root, _, card, inner) = card_tree();
+        assert_eq!(tree.compute_dirty_layout(root), IncrementalLayout::Clean);
+
+        tree.set_style(inner, fixed(30.0, 30.0));
+        assert_eq!(
+            tree.compute_dirty_layout(root),
+            IncrementalLayout::Partial(vec![card])
+        );
+        assert_eq!(tree.last_layout_node_count(), 2);
+
+        // The boundary keeps its place in the parent
+        let bounds = tree.get_bounds(card, (0.0, 0.0)).unwrap();
+        assert_eq!((bounds.x, bounds.y), (0.0, 50.0));
+        assert_eq!(tree.get_bounds(inner, (0.0, 0.0)).unwrap().height, 30.0);
+    }
+
+    #[test]
+    fn test_change_in_auto_sized_node_needs_full_layout() {
+        let (mut tree, root, header, _, _) = card_tree();
+
+        tree.set_style(
+            header,
+            Style {
+                size: Size {
+                    width: Dimension::Auto,
+                    height: Dimension::Length(80.0),
+                },
+                ..Default::default()
+            },
+        );
+        assert_eq!(tree.compute_dirty_layout(root), IncrementalLayout::Full);
+    }
+
+    #[test]
+    fn test_resized_boundary_moves_its_siblings() {
+        let (mut tree, root, _, card, _) = card_tree();
+        let footer = tree.create_node(fixed(100.0, 20.0));
+        tree.add_child(root, footer);
+        tree.compute_layout(
+            root,
+            Size {
+                width: AvailableSpace::Definite(400.0),
+                height: AvailableSpace::Definite(400.0),
+            },
+        );
+        assert_eq!(tree.get_bounds(footer, (0.0, 0.0)).unwrap().y, 150.0);
+
+        // The card's own size changed, so it can't isolate the change: its
+        // parent (here the root) has to be laid out again
+        tree.set_style(card, fixed(100.0, 200.0));
+        assert_eq!(tree.compute_dirty_layout(root), IncrementalLayout::Full);
+        tree.compute_layout(
+            root,
+            Size {
+                width: AvailableSpace::Definite(400.0),
+                height: AvailableSpace::Definite(400.0),
+            },
+        );
+        assert_eq!(tree.get_bounds(card, (0.0, 0.0)).unwrap().height, 200.0);
+        assert_eq!(tree.get_bounds(footer, (0.0, 0.0)).unwrap().y, 250.0);
+    }
+
+    #[test]
+    fn test_generation_differs_between_trees() {
+        let (first, ..) = card_tree();
+        let (second, ..) = card_tree();
+        assert_ne!(first.generation(), second.generation());
+        assert_ne!(
+            LayoutTree::new().generation(),
+            LayoutTree::new().generation()
+        );
+    }
+
+    #[test]
+    fn test_outer_boundary_relayout_replaces_nested_boundary_layout() {
+        // root -> panel (200x200 column) -> [spacer (auto x 20), card (100x100) -> inner]
+        let mut tree = LayoutTree::new();
+        let root = tree.create_node(fixed(400.0, 400.0));
+        let panel = tree.create_node(Style {
+            flex_direction: FlexDirection::Column,
+            ..fixed(200.0, 200.0)
+        });
+        let spacer_style = |height| Style {
+            size: Size {
+                width: Dimension::Auto,
+                height: Dimension::Length(height),
+            },
+            flex_shrink: 0.0,
+            ..Default::default()
+        };
+        let spacer = tree.create_node(spacer_style(20.0));
+        let card = tree.create_node(fixed(100.0, 100.0));
+        let inner = tree.create_node(Style::default());
+        tree.add_child(root, panel);
+        tree.add_child(panel, spacer);
+        tree.add_child(panel, card);
+        tree.add_child(card, inner);
+        tree.compute_layout(
+            root,
+            Size {
+                width: AvailableSpace::Definite(400.0),
+                height: AvailableSpace::Definite(400.0),
+            },
+        );
+
+        tree.set_style(inner, fixed(30.0, 30.0));
+        assert_eq!(
+            tree.compute_dirty_layout(root),
+            IncrementalLayout::Partial(vec![card])
+        );
+
+        // Resizing the card lays out the panel around it
+        tree.set_style(card, fixed(100.0, 150.0));
+        assert_eq!(
+            tree.compute_dirty_layout(root),
+            IncrementalLayout::Partial(vec![panel])
+        );
+        assert_eq!(tree.get_bounds(card, (0.0, 0.0)).unwrap().height, 150.0);
+
+        // Moving the card within the panel must not keep its restored layout
+        tree.set_style(spacer, spacer_style(40.0));
+        assert_eq!(
+            tree.compute_dirty_layout(root),
+            IncrementalLayout::Partial(vec![panel])
+        );
+        assert_eq!(tree.get_bounds(card, (0.0, 0.0)).unwrap().y, 40.0);
+    }
+}
@@ -624,6 +624,25 @@ impl Code {
             .padding_y_px(self.config.padding)
             .relative();
 
+        // Shape every span up front (in parallel for long files) so the
+        // per-span measurements below hit the shape cache
+        let span_texts: Vec<&str> = styled
+            .lines
+            .iter()
+            .flat_map(|line| {
+                line.spans
+                    .iter()
+                    .map(move |span| &line.text[span.start..span.end])
+            })
+            .collect();
+        let mut measure_options = crate::text_measure::TextLayoutOptions::new();
+        measure_options.generic_font = crate::div::GenericFont::Monospace;
+        crate::text_measure::prepare_text_batch(
+            &span_texts,
+            self.config.font_size,
+            &measure_options,
+        );
+
         // Render each line with styled spans
         for styled_line in &styled.lines {
             // Don't use overflow_clip on line divs - rely on outer container's clip
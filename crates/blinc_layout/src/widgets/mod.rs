@@ -10,6 +10,7 @@
 //! - [`text_input()`] - Single-line text input with validation
 //! - [`text_area()`] - Multi-line text area
 //! - [`scroll()`] - Scrollable container with bounce physics
+//! - [`virtual_list()`] - Scroll container that only builds the items in view
 //! - [`code()`] - Code block with syntax highlighting and line numbers
 //!
 //! # Example
@@ -44,6 +45,7 @@ pub mod scroll;
 pub mod table;
 pub mod text_area;
 pub mod text_input;
+pub mod virtual_list;
 
 // Re-export button widget
 pub use button::{button, button_with, Button, ButtonConfig, ButtonVisualState};
@@ -94,6 +96,9 @@ pub use scroll::{
     ScrollbarVisibility, SharedScrollPhysics,
 };
 
+// Re-export virtual list widget
+pub use virtual_list::{virtual_list, SharedVirtualList, VirtualList, VirtualListState};
+
 // Re-export cursor widget (canvas-based smooth cursor)
 pub use cursor::{
     cursor_canvas, cursor_canvas_absolute, cursor_state, CursorAnimation, CursorState,
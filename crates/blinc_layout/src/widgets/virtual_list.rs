@@ -0,0 +1,609 @@
+//! Virtualized list and grid element
+//!
+//! `virtual_list()` is a scroll container for long lists. Its content is as
+//! tall as all items together, but only the lines inside the viewport plus an
+//! overscan margin are built. A line is one item, or one row of cells when
+//! the list is laid out as a grid with `columns(n)`. Lines are absolutely
+//! positioned at their offset, so nothing outside the window is ever built
+//! or laid out.
+//!
+//! Every line starts at its estimated size. Once a line has been laid out its
+//! measured size replaces the estimate, so the scroll extent converges to the
+//! real content height. When a line above the viewport turns out to be
+//! taller or shorter than estimated, the scroll offset moves by the
+//! difference so the visible lines stay where they are.
+//!
+//! `RenderTree` reconciles the window after scrolling and after each layout
+//! (see `RenderTree::update_virtual_lists`). Lines that stay in the window
+//! keep their nodes, and the wrapper nodes of lines that left are recycled
+//! for lines that entered. The list state is stored under its
+//! `InstanceKey`, so measured sizes and the scroll position survive full UI
+//! rebuilds. States that no element or tree refers to any more are dropped.
+//!
+//! # Example
+//!
+//! ```rust,ignore
+//! use blinc_layout::prelude::*;
+//!
+//! let messages = load_messages();
+//! let list = virtual_list(
+//!     messages.len(),
+//!     |_| 56.0,
+//!     move |i| div().p(12.0).child(text(&messages[i].body)),
+//! )
+//! .h(600.0)
+//! .overscan(300.0);
+//! ```
+
+use std::collections::{BTreeMap, HashMap};
+use std::ops::Range;
+use std::sync::{Arc, LazyLock, Mutex};
+
+use blinc_core::Brush;
+
+use crate::div::{Div, ElementBuilder, ElementTypeId};
+use crate::element::RenderProps;
+use crate::event_handler::EventHandlers;
+use crate::key::InstanceKey;
+use crate::selector::ScrollRef;
+use crate::tree::{LayoutNodeId, LayoutTree};
+use crate::widgets::scroll::{Scroll, ScrollRenderInfo, SharedScrollPhysics};
+
+/// Extra content built above and below the viewport (logical pixels)
+pub const DEFAULT_OVERSCAN: f32 = 200.0;
+
+/// Measured sizes closer than this to the current size are ignored, so
+/// sub-pixel layout noise never moves lines
+const MEASURE_EPSILON: f32 = 0.5;
+
+/// Builds the element for one item
+pub type ItemBuilder = Arc<dyn Fn(usize) -> Box<dyn ElementBuilder> + Send + Sync>;
+
+/// Estimates the height of one item before it has been laid out
+pub type SizeEstimator = Arc<dyn Fn(usize) -> f32 + Send + Sync>;
+
+/// Shared handle to a list's state, registered with `RenderTree`
+pub type SharedVirtualList = Arc<Mutex<VirtualListState>>;
+
+/// List states by instance key, so they survive full rebuilds
+///
+/// Each live list is also held by its element or the `RenderTree` it was
+/// built into; entries only the map still holds belong to lists that are
+/// gone and are evicted by `shared_state`.
+static LIST_STATES: LazyLock<Mutex<HashMap<String, SharedVirtualList>>> =
+    LazyLock::new(|| Mutex::new(HashMap::new()));
+
+/// A line that currently has nodes in the tree
+#[derive(Clone, Copy, Debug)]
+pub(crate) struct MaterializedLine {
+    /// Absolutely positioned wrapper holding the line's items
+    pub node: LayoutNodeId,
+    /// Offset the wrapper was last positioned at
+    pub top: f32,
+}
+
+/// Item sizes, window and materialized lines of one virtual list
+pub struct VirtualListState {
+    count: usize,
+    columns: usize,
+    overscan: f32,
+    estimate: SizeEstimator,
+    builder: ItemBuilder,
+    /// Measured height of each line (None until it has been laid out)
+    measured: Vec<Option<f32>>,
+    /// Start offset of each line, followed by the total content height
+    offsets: Vec<f32>,
+    /// Lines with nodes in the tree, by line index
+    pub(crate) lines: BTreeMap<usize, MaterializedLine>,
+    physics: SharedScrollPhysics,
+}
+
+impl VirtualListState {
+    fn new(physics: SharedScrollPhysics) -> Self {
+        Self {
+            count: 0,
+            columns: 1,
+            overscan: DEFAULT_OVERSCAN,
+            estimate: Arc::new(|_| 0.0),
+            builder: Arc::new(|_| Box::new(Div::new())),
+            measured: Vec::new(),
+            offsets: vec![0.0],
+            lines: BTreeMap::new(),
+            physics,
+        }
+    }
+
+    /// Replace the items, keeping measurements of lines that still exist
+    fn set_items(&mut self, count: usize, estimate: SizeEstimator, builder: ItemBuilder) {
+        self.count = count;
+        self.estimate = estimate;
+        self.builder = builder;
+        self.measured.resize(self.line_count(), None);
+        self.recompute_offsets();
+    }
+
+    fn set_columns(&mut self, columns: usize) {
+        let columns = columns.max(1);
+        if columns != self.columns {
+            self.columns = columns;
+            // Line heights depend on which items share a line
+            self.measured = vec![None; self.line_count()];
+            self.recompute_offsets();
+        }
+    }
+
+    /// Number of items
+    pub fn count(&self) -> usize {
+        self.count
+    }
+
+    /// Number of lines (items, or rows of cells for grids)
+    pub fn line_count(&self) -> usize {
+        self.count.div_ceil(self.columns)
+    }
+
+    /// Total content height, measured where known and estimated elsewhere
+    pub fn content_height(&self) -> f32 {
+        self.offsets.last().copied().unwrap_or(0.0)
+    }
+
+    /// Offset of a line from the top of the content
+    pub fn line_offset(&self, line: usize) -> f32 {
+        self.offsets[line.min(self.line_count())]
+    }
+
+    /// Current height of a line: measured if laid out, else the tallest
+    /// estimate of its items
+    fn line_height(&self, line: usize) -> f32 {
+        if let Some(height) = self.measured[line] {
+            return height;
+        }
+        let start = line * self.columns;
+        let end = (start + self.columns).min(self.count);
+        (start..end)
+            .map(|i| (self.estimate)(i).max(0.0))
+            .fold(0.0, f32::max)
+    }
+
+    fn recompute_offsets(&mut self) {
+        let lines = self.line_count();
+        let mut offsets = Vec::with_capacity(lines + 1);
+        let mut y = 0.0;
+        offsets.push(y);
+        for line in 0..lines {
+            y += self.line_height(line);
+            offsets.push(y);
+        }
+        self.offsets = offsets;
+    }
+
+    /// Lines intersecting `[top - overscan, top + height + overscan)`
+    pub fn lines_in_range(&self, top: f32, height: f32) -> Range<usize> {
+        let lines = self.line_count();
+        let start = top - self.overscan;
+        let end = top + height + self.overscan;
+        // First line ending after `start`, first line starting at or after `end`
+        let first = self.offsets[1..].partition_point(|&line_end| line_end <= start);
+        let last = self.offsets[..lines].partition_point(|&line_start| line_start < end);
+        first..last.max(first)
+    }
+
+    /// Lines that should be materialized at the current scroll position
+    pub(crate) fn window(&self) -> Range<usize> {
+        let (top, height) = {
+            let physics = self.physics.lock().unwrap();
+            ((-physics.offset_y).max(0.0), physics.viewport_height)
+        };
+        self.lines_in_range(top, height)
+    }
+
+    /// Whether the materialized lines differ from the current window
+    pub(crate) fn needs_update(&self) -> bool {
+        let window = self.window();
+        let materialized = match (self.lines.keys().next(), self.lines.keys().next_back()) {
+            (Some(&first), Some(&last)) => first..last + 1,
+            _ => 0..0,
+        };
+        if window.is_empty() {
+            !materialized.is_empty()
+        } else {
+            window != materialized
+        }
+    }
+
+    /// Replace line heights with measured ones
+    ///
+    /// Lines that end above the viewport also move the scroll offset by the
+    /// change, so the lines on screen don't jump. Returns whether any line
+    /// changed size.
+    pub(crate) fn record_measurements(&mut self, heights: &[(usize, f32)]) -> bool {
+        let mut physics = self.physics.lock().unwrap();
+        let top = (-physics.offset_y).max(0.0);
+
+        let mut changed = false;
+        let mut shift = 0.0;
+        for &(line, height) in heights {
+            if line >= self.measured.len() {
+                continue;
+            }
+            let previous = self.line_height(line);
+            if self.measured[line].is_some() && (previous - height).abs() < MEASURE_EPSILON {
+                continue;
+            }
+            self.measured[line] = Some(height);
+            if (previous - height).abs() < MEASURE_EPSILON {
+                continue;
+            }
+            if self.offsets[line + 1] <= top {
+                shift += height - previous;
+            }
+            changed = true;
+        }
+
+        if changed {
+            self.recompute_offsets();
+            if shift != 0.0 {
+                // offset_y is negative when scrolled down
+                physics.offset_y -= shift;
+                physics.content_height = self.content_height();
+            }
+        }
+        changed
+    }
+
+    /// The content container, sized to the whole list
+    fn content(&self) -> Div {
+        Div::new()
+            .relative()
+            .w_full()
+            .h(self.content_height())
+            .flex_shrink_0()
+    }
+
+    /// Wrapper holding the items of one line, positioned at its offset
+    pub(crate) fn build_line(&self, line: usize) -> Div {
+        let wrapper = Div::new()
+            .absolute()
+            .left(0.0)
+            .right(0.0)
+            .top(self.line_offset(line));
+
+        let start = line * self.columns;
+        if self.columns == 1 {
+            return wrapper.flex_col().child_box((self.builder)(start));
+        }
+
+        let end = (start + self.columns).min(self.count);
+        let mut wrapper = wrapper.flex_row();
+        for i in start..start + self.columns {
+            let cell = Div::new().flex_1().flex_col();
+            // Empty cells keep the last line's columns aligned
+            wrapper = wrapper.child(if i < end {
+                cell.child_box((self.builder)(i))
+            } else {
+                cell
+            });
+        }
+        wrapper
+    }
+}
+
+/// Get or create the persisted state for a list key
+///
+/// Also drops the states of lists that no longer exist.
+fn shared_state(key: &str) -> SharedVirtualList {
+    let mut states = LIST_STATES.lock().unwrap();
+    states.retain(|k, state| k == key || Arc::strong_count(state) > 1);
+    Arc::clone(states.entry(key.to_string()).or_insert_with(|| {
+        let physics = Arc::new(Mutex::new(Default::default()));
+        Arc::new(Mutex::new(VirtualListState::new(physics)))
+    }))
+}
+
+/// Content element of a virtual list
+///
+/// Builds only the full-height container; `RenderTree` materializes lines
+/// into it.
+struct VirtualListContent {
+    inner: Div,
+    state: SharedVirtualList,
+}
+
+impl ElementBuilder for VirtualListContent {
+    fn build(&self, tree: &mut LayoutTree) -> LayoutNodeId {
+        self.inner.build(tree)
+    }
+
+    fn render_props(&self) -> RenderProps {
+        self.inner.render_props()
+    }
+
+    fn children_builders(&self) -> &[Box<dyn ElementBuilder>] {
+        &[]
+    }
+
+    fn element_type_id(&self) -> ElementTypeId {
+        ElementTypeId::Div
+    }
+
+    fn layout_style(&self) -> Option<&taffy::Style> {
+        self.inner.layout_style()
+    }
+
+    fn virtual_list(&self) -> Option<SharedVirtualList> {
+        Some(Arc::clone(&self.state))
+    }
+}
+
+/// A scroll container that only builds the lines in view
+pub struct VirtualList {
+    scroll: Scroll,
+    state: SharedVirtualList,
+}
+
+impl VirtualList {
+    /// Create a list of `count` items
+    ///
+    /// `estimate` gives an item's height before it has been laid out and
+    /// `builder` builds the item at an index.
+    #[track_caller]
+    pub fn new<E, S, F>(count: usize, estimate: S, builder: F) -> Self
+    where
+        E: ElementBuilder + 'static,
+        S: Fn(usize) -> f32 + Send + Sync + 'static,
+        F: Fn(usize) -> E + Send + Sync + 'static,
+    {
+        let key = InstanceKey::new("virtual_list");
+        let state = shared_state(key.get());
+        let physics = {
+            let mut list = state.lock().unwrap();
+            list.set_items(
+                count,
+                Arc::new(estimate),
+                Arc::new(move |i| Box::new(builder(i)) as Box<dyn ElementBuilder>),
+            );
+            Arc::clone(&list.physics)
+        };
+
+        let mut list = Self {
+            scroll: Scroll::with_physics(physics),
+            state,
+        };
+        list.update_content();
+        list
+    }
+
+    /// Rebuild the scroll content for the current list settings
+    fn update_content(&mut self) {
+        let inner = self.state.lock().unwrap().content();
+        let content = VirtualListContent {
+            inner,
+            state: Arc::clone(&self.state),
+        };
+        self.scroll = std::mem::take(&mut self.scroll).content(content);
+    }
+
+    /// Lay items out as a grid with this many equal-width columns
+    pub fn columns(mut self, columns: usize) -> Self {
+        self.state.lock().unwrap().set_columns(columns);
+        self.update_content();
+        self
+    }
+
+    /// Content built beyond each edge of the viewport (default
+    /// [`DEFAULT_OVERSCAN`])
+    pub fn overscan(self, px: f32) -> Self {
+        self.state.lock().unwrap().overscan = px.max(0.0);
+        self
+    }
+
+    /// Get the shared list state
+    pub fn state(&self) -> SharedVirtualList {
+        Arc::clone(&self.state)
+    }
+
+    /// Get the shared physics handle
+    pub fn physics(&self) -> SharedScrollPhysics {
+        self.scroll.physics()
+    }
+
+    /// Configure the underlying scroll container
+    pub fn scroll(mut self, f: impl FnOnce(Scroll) -> Scroll) -> Self {
+        self.scroll = f(std::mem::take(&mut self.scroll));
+        self
+    }
+
+    pub fn id(self, id: impl Into<String>) -> Self {
+        self.scroll(|s| s.id(id))
+    }
+
+    pub fn w(self, px: f32) -> Self {
+        self.scroll(|s| s.w(px))
+    }
+
+    pub fn h(self, px: f32) -> Self {
+        self.scroll(|s| s.h(px))
+    }
+
+    pub fn size(self, w: f32, h: f32) -> Self {
+        self.scroll(|s| s.size(w, h))
+    }
+
+    pub fn w_full(self) -> Self {
+        self.scroll(|s| s.w_full())
+    }
+
+    pub fn h_full(self) -> Self {
+        self.scroll(|s| s.h_full())
+    }
+
+    pub fn flex_grow(self) -> Self {
+        self.scroll(|s| s.flex_grow())
+    }
+
+    pub fn bg(self, color: impl Into<Brush>) -> Self {
+        self.scroll(|s| s.bg(color))
+    }
+
+    pub fn rounded(self, radius: f32) -> Self {
+        self.scroll(|s| s.rounded(radius))
+    }
+}
+
+impl ElementBuilder for VirtualList {
+    fn build(&self, tree: &mut LayoutTree) -> LayoutNodeId {
+        self.scroll.build(tree)
+    }
+
+    fn render_props(&self) -> RenderProps {
+        self.scroll.render_props()
+    }
+
+    fn children_builders(&self) -> &[Box<dyn ElementBuilder>] {
+        self.scroll.children_builders()
+    }
+
+    fn element_type_id(&self) -> ElementTypeId {
+        self.scroll.element_type_id()
+    }
+
+    fn event_handlers(&self) -> Option<&EventHandlers> {
+        self.scroll.event_handlers()
+    }
+
+    fn scroll_info(&self) -> Option<ScrollRenderInfo> {
+        self.scroll.scroll_info()
+    }
+
+    fn scroll_physics(&self) -> Option<SharedScrollPhysics> {
+        self.scroll.scroll_physics()
+    }
+
+    fn layout_style(&self) -> Option<&taffy::Style> {
+        self.scroll.layout_style()
+    }
+
+    fn element_id(&self) -> Option<&str> {
+        self.scroll.element_id()
+    }
+
+    fn bound_scroll_ref(&self) -> Option<&ScrollRef> {
+        self.scroll.bound_scroll_ref()
+    }
+}
+
+/// Create a virtualized list of `count` items
+///
+/// Only items in view (plus [`VirtualList::overscan`]) are built. `estimate`
+/// gives an item's height until it has been laid out; `builder` builds the
+/// item at an index.
+///
+/// # Example
+///
+/// ```rust,ignore
+/// use blinc_layout::prelude::*;
+///
+/// virtual_list(10_000, |_| 32.0, |i| text(format!("Row {i}")))
+///     .h(480.0)
+///     .columns(4)
+/// ```
+#[track_caller]
+pub fn virtual_list<E, S, F>(count: usize, estimate: S, builder: F) -> VirtualList
+where
+    E: ElementBuilder + 'static,
+    S: Fn(usize) -> f32 + Send + Sync + 'static,
+    F: Fn(usize) -> E + Send + Sync + 'static,
+{
+    VirtualList::new(count, estimate, builder)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn list(count: usize, estimate: f32, viewport: f32) -> VirtualListState {
+        let physics: SharedScrollPhysics = Arc::new(Mutex::new(Default::default()));
+        physics.lock().unwrap().viewport_height = viewport;
+        let mut state = VirtualListState::new(physics);
+        state.overscan = 0.0;
+        state.set_items(
+            count,
+            Arc::new(move |_| estimate),
+            Arc::new(|_| Box::new(Div::new())),
+        );
+        state
+    }
+
+    #[test]
+    fn test_window_covers_viewport_and_overscan() {
+        let mut state = list(1000, 20.0, 100.0);
+        assert_eq!(state.content_height(), 20_000.0);
+        assert_eq!(state.lines_in_range(0.0, 100.0), 0..5);
+        assert_eq!(state.lines_in_range(210.0, 100.0), 10..16);
+
+        state.overscan = 40.0;
+        assert_eq!(state.lines_in_range(210.0, 100.0), 8..18);
+        // Past the end
+        assert_eq!(state.lines_in_range(19_990.0, 100.0), 999..1000);
+    }
+
+    #[test]
+    fn test_grid_lines() {
+        let mut state = list(10, 20.0, 100.0);
+        state.set_columns(4);
+        assert_eq!(state.line_count(), 3);
+        assert_eq!(state.content_height(), 60.0);
+    }
+
+    #[test]
+    fn test_measurements_replace_estimates() {
+        let mut state = list(100, 20.0, 100.0);
+        assert!(state.record_measurements(&[(0, 50.0), (1, 20.0)]));
+        assert_eq!(state.line_offset(1), 50.0);
+        assert_eq!(state.content_height(), 2030.0);
+        // Same sizes again change nothing
+        assert!(!state.record_measurements(&[(0, 50.0), (1, 20.0)]));
+    }
+
+    #[test]
+    fn test_measurement_above_viewport_keeps_visible_lines_in_place() {
+        let mut state = list(100, 20.0, 100.0);
+        state.physics.lock().unwrap().offset_y = -200.0;
+        let visible = state.line_offset(10) + state.physics.lock().unwrap().offset_y;
+
+        state.record_measurements(&[(2, 35.0), (10, 60.0)]);
+
+        let offset_y = state.physics.lock().unwrap().offset_y;
+        assert_eq!(offset_y, -215.0);
+        assert_eq!(state.line_offset(10) + offset_y, visible);
+    }
+
+    #[test]
+    fn test_needs_update_tracks_window() {
+        let mut state = list(100, 20.0, 100.0);
+        assert!(state.needs_update());
+
+        let node = LayoutNodeId::default();
+        for line in state.window() {
+            state
+                .lines
+                .insert(line, MaterializedLine { node, top: 0.0 });
+        }
+        assert!(!state.needs_update());
+
+        state.physics.lock().unwrap().offset_y = -100.0;
+        assert!(state.needs_update());
+    }
+
+    #[test]
+    fn test_unused_states_are_evicted() {
+        let kept = shared_state("test_evict_kept");
+        drop(shared_state("test_evict_dropped"));
+
+        shared_state("test_evict_other");
+        let states = LIST_STATES.lock().unwrap();
+        assert!(states.contains_key("test_evict_kept"));
+        assert!(!states.contains_key("test_evict_dropped"));
+        drop(kept);
+    }
+}
@@ -4,6 +4,7 @@
 //! - Event recording for user interactions
 //! - Tree snapshot capture for debugging UI state
 //! - Session management with start/pause/stop lifecycle
+//! - Profiling replay of recordings with Chrome trace output
 //!
 //! # Quick Start
 //!
@@ -38,7 +39,8 @@ pub use capture::{
     TreeDiff, TreeSnapshot, VisualProps, WindowResizeEvent,
 };
 pub use replay::{
-    EventSimulator, FrameUpdate, ReplayConfig, ReplayPlayer, ReplayState, SimulatedInput,
+    EventSimulator, FrameStage, FrameUpdate, ProfileConfig, ProfileReplay, ProfileTrace,
+    ProfiledFrame, ProfiledInput, ReplayConfig, ReplayPlayer, ReplayState, SimulatedInput,
     VirtualClock,
 };
 pub use server::{
@@ -4,6 +4,7 @@
 //! - `VirtualClock` - Deterministic time control for replay
 //! - `EventSimulator` - Inject recorded events into the UI
 //! - `ReplayPlayer` - Play back recorded sessions with time control
+//! - `ProfileReplay` - Time a recording through the real frame pipeline
 //!
 //! # Example
 //!
@@ -28,8 +29,12 @@
 
 mod clock;
 mod player;
+mod profile;
 mod simulator;
 
 pub use clock::VirtualClock;
 pub use player::{FrameUpdate, ReplayConfig, ReplayPlayer, ReplayState};
+pub use profile::{
+    FrameStage, ProfileConfig, ProfileReplay, ProfileTrace, ProfiledFrame, ProfiledInput,
+};
 pub use simulator::{EventSimulator, SimulatedInput};
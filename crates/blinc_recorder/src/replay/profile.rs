@@ -0,0 +1,513 @@
+//! Profiling replay of recorded sessions.
+//!
+//! `ProfileReplay` steps a recording through the real frame pipeline one
+//! frame at a time and collects how long each frame took, so a field
+//! recording can be replayed on a device or headless to reproduce its
+//! performance. Frames are placed on the recording's timeline, and the
+//! resulting `ProfileTrace` exports as Chrome trace JSON (loadable in
+//! `chrome://tracing` and Perfetto), where slow frames line up with the
+//! inputs the user made when they saw the jank.
+//!
+//! The frame pipeline itself lives outside this crate: the caller applies the
+//! frame's inputs, builds and renders, and reports the stage timings.
+//!
+//! # Example
+//!
+//! ```ignore
+//! let mut replay = ProfileReplay::new(export, ProfileConfig::accelerated(4.0));
+//! while let Some(update) = replay.next_frame() {
+//!     for input in &update.events {
+//!         // Dispatch input...
+//!     }
+//!     // Build, lay out and render, timing each stage...
+//!     replay.finish_frame(vec![FrameStage::new("build", build_time)]);
+//! }
+//! std::fs::write("replay.trace.json", replay.trace().to_chrome_trace())?;
+//! ```
+
+use std::fmt::Write as _;
+use std::time::{Duration, Instant};
+
+use super::{FrameUpdate, ReplayConfig, ReplayPlayer};
+use crate::{RecordedEvent, RecordingExport, Timestamp};
+
+/// Configuration for a profiling replay.
+#[derive(Clone, Debug)]
+pub struct ProfileConfig {
+    /// Recording time covered by each replayed frame, as a multiple of
+    /// `frame_budget_us` (1.0 = original timing, 4.0 = 4x faster).
+    pub speed: f64,
+    /// Sleep so frames start every `frame_budget_us` of wall time, like a
+    /// display link would. Leave off when a display link already paces
+    /// frames, or to replay as fast as the pipeline allows.
+    pub paced: bool,
+    /// Frame interval of the original session (microseconds).
+    pub frame_budget_us: u64,
+}
+
+impl Default for ProfileConfig {
+    fn default() -> Self {
+        Self {
+            speed: 1.0,
+            paced: true,
+            frame_budget_us: 16_667, // ~60fps
+        }
+    }
+}
+
+impl ProfileConfig {
+    /// Replay at the original timing.
+    pub fn original() -> Self {
+        Self::default()
+    }
+
+    /// Replay `speed` times faster than the original, unpaced.
+    pub fn accelerated(speed: f64) -> Self {
+        Self {
+            speed: speed.max(0.1),
+            paced: false,
+            ..Self::default()
+        }
+    }
+
+    /// Set the original frame interval.
+    pub fn with_frame_budget_us(mut self, frame_budget_us: u64) -> Self {
+        self.frame_budget_us = frame_budget_us.max(1);
+        self
+    }
+
+    /// Enable or disable pacing.
+    pub fn with_paced(mut self, paced: bool) -> Self {
+        self.paced = paced;
+        self
+    }
+
+    /// Recording time advanced per replayed frame.
+    fn step_us(&self) -> u64 {
+        ((self.frame_budget_us as f64) * self.speed)
+            .round()
+            .max(1.0) as u64
+    }
+}
+
+/// Time spent in one stage of a frame.
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub struct FrameStage {
+    /// Stage name shown in the trace ("build", "layout", "encode", ...).
+    pub name: &'static str,
+    /// Time spent in the stage.
+    pub duration: Duration,
+}
+
+impl FrameStage {
+    pub fn new(name: &'static str, duration: Duration) -> Self {
+        Self { name, duration }
+    }
+}
+
+/// A recorded input delivered during a profiled frame.
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub struct ProfiledInput {
+    /// When the user made the input.
+    pub timestamp: Timestamp,
+    /// Event kind ("MouseDown", "Scroll", ...).
+    pub name: &'static str,
+}
+
+/// Timings of one replayed frame.
+#[derive(Clone, Debug, PartialEq)]
+pub struct ProfiledFrame {
+    /// Sequence number (starts at 0).
+    pub index: u32,
+    /// Recording time at the start of the frame.
+    pub recording_time: Timestamp,
+    /// Inputs applied in this frame.
+    pub inputs: Vec<ProfiledInput>,
+    /// Stage timings, in pipeline order.
+    pub stages: Vec<FrameStage>,
+}
+
+impl ProfiledFrame {
+    /// Sum of all stages.
+    pub fn total(&self) -> Duration {
+        self.stages.iter().map(|s| s.duration).sum()
+    }
+}
+
+/// Per-frame timings collected by `ProfileReplay`.
+#[derive(Clone, Debug, Default, PartialEq)]
+pub struct ProfileTrace {
+    /// Frame interval frames are judged against (microseconds).
+    pub frame_budget_us: u64,
+    /// Frames in replay order.
+    pub frames: Vec<ProfiledFrame>,
+}
+
+impl ProfileTrace {
+    /// Whether `frame` missed the frame budget.
+    pub fn is_jank(&self, frame: &ProfiledFrame) -> bool {
+        frame.total() > Duration::from_micros(self.frame_budget_us)
+    }
+
+    /// Frames that missed the frame budget.
+    pub fn jank_frames(&self) -> impl Iterator<Item = &ProfiledFrame> {
+        self.frames.iter().filter(move |f| self.is_jank(f))
+    }
+
+    /// Export as Chrome trace event JSON.
+    ///
+    /// Frames and their stages are complete ("X") events on a "Frames"
+    /// track, starting at the frame's recording time; a frame that overruns
+    /// into the next one pushes it later. Inputs are instant events on an
+    /// "Input" track at the moment they were recorded, and each janky frame
+    /// gets a global "Jank" marker at its recording time.
+    pub fn to_chrome_trace(&self) -> String {
+        const PID: u32 = 1;
+        const FRAME_TID: u32 = 1;
+        const INPUT_TID: u32 = 2;
+
+        let mut events = Vec::new();
+        events.push(format!(
+            r#"{{"name":"process_name","ph":"M","pid":{},"args":{{"name":"Blinc replay"}}}}"#,
+            PID
+        ));
+        for (tid, name) in [(FRAME_TID, "Frames"), (INPUT_TID, "Input")] {
+            events.push(format!(
+                r#"{{"name":"thread_name","ph":"M","pid":{},"tid":{},"args":{{"name":"{}"}}}}"#,
+                PID, tid, name
+            ));
+        }
+
+        let mut track_end = 0.0f64;
+        for frame in &self.frames {
+            let recording_us = frame.recording_time.as_micros() as f64;
+            let start = recording_us.max(track_end);
+            let total = micros(frame.total());
+            let jank = self.is_jank(frame);
+            events.push(format!(
+                r#"{{"name":"Frame {}","cat":"frame","ph":"X","pid":{},"tid":{},"ts":{:.3},"dur":{:.3},"args":{{"recording_ms":{:.3},"inputs":{},"jank":{}}}}}"#,
+                frame.index,
+                PID,
+                FRAME_TID,
+                start,
+                total,
+                recording_us / 1000.0,
+                frame.inputs.len(),
+                jank
+            ));
+
+            let mut stage_start = start;
+            for stage in &frame.stages {
+                let dur = micros(stage.duration);
+                events.push(format!(
+                    r#"{{"name":"{}","cat":"stage","ph":"X","pid":{},"tid":{},"ts":{:.3},"dur":{:.3}}}"#,
+                    escape(stage.name),
+                    PID,
+                    FRAME_TID,
+                    stage_start,
+                    dur
+                ));
+                stage_start += dur;
+            }
+            track_end = start + total;
+
+            for input in &frame.inputs {
+                events.push(format!(
+                    r#"{{"name":"{}","cat":"input","ph":"i","s":"t","pid":{},"tid":{},"ts":{}}}"#,
+                    escape(input.name),
+                    PID,
+                    INPUT_TID,
+                    input.timestamp.as_micros()
+                ));
+            }
+
+            if jank {
+                events.push(format!(
+                    r#"{{"name":"Jank","cat":"jank","ph":"i","s":"g","pid":{},"tid":{},"ts":{:.3},"args":{{"frame":{},"frame_ms":{:.3},"budget_ms":{:.3}}}}}"#,
+                    PID,
+                    FRAME_TID,
+                    recording_us,
+                    frame.index,
+                    total / 1000.0,
+                    self.frame_budget_us as f64 / 1000.0
+                ));
+            }
+        }
+
+        let mut json = String::from(r#"{"displayTimeUnit":"ms","traceEvents":["#);
+        for (i, event) in events.iter().enumerate() {
+            if i > 0 {
+                json.push(',');
+            }
+            json.push('\n');
+            json.push_str(event);
+        }
+        json.push_str("\n]}\n");
+        json
+    }
+}
+
+fn micros(duration: Duration) -> f64 {
+    duration.as_secs_f64() * 1_000_000.0
+}
+
+/// Escape a string for a JSON string literal.
+fn escape(s: &str) -> String {
+    let mut out = String::with_capacity(s.len());
+    for c in s.chars() {
+        match c {
+            '"' => out.push_str("\\\""),
+            '\\' => out.push_str("\\\\"),
+            c if (c as u32) < 0x20 => {
+                let _ = write!(out, "\\u{:04x}", c as u32);
+            }
+            c => out.push(c),
+        }
+    }
+    out
+}
+
+/// Variant name of a recorded event, for trace labels.
+fn event_name(event: &RecordedEvent) -> &'static str {
+    match event {
+        RecordedEvent::MouseDown(_) => "MouseDown",
+        RecordedEvent::MouseUp(_) => "MouseUp",
+        RecordedEvent::MouseMove(_) => "MouseMove",
+        RecordedEvent::Click(_) => "Click",
+        RecordedEvent::DoubleClick(_) => "DoubleClick",
+        RecordedEvent::KeyDown(_) => "KeyDown",
+        RecordedEvent::KeyUp(_) => "KeyUp",
+        RecordedEvent::TextInput(_) => "TextInput",
+        RecordedEvent::Scroll(_) => "Scroll",
+        RecordedEvent::FocusChange(_) => "FocusChange",
+        RecordedEvent::HoverEnter(_) => "HoverEnter",
+        RecordedEvent::HoverLeave(_) => "HoverLeave",
+        RecordedEvent::WindowResize(_) => "WindowResize",
+        RecordedEvent::WindowFocus(_) => "WindowFocus",
+        RecordedEvent::Custom(_) => "Custom",
+    }
+}
+
+/// Drives a recording through a frame pipeline and collects frame timings.
+pub struct ProfileReplay {
+    player: ReplayPlayer,
+    config: ProfileConfig,
+    trace: ProfileTrace,
+    /// Frame handed out by `next_frame` and not yet finished.
+    pending: Option<ProfiledFrame>,
+    /// Wall-clock start of the replay, for pacing.
+    started: Option<Instant>,
+}
+
+impl ProfileReplay {
+    /// Create a profiling replay of `export`.
+    pub fn new(export: RecordingExport, config: ProfileConfig) -> Self {
+        let replay_config = ReplayConfig {
+            frame_duration_us: config.step_us(),
+            ..ReplayConfig::testing()
+        };
+        Self {
+            player: ReplayPlayer::new(export, replay_config),
+            trace: ProfileTrace {
+                frame_budget_us: config.frame_budget_us,
+                frames: Vec::new(),
+            },
+            config,
+            pending: None,
+            started: None,
+        }
+    }
+
+    /// Get the configuration.
+    pub fn config(&self) -> &ProfileConfig {
+        &self.config
+    }
+
+    /// Check if the whole recording has been replayed.
+    pub fn is_finished(&self) -> bool {
+        self.player.position() >= self.player.duration() && self.started.is_some()
+    }
+
+    /// Advance to the next frame and return its inputs.
+    ///
+    /// Returns `None` once the recording is exhausted. When pacing is
+    /// enabled this sleeps until the frame is due. Report the frame's
+    /// timings with `finish_frame` before asking for the next one; a frame
+    /// that is never finished is recorded without stages.
+    pub fn next_frame(&mut self) -> Option<FrameUpdate> {
+        if let Some(frame) = self.pending.take() {
+            self.trace.frames.push(frame);
+        }
+        if self.is_finished() {
+            return None;
+        }
+
+        let index = self.trace.frames.len() as u32;
+        let started = *self.started.get_or_insert_with(Instant::now);
+        if self.config.paced {
+            let due = started + Duration::from_micros(self.config.frame_budget_us) * index;
+            let now = Instant::now();
+            if due > now {
+                std::thread::sleep(due - now);
+            }
+        }
+
+        let start = self.player.position();
+        let end = Timestamp::from_micros(
+            (start.as_micros() + self.config.step_us()).min(self.player.duration().as_micros()),
+        );
+        // Events at `start` were delivered by the previous frame, except on
+        // the first one
+        let inputs = self
+            .player
+            .peek_events(start, end)
+            .into_iter()
+            .filter(|e| index == 0 || e.timestamp > start)
+            .map(|e| ProfiledInput {
+                timestamp: e.timestamp,
+                name: event_name(&e.event),
+            })
+            .collect();
+
+        let update = self.player.step();
+        self.pending = Some(ProfiledFrame {
+            index,
+            recording_time: start,
+            inputs,
+            stages: Vec::new(),
+        });
+        Some(update)
+    }
+
+    /// Record the stage timings of the frame returned by `next_frame`.
+    pub fn finish_frame(&mut self, stages: Vec<FrameStage>) {
+        if let Some(mut frame) = self.pending.take() {
+            frame.stages = stages;
+            self.trace.frames.push(frame);
+        }
+    }
+
+    /// Timings collected so far.
+    pub fn trace(&self) -> &ProfileTrace {
+        &self.trace
+    }
+
+    /// Stop replaying and return the collected timings.
+    pub fn into_trace(mut self) -> ProfileTrace {
+        if let Some(frame) = self.pending.take() {
+            self.trace.frames.push(frame);
+        }
+        self.trace
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::{
+        Modifiers, MouseButton, MouseEvent, Point, RecordingConfig, ScrollEvent, TimestampedEvent,
+    };
+
+    fn export() -> RecordingExport {
+        let click = |us| {
+            TimestampedEvent::new(
+                Timestamp::from_micros(us),
+                RecordedEvent::Click(MouseEvent {
+                    position: Point::new(10.0, 10.0),
+                    button: MouseButton::Left,
+                    modifiers: Modifiers::none(),
+                    target_element: None,
+                }),
+            )
+        };
+        RecordingExport {
+            config: RecordingConfig::minimal(),
+            events: vec![
+                click(0),
+                TimestampedEvent::new(
+                    Timestamp::from_micros(20_000),
+                    RecordedEvent::Scroll(ScrollEvent {
+                        position: Point::new(10.0, 10.0),
+                        delta_x: 0.0,
+                        delta_y: -40.0,
+                        target_element: None,
+                    }),
+                ),
+                click(50_000),
+            ],
+            snapshots: Vec::new(),
+            stats: Default::default(),
+        }
+    }
+
+    #[test]
+    fn test_replays_every_input_once() {
+        let config = ProfileConfig::accelerated(1.0).with_frame_budget_us(10_000);
+        let mut replay = ProfileReplay::new(export(), config);
+
+        let mut delivered = 0;
+        while let Some(update) = replay.next_frame() {
+            delivered += update.events.len();
+            replay.finish_frame(vec![FrameStage::new("build", Duration::from_millis(1))]);
+        }
+        let trace = replay.into_trace();
+
+        assert_eq!(delivered, 3);
+        assert_eq!(trace.frames.len(), 5);
+        let inputs: usize = trace.frames.iter().map(|f| f.inputs.len()).sum();
+        assert_eq!(inputs, 3);
+        assert_eq!(trace.frames[2].recording_time.as_micros(), 20_000);
+    }
+
+    #[test]
+    fn test_accelerated_replay_covers_more_time_per_frame() {
+        let config = ProfileConfig::accelerated(5.0).with_frame_budget_us(10_000);
+        let mut replay = ProfileReplay::new(export(), config);
+        while replay.next_frame().is_some() {
+            replay.finish_frame(Vec::new());
+        }
+        assert_eq!(replay.trace().frames.len(), 1);
+    }
+
+    #[test]
+    fn test_chrome_trace_marks_jank_frames() {
+        let trace = ProfileTrace {
+            frame_budget_us: 16_667,
+            frames: vec![
+                ProfiledFrame {
+                    index: 0,
+                    recording_time: Timestamp::zero(),
+                    inputs: Vec::new(),
+                    stages: vec![FrameStage::new("build", Duration::from_millis(4))],
+                },
+                ProfiledFrame {
+                    index: 1,
+                    recording_time: Timestamp::from_micros(16_667),
+                    inputs: vec![ProfiledInput {
+                        timestamp: Timestamp::from_micros(16_000),
+                        name: "Scroll",
+                    }],
+                    stages: vec![
+                        FrameStage::new("layout", Duration::from_millis(12)),
+                        FrameStage::new("gpu", Duration::from_millis(10)),
+                    ],
+                },
+            ],
+        };
+
+        assert_eq!(
+            trace.jank_frames().map(|f| f.index).collect::<Vec<_>>(),
+            [1]
+        );
+
+        let json = trace.to_chrome_trace();
+        assert!(json.starts_with(r#"{"displayTimeUnit":"ms","traceEvents":["#));
+        assert_eq!(json.matches(r#""name":"Jank""#).count(), 1);
+        assert!(json.contains(
+            r#""name":"Scroll","cat":"input","ph":"i","s":"t","pid":1,"tid":2,"ts":16000"#
+        ));
+        assert!(
+            json.contains(r#""name":"gpu","cat":"stage","ph":"X","pid":1,"tid":1,"ts":28667.000"#)
+        );
+    }
+}
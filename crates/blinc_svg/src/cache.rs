@@ -0,0 +1,393 @@
+//! Keyed cache of parsed and rasterized SVGs
+//!
+//! Icons are drawn from the same handful of SVG sources over and over, at a
+//! handful of sizes. `SvgCache` keeps the parsed `usvg::Tree` per source and
+//! the untinted raster per (source, pixel size, scale factor), so parsing and
+//! resvg rasterization happen once per icon and size instead of once per
+//! window, theme change or hover state. Colors are applied at draw time by
+//! tinting the cached coverage on the GPU.
+//!
+//! Renderers that upload a raster to a texture release it with
+//! `release_raster` right after, so pixels aren't held on both sides. Each
+//! one also retains the sources it draws and releases them when trimming
+//! memory, which drops only the trees no other renderer still uses.
+
+use std::collections::hash_map::DefaultHasher;
+use std::collections::HashMap;
+use std::hash::{Hash, Hasher};
+use std::sync::{Arc, Mutex};
+
+use usvg::{Options, Tree};
+
+use crate::error::SvgError;
+use crate::rasterize::RasterizedSvg;
+
+/// Default number of parsed trees kept
+pub const DEFAULT_SVG_TREE_CAPACITY: usize = 256;
+
+/// Default byte budget for cached rasters (64 MiB of RGBA)
+pub const DEFAULT_SVG_RASTER_BUDGET: usize = 64 * 1024 * 1024;
+
+/// Hash identifying an SVG source in `SvgCache`
+pub fn content_hash(data: &[u8]) -> u64 {
+    let mut hasher = DefaultHasher::new();
+    data.hash(&mut hasher);
+    hasher.finish()
+}
+
+/// Snapshot of `SvgCache` counters
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub struct SvgCacheStats {
+    /// Parsed trees currently cached
+    pub trees: usize,
+    /// Rasters currently cached
+    pub rasters: usize,
+    /// Bytes of pixel data held by cached rasters
+    pub raster_bytes: usize,
+    /// Raster lookups served from the cache
+    pub hits: u64,
+    /// Raster lookups that had to rasterize
+    pub misses: u64,
+}
+
+#[derive(Clone, Copy, PartialEq, Eq, Hash)]
+struct RasterKey {
+    content_hash: u64,
+    width: u32,
+    height: u32,
+    scale_bits: u32,
+}
+
+struct TreeEntry {
+    tree: Arc<Tree>,
+    /// Source length, checked alongside the hash to catch collisions
+    len: usize,
+    last_used: u64,
+}
+
+struct RasterEntry {
+    raster: Arc<RasterizedSvg>,
+    len: usize,
+    last_used: u64,
+}
+
+struct Inner {
+    trees: HashMap<u64, TreeEntry>,
+    rasters: HashMap<RasterKey, RasterEntry>,
+    /// Retain counts per source hash, see `SvgCache::retain_source`
+    users: HashMap<u64, usize>,
+    tree_capacity: usize,
+    raster_budget: usize,
+    raster_bytes: usize,
+    clock: u64,
+    hits: u64,
+    misses: u64,
+}
+
+impl Inner {
+    fn tick(&mut self) -> u64 {
+        self.clock += 1;
+        self.clock
+    }
+
+    fn remove_raster(&mut self, key: &RasterKey) {
+        if let Some(entry) = self.rasters.remove(key) {
+            self.raster_bytes -= entry.raster.pixels.len();
+        }
+    }
+
+    fn evict_trees(&mut self) {
+        if self.trees.len() <= self.tree_capacity {
+            return;
+        }
+        // Drop the least recently used quarter in one pass
+        let keep = self.tree_capacity * 3 / 4;
+        let mut ages: Vec<(u64, u64)> = self.trees.iter().map(|(k, e)| (e.last_used, *k)).collect();
+        ages.sort_unstable();
+        for (_, key) in &ages[..ages.len() - keep] {
+            self.trees.remove(key);
+        }
+    }
+
+    fn evict_rasters(&mut self) {
+        if self.raster_bytes <= self.raster_budget {
+            return;
+        }
+        let target = self.raster_budget * 3 / 4;
+        let mut ages: Vec<(u64, RasterKey)> = self
+            .rasters
+            .iter()
+            .map(|(k, e)| (e.last_used, *k))
+            .collect();
+        ages.sort_unstable_by_key(|(age, _)| *age);
+        for (_, key) in ages {
+            if self.raster_bytes <= target {
+                break;
+            }
+            self.remove_raster(&key);
+        }
+    }
+}
+
+/// Thread-safe cache of parsed SVG trees and untinted rasters
+///
+/// Shared between render contexts through `global_svg_cache`.
+pub struct SvgCache {
+    inner: Mutex<Inner>,
+}
+
+impl SvgCache {
+    /// Create a cache keeping up to `tree_capacity` parsed trees and
+    /// `raster_budget` bytes of rasters
+    pub fn new(tree_capacity: usize, raster_budget: usize) -> Self {
+        Self {
+            inner: Mutex::new(Inner {
+                trees: HashMap::new(),
+                rasters: HashMap::new(),
+                users: HashMap::new(),
+                tree_capacity: tree_capacity.max(1),
+                raster_budget,
+                raster_bytes: 0,
+                clock: 0,
+                hits: 0,
+                misses: 0,
+            }),
+        }
+    }
+
+    /// Parsed tree for `data`, parsing it on first use
+    pub fn tree(&self, data: &[u8]) -> Result<Arc<Tree>, SvgError> {
+        let hash = content_hash(data);
+        {
+            let mut guard = self.inner.lock().unwrap();
+            let inner = &mut *guard;
+            let now = inner.tick();
+            if let Some(entry) = inner.trees.get_mut(&hash) {
+                if entry.len == data.len() {
+                    entry.last_used = now;
+                    return Ok(Arc::clone(&entry.tree));
+                }
+            }
+        }
+
+        // Parse outside the lock so other threads aren't blocked on it.
+        // Leading whitespace is trimmed: an XML declaration must come first.
+        let trimmed = std::str::from_utf8(data).unwrap_or("").trim_start();
+        let tree = Tree::from_data(trimmed.as_bytes(), &Options::default())
+            .map_err(|e| SvgError::Parse(e.to_string()))?;
+        let tree = Arc::new(tree);
+
+        let mut inner = self.inner.lock().unwrap();
+        let now = inner.tick();
+        inner.trees.insert(
+            hash,
+            TreeEntry {
+                tree: Arc::clone(&tree),
+                len: data.len(),
+                last_used: now,
+            },
+        );
+        inner.evict_trees();
+        Ok(tree)
+    }
+
+    /// Untinted raster of `data` at `width`×`height` physical pixels
+    ///
+    /// `scale_factor` is the display scale the size was computed for; it is
+    /// part of the key so the same logical icon on a 1x and a 2x window
+    /// doesn't alias.
+    pub fn rasterize(
+        &self,
+        data: &[u8],
+        width: u32,
+        height: u32,
+        scale_factor: f32,
+    ) -> Result<Arc<RasterizedSvg>, SvgError> {
+        let key = RasterKey {
+            content_hash: content_hash(data),
+            width,
+            height,
+            scale_bits: scale_factor.to_bits(),
+        };
+        {
+            let mut guard = self.inner.lock().unwrap();
+            let inner = &mut *guard;
+            let now = inner.tick();
+            if let Some(entry) = inner.rasters.get_mut(&key) {
+                if entry.len == data.len() {
+                    entry.last_used = now;
+                    inner.hits += 1;
+                    return Ok(Arc::clone(&entry.raster));
+                }
+            }
+            inner.misses += 1;
+        }
+
+        let tree = self.tree(data)?;
+        let raster = Arc::new(RasterizedSvg::from_tree(&tree, width, height)?);
+
+        let mut inner = self.inner.lock().unwrap();
+        let now = inner.tick();
+        inner.raster_bytes += raster.pixels.len();
+        let replaced = inner.rasters.insert(
+            key,
+            RasterEntry {
+                raster: Arc::clone(&raster),
+                len: data.len(),
+                last_used: now,
+            },
+        );
+        if let Some(old) = replaced {
+            inner.raster_bytes -= old.raster.pixels.len();
+        }
+        inner.evict_rasters();
+        Ok(raster)
+    }
+
+    /// Drop the cached raster of `data` at this size and scale, e.g. once it
+    /// has been uploaded to a texture; the parsed tree stays cached
+    pub fn release_raster(&self, data: &[u8], width: u32, height: u32, scale_factor: f32) {
+        let key = RasterKey {
+            content_hash: content_hash(data),
+            width,
+            height,
+            scale_bits: scale_factor.to_bits(),
+        };
+        self.inner.lock().unwrap().remove_raster(&key);
+    }
+
+    /// Note that a renderer draws the source with `hash` (see `content_hash`)
+    ///
+    /// Each call must be balanced by one release in `release_sources`.
+    pub fn retain_source(&self, hash: u64) {
+        *self.inner.lock().unwrap().users.entry(hash).or_insert(0) += 1;
+    }
+
+    /// Release sources retained with `retain_source`
+    ///
+    /// Trees and rasters of a source are dropped once nothing retains it any
+    /// more; sources another renderer still retains stay cached.
+    pub fn release_sources(&self, hashes: impl IntoIterator<Item = u64>) {
+        let mut inner = self.inner.lock().unwrap();
+        for hash in hashes {
+            let Some(count) = inner.users.get_mut(&hash) else {
+                continue;
+            };
+            *count -= 1;
+            if *count > 0 {
+                continue;
+            }
+            inner.users.remove(&hash);
+            inner.trees.remove(&hash);
+            let keys: Vec<RasterKey> = inner
+                .rasters
+                .keys()
+                .filter(|k| k.content_hash == hash)
+                .copied()
+                .collect();
+            for key in &keys {
+                inner.remove_raster(key);
+            }
+        }
+    }
+
+    /// Drop every cached tree and raster
+    ///
+    /// Retain counts are kept. Affects every renderer sharing the cache;
+    /// to free one renderer's sources use `release_sources`.
+    pub fn clear(&self) {
+        let mut inner = self.inner.lock().unwrap();
+        inner.trees.clear();
+        inner.rasters.clear();
+        inner.raster_bytes = 0;
+    }
+
+    /// Current entry counts and hit/miss totals
+    pub fn stats(&self) -> SvgCacheStats {
+        let inner = self.inner.lock().unwrap();
+        SvgCacheStats {
+            trees: inner.trees.len(),
+            rasters: inner.rasters.len(),
+            raster_bytes: inner.raster_bytes,
+            hits: inner.hits,
+            misses: inner.misses,
+        }
+    }
+}
+
+impl Default for SvgCache {
+    fn default() -> Self {
+        Self::new(DEFAULT_SVG_TREE_CAPACITY, DEFAULT_SVG_RASTER_BUDGET)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    const CIRCLE: &str = r#"<svg xmlns="http://www.w3.org/2000/svg" width="24" height="24">
+        <circle cx="12" cy="12" r="10" fill="white"/>
+    </svg>"#;
+
+    #[test]
+    fn test_rasters_are_keyed_by_size_and_scale() {
+        let cache = SvgCache::default();
+        let a = cache.rasterize(CIRCLE.as_bytes(), 48, 48, 2.0).unwrap();
+        let b = cache.rasterize(CIRCLE.as_bytes(), 48, 48, 2.0).unwrap();
+        assert!(Arc::ptr_eq(&a, &b));
+
+        cache.rasterize(CIRCLE.as_bytes(), 48, 48, 1.0).unwrap();
+        cache.rasterize(CIRCLE.as_bytes(), 24, 24, 1.0).unwrap();
+
+        let stats = cache.stats();
+        assert_eq!(stats.trees, 1);
+        assert_eq!(stats.rasters, 3);
+        assert_eq!(stats.hits, 1);
+        assert_eq!(stats.misses, 3);
+    }
+
+    #[test]
+    fn test_raster_budget_evicts_least_recently_used() {
+        // Room for two 16x16 rasters (1 KiB each)
+        let cache = SvgCache::new(8, 2 * 16 * 16 * 4);
+        let first = cache.rasterize(CIRCLE.as_bytes(), 16, 16, 1.0).unwrap();
+        cache.rasterize(CIRCLE.as_bytes(), 16, 16, 2.0).unwrap();
+        cache.rasterize(CIRCLE.as_bytes(), 16, 16, 3.0).unwrap();
+
+        let stats = cache.stats();
+        assert!(stats.raster_bytes <= 2 * 16 * 16 * 4);
+        let again = cache.rasterize(CIRCLE.as_bytes(), 16, 16, 1.0).unwrap();
+        assert!(!Arc::ptr_eq(&first, &again));
+    }
+
+    #[test]
+    fn test_release_raster_keeps_tree() {
+        let cache = SvgCache::default();
+        cache.rasterize(CIRCLE.as_bytes(), 16, 16, 1.0).unwrap();
+        cache.release_raster(CIRCLE.as_bytes(), 16, 16, 1.0);
+
+        let stats = cache.stats();
+        assert_eq!(stats.trees, 1);
+        assert_eq!(stats.rasters, 0);
+        assert_eq!(stats.raster_bytes, 0);
+    }
+
+    #[test]
+    fn test_release_sources_keeps_sources_still_retained() {
+        let cache = SvgCache::default();
+        let hash = content_hash(CIRCLE.as_bytes());
+        cache.retain_source(hash);
+        cache.retain_source(hash);
+        cache.rasterize(CIRCLE.as_bytes(), 16, 16, 1.0).unwrap();
+
+        cache.release_sources([hash]);
+        assert_eq!(cache.stats().trees, 1);
+        assert_eq!(cache.stats().rasters, 1);
+
+        cache.release_sources([hash]);
+        let stats = cache.stats();
+        assert_eq!(stats.trees, 0);
+        assert_eq!(stats.rasters, 0);
+        assert_eq!(stats.raster_bytes, 0);
+    }
+}
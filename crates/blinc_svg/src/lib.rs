@@ -13,6 +13,10 @@
 //! Uses `resvg` for high-quality CPU rasterization with proper anti-aliasing.
 //! Produces pixel-perfect output that can be uploaded as GPU textures.
 //!
+//! Rasters are cached per source, pixel size and scale factor in
+//! `global_svg_cache`; draw them with a GPU tint rather than baking the
+//! color in, so recoloring an icon never re-rasterizes it.
+//!
 //! # Example
 //!
 //! ```ignore
@@ -27,12 +31,22 @@
 //! // Upload rasterized.data() to GPU texture
 //! ```
 
+mod cache;
 mod document;
 mod error;
 mod path;
 mod rasterize;
 mod style;
 
+pub use cache::{
+    content_hash, SvgCache, SvgCacheStats, DEFAULT_SVG_RASTER_BUDGET, DEFAULT_SVG_TREE_CAPACITY,
+};
 pub use document::{SvgDocument, SvgDrawCommand};
 pub use error::SvgError;
 pub use rasterize::RasterizedSvg;
+
+/// Process-wide SVG cache shared by every renderer
+pub fn global_svg_cache() -> &'static SvgCache {
+    static CACHE: std::sync::OnceLock<SvgCache> = std::sync::OnceLock::new();
+    CACHE.get_or_init(SvgCache::default)
+}
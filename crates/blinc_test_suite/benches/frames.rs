@@ -0,0 +1,82 @@
+//! Headless frame-time benchmarks
+//!
+//! Usage:
+//!   cargo bench -p blinc_test_suite --features bench -- [options]
+//!
+//! Options:
+//!   --frames N            Measured frames per scenario (default 300)
+//!   --warmup N            Discarded frames before measuring (default 30)
+//!   --scenario NAME       Only run scenarios whose name contains NAME
+//!   --output PATH         Where to write the JSON report
+//!   --baseline PATH       Compare against a previous JSON report
+//!   --thresholds PATH     Regression thresholds (JSON, see `bench::Thresholds`)
+//!
+//! Exits with status 1 if any threshold is exceeded.
+
+use anyhow::{Context, Result};
+use blinc_test_suite::bench::{
+    BenchConfig, BenchReport, BenchRunner, CountingAllocator, Thresholds,
+};
+use tracing_subscriber::{layer::SubscriberExt, util::SubscriberInitExt};
+
+#[global_allocator]
+static ALLOCATOR: CountingAllocator = CountingAllocator;
+
+fn arg<'a>(args: &'a [String], name: &str) -> Option<&'a str> {
+    args.iter()
+        .position(|a| a == name)
+        .and_then(|i| args.get(i + 1))
+        .map(String::as_str)
+}
+
+fn main() -> Result<()> {
+    tracing_subscriber::registry()
+        .with(
+            tracing_subscriber::EnvFilter::try_from_default_env().unwrap_or_else(|_| "warn".into()),
+        )
+        .with(tracing_subscriber::fmt::layer())
+        .init();
+
+    // cargo passes `--bench`; unknown flags are ignored
+    let args: Vec<String> = std::env::args().collect();
+    let mut config = BenchConfig::default();
+    if let Some(frames) = arg(&args, "--frames") {
+        config.frames = frames.parse().context("--frames")?;
+    }
+    if let Some(warmup) = arg(&args, "--warmup") {
+        config.warmup_frames = warmup.parse().context("--warmup")?;
+    }
+    let output = arg(&args, "--output")
+        .map(String::from)
+        .unwrap_or_else(|| concat!(env!("CARGO_TARGET_TMPDIR"), "/blinc-frames.json").to_string());
+
+    let thresholds = match arg(&args, "--thresholds") {
+        Some(path) => {
+            Thresholds::from_json(&std::fs::read_to_string(path).context("--thresholds")?)?
+        }
+        None => Thresholds::default(),
+    };
+    let baseline = match arg(&args, "--baseline") {
+        Some(path) => Some(BenchReport::from_json(
+            &std::fs::read_to_string(path).context("--baseline")?,
+        )?),
+        None => None,
+    };
+
+    let mut runner = BenchRunner::new()?;
+    let report = runner.run_all(&config, arg(&args, "--scenario"))?;
+    report.print_summary();
+
+    std::fs::write(&output, report.to_json()?).with_context(|| format!("writing {}", output))?;
+    println!("\nReport written to {}", output);
+
+    let regressions = thresholds.check(&report, baseline.as_ref());
+    if regressions.is_empty() {
+        return Ok(());
+    }
+    println!("\nRegressions:");
+    for regression in &regressions {
+        println!("  {}", regression);
+    }
+    std::process::exit(1);
+}
@@ -0,0 +1,594 @@
+//! Headless frame-time benchmarks
+//!
+//! Renders each scenario in [`scenarios`] for a fixed number of frames
+//! through a headless `BlincApp` and records, per frame, the time spent
+//! building the element tree, computing layout, encoding GPU work and waiting
+//! for the GPU, plus the heap allocations made. Results are summarized as
+//! p50/p99 and written as JSON so CI can compare a run against a stored
+//! baseline with [`Thresholds`].
+//!
+//! Run with `cargo bench -p blinc_test_suite --features bench`; see
+//! `benches/frames.rs` for the command-line options.
+
+pub mod scenarios;
+
+pub use scenarios::{all_scenarios, Scenario};
+
+use std::alloc::{GlobalAlloc, Layout, System};
+use std::collections::HashMap;
+use std::sync::atomic::{AtomicU64, AtomicUsize, Ordering};
+use std::sync::{Arc, Mutex};
+use std::time::{Duration, Instant};
+
+use anyhow::Result;
+use blinc_animation::AnimationScheduler;
+use blinc_app::BlincApp;
+use blinc_layout::{RenderState, RenderTree};
+use blinc_theme::{BlincTheme, ColorScheme, ThemeState};
+use serde::{Deserialize, Serialize};
+
+// ============================================================================
+// Allocation counting
+// ============================================================================
+
+static ALLOCATIONS: AtomicU64 = AtomicU64::new(0);
+static LIVE_BYTES: AtomicUsize = AtomicUsize::new(0);
+static PEAK_BYTES: AtomicUsize = AtomicUsize::new(0);
+
+/// Global allocator that counts allocations and tracks peak heap usage
+///
+/// Install it in the benchmark binary with `#[global_allocator]`. Without it
+/// allocation counts and peak heap bytes are reported as zero.
+pub struct CountingAllocator;
+
+impl CountingAllocator {
+    fn track(size: usize) {
+        ALLOCATIONS.fetch_add(1, Ordering::Relaxed);
+        let live = LIVE_BYTES.fetch_add(size, Ordering::Relaxed) + size;
+        PEAK_BYTES.fetch_max(live, Ordering::Relaxed);
+    }
+}
+
+unsafe impl GlobalAlloc for CountingAllocator {
+    unsafe fn alloc(&self, layout: Layout) -> *mut u8 {
+        let ptr = System.alloc(layout);
+        if !ptr.is_null() {
+            Self::track(layout.size());
+        }
+        ptr
+    }
+
+    unsafe fn alloc_zeroed(&self, layout: Layout) -> *mut u8 {
+        let ptr = System.alloc_zeroed(layout);
+        if !ptr.is_null() {
+            Self::track(layout.size());
+        }
+        ptr
+    }
+
+    unsafe fn dealloc(&self, ptr: *mut u8, layout: Layout) {
+        System.dealloc(ptr, layout);
+        LIVE_BYTES.fetch_sub(layout.size(), Ordering::Relaxed);
+    }
+
+    unsafe fn realloc(&self, ptr: *mut u8, layout: Layout, new_size: usize) -> *mut u8 {
+        let new_ptr = System.realloc(ptr, layout, new_size);
+        if !new_ptr.is_null() {
+            LIVE_BYTES.fetch_sub(layout.size(), Ordering::Relaxed);
+            Self::track(new_size);
+        }
+        new_ptr
+    }
+}
+
+fn allocation_count() -> u64 {
+    ALLOCATIONS.load(Ordering::Relaxed)
+}
+
+/// Restart peak tracking from the current live heap size
+fn reset_peak_bytes() {
+    PEAK_BYTES.store(LIVE_BYTES.load(Ordering::Relaxed), Ordering::Relaxed);
+}
+
+fn peak_bytes() -> u64 {
+    PEAK_BYTES.load(Ordering::Relaxed) as u64
+}
+
+// ============================================================================
+// Reports
+// ============================================================================
+
+/// p50/p99/max of one timing, in milliseconds
+#[derive(Clone, Copy, Debug, Default, PartialEq, Serialize, Deserialize)]
+pub struct Percentiles {
+    pub p50_ms: f64,
+    pub p99_ms: f64,
+    pub max_ms: f64,
+}
+
+impl Percentiles {
+    /// Nearest-rank percentiles of `samples` (milliseconds)
+    pub fn from_samples(samples: &[f64]) -> Self {
+        if samples.is_empty() {
+            return Self::default();
+        }
+        let mut sorted = samples.to_vec();
+        sorted.sort_unstable_by(f64::total_cmp);
+        let rank = |p: f64| {
+            let index = (p * sorted.len() as f64).ceil() as usize;
+            sorted[index.clamp(1, sorted.len()) - 1]
+        };
+        Self {
+            p50_ms: rank(0.50),
+            p99_ms: rank(0.99),
+            max_ms: sorted[sorted.len() - 1],
+        }
+    }
+}
+
+/// Results for one scenario
+#[derive(Clone, Debug, PartialEq, Serialize, Deserialize)]
+pub struct ScenarioReport {
+    pub name: String,
+    /// Measured frames (warmup frames excluded)
+    pub frames: u32,
+    /// Scenario builder plus `RenderTree::from_element`
+    pub build: Percentiles,
+    /// `RenderTree::compute_layout`
+    pub layout: Percentiles,
+    /// Text preparation and GPU command encoding
+    pub encode: Percentiles,
+    /// Waiting for the GPU to finish the frame
+    pub gpu: Percentiles,
+    /// Sum of the four stages
+    pub total: Percentiles,
+    /// Mean heap allocations per frame
+    pub allocations_per_frame: f64,
+    /// Peak heap size while the scenario ran
+    pub peak_heap_bytes: u64,
+    /// Peak `MemoryUsage::total_bytes` of the renderer's caches
+    pub peak_gpu_cache_bytes: u64,
+}
+
+/// Results for a benchmark run
+#[derive(Clone, Debug, Default, PartialEq, Serialize, Deserialize)]
+pub struct BenchReport {
+    pub scenarios: Vec<ScenarioReport>,
+}
+
+impl BenchReport {
+    /// Report for the scenario called `name`
+    pub fn scenario(&self, name: &str) -> Option<&ScenarioReport> {
+        self.scenarios.iter().find(|s| s.name == name)
+    }
+
+    pub fn to_json(&self) -> Result<String> {
+        Ok(serde_json::to_string_pretty(self)?)
+    }
+
+    pub fn from_json(json: &str) -> Result<Self> {
+        Ok(serde_json::from_str(json)?)
+    }
+
+    /// Print a human-readable table
+    pub fn print_summary(&self) {
+        println!(
+            "{:<16} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10} {:>12}",
+            "scenario",
+            "build p50",
+            "layout p50",
+            "encode p50",
+            "gpu p50",
+            "total p50",
+            "total p99",
+            "allocs/frame"
+        );
+        for s in &self.scenarios {
+            println!(
+                "{:<16} {:>10.3} {:>10.3} {:>10.3} {:>10.3} {:>10.3} {:>10.3} {:>12.1}",
+                s.name,
+                s.build.p50_ms,
+                s.layout.p50_ms,
+                s.encode.p50_ms,
+                s.gpu.p50_ms,
+                s.total.p50_ms,
+                s.total.p99_ms,
+                s.allocations_per_frame
+            );
+        }
+    }
+}
+
+// ============================================================================
+// Regression thresholds
+// ============================================================================
+
+/// Absolute limits for one scenario
+#[derive(Clone, Debug, Default, PartialEq, Serialize, Deserialize)]
+pub struct Budget {
+    #[serde(default)]
+    pub p99_frame_ms: Option<f64>,
+    #[serde(default)]
+    pub allocations_per_frame: Option<f64>,
+}
+
+/// Allocations per frame a scenario may gain over its baseline regardless of
+/// `max_regression`, so a zero baseline isn't brittle
+const ALLOCATION_SLACK: f64 = 1.0;
+
+/// When a run counts as a regression
+///
+/// Loaded from JSON, e.g.
+/// `{"max_regression": 0.1, "budgets": {"scroll": {"p99_frame_ms": 8.0}}}`.
+#[derive(Clone, Debug, PartialEq, Serialize, Deserialize)]
+pub struct Thresholds {
+    /// Allowed slowdown relative to the baseline (0.1 = 10%)
+    #[serde(default = "Thresholds::default_max_regression")]
+    pub max_regression: f64,
+    /// Timing differences smaller than this are treated as noise
+    #[serde(default = "Thresholds::default_noise_floor_ms")]
+    pub noise_floor_ms: f64,
+    /// Absolute per-scenario limits, checked with or without a baseline
+    #[serde(default)]
+    pub budgets: HashMap<String, Budget>,
+}
+
+impl Thresholds {
+    fn default_max_regression() -> f64 {
+        0.10
+    }
+
+    fn default_noise_floor_ms() -> f64 {
+        0.25
+    }
+
+    pub fn from_json(json: &str) -> Result<Self> {
+        Ok(serde_json::from_str(json)?)
+    }
+
+    /// Regressions in `report`, against `baseline` if given
+    pub fn check(&self, report: &BenchReport, baseline: Option<&BenchReport>) -> Vec<Regression> {
+        let mut regressions = Vec::new();
+        for current in &report.scenarios {
+            if let Some(base) = baseline.and_then(|b| b.scenario(&current.name)) {
+                let timings = [
+                    ("total.p50_ms", base.total.p50_ms, current.total.p50_ms),
+                    ("total.p99_ms", base.total.p99_ms, current.total.p99_ms),
+                ];
+                for (metric, base, now) in timings {
+                    let limit =
+                        (base * (1.0 + self.max_regression)).max(base + self.noise_floor_ms);
+                    if now > limit {
+                        regressions.push(Regression::new(&current.name, metric, limit, now));
+                    }
+                }
+                let limit = (base.allocations_per_frame * (1.0 + self.max_regression))
+                    .max(base.allocations_per_frame + ALLOCATION_SLACK);
+                if current.allocations_per_frame > limit {
+                    regressions.push(Regression::new(
+                        &current.name,
+                        "allocations_per_frame",
+                        limit,
+                        current.allocations_per_frame,
+                    ));
+                }
+            }
+
+            if let Some(budget) = self.budgets.get(&current.name) {
+                if let Some(limit) = budget.p99_frame_ms {
+                    if current.total.p99_ms > limit {
+                        regressions.push(Regression::new(
+                            &current.name,
+                            "total.p99_ms",
+                            limit,
+                            current.total.p99_ms,
+                        ));
+                    }
+                }
+                if let Some(limit) = budget.allocations_per_frame {
+                    if current.allocations_per_frame > limit {
+                        regressions.push(Regression::new(
+                            &current.name,
+                            "allocations_per_frame",
+                            limit,
+                            current.allocations_per_frame,
+                        ));
+                    }
+                }
+            }
+        }
+        regressions
+    }
+}
+
+impl Default for Thresholds {
+    fn default() -> Self {
+        Self {
+            max_regression: Self::default_max_regression(),
+            noise_floor_ms: Self::default_noise_floor_ms(),
+            budgets: HashMap::new(),
+        }
+    }
+}
+
+/// A metric that exceeded its threshold
+#[derive(Clone, Debug, PartialEq)]
+pub struct Regression {
+    pub scenario: String,
+    pub metric: &'static str,
+    pub limit: f64,
+    pub value: f64,
+}
+
+impl Regression {
+    fn new(scenario: &str, metric: &'static str, limit: f64, value: f64) -> Self {
+        Self {
+            scenario: scenario.to_string(),
+            metric,
+            limit,
+            value,
+        }
+    }
+}
+
+impl std::fmt::Display for Regression {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        write!(
+            f,
+            "{}: {} = {:.3} exceeds {:.3}",
+            self.scenario, self.metric, self.value, self.limit
+        )
+    }
+}
+
+// ============================================================================
+// Runner
+// ============================================================================
+
+/// Frame counts for a run
+#[derive(Clone, Debug)]
+pub struct BenchConfig {
+    /// Frames measured per scenario
+    pub frames: u32,
+    /// Frames rendered first and discarded (pipeline compilation, atlas fill)
+    pub warmup_frames: u32,
+}
+
+impl Default for BenchConfig {
+    fn default() -> Self {
+        Self {
+            frames: 300,
+            warmup_frames: 30,
+        }
+    }
+}
+
+struct Target {
+    _texture: wgpu::Texture,
+    view: wgpu::TextureView,
+    width: u32,
+    height: u32,
+}
+
+/// Renders scenarios through a headless `BlincApp` and times each frame
+pub struct BenchRunner {
+    app: BlincApp,
+    render_state: RenderState,
+    target: Option<Target>,
+}
+
+impl BenchRunner {
+    /// Create a headless app with a fixed theme, so runs are comparable
+    /// across machines with different system color schemes
+    pub fn new() -> Result<Self> {
+        ThemeState::init(BlincTheme::bundle(), ColorScheme::Dark);
+
+        let app = BlincApp::new()?;
+        blinc_app::init_text_measurer_with_registry(app.font_registry());
+
+        let scheduler = Arc::new(Mutex::new(AnimationScheduler::new()));
+        Ok(Self {
+            app,
+            render_state: RenderState::new(scheduler),
+            target: None,
+        })
+    }
+
+    fn ensure_target(&mut self, width: u32, height: u32) {
+        let stale = self
+            .target
+            .as_ref()
+            .map_or(true, |t| t.width != width || t.height != height);
+        if stale {
+            let texture = self.app.device().create_texture(&wgpu::TextureDescriptor {
+                label: Some("Bench Target"),
+                size: wgpu::Extent3d {
+                    width,
+                    height,
+                    depth_or_array_layers: 1,
+                },
+                mip_level_count: 1,
+                sample_count: 1,
+                dimension: wgpu::TextureDimension::D2,
+                format: self.app.texture_format(),
+                usage: wgpu::TextureUsages::RENDER_ATTACHMENT | wgpu::TextureUsages::COPY_SRC,
+                view_formats: &[],
+            });
+            let view = texture.create_view(&wgpu::TextureViewDescriptor::default());
+            self.target = Some(Target {
+                _texture: texture,
+                view,
+                width,
+                height,
+            });
+        }
+    }
+
+    /// Render `scenario` and summarize its frame times
+    pub fn run(&mut self, scenario: &mut Scenario, config: &BenchConfig) -> Result<ScenarioReport> {
+        let (width, height) = (scenario.width, scenario.height);
+        self.ensure_target(width, height);
+
+        let frames = config.frames.max(1);
+        let mut build = Vec::with_capacity(frames as usize);
+        let mut layout = Vec::with_capacity(frames as usize);
+        let mut encode = Vec::with_capacity(frames as usize);
+        let mut gpu = Vec::with_capacity(frames as usize);
+        let mut total = Vec::with_capacity(frames as usize);
+        let mut allocations = 0u64;
+        let mut peak_gpu_cache_bytes = 0u64;
+
+        for frame in 0..config.warmup_frames + frames {
+            let measured = frame >= config.warmup_frames;
+            if frame == config.warmup_frames {
+                reset_peak_bytes();
+            }
+            let allocs_before = allocation_count();
+
+            let start = Instant::now();
+            let element = (scenario.build)(frame);
+            let mut tree = RenderTree::from_element(&element);
+            let build_time = start.elapsed();
+
+            let start = Instant::now();
+            tree.compute_layout(width as f32, height as f32);
+            let layout_time = start.elapsed();
+
+            let target = &self.target.as_ref().unwrap().view;
+            self.app
+                .render_tree_with_motion(&tree, &self.render_state, target, width, height)?;
+            // The renderer already waits once after submitting; wait again in
+            // case work was queued after that (overlays)
+            let start = Instant::now();
+            self.app.device().poll(wgpu::Maintain::Wait);
+            let stats = self.app.last_render_stats();
+            let gpu_time = stats.gpu_time + start.elapsed();
+
+            if !measured {
+                continue;
+            }
+            // Dropping the tree is part of the frame's cost
+            drop(tree);
+            drop(element);
+            allocations += allocation_count() - allocs_before;
+            peak_gpu_cache_bytes = peak_gpu_cache_bytes.max(self.app.memory_usage().total_bytes());
+
+            let stages = [build_time, layout_time, stats.encode_time, gpu_time];
+            build.push(ms(build_time));
+            layout.push(ms(layout_time));
+            encode.push(ms(stats.encode_time));
+            gpu.push(ms(gpu_time));
+            total.push(ms(stages.iter().sum()));
+        }
+
+        Ok(ScenarioReport {
+            name: scenario.name.to_string(),
+            frames,
+            build: Percentiles::from_samples(&build),
+            layout: Percentiles::from_samples(&layout),
+            encode: Percentiles::from_samples(&encode),
+            gpu: Percentiles::from_samples(&gpu),
+            total: Percentiles::from_samples(&total),
+            allocations_per_frame: allocations as f64 / frames as f64,
+            peak_heap_bytes: peak_bytes(),
+            peak_gpu_cache_bytes,
+        })
+    }
+
+    /// Run every scenario whose name contains `filter` (all if `None`)
+    pub fn run_all(&mut self, config: &BenchConfig, filter: Option<&str>) -> Result<BenchReport> {
+        let mut report = BenchReport::default();
+        for mut scenario in all_scenarios() {
+            if filter.map_or(false, |f| !scenario.name.contains(f)) {
+                continue;
+            }
+            tracing::info!(
+                "Running scenario {} ({} frames)",
+                scenario.name,
+                config.frames
+            );
+            report.scenarios.push(self.run(&mut scenario, config)?);
+        }
+        Ok(report)
+    }
+}
+
+fn ms(duration: Duration) -> f64 {
+    duration.as_secs_f64() * 1000.0
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn report(name: &str, p50: f64, p99: f64, allocations: f64) -> BenchReport {
+        let total = Percentiles {
+            p50_ms: p50,
+            p99_ms: p99,
+            max_ms: p99,
+        };
+        BenchReport {
+            scenarios: vec![ScenarioReport {
+                name: name.to_string(),
+                frames: 100,
+                build: Percentiles::default(),
+                layout: Percentiles::default(),
+                encode: Percentiles::default(),
+                gpu: Percentiles::default(),
+                total,
+                allocations_per_frame: allocations,
+                peak_heap_bytes: 0,
+                peak_gpu_cache_bytes: 0,
+            }],
+        }
+    }
+
+    #[test]
+    fn test_nearest_rank_percentiles() {
+        let samples: Vec<f64> = (1..=100).map(f64::from).collect();
+        let p = Percentiles::from_samples(&samples);
+        assert_eq!(p.p50_ms, 50.0);
+        assert_eq!(p.p99_ms, 99.0);
+        assert_eq!(p.max_ms, 100.0);
+        assert_eq!(Percentiles::from_samples(&[]), Percentiles::default());
+    }
+
+    #[test]
+    fn test_thresholds_flag_regressions_against_baseline() {
+        let thresholds = Thresholds::default();
+        let baseline = report("scroll", 4.0, 8.0, 100.0);
+
+        // Within 10% (and noise) passes
+        let ok = report("scroll", 4.3, 8.6, 105.0);
+        assert!(thresholds.check(&ok, Some(&baseline)).is_empty());
+
+        let slow = report("scroll", 4.0, 10.0, 150.0);
+        let metrics: Vec<_> = thresholds
+            .check(&slow, Some(&baseline))
+            .into_iter()
+            .map(|r| r.metric)
+            .collect();
+        assert_eq!(metrics, ["total.p99_ms", "allocations_per_frame"]);
+
+        // The reported limit is the one that was checked, slack included
+        let zero = report("scroll", 4.0, 8.0, 0.0);
+        let regressions = thresholds.check(&report("scroll", 4.0, 8.0, 2.0), Some(&zero));
+        assert_eq!(regressions.len(), 1);
+        assert_eq!(regressions[0].limit, ALLOCATION_SLACK);
+        assert!(thresholds
+            .check(&report("scroll", 4.0, 8.0, ALLOCATION_SLACK), Some(&zero))
+            .is_empty());
+
+        let json = r#"{"budgets": {"scroll": {"p99_frame_ms": 6.0}}}"#;
+        let budgets = Thresholds::from_json(json).unwrap();
+        assert_eq!(budgets.max_regression, 0.10);
+        assert_eq!(budgets.check(&ok, None).len(), 1);
+    }
+
+    #[test]
+    fn test_report_round_trips_through_json() {
+        let original = report("table_demo", 2.0, 3.0, 10.0);
+        let parsed = BenchReport::from_json(&original.to_json().unwrap()).unwrap();
+        assert_eq!(parsed, original);
+    }
+}
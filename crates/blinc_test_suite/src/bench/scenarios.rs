@@ -0,0 +1,409 @@
+//! Benchmark scenarios
+//!
+//! Headless versions of the `blinc_app` examples. Each scenario builds its UI
+//! from the frame index only, so two runs of the same scenario produce the
+//! same sequence of trees and their timings are comparable.
+
+use std::sync::{Arc, Mutex};
+
+use blinc_cn::prelude::*;
+use blinc_core::{Brush, Color, Gradient, Point};
+use blinc_layout::prelude::*;
+
+/// Builds the UI for a given frame index
+pub type ScenarioBuilder = Box<dyn FnMut(u32) -> Div>;
+
+/// A reproducible UI workload rendered for a fixed number of frames
+pub struct Scenario {
+    /// Name used in reports and on the command line
+    pub name: &'static str,
+    /// Viewport width in pixels
+    pub width: u32,
+    /// Viewport height in pixels
+    pub height: u32,
+    /// Per-frame UI builder
+    pub build: ScenarioBuilder,
+}
+
+impl Scenario {
+    fn new(name: &'static str, build: impl FnMut(u32) -> Div + 'static) -> Self {
+        Self {
+            name,
+            width: 1200,
+            height: 800,
+            build: Box::new(build),
+        }
+    }
+}
+
+/// All built-in scenarios, in report order
+pub fn all_scenarios() -> Vec<Scenario> {
+    vec![
+        cn_demo(),
+        markdown_demo(),
+        table_demo(),
+        scroll_demo(),
+        effects_demo(),
+    ]
+}
+
+fn root(width: f32, height: f32) -> Div {
+    div()
+        .w(width)
+        .h(height)
+        .bg(Color::rgba(0.08, 0.08, 0.1, 1.0))
+        .flex_col()
+        .p(16.0)
+        .gap(16.0)
+}
+
+// ============================================================================
+// cn_demo: component gallery with an animating progress bar
+// ============================================================================
+
+fn cn_demo() -> Scenario {
+    Scenario::new("cn_demo", |frame| {
+        let progress = (frame % 100) as f32;
+        root(1200.0, 800.0)
+            .child(
+                div()
+                    .flex_row()
+                    .flex_wrap()
+                    .gap(12.0)
+                    .child(cn::button("Primary"))
+                    .child(cn::button("Secondary").variant(ButtonVariant::Secondary))
+                    .child(cn::button("Destructive").variant(ButtonVariant::Destructive))
+                    .child(cn::button("Outline").variant(ButtonVariant::Outline))
+                    .child(cn::button("Ghost").variant(ButtonVariant::Ghost))
+                    .child(cn::button("Disabled").disabled(true)),
+            )
+            .child(
+                div()
+                    .flex_row()
+                    .flex_wrap()
+                    .gap(12.0)
+                    .child(cn::badge("Default"))
+                    .child(cn::badge("Success").variant(BadgeVariant::Success))
+                    .child(cn::badge("Warning").variant(BadgeVariant::Warning))
+                    .child(cn::badge("Outline").variant(BadgeVariant::Outline)),
+            )
+            .child(
+                div()
+                    .flex_row()
+                    .flex_wrap()
+                    .gap(16.0)
+                    .child(
+                        cn::card()
+                            .w(300.0)
+                            .child(
+                                cn::card_header()
+                                    .title("Card Title")
+                                    .description("Card description"),
+                            )
+                            .child(
+                                cn::card_content().child(text(
+                                    "Cards are great for grouping related information.",
+                                )),
+                            )
+                            .child(cn::card_footer().child(cn::button("Action"))),
+                    )
+                    .child(
+                        cn::card()
+                            .w(300.0)
+                            .child(cn::card_header().title("Simple Card"))
+                            .child(
+                                cn::card_content().child(text("A simpler card without footer.")),
+                            ),
+                    ),
+            )
+            .child(
+                div()
+                    .flex_col()
+                    .gap(8.0)
+                    .child(cn::alert("This is a default informational alert."))
+                    .child(
+                        cn::alert("Operation completed successfully!")
+                            .variant(AlertVariant::Success),
+                    )
+                    .child(
+                        cn::alert("An error occurred. Please try again.")
+                            .variant(AlertVariant::Destructive),
+                    ),
+            )
+            .child(
+                div()
+                    .flex_col()
+                    .gap(8.0)
+                    .child(cn::progress(progress).w(400.0))
+                    .child(cn::progress(100.0 - progress).w(400.0)),
+            )
+    })
+}
+
+// ============================================================================
+// markdown_demo: preview re-parsed as the source grows
+// ============================================================================
+
+const MARKDOWN_SOURCE: &str = r#"# Welcome to Markdown Editor
+
+This is a **live preview** markdown editor built with Blinc.
+
+## Features
+
+- *Italic* and **bold** text
+- ~~Strikethrough~~ text
+- Inline `code` snippets
+
+### Task Lists
+
+- [x] Implement markdown parser
+- [x] Create preview component
+- [ ] Add syntax highlighting
+
+### Code Blocks
+
+```rust
+fn main() {
+    println!("Hello, Blinc!");
+}
+```
+
+> Blockquotes are supported too.
+
+| Feature | Status |
+|---------|--------|
+| Tables  | Done   |
+| Images  | Done   |
+"#;
+
+fn markdown_demo() -> Scenario {
+    Scenario::new("markdown_demo", |frame| {
+        // One more typed line every 10 frames, like the editor's live preview
+        let mut source = String::from(MARKDOWN_SOURCE);
+        for line in 0..frame / 10 {
+            source.push_str(&format!("\nTyped line {} with some **bold** text.\n", line));
+        }
+        root(1200.0, 800.0).child(
+            scroll()
+                .w_full()
+                .h(720.0)
+                .direction(ScrollDirection::Vertical)
+                .child(div().w_full().p(4.0).child(markdown_light(&source))),
+        )
+    })
+}
+
+// ============================================================================
+// table_demo: striped table with a moving selection
+// ============================================================================
+
+const TABLE_ROWS: u32 = 200;
+
+fn table_demo() -> Scenario {
+    Scenario::new("table_demo", |frame| {
+        let mut builder = TableBuilder::new().headers(&["ID", "Product", "Price", "Stock"]);
+        for row in 0..TABLE_ROWS {
+            let id = row.to_string();
+            let product = format!("Product {}", row);
+            let price = format!("${}.{:02}", 10 + row * 3, row % 100);
+            let stock = ((row * 37) % 250).to_string();
+            builder = builder.row(&[
+                id.as_str(),
+                product.as_str(),
+                price.as_str(),
+                stock.as_str(),
+            ]);
+        }
+        let selected = frame % TABLE_ROWS;
+
+        root(1200.0, 800.0)
+            .child(h1("TableBuilder Demo").color(Color::WHITE))
+            .child(text(format!("Selected row {}", selected)).color(Color::WHITE))
+            .child(
+                scroll()
+                    .w_full()
+                    .h(680.0)
+                    .direction(ScrollDirection::Vertical)
+                    .child(
+                        builder
+                            .striped(true)
+                            .build()
+                            .w_full()
+                            .bg(Color::rgba(0.12, 0.12, 0.15, 1.0))
+                            .rounded(8.0)
+                            .overflow_clip(),
+                    ),
+            )
+    })
+}
+
+// ============================================================================
+// scroll: glass cards scrolled at a constant speed
+// ============================================================================
+
+const SCROLL_CARDS: u32 = 24;
+const SCROLL_STEP: f32 = 12.0;
+
+fn scroll_demo() -> Scenario {
+    let physics: SharedScrollPhysics = Arc::new(Mutex::new(ScrollPhysics::default()));
+    Scenario::new("scroll", move |frame| {
+        let (viewport_w, viewport_h) = (1120.0, 700.0);
+        {
+            let mut p = physics.lock().unwrap();
+            p.viewport_width = viewport_w;
+            p.viewport_height = viewport_h;
+            // Ping-pong through the content so every frame scrolls
+            let range = SCROLL_CARDS as f32 * 120.0 - viewport_h;
+            let travel = (frame as f32 * SCROLL_STEP) % (2.0 * range);
+            p.offset_y = -(if travel > range {
+                2.0 * range - travel
+            } else {
+                travel
+            });
+        }
+
+        let mut content = div().w_full().p(20.0).flex_col().gap(16.0);
+        for i in 0..SCROLL_CARDS {
+            content = content.child(if i % 3 == 0 {
+                div()
+                    .glass()
+                    .w_full()
+                    .rounded(16.0)
+                    .p(20.0)
+                    .flex_col()
+                    .gap(8.0)
+                    .child(
+                        div()
+                            .w_full()
+                            .h(4.0)
+                            .bg(Color::rgba(0.4, 0.6, 1.0, 0.3))
+                            .rounded(2.0),
+                    )
+                    .child(
+                        text(format!("Glass card {}", i))
+                            .size(24.0)
+                            .weight(FontWeight::Bold)
+                            .color(Color::WHITE),
+                    )
+            } else {
+                div()
+                    .w_full()
+                    .bg(Color::rgba(0.2, 0.2, 0.25, 1.0))
+                    .rounded(12.0)
+                    .p(16.0)
+                    .child(
+                        text(format!("Card {}: more content to scroll through", i))
+                            .size(16.0)
+                            .color(Color::WHITE),
+                    )
+            });
+        }
+
+        root(1200.0, 800.0).child(
+            Scroll::with_physics(physics.clone())
+                .w(viewport_w)
+                .h(viewport_h)
+                .rounded(24.0)
+                .bg(Color::rgba(0.15, 0.15, 0.2, 1.0))
+                .direction(ScrollDirection::Vertical)
+                .child(content),
+        )
+    })
+}
+
+// ============================================================================
+// effects_demo: layer effects and a glass panel moving over a gradient
+// ============================================================================
+
+fn effect_tile(label: &str) -> Div {
+    div()
+        .w(120.0)
+        .h(120.0)
+        .rounded(12.0)
+        .bg(Color::from_hex(0x3b82f6))
+        .flex()
+        .items_center()
+        .justify_center()
+        .child(
+            text(label)
+                .size(16.0)
+                .weight(FontWeight::Bold)
+                .color(Color::WHITE),
+        )
+}
+
+fn effects_demo() -> Scenario {
+    Scenario::new("effects_demo", |frame| {
+        let panel_x = 20.0 + (frame % 120) as f32 * 2.0;
+        root(1200.0, 800.0)
+            .child(
+                div()
+                    .flex_row()
+                    .flex_wrap()
+                    .gap(16.0)
+                    .child(effect_tile("None"))
+                    .child(effect_tile("blur(4)").blur(4.0))
+                    .child(effect_tile("blur(12)").blur(12.0))
+                    .child(effect_tile("shadow").drop_shadow_effect(
+                        4.0,
+                        4.0,
+                        12.0,
+                        Color::rgba(0.0, 0.0, 0.0, 0.5),
+                    ))
+                    .child(effect_tile("glow").glow_effect(
+                        Color::from_hex(0x3b82f6),
+                        16.0,
+                        0.0,
+                        0.8,
+                    ))
+                    .child(effect_tile("grayscale").grayscale())
+                    .child(effect_tile("sepia").sepia()),
+            )
+            .child(
+                div()
+                    .w(800.0)
+                    .h(300.0)
+                    .rounded(16.0)
+                    .background(Brush::Gradient(Gradient::linear(
+                        Point::new(0.0, 0.0),
+                        Point::new(800.0, 300.0),
+                        Color::from_hex(0xf43f5e),
+                        Color::from_hex(0x3b82f6),
+                    )))
+                    .relative()
+                    .child(
+                        div().absolute().top(40.0).left(40.0).child(
+                            text("Content Behind Glass")
+                                .size(32.0)
+                                .weight(FontWeight::Bold)
+                                .color(Color::WHITE),
+                        ),
+                    )
+                    .child(
+                        div()
+                            .absolute()
+                            .bottom(20.0)
+                            .left(panel_x)
+                            .w(300.0)
+                            .h(120.0)
+                            .rounded(12.0)
+                            .material(Material::Glass(GlassMaterial::simple().blur(12.0)))
+                            .border(1.0, Color::rgba(1.0, 1.0, 1.0, 0.2)),
+                    ),
+            )
+    })
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_scenario_names_are_unique() {
+        let scenarios = all_scenarios();
+        let mut names: Vec<_> = scenarios.iter().map(|s| s.name).collect();
+        names.sort_unstable();
+        names.dedup();
+        assert_eq!(names.len(), scenarios.len());
+    }
+}
@@ -371,6 +371,9 @@ impl TestHarness {
             sample_count: config.sample_count,
             texture_format: Some(wgpu::TextureFormat::Rgba8Unorm),
             unified_text_rendering: true,
+            pipeline_cache_dir: None,
+            background_pipeline_compilation: true,
+            blur_mode: blinc_gpu::BlurMode::Quality,
         };
 
         let renderer = pollster::block_on(GpuRenderer::new(renderer_config))
@@ -529,6 +532,7 @@ impl TestHarness {
                 atlas_view,
                 color_atlas_view,
                 text_ctx.sampler(),
+                text_ctx.atlas_generation(),
             );
         }
     }
@@ -6,14 +6,18 @@
 //! # Features
 //!
 //! - `interactive` - Enable interactive window tests (requires display)
+//! - `bench` - Enable the headless frame-time benchmarks
 //!
 //! # Test Categories
 //!
 //! - **Headless Tests**: Run without display, render to textures
 //! - **Visual Regression**: Compare rendered output to reference images
 //! - **Interactive Tests**: Manual testing with live windows
-//! - **Benchmarks**: Performance testing of rendering pipeline
+//! - **Benchmarks**: Headless frame-time scenarios with regression thresholds
+//!   (`cargo bench -p blinc_test_suite --features bench`, see `bench`)
 
+#[cfg(feature = "bench")]
+pub mod bench;
 pub mod harness;
 pub mod runner;
 pub mod tests;
@@ -1,7 +1,9 @@
 //! Glyph atlas management
 //!
-//! Manages a texture atlas for caching rendered glyphs. Uses a skyline/shelf
-//! packing algorithm for efficient space utilization.
+//! Manages paged texture atlases for caching rendered glyphs. Each page is
+//! packed with a shelf algorithm and is uploaded as one layer of a texture
+//! array. When every page is full, glyphs that haven't been used recently
+//! are evicted a shelf at a time and their space is reused.
 //!
 //! Provides two atlas types:
 //! - `GlyphAtlas`: Grayscale atlas for regular text glyphs
@@ -10,9 +12,25 @@
 use crate::{Result, TextError};
 use rustc_hash::FxHashMap;
 
+/// Default maximum number of pages (texture array layers) per atlas
+pub const DEFAULT_MAX_PAGES: u32 = 4;
+
+/// Identifies one of the render contexts sharing an atlas
+///
+/// See [`PagedAtlas::begin_frame_for`].
+pub type FrameClient = u32;
+
+/// Client whose frames [`PagedAtlas::begin_frame`] starts
+pub const DEFAULT_FRAME_CLIENT: FrameClient = 0;
+
+/// Pending upload rects per page before they collapse into their bounds
+const MAX_DIRTY_RECTS: usize = 16;
+
 /// Region in the atlas texture
-#[derive(Debug, Clone, Copy)]
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
 pub struct AtlasRegion {
+    /// Atlas page (texture array layer) holding this region
+    pub page: u32,
     /// X position in atlas (pixels)
     pub x: u32,
     /// Y position in atlas (pixels)
@@ -32,6 +50,41 @@ impl AtlasRegion {
         let v_max = (self.y + self.height) as f32 / atlas_height as f32;
         [u_min, v_min, u_max, v_max]
     }
+
+    /// Texel coordinates of this region (x_min, y_min, x_max, y_max)
+    ///
+    /// Unlike `uv_bounds`, these stay valid when the atlas grows: shaders
+    /// normalize them against the atlas texture that is actually bound.
+    pub fn texel_bounds(&self) -> [f32; 4] {
+        [
+            self.x as f32,
+            self.y as f32,
+            (self.x + self.width) as f32,
+            (self.y + self.height) as f32,
+        ]
+    }
+
+    /// Whether `other` lies entirely inside this region (same page)
+    fn contains(&self, other: &AtlasRegion) -> bool {
+        self.page == other.page
+            && other.x >= self.x
+            && other.y >= self.y
+            && other.x + other.width <= self.x + self.width
+            && other.y + other.height <= self.y + self.height
+    }
+
+    /// Smallest region on the same page containing both
+    fn union(&self, other: &AtlasRegion) -> AtlasRegion {
+        let x = self.x.min(other.x);
+        let y = self.y.min(other.y);
+        AtlasRegion {
+            page: self.page,
+            x,
+            y,
+            width: (self.x + self.width).max(other.x + other.width) - x,
+            height: (self.y + self.height).max(other.y + other.height) - y,
+        }
+    }
 }
 
 /// Information about a cached glyph
@@ -47,6 +100,33 @@ pub struct GlyphInfo {
     pub advance: u16,
     /// Font size this glyph was rasterized at
     pub font_size: f32,
+    /// Whether the region holds a signed distance field instead of coverage
+    pub sdf: bool,
+}
+
+impl GlyphInfo {
+    /// Scale from atlas texels to pixels when drawn at `font_size`
+    ///
+    /// Bitmap glyphs are drawn 1:1; SDF glyphs are rasterized at a bucket
+    /// size and scaled to whatever size they are drawn at.
+    pub fn scale_for(&self, font_size: f32) -> f32 {
+        if self.sdf {
+            font_size / self.font_size
+        } else {
+            1.0
+        }
+    }
+}
+
+/// Usage statistics for one atlas page
+#[derive(Debug, Clone, Copy, Default, PartialEq)]
+pub struct AtlasPageStats {
+    /// Glyphs currently stored on the page
+    pub glyph_count: usize,
+    /// Fraction of the page area allocated to shelves (0.0 to 1.0)
+    pub utilization: f32,
+    /// Glyphs evicted from the page to make room for new ones
+    pub evictions: u64,
 }
 
 /// Key for glyph cache lookup
@@ -58,20 +138,33 @@ struct GlyphKey {
     glyph_id: u16,
     /// Font size (quantized to avoid too many entries)
     size_key: u16,
+    /// Signed distance field rather than coverage bitmap
+    sdf: bool,
 }
 
 impl GlyphKey {
-    fn new(font_id: u32, glyph_id: u16, font_size: f32) -> Self {
+    fn new(font_id: u32, glyph_id: u16, font_size: f32, sdf: bool) -> Self {
         // Quantize font size to reduce cache entries (0.5px granularity)
         let size_key = (font_size * 2.0).round() as u16;
         Self {
             font_id,
             glyph_id,
             size_key,
+            sdf,
         }
     }
 }
 
+/// A cached glyph and when it was last drawn
+#[derive(Debug)]
+struct GlyphEntry {
+    info: GlyphInfo,
+    /// Shelf on `info.region.page` holding the glyph (None for empty glyphs)
+    shelf: Option<usize>,
+    /// Frame (see `PagedAtlas::begin_frame`) the glyph was last used in
+    last_used: u64,
+}
+
 /// A shelf in the skyline packing algorithm
 #[derive(Debug)]
 struct Shelf {
@@ -81,122 +174,221 @@ struct Shelf {
     height: u32,
     /// Current X position (next free space)
     x: u32,
+    /// Most recent `last_used` of the glyphs on this shelf
+    last_used: u64,
 }
 
-/// Glyph atlas for caching rendered glyphs
-pub struct GlyphAtlas {
-    /// Atlas width in pixels
-    width: u32,
-    /// Atlas height in pixels
-    height: u32,
-    /// Pixel data (single channel, 8-bit grayscale or SDF values)
+/// One layer of a paged atlas
+#[derive(Debug)]
+struct AtlasPage {
+    /// Pixel data for this page (row-major, `bytes_per_pixel` per pixel)
     pixels: Vec<u8>,
-    /// Cached glyph information
-    glyphs: FxHashMap<GlyphKey, GlyphInfo>,
     /// Shelves for skyline packing
     shelves: Vec<Shelf>,
+    /// Glyphs currently stored on this page
+    glyph_count: usize,
+    /// Glyphs evicted from this page so far
+    evictions: u64,
+    /// Regions modified since the last upload
+    dirty: Vec<AtlasRegion>,
+}
+
+impl AtlasPage {
+    fn new(bytes: usize) -> Self {
+        Self {
+            pixels: vec![0; bytes],
+            shelves: Vec::new(),
+            glyph_count: 0,
+            evictions: 0,
+            dirty: Vec::new(),
+        }
+    }
+
+    /// Bottom of the lowest shelf
+    fn used_height(&self) -> u32 {
+        self.shelves.last().map(|s| s.y + s.height).unwrap_or(0)
+    }
+}
+
+/// Where a new glyph goes: shelf index on the page, and region
+type Allocation = (usize, AtlasRegion);
+
+/// Paged glyph atlas shared by `GlyphAtlas` and `ColorGlyphAtlas`
+///
+/// Every page has the same dimensions and maps to one layer of a texture
+/// array; `AtlasRegion::page` selects the layer. Glyph regions never move, so
+/// `GlyphInfo`s stay valid until the glyph is evicted.
+///
+/// Call [`begin_frame`](Self::begin_frame) once per frame, or
+/// [`begin_frame_for`](Self::begin_frame_for) and
+/// [`end_frame_for`](Self::end_frame_for) around each frame when several
+/// render contexts share the atlas. A glyph is never evicted while a frame
+/// that may have used it is still open, since its draws may not have been
+/// submitted yet.
+pub struct PagedAtlas {
+    /// Page width in pixels
+    width: u32,
+    /// Page height in pixels
+    height: u32,
+    /// Bytes per pixel (1 for grayscale, 4 for RGBA)
+    bytes_per_pixel: u32,
+    /// Allocated pages, in texture array layer order
+    pages: Vec<AtlasPage>,
+    /// Cached glyph information
+    glyphs: FxHashMap<GlyphKey, GlyphEntry>,
     /// Padding between glyphs
     padding: u32,
-    /// Whether atlas data has been modified since last upload
-    dirty: bool,
+    /// Height the atlas was created with; `grow` never exceeds it
+    max_height: u32,
+    /// Pages to allocate before evicting glyphs
+    max_pages: u32,
+    /// Current frame number, used for last-used tracking
+    frame: u64,
+    /// Frame number each client's open frame started at
+    open_frames: FxHashMap<FrameClient, u64>,
 }
 
-impl GlyphAtlas {
-    /// Create a new glyph atlas
-    pub fn new(width: u32, height: u32) -> Self {
-        Self {
+impl PagedAtlas {
+    /// Create a paged atlas with one page of `width` x `height` pixels
+    pub fn new(width: u32, height: u32, bytes_per_pixel: u32) -> Self {
+        let mut atlas = Self {
             width,
             height,
-            pixels: vec![0; (width * height) as usize],
+            bytes_per_pixel,
+            pages: Vec::new(),
             glyphs: FxHashMap::default(),
-            shelves: Vec::new(),
             padding: 2, // 2 pixel padding between glyphs
-            dirty: true,
-        }
+            max_height: height,
+            max_pages: DEFAULT_MAX_PAGES,
+            frame: 0,
+            open_frames: FxHashMap::default(),
+        };
+        atlas.push_page();
+        atlas
     }
 
-    /// Get atlas dimensions
+    /// Get page dimensions
     pub fn dimensions(&self) -> (u32, u32) {
         (self.width, self.height)
     }
 
-    /// Get raw pixel data
-    pub fn pixels(&self) -> &[u8] {
-        &self.pixels
+    /// Bytes per pixel of the pixel data
+    pub fn bytes_per_pixel(&self) -> u32 {
+        self.bytes_per_pixel
+    }
+
+    /// Number of allocated pages (texture array layers)
+    pub fn page_count(&self) -> u32 {
+        self.pages.len() as u32
+    }
+
+    /// Maximum number of pages before glyphs are evicted
+    pub fn max_pages(&self) -> u32 {
+        self.max_pages
+    }
+
+    /// Set the maximum number of pages (at least 1)
+    ///
+    /// Pages beyond the new maximum are dropped along with their glyphs.
+    pub fn set_max_pages(&mut self, max_pages: u32) {
+        self.max_pages = max_pages.max(1);
+        if self.pages.len() > self.max_pages as usize {
+            self.pages.truncate(self.max_pages as usize);
+            let max_pages = self.max_pages;
+            self.glyphs
+                .retain(|_, entry| entry.info.region.page < max_pages);
+        }
+    }
+
+    /// Get raw pixel data of one page
+    pub fn page_pixels(&self, page: u32) -> &[u8] {
+        &self.pages[page as usize].pixels
     }
 
     /// Check if atlas has been modified
     pub fn is_dirty(&self) -> bool {
-        self.dirty
+        self.pages.iter().any(|page| !page.dirty.is_empty())
     }
 
     /// Mark atlas as clean (after GPU upload)
     pub fn mark_clean(&mut self) {
-        self.dirty = false;
+        for page in &mut self.pages {
+            page.dirty.clear();
+        }
     }
 
-    /// Look up a cached glyph
-    pub fn get_glyph(&self, font_id: u32, glyph_id: u16, font_size: f32) -> Option<&GlyphInfo> {
-        let key = GlyphKey::new(font_id, glyph_id, font_size);
-        self.glyphs.get(&key)
+    /// Take the regions modified since the last upload, marking the atlas clean
+    ///
+    /// Only these regions need to be copied to an existing texture; a texture
+    /// whose size or layer count differs from the atlas must be re-created
+    /// and filled from every page instead.
+    pub fn take_dirty_regions(&mut self) -> Vec<AtlasRegion> {
+        self.pages
+            .iter_mut()
+            .flat_map(|page| page.dirty.drain(..))
+            .collect()
     }
 
-    /// Allocate space for a glyph using skyline packing
-    fn allocate(&mut self, width: u32, height: u32) -> Result<AtlasRegion> {
-        let padded_width = width + self.padding;
-        let padded_height = height + self.padding;
-
-        // Find best shelf (smallest height that fits)
-        let mut best_shelf = None;
-        let mut best_y = u32::MAX;
-
-        for (i, shelf) in self.shelves.iter().enumerate() {
-            // Check if glyph fits in this shelf
-            if shelf.height >= padded_height && shelf.x + padded_width <= self.width {
-                if shelf.y < best_y {
-                    best_y = shelf.y;
-                    best_shelf = Some(i);
-                }
-            }
-        }
+    /// Start a frame for the default client
+    ///
+    /// Its previous frame counts as submitted, so glyphs only that frame
+    /// used may be evicted from now on.
+    pub fn begin_frame(&mut self) {
+        self.begin_frame_for(DEFAULT_FRAME_CLIENT);
+    }
 
-        if let Some(shelf_idx) = best_shelf {
-            // Use existing shelf
-            let shelf = &mut self.shelves[shelf_idx];
-            let region = AtlasRegion {
-                x: shelf.x,
-                y: shelf.y,
-                width,
-                height,
-            };
-            shelf.x += padded_width;
-            return Ok(region);
-        }
+    /// Start a frame for `client`, ending its previous one
+    ///
+    /// Glyphs used while any client's frame is open stay pinned until that
+    /// frame ends, however many frames other clients start meanwhile.
+    pub fn begin_frame_for(&mut self, client: FrameClient) {
+        self.frame += 1;
+        self.open_frames.insert(client, self.frame);
+    }
 
-        // Create new shelf
-        let new_y = self.shelves.last().map(|s| s.y + s.height).unwrap_or(0);
+    /// End `client`'s frame once its draws have been submitted
+    ///
+    /// An idle client then no longer pins the glyphs it used.
+    pub fn end_frame_for(&mut self, client: FrameClient) {
+        self.open_frames.remove(&client);
+    }
 
-        if new_y + padded_height > self.height {
-            return Err(TextError::AtlasFull);
-        }
+    /// Look up a cached glyph without marking it as used
+    pub fn get_glyph(&self, font_id: u32, glyph_id: u16, font_size: f32) -> Option<&GlyphInfo> {
+        let key = GlyphKey::new(font_id, glyph_id, font_size, false);
+        self.glyphs.get(&key).map(|entry| &entry.info)
+    }
 
-        let region = AtlasRegion {
-            x: 0,
-            y: new_y,
-            width,
-            height,
-        };
+    /// Look up a cached glyph and mark it as used this frame
+    pub fn lookup(&mut self, font_id: u32, glyph_id: u16, font_size: f32) -> Option<GlyphInfo> {
+        self.lookup_key(GlyphKey::new(font_id, glyph_id, font_size, false))
+    }
 
-        self.shelves.push(Shelf {
-            y: new_y,
-            height: padded_height,
-            x: padded_width,
-        });
+    /// Look up a cached SDF glyph and mark it as used this frame
+    ///
+    /// `font_size` is the size bucket the SDF was rasterized at.
+    pub fn lookup_sdf(&mut self, font_id: u32, glyph_id: u16, font_size: f32) -> Option<GlyphInfo> {
+        self.lookup_key(GlyphKey::new(font_id, glyph_id, font_size, true))
+    }
 
-        Ok(region)
+    fn lookup_key(&mut self, key: GlyphKey) -> Option<GlyphInfo> {
+        let entry = self.glyphs.get_mut(&key)?;
+        entry.last_used = self.frame;
+        if let Some(shelf) = entry.shelf {
+            self.pages[entry.info.region.page as usize].shelves[shelf].last_used = self.frame;
+        }
+        Some(entry.info)
     }
 
     /// Insert a rasterized glyph into the atlas
+    ///
+    /// `bitmap` holds `width * height` pixels of `bytes_per_pixel` bytes.
+    /// Empty glyphs (zero width or height) are cached without using space.
+    /// Fills free space first, then grows the page height, then adds pages,
+    /// and finally evicts the least recently used glyphs. Returns
+    /// `TextError::AtlasFull` only when the glyph is larger than a page or
+    /// everything on the atlas is pinned by an open frame.
+    #[allow(clippy::too_many_arguments)]
     pub fn insert_glyph(
         &mut self,
         font_id: u32,
@@ -209,254 +401,353 @@ impl GlyphAtlas {
         advance: u16,
         bitmap: &[u8],
     ) -> Result<GlyphInfo> {
-        let key = GlyphKey::new(font_id, glyph_id, font_size);
-
-        // Check if already cached
-        if let Some(info) = self.glyphs.get(&key) {
-            return Ok(*info);
-        }
+        let key = GlyphKey::new(font_id, glyph_id, font_size, false);
+        self.insert(
+            key, font_size, width, height, bearing_x, bearing_y, advance, bitmap,
+        )
+    }
 
-        // Allocate region
-        let region = self.allocate(width, height)?;
+    /// Insert a signed distance field glyph (single channel) into the atlas
+    ///
+    /// SDF glyphs are cached separately from bitmaps of the same size; see
+    /// [`insert_glyph`](Self::insert_glyph) for eviction behaviour.
+    #[allow(clippy::too_many_arguments)]
+    pub fn insert_sdf_glyph(
+        &mut self,
+        font_id: u32,
+        glyph_id: u16,
+        font_size: f32,
+        width: u32,
+        height: u32,
+        bearing_x: i16,
+        bearing_y: i16,
+        advance: u16,
+        bitmap: &[u8],
+    ) -> Result<GlyphInfo> {
+        let key = GlyphKey::new(font_id, glyph_id, font_size, true);
+        self.insert(
+            key, font_size, width, height, bearing_x, bearing_y, advance, bitmap,
+        )
+    }
 
-        // Copy bitmap to atlas
-        for y in 0..height {
-            let src_offset = (y * width) as usize;
-            let dst_offset = ((region.y + y) * self.width + region.x) as usize;
-            let row_end = src_offset + width as usize;
-
-            if row_end <= bitmap.len() && dst_offset + width as usize <= self.pixels.len() {
-                self.pixels[dst_offset..dst_offset + width as usize]
-                    .copy_from_slice(&bitmap[src_offset..row_end]);
-            }
+    #[allow(clippy::too_many_arguments)]
+    fn insert(
+        &mut self,
+        key: GlyphKey,
+        font_size: f32,
+        width: u32,
+        height: u32,
+        bearing_x: i16,
+        bearing_y: i16,
+        advance: u16,
+        bitmap: &[u8],
+    ) -> Result<GlyphInfo> {
+        // Check if already cached
+        if let Some(info) = self.lookup_key(key) {
+            return Ok(info);
         }
 
-        let info = GlyphInfo {
-            region,
+        let mut info = GlyphInfo {
+            region: AtlasRegion::default(),
             bearing_x,
             bearing_y,
             advance,
             font_size,
+            sdf: key.sdf,
         };
 
-        self.glyphs.insert(key, info);
-        self.dirty = true;
-
-        Ok(info)
-    }
+        if width == 0 || height == 0 {
+            self.glyphs.insert(
+                key,
+                GlyphEntry {
+                    info,
+                    shelf: None,
+                    last_used: self.frame,
+                },
+            );
+            return Ok(info);
+        }
 
-    /// Clear all cached glyphs
-    pub fn clear(&mut self) {
-        self.glyphs.clear();
-        self.shelves.clear();
-        self.pixels.fill(0);
-        self.dirty = true;
-    }
+        // Allocate region
+        let (shelf, region) = self.allocate(width, height)?;
+        info.region = region;
 
-    /// Get number of cached glyphs
-    pub fn glyph_count(&self) -> usize {
-        self.glyphs.len()
-    }
+        // Copy bitmap to atlas
+        let bpp = self.bytes_per_pixel as usize;
+        let row_bytes = width as usize * bpp;
+        let stride = self.width as usize * bpp;
+        let page = &mut self.pages[region.page as usize];
+        for y in 0..height as usize {
+            let src_offset = y * row_bytes;
+            let dst_offset = (region.y as usize + y) * stride + region.x as usize * bpp;
+
+            if src_offset + row_bytes <= bitmap.len() && dst_offset + row_bytes <= page.pixels.len()
+            {
+                page.pixels[dst_offset..dst_offset + row_bytes]
+                    .copy_from_slice(&bitmap[src_offset..src_offset + row_bytes]);
+            }
+        }
 
-    /// Calculate atlas utilization (0.0 to 1.0)
-    pub fn utilization(&self) -> f32 {
-        let used_height = self.shelves.last().map(|s| s.y + s.height).unwrap_or(0);
-        used_height as f32 / self.height as f32
-    }
-}
+        page.shelves[shelf].last_used = self.frame;
+        page.glyph_count += 1;
+        self.mark_dirty(region);
 
-impl Default for GlyphAtlas {
-    fn default() -> Self {
-        // Default to 1024x1024 atlas (1 MB)
-        // This supports multiple fonts at various sizes for typical UI usage
-        Self::new(1024, 1024)
-    }
-}
+        self.glyphs.insert(
+            key,
+            GlyphEntry {
+                info,
+                shelf: Some(shelf),
+                last_used: self.frame,
+            },
+        );
 
-impl std::fmt::Debug for GlyphAtlas {
-    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
-        f.debug_struct("GlyphAtlas")
-            .field("dimensions", &(self.width, self.height))
-            .field("glyph_count", &self.glyphs.len())
-            .field(
-                "utilization",
-                &format!("{:.1}%", self.utilization() * 100.0),
-            )
-            .field("dirty", &self.dirty)
-            .finish()
+        Ok(info)
     }
-}
 
-/// Color glyph atlas for RGBA emoji
-///
-/// Similar to GlyphAtlas but stores RGBA pixel data (4 bytes per pixel)
-/// for color emoji and other color glyphs.
-pub struct ColorGlyphAtlas {
-    /// Atlas width in pixels
-    width: u32,
-    /// Atlas height in pixels
-    height: u32,
-    /// Pixel data (RGBA, 4 bytes per pixel)
-    pixels: Vec<u8>,
-    /// Cached glyph information
-    glyphs: FxHashMap<GlyphKey, GlyphInfo>,
-    /// Shelves for skyline packing
-    shelves: Vec<Shelf>,
-    /// Padding between glyphs
-    padding: u32,
-    /// Whether atlas data has been modified since last upload
-    dirty: bool,
-}
-
-impl ColorGlyphAtlas {
-    /// Create a new color glyph atlas
-    pub fn new(width: u32, height: u32) -> Self {
-        Self {
-            width,
-            height,
-            pixels: vec![0; (width * height * 4) as usize], // RGBA = 4 bytes per pixel
-            glyphs: FxHashMap::default(),
-            shelves: Vec::new(),
-            padding: 2,
-            dirty: true,
+    /// Allocate space for a glyph, evicting cold glyphs if the atlas is full
+    fn allocate(&mut self, width: u32, height: u32) -> Result<Allocation> {
+        let padded_width = width + self.padding;
+        let padded_height = height + self.padding;
+        if padded_width > self.width || padded_height > self.max_height {
+            return Err(TextError::AtlasFull);
         }
-    }
-
-    /// Get atlas dimensions
-    pub fn dimensions(&self) -> (u32, u32) {
-        (self.width, self.height)
-    }
 
-    /// Get raw pixel data (RGBA format)
-    pub fn pixels(&self) -> &[u8] {
-        &self.pixels
-    }
+        loop {
+            if let Some(allocation) = self.allocate_in_free_space(width, height) {
+                return Ok(allocation);
+            }
+            if !self.grow() {
+                break;
+            }
+        }
 
-    /// Check if atlas has been modified
-    pub fn is_dirty(&self) -> bool {
-        self.dirty
-    }
+        if self.pages.len() < self.max_pages as usize {
+            self.push_page();
+            if let Some(allocation) = self.allocate_in_free_space(width, height) {
+                return Ok(allocation);
+            }
+        }
 
-    /// Mark atlas as clean (after GPU upload)
-    pub fn mark_clean(&mut self) {
-        self.dirty = false;
-    }
+        if self.evict_shelf(padded_height) || self.evict_page() {
+            if let Some(allocation) = self.allocate_in_free_space(width, height) {
+                return Ok(allocation);
+            }
+        }
 
-    /// Look up a cached glyph
-    pub fn get_glyph(&self, font_id: u32, glyph_id: u16, font_size: f32) -> Option<&GlyphInfo> {
-        let key = GlyphKey::new(font_id, glyph_id, font_size);
-        self.glyphs.get(&key)
+        Err(TextError::AtlasFull)
     }
 
-    /// Allocate space for a glyph using skyline packing
-    fn allocate(&mut self, width: u32, height: u32) -> Result<AtlasRegion> {
+    /// Place a glyph on an existing shelf or a new shelf, without evicting
+    fn allocate_in_free_space(&mut self, width: u32, height: u32) -> Option<Allocation> {
         let padded_width = width + self.padding;
         let padded_height = height + self.padding;
 
         // Find best shelf (smallest height that fits)
-        let mut best_shelf = None;
-        let mut best_y = u32::MAX;
-
-        for (i, shelf) in self.shelves.iter().enumerate() {
-            if shelf.height >= padded_height && shelf.x + padded_width <= self.width {
-                if shelf.y < best_y {
-                    best_y = shelf.y;
-                    best_shelf = Some(i);
+        let mut best: Option<(usize, usize)> = None;
+        let mut best_height = u32::MAX;
+        for (p, page) in self.pages.iter().enumerate() {
+            for (i, shelf) in page.shelves.iter().enumerate() {
+                if shelf.height >= padded_height
+                    && shelf.x + padded_width <= self.width
+                    && shelf.height < best_height
+                {
+                    best_height = shelf.height;
+                    best = Some((p, i));
                 }
             }
         }
 
-        if let Some(shelf_idx) = best_shelf {
-            let shelf = &mut self.shelves[shelf_idx];
+        if let Some((p, i)) = best {
+            // Use existing shelf
+            let shelf = &mut self.pages[p].shelves[i];
             let region = AtlasRegion {
+                page: p as u32,
                 x: shelf.x,
                 y: shelf.y,
                 width,
                 height,
             };
             shelf.x += padded_width;
-            return Ok(region);
+            return Some((i, region));
         }
 
-        // Create new shelf
-        let new_y = self.shelves.last().map(|s| s.y + s.height).unwrap_or(0);
-
-        if new_y + padded_height > self.height {
-            return Err(TextError::AtlasFull);
+        // Create new shelf on the first page with room below its shelves
+        for (p, page) in self.pages.iter_mut().enumerate() {
+            let new_y = page.used_height();
+            if new_y + padded_height > self.height {
+                continue;
+            }
+            page.shelves.push(Shelf {
+                y: new_y,
+                height: padded_height,
+                x: padded_width,
+                last_used: self.frame,
+            });
+            let region = AtlasRegion {
+                page: p as u32,
+                x: 0,
+                y: new_y,
+                width,
+                height,
+            };
+            return Some((page.shelves.len() - 1, region));
         }
 
+        None
+    }
+
+    /// Empty the least recently used shelf at least `min_height` tall
+    ///
+    /// Shelves pinned by an open frame are skipped. Returns false if none
+    /// qualifies.
+    fn evict_shelf(&mut self, min_height: u32) -> bool {
+        let coldest = self
+            .pages
+            .iter()
+            .enumerate()
+            .flat_map(|(p, page)| {
+                page.shelves
+                    .iter()
+                    .enumerate()
+                    .map(move |(i, shelf)| (p, i, shelf))
+            })
+            .filter(|(_, _, shelf)| {
+                shelf.height >= min_height && self.is_evictable(shelf.last_used)
+            })
+            .min_by_key(|(_, _, shelf)| (shelf.last_used, shelf.height))
+            .map(|(p, i, _)| (p, i));
+
+        let Some((p, i)) = coldest else {
+            return false;
+        };
+
+        let removed = self
+            .remove_glyphs(|entry| entry.info.region.page == p as u32 && entry.shelf == Some(i));
+
+        let width = self.width;
+        let stride = (width * self.bytes_per_pixel) as usize;
+        let page = &mut self.pages[p];
+        let shelf = &mut page.shelves[i];
+        shelf.x = 0;
         let region = AtlasRegion {
+            page: p as u32,
             x: 0,
-            y: new_y,
+            y: shelf.y,
             width,
-            height,
+            height: shelf.height,
         };
+        page.pixels[region.y as usize * stride..(region.y + region.height) as usize * stride]
+            .fill(0);
+        page.glyph_count -= removed;
+        page.evictions += removed as u64;
+        self.mark_dirty(region);
+        true
+    }
 
-        self.shelves.push(Shelf {
-            y: new_y,
-            height: padded_height,
-            x: padded_width,
-        });
+    /// Empty the page whose glyphs were used longest ago
+    ///
+    /// Used when a glyph is taller than every cold shelf. Pages with glyphs
+    /// pinned by an open frame are skipped. Returns false if none qualifies.
+    fn evict_page(&mut self) -> bool {
+        let coldest = self
+            .pages
+            .iter()
+            .enumerate()
+            .filter_map(|(p, page)| {
+                let last_used = page.shelves.iter().map(|s| s.last_used).max()?;
+                self.is_evictable(last_used).then_some((p, last_used))
+            })
+            .min_by_key(|(_, last_used)| *last_used)
+            .map(|(p, _)| p);
+
+        let Some(p) = coldest else {
+            return false;
+        };
 
-        Ok(region)
+        let removed =
+            self.remove_glyphs(|entry| entry.shelf.is_some() && entry.info.region.page == p as u32);
+
+        let page = &mut self.pages[p];
+        page.shelves.clear();
+        page.pixels.fill(0);
+        page.glyph_count -= removed;
+        page.evictions += removed as u64;
+        self.mark_page_dirty(p);
+        true
     }
 
-    /// Insert a rasterized color glyph (RGBA) into the atlas
-    pub fn insert_glyph(
-        &mut self,
-        font_id: u32,
-        glyph_id: u16,
-        font_size: f32,
-        width: u32,
-        height: u32,
-        bearing_x: i16,
-        bearing_y: i16,
-        advance: u16,
-        bitmap: &[u8],
-    ) -> Result<GlyphInfo> {
-        let key = GlyphKey::new(font_id, glyph_id, font_size);
+    /// Whether something last used in frame `last_used` may be evicted
+    ///
+    /// It may not if it was used in the current frame, or after the oldest
+    /// frame still open started.
+    fn is_evictable(&self, last_used: u64) -> bool {
+        let oldest_open = self
+            .open_frames
+            .values()
+            .fold(self.frame, |oldest, &start| oldest.min(start));
+        last_used < oldest_open
+    }
 
-        // Check if already cached
-        if let Some(info) = self.glyphs.get(&key) {
-            return Ok(*info);
-        }
+    /// Drop glyphs matching `evict`, returning how many were removed
+    fn remove_glyphs(&mut self, evict: impl Fn(&GlyphEntry) -> bool) -> usize {
+        let before = self.glyphs.len();
+        self.glyphs.retain(|_, entry| !evict(entry));
+        before - self.glyphs.len()
+    }
 
-        // Allocate region
-        let region = self.allocate(width, height)?;
+    /// Append an empty page
+    fn push_page(&mut self) {
+        let bytes = (self.width * self.height * self.bytes_per_pixel) as usize;
+        self.pages.push(AtlasPage::new(bytes));
+        self.mark_page_dirty(self.pages.len() - 1);
+    }
 
-        // Copy RGBA bitmap to atlas (4 bytes per pixel)
-        for y in 0..height {
-            let src_offset = (y * width * 4) as usize;
-            let dst_offset = ((region.y + y) * self.width * 4 + region.x * 4) as usize;
-            let row_bytes = (width * 4) as usize;
+    /// Record a modified region for upload, merging it with pending ones
+    fn mark_dirty(&mut self, region: AtlasRegion) {
+        let dirty = &mut self.pages[region.page as usize].dirty;
+        if dirty.iter().any(|r| r.contains(&region)) {
+            return;
+        }
 
-            if src_offset + row_bytes <= bitmap.len() && dst_offset + row_bytes <= self.pixels.len()
-            {
-                self.pixels[dst_offset..dst_offset + row_bytes]
-                    .copy_from_slice(&bitmap[src_offset..src_offset + row_bytes]);
+        // Glyphs on the same shelf are placed left to right
+        if let Some(last) = dirty.last_mut() {
+            if last.y == region.y && last.height == region.height && region.x >= last.x {
+                *last = last.union(&region);
+                return;
             }
         }
 
-        let info = GlyphInfo {
-            region,
-            bearing_x,
-            bearing_y,
-            advance,
-            font_size,
-        };
-
-        self.glyphs.insert(key, info);
-        self.dirty = true;
+        dirty.push(region);
+        if dirty.len() > MAX_DIRTY_RECTS {
+            let bounds = dirty.drain(..).reduce(|a, b| a.union(&b));
+            dirty.extend(bounds);
+        }
+    }
 
-        Ok(info)
+    /// Mark a whole page for upload
+    fn mark_page_dirty(&mut self, page: usize) {
+        let region = AtlasRegion {
+            page: page as u32,
+            x: 0,
+            y: 0,
+            width: self.width,
+            height: self.height,
+        };
+        let dirty = &mut self.pages[page].dirty;
+        dirty.clear();
+        dirty.push(region);
     }
 
     /// Clear all cached glyphs
     pub fn clear(&mut self) {
         self.glyphs.clear();
-        self.shelves.clear();
-        self.pixels.fill(0);
-        self.dirty = true;
+        for p in 0..self.pages.len() {
+            let page = &mut self.pages[p];
+            page.shelves.clear();
+            page.pixels.fill(0);
+            page.glyph_count = 0;
+            self.mark_page_dirty(p);
+        }
     }
 
     /// Get number of cached glyphs
@@ -464,31 +755,296 @@ impl ColorGlyphAtlas {
         self.glyphs.len()
     }
 
-    /// Calculate atlas utilization (0.0 to 1.0)
+    /// Glyphs evicted from all pages so far
+    pub fn evictions(&self) -> u64 {
+        self.pages.iter().map(|page| page.evictions).sum()
+    }
+
+    /// Calculate atlas utilization (0.0 to 1.0), averaged over all pages
     pub fn utilization(&self) -> f32 {
-        let used_height = self.shelves.last().map(|s| s.y + s.height).unwrap_or(0);
-        used_height as f32 / self.height as f32
+        let stats = self.page_stats();
+        stats.iter().map(|s| s.utilization).sum::<f32>() / stats.len().max(1) as f32
     }
-}
 
-impl Default for ColorGlyphAtlas {
-    fn default() -> Self {
-        // Default to 512x512 atlas (1 MB for RGBA)
-        // Color emoji are typically larger so we use a smaller atlas
-        Self::new(512, 512)
+    /// Utilization, glyph count and evictions of each page
+    pub fn page_stats(&self) -> Vec<AtlasPageStats> {
+        let area = (self.width * self.height) as f32;
+        self.pages
+            .iter()
+            .map(|page| {
+                let used: u32 = page
+                    .shelves
+                    .iter()
+                    .map(|s| s.x.min(self.width) * s.height)
+                    .sum();
+                AtlasPageStats {
+                    glyph_count: page.glyph_count,
+                    utilization: (used as f32 / area).min(1.0),
+                    evictions: page.evictions,
+                }
+            })
+            .collect()
+    }
+
+    /// Bytes held by the pixel buffers of all pages
+    pub fn memory_bytes(&self) -> usize {
+        self.pages.iter().map(|page| page.pixels.len()).sum()
+    }
+
+    /// Drop all glyphs and extra pages and reallocate a single page at a
+    /// smaller height to release memory
+    ///
+    /// The atlas grows back towards its original height and page count as
+    /// glyphs are inserted again (see [`grow`](Self::grow)).
+    pub fn shrink(&mut self, height: u32) {
+        self.height = height.clamp(1, self.max_height);
+        self.glyphs.clear();
+        self.pages.clear();
+        self.push_page();
+    }
+
+    /// Double the page height, up to the height the atlas was created with
+    ///
+    /// Shelves span the full width, so extending the bottom keeps every
+    /// cached glyph region valid. Returns false if the atlas can't grow.
+    pub fn grow(&mut self) -> bool {
+        if self.height >= self.max_height {
+            return false;
+        }
+        self.height = (self.height * 2).min(self.max_height);
+        let bytes = (self.width * self.height * self.bytes_per_pixel) as usize;
+        for p in 0..self.pages.len() {
+            self.pages[p].pixels.resize(bytes, 0);
+            self.mark_page_dirty(p);
+        }
+        true
     }
 }
 
-impl std::fmt::Debug for ColorGlyphAtlas {
+impl std::fmt::Debug for PagedAtlas {
     fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
-        f.debug_struct("ColorGlyphAtlas")
+        f.debug_struct("PagedAtlas")
             .field("dimensions", &(self.width, self.height))
+            .field("pages", &self.pages.len())
             .field("glyph_count", &self.glyphs.len())
             .field(
                 "utilization",
                 &format!("{:.1}%", self.utilization() * 100.0),
             )
-            .field("dirty", &self.dirty)
+            .field("evictions", &self.evictions())
+            .field("dirty", &self.is_dirty())
             .finish()
     }
 }
+
+/// Glyph atlas for caching rendered glyphs
+///
+/// Pages hold single channel pixel data (8-bit grayscale or SDF values).
+pub struct GlyphAtlas(PagedAtlas);
+
+impl GlyphAtlas {
+    /// Create a new glyph atlas with pages of `width` x `height` pixels
+    pub fn new(width: u32, height: u32) -> Self {
+        Self(PagedAtlas::new(width, height, 1))
+    }
+}
+
+impl std::ops::Deref for GlyphAtlas {
+    type Target = PagedAtlas;
+
+    fn deref(&self) -> &PagedAtlas {
+        &self.0
+    }
+}
+
+impl std::ops::DerefMut for GlyphAtlas {
+    fn deref_mut(&mut self) -> &mut PagedAtlas {
+        &mut self.0
+    }
+}
+
+impl Default for GlyphAtlas {
+    fn default() -> Self {
+        // Default to 1024x1024 pages (1 MB each)
+        // This supports multiple fonts at various sizes for typical UI usage
+        Self::new(1024, 1024)
+    }
+}
+
+impl std::fmt::Debug for GlyphAtlas {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_tuple("GlyphAtlas").field(&self.0).finish()
+    }
+}
+
+/// Color glyph atlas for RGBA emoji
+///
+/// Similar to GlyphAtlas but stores RGBA pixel data (4 bytes per pixel)
+/// for color emoji and other color glyphs.
+pub struct ColorGlyphAtlas(PagedAtlas);
+
+impl ColorGlyphAtlas {
+    /// Create a new color glyph atlas with pages of `width` x `height` pixels
+    pub fn new(width: u32, height: u32) -> Self {
+        Self(PagedAtlas::new(width, height, 4))
+    }
+}
+
+impl std::ops::Deref for ColorGlyphAtlas {
+    type Target = PagedAtlas;
+
+    fn deref(&self) -> &PagedAtlas {
+        &self.0
+    }
+}
+
+impl std::ops::DerefMut for ColorGlyphAtlas {
+    fn deref_mut(&mut self) -> &mut PagedAtlas {
+        &mut self.0
+    }
+}
+
+impl Default for ColorGlyphAtlas {
+    fn default() -> Self {
+        // Default to 512x512 pages (1 MB each for RGBA)
+        // Color emoji are typically larger so we use a smaller atlas
+        Self::new(512, 512)
+    }
+}
+
+impl std::fmt::Debug for ColorGlyphAtlas {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_tuple("ColorGlyphAtlas").field(&self.0).finish()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn insert(atlas: &mut GlyphAtlas, glyph_id: u16) -> Result<GlyphInfo> {
+        atlas.insert_glyph(0, glyph_id, 16.0, 10, 10, 0, 0, 10, &[255; 100])
+    }
+
+    #[test]
+    fn test_shrink_releases_memory() {
+        let mut atlas = GlyphAtlas::new(64, 64);
+        insert(&mut atlas, 1).unwrap();
+        atlas.shrink(16);
+        assert_eq!(atlas.dimensions(), (64, 16));
+        assert_eq!(atlas.memory_bytes(), 64 * 16);
+        assert_eq!(atlas.glyph_count(), 0);
+    }
+
+    #[test]
+    fn test_grow_keeps_glyphs() {
+        let mut atlas = GlyphAtlas::new(64, 64);
+        atlas.shrink(16);
+        let first = insert(&mut atlas, 1).unwrap();
+
+        // Second shelf doesn't fit in 16 rows, so the page grows
+        for id in 2..=6 {
+            insert(&mut atlas, id).unwrap();
+        }
+        assert_eq!(atlas.dimensions(), (64, 32));
+        assert_eq!(atlas.page_count(), 1);
+        assert_eq!(atlas.page_pixels(0)[0], 255);
+        assert_eq!(
+            atlas.get_glyph(0, 1, 16.0).unwrap().region.y,
+            first.region.y
+        );
+
+        assert!(atlas.grow());
+        assert!(!atlas.grow());
+        assert_eq!(atlas.dimensions(), (64, 64));
+    }
+
+    #[test]
+    fn test_texel_bounds_survive_grow() {
+        let mut atlas = GlyphAtlas::new(64, 64);
+        atlas.shrink(16);
+        let first = insert(&mut atlas, 1).unwrap();
+        let shrunk_uv = first.region.uv_bounds(64, 16);
+
+        // Allocating past the shrunken height doubles the page height
+        let mut last = first;
+        for id in 2..=6 {
+            last = insert(&mut atlas, id).unwrap();
+        }
+        assert_eq!(atlas.dimensions(), (64, 32));
+        assert!(last.region.y + last.region.height > 16);
+
+        // Normalized UVs taken before the grow are now off by the height
+        // change; texel bounds normalized against the grown page are not
+        let (width, height) = atlas.dimensions();
+        let texels = first.region.texel_bounds();
+        assert_eq!(texels, [0.0, 0.0, 10.0, 10.0]);
+        let uv = [
+            texels[0] / width as f32,
+            texels[1] / height as f32,
+            texels[2] / width as f32,
+            texels[3] / height as f32,
+        ];
+        assert_eq!(uv, first.region.uv_bounds(width, height));
+        assert_ne!(uv, shrunk_uv);
+        assert_eq!(
+            last.region.texel_bounds()[3],
+            (last.region.y + last.region.height) as f32
+        );
+    }
+
+    #[test]
+    fn test_full_atlas_adds_pages_then_evicts_cold_shelf() {
+        // 25 padded 10x10 glyphs fit on a 64x64 page
+        let mut atlas = GlyphAtlas::new(64, 64);
+        atlas.set_max_pages(2);
+        atlas.begin_frame_for(1);
+        for id in 0..50 {
+            insert(&mut atlas, id).unwrap();
+        }
+        assert_eq!(atlas.page_count(), 2);
+
+        // Everything was used this frame, so nothing can be evicted
+        assert!(matches!(insert(&mut atlas, 50), Err(TextError::AtlasFull)));
+
+        // Nor while that frame is open, however many frames other contexts
+        // sharing the atlas start meanwhile
+        for _ in 0..2 {
+            atlas.begin_frame_for(2);
+            atlas.begin_frame_for(3);
+        }
+        assert!(matches!(insert(&mut atlas, 50), Err(TextError::AtlasFull)));
+
+        atlas.end_frame_for(1);
+        atlas.lookup(0, 0, 16.0).unwrap();
+        let info = insert(&mut atlas, 50).unwrap();
+
+        // The first shelf is still hot, so the second one is reused
+        assert_eq!((info.region.page, info.region.x, info.region.y), (0, 0, 12));
+        assert!(atlas.get_glyph(0, 0, 16.0).is_some());
+        assert!(atlas.get_glyph(0, 5, 16.0).is_none());
+        assert_eq!(atlas.page_stats()[0].evictions, 5);
+        assert_eq!(atlas.page_stats()[0].glyph_count, 21);
+        assert_eq!(atlas.glyph_count(), 46);
+    }
+
+    #[test]
+    fn test_dirty_regions_cover_new_glyphs() {
+        let mut atlas = GlyphAtlas::new(64, 64);
+        atlas.mark_clean();
+        insert(&mut atlas, 1).unwrap();
+        insert(&mut atlas, 2).unwrap();
+
+        assert_eq!(
+            atlas.take_dirty_regions(),
+            vec![AtlasRegion {
+                page: 0,
+                x: 0,
+                y: 0,
+                width: 22,
+                height: 10,
+            }]
+        );
+        assert!(!atlas.is_dirty());
+    }
+}
@@ -3,8 +3,12 @@
 //! Provides font parsing via ttf-parser and font metric extraction.
 
 use crate::{Result, TextError};
+use std::sync::atomic::{AtomicU64, Ordering};
 use std::sync::Arc;
 
+/// Source of `FontFace::id` values
+static NEXT_FACE_ID: AtomicU64 = AtomicU64::new(1);
+
 /// Font data that can be either owned or memory-mapped.
 ///
 /// This avoids copying 180MB+ font files when using memory-mapped sources.
@@ -150,6 +154,8 @@ impl FontMetrics {
 
 /// A parsed font face
 pub struct FontFace {
+    /// Identity of this loaded face, unique for the process lifetime
+    id: u64,
     /// Raw font data (kept alive for ttf-parser) - can be owned or memory-mapped
     data: FontData,
     /// Face index within the font file (for TTC files)
@@ -226,6 +232,7 @@ impl FontFace {
         let glyph_count = face.number_of_glyphs();
 
         Ok(Self {
+            id: NEXT_FACE_ID.fetch_add(1, Ordering::Relaxed),
             data,
             face_index,
             metrics,
@@ -268,6 +275,14 @@ impl FontFace {
         self.style
     }
 
+    /// Identity of this loaded face
+    ///
+    /// Unique per `FontFace` instance (never reused), so caches can key on it
+    /// without holding the face alive.
+    pub fn id(&self) -> u64 {
+        self.id
+    }
+
     /// Get raw font data for shaping
     pub fn data(&self) -> &[u8] {
         self.data.as_bytes()
@@ -128,6 +128,14 @@ impl TextLayoutEngine {
         }
     }
 
+    /// Shape independent runs ahead of layout, in parallel when large
+    ///
+    /// Results land in the shape cache, so later `layout` calls for these
+    /// runs (with the same font and size) skip shaping.
+    pub fn shape_batch(&self, texts: &[&str], font: &FontFace, font_size: f32) {
+        self.shaper.shape_batch(texts, font, font_size);
+    }
+
     /// Layout text with the given options
     pub fn layout(
         &self,
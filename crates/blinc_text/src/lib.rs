@@ -30,7 +30,10 @@ pub mod shaper;
 
 use std::sync::{Arc, Mutex, OnceLock};
 
-pub use atlas::{AtlasRegion, ColorGlyphAtlas, GlyphAtlas, GlyphInfo};
+pub use atlas::{
+    AtlasPageStats, AtlasRegion, ColorGlyphAtlas, FrameClient, GlyphAtlas, GlyphInfo, PagedAtlas,
+    DEFAULT_FRAME_CLIENT,
+};
 pub use emoji::{contains_emoji, is_emoji, EmojiRenderer, EmojiSprite};
 pub use font::{Font, FontFace, FontMetrics, FontStyle, FontWeight};
 
@@ -61,16 +64,30 @@ pub fn global_font_registry() -> Arc<Mutex<registry::FontRegistry>> {
     )
 }
 
+/// Global shared shape cache singleton.
+///
+/// Every `TextShaper::new()` (and so every `TextLayoutEngine`) shapes through
+/// this cache, so the text measurer and the renderer shape each run once
+/// and reuse it across frames.
+static GLOBAL_SHAPE_CACHE: OnceLock<Arc<shaper::ShapeCache>> = OnceLock::new();
+
+/// Get the global shared shape cache.
+pub fn global_shape_cache() -> Arc<shaper::ShapeCache> {
+    Arc::clone(GLOBAL_SHAPE_CACHE.get_or_init(|| Arc::new(shaper::ShapeCache::default())))
+}
+
 // Re-export html-escape for entity decoding
 pub use html_escape::decode_html_entities;
 pub use layout::{
     LayoutOptions, LineBreakMode, PositionedGlyph, TextAlignment, TextAnchor, TextLayout,
     TextLayoutEngine,
 };
-pub use rasterizer::{GlyphFormat, GlyphRasterizer, RasterizedGlyph};
+pub use rasterizer::{GlyphFormat, GlyphRasterizer, RasterizedGlyph, SDF_SPREAD};
 pub use registry::{FontRegistry, GenericFont};
 pub use renderer::{ColorSpan, GlyphInstance, PreparedText, TextRenderer};
-pub use shaper::{ShapedGlyph, ShapedText, TextShaper};
+pub use shaper::{
+    ShapeCache, ShapeCacheStats, ShapedGlyph, ShapedText, TextShaper, DEFAULT_SHAPE_CACHE_CAPACITY,
+};
 
 use thiserror::Error;
 
@@ -3,13 +3,23 @@
 //! Converts font glyph outlines to bitmap images for the glyph atlas.
 //! Uses swash for high-quality, accurate glyph rendering.
 //!
-//! Supports both grayscale alpha glyphs (for text) and RGBA color emoji.
+//! Supports grayscale alpha glyphs (for text), RGBA color emoji and
+//! signed distance fields for text drawn at arbitrary scales.
 
 use crate::font::FontFace;
 use crate::{Result, TextError};
 use swash::scale::{Render, ScaleContext, Source, StrikeWith};
 use swash::zeno::Format;
 
+/// Distance (in SDF texels) encoded on each side of a glyph outline
+///
+/// SDF bitmaps are padded by this many texels. A texel value of 0.5 lies on
+/// the outline; 0.0 and 1.0 are `SDF_SPREAD` texels outside and inside.
+pub const SDF_SPREAD: u32 = 4;
+
+/// Outline supersampling used when computing distance fields
+const SDF_SUPERSAMPLE: u32 = 4;
+
 /// Format of the rasterized glyph bitmap
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
 pub enum GlyphFormat {
@@ -17,6 +27,8 @@ pub enum GlyphFormat {
     Alpha,
     /// RGBA color (for color emoji)
     Rgba,
+    /// Single-channel signed distance field (see [`SDF_SPREAD`])
+    Sdf,
 }
 
 /// Rasterized glyph bitmap with metrics
@@ -218,6 +230,159 @@ impl GlyphRasterizer {
             }),
         }
     }
+
+    /// Rasterize a glyph as a single-channel signed distance field
+    ///
+    /// The outline is rendered at `SDF_SUPERSAMPLE` times `font_size`, and the
+    /// exact distance to its edge is sampled back at `font_size`. The result
+    /// is padded by `SDF_SPREAD` texels on every side (included in the
+    /// bearings) and can be drawn at any scale with a smoothstep on 0.5.
+    pub fn rasterize_sdf(
+        &mut self,
+        font: &FontFace,
+        glyph_id: u16,
+        font_size: f32,
+    ) -> Result<RasterizedGlyph> {
+        let mut glyph = self.rasterize(font, glyph_id, font_size * SDF_SUPERSAMPLE as f32)?;
+        let advance = (glyph.advance as f32 / SDF_SUPERSAMPLE as f32).round() as u16;
+        if glyph.width == 0 || glyph.height == 0 {
+            glyph.advance = advance;
+            return Ok(glyph);
+        }
+
+        let ss = SDF_SUPERSAMPLE as i32;
+        let spread = SDF_SPREAD as i32;
+
+        // Output grid in font_size pixels (y down, relative to the pen position),
+        // snapped to whole texels and padded by the spread
+        let left = glyph.bearing_x as i32;
+        let top = -(glyph.bearing_y as i32);
+        let x0 = left.div_euclid(ss) - spread;
+        let y0 = top.div_euclid(ss) - spread;
+        let x1 = (left + glyph.width as i32 + ss - 1).div_euclid(ss) + spread;
+        let y1 = (top + glyph.height as i32 + ss - 1).div_euclid(ss) + spread;
+        let (width, height) = ((x1 - x0) as usize, (y1 - y0) as usize);
+
+        // Supersampled mask aligned with the output grid
+        let (hi_w, hi_h) = (width * ss as usize, height * ss as usize);
+        let (off_x, off_y) = ((left - x0 * ss) as usize, (top - y0 * ss) as usize);
+        let mut inside = vec![false; hi_w * hi_h];
+        for row in 0..glyph.height as usize {
+            for col in 0..glyph.width as usize {
+                let coverage = glyph.bitmap[row * glyph.width as usize + col];
+                inside[(row + off_y) * hi_w + off_x + col] = coverage >= 128;
+            }
+        }
+
+        let to_inside = squared_distance_transform(&inside, hi_w, hi_h, true);
+        let to_outside = squared_distance_transform(&inside, hi_w, hi_h, false);
+        let signed_distance = |i: usize| {
+            // Distances are between pixel centers; the edge is half a pixel closer
+            if inside[i] {
+                0.5 - to_outside[i].sqrt()
+            } else {
+                to_inside[i].sqrt() - 0.5
+            }
+        };
+
+        // Average the four supersampled pixels around each texel center
+        let half = ss as usize / 2;
+        let mut bitmap = Vec::with_capacity(width * height);
+        for y in 0..height {
+            for x in 0..width {
+                let (cx, cy) = (x * ss as usize + half, y * ss as usize + half);
+                let distance = (signed_distance((cy - 1) * hi_w + cx - 1)
+                    + signed_distance((cy - 1) * hi_w + cx)
+                    + signed_distance(cy * hi_w + cx - 1)
+                    + signed_distance(cy * hi_w + cx))
+                    / (4.0 * ss as f32);
+                let value = 0.5 - distance / (2.0 * SDF_SPREAD as f32);
+                bitmap.push((value.clamp(0.0, 1.0) * 255.0).round() as u8);
+            }
+        }
+
+        Ok(RasterizedGlyph {
+            bitmap,
+            width: width as u32,
+            height: height as u32,
+            bearing_x: x0 as i16,
+            bearing_y: -y0 as i16,
+            advance,
+            format: GlyphFormat::Sdf,
+        })
+    }
+}
+
+/// Squared Euclidean distance from every pixel to the nearest pixel whose
+/// mask value equals `target` (Felzenszwalb & Huttenlocher, exact, O(n))
+fn squared_distance_transform(
+    mask: &[bool],
+    width: usize,
+    height: usize,
+    target: bool,
+) -> Vec<f32> {
+    const INF: f32 = 1e20;
+    let mut grid: Vec<f32> = mask
+        .iter()
+        .map(|&m| if m == target { 0.0 } else { INF })
+        .collect();
+
+    let n = width.max(height);
+    let mut f = vec![0.0; n];
+    let mut d = vec![0.0; n];
+    let mut v = vec![0usize; n];
+    let mut z = vec![0.0; n + 1];
+
+    for x in 0..width {
+        for y in 0..height {
+            f[y] = grid[y * width + x];
+        }
+        distance_transform_1d(&f[..height], &mut d[..height], &mut v, &mut z);
+        for y in 0..height {
+            grid[y * width + x] = d[y];
+        }
+    }
+    for y in 0..height {
+        f[..width].copy_from_slice(&grid[y * width..(y + 1) * width]);
+        distance_transform_1d(&f[..width], &mut d[..width], &mut v, &mut z);
+        grid[y * width..(y + 1) * width].copy_from_slice(&d[..width]);
+    }
+    grid
+}
+
+/// 1D squared distance transform of sampled function `f` into `d`
+fn distance_transform_1d(f: &[f32], d: &mut [f32], v: &mut [usize], z: &mut [f32]) {
+    let n = f.len();
+    if n == 0 {
+        return;
+    }
+    let mut k = 0;
+    v[0] = 0;
+    z[0] = f32::NEG_INFINITY;
+    z[1] = f32::INFINITY;
+    for q in 1..n {
+        let intersect =
+            |p: usize| ((f[q] + (q * q) as f32) - (f[p] + (p * p) as f32)) / (2 * q - 2 * p) as f32;
+        let mut s = intersect(v[k]);
+        // z[0] is -inf, so this stops at k == 0
+        while s <= z[k] {
+            k -= 1;
+            s = intersect(v[k]);
+        }
+        k += 1;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = f32::INFINITY;
+    }
+    k = 0;
+    for (q, out) in d.iter_mut().enumerate() {
+        while z[k + 1] < q as f32 {
+            k += 1;
+        }
+        let p = v[k];
+        let dq = q as f32 - p as f32;
+        *out = dq * dq + f[p];
+    }
 }
 
 impl Default for GlyphRasterizer {
@@ -234,4 +399,16 @@ mod tests {
     fn test_rasterizer_creation() {
         let _rasterizer = GlyphRasterizer::new();
     }
+
+    #[test]
+    fn test_distance_transform_is_exact() {
+        // Single target pixel in the middle of a 5x5 grid
+        let mut mask = vec![false; 25];
+        mask[12] = true;
+        let dist = squared_distance_transform(&mask, 5, 5, true);
+        assert_eq!(dist[12], 0.0);
+        assert_eq!(dist[13], 1.0);
+        assert_eq!(dist[18], 2.0);
+        assert_eq!(dist[0], 8.0);
+    }
 }
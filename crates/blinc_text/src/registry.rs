@@ -178,10 +178,60 @@ impl FontRegistry {
         let loaded = after - before;
         if loaded > 0 {
             tracing::debug!("Loaded {} font faces from data", loaded);
+            self.forget_missing_fonts();
         }
         loaded
     }
 
+    /// Register a font file by path without reading it into memory
+    ///
+    /// fontdb maps the file just long enough to parse its table directory
+    /// and names. Glyph data is mapped again when a face is first used (see
+    /// `load_face_by_id`). Already registered files are skipped.
+    ///
+    /// Returns the number of font faces added.
+    pub fn load_font_file(&mut self, path: &Path) -> usize {
+        let already_loaded = self
+            .db
+            .faces()
+            .any(|face| matches!(&face.source, Source::File(p) if p == path));
+        if already_loaded {
+            return 0;
+        }
+
+        let before = self.db.faces().count();
+        if let Err(e) = self.db.load_font_file(path) {
+            tracing::warn!("Failed to register font file {:?}: {}", path, e);
+            return 0;
+        }
+        let loaded = self.db.faces().count() - before;
+        if loaded > 0 {
+            tracing::debug!("Registered {} font faces from {:?}", loaded, path);
+            self.forget_missing_fonts();
+        }
+        loaded
+    }
+
+    /// Register font data owned elsewhere (e.g. an mmap or a platform buffer)
+    ///
+    /// The data is shared, not copied, and stays alive as long as any face
+    /// loaded from it does.
+    ///
+    /// Returns the number of font faces added.
+    pub fn load_font_shared(&mut self, data: Arc<dyn AsRef<[u8]> + Send + Sync>) -> usize {
+        let loaded = self.db.load_font_source(Source::Binary(data)).len();
+        if loaded > 0 {
+            tracing::debug!("Loaded {} font faces from shared data", loaded);
+            self.forget_missing_fonts();
+        }
+        loaded
+    }
+
+    /// Drop cached failed lookups so newly registered faces can be found
+    fn forget_missing_fonts(&mut self) {
+        self.faces.retain(|_, face| face.is_some());
+    }
+
     /// Ensure all system fonts are loaded (lazy initialization)
     ///
     /// Called automatically when a font lookup fails.
@@ -934,6 +984,67 @@ mod tests {
         }
     }
 
+    /// Font bundled with the iOS example app
+    fn bundled_font_data() -> Option<Vec<u8>> {
+        let path = Path::new(env!("CARGO_MANIFEST_DIR"))
+            .join("../../mobile/example/platforms/ios/BlincApp/Fonts/Arial.ttf");
+        std::fs::read(path).ok()
+    }
+
+    /// Font bytes owned by the caller, like the buffers iOS passes to
+    /// `blinc_load_font_from_memory`
+    struct ForeignBytes {
+        data: Vec<u8>,
+        released: Arc<std::sync::atomic::AtomicBool>,
+    }
+
+    impl AsRef<[u8]> for ForeignBytes {
+        fn as_ref(&self) -> &[u8] {
+            &self.data
+        }
+    }
+
+    impl Drop for ForeignBytes {
+        fn drop(&mut self) {
+            self.released
+                .store(true, std::sync::atomic::Ordering::SeqCst);
+        }
+    }
+
+    #[test]
+    fn test_shared_font_data_resolves_family() {
+        let Some(data) = bundled_font_data() else {
+            println!("Bundled font not found - skipping test");
+            return;
+        };
+        let mut registry = FontRegistry::new();
+
+        // A failed lookup before registration must not stick
+        let found_before = registry.load_font("Arial").is_ok();
+
+        let released = Arc::new(std::sync::atomic::AtomicBool::new(false));
+        let bytes = ForeignBytes {
+            data,
+            released: Arc::clone(&released),
+        };
+        assert!(registry.load_font_shared(Arc::new(bytes)) > 0);
+        assert!(registry.db.faces().any(|face| {
+            matches!(face.source, Source::Binary(_))
+                && face.families.iter().any(|(name, _)| name == "Arial")
+        }));
+
+        let face = registry
+            .load_font("Arial")
+            .unwrap_or_else(|e| panic!("Arial not found (found before: {found_before}): {e:?}"));
+        assert_eq!(face.family_name(), "Arial");
+
+        // The bytes stay with the registry and are handed back once it goes
+        assert!(!released.load(std::sync::atomic::Ordering::SeqCst));
+        drop(face);
+        drop(registry);
+        assert!(released.load(std::sync::atomic::Ordering::SeqCst));
+    }
+
     #[test]
     fn test_list_families() {
         let mut registry = FontRegistry::new();
@@ -1175,9 +1286,9 @@ mod tests {
             Ok(prepared) => {
                 println!("Prepared {} glyphs for 'SF Mono':", prepared.glyphs.len());
                 for (i, glyph) in prepared.glyphs.iter().enumerate() {
-                    println!("  [{}] bounds=[{:.1}, {:.1}, {:.1}, {:.1}], uv=[{:.4}, {:.4}, {:.4}, {:.4}]",
+                    println!("  [{}] bounds=[{:.1}, {:.1}, {:.1}, {:.1}], texels=[{:.1}, {:.1}, {:.1}, {:.1}]",
                         i, glyph.bounds[0], glyph.bounds[1], glyph.bounds[2], glyph.bounds[3],
-                        glyph.uv_bounds[0], glyph.uv_bounds[1], glyph.uv_bounds[2], glyph.uv_bounds[3]);
+                        glyph.texel_bounds[0], glyph.texel_bounds[1], glyph.texel_bounds[2], glyph.texel_bounds[3]);
                 }
             }
             Err(e) => {
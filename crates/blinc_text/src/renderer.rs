@@ -6,7 +6,9 @@
 //! Supports automatic emoji font fallback - when the primary font doesn't
 //! have a glyph for an emoji character, the system emoji font is used.
 
-use crate::atlas::{ColorGlyphAtlas, GlyphAtlas, GlyphInfo};
+use crate::atlas::{
+    AtlasPageStats, AtlasRegion, ColorGlyphAtlas, FrameClient, GlyphAtlas, GlyphInfo,
+};
 use crate::emoji::{is_emoji, is_variation_selector, is_zwj};
 use crate::font::FontFace;
 use crate::layout::{LayoutOptions, PositionedGlyph, TextLayoutEngine};
@@ -14,27 +16,37 @@ use crate::rasterizer::GlyphRasterizer;
 use crate::registry::{FontRegistry, GenericFont};
 use crate::shaper::TextShaper;
 use crate::{Result, TextError};
-use lru::LruCache;
-use std::num::NonZeroUsize;
 use std::sync::Arc;
 
-/// Maximum number of glyphs to keep in the grayscale glyph cache
-const GLYPH_CACHE_CAPACITY: usize = 2048;
+/// Atlas height after `TextRenderer::shrink_atlases` (grows back on demand)
+const MIN_ATLAS_HEIGHT: u32 = 128;
 
-/// Maximum number of color glyphs (emoji) to keep in cache
-const COLOR_GLYPH_CACHE_CAPACITY: usize = 512;
+/// Font sizes SDF glyphs are rasterized at
+///
+/// Text uses the smallest bucket at least as large as its font size (or the
+/// largest bucket), so scaling text only rasterizes again when it crosses
+/// a bucket boundary.
+const SDF_SIZE_BUCKETS: [f32; 3] = [32.0, 64.0, 128.0];
 
 /// A GPU glyph instance for rendering
 #[derive(Debug, Clone, Copy)]
 pub struct GlyphInstance {
     /// Position and size in pixels (x, y, width, height)
     pub bounds: [f32; 4],
-    /// UV coordinates in atlas (u_min, v_min, u_max, v_max)
-    pub uv_bounds: [f32; 4],
+    /// Texel coordinates in the atlas page (x_min, y_min, x_max, y_max)
+    ///
+    /// Shaders normalize these against the bound atlas texture, so glyphs
+    /// prepared before the atlas grows keep sampling the right region.
+    pub texel_bounds: [f32; 4],
     /// Text color (RGBA, 0.0-1.0)
     pub color: [f32; 4],
     /// Whether this glyph is from the color atlas (emoji)
     pub is_color: bool,
+    /// Atlas page (texture array layer) holding the glyph
+    pub page: u32,
+    /// Whether the atlas region holds a signed distance field
+    /// (see `rasterizer::SDF_SPREAD`) instead of coverage
+    pub sdf: bool,
 }
 
 /// Result of preparing text for rendering
@@ -78,11 +90,8 @@ pub struct TextRenderer {
     rasterizer: GlyphRasterizer,
     /// Text layout engine
     layout_engine: TextLayoutEngine,
-    /// LRU cache for grayscale glyphs: (font_id, glyph_id, quantized_size) -> atlas info
-    /// font_id is hash of font name or 0 for default
-    glyph_cache: LruCache<(u32, u16, u16), GlyphInfo>,
-    /// LRU cache for color glyphs (emoji) - same key format
-    color_glyph_cache: LruCache<(u32, u16, u16), GlyphInfo>,
+    /// Font size from which glyphs are drawn from SDFs (None = bitmaps only)
+    sdf_min_size: Option<f32>,
 }
 
 impl TextRenderer {
@@ -98,10 +107,7 @@ impl TextRenderer {
             color_atlas: ColorGlyphAtlas::default(),
             rasterizer: GlyphRasterizer::new(),
             layout_engine: TextLayoutEngine::new(),
-            glyph_cache: LruCache::new(NonZeroUsize::new(GLYPH_CACHE_CAPACITY).unwrap()),
-            color_glyph_cache: LruCache::new(
-                NonZeroUsize::new(COLOR_GLYPH_CACHE_CAPACITY).unwrap(),
-            ),
+            sdf_min_size: None,
         }
     }
 
@@ -117,10 +123,7 @@ impl TextRenderer {
             color_atlas: ColorGlyphAtlas::default(),
             rasterizer: GlyphRasterizer::new(),
             layout_engine: TextLayoutEngine::new(),
-            glyph_cache: LruCache::new(NonZeroUsize::new(GLYPH_CACHE_CAPACITY).unwrap()),
-            color_glyph_cache: LruCache::new(
-                NonZeroUsize::new(COLOR_GLYPH_CACHE_CAPACITY).unwrap(),
-            ),
+            sdf_min_size: None,
         }
     }
 
@@ -135,10 +138,7 @@ impl TextRenderer {
             color_atlas: ColorGlyphAtlas::default(),
             rasterizer: GlyphRasterizer::new(),
             layout_engine: TextLayoutEngine::new(),
-            glyph_cache: LruCache::new(NonZeroUsize::new(GLYPH_CACHE_CAPACITY).unwrap()),
-            color_glyph_cache: LruCache::new(
-                NonZeroUsize::new(COLOR_GLYPH_CACHE_CAPACITY).unwrap(),
-            ),
+            sdf_min_size: None,
         }
     }
 
@@ -178,6 +178,41 @@ impl TextRenderer {
         registry.load_font_data(data)
     }
 
+    /// Register a font file in the registry by path (mapped lazily, not read)
+    ///
+    /// Returns the number of font faces added.
+    pub fn load_font_file_to_registry(&mut self, path: &std::path::Path) -> usize {
+        let mut registry = self.font_registry.lock().unwrap();
+        registry.load_font_file(path)
+    }
+
+    /// Register font data owned elsewhere in the registry without copying it
+    ///
+    /// Returns the number of font faces added.
+    pub fn load_shared_font_data_to_registry(
+        &mut self,
+        data: Arc<dyn AsRef<[u8]> + Send + Sync>,
+    ) -> usize {
+        let mut registry = self.font_registry.lock().unwrap();
+        registry.load_font_shared(data)
+    }
+
+    /// Draw text at or above `min_size` pixels from signed distance fields
+    ///
+    /// SDF glyphs are rasterized once per size bucket and scaled on the GPU,
+    /// so animated or zoomed text doesn't rasterize new bitmaps at every
+    /// size step. Smaller text keeps hinted bitmaps, which look sharper at
+    /// body sizes. `None` (the default) disables SDF text; `Some(0.0)` uses
+    /// it for all text. Color emoji are always bitmaps.
+    pub fn set_sdf_min_size(&mut self, min_size: Option<f32>) {
+        self.sdf_min_size = min_size;
+    }
+
+    /// Font size from which text is drawn from SDFs, if enabled
+    pub fn sdf_min_size(&self) -> Option<f32> {
+        self.sdf_min_size
+    }
+
     /// Get the glyph atlas (grayscale)
     pub fn atlas(&self) -> &GlyphAtlas {
         &self.atlas
@@ -218,14 +253,62 @@ impl TextRenderer {
         self.color_atlas.mark_clean();
     }
 
-    /// Get atlas pixel data for GPU upload (grayscale)
-    pub fn atlas_pixels(&self) -> &[u8] {
-        self.atlas.pixels()
+    /// Take the atlas regions modified since the last upload (grayscale)
+    pub fn take_atlas_dirty_regions(&mut self) -> Vec<AtlasRegion> {
+        self.atlas.take_dirty_regions()
+    }
+
+    /// Take the color atlas regions modified since the last upload (RGBA)
+    pub fn take_color_atlas_dirty_regions(&mut self) -> Vec<AtlasRegion> {
+        self.color_atlas.take_dirty_regions()
+    }
+
+    /// Get atlas pixel data of one page for GPU upload (grayscale)
+    pub fn atlas_page_pixels(&self, page: u32) -> &[u8] {
+        self.atlas.page_pixels(page)
     }
 
-    /// Get color atlas pixel data for GPU upload (RGBA)
-    pub fn color_atlas_pixels(&self) -> &[u8] {
-        self.color_atlas.pixels()
+    /// Get color atlas pixel data of one page for GPU upload (RGBA)
+    pub fn color_atlas_page_pixels(&self, page: u32) -> &[u8] {
+        self.color_atlas.page_pixels(page)
+    }
+
+    /// Number of atlas pages (grayscale)
+    pub fn atlas_page_count(&self) -> u32 {
+        self.atlas.page_count()
+    }
+
+    /// Number of color atlas pages (RGBA)
+    pub fn color_atlas_page_count(&self) -> u32 {
+        self.color_atlas.page_count()
+    }
+
+    /// Per-page utilization and eviction counts of the (grayscale, color) atlases
+    pub fn atlas_page_stats(&self) -> (Vec<AtlasPageStats>, Vec<AtlasPageStats>) {
+        (self.atlas.page_stats(), self.color_atlas.page_stats())
+    }
+
+    /// Start a new frame
+    ///
+    /// Glyphs used during the current frame are never evicted from the
+    /// atlases, so call this once per frame before preparing text.
+    pub fn begin_frame(&mut self) {
+        self.atlas.begin_frame();
+        self.color_atlas.begin_frame();
+    }
+
+    /// Start a frame for one of several contexts sharing the atlases
+    ///
+    /// Glyphs used until the matching `end_frame_for` are never evicted.
+    pub fn begin_frame_for(&mut self, client: FrameClient) {
+        self.atlas.begin_frame_for(client);
+        self.color_atlas.begin_frame_for(client);
+    }
+
+    /// End a frame started with `begin_frame_for` once it was submitted
+    pub fn end_frame_for(&mut self, client: FrameClient) {
+        self.atlas.end_frame_for(client);
+        self.color_atlas.end_frame_for(client);
     }
 
     /// Get atlas dimensions
@@ -352,8 +435,6 @@ impl TextRenderer {
 
         // Convert to GPU glyph instances
         let mut glyphs = Vec::with_capacity(positioned_glyphs.len());
-        let atlas_dims = self.atlas.dimensions();
-        let color_atlas_dims = self.color_atlas.dimensions();
 
         // Track glyph info along with whether it's a color glyph
         // (GlyphInfo, PositionedGlyph, is_color)
@@ -493,7 +574,8 @@ impl TextRenderer {
 
                                 // Calculate advance correction
                                 // The fallback font's advance tells us how much space this glyph needs
-                                let fallback_advance = glyph_info.advance as f32;
+                                let fallback_advance =
+                                    glyph_info.advance as f32 * glyph_info.scale_for(font_size);
 
                                 // Calculate what advance the primary font thought this character had
                                 // by looking at the distance to the next glyph
@@ -551,25 +633,20 @@ impl TextRenderer {
             // Calculate screen position
             // positioned.x is the pen position from the shaper (includes advance)
             // bearing_x is the offset from pen position to the glyph's left edge
-            let x = data.positioned.x + data.info.bearing_x as f32;
-            let y = data.positioned.y - data.info.bearing_y as f32;
-            let w = data.info.region.width as f32;
-            let h = data.info.region.height as f32;
-
-            // Get UV coordinates from the appropriate atlas
-            let uv = if data.is_color {
-                data.info
-                    .region
-                    .uv_bounds(color_atlas_dims.0, color_atlas_dims.1)
-            } else {
-                data.info.region.uv_bounds(atlas_dims.0, atlas_dims.1)
-            };
+            // SDF glyphs are scaled from their size bucket
+            let scale = data.info.scale_for(font_size);
+            let x = data.positioned.x + data.info.bearing_x as f32 * scale;
+            let y = data.positioned.y - data.info.bearing_y as f32 * scale;
+            let w = data.info.region.width as f32 * scale;
+            let h = data.info.region.height as f32 * scale;
 
             glyphs.push(GlyphInstance {
                 bounds: [x, y, w, h],
-                uv_bounds: uv,
+                texel_bounds: data.info.region.texel_bounds(),
                 color,
                 is_color: data.is_color,
+                page: data.info.region.page,
+                sdf: data.info.sdf,
             });
         }
 
@@ -628,7 +705,6 @@ impl TextRenderer {
 
         // Convert to GPU glyph instances
         let mut glyphs = Vec::with_capacity(positioned_glyphs.len());
-        let atlas_dims = self.atlas.dimensions();
 
         // First pass: rasterize all glyphs
         let mut glyph_infos: Vec<Option<GlyphInfo>> = Vec::with_capacity(positioned_glyphs.len());
@@ -671,18 +747,19 @@ impl TextRenderer {
 
             // positioned.x is the pen position from the shaper
             // bearing_x is the offset from pen position to the glyph's left edge
-            let x = positioned.x + glyph_info.bearing_x as f32;
-            let y = positioned.y - glyph_info.bearing_y as f32;
-            let w = glyph_info.region.width as f32;
-            let h = glyph_info.region.height as f32;
-
-            let uv = glyph_info.region.uv_bounds(atlas_dims.0, atlas_dims.1);
+            let scale = glyph_info.scale_for(font_size);
+            let x = positioned.x + glyph_info.bearing_x as f32 * scale;
+            let y = positioned.y - glyph_info.bearing_y as f32 * scale;
+            let w = glyph_info.region.width as f32 * scale;
+            let h = glyph_info.region.height as f32 * scale;
 
             glyphs.push(GlyphInstance {
                 bounds: [x, y, w, h],
-                uv_bounds: uv,
+                texel_bounds: glyph_info.region.texel_bounds(),
                 color,
                 is_color: false,
+                page: glyph_info.region.page,
+                sdf: glyph_info.sdf,
             });
         }
 
@@ -807,52 +884,66 @@ impl TextRenderer {
         glyph_id: u16,
         font_size: f32,
     ) -> Result<GlyphInfo> {
-        // Quantize font size for cache key (0.5px granularity)
-        let size_key = (font_size * 2.0).round() as u16;
-        let cache_key = (font_id, glyph_id, size_key);
+        if self.sdf_min_size.is_some_and(|min| font_size >= min) {
+            return self.rasterize_sdf_glyph_for_font(font, font_id, glyph_id, font_size);
+        }
 
-        // Check cache first (LruCache::get promotes to most-recently-used)
-        if let Some(info) = self.glyph_cache.get(&cache_key) {
-            return Ok(*info);
+        // Check the atlas first (marks the glyph as used this frame)
+        if let Some(info) = self.atlas.lookup(font_id, glyph_id, font_size) {
+            return Ok(info);
         }
 
         // Rasterize the glyph
         let rasterized = self.rasterizer.rasterize(font, glyph_id, font_size)?;
 
-        // Handle empty glyphs (like space)
-        if rasterized.width == 0 || rasterized.height == 0 {
-            let info = GlyphInfo {
-                region: crate::atlas::AtlasRegion {
-                    x: 0,
-                    y: 0,
-                    width: 0,
-                    height: 0,
-                },
-                bearing_x: rasterized.bearing_x,
-                bearing_y: rasterized.bearing_y,
-                advance: rasterized.advance,
-                font_size,
-            };
-            // LruCache::put evicts oldest entry if at capacity
-            self.glyph_cache.put(cache_key, info);
+        // Insert into atlas; empty glyphs (like space) are cached without
+        // using atlas space. A full atlas grows, adds pages or evicts cold
+        // glyphs as needed.
+        self.atlas.insert_glyph(
+            font_id,
+            glyph_id,
+            font_size,
+            rasterized.width,
+            rasterized.height,
+            rasterized.bearing_x,
+            rasterized.bearing_y,
+            rasterized.advance,
+            &rasterized.bitmap,
+        )
+    }
+
+    /// Rasterize a glyph as an SDF at the size bucket for `font_size`
+    ///
+    /// The returned info is in bucket texels; scale it with
+    /// `GlyphInfo::scale_for(font_size)`.
+    fn rasterize_sdf_glyph_for_font(
+        &mut self,
+        font: &FontFace,
+        font_id: u32,
+        glyph_id: u16,
+        font_size: f32,
+    ) -> Result<GlyphInfo> {
+        let bucket = SDF_SIZE_BUCKETS
+            .into_iter()
+            .find(|&size| size >= font_size)
+            .unwrap_or(SDF_SIZE_BUCKETS[SDF_SIZE_BUCKETS.len() - 1]);
+
+        if let Some(info) = self.atlas.lookup_sdf(font_id, glyph_id, bucket) {
             return Ok(info);
         }
 
-        // Insert into atlas
-        let info = self.atlas.insert_glyph(
+        let rasterized = self.rasterizer.rasterize_sdf(font, glyph_id, bucket)?;
+        self.atlas.insert_sdf_glyph(
             font_id,
             glyph_id,
-            font_size,
+            bucket,
             rasterized.width,
             rasterized.height,
             rasterized.bearing_x,
             rasterized.bearing_y,
             rasterized.advance,
             &rasterized.bitmap,
-        )?;
-
-        self.glyph_cache.put(cache_key, info);
-        Ok(info)
+        )
     }
 
     /// Rasterize a color glyph (emoji) for a specific font
@@ -863,39 +954,16 @@ impl TextRenderer {
         glyph_id: u16,
         font_size: f32,
     ) -> Result<GlyphInfo> {
-        // Quantize font size for cache key (0.5px granularity)
-        let size_key = (font_size * 2.0).round() as u16;
-        let cache_key = (font_id, glyph_id, size_key);
-
-        // Check color cache first (LruCache::get promotes to most-recently-used)
-        if let Some(info) = self.color_glyph_cache.get(&cache_key) {
-            return Ok(*info);
+        // Check the color atlas first (marks the glyph as used this frame)
+        if let Some(info) = self.color_atlas.lookup(font_id, glyph_id, font_size) {
+            return Ok(info);
         }
 
         // Rasterize the glyph as color (RGBA)
         let rasterized = self.rasterizer.rasterize_color(font, glyph_id, font_size)?;
 
-        // Handle empty glyphs
-        if rasterized.width == 0 || rasterized.height == 0 {
-            let info = GlyphInfo {
-                region: crate::atlas::AtlasRegion {
-                    x: 0,
-                    y: 0,
-                    width: 0,
-                    height: 0,
-                },
-                bearing_x: rasterized.bearing_x,
-                bearing_y: rasterized.bearing_y,
-                advance: rasterized.advance,
-                font_size,
-            };
-            // LruCache::put evicts oldest entry if at capacity
-            self.color_glyph_cache.put(cache_key, info);
-            return Ok(info);
-        }
-
-        // Insert into color atlas
-        let info = self.color_atlas.insert_glyph(
+        // Insert into color atlas (see `rasterize_glyph_for_font`)
+        self.color_atlas.insert_glyph(
             font_id,
             glyph_id,
             font_size,
@@ -905,10 +973,7 @@ impl TextRenderer {
             rasterized.bearing_y,
             rasterized.advance,
             &rasterized.bitmap,
-        )?;
-
-        self.color_glyph_cache.put(cache_key, info);
-        Ok(info)
+        )
     }
 
     /// Legacy method for backward compatibility - uses system font from registry
@@ -921,12 +986,25 @@ impl TextRenderer {
         self.rasterize_glyph_for_font(&font, 0, glyph_id, font_size)
     }
 
-    /// Clear the glyph cache and atlas
+    /// Clear the glyph atlases
     pub fn clear(&mut self) {
         self.atlas.clear();
         self.color_atlas.clear();
-        self.glyph_cache.clear();
-        self.color_glyph_cache.clear();
+    }
+
+    /// Clear cached glyphs and shrink both atlases to a single small page
+    /// to release memory
+    ///
+    /// Glyphs are re-rasterized as they are used, and the atlases grow back
+    /// to their original size as needed.
+    pub fn shrink_atlases(&mut self) {
+        self.atlas.shrink(MIN_ATLAS_HEIGHT);
+        self.color_atlas.shrink(MIN_ATLAS_HEIGHT);
+    }
+
+    /// Bytes held by the CPU copies of the (grayscale, color) atlases
+    pub fn atlas_memory_bytes(&self) -> (usize, usize) {
+        (self.atlas.memory_bytes(), self.color_atlas.memory_bytes())
     }
 }
 
@@ -2,10 +2,27 @@
 //!
 //! Converts text strings into positioned glyph sequences with proper
 //! kerning, ligatures, and OpenType feature support.
+//!
+//! Shaping is the most expensive step of text layout, and the same strings
+//! are shaped over and over (every rebuild re-measures and re-renders every
+//! label). `TextShaper` therefore keeps shaped runs in a bounded `ShapeCache`,
+//! by default the process-wide one from `crate::global_shape_cache`, so the
+//! text measurer and the renderer share results across frames.
 
-use crate::font::FontFace;
+use std::hash::{Hash, Hasher};
+use std::sync::{Arc, Mutex};
+
+use rustc_hash::{FxHashMap, FxHasher};
 use rustybuzz::{Face, UnicodeBuffer};
 
+use crate::font::FontFace;
+
+/// Default maximum number of shaped runs kept by a `ShapeCache`
+pub const DEFAULT_SHAPE_CACHE_CAPACITY: usize = 8192;
+
+/// Total bytes of uncached text below which `shape_batch` stays on one thread
+const PARALLEL_SHAPE_MIN_BYTES: usize = 8 * 1024;
+
 /// A shaped glyph with position information
 #[derive(Debug, Clone, Copy)]
 pub struct ShapedGlyph {
@@ -50,100 +67,221 @@ impl ShapedText {
     }
 }
 
-/// Text shaper using HarfBuzz via rustybuzz
-pub struct TextShaper {
-    // We don't cache the Face here because it borrows from FontFace data
-    // Instead, create it on-demand in shape()
+/// Cache statistics for a `ShapeCache`
+#[derive(Debug, Clone, Copy, Default, PartialEq, Eq)]
+pub struct ShapeCacheStats {
+    /// Shaped runs currently cached
+    pub entries: usize,
+    /// Lookups answered from the cache
+    pub hits: u64,
+    /// Lookups that had to shape
+    pub misses: u64,
 }
 
-impl TextShaper {
-    /// Create a new text shaper
-    pub fn new() -> Self {
-        Self {}
-    }
+/// Key of a cached shaped run
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Hash)]
+struct ShapeKey {
+    text_hash: u64,
+    font_id: u64,
+    font_size_bits: u32,
+    features_hash: u64,
+}
 
-    /// Shape a text string using the given font
-    pub fn shape(&self, text: &str, font_face: &FontFace, font_size: f32) -> ShapedText {
-        // Create rustybuzz Face from font data with correct face index
-        let face = match Face::from_slice(font_face.data(), font_face.face_index()) {
-            Some(f) => f,
-            None => {
-                // Fallback: return basic glyph sequence without shaping
-                return self.fallback_shape(text, font_face, font_size);
-            }
-        };
+impl ShapeKey {
+    fn new(
+        text: &str,
+        font_face: &FontFace,
+        font_size: f32,
+        features: &[rustybuzz::Feature],
+    ) -> Self {
+        let mut hasher = FxHasher::default();
+        text.hash(&mut hasher);
+        let text_hash = hasher.finish();
 
-        // Create and fill the Unicode buffer
-        let mut buffer = UnicodeBuffer::new();
-        buffer.push_str(text);
-
-        // Shape the buffer
-        let output = rustybuzz::shape(&face, &[], buffer);
-
-        // Extract glyph information
-        let glyph_infos = output.glyph_infos();
-        let glyph_positions = output.glyph_positions();
-
-        let mut glyphs = Vec::with_capacity(glyph_infos.len());
-        let mut total_advance = 0i32;
-
-        for (info, pos) in glyph_infos.iter().zip(glyph_positions.iter()) {
-            // Find the original character for this cluster
-            let codepoint = text
-                .char_indices()
-                .find(|(i, _)| *i as u32 == info.cluster)
-                .map(|(_, c)| c)
-                .unwrap_or('\u{FFFD}');
-
-            glyphs.push(ShapedGlyph {
-                glyph_id: info.glyph_id as u16,
-                codepoint,
-                x_offset: pos.x_offset,
-                y_offset: pos.y_offset,
-                x_advance: pos.x_advance,
-                y_advance: pos.y_advance,
-                cluster: info.cluster,
-            });
+        let mut hasher = FxHasher::default();
+        for feature in features {
+            (feature.tag.0, feature.value, feature.start, feature.end).hash(&mut hasher);
+        }
 
-            total_advance += pos.x_advance;
+        Self {
+            text_hash,
+            font_id: font_face.id(),
+            font_size_bits: font_size.to_bits(),
+            features_hash: hasher.finish(),
         }
+    }
+}
+
+#[derive(Debug)]
+struct ShapeEntry {
+    /// Full text, to tell hash collisions apart
+    text: Box<str>,
+    shaped: Arc<ShapedText>,
+    last_used: u64,
+}
+
+#[derive(Debug)]
+struct ShapeCacheInner {
+    entries: FxHashMap<ShapeKey, ShapeEntry>,
+    capacity: usize,
+    /// Lookup counter used as the recency clock
+    tick: u64,
+    hits: u64,
+    misses: u64,
+}
+
+/// Bounded cache of shaped runs, keyed by (text, font face, size, features)
+///
+/// Thread-safe so one cache can be shared by the text measurer, the renderer
+/// and `TextShaper::shape_batch` worker threads. When full, the least
+/// recently used quarter of the entries is evicted at once, which keeps
+/// eviction cost amortized O(1) per insert.
+#[derive(Debug)]
+pub struct ShapeCache {
+    inner: Mutex<ShapeCacheInner>,
+}
 
-        ShapedText {
-            glyphs,
-            total_advance,
-            font_size,
-            units_per_em: font_face.metrics().units_per_em,
+impl ShapeCache {
+    /// Create a cache holding at most `capacity` shaped runs
+    pub fn new(capacity: usize) -> Self {
+        Self {
+            inner: Mutex::new(ShapeCacheInner {
+                entries: FxHashMap::default(),
+                capacity: capacity.max(1),
+                tick: 0,
+                hits: 0,
+                misses: 0,
+            }),
         }
     }
 
-    /// Fallback shaping when rustybuzz fails
-    fn fallback_shape(&self, text: &str, font_face: &FontFace, font_size: f32) -> ShapedText {
-        let mut glyphs = Vec::new();
-        let mut total_advance = 0i32;
+    /// Maximum number of cached runs
+    pub fn capacity(&self) -> usize {
+        self.inner.lock().unwrap().capacity
+    }
 
-        for (cluster, c) in text.char_indices() {
-            let glyph_id = font_face.glyph_id(c).unwrap_or(0);
-            let advance = font_face.glyph_advance(glyph_id).unwrap_or(500) as i32;
+    /// Change the maximum number of cached runs, evicting if needed
+    pub fn set_capacity(&self, capacity: usize) {
+        let mut inner = self.inner.lock().unwrap();
+        inner.capacity = capacity.max(1);
+        inner.evict_to_capacity();
+    }
 
-            glyphs.push(ShapedGlyph {
-                glyph_id,
-                codepoint: c,
-                x_offset: 0,
-                y_offset: 0,
-                x_advance: advance,
-                y_advance: 0,
-                cluster: cluster as u32,
-            });
+    /// Number of cached runs
+    pub fn len(&self) -> usize {
+        self.inner.lock().unwrap().entries.len()
+    }
+
+    /// Whether the cache is empty
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Drop all cached runs (e.g. after fonts are reloaded)
+    pub fn clear(&self) {
+        self.inner.lock().unwrap().entries.clear();
+    }
 
-            total_advance += advance;
+    /// Hit/miss counters and current size
+    pub fn stats(&self) -> ShapeCacheStats {
+        let inner = self.inner.lock().unwrap();
+        ShapeCacheStats {
+            entries: inner.entries.len(),
+            hits: inner.hits,
+            misses: inner.misses,
         }
+    }
+
+    fn get(&self, key: &ShapeKey, text: &str) -> Option<Arc<ShapedText>> {
+        let mut guard = self.inner.lock().unwrap();
+        let inner = &mut *guard;
+        inner.tick += 1;
+        match inner.entries.get_mut(key) {
+            Some(entry) if &*entry.text == text => {
+                entry.last_used = inner.tick;
+                inner.hits += 1;
+                Some(Arc::clone(&entry.shaped))
+            }
+            _ => {
+                inner.misses += 1;
+                None
+            }
+        }
+    }
+
+    fn insert(&self, key: ShapeKey, text: &str, shaped: Arc<ShapedText>) {
+        let mut inner = self.inner.lock().unwrap();
+        inner.tick += 1;
+        let last_used = inner.tick;
+        inner.entries.insert(
+            key,
+            ShapeEntry {
+                text: text.into(),
+                shaped,
+                last_used,
+            },
+        );
+        inner.evict_to_capacity();
+    }
+}
 
-        ShapedText {
-            glyphs,
-            total_advance,
-            font_size,
-            units_per_em: font_face.metrics().units_per_em,
+impl ShapeCacheInner {
+    fn evict_to_capacity(&mut self) {
+        if self.entries.len() <= self.capacity {
+            return;
         }
+
+        // Keep the most recently used three quarters of the capacity
+        let keep = self.capacity - self.capacity / 4;
+        let mut ticks: Vec<u64> = self.entries.values().map(|e| e.last_used).collect();
+        let cut = ticks.len() - keep;
+        let (_, threshold, _) = ticks.select_nth_unstable(cut);
+        let threshold = *threshold;
+        self.entries.retain(|_, e| e.last_used >= threshold);
+    }
+}
+
+impl Default for ShapeCache {
+    fn default() -> Self {
+        Self::new(DEFAULT_SHAPE_CACHE_CAPACITY)
+    }
+}
+
+/// Text shaper using HarfBuzz via rustybuzz
+///
+/// Results are cached in a `ShapeCache` (the global one unless constructed
+/// with `with_cache` or `uncached`), so shaping the same run again is a
+/// hash lookup.
+pub struct TextShaper {
+    // We don't cache the Face here because it borrows from FontFace data
+    // Instead, create it on-demand when a run misses the cache
+    cache: Option<Arc<ShapeCache>>,
+}
+
+impl TextShaper {
+    /// Create a new text shaper backed by the global shape cache
+    pub fn new() -> Self {
+        Self::with_cache(crate::global_shape_cache())
+    }
+
+    /// Create a text shaper backed by a specific shape cache
+    pub fn with_cache(cache: Arc<ShapeCache>) -> Self {
+        Self { cache: Some(cache) }
+    }
+
+    /// Create a text shaper that shapes every call from scratch
+    pub fn uncached() -> Self {
+        Self { cache: None }
+    }
+
+    /// The shape cache backing this shaper, if any
+    pub fn cache(&self) -> Option<&Arc<ShapeCache>> {
+        self.cache.as_ref()
+    }
+
+    /// Shape a text string using the given font
+    pub fn shape(&self, text: &str, font_face: &FontFace, font_size: f32) -> Arc<ShapedText> {
+        self.shape_with_features(text, font_face, font_size, &[])
     }
 
     /// Shape with specific OpenType features enabled/disabled
@@ -153,49 +291,101 @@ impl TextShaper {
         font_face: &FontFace,
         font_size: f32,
         features: &[rustybuzz::Feature],
-    ) -> ShapedText {
-        let face = match Face::from_slice(font_face.data(), font_face.face_index()) {
-            Some(f) => f,
-            None => return self.fallback_shape(text, font_face, font_size),
+    ) -> Arc<ShapedText> {
+        let Some(cache) = &self.cache else {
+            return Arc::new(shape_uncached(text, font_face, font_size, features));
         };
 
-        let mut buffer = UnicodeBuffer::new();
-        buffer.push_str(text);
-
-        let output = rustybuzz::shape(&face, features, buffer);
+        let key = ShapeKey::new(text, font_face, font_size, features);
+        if let Some(shaped) = cache.get(&key, text) {
+            return shaped;
+        }
 
-        let glyph_infos = output.glyph_infos();
-        let glyph_positions = output.glyph_positions();
+        let shaped = Arc::new(shape_uncached(text, font_face, font_size, features));
+        cache.insert(key, text, Arc::clone(&shaped));
+        shaped
+    }
 
-        let mut glyphs = Vec::with_capacity(glyph_infos.len());
-        let mut total_advance = 0i32;
+    /// Shape many independent runs (e.g. the paragraphs of a document)
+    ///
+    /// Cached runs are returned directly; the rest are shaped in parallel on
+    /// scoped threads (one per available core) when there is enough text to
+    /// be worth it, then added to the cache. Results are in input order.
+    pub fn shape_batch(
+        &self,
+        texts: &[&str],
+        font_face: &FontFace,
+        font_size: f32,
+    ) -> Vec<Arc<ShapedText>> {
+        let mut results: Vec<Option<Arc<ShapedText>>> = Vec::with_capacity(texts.len());
+        let mut misses: Vec<(usize, ShapeKey)> = Vec::new();
+        for (i, text) in texts.iter().enumerate() {
+            let key = ShapeKey::new(text, font_face, font_size, &[]);
+            let cached = self.cache.as_ref().and_then(|c| c.get(&key, text));
+            if cached.is_none() {
+                misses.push((i, key));
+            }
+            results.push(cached);
+        }
 
-        for (info, pos) in glyph_infos.iter().zip(glyph_positions.iter()) {
-            let codepoint = text
-                .char_indices()
-                .find(|(i, _)| *i as u32 == info.cluster)
-                .map(|(_, c)| c)
-                .unwrap_or('\u{FFFD}');
+        let miss_bytes: usize = misses.iter().map(|(i, _)| texts[*i].len()).sum();
+        let threads = std::thread::available_parallelism()
+            .map(|n| n.get())
+            .unwrap_or(1)
+            .min(misses.len());
 
-            glyphs.push(ShapedGlyph {
-                glyph_id: info.glyph_id as u16,
-                codepoint,
-                x_offset: pos.x_offset,
-                y_offset: pos.y_offset,
-                x_advance: pos.x_advance,
-                y_advance: pos.y_advance,
-                cluster: info.cluster,
+        let shaped: Vec<ShapedText> = if threads <= 1 || miss_bytes < PARALLEL_SHAPE_MIN_BYTES {
+            misses
+                .iter()
+                .map(|(i, _)| shape_uncached(texts[*i], font_face, font_size, &[]))
+                .collect()
+        } else {
+            // Interleave runs across workers so long paragraphs spread out
+            let mut per_thread: Vec<Vec<(usize, ShapedText)>> = std::thread::scope(|scope| {
+                let workers: Vec<_> = (0..threads)
+                    .map(|t| {
+                        let misses = &misses;
+                        scope.spawn(move || {
+                            misses
+                                .iter()
+                                .enumerate()
+                                .skip(t)
+                                .step_by(threads)
+                                .map(|(slot, (i, _))| {
+                                    (slot, shape_uncached(texts[*i], font_face, font_size, &[]))
+                                })
+                                .collect::<Vec<_>>()
+                        })
+                    })
+                    .collect();
+                workers
+                    .into_iter()
+                    .map(|w| w.join().expect("shaping thread panicked"))
+                    .collect()
             });
 
-            total_advance += pos.x_advance;
-        }
+            let mut slots: Vec<Option<ShapedText>> = (0..misses.len()).map(|_| None).collect();
+            for (slot, shaped) in per_thread.drain(..).flatten() {
+                slots[slot] = Some(shaped);
+            }
+            slots
+                .into_iter()
+                .map(|s| s.expect("run not shaped"))
+                .collect()
+        };
 
-        ShapedText {
-            glyphs,
-            total_advance,
-            font_size,
-            units_per_em: font_face.metrics().units_per_em,
+        for ((i, key), shaped) in misses.into_iter().zip(shaped) {
+            let shaped = Arc::new(shaped);
+            if let Some(cache) = &self.cache {
+                cache.insert(key, texts[i], Arc::clone(&shaped));
+            }
+            results[i] = Some(shaped);
         }
+
+        results
+            .into_iter()
+            .map(|r| r.expect("run not shaped"))
+            .collect()
     }
 }
 
@@ -204,3 +394,142 @@ impl Default for TextShaper {
         Self::new()
     }
 }
+
+/// Shape a run with rustybuzz, bypassing any cache
+fn shape_uncached(
+    text: &str,
+    font_face: &FontFace,
+    font_size: f32,
+    features: &[rustybuzz::Feature],
+) -> ShapedText {
+    // Create rustybuzz Face from font data with correct face index
+    let face = match Face::from_slice(font_face.data(), font_face.face_index()) {
+        Some(f) => f,
+        None => {
+            // Fallback: return basic glyph sequence without shaping
+            return fallback_shape(text, font_face, font_size);
+        }
+    };
+
+    // Create and fill the Unicode buffer
+    let mut buffer = UnicodeBuffer::new();
+    buffer.push_str(text);
+
+    // Shape the buffer
+    let output = rustybuzz::shape(&face, features, buffer);
+
+    // Extract glyph information
+    let glyph_infos = output.glyph_infos();
+    let glyph_positions = output.glyph_positions();
+
+    let mut glyphs = Vec::with_capacity(glyph_infos.len());
+    let mut total_advance = 0i32;
+
+    for (info, pos) in glyph_infos.iter().zip(glyph_positions.iter()) {
+        // Clusters are byte offsets of the first character of the cluster
+        let codepoint = text
+            .get(info.cluster as usize..)
+            .and_then(|rest| rest.chars().next())
+            .unwrap_or('\u{FFFD}');
+
+        glyphs.push(ShapedGlyph {
+            glyph_id: info.glyph_id as u16,
+            codepoint,
+            x_offset: pos.x_offset,
+            y_offset: pos.y_offset,
+            x_advance: pos.x_advance,
+            y_advance: pos.y_advance,
+            cluster: info.cluster,
+        });
+
+        total_advance += pos.x_advance;
+    }
+
+    ShapedText {
+        glyphs,
+        total_advance,
+        font_size,
+        units_per_em: font_face.metrics().units_per_em,
+    }
+}
+
+/// Fallback shaping when rustybuzz fails
+fn fallback_shape(text: &str, font_face: &FontFace, font_size: f32) -> ShapedText {
+    let mut glyphs = Vec::new();
+    let mut total_advance = 0i32;
+
+    for (cluster, c) in text.char_indices() {
+        let glyph_id = font_face.glyph_id(c).unwrap_or(0);
+        let advance = font_face.glyph_advance(glyph_id).unwrap_or(500) as i32;
+
+        glyphs.push(ShapedGlyph {
+            glyph_id,
+            codepoint: c,
+            x_offset: 0,
+            y_offset: 0,
+            x_advance: advance,
+            y_advance: 0,
+            cluster: cluster as u32,
+        });
+
+        total_advance += advance;
+    }
+
+    ShapedText {
+        glyphs,
+        total_advance,
+        font_size,
+        units_per_em: font_face.metrics().units_per_em,
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn shaped(advance: i32) -> Arc<ShapedText> {
+        Arc::new(ShapedText {
+            glyphs: Vec::new(),
+            total_advance: advance,
+            font_size: 16.0,
+            units_per_em: 1000,
+        })
+    }
+
+    fn key(n: u64) -> ShapeKey {
+        ShapeKey {
+            text_hash: n,
+            font_id: 1,
+            font_size_bits: 16.0f32.to_bits(),
+            features_hash: 0,
+        }
+    }
+
+    #[test]
+    fn test_cache_checks_text_on_hash_match() {
+        let cache = ShapeCache::new(16);
+        cache.insert(key(1), "hello", shaped(10));
+
+        assert_eq!(cache.get(&key(1), "hello").unwrap().total_advance, 10);
+        assert!(cache.get(&key(1), "other").is_none());
+        assert_eq!(cache.stats().hits, 1);
+        assert_eq!(cache.stats().misses, 1);
+    }
+
+    #[test]
+    fn test_cache_evicts_least_recently_used() {
+        let cache = ShapeCache::new(8);
+        for n in 0..8 {
+            cache.insert(key(n), "run", shaped(n as i32));
+        }
+        // Touch the oldest entry so it survives eviction
+        assert!(cache.get(&key(0), "run").is_some());
+
+        cache.insert(key(8), "run", shaped(8));
+
+        assert!(cache.len() <= 8);
+        assert!(cache.get(&key(0), "run").is_some());
+        assert!(cache.get(&key(8), "run").is_some());
+        assert!(cache.get(&key(1), "run").is_none());
+    }
+}
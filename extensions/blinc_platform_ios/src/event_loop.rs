@@ -9,11 +9,15 @@ use blinc_platform::{ControlFlow, Event, EventLoop, PlatformError};
 use std::sync::atomic::{AtomicBool, Ordering};
 
 #[cfg(target_os = "ios")]
-use std::sync::Arc;
+use std::sync::{Arc, Mutex};
 
 #[cfg(target_os = "ios")]
 use tracing::{debug, info, warn};
 
+/// Handler invoked on every wake, shared by all clones of a proxy
+#[cfg(target_os = "ios")]
+type WakeHandler = Arc<dyn Fn() + Send + Sync>;
+
 /// Wake proxy for iOS event loop
 ///
 /// Use this to request a redraw from a background animation thread.
@@ -22,6 +26,8 @@ use tracing::{debug, info, warn};
 pub struct IOSWakeProxy {
     /// Flag indicating a wake was requested
     wake_requested: Arc<AtomicBool>,
+    /// Called after the flag is set, e.g. to resume a paused display link
+    handler: Arc<Mutex<Option<WakeHandler>>>,
 }
 
 #[cfg(target_os = "ios")]
@@ -30,20 +36,46 @@ impl IOSWakeProxy {
     pub fn new() -> Self {
         Self {
             wake_requested: Arc::new(AtomicBool::new(false)),
+            handler: Arc::new(Mutex::new(None)),
         }
     }
 
     /// Wake up the event loop, causing it to process events and potentially redraw
     pub fn wake(&self) {
         self.wake_requested.store(true, Ordering::SeqCst);
-        // On iOS, we rely on CADisplayLink which runs at vsync
-        // The wake_requested flag will be checked on next frame
+        // The wake_requested flag is checked on the next CADisplayLink frame;
+        // the handler lets a paused display link be resumed first
+        let handler = self.handler.lock().unwrap().clone();
+        if let Some(handler) = handler {
+            handler();
+        }
+    }
+
+    /// Set the function called on every wake, replacing any previous one
+    ///
+    /// Wakes can come from any thread, so the handler should only schedule
+    /// work (e.g. dispatch to the main queue) and return.
+    pub fn set_handler<F>(&self, handler: F)
+    where
+        F: Fn() + Send + Sync + 'static,
+    {
+        *self.handler.lock().unwrap() = Some(Arc::new(handler));
+    }
+
+    /// Remove the wake handler
+    pub fn clear_handler(&self) {
+        *self.handler.lock().unwrap() = None;
     }
 
     /// Check if a wake was requested and clear the flag
     pub fn take_wake_request(&self) -> bool {
         self.wake_requested.swap(false, Ordering::SeqCst)
     }
+
+    /// Check if a wake was requested without clearing the flag
+    pub fn is_wake_requested(&self) -> bool {
+        self.wake_requested.load(Ordering::SeqCst)
+    }
 }
 
 /// Placeholder wake proxy for non-iOS builds
@@ -61,10 +93,25 @@ impl IOSWakeProxy {
     /// No-op wake for non-iOS
     pub fn wake(&self) {}
 
+    /// No-op on non-iOS; the handler is never called
+    pub fn set_handler<F>(&self, _handler: F)
+    where
+        F: Fn() + Send + Sync + 'static,
+    {
+    }
+
+    /// No-op on non-iOS
+    pub fn clear_handler(&self) {}
+
     /// Always returns false on non-iOS
     pub fn take_wake_request(&self) -> bool {
         false
     }
+
+    /// Always returns false on non-iOS
+    pub fn is_wake_requested(&self) -> bool {
+        false
+    }
 }
 
 /// iOS event loop using CADisplayLink
@@ -56,6 +56,83 @@ impl Touch {
     }
 }
 
+/// A packed touch sample as passed across the C ABI
+///
+/// Swift fills an array of these (one per `UITouch`, including every entry
+/// from `coalescedTouches(for:)`) and hands it to `blinc_handle_touches`.
+#[repr(C)]
+#[derive(Clone, Copy, Debug)]
+pub struct BlincTouch {
+    /// Unique identifier for the touch (stable for the touch's lifetime)
+    pub id: u64,
+    /// X position in logical points
+    pub x: f32,
+    /// Y position in logical points
+    pub y: f32,
+    /// Touch phase: 0=began, 1=moved, 2=ended, 3=cancelled
+    pub phase: i32,
+    /// Force of the touch (0.0 - 1.0 on 3D Touch devices)
+    pub force: f32,
+    /// Sample timestamp in seconds (`UITouch.timestamp`), 0 if unknown
+    pub timestamp: f64,
+}
+
+impl BlincTouch {
+    /// Convert the C representation to a `Touch`
+    pub fn to_touch(&self) -> Touch {
+        Touch::with_force(
+            self.id,
+            self.x,
+            self.y,
+            touch_phase_from_raw(self.phase),
+            self.force,
+        )
+    }
+}
+
+/// Convert a raw C ABI phase value to a `TouchPhase`
+pub fn touch_phase_from_raw(phase: i32) -> TouchPhase {
+    match phase {
+        0 => TouchPhase::Began,
+        1 => TouchPhase::Moved,
+        2 => TouchPhase::Ended,
+        _ => TouchPhase::Cancelled,
+    }
+}
+
+/// A single historical position of a touch, used for gesture velocity
+#[derive(Clone, Copy, Debug, PartialEq)]
+pub struct TouchSample {
+    /// X position in logical points
+    pub x: f32,
+    /// Y position in logical points
+    pub y: f32,
+    /// Sample timestamp in seconds
+    pub timestamp: f64,
+}
+
+/// Coalesce a batch of touches into the minimal set of events to route
+///
+/// Consecutive `Moved` samples for the same touch id collapse into the latest
+/// one. Phase transitions (`Began`, `Ended`, `Cancelled`) are always kept, in
+/// order, so a touch that begins, moves and ends within one batch still
+/// produces all three events. `out` is cleared first so callers can reuse
+/// the allocation across frames.
+pub fn coalesce_touches(touches: &[Touch], out: &mut Vec<Touch>) {
+    out.clear();
+    for touch in touches {
+        if touch.phase == TouchPhase::Moved {
+            if let Some(last) = out.iter_mut().rev().find(|t| t.id == touch.id) {
+                if last.phase == TouchPhase::Moved {
+                    *last = touch.clone();
+                    continue;
+                }
+            }
+        }
+        out.push(touch.clone());
+    }
+}
+
 /// Convert an iOS touch to a Blinc input event
 pub fn convert_touch(touch: &Touch) -> InputEvent {
     match touch.phase {
@@ -177,3 +254,41 @@ pub enum Gesture {
     /// Rotation gesture
     Rotation { angle: f32, center: (f32, f32) },
 }
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_coalesce_merges_moves_per_id() {
+        let touches = vec![
+            Touch::new(1, 0.0, 0.0, TouchPhase::Moved),
+            Touch::new(2, 5.0, 5.0, TouchPhase::Moved),
+            Touch::new(1, 1.0, 1.0, TouchPhase::Moved),
+            Touch::new(1, 2.0, 2.0, TouchPhase::Moved),
+        ];
+        let mut out = Vec::new();
+        coalesce_touches(&touches, &mut out);
+        assert_eq!(out.len(), 2);
+        assert_eq!((out[0].id, out[0].x), (1, 2.0));
+        assert_eq!((out[1].id, out[1].x), (2, 5.0));
+    }
+
+    #[test]
+    fn test_coalesce_keeps_phase_transitions() {
+        let touches = vec![
+            Touch::new(1, 0.0, 0.0, TouchPhase::Began),
+            Touch::new(1, 1.0, 0.0, TouchPhase::Moved),
+            Touch::new(1, 2.0, 0.0, TouchPhase::Moved),
+            Touch::new(1, 3.0, 0.0, TouchPhase::Ended),
+        ];
+        let mut out = Vec::new();
+        coalesce_touches(&touches, &mut out);
+        let phases: Vec<_> = out.iter().map(|t| t.phase).collect();
+        assert_eq!(
+            phases,
+            vec![TouchPhase::Began, TouchPhase::Moved, TouchPhase::Ended]
+        );
+        assert_eq!(out[1].x, 2.0);
+    }
+}
@@ -45,9 +45,14 @@ pub use app::{
 };
 pub use assets::IOSAssetLoader;
 pub use event_loop::{IOSEventLoop, IOSWakeProxy};
-pub use input::{convert_touch, convert_touches, Gesture, GestureDetector, Touch, TouchPhase};
+pub use input::{
+    coalesce_touches, convert_touch, convert_touches, touch_phase_from_raw, BlincTouch, Gesture,
+    GestureDetector, Touch, TouchPhase, TouchSample,
+};
 pub use native_bridge::{
-    blinc_native_bridge_is_ready, blinc_set_native_call_fn, IOSNativeBridgeAdapter,
+    blinc_native_bridge_is_ready, blinc_native_complete, blinc_set_native_call_async_fn,
+    blinc_set_native_call_fn, blinc_set_native_call_fn_v2, BlincNativeResult, BlincNativeValue,
+    IOSNativeBridgeAdapter, IOSNativeCallAsyncFn, IOSNativeCallFnV2,
 };
 pub use window::IOSWindow;
 
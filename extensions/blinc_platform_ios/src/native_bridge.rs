@@ -21,6 +21,25 @@
 //! Swift handler executes, returns JSON result
 //! ```
 //!
+//! # Binary ABI (v2)
+//!
+//! The JSON path builds and parses strings on both sides of every call. For
+//! calls made at frame rate (sensors, haptics) Swift can additionally register
+//! a binary handler with `blinc_set_native_call_fn_v2`. Arguments are passed
+//! as a borrowed array of `BlincNativeValue` tagged unions (strings and bytes
+//! are pointer + length into Rust-owned memory, with no copy or encoding) and
+//! the result is written into a caller-provided `BlincNativeResult`.
+//!
+//! If the binary handler reports `BLINC_NATIVE_STATUS_UNHANDLED`, the call
+//! falls back to the JSON handler when one is registered.
+//!
+//! # Async Calls
+//!
+//! With `blinc_set_native_call_async_fn`, `native_call_async` dispatches to
+//! Swift with a request id and returns immediately. Swift completes the
+//! request later from any thread with `blinc_native_complete`, and the result
+//! is delivered when `blinc_build_frame` drains completions.
+//!
 //! # Swift Side
 //!
 //! ```swift
@@ -62,13 +81,15 @@
 //! }
 //! ```
 
-use std::ffi::{CStr, CString};
+use std::ffi::{c_void, CStr, CString};
 use std::os::raw::c_char;
 use std::sync::Arc;
 
+use smallvec::SmallVec;
+
 use blinc_core::native_bridge::{
-    parse_native_result_json, NativeBridgeError, NativeBridgeState, NativeResult, NativeValue,
-    PlatformAdapter,
+    native_complete, parse_native_result_json, NativeBridgeError, NativeBridgeState,
+    NativeRequestId, NativeResult, NativeValue, PlatformAdapter,
 };
 
 /// Function pointer type for iOS native call
@@ -78,6 +99,230 @@ use blinc_core::native_bridge::{
 pub type IOSNativeCallFn =
     extern "C" fn(ns: *const c_char, name: *const c_char, args_json: *const c_char) -> *mut c_char;
 
+// ============================================================================
+// Binary ABI Types
+// ============================================================================
+
+/// `BlincNativeValue` tag: no value
+pub const BLINC_NATIVE_VOID: u32 = 0;
+/// `BlincNativeValue` tag: `value.b`
+pub const BLINC_NATIVE_BOOL: u32 = 1;
+/// `BlincNativeValue` tag: `value.i32`
+pub const BLINC_NATIVE_INT32: u32 = 2;
+/// `BlincNativeValue` tag: `value.i64`
+pub const BLINC_NATIVE_INT64: u32 = 3;
+/// `BlincNativeValue` tag: `value.f32`
+pub const BLINC_NATIVE_FLOAT32: u32 = 4;
+/// `BlincNativeValue` tag: `value.f64`
+pub const BLINC_NATIVE_FLOAT64: u32 = 5;
+/// `BlincNativeValue` tag: UTF-8 string in `value.data` (not nul-terminated)
+pub const BLINC_NATIVE_STRING: u32 = 6;
+/// `BlincNativeValue` tag: raw bytes in `value.data`
+pub const BLINC_NATIVE_BYTES: u32 = 7;
+/// `BlincNativeValue` tag: JSON text in `value.data`
+pub const BLINC_NATIVE_JSON: u32 = 8;
+
+/// `BlincNativeResult` status: call succeeded, `value` is set
+pub const BLINC_NATIVE_STATUS_OK: i32 = 0;
+/// `BlincNativeResult` status: no handler for namespace/name
+pub const BLINC_NATIVE_STATUS_NOT_REGISTERED: i32 = 1;
+/// `BlincNativeResult` status: handler failed, `error` holds the message
+pub const BLINC_NATIVE_STATUS_ERROR: i32 = 2;
+/// `BlincNativeResult` status: handler not available on the binary path,
+/// retry on the JSON path
+pub const BLINC_NATIVE_STATUS_UNHANDLED: i32 = 3;
+
+/// Borrowed byte slice across the C ABI
+#[repr(C)]
+#[derive(Clone, Copy, Debug)]
+pub struct BlincNativeData {
+    /// Pointer to the first byte (may be null when `len` is 0)
+    pub ptr: *const u8,
+    /// Length in bytes
+    pub len: usize,
+}
+
+impl BlincNativeData {
+    const EMPTY: Self = Self {
+        ptr: std::ptr::null(),
+        len: 0,
+    };
+
+    fn from_slice(bytes: &[u8]) -> Self {
+        Self {
+            ptr: bytes.as_ptr(),
+            len: bytes.len(),
+        }
+    }
+
+    /// View the data as a slice
+    ///
+    /// # Safety
+    /// `ptr` must be valid for `len` bytes for the lifetime of the returned slice.
+    unsafe fn as_slice<'a>(&self) -> &'a [u8] {
+        if self.ptr.is_null() || self.len == 0 {
+            &[]
+        } else {
+            std::slice::from_raw_parts(self.ptr, self.len)
+        }
+    }
+}
+
+/// Payload of a `BlincNativeValue`, selected by its tag
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub union BlincNativePayload {
+    pub b: bool,
+    pub i32: i32,
+    pub i64: i64,
+    pub f32: f32,
+    pub f64: f64,
+    pub data: BlincNativeData,
+}
+
+/// Tagged union mirroring `NativeValue` for the binary ABI
+///
+/// Values passed as arguments borrow Rust memory and are only valid for the
+/// duration of the call.
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct BlincNativeValue {
+    /// One of the `BLINC_NATIVE_*` tags
+    pub tag: u32,
+    /// Payload for the tag
+    pub value: BlincNativePayload,
+}
+
+impl BlincNativeValue {
+    const VOID: Self = Self {
+        tag: BLINC_NATIVE_VOID,
+        value: BlincNativePayload { i64: 0 },
+    };
+
+    /// Borrow a `NativeValue` as a binary value (no copy for strings/bytes)
+    pub fn borrow(value: &NativeValue) -> Self {
+        let (tag, value) = match value {
+            NativeValue::Void => return Self::VOID,
+            NativeValue::Bool(v) => (BLINC_NATIVE_BOOL, BlincNativePayload { b: *v }),
+            NativeValue::Int32(v) => (BLINC_NATIVE_INT32, BlincNativePayload { i32: *v }),
+            NativeValue::Int64(v) => (BLINC_NATIVE_INT64, BlincNativePayload { i64: *v }),
+            NativeValue::Float32(v) => (BLINC_NATIVE_FLOAT32, BlincNativePayload { f32: *v }),
+            NativeValue::Float64(v) => (BLINC_NATIVE_FLOAT64, BlincNativePayload { f64: *v }),
+            NativeValue::String(s) => (
+                BLINC_NATIVE_STRING,
+                BlincNativePayload {
+                    data: BlincNativeData::from_slice(s.as_bytes()),
+                },
+            ),
+            NativeValue::Bytes(b) => (
+                BLINC_NATIVE_BYTES,
+                BlincNativePayload {
+                    data: BlincNativeData::from_slice(b),
+                },
+            ),
+            NativeValue::Json(j) => (
+                BLINC_NATIVE_JSON,
+                BlincNativePayload {
+                    data: BlincNativeData::from_slice(j.as_bytes()),
+                },
+            ),
+        };
+        Self { tag, value }
+    }
+
+    /// Copy a binary value into an owned `NativeValue`
+    ///
+    /// # Safety
+    /// For string, bytes and JSON tags, `value.data` must be valid.
+    pub unsafe fn to_native_value(&self) -> NativeResult<NativeValue> {
+        Ok(match self.tag {
+            BLINC_NATIVE_VOID => NativeValue::Void,
+            BLINC_NATIVE_BOOL => NativeValue::Bool(self.value.b),
+            BLINC_NATIVE_INT32 => NativeValue::Int32(self.value.i32),
+            BLINC_NATIVE_INT64 => NativeValue::Int64(self.value.i64),
+            BLINC_NATIVE_FLOAT32 => NativeValue::Float32(self.value.f32),
+            BLINC_NATIVE_FLOAT64 => NativeValue::Float64(self.value.f64),
+            BLINC_NATIVE_STRING => NativeValue::String(
+                String::from_utf8_lossy(self.value.data.as_slice()).into_owned(),
+            ),
+            BLINC_NATIVE_BYTES => NativeValue::Bytes(self.value.data.as_slice().to_vec()),
+            BLINC_NATIVE_JSON => {
+                NativeValue::Json(String::from_utf8_lossy(self.value.data.as_slice()).into_owned())
+            }
+            tag => {
+                return Err(NativeBridgeError::SerializationError(format!(
+                    "Unknown native value tag: {}",
+                    tag
+                )))
+            }
+        })
+    }
+}
+
+/// Result slot filled in by the binary native call handler
+///
+/// Rust passes it with `status` preset to `BLINC_NATIVE_STATUS_UNHANDLED`, a
+/// void `value`, no `error` and no `release`, so a handler that leaves it
+/// untouched falls back to the JSON path. String/bytes memory referenced
+/// by `value` or `error` must stay valid until Rust has copied it; if
+/// `release` is set, Rust calls `release(release_ctx)` once it is done.
+#[repr(C)]
+pub struct BlincNativeResult {
+    /// One of the `BLINC_NATIVE_STATUS_*` codes
+    pub status: i32,
+    /// Return value when `status` is `BLINC_NATIVE_STATUS_OK`
+    pub value: BlincNativeValue,
+    /// UTF-8 error message when `status` is `BLINC_NATIVE_STATUS_ERROR`
+    pub error: BlincNativeData,
+    /// Optional callback releasing handler-owned result memory
+    pub release: Option<extern "C" fn(ctx: *mut c_void)>,
+    /// Context passed to `release`
+    pub release_ctx: *mut c_void,
+}
+
+impl BlincNativeResult {
+    fn empty() -> Self {
+        Self {
+            status: BLINC_NATIVE_STATUS_UNHANDLED,
+            value: BlincNativeValue::VOID,
+            error: BlincNativeData::EMPTY,
+            release: None,
+            release_ctx: std::ptr::null_mut(),
+        }
+    }
+}
+
+/// Function pointer type for the binary iOS native call (v2)
+///
+/// Namespace and name are UTF-8 pointer + length pairs (not nul-terminated).
+/// `args` points to `arg_count` values that are only valid during the call.
+pub type IOSNativeCallFnV2 = extern "C" fn(
+    ns: *const u8,
+    ns_len: usize,
+    name: *const u8,
+    name_len: usize,
+    args: *const BlincNativeValue,
+    arg_count: usize,
+    out: *mut BlincNativeResult,
+);
+
+/// Function pointer type for async iOS native calls
+///
+/// The handler must copy whatever it needs from `args` before returning and
+/// later call `blinc_native_complete(request_id, ..)` from any thread.
+pub type IOSNativeCallAsyncFn = extern "C" fn(
+    request_id: u64,
+    ns: *const u8,
+    ns_len: usize,
+    name: *const u8,
+    name_len: usize,
+    args: *const BlincNativeValue,
+    arg_count: usize,
+);
+
+/// Arguments up to this count are marshalled without a heap allocation
+const INLINE_ARGS: usize = 8;
+
 /// Free a string allocated by Swift (via strdup)
 ///
 /// This is the Rust-side implementation. When Swift is linked,
@@ -96,9 +341,16 @@ pub extern "C" fn blinc_free_string(ptr: *mut c_char) {
 }
 
 /// iOS platform adapter using C FFI to call Swift handlers
+///
+/// Uses the binary (v2) handler when registered, falling back to the JSON
+/// handler for calls the binary handler reports as unhandled.
 pub struct IOSNativeBridgeAdapter {
-    /// Function pointer to Swift's native call handler
-    call_fn: IOSNativeCallFn,
+    /// Function pointer to Swift's JSON native call handler
+    call_fn: Option<IOSNativeCallFn>,
+    /// Function pointer to Swift's binary native call handler
+    call_fn_v2: Option<IOSNativeCallFnV2>,
+    /// Function pointer to Swift's async native call handler
+    call_fn_async: Option<IOSNativeCallAsyncFn>,
 }
 
 impl IOSNativeBridgeAdapter {
@@ -107,7 +359,126 @@ impl IOSNativeBridgeAdapter {
     /// # Arguments
     /// * `call_fn` - Function pointer to `blinc_ios_native_call` from Swift
     pub fn new(call_fn: IOSNativeCallFn) -> Self {
-        Self { call_fn }
+        Self {
+            call_fn: Some(call_fn),
+            call_fn_v2: None,
+            call_fn_async: None,
+        }
+    }
+
+    /// Create an adapter using the binary ABI, with an optional JSON fallback
+    ///
+    /// # Arguments
+    /// * `call_fn_v2` - Function pointer to `blinc_ios_native_call_v2` from Swift
+    /// * `fallback` - JSON handler used when the binary handler reports unhandled
+    pub fn with_binary(call_fn_v2: IOSNativeCallFnV2, fallback: Option<IOSNativeCallFn>) -> Self {
+        Self {
+            call_fn: fallback,
+            call_fn_v2: Some(call_fn_v2),
+            call_fn_async: None,
+        }
+    }
+
+    /// Dispatch async calls to `call_fn_async` instead of blocking on `call`
+    pub fn with_async(mut self, call_fn_async: IOSNativeCallAsyncFn) -> Self {
+        self.call_fn_async = Some(call_fn_async);
+        self
+    }
+
+    /// Call through the binary ABI
+    ///
+    /// Returns `None` if the handler reported `BLINC_NATIVE_STATUS_UNHANDLED`.
+    fn call_binary(
+        call_fn_v2: IOSNativeCallFnV2,
+        namespace: &str,
+        name: &str,
+        args: &[NativeValue],
+    ) -> Option<NativeResult<NativeValue>> {
+        let raw_args: SmallVec<[BlincNativeValue; INLINE_ARGS]> =
+            args.iter().map(BlincNativeValue::borrow).collect();
+        let mut out = BlincNativeResult::empty();
+
+        call_fn_v2(
+            namespace.as_ptr(),
+            namespace.len(),
+            name.as_ptr(),
+            name.len(),
+            raw_args.as_ptr(),
+            raw_args.len(),
+            &mut out,
+        );
+
+        // Safety: the handler guarantees result memory is valid until released
+        unsafe { Self::take_result(&out, namespace, name) }
+    }
+
+    /// Convert a filled-in result slot to a `NativeResult` and release it
+    ///
+    /// Returns `None` for `BLINC_NATIVE_STATUS_UNHANDLED`.
+    ///
+    /// # Safety
+    /// Memory referenced by `out` must be valid until it is released here.
+    unsafe fn take_result(
+        out: &BlincNativeResult,
+        namespace: &str,
+        name: &str,
+    ) -> Option<NativeResult<NativeValue>> {
+        let result = match out.status {
+            BLINC_NATIVE_STATUS_OK => Some(out.value.to_native_value()),
+            BLINC_NATIVE_STATUS_NOT_REGISTERED => Some(Err(NativeBridgeError::NotRegistered {
+                namespace: namespace.to_string(),
+                name: name.to_string(),
+            })),
+            BLINC_NATIVE_STATUS_UNHANDLED => None,
+            _ => Some(Err(NativeBridgeError::PlatformError(
+                String::from_utf8_lossy(out.error.as_slice()).into_owned(),
+            ))),
+        };
+
+        if let Some(release) = out.release {
+            release(out.release_ctx);
+        }
+
+        result
+    }
+
+    /// Call through the JSON ABI
+    fn call_json(
+        call_fn: IOSNativeCallFn,
+        namespace: &str,
+        name: &str,
+        args: &[NativeValue],
+    ) -> NativeResult<NativeValue> {
+        // Create C strings for arguments
+        let ns_cstr = CString::new(namespace)
+            .map_err(|e| NativeBridgeError::PlatformError(format!("Invalid namespace: {}", e)))?;
+
+        let name_cstr = CString::new(name)
+            .map_err(|e| NativeBridgeError::PlatformError(format!("Invalid name: {}", e)))?;
+
+        // Serialize args to JSON
+        let args_json = Self::args_to_json(args);
+        let args_cstr = CString::new(args_json)
+            .map_err(|e| NativeBridgeError::PlatformError(format!("Invalid args: {}", e)))?;
+
+        // Call Swift function
+        let result_ptr = call_fn(ns_cstr.as_ptr(), name_cstr.as_ptr(), args_cstr.as_ptr());
+
+        if result_ptr.is_null() {
+            return Err(NativeBridgeError::PlatformError(
+                "Null result from iOS native call".to_string(),
+            ));
+        }
+
+        // Extract result string
+        let result_cstr = unsafe { CStr::from_ptr(result_ptr) };
+        let result_str = result_cstr.to_string_lossy().into_owned();
+
+        // Free the string (allocated by Swift's strdup or C malloc)
+        unsafe { libc::free(result_ptr as *mut libc::c_void) };
+
+        // Parse the JSON result
+        parse_native_result_json(&result_str)
     }
 
     /// Serialize NativeValue arguments to JSON
@@ -144,38 +515,45 @@ impl PlatformAdapter for IOSNativeBridgeAdapter {
         name: &str,
         args: Vec<NativeValue>,
     ) -> NativeResult<NativeValue> {
-        // Create C strings for arguments
-        let ns_cstr = CString::new(namespace)
-            .map_err(|e| NativeBridgeError::PlatformError(format!("Invalid namespace: {}", e)))?;
-
-        let name_cstr = CString::new(name)
-            .map_err(|e| NativeBridgeError::PlatformError(format!("Invalid name: {}", e)))?;
-
-        // Serialize args to JSON
-        let args_json = Self::args_to_json(&args);
-        let args_cstr = CString::new(args_json)
-            .map_err(|e| NativeBridgeError::PlatformError(format!("Invalid args: {}", e)))?;
-
-        // Call Swift function
-        let result_ptr = (self.call_fn)(ns_cstr.as_ptr(), name_cstr.as_ptr(), args_cstr.as_ptr());
-
-        if result_ptr.is_null() {
-            return Err(NativeBridgeError::PlatformError(
-                "Null result from iOS native call".to_string(),
-            ));
+        if let Some(call_fn_v2) = self.call_fn_v2 {
+            if let Some(result) = Self::call_binary(call_fn_v2, namespace, name, &args) {
+                return result;
+            }
         }
 
-        // Extract result string
-        let result_cstr = unsafe { CStr::from_ptr(result_ptr) };
-        let result_str = result_cstr.to_string_lossy().into_owned();
-
-        // Free the string (allocated by Swift's strdup or C malloc)
-        if !result_ptr.is_null() {
-            unsafe { libc::free(result_ptr as *mut libc::c_void) };
+        match self.call_fn {
+            Some(call_fn) => Self::call_json(call_fn, namespace, name, &args),
+            None => Err(NativeBridgeError::NotRegistered {
+                namespace: namespace.to_string(),
+                name: name.to_string(),
+            }),
         }
+    }
 
-        // Parse the JSON result
-        parse_native_result_json(&result_str)
+    fn call_async(
+        &self,
+        request_id: NativeRequestId,
+        namespace: &str,
+        name: &str,
+        args: Vec<NativeValue>,
+    ) {
+        let Some(call_fn_async) = self.call_fn_async else {
+            // No async handler registered: block on the sync path
+            native_complete(request_id, self.call(namespace, name, args));
+            return;
+        };
+
+        let raw_args: SmallVec<[BlincNativeValue; INLINE_ARGS]> =
+            args.iter().map(BlincNativeValue::borrow).collect();
+        call_fn_async(
+            request_id,
+            namespace.as_ptr(),
+            namespace.len(),
+            name.as_ptr(),
+            name.len(),
+            raw_args.as_ptr(),
+            raw_args.len(),
+        );
     }
 }
 
@@ -186,6 +564,37 @@ impl PlatformAdapter for IOSNativeBridgeAdapter {
 /// Static storage for the call function pointer
 static mut IOS_NATIVE_CALL_FN: Option<IOSNativeCallFn> = None;
 
+/// Static storage for the binary (v2) call function pointer
+static mut IOS_NATIVE_CALL_FN_V2: Option<IOSNativeCallFnV2> = None;
+
+/// Static storage for the async call function pointer
+static mut IOS_NATIVE_CALL_ASYNC_FN: Option<IOSNativeCallAsyncFn> = None;
+
+/// (Re)build the platform adapter from the registered call functions
+fn install_adapter() {
+    // Initialize native bridge if not already done
+    if !NativeBridgeState::is_initialized() {
+        NativeBridgeState::init();
+    }
+
+    let (call_fn, call_fn_v2, call_fn_async) = unsafe {
+        (
+            IOS_NATIVE_CALL_FN,
+            IOS_NATIVE_CALL_FN_V2,
+            IOS_NATIVE_CALL_ASYNC_FN,
+        )
+    };
+    let mut adapter = match (call_fn_v2, call_fn) {
+        (Some(v2), fallback) => IOSNativeBridgeAdapter::with_binary(v2, fallback),
+        (None, Some(json)) => IOSNativeBridgeAdapter::new(json),
+        (None, None) => return,
+    };
+    if let Some(call_fn_async) = call_fn_async {
+        adapter = adapter.with_async(call_fn_async);
+    }
+    NativeBridgeState::get().set_platform_adapter(Arc::new(adapter));
+}
+
 /// Register the iOS native call function
 ///
 /// Called from Swift during app initialization to wire up the native bridge.
@@ -205,21 +614,88 @@ pub extern "C" fn blinc_set_native_call_fn(call_fn: IOSNativeCallFn) {
     unsafe {
         IOS_NATIVE_CALL_FN = Some(call_fn);
     }
+    install_adapter();
+}
 
-    // Initialize native bridge if not already done
-    if !NativeBridgeState::is_initialized() {
-        NativeBridgeState::init();
+/// Register the binary iOS native call function (v2)
+///
+/// Calls go through the binary ABI first. If a JSON handler is also
+/// registered, it is used for calls the binary handler reports as
+/// `BLINC_NATIVE_STATUS_UNHANDLED`.
+///
+/// # Swift Usage
+///
+/// ```swift
+/// blinc_set_native_call_fn(blinc_ios_native_call)       // optional fallback
+/// blinc_set_native_call_fn_v2(blinc_ios_native_call_v2)
+/// ```
+///
+/// # Safety
+///
+/// Must be called from the main thread before any native calls are made.
+#[no_mangle]
+pub extern "C" fn blinc_set_native_call_fn_v2(call_fn: IOSNativeCallFnV2) {
+    unsafe {
+        IOS_NATIVE_CALL_FN_V2 = Some(call_fn);
     }
+    install_adapter();
+}
 
-    // Create and register the adapter
-    let adapter = IOSNativeBridgeAdapter::new(call_fn);
-    NativeBridgeState::get().set_platform_adapter(Arc::new(adapter));
+/// Register the async iOS native call function
+///
+/// `native_call_async` / `native_call_async_with` dispatch to this handler and
+/// return immediately. Without it, async calls block on the sync handler.
+///
+/// # Swift Usage
+///
+/// ```swift
+/// blinc_set_native_call_async_fn(blinc_ios_native_call_async)
+/// ```
+///
+/// # Safety
+///
+/// Must be called from the main thread before any native calls are made.
+#[no_mangle]
+pub extern "C" fn blinc_set_native_call_async_fn(call_fn: IOSNativeCallAsyncFn) {
+    unsafe {
+        IOS_NATIVE_CALL_ASYNC_FN = Some(call_fn);
+    }
+    install_adapter();
+}
+
+/// Complete an async native call (callable from any thread)
+///
+/// The result is copied out of `result` (and its `release` callback invoked)
+/// before this returns. A null `result` completes the call with no value.
+/// Completion wakes every context's frame loop (see `blinc_set_wake_callback`)
+/// and is delivered on the next `blinc_build_frame`.
+///
+/// # Safety
+///
+/// `result` must be null or point to a valid, filled-in `BlincNativeResult`.
+#[no_mangle]
+pub extern "C" fn blinc_native_complete(request_id: u64, result: *const BlincNativeResult) {
+    let result = if result.is_null() {
+        Ok(NativeValue::Void)
+    } else {
+        unsafe {
+            IOSNativeBridgeAdapter::take_result(&*result, "unknown", "unknown").unwrap_or_else(
+                || {
+                    Err(NativeBridgeError::PlatformError(
+                        "Async native call completed as unhandled".to_string(),
+                    ))
+                },
+            )
+        }
+    };
+    native_complete(request_id, result);
 }
 
 /// Check if the iOS native bridge is initialized
 #[no_mangle]
 pub extern "C" fn blinc_native_bridge_is_ready() -> bool {
-    (unsafe { IOS_NATIVE_CALL_FN.is_some() }) && NativeBridgeState::is_initialized()
+    let (call_fn, call_fn_v2) = unsafe { (IOS_NATIVE_CALL_FN, IOS_NATIVE_CALL_FN_V2) };
+    (call_fn.is_some() || call_fn_v2.is_some()) && NativeBridgeState::is_initialized()
 }
 
 // ============================================================================
@@ -281,6 +757,104 @@ mod tests {
         assert_eq!(json, r#"[42,true,"hello"]"#);
     }
 
+    extern "C" fn echo_v2(
+        _ns: *const u8,
+        _ns_len: usize,
+        name: *const u8,
+        name_len: usize,
+        args: *const BlincNativeValue,
+        arg_count: usize,
+        out: *mut BlincNativeResult,
+    ) {
+        unsafe {
+            let name = std::slice::from_raw_parts(name, name_len);
+            let out = &mut *out;
+            match name {
+                b"echo" if arg_count > 0 => {
+                    out.status = BLINC_NATIVE_STATUS_OK;
+                    out.value = *args;
+                }
+                b"legacy" => out.status = BLINC_NATIVE_STATUS_UNHANDLED,
+                _ => out.status = BLINC_NATIVE_STATUS_NOT_REGISTERED,
+            }
+        }
+    }
+
+    extern "C" fn legacy_json(
+        _ns: *const c_char,
+        _name: *const c_char,
+        _args: *const c_char,
+    ) -> *mut c_char {
+        let json = CString::new(r#"{"success":true,"value":"json"}"#).unwrap();
+        unsafe { libc::strdup(json.as_ptr()) }
+    }
+
+    #[test]
+    fn test_binary_call_borrows_bytes() {
+        let adapter = IOSNativeBridgeAdapter::with_binary(echo_v2, None);
+        let bytes = vec![1u8, 2, 3, 4];
+        let result = adapter
+            .call("test", "echo", vec![NativeValue::Bytes(bytes.clone())])
+            .unwrap();
+        assert_eq!(result, NativeValue::Bytes(bytes));
+
+        let result = adapter
+            .call("test", "echo", vec![NativeValue::Float64(0.5)])
+            .unwrap();
+        assert_eq!(result, NativeValue::Float64(0.5));
+    }
+
+    #[test]
+    fn test_binary_call_falls_back_to_json() {
+        let adapter = IOSNativeBridgeAdapter::with_binary(echo_v2, Some(legacy_json));
+        let result = adapter.call("test", "legacy", vec![]).unwrap();
+        assert_eq!(result.as_str(), Some("json"));
+
+        let missing = adapter.call("test", "missing", vec![]);
+        assert!(matches!(
+            missing,
+            Err(NativeBridgeError::NotRegistered { .. })
+        ));
+    }
+
+    extern "C" fn complete_later(
+        request_id: u64,
+        _ns: *const u8,
+        _ns_len: usize,
+        _name: *const u8,
+        _name_len: usize,
+        args: *const BlincNativeValue,
+        arg_count: usize,
+    ) {
+        assert_eq!(arg_count, 1);
+        // Copy the argument out before returning; it is only valid during the call
+        let value = unsafe { (*args).value.i32 };
+        std::thread::spawn(move || {
+            let result = BlincNativeResult {
+                status: BLINC_NATIVE_STATUS_OK,
+                value: BlincNativeValue::borrow(&NativeValue::Int32(value)),
+                ..BlincNativeResult::empty()
+            };
+            blinc_native_complete(request_id, &result);
+        })
+        .join()
+        .unwrap();
+    }
+
+    #[test]
+    fn test_async_call_completes_from_other_thread() {
+        NativeBridgeState::init();
+        let adapter = IOSNativeBridgeAdapter::with_binary(echo_v2, None).with_async(complete_later);
+        NativeBridgeState::get().set_platform_adapter(Arc::new(adapter));
+
+        let call = NativeBridgeState::get().call_async("test", "later", (7i32,));
+        assert!(call.try_take().is_none());
+        blinc_core::native_bridge::drain_native_completions();
+        assert_eq!(call.try_take().unwrap().unwrap(), NativeValue::Int32(7));
+
+        NativeBridgeState::get().clear_platform_adapter();
+    }
+
     #[test]
     fn test_base64_encode() {
         assert_eq!(base64_encode(b"hello"), "aGVsbG8=");
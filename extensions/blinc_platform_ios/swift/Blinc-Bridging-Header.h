@@ -11,6 +11,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 // Opaque pointer to the Blinc render context
 typedef struct IOSRenderContext IOSRenderContext;
@@ -48,7 +49,10 @@ void blinc_destroy_context(IOSRenderContext* ctx);
 /// @return true if render needed (state changed, animations active, or wake requested)
 bool blinc_needs_render(IOSRenderContext* ctx);
 
-/// Tick animations - call each frame before building UI
+/// Tick animations
+///
+/// Animations are clocked by the display link: blinc_build_frame already
+/// ticks once per frame, so only call this when not using it.
 ///
 /// @param ctx Render context pointer
 /// @return true if animations are active (keep rendering)
@@ -126,6 +130,28 @@ WindowedContext* blinc_get_windowed_context(IOSRenderContext* ctx);
 /// @param phase Touch phase (0=began, 1=moved, 2=ended, 3=cancelled)
 void blinc_handle_touch(IOSRenderContext* ctx, uint64_t touch_id, float x, float y, int32_t phase);
 
+/// A packed touch sample for blinc_handle_touches
+typedef struct BlincTouch {
+    uint64_t id;        // Unique touch identifier (stable for the touch's lifetime)
+    float x;            // X position in logical points
+    float y;            // Y position in logical points
+    int32_t phase;      // Touch phase (0=began, 1=moved, 2=ended, 3=cancelled)
+    float force;        // Touch force (0.0 - 1.0), 0 if unavailable
+    double timestamp;   // UITouch.timestamp in seconds, 0 if unknown
+} BlincTouch;
+
+/// Handle a batch of touch samples in one call
+///
+/// Pass every touch of a UIKit callback, including coalescedTouches(for:).
+/// Moves are merged per touch id to the latest sample (history is kept for
+/// gesture velocity) and the batch is hit-tested and dispatched once.
+///
+/// @param ctx Render context pointer
+/// @param touches Packed array of touch samples
+/// @param count Number of samples in the array
+/// @param timestamp Batch timestamp in seconds (UIEvent.timestamp)
+void blinc_handle_touches(IOSRenderContext* ctx, const BlincTouch* touches, size_t count, double timestamp);
+
 /// Set the focus state (call on viewDidAppear/viewWillDisappear)
 ///
 /// @param ctx Render context pointer
@@ -149,6 +175,102 @@ typedef char* (*NativeCallFn)(const char* ns, const char* name, const char* args
 /// @param call_fn Function pointer to Swift's blinc_ios_native_call
 void blinc_set_native_call_fn(NativeCallFn call_fn);
 
+// -----------------------------------------------------------------------------
+// Binary native call ABI (v2)
+// -----------------------------------------------------------------------------
+
+/// BlincNativeValue tags
+#define BLINC_NATIVE_VOID    0
+#define BLINC_NATIVE_BOOL    1
+#define BLINC_NATIVE_INT32   2
+#define BLINC_NATIVE_INT64   3
+#define BLINC_NATIVE_FLOAT32 4
+#define BLINC_NATIVE_FLOAT64 5
+#define BLINC_NATIVE_STRING  6  // UTF-8 in value.data, not NUL-terminated
+#define BLINC_NATIVE_BYTES   7  // raw bytes in value.data
+#define BLINC_NATIVE_JSON    8  // JSON text in value.data
+
+/// BlincNativeResult status codes
+#define BLINC_NATIVE_STATUS_OK             0
+#define BLINC_NATIVE_STATUS_NOT_REGISTERED 1
+#define BLINC_NATIVE_STATUS_ERROR          2
+#define BLINC_NATIVE_STATUS_UNHANDLED      3  // retry on the JSON path
+
+/// Borrowed byte range
+typedef struct BlincNativeData {
+    const uint8_t* ptr;
+    size_t len;
+} BlincNativeData;
+
+/// Tagged union value; argument values borrow Rust memory for the call only
+typedef struct BlincNativeValue {
+    uint32_t tag;
+    union {
+        bool b;
+        int32_t i32;
+        int64_t i64;
+        float f32;
+        double f64;
+        BlincNativeData data;
+    } value;
+} BlincNativeValue;
+
+/// Result slot provided by Rust and filled in by the handler
+///
+/// Rust presets status to BLINC_NATIVE_STATUS_UNHANDLED (void value, no error,
+/// no release), so a handler that leaves it untouched falls back to the JSON
+/// path. Memory referenced by value/error must stay valid until Rust has copied it.
+/// If release is set, Rust calls release(release_ctx) when done.
+typedef struct BlincNativeResult {
+    int32_t status;
+    BlincNativeValue value;
+    BlincNativeData error;
+    void (*release)(void* ctx);
+    void* release_ctx;
+} BlincNativeResult;
+
+/// Binary native call function type
+/// @param ns Namespace (UTF-8, ns_len bytes, not NUL-terminated)
+/// @param name Function name (UTF-8, name_len bytes, not NUL-terminated)
+/// @param args Argument array (valid only during the call)
+/// @param arg_count Number of arguments
+/// @param out Result slot to fill in
+typedef void (*NativeCallFnV2)(const uint8_t* ns, size_t ns_len,
+                               const uint8_t* name, size_t name_len,
+                               const BlincNativeValue* args, size_t arg_count,
+                               BlincNativeResult* out);
+
+/// Register the binary native call function
+/// Calls go through this handler first; the JSON handler registered with
+/// blinc_set_native_call_fn (if any) is used when it returns
+/// BLINC_NATIVE_STATUS_UNHANDLED.
+/// @param call_fn Function pointer to Swift's blinc_ios_native_call_v2
+void blinc_set_native_call_fn_v2(NativeCallFnV2 call_fn);
+
+// -----------------------------------------------------------------------------
+// Async native calls
+// -----------------------------------------------------------------------------
+
+/// Async native call function type
+/// Copy anything needed from args before returning (they are only valid during
+/// the call), then complete later with blinc_native_complete from any thread.
+typedef void (*NativeCallAsyncFn)(uint64_t request_id,
+                                  const uint8_t* ns, size_t ns_len,
+                                  const uint8_t* name, size_t name_len,
+                                  const BlincNativeValue* args, size_t arg_count);
+
+/// Register the async native call function
+/// Without it, async calls from Rust block on the sync handler.
+/// @param call_fn Function pointer to Swift's blinc_ios_native_call_async
+void blinc_set_native_call_async_fn(NativeCallAsyncFn call_fn);
+
+/// Complete an async native call (safe to call from any thread)
+/// The result is copied (and released) before this returns. It is delivered
+/// to the waiting Rust code on the next blinc_build_frame.
+/// @param request_id Request id passed to the async call function
+/// @param result Filled-in result, or NULL for a void result
+void blinc_native_complete(uint64_t request_id, const BlincNativeResult* result);
+
 /// Check if native bridge is ready
 /// @return true if native call function has been registered
 bool blinc_native_bridge_is_ready(void);
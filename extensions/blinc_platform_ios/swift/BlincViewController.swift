@@ -216,11 +216,24 @@ class BlincViewController: UIViewController {
     override func touchesMoved(_ touches: Set<UITouch>, with event: UIEvent?) {
         guard let ctx = blincContext else { return }
 
+        // Send every coalesced sample in one batch; Blinc merges moves per
+        // touch and hit-tests once, keeping the samples for gesture velocity.
+        var batch: [BlincTouch] = []
         for touch in touches {
-            let point = touch.location(in: view)
             let touchId = UInt64(bitPattern: Int64(touch.hash))
-            blinc_handle_touch(ctx, touchId, Float(point.x), Float(point.y), 1)
+            for sample in event?.coalescedTouches(for: touch) ?? [touch] {
+                let point = sample.location(in: view)
+                batch.append(BlincTouch(
+                    id: touchId,
+                    x: Float(point.x),
+                    y: Float(point.y),
+                    phase: 1,
+                    force: Float(sample.force),
+                    timestamp: sample.timestamp
+                ))
+            }
         }
+        blinc_handle_touches(ctx, batch, batch.count, event?.timestamp ?? 0)
     }
 
     override func touchesEnded(_ touches: Set<UITouch>, with event: UIEvent?) {
@@ -30,6 +30,9 @@ public final class BlincNativeBridge {
     // Handler type: (args: [Any]) throws -> Any?
     private var handlers: [String: [String: ([Any]) throws -> Any?]] = [:]
 
+    // Queue that async native calls run on
+    private let asyncQueue = DispatchQueue(label: "blinc.native.async", qos: .userInitiated, attributes: .concurrent)
+
     private init() {}
 
     // MARK: - Registration
@@ -88,9 +91,50 @@ public final class BlincNativeBridge {
         }
     }
 
-    /// Connect to Rust by registering our native call function
+    /// Called from Rust via the binary (v2) C ABI
+    ///
+    /// Uses the same handlers as `callNative`, but decodes arguments directly
+    /// from `BlincNativeValue`s and writes the result into `out` without any
+    /// JSON. `Data` arguments wrap Rust memory without copying and are only
+    /// valid during the call - copy them if a handler needs to keep them.
+    func callNativeBinary(namespace: String, name: String, args: [Any], out: UnsafeMutablePointer<BlincNativeResult>) {
+        guard let handler = handlers[namespace]?[name] else {
+            out.pointee.status = BLINC_NATIVE_STATUS_NOT_REGISTERED
+            return
+        }
+
+        do {
+            let result = try handler(args)
+            out.pointee.status = BLINC_NATIVE_STATUS_OK
+            encodeBinary(result, into: out)
+        } catch {
+            out.pointee.status = BLINC_NATIVE_STATUS_ERROR
+            out.pointee.error = Self.ownedData(Array(error.localizedDescription.utf8), releasedBy: out)
+        }
+    }
+
+    /// Called from Rust for async calls; runs the handler off the calling thread
+    ///
+    /// The result is handed back with `blinc_native_complete` and delivered to
+    /// Rust on the next frame, so slow handlers never hold up frame building.
+    func callNativeAsync(requestId: UInt64, namespace: String, name: String, args: [Any]) {
+        asyncQueue.async {
+            var result = BlincNativeResult()
+            withUnsafeMutablePointer(to: &result) { out in
+                self.callNativeBinary(namespace: namespace, name: name, args: args, out: out)
+                blinc_native_complete(requestId, out)
+            }
+        }
+    }
+
+    /// Connect to Rust by registering our native call functions
+    ///
+    /// The binary handler is used for every call; the JSON handler stays
+    /// registered as the fallback path.
     public func connectToRust() {
         blinc_set_native_call_fn(blinc_ios_native_call)
+        blinc_set_native_call_fn_v2(blinc_ios_native_call_v2)
+        blinc_set_native_call_async_fn(blinc_ios_native_call_async)
     }
 
     // MARK: - Default Handlers
@@ -301,6 +345,80 @@ public final class BlincNativeBridge {
         return "{\"success\":true,\"value\":null}"
     }
 
+    // MARK: - Binary ABI Helpers
+
+    static func decodeBinaryArgs(_ args: UnsafePointer<BlincNativeValue>?, count: Int) -> [Any] {
+        guard let args = args, count > 0 else { return [] }
+        return (0..<count).map { index -> Any in
+            let value = args[index]
+            switch Int32(bitPattern: value.tag) {
+            case BLINC_NATIVE_BOOL: return value.value.b
+            case BLINC_NATIVE_INT32: return Int(value.value.i32)
+            case BLINC_NATIVE_INT64: return Int(value.value.i64)
+            case BLINC_NATIVE_FLOAT32: return Double(value.value.f32)
+            case BLINC_NATIVE_FLOAT64: return value.value.f64
+            case BLINC_NATIVE_STRING, BLINC_NATIVE_JSON:
+                let bytes = UnsafeBufferPointer(start: value.value.data.ptr, count: value.value.data.len)
+                return String(decoding: bytes, as: UTF8.self)
+            case BLINC_NATIVE_BYTES:
+                guard let ptr = value.value.data.ptr else { return Data() }
+                return Data(bytesNoCopy: UnsafeMutableRawPointer(mutating: ptr),
+                            count: value.value.data.len,
+                            deallocator: .none)
+            default: return NSNull()
+            }
+        }
+    }
+
+    private func encodeBinary(_ value: Any?, into out: UnsafeMutablePointer<BlincNativeResult>) {
+        var encoded = BlincNativeValue()
+        switch value {
+        case nil:
+            encoded.tag = UInt32(BLINC_NATIVE_VOID)
+        case let bool as Bool:
+            encoded.tag = UInt32(BLINC_NATIVE_BOOL)
+            encoded.value.b = bool
+        case let int as Int:
+            if let small = Int32(exactly: int) {
+                encoded.tag = UInt32(BLINC_NATIVE_INT32)
+                encoded.value.i32 = small
+            } else {
+                encoded.tag = UInt32(BLINC_NATIVE_INT64)
+                encoded.value.i64 = Int64(int)
+            }
+        case let int64 as Int64:
+            encoded.tag = UInt32(BLINC_NATIVE_INT64)
+            encoded.value.i64 = int64
+        case let float as Float:
+            encoded.tag = UInt32(BLINC_NATIVE_FLOAT32)
+            encoded.value.f32 = float
+        case let double as Double:
+            encoded.tag = UInt32(BLINC_NATIVE_FLOAT64)
+            encoded.value.f64 = double
+        case let data as Data:
+            encoded.tag = UInt32(BLINC_NATIVE_BYTES)
+            encoded.value.data = Self.ownedData(Array(data), releasedBy: out)
+        case let string as String:
+            encoded.tag = UInt32(BLINC_NATIVE_STRING)
+            encoded.value.data = Self.ownedData(Array(string.utf8), releasedBy: out)
+        default:
+            encoded.tag = UInt32(BLINC_NATIVE_STRING)
+            encoded.value.data = Self.ownedData(Array(String(describing: value!).utf8), releasedBy: out)
+        }
+        out.pointee.value = encoded
+    }
+
+    /// Copy bytes into a malloc'd buffer that Rust releases after reading
+    private static func ownedData(_ bytes: [UInt8], releasedBy out: UnsafeMutablePointer<BlincNativeResult>) -> BlincNativeData {
+        guard !bytes.isEmpty, let buffer = malloc(bytes.count) else {
+            return BlincNativeData(ptr: nil, len: 0)
+        }
+        bytes.withUnsafeBytes { buffer.copyMemory(from: $0.baseAddress!, byteCount: bytes.count) }
+        out.pointee.release = blinc_ios_release_native_buffer
+        out.pointee.release_ctx = buffer
+        return BlincNativeData(ptr: buffer.assumingMemoryBound(to: UInt8.self), len: bytes.count)
+    }
+
     private func errorJson(type: String, message: String) -> String {
         let result: [String: Any] = [
             "success": false,
@@ -339,6 +457,60 @@ public func blinc_ios_native_call(
     return strdup(result)
 }
 
+/// Binary (v2) C function called by Rust to execute native handlers
+@_cdecl("blinc_ios_native_call_v2")
+public func blinc_ios_native_call_v2(
+    ns: UnsafePointer<UInt8>?,
+    nsLen: Int,
+    name: UnsafePointer<UInt8>?,
+    nameLen: Int,
+    args: UnsafePointer<BlincNativeValue>?,
+    argCount: Int,
+    out: UnsafeMutablePointer<BlincNativeResult>?
+) {
+    guard let out = out else { return }
+    let namespace = String(decoding: UnsafeBufferPointer(start: ns, count: nsLen), as: UTF8.self)
+    let funcName = String(decoding: UnsafeBufferPointer(start: name, count: nameLen), as: UTF8.self)
+
+    BlincNativeBridge.shared.callNativeBinary(
+        namespace: namespace,
+        name: funcName,
+        args: BlincNativeBridge.decodeBinaryArgs(args, count: argCount),
+        out: out
+    )
+}
+
+/// Async C function called by Rust; completes later via blinc_native_complete
+@_cdecl("blinc_ios_native_call_async")
+public func blinc_ios_native_call_async(
+    requestId: UInt64,
+    ns: UnsafePointer<UInt8>?,
+    nsLen: Int,
+    name: UnsafePointer<UInt8>?,
+    nameLen: Int,
+    args: UnsafePointer<BlincNativeValue>?,
+    argCount: Int
+) {
+    let namespace = String(decoding: UnsafeBufferPointer(start: ns, count: nsLen), as: UTF8.self)
+    let funcName = String(decoding: UnsafeBufferPointer(start: name, count: nameLen), as: UTF8.self)
+    // Args borrow Rust memory for the duration of this call only - copy bytes out
+    let decoded = BlincNativeBridge.decodeBinaryArgs(args, count: argCount).map { arg -> Any in
+        (arg as? Data).map { Data($0) } ?? arg
+    }
+
+    BlincNativeBridge.shared.callNativeAsync(
+        requestId: requestId,
+        namespace: namespace,
+        name: funcName,
+        args: decoded
+    )
+}
+
+/// Release callback for result buffers handed to Rust by the binary ABI
+private func blinc_ios_release_native_buffer(_ ctx: UnsafeMutableRawPointer?) {
+    free(ctx)
+}
+
 /// Free a string allocated by blinc_ios_native_call
 @_cdecl("blinc_free_string")
 public func blinc_free_string(ptr: UnsafeMutablePointer<CChar>?) {
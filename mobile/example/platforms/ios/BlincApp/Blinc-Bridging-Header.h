@@ -10,6 +10,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 // Opaque type for the Blinc render context
 typedef struct IOSRenderContext IOSRenderContext;
@@ -53,7 +54,7 @@ void blinc_destroy_context(IOSRenderContext* ctx);
 /// Check if a frame needs to be rendered
 ///
 /// Returns true if reactive state changed, animations are active,
-/// or a wake was requested by the animation thread.
+/// or a wake was requested by the animation scheduler.
 ///
 /// @param ctx Render context pointer
 /// @return true if rendering is needed
@@ -67,6 +68,15 @@ bool blinc_needs_render(IOSRenderContext* ctx);
 /// @param builder Function pointer to UI builder
 void blinc_set_ui_builder(UIBuilderFn builder);
 
+/// Register a UI builder for one context only
+///
+/// Takes precedence over blinc_set_ui_builder, so each context can show its
+/// own UI.
+///
+/// @param ctx Render context pointer
+/// @param builder Function pointer to UI builder
+void blinc_set_context_ui_builder(IOSRenderContext* ctx, UIBuilderFn builder);
+
 /// Build a frame using the registered UI builder
 ///
 /// This ticks animations, calls the registered UI builder, and prepares
@@ -77,7 +87,8 @@ void blinc_build_frame(IOSRenderContext* ctx);
 
 /// Tick animations
 ///
-/// Call this each frame before building UI.
+/// blinc_build_frame and blinc_frame already tick animations; only call this
+/// when driving the scheduler without them, or animations are ticked twice.
 ///
 /// @param ctx Render context pointer
 /// @return true if any animations are active
@@ -127,6 +138,28 @@ double blinc_get_scale_factor(IOSRenderContext* ctx);
 /// @param phase Touch phase: 0=began, 1=moved, 2=ended, 3=cancelled
 void blinc_handle_touch(IOSRenderContext* ctx, uint64_t touch_id, float x, float y, int32_t phase);
 
+/// A packed touch sample for blinc_handle_touches
+typedef struct BlincTouch {
+    uint64_t id;        // Unique touch identifier (stable for the touch's lifetime)
+    float x;            // X position in logical points
+    float y;            // Y position in logical points
+    int32_t phase;      // Touch phase (0=began, 1=moved, 2=ended, 3=cancelled)
+    float force;        // Touch force (0.0 - 1.0), 0 if unavailable
+    double timestamp;   // UITouch.timestamp in seconds, 0 if unknown
+} BlincTouch;
+
+/// Handle a batch of touch samples in one call
+///
+/// Pass every touch of a UIKit callback, including coalescedTouches(for:).
+/// Moves are merged per touch id to the latest sample (history is kept for
+/// gesture velocity) and the batch is hit-tested and dispatched once.
+///
+/// @param ctx Render context pointer
+/// @param touches Packed array of touch samples
+/// @param count Number of samples in the array
+/// @param timestamp Batch timestamp in seconds (UIEvent.timestamp)
+void blinc_handle_touches(IOSRenderContext* ctx, const BlincTouch* touches, size_t count, double timestamp);
+
 /// Set the focus state
 ///
 /// @param ctx Render context pointer
@@ -169,6 +202,71 @@ typedef struct IOSGpuRenderer IOSGpuRenderer;
 /// @return Pointer to GPU renderer, or NULL on failure
 IOSGpuRenderer* blinc_init_gpu(IOSRenderContext* ctx, void* metal_layer, uint32_t width, uint32_t height);
 
+/// GPU init options for blinc_init_gpu_with_options
+///
+/// Zero-initialising gives no pipeline cache and synchronous pipeline
+/// compilation; use blinc_gpu_options_default for the recommended defaults.
+typedef struct {
+    /// UTF-8 path of a writable directory for the persistent pipeline cache
+    /// (e.g. the Caches directory), or NULL for no cache
+    const char* pipeline_cache_dir;
+    /// Compile glass and effect pipelines on a background thread instead of
+    /// blocking init; the first frame that uses them waits for the compile
+    bool background_pipeline_compilation;
+    /// Keep the previous frame and redraw only damaged regions when possible
+    /// (costs one drawable-sized texture)
+    bool partial_redraw;
+    /// Blur glass, shadows and blur effects through a downsampled pyramid,
+    /// reusing the glass backdrop while the content under it is unchanged
+    bool performance_blur;
+} BlincGpuOptions;
+
+/// Get the default GPU init options (no cache, background compilation and
+/// partial redraw on)
+BlincGpuOptions blinc_gpu_options_default(void);
+
+/// Initialize the GPU renderer with a CAMetalLayer and init options
+///
+/// Pipeline caching only persists data on backends that support it; on Metal
+/// the directory is accepted but nothing is written.
+///
+/// @param ctx Render context pointer from blinc_create_context
+/// @param metal_layer Pointer to CAMetalLayer
+/// @param width Drawable width in pixels
+/// @param height Drawable height in pixels
+/// @param options Init options, or NULL for defaults
+/// @return Pointer to GPU renderer, or NULL on failure
+IOSGpuRenderer* blinc_init_gpu_with_options(IOSRenderContext* ctx, void* metal_layer, uint32_t width, uint32_t height, const BlincGpuOptions* options);
+
+/// Opaque type for a GPU device shared by several renderers
+typedef struct BlincGpuDevice BlincGpuDevice;
+
+/// Create a GPU device to share between render contexts
+///
+/// Renderers created from it with blinc_init_gpu_shared (e.g. one per window
+/// or embedded view) share its pipelines, glyph atlas and image caches.
+///
+/// @param options Init options for every renderer on the device, or NULL for defaults
+/// @return Pointer to the device, or NULL on failure
+BlincGpuDevice* blinc_create_gpu_device(const BlincGpuOptions* options);
+
+/// Initialize a GPU renderer on a shared device
+///
+/// @param ctx Render context pointer from blinc_create_context
+/// @param device Device from blinc_create_gpu_device
+/// @param metal_layer Pointer to CAMetalLayer
+/// @param width Drawable width in pixels
+/// @param height Drawable height in pixels
+/// @return Pointer to GPU renderer, or NULL on failure
+IOSGpuRenderer* blinc_init_gpu_shared(IOSRenderContext* ctx, BlincGpuDevice* device, void* metal_layer, uint32_t width, uint32_t height);
+
+/// Release a shared GPU device
+///
+/// Renderers created from it keep it alive until blinc_destroy_gpu.
+///
+/// @param device Device pointer
+void blinc_destroy_gpu_device(BlincGpuDevice* device);
+
 /// Resize the GPU surface
 ///
 /// Call this when the Metal layer's drawable size changes.
@@ -187,14 +285,259 @@ void blinc_gpu_resize(IOSGpuRenderer* gpu, uint32_t width, uint32_t height);
 /// @return true if frame was rendered successfully
 bool blinc_render_frame(IOSGpuRenderer* gpu);
 
+/// Result of a combined frame (blinc_frame)
+typedef struct {
+    /// A frame was encoded and presented
+    bool rendered;
+    /// The UI builder ran (full rebuild)
+    bool rebuilt;
+    /// Animations or scroll physics are still running after this frame's tick
+    bool animations_active;
+    /// Another frame is needed; when false the display link can be paused
+    /// until input, a size change or blinc_mark_dirty
+    bool needs_another_frame;
+} BlincFrameResult;
+
+/// Run a complete frame in one call
+///
+/// Replaces blinc_needs_render + blinc_tick_animations + blinc_build_frame +
+/// blinc_render_frame + blinc_clear_dirty. Checks for pending work, ticks
+/// animations exactly once at target_timestamp, applies incremental updates
+/// or rebuilds, then encodes and presents.
+///
+/// @param ctx Render context pointer
+/// @param gpu GPU renderer pointer
+/// @param timestamp CADisplayLink.timestamp
+/// @param target_timestamp CADisplayLink.targetTimestamp
+/// @param out Receives the frame result (can be NULL)
+void blinc_frame(IOSRenderContext* ctx, IOSGpuRenderer* gpu, double timestamp,
+                 double target_timestamp, BlincFrameResult* out);
+
+/// Register a function called when the context wants a frame
+///
+/// Called when an animation starts, an update is queued (from any thread), an
+/// image decode or blinc_native_complete finishes, or blinc_mark_dirty is
+/// called, so a display link paused after needs_another_frame came back
+/// false can be resumed. May be called on any thread; dispatch to the main
+/// queue before touching UIKit. Pass NULL to remove it.
+///
+/// @param ctx Render context pointer
+/// @param callback Function to call, or NULL
+/// @param user_data Passed to callback
+void blinc_set_wake_callback(IOSRenderContext* ctx, void (*callback)(void* user_data),
+                             void* user_data);
+
+/// Per-frame phase timings (CPU milliseconds) and counters
+typedef struct {
+    uint64_t frame_index;
+    float animation_ms;
+    float prop_update_ms;
+    float subtree_rebuild_ms;
+    float layout_ms;
+    float ui_build_ms;
+    /// Waiting for the next drawable
+    float acquire_ms;
+    /// Text preparation and GPU command encoding
+    float encode_ms;
+    /// Waiting for the GPU after the last submit
+    float gpu_ms;
+    /// Whole render call (only recording when the render thread is running)
+    float render_ms;
+    float frame_ms;
+    uint32_t prop_updates;
+    uint32_t subtree_rebuilds;
+    uint32_t layout_nodes;
+    uint32_t primitives;
+    uint32_t glyphs;
+    uint32_t draw_calls;
+    /// Layer texture pool hit rate over this frame (0.0 - 1.0)
+    float layer_cache_hit_rate;
+    /// Damage rects redrawn (0 for full repaints and reused frames)
+    uint32_t damage_rects;
+    /// Fraction of the drawable repainted (0.0 - 1.0)
+    float damage_fraction;
+    /// 1 if the frame moved the previous frame's scroll content instead of
+    /// recording it again
+    uint32_t scroll_composited;
+    /// Quality tier the frame was drawn at (BLINC_QUALITY_*)
+    uint32_t quality_tier;
+    /// Frame rate animations were paced to
+    uint32_t target_fps;
+} BlincFrameStats;
+
+/// Get stats for the last rendered frame
+///
+/// @param ctx Render context pointer
+/// @param out Receives the stats
+/// @return false if no frame has been rendered yet
+bool blinc_get_frame_stats(IOSRenderContext* ctx, BlincFrameStats* out);
+
+/// Copy stats of up to the last 120 frames, oldest first
+///
+/// @param ctx Render context pointer
+/// @param out Array of at least `capacity` elements
+/// @param capacity Number of elements in `out`
+/// @return Number of frames written
+uint32_t blinc_get_frame_stats_history(IOSRenderContext* ctx, BlincFrameStats* out,
+                                       uint32_t capacity);
+
+/// ProcessInfo.ThermalState raw values for blinc_set_power_state
+#define BLINC_THERMAL_NOMINAL 0
+#define BLINC_THERMAL_FAIR 1
+#define BLINC_THERMAL_SERIOUS 2
+#define BLINC_THERMAL_CRITICAL 3
+
+/// BlincFrameStats.quality_tier: configured MSAA and blur quality
+#define BLINC_QUALITY_FULL 0
+/// BlincFrameStats.quality_tier: at most 2x MSAA, pyramid blurs, 60fps cap
+#define BLINC_QUALITY_REDUCED 1
+/// BlincFrameStats.quality_tier: no MSAA, pyramid blurs, 30fps cap
+#define BLINC_QUALITY_MINIMAL 2
+
+/// A frame rate range in frames per second (same fields as CAFrameRateRange)
+typedef struct {
+    float minimum;
+    float maximum;
+    float preferred;
+} BlincFrameRateRange;
+
+/// Set the frame rate range the app wants while the device is cool
+///
+/// Pass the display link's preferredFrameRateRange. Animations tick at the
+/// preferred rate; blinc_set_power_state may cap it.
+///
+/// @param ctx Render context pointer
+/// @param min Lowest acceptable rate (0 for none)
+/// @param max Highest rate (0 for the default 120fps)
+/// @param preferred Rate to aim for (0 for max)
+void blinc_set_frame_rate_range(IOSRenderContext* ctx, float min, float max, float preferred);
+
+/// Report the thermal state and Low Power Mode
+///
+/// Call at startup and on thermalStateDidChangeNotification /
+/// NSProcessInfoPowerStateDidChange. Serious thermal state or Low Power Mode
+/// reduce MSAA and blur quality and cap at 60fps; critical drops MSAA and
+/// caps at 30fps. blinc_frame skips callbacks above the cap.
+///
+/// @param ctx Render context pointer
+/// @param thermal_level ProcessInfo.thermalState.rawValue (BLINC_THERMAL_*)
+/// @param low_power ProcessInfo.isLowPowerModeEnabled
+/// @return true if the quality tier changed
+bool blinc_set_power_state(IOSRenderContext* ctx, uint32_t thermal_level, bool low_power);
+
+/// Get the frame rate range to run the display link at
+///
+/// The range from blinc_set_frame_rate_range, capped for the power state.
+///
+/// @param ctx Render context pointer
+/// @param out Receives the range
+/// @return false if ctx or out is NULL
+bool blinc_get_frame_rate_range(IOSRenderContext* ctx, BlincFrameRateRange* out);
+
+/// Start replaying a recording for profiling (requires the replay-profile feature)
+///
+/// Recorded pointer input is injected as touches during blinc_frame and each
+/// frame's stats are attributed to it. Each frame advances speed x 16.67ms of
+/// the recording.
+///
+/// @param ctx Render context pointer
+/// @param recording_json Recording JSON from SharedRecordingSession::export
+/// @param speed Recording time per frame relative to 60fps (1.0 = real time)
+/// @return false if the recording could not be parsed
+bool blinc_replay_profile_start(IOSRenderContext* ctx, const char* recording_json, double speed);
+
+/// Check whether a profiling replay still has frames to play
+bool blinc_replay_profile_active(IOSRenderContext* ctx);
+
+/// Stop the profiling replay and write its Chrome trace
+///
+/// @param ctx Render context pointer
+/// @param trace_path Where to write the trace JSON
+/// @return Number of janky frames, or -1 on failure
+int32_t blinc_replay_profile_finish(IOSRenderContext* ctx, const char* trace_path);
+
+/// A damaged region of the drawable, in pixels
+typedef struct {
+    float x;
+    float y;
+    float width;
+    float height;
+} BlincDamageRect;
+
+/// Get the regions repainted by the last rendered frame
+///
+/// A full repaint is one rect covering the drawable; a reused frame has none.
+///
+/// @param gpu GPU renderer pointer
+/// @param out Array receiving the rects
+/// @param capacity Number of elements out can hold
+/// @return Number of rects written
+uint32_t blinc_get_damage_rects(IOSGpuRenderer* gpu, BlincDamageRect* out, uint32_t capacity);
+
 /// Destroy the GPU renderer
 ///
 /// @param gpu GPU renderer pointer (can be NULL)
 void blinc_destroy_gpu(IOSGpuRenderer* gpu);
 
+/// Move frame encoding and presentation to a Blinc-owned render thread
+///
+/// blinc_frame / blinc_render_frame then only record a display list on the
+/// main thread; the render thread acquires the drawable and presents, so
+/// the main thread never blocks on nextDrawable. Call from the main thread.
+///
+/// @param gpu GPU renderer pointer
+/// @return true if the render thread is running
+bool blinc_start_render_thread(IOSGpuRenderer* gpu);
+
+/// Stop the render thread and render on the main thread again
+///
+/// @param gpu GPU renderer pointer
+void blinc_stop_render_thread(IOSGpuRenderer* gpu);
+
+/// Set how many drawables the Metal layer may have in flight
+///
+/// 2 = lowest latency, 3 = more GPU slack. Clamped to 2...3.
+///
+/// @param gpu GPU renderer pointer
+/// @param count Maximum drawable count
+void blinc_set_drawable_count(IOSGpuRenderer* gpu, uint32_t count);
+
+#define BLINC_MEMORY_WARNING_MODERATE 0
+#define BLINC_MEMORY_WARNING_CRITICAL 1
+
+/// Release cached GPU memory (call from didReceiveMemoryWarning)
+///
+/// Moderate drops pooled layer textures and image/SVG caches; critical also
+/// shrinks the glyph atlases and releases MSAA/backdrop targets. Everything
+/// is rebuilt lazily on later frames.
+///
+/// @param gpu GPU renderer pointer
+/// @param level BLINC_MEMORY_WARNING_MODERATE or BLINC_MEMORY_WARNING_CRITICAL
+void blinc_handle_memory_warning(IOSGpuRenderer* gpu, uint32_t level);
+
+/// Estimated bytes held by each renderer cache
+typedef struct {
+    uint64_t layer_pool_bytes;
+    uint64_t layer_named_bytes;
+    uint64_t image_cache_bytes;
+    uint64_t svg_cache_bytes;
+    uint64_t glyph_atlas_bytes;
+    uint64_t color_glyph_atlas_bytes;
+    uint64_t render_target_bytes;
+    uint64_t total_bytes;
+} BlincMemoryStats;
+
+/// Get the renderer's estimated cache footprint
+///
+/// @param gpu GPU renderer pointer
+/// @param out Receives the stats
+/// @return false if gpu or out is NULL
+bool blinc_get_memory_usage(IOSGpuRenderer* gpu, BlincMemoryStats* out);
+
 /// Load a bundled font from the app bundle
 ///
 /// Call this after blinc_init_gpu to load fonts from the app bundle.
+/// The file is registered by path and memory-mapped on first use.
 /// Returns the number of font faces loaded.
 ///
 /// @param gpu GPU renderer pointer
@@ -202,6 +545,24 @@ void blinc_destroy_gpu(IOSGpuRenderer* gpu);
 /// @return Number of font faces loaded (0 on failure)
 uint32_t blinc_load_bundled_font(IOSGpuRenderer* gpu, const char* path);
 
+/// Called when Blinc no longer needs memory passed to blinc_load_font_from_memory
+typedef void (*BlincReleaseCallback)(void* context);
+
+/// Load a font from caller-owned memory without copying
+///
+/// Pass the bytes of an NSData (ideally created with .alwaysMapped) and a
+/// retained reference as `context`; `release(context)` is called exactly
+/// once when the last face using the bytes is dropped (or on failure).
+///
+/// @param gpu GPU renderer pointer
+/// @param data Font file bytes (TTF/OTF/TTC)
+/// @param len Length of data in bytes
+/// @param release Release callback (can be NULL)
+/// @param context Passed to release
+/// @return Number of font faces loaded (0 on failure)
+uint32_t blinc_load_font_from_memory(IOSGpuRenderer* gpu, const uint8_t* data, size_t len,
+                                     BlincReleaseCallback release, void* context);
+
 /// Free a string allocated by Rust
 void blinc_free_string(char* ptr);
 
@@ -32,6 +32,9 @@ class BlincViewController: UIViewController {
     /// Whether the view is currently visible
     private var isVisible = false
 
+    /// Target of the wake callback, retained on Blinc's behalf until deinit
+    private var wakeTarget: Unmanaged<WakeTarget>?
+
     /// Track touches by their hash for multi-touch support
     private var touchIds: [ObjectIdentifier: UInt64] = [:]
     private var nextTouchId: UInt64 = 1
@@ -51,6 +54,9 @@ class BlincViewController: UIViewController {
 
         // Set up display link
         setupDisplayLink()
+
+        // Follow thermal state and Low Power Mode
+        observePowerState()
     }
 
     override func viewWillAppear(_ animated: Bool) {
@@ -88,6 +94,16 @@ class BlincViewController: UIViewController {
         if let gpu = gpuRenderer {
             blinc_gpu_resize(gpu, width, height)
         }
+        resumeDisplayLink()
+    }
+
+    override func didReceiveMemoryWarning() {
+        super.didReceiveMemoryWarning()
+
+        // Release Blinc's caches; they are rebuilt lazily on later frames
+        if let gpu = gpuRenderer {
+            blinc_handle_memory_warning(gpu, UInt32(BLINC_MEMORY_WARNING_CRITICAL))
+        }
     }
 
     deinit {
@@ -100,8 +116,10 @@ class BlincViewController: UIViewController {
             blinc_destroy_gpu(gpu)
         }
         if let ctx = renderContext {
+            blinc_set_wake_callback(ctx, nil, nil)
             blinc_destroy_context(ctx)
         }
+        wakeTarget?.release()
     }
 
     // MARK: - Initialization
@@ -126,6 +144,9 @@ class BlincViewController: UIViewController {
         renderContext = ctx
         os_log(.info, log: log, "Render context created")
 
+        // Restart the display link when Blinc wants a frame while idle
+        registerWakeCallback(ctx: ctx)
+
         // Initialize GPU with Metal layer
         let metalLayer = metalView.metalLayer
         os_log(.info, log: log, "Metal layer device: %{public}@", String(describing: metalLayer.device))
@@ -162,24 +183,86 @@ class BlincViewController: UIViewController {
         }
     }
 
+    /// Resume the display link whenever Blinc wants a frame
+    ///
+    /// Blinc may call back on any thread, so the callback hops to the main
+    /// queue. It holds the controller weakly through a retained `WakeTarget`.
+    private func registerWakeCallback(ctx: OpaquePointer) {
+        let target = Unmanaged.passRetained(WakeTarget(controller: self))
+        wakeTarget = target
+
+        blinc_set_wake_callback(ctx, { userData in
+            guard let userData = userData else { return }
+            let target = Unmanaged<WakeTarget>.fromOpaque(userData).takeUnretainedValue()
+            DispatchQueue.main.async {
+                target.controller?.resumeDisplayLink()
+            }
+        }, target.toOpaque())
+    }
+
     private func setupDisplayLink() {
         displayLink = CADisplayLink(target: self, selector: #selector(displayLinkFired))
 
         // Prefer 60fps, but allow system to throttle
+        if let ctx = renderContext {
+            blinc_set_frame_rate_range(ctx, 30, 120, 60)
+        }
+        applyFrameRateRange()
+
+        displayLink?.add(to: .main, forMode: .common)
+    }
+
+    /// Run the display link at the range Blinc picked for the power state
+    private func applyFrameRateRange() {
+        var range = BlincFrameRateRange(minimum: 30, maximum: 120, preferred: 60)
+        if let ctx = renderContext {
+            blinc_get_frame_rate_range(ctx, &range)
+        }
+
         if #available(iOS 15.0, *) {
-            displayLink?.preferredFrameRateRange = CAFrameRateRange(minimum: 30, maximum: 120, preferred: 60)
+            displayLink?.preferredFrameRateRange = CAFrameRateRange(
+                minimum: range.minimum, maximum: range.maximum, preferred: range.preferred)
         } else {
-            displayLink?.preferredFramesPerSecond = 60
+            displayLink?.preferredFramesPerSecond = Int(range.preferred)
         }
+    }
 
-        displayLink?.add(to: .main, forMode: .common)
+    // MARK: - Power State
+
+    private func observePowerState() {
+        NotificationCenter.default.addObserver(
+            self, selector: #selector(powerStateChanged),
+            name: ProcessInfo.thermalStateDidChangeNotification, object: nil)
+        NotificationCenter.default.addObserver(
+            self, selector: #selector(powerStateChanged),
+            name: .NSProcessInfoPowerStateDidChange, object: nil)
+        powerStateChanged()
+    }
+
+    /// Tell Blinc about the thermal state and Low Power Mode
+    ///
+    /// A hot or power-saving device gets lower MSAA, cheaper blurs and a
+    /// capped frame rate. Notifications may arrive on any thread.
+    @objc private func powerStateChanged() {
+        DispatchQueue.main.async { [weak self] in
+            guard let self = self, let ctx = self.renderContext else { return }
+
+            let info = ProcessInfo.processInfo
+            let thermalLevel = UInt32(info.thermalState.rawValue)
+            if blinc_set_power_state(ctx, thermalLevel, info.isLowPowerModeEnabled) {
+                os_log(.info, log: log, "Power state changed (thermal: %d, low power: %d)",
+                       thermalLevel, info.isLowPowerModeEnabled ? 1 : 0)
+            }
+            self.applyFrameRateRange()
+            self.resumeDisplayLink()
+        }
     }
 
     // MARK: - Rendering
 
     private var frameCount = 0
 
-    @objc private func displayLinkFired() {
+    @objc private func displayLinkFired(_ link: CADisplayLink) {
         guard isVisible,
               let ctx = renderContext,
               let gpu = gpuRenderer else {
@@ -190,37 +273,31 @@ class BlincViewController: UIViewController {
             return
         }
 
-        // Log first few frames
-        if frameCount < 3 {
-            os_log(.debug, log: log, "Frame %d - checking if render needed", frameCount)
-        }
+        // Check for work, tick animations at the presentation time, build and render
+        var result = BlincFrameResult()
+        blinc_frame(ctx, gpu, link.timestamp, link.targetTimestamp, &result)
 
-        // Check if we need to render
-        let needsRender = blinc_needs_render(ctx)
+        // Log first few frames
         if frameCount < 3 {
-            os_log(.debug, log: log, "Frame %d - needs_render: %d", frameCount, needsRender ? 1 : 0)
-        }
-
-        if !needsRender && frameCount >= 3 {
-            return
+            os_log(.info, log: log, "Frame %d - rendered: %d, rebuilt: %d, needs another: %d",
+                   frameCount, result.rendered ? 1 : 0, result.rebuilt ? 1 : 0,
+                   result.needs_another_frame ? 1 : 0)
         }
 
-        // Build UI (this ticks animations and calls the UI builder)
-        if frameCount < 3 {
-            os_log(.debug, log: log, "Frame %d - calling blinc_build_frame", frameCount)
+        if result.rendered {
+            frameCount += 1
         }
-        blinc_build_frame(ctx)
 
-        // Render to Metal
-        if frameCount < 3 {
-            os_log(.debug, log: log, "Frame %d - calling blinc_render_frame", frameCount)
-        }
-        let result = blinc_render_frame(gpu)
-        if frameCount < 3 {
-            os_log(.info, log: log, "Frame %d - render result: %d", frameCount, result ? 1 : 0)
+        // Nothing left to draw: stop until a wake, touch or size change
+        if !result.needs_another_frame {
+            link.isPaused = true
         }
+    }
 
-        frameCount += 1
+    /// Restart a display link paused while Blinc was idle
+    fileprivate func resumeDisplayLink() {
+        guard isVisible else { return }
+        displayLink?.isPaused = false
     }
 
     // MARK: - Touch Handling
@@ -240,6 +317,7 @@ class BlincViewController: UIViewController {
             os_log(.info, log: log, "touchesBegan: calling blinc_handle_touch at (%.1f, %.1f)", point.x, point.y)
             blinc_handle_touch(ctx, touchId, Float(point.x), Float(point.y), 0) // 0 = began
         }
+        resumeDisplayLink()
     }
 
     override func touchesMoved(_ touches: Set<UITouch>, with event: UIEvent?) {
@@ -250,6 +328,7 @@ class BlincViewController: UIViewController {
             let touchId = getTouchId(for: touch)
             blinc_handle_touch(ctx, touchId, Float(point.x), Float(point.y), 1) // 1 = moved
         }
+        resumeDisplayLink()
     }
 
     override func touchesEnded(_ touches: Set<UITouch>, with event: UIEvent?) {
@@ -267,6 +346,7 @@ class BlincViewController: UIViewController {
             blinc_handle_touch(ctx, touchId, Float(point.x), Float(point.y), 2) // 2 = ended
             removeTouchId(for: touch)
         }
+        resumeDisplayLink()
     }
 
     override func touchesCancelled(_ touches: Set<UITouch>, with event: UIEvent?) {
@@ -278,6 +358,7 @@ class BlincViewController: UIViewController {
             blinc_handle_touch(ctx, touchId, Float(point.x), Float(point.y), 3) // 3 = cancelled
             removeTouchId(for: touch)
         }
+        resumeDisplayLink()
     }
 
     // MARK: - Touch ID Management
@@ -315,6 +396,15 @@ class BlincViewController: UIViewController {
     }
 }
 
+/// Weak reference to the controller handed to Blinc's wake callback
+private final class WakeTarget {
+    weak var controller: BlincViewController?
+
+    init(controller: BlincViewController) {
+        self.controller = controller
+    }
+}
+
 // MARK: - UI Builder Registration
 
 /// Global UI builder function pointer for FFI